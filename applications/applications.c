@@ -75,7 +75,7 @@ const FlipperApplication FLIPPER_SERVICES[] = {
 #endif
 
 #ifdef SRV_BT
-    {.app = bt_srv, .name = "BtSrv", .stack_size = 1024, .icon = NULL},
+    {.app = bt_srv, .name = "BtSrv", .stack_size = 2048, .icon = NULL},
 #endif
 
 #ifdef SRV_CLI
@@ -87,7 +87,7 @@ const FlipperApplication FLIPPER_SERVICES[] = {
 #endif
 
 #ifdef SRV_DOLPHIN
-    {.app = dolphin_srv, .name = "DolphinSrv", .stack_size = 1024, .icon = NULL},
+    {.app = dolphin_srv, .name = "DolphinSrv", .stack_size = 2048, .icon = NULL},
 #endif
 
 #ifdef SRV_DESKTOP
@@ -103,7 +103,7 @@ const FlipperApplication FLIPPER_SERVICES[] = {
 #endif
 
 #ifdef SRV_LOADER
-    {.app = loader_srv, .name = "LoaderSrv", .stack_size = 1024, .icon = NULL},
+    {.app = loader_srv, .name = "LoaderSrv", .stack_size = 2048, .icon = NULL},
 #endif
 
 #ifdef SRV_NOTIFICATION
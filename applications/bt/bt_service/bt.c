@@ -7,10 +7,6 @@
 
 #define TAG "BtSrv"
 
-#define BT_RPC_EVENT_BUFF_SENT (1UL << 0)
-#define BT_RPC_EVENT_DISCONNECTED (1UL << 1)
-#define BT_RPC_EVENT_ALL (BT_RPC_EVENT_BUFF_SENT | BT_RPC_EVENT_DISCONNECTED)
-
 static void bt_draw_statusbar_callback(Canvas* canvas, void* context) {
     furi_assert(context);
 
@@ -100,6 +96,11 @@ static void bt_battery_level_changed_callback(const void* _event, void* context)
     }
 }
 
+static FuriHalBtSerialTxStatus bt_rpc_tx_callback(uint8_t* data, uint16_t size, void* context) {
+    UNUSED(context);
+    return furi_hal_bt_serial_tx(data, size);
+}
+
 Bt* bt_alloc() {
     Bt* bt = malloc(sizeof(Bt));
     // Init default maximum packet size
@@ -134,7 +135,7 @@ Bt* bt_alloc() {
 
     // RPC
     bt->rpc = furi_record_open("rpc");
-    bt->rpc_event = osEventFlagsNew(NULL);
+    bt->rpc_tx = bt_rpc_tx_alloc(bt_rpc_tx_callback, bt);
 
     // API evnent
     bt->api_event = osEventFlagsNew(NULL);
@@ -156,8 +157,12 @@ static uint16_t bt_serial_event_callback(SerialServiceEvent event, void* context
                 TAG, "Only %d of %d bytes processed by RPC", bytes_processed, event.data.size);
         }
         ret = rpc_session_get_available_size(bt->rpc_session);
+        if(event.data.size >= bt->max_packet_size) {
+            // Client fills packets: upload is in progress
+            furi_hal_bt_request_bulk_transfer();
+        }
     } else if(event.event == SerialServiceEventTypeDataSent) {
-        osEventFlagsSet(bt->rpc_event, BT_RPC_EVENT_BUFF_SENT);
+        bt_rpc_tx_notify_sent(bt->rpc_tx);
     }
     return ret;
 }
@@ -167,25 +172,27 @@ static void bt_rpc_send_bytes_callback(void* context, uint8_t* bytes, size_t byt
     furi_assert(context);
     Bt* bt = context;
 
-    osEventFlagsClear(bt->rpc_event, BT_RPC_EVENT_ALL);
-    size_t bytes_sent = 0;
-    while(bytes_sent < bytes_len) {
-        size_t bytes_remain = bytes_len - bytes_sent;
-        if(bytes_remain > bt->max_packet_size) {
-            furi_hal_bt_serial_tx(&bytes[bytes_sent], bt->max_packet_size);
-            bytes_sent += bt->max_packet_size;
-        } else {
-            furi_hal_bt_serial_tx(&bytes[bytes_sent], bytes_remain);
-            bytes_sent += bytes_remain;
-        }
-        uint32_t event_flag =
-            osEventFlagsWait(bt->rpc_event, BT_RPC_EVENT_ALL, osFlagsWaitAny, osWaitForever);
-        if(event_flag & BT_RPC_EVENT_DISCONNECTED) {
-            break;
+    if(bytes_len > bt->max_packet_size) {
+        furi_hal_bt_request_bulk_transfer();
+    }
+    if(bt_rpc_tx_send(bt->rpc_tx, bytes, bytes_len)) {
+        // Keep tail for next response while RPC has input to process, its empty buffer
+        // callback sends tail. Checked after tail is queued, so flush can't be missed.
+        if(rpc_session_get_available_size(bt->rpc_session) == RPC_BUFFER_SIZE) {
+            bt_rpc_tx_flush(bt->rpc_tx);
         }
     }
 }
 
+// Called from RPC thread
+static void bt_rpc_buffer_is_empty_callback(void* context) {
+    furi_assert(context);
+    Bt* bt = context;
+
+    bt_rpc_tx_flush(bt->rpc_tx);
+    furi_hal_bt_serial_notify_buffer_is_empty();
+}
+
 // Called from GAP thread
 static bool bt_on_gap_event_callback(GapEvent event, void* context) {
     furi_assert(context);
@@ -202,9 +209,10 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
             bt->rpc_session = rpc_session_open(bt->rpc);
             if(bt->rpc_session) {
                 FURI_LOG_I(TAG, "Open RPC connection");
+                bt_rpc_tx_reset(bt->rpc_tx, bt->max_packet_size);
                 rpc_session_set_send_bytes_callback(bt->rpc_session, bt_rpc_send_bytes_callback);
                 rpc_session_set_buffer_is_empty_callback(
-                    bt->rpc_session, furi_hal_bt_serial_notify_buffer_is_empty);
+                    bt->rpc_session, bt_rpc_buffer_is_empty_callback);
                 rpc_session_set_context(bt->rpc_session, bt);
                 furi_hal_bt_serial_set_event_callback(
                     RPC_BUFFER_SIZE, bt_serial_event_callback, bt);
@@ -222,7 +230,7 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
     } else if(event.type == GapEventTypeDisconnected) {
         if(bt->profile == BtProfileSerial && bt->rpc_session) {
             FURI_LOG_I(TAG, "Close RPC connection");
-            osEventFlagsSet(bt->rpc_event, BT_RPC_EVENT_DISCONNECTED);
+            bt_rpc_tx_abort(bt->rpc_tx);
             rpc_session_close(bt->rpc_session);
             furi_hal_bt_serial_set_event_callback(0, NULL, NULL);
             bt->rpc_session = NULL;
@@ -247,6 +255,7 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
         ret = bt_pin_code_verify_event_handler(bt, event.data.pin_code);
     } else if(event.type == GapEventTypeUpdateMTU) {
         bt->max_packet_size = event.data.max_packet_size;
+        bt_rpc_tx_set_packet_size(bt->rpc_tx, bt->max_packet_size);
         ret = true;
     }
     return ret;
@@ -284,7 +293,7 @@ static void bt_change_profile(Bt* bt, BtMessage* message) {
         bt_settings_load(&bt->bt_settings);
         if(bt->profile == BtProfileSerial && bt->rpc_session) {
             FURI_LOG_I(TAG, "Close RPC connection");
-            osEventFlagsSet(bt->rpc_event, BT_RPC_EVENT_DISCONNECTED);
+            bt_rpc_tx_abort(bt->rpc_tx);
             rpc_session_close(bt->rpc_session);
             furi_hal_bt_serial_set_event_callback(0, NULL, NULL);
             bt->rpc_session = NULL;
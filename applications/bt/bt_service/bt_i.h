@@ -15,6 +15,7 @@
 #include <applications/notification/notification.h>
 
 #include "../bt_settings.h"
+#include "bt_rpc_tx.h"
 
 #define BT_API_UNLOCK_EVENT (1UL << 0)
 
@@ -57,7 +58,7 @@ struct Bt {
     Power* power;
     Rpc* rpc;
     RpcSession* rpc_session;
-    osEventFlagsId_t rpc_event;
+    BtRpcTx* rpc_tx;
     osEventFlagsId_t api_event;
     BtStatusChangedCallback status_changed_cb;
     void* status_changed_ctx;
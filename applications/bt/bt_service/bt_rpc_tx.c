@@ -0,0 +1,140 @@
+#include "bt_rpc_tx.h"
+
+#include <furi.h>
+
+#define TAG "BtRpcTx"
+
+/** Same as ATT transaction timeout: link is dead if client doesn't take data that long */
+#define BT_RPC_TX_TIMEOUT 30000
+
+#define BT_RPC_TX_EVENT_SENT (1UL << 0)
+#define BT_RPC_TX_EVENT_ABORT (1UL << 1)
+#define BT_RPC_TX_EVENT_ALL (BT_RPC_TX_EVENT_SENT | BT_RPC_TX_EVENT_ABORT)
+
+struct BtRpcTx {
+    BtRpcTxCallback callback;
+    void* context;
+    osMutexId_t mutex;
+    osEventFlagsId_t event;
+    volatile bool aborted;
+    uint16_t packet_size;
+    uint16_t fill;
+    uint8_t buffer[FURI_HAL_BT_SERIAL_PACKET_SIZE_MAX];
+};
+
+BtRpcTx* bt_rpc_tx_alloc(BtRpcTxCallback callback, void* context) {
+    furi_assert(callback);
+    BtRpcTx* tx = malloc(sizeof(BtRpcTx));
+    tx->callback = callback;
+    tx->context = context;
+    tx->mutex = osMutexNew(NULL);
+    tx->event = osEventFlagsNew(NULL);
+    tx->aborted = false;
+    tx->packet_size = FURI_HAL_BT_SERIAL_PACKET_SIZE_MAX;
+    tx->fill = 0;
+    return tx;
+}
+
+void bt_rpc_tx_free(BtRpcTx* tx) {
+    furi_assert(tx);
+    osEventFlagsDelete(tx->event);
+    osMutexDelete(tx->mutex);
+    free(tx);
+}
+
+void bt_rpc_tx_reset(BtRpcTx* tx, uint16_t packet_size) {
+    furi_assert(tx);
+    furi_check(osMutexAcquire(tx->mutex, osWaitForever) == osOK);
+    tx->fill = 0;
+    tx->aborted = false;
+    osEventFlagsClear(tx->event, BT_RPC_TX_EVENT_ALL);
+    furi_check(osMutexRelease(tx->mutex) == osOK);
+    bt_rpc_tx_set_packet_size(tx, packet_size);
+}
+
+void bt_rpc_tx_set_packet_size(BtRpcTx* tx, uint16_t packet_size) {
+    furi_assert(tx);
+    furi_assert(packet_size);
+    // No mutex: called from BLE event thread, which must not wait for blocked sender
+    tx->packet_size = MIN(packet_size, FURI_HAL_BT_SERIAL_PACKET_SIZE_MAX);
+}
+
+/** Queue one packet, wait only while transport has no free buffers. Mutex is held. */
+static bool bt_rpc_tx_packet(BtRpcTx* tx, uint8_t* data, uint16_t size) {
+    while(!tx->aborted) {
+        // Clear before try: notification may come before wait starts
+        osEventFlagsClear(tx->event, BT_RPC_TX_EVENT_SENT);
+        FuriHalBtSerialTxStatus status = tx->callback(data, size, tx->context);
+        if(status == SerialServiceTxStatusOk) {
+            return true;
+        } else if(status == SerialServiceTxStatusError) {
+            FURI_LOG_E(TAG, "Failed to send %d bytes", size);
+            return false;
+        }
+
+        uint32_t flags = osEventFlagsWait(
+            tx->event, BT_RPC_TX_EVENT_ALL, osFlagsWaitAny, BT_RPC_TX_TIMEOUT);
+        if(flags & osFlagsError) {
+            FURI_LOG_E(TAG, "Transport is busy for too long, dropping data");
+            return false;
+        }
+    }
+    return false;
+}
+
+bool bt_rpc_tx_send(BtRpcTx* tx, uint8_t* data, size_t size) {
+    furi_assert(tx);
+    furi_check(osMutexAcquire(tx->mutex, osWaitForever) == osOK);
+
+    bool result = !tx->aborted;
+    while(result && (size || tx->fill >= tx->packet_size)) {
+        uint16_t packet_size = tx->packet_size;
+        if(tx->fill >= packet_size) {
+            // Buffered packet is complete, packet size could shrink after it was started
+            result = bt_rpc_tx_packet(tx, tx->buffer, tx->fill);
+            tx->fill = 0;
+        } else if(tx->fill == 0 && size >= packet_size) {
+            // Full packet straight from caller buffer
+            result = bt_rpc_tx_packet(tx, data, packet_size);
+            data += packet_size;
+            size -= packet_size;
+        } else {
+            size_t chunk = MIN(size, (size_t)(packet_size - tx->fill));
+            memcpy(&tx->buffer[tx->fill], data, chunk);
+            tx->fill += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+    }
+
+    if(!result) {
+        tx->fill = 0;
+    }
+    furi_check(osMutexRelease(tx->mutex) == osOK);
+    return result;
+}
+
+bool bt_rpc_tx_flush(BtRpcTx* tx) {
+    furi_assert(tx);
+    furi_check(osMutexAcquire(tx->mutex, osWaitForever) == osOK);
+
+    bool result = !tx->aborted;
+    if(result && tx->fill) {
+        result = bt_rpc_tx_packet(tx, tx->buffer, tx->fill);
+    }
+    tx->fill = 0;
+
+    furi_check(osMutexRelease(tx->mutex) == osOK);
+    return result;
+}
+
+void bt_rpc_tx_notify_sent(BtRpcTx* tx) {
+    furi_assert(tx);
+    osEventFlagsSet(tx->event, BT_RPC_TX_EVENT_SENT);
+}
+
+void bt_rpc_tx_abort(BtRpcTx* tx) {
+    furi_assert(tx);
+    tx->aborted = true;
+    osEventFlagsSet(tx->event, BT_RPC_TX_EVENT_ABORT);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <furi_hal_bt_serial.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** RPC to BLE serial transmit queue
+ *
+ * Packs outgoing RPC bytes into packets of negotiated size and hands them to transport
+ * without waiting for delivery. Sender blocks only when transport reports busy.
+ */
+typedef struct BtRpcTx BtRpcTx;
+
+/** Transport callback: queue one packet, don't wait for delivery
+ *
+ * @return FuriHalBtSerialTxStatus, on Busy the same packet is retried after
+ *         bt_rpc_tx_notify_sent
+ */
+typedef FuriHalBtSerialTxStatus (*BtRpcTxCallback)(uint8_t* data, uint16_t size, void* context);
+
+BtRpcTx* bt_rpc_tx_alloc(BtRpcTxCallback callback, void* context);
+
+void bt_rpc_tx_free(BtRpcTx* tx);
+
+/** Prepare for new connection: drop pending data, clear abort state */
+void bt_rpc_tx_reset(BtRpcTx* tx, uint16_t packet_size);
+
+/** Set packet size negotiated with client, not more than FURI_HAL_BT_SERIAL_PACKET_SIZE_MAX */
+void bt_rpc_tx_set_packet_size(BtRpcTx* tx, uint16_t packet_size);
+
+/** Append data, send all complete packets
+ *
+ * Incomplete tail stays in buffer until more data or bt_rpc_tx_flush
+ *
+ * @return false if transmission was aborted or failed
+ */
+bool bt_rpc_tx_send(BtRpcTx* tx, uint8_t* data, size_t size);
+
+/** Send buffered tail
+ *
+ * @return false if transmission was aborted or failed
+ */
+bool bt_rpc_tx_flush(BtRpcTx* tx);
+
+/** Transport has free buffers again. Safe to call from any thread */
+void bt_rpc_tx_notify_sent(BtRpcTx* tx);
+
+/** Connection is lost: release blocked sender, drop all data until reset.
+ * Safe to call from any thread
+ */
+void bt_rpc_tx_abort(BtRpcTx* tx);
+
+#ifdef __cplusplus
+}
+#endif
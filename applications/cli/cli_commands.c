@@ -6,6 +6,7 @@
 #include <time.h>
 #include <notification/notification_messages.h>
 #include <loader/loader.h>
+#include <lib/toolbox/args.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
 #define CLI_DATE_FORMAT "%.4d-%.2d-%.2d %.2d:%.2d:%.2d %d"
@@ -335,6 +336,96 @@ void cli_command_free_blocks(Cli* cli, string_t args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+static void cli_command_profiler_dump_callback(
+    const uint8_t* data,
+    size_t size,
+    bool last,
+    void* context) {
+    Cli* cli = context;
+    cli_write(cli, data, size);
+}
+
+static void cli_command_profiler_print_usage() {
+    printf("Usage:\r\n");
+    printf("profiler <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+    printf(
+        "\tstart [rate]\t - start sampling, %d Hz by default\r\n",
+        FURI_HAL_PROFILER_RATE_DEFAULT);
+    printf("\tstop\t - stop sampling\r\n");
+    printf("\tdump\t - send threads and collected samples, binary\r\n");
+}
+
+void cli_command_profiler(Cli* cli, string_t args, void* context) {
+    string_t cmd;
+    string_init(cmd);
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_profiler_print_usage();
+            break;
+        }
+
+        if(string_cmp_str(cmd, "start") == 0) {
+            int rate = FURI_HAL_PROFILER_RATE_DEFAULT;
+            if(string_size(args) && !args_read_int_and_trim(args, &rate)) {
+                cli_print_usage("profiler start", "[rate]", string_get_cstr(args));
+            } else if(!furi_hal_profiler_start(rate)) {
+                printf(
+                    "Already running or rate is out of %d-%d Hz\r\n",
+                    FURI_HAL_PROFILER_RATE_MIN,
+                    FURI_HAL_PROFILER_RATE_MAX);
+            }
+            break;
+        }
+
+        if(string_cmp_str(cmd, "stop") == 0) {
+            furi_hal_profiler_stop();
+            break;
+        }
+
+        if(string_cmp_str(cmd, "dump") == 0) {
+            // Binary goes straight to VCP, text before it must be out already
+            fflush(stdout);
+            if(!furi_hal_profiler_dump(cli_command_profiler_dump_callback, cli)) {
+                printf("Nothing to dump or dump is running in other session\r\n");
+            }
+            break;
+        }
+
+        cli_command_profiler_print_usage();
+    } while(false);
+
+    string_clear(cmd);
+}
+
+static void cli_command_trace_drain_callback(
+    const uint8_t* data,
+    size_t size,
+    bool last,
+    void* context) {
+    Cli* cli = context;
+    cli_write(cli, data, size);
+}
+
+void cli_command_trace(Cli* cli, string_t args, void* context) {
+    if(string_cmp_str(args, "drain") != 0) {
+        cli_print_usage("trace", "drain", string_get_cstr(args));
+        return;
+    }
+
+    if(!furi_trace_is_enabled()) {
+        printf("Trace points are not compiled in, build with FURI_TRACE=1\r\n");
+        return;
+    }
+
+    // Binary goes straight to VCP, text before it must be out already
+    fflush(stdout);
+    if(!furi_trace_drain(cli_command_trace_drain_callback, cli)) {
+        printf("Trace is drained by other session\r\n");
+    }
+}
+
 void cli_command_i2c(Cli* cli, string_t args, void* context) {
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_external);
     printf("Scanning external i2c on PC0(SCL)/PC1(SDA)\r\n"
@@ -365,6 +456,8 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "log", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "debug", CliCommandFlagDefault, cli_command_debug, NULL);
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
+    cli_add_command(cli, "profiler", CliCommandFlagParallelSafe, cli_command_profiler, NULL);
+    cli_add_command(cli, "trace", CliCommandFlagParallelSafe, cli_command_trace, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
 
@@ -89,6 +89,7 @@ static void display_test_reload_config(DisplayTest* instance) {
         instance->config_contrast,
         instance->config_regulation_ratio,
         instance->config_bias);
+    canvas_invalidate(instance->gui->canvas);
     gui_update(instance->gui);
 }
 
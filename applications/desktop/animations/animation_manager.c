@@ -48,6 +48,8 @@ struct AnimationManager {
     AnimationManagerInteractCallback interact_callback;
     AnimationManagerSetNewIdleAnimationCallback new_idle_callback;
     AnimationManagerSetNewIdleAnimationCallback check_blocking_callback;
+    AnimationManagerFrameCallback frame_callback;
+    void* frame_callback_context;
     void* context;
     string_t freezed_animation_name;
     int32_t freezed_animation_time_left;
@@ -93,6 +95,15 @@ void animation_manager_set_interact_callback(
     animation_manager->interact_callback = callback;
 }
 
+void animation_manager_set_frame_callback(
+    AnimationManager* animation_manager,
+    AnimationManagerFrameCallback callback,
+    void* context) {
+    furi_assert(animation_manager);
+    animation_manager->frame_callback_context = context;
+    animation_manager->frame_callback = callback;
+}
+
 static void animation_manager_check_blocking_callback(const void* message, void* context) {
     const StorageEvent* storage_event = message;
 
@@ -102,6 +113,7 @@ static void animation_manager_check_blocking_callback(const void* message, void*
     case StorageEventTypeCardMountError:
         furi_assert(context);
         AnimationManager* animation_manager = context;
+        animation_storage_invalidate_manifest();
         if(animation_manager->check_blocking_callback) {
             animation_manager->check_blocking_callback(animation_manager->context);
         }
@@ -128,6 +140,20 @@ static void animation_manager_interact_callback(void* context) {
     }
 }
 
+static void animation_manager_frame_callback(void* context) {
+    furi_assert(context);
+    AnimationManager* animation_manager = context;
+    if(animation_manager->frame_callback) {
+        animation_manager->frame_callback(animation_manager->frame_callback_context);
+    }
+}
+
+/* reaction to animation_manager->frame_callback() */
+void animation_manager_frame_process(AnimationManager* animation_manager) {
+    furi_assert(animation_manager);
+    bubble_animation_view_process_frame(animation_manager->animation_view);
+}
+
 /* reaction to animation_manager->check_blocking_callback() */
 void animation_manager_check_blocking_process(AnimationManager* animation_manager) {
     furi_assert(animation_manager);
@@ -280,6 +306,8 @@ AnimationManager* animation_manager_alloc(void) {
         osTimerNew(animation_manager_timer_callback, osTimerOnce, animation_manager, NULL);
     bubble_animation_view_set_interact_callback(
         animation_manager->animation_view, animation_manager_interact_callback, animation_manager);
+    bubble_animation_view_set_frame_callback(
+        animation_manager->animation_view, animation_manager_frame_callback, animation_manager);
 
     Storage* storage = furi_record_open("storage");
     animation_manager->pubsub_subscription_storage = furi_pubsub_subscribe(
@@ -22,6 +22,8 @@ typedef struct FrameBubble {
     const struct FrameBubble* next_bubble;
 } FrameBubble;
 
+typedef struct AnimationFrameStream AnimationFrameStream;
+
 typedef struct {
     const FrameBubble* const* frame_bubble_sequences;
     uint8_t frame_bubble_sequences_count;
@@ -32,11 +34,15 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    /* Frames source of animation loaded from bundle,
+     * NULL if all frames are kept in icon_animation */
+    AnimationFrameStream* frame_stream;
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
 typedef void (*AnimationManagerCheckBlockingCallback)(void* context);
 typedef void (*AnimationManagerInteractCallback)(void*);
+typedef void (*AnimationManagerFrameCallback)(void* context);
 
 /**
  * Allocate Animation Manager
@@ -133,6 +139,28 @@ void animation_manager_set_interact_callback(
  */
 void animation_manager_interact_process(AnimationManager* animation_manager);
 
+/**
+ * Set callback for Animation Manager for defered calls
+ * for animation_manager_frame_process(). Called from timer
+ * task on every frame of idle animation.
+ *
+ * @animation_manager   instance
+ * @callback            callback
+ * @context             callback context
+ */
+void animation_manager_set_frame_callback(
+    AnimationManager* animation_manager,
+    AnimationManagerFrameCallback callback,
+    void* context);
+
+/**
+ * Function to call in main thread as a response to
+ * frame_callback's call: reads and decodes next frame.
+ *
+ * @animation_manager   instance
+ */
+void animation_manager_frame_process(AnimationManager* animation_manager);
+
 /** Check if animation loaded
  *
  * @animation_manager   instance
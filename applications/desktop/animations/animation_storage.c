@@ -1,4 +1,3 @@
-
 #include <stdint.h>
 #include <flipper_format/flipper_format.h>
 #include <furi.h>
@@ -6,6 +5,8 @@
 #include <storage/storage.h>
 #include <gui/icon_i.h>
 #include <m-string.h>
+#include <furi_hal_compress.h>
+#include <lib/heatshrink/heatshrink_decoder.h>
 
 #include "animation_manager.h"
 #include "animation_storage.h"
@@ -16,65 +17,194 @@
 #define ANIMATION_META_FILE "meta.txt"
 #define ANIMATION_DIR "/ext/dolphin"
 #define ANIMATION_MANIFEST_FILE ANIMATION_DIR "/manifest.txt"
+#define ANIMATION_BUNDLE_EXT ".bundle"
+#define ANIMATION_BUNDLE_MAGIC 0x42414C46 /* "FLAB" */
+#define ANIMATION_BUNDLE_VERSION 1
+#define ANIMATION_STREAM_SLOTS 2
+#define ANIMATION_DECODER_INPUT_SIZE 256
 #define TAG "AnimationStorage"
 
+/* Bundle layout: header, frames order, frame offsets (frame_count + 1,
+ * absolute, last one is end of data), bubbles, frames data.
+ * Frames are Flipper Compressed Bitmaps, same as frame_X.bm */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t width;
+    uint8_t height;
+    uint8_t frame_count;
+    uint8_t passive_frames;
+    uint8_t active_frames;
+    uint8_t active_cycles;
+    uint8_t frame_rate;
+    uint16_t duration;
+    uint16_t active_cooldown;
+    uint8_t bubble_slots;
+    uint8_t bubble_count;
+    uint16_t reserved;
+} __attribute__((packed)) AnimationBundleHeader;
+
+/* Followed by text_length bytes of text without terminator */
+typedef struct {
+    uint8_t slot;
+    uint8_t x;
+    uint8_t y;
+    uint8_t align_h;
+    uint8_t align_v;
+    uint8_t start_frame;
+    uint8_t end_frame;
+    uint8_t text_length;
+} __attribute__((packed)) AnimationBundleBubble;
+
+struct AnimationFrameStream {
+    File* file;
+    uint32_t* offsets;
+    uint8_t* buffer;
+    size_t slot_size;
+    int16_t slot_frame[ANIMATION_STREAM_SLOTS];
+    uint8_t last_slot;
+};
+
+/* Parsed manifest. Used only from animation manager thread,
+ * generation is changed from storage events. */
+typedef struct {
+    StorageAnimationManifestInfo* items;
+    size_t count;
+    uint64_t manifest_size;
+    uint32_t manifest_mtime;
+    uint32_t generation;
+    bool valid;
+} AnimationManifestCache;
+
+static AnimationManifestCache manifest_cache;
+static volatile uint32_t manifest_generation;
+
 static void animation_storage_free_bubbles(BubbleAnimation* animation);
 static void animation_storage_free_frames(BubbleAnimation* animation);
 static void animation_storage_free_animation(BubbleAnimation** storage_animation);
 static BubbleAnimation* animation_storage_load_animation(const char* name);
 
-static bool animation_storage_load_single_manifest_info(
-    StorageAnimationManifestInfo* manifest_info,
-    const char* name) {
-    furi_assert(manifest_info);
+static void animation_storage_copy_manifest_info(
+    StorageAnimationManifestInfo* dst,
+    const StorageAnimationManifestInfo* src) {
+    *dst = *src;
+    dst->name = malloc(strlen(src->name) + 1);
+    strcpy((char*)dst->name, src->name);
+}
 
-    bool result = false;
-    Storage* storage = furi_record_open("storage");
+static bool animation_storage_read_manifest_info(
+    FlipperFormat* file,
+    string_t read_string,
+    StorageAnimationManifestInfo* manifest_info) {
+    uint32_t u32value;
+
+    if(!flipper_format_read_string(file, "Name", read_string)) return false;
+    if(!flipper_format_read_uint32(file, "Min butthurt", &u32value, 1)) return false;
+    manifest_info->min_butthurt = u32value;
+    if(!flipper_format_read_uint32(file, "Max butthurt", &u32value, 1)) return false;
+    manifest_info->max_butthurt = u32value;
+    if(!flipper_format_read_uint32(file, "Min level", &u32value, 1)) return false;
+    manifest_info->min_level = u32value;
+    if(!flipper_format_read_uint32(file, "Max level", &u32value, 1)) return false;
+    manifest_info->max_level = u32value;
+    if(!flipper_format_read_uint32(file, "Weight", &u32value, 1)) return false;
+    manifest_info->weight = u32value;
+
+    manifest_info->name = malloc(string_size(read_string) + 1);
+    strcpy((char*)manifest_info->name, string_get_cstr(read_string));
+    return true;
+}
+
+static void animation_storage_manifest_cache_clear(void) {
+    for(size_t i = 0; i < manifest_cache.count; ++i) {
+        free((void*)manifest_cache.items[i].name);
+    }
+    free(manifest_cache.items);
+    manifest_cache.items = NULL;
+    manifest_cache.count = 0;
+    manifest_cache.valid = false;
+}
+
+static bool animation_storage_manifest_cache_parse(Storage* storage) {
     FlipperFormat* file = flipper_format_file_alloc(storage);
+    /* Forbid skipping fields */
     flipper_format_set_strict_mode(file, true);
     string_t read_string;
     string_init(read_string);
+    bool result = false;
 
     do {
         uint32_t u32value;
-        if(FSE_OK != storage_sd_status(storage)) break;
         if(!flipper_format_file_open_existing(file, ANIMATION_MANIFEST_FILE)) break;
-
         if(!flipper_format_read_header(file, read_string, &u32value)) break;
         if(string_cmp_str(read_string, "Flipper Animation Manifest")) break;
 
-        manifest_info->name = NULL;
-
-        /* skip other animation names */
-        flipper_format_set_strict_mode(file, false);
-        while(flipper_format_read_string(file, "Name", read_string) &&
-              string_cmp_str(read_string, name))
-            ;
-        if(string_cmp_str(read_string, name)) break;
-        flipper_format_set_strict_mode(file, true);
-
-        manifest_info->name = malloc(string_size(read_string) + 1);
-        strcpy((char*)manifest_info->name, string_get_cstr(read_string));
-
-        if(!flipper_format_read_uint32(file, "Min butthurt", &u32value, 1)) break;
-        manifest_info->min_butthurt = u32value;
-        if(!flipper_format_read_uint32(file, "Max butthurt", &u32value, 1)) break;
-        manifest_info->max_butthurt = u32value;
-        if(!flipper_format_read_uint32(file, "Min level", &u32value, 1)) break;
-        manifest_info->min_level = u32value;
-        if(!flipper_format_read_uint32(file, "Max level", &u32value, 1)) break;
-        manifest_info->max_level = u32value;
-        if(!flipper_format_read_uint32(file, "Weight", &u32value, 1)) break;
-        manifest_info->weight = u32value;
+        /* read up to first incomplete record */
+        StorageAnimationManifestInfo manifest_info;
+        while(animation_storage_read_manifest_info(file, read_string, &manifest_info)) {
+            manifest_cache.items = realloc(
+                manifest_cache.items,
+                sizeof(StorageAnimationManifestInfo) * (manifest_cache.count + 1));
+            manifest_cache.items[manifest_cache.count++] = manifest_info;
+        }
         result = true;
     } while(0);
 
-    if(!result && manifest_info->name) {
-        free((void*)manifest_info->name);
-    }
     string_clear(read_string);
     flipper_format_free(file);
 
+    return result;
+}
+
+/* Reparse manifest only if it was changed or SD-card was remounted */
+static bool animation_storage_manifest_cache_update(Storage* storage) {
+    uint32_t generation = manifest_generation;
+    FileInfo file_info;
+
+    if((FSE_OK != storage_sd_status(storage)) ||
+       (FSE_OK != storage_common_stat(storage, ANIMATION_MANIFEST_FILE, &file_info))) {
+        animation_storage_manifest_cache_clear();
+        return false;
+    }
+
+    if(manifest_cache.valid && (manifest_cache.generation == generation) &&
+       (manifest_cache.manifest_size == file_info.size) &&
+       (manifest_cache.manifest_mtime == file_info.mtime)) {
+        return true;
+    }
+
+    animation_storage_manifest_cache_clear();
+    manifest_cache.valid = animation_storage_manifest_cache_parse(storage);
+    manifest_cache.generation = generation;
+    manifest_cache.manifest_size = file_info.size;
+    manifest_cache.manifest_mtime = file_info.mtime;
+
+    return manifest_cache.valid;
+}
+
+void animation_storage_invalidate_manifest(void) {
+    ++manifest_generation;
+}
+
+static bool animation_storage_load_single_manifest_info(
+    StorageAnimationManifestInfo* manifest_info,
+    const char* name) {
+    furi_assert(manifest_info);
+
+    bool result = false;
+    Storage* storage = furi_record_open("storage");
+    manifest_info->name = NULL;
+
+    if(animation_storage_manifest_cache_update(storage)) {
+        for(size_t i = 0; i < manifest_cache.count; ++i) {
+            if(!strcmp(manifest_cache.items[i].name, name)) {
+                animation_storage_copy_manifest_info(manifest_info, &manifest_cache.items[i]);
+                result = true;
+                break;
+            }
+        }
+    }
+
     furi_record_close("storage");
 
     return result;
@@ -85,49 +215,17 @@ void animation_storage_fill_animation_list(StorageAnimationList_t* animation_lis
     furi_assert(!StorageAnimationList_size(*animation_list));
 
     Storage* storage = furi_record_open("storage");
-    FlipperFormat* file = flipper_format_file_alloc(storage);
-    /* Forbid skipping fields */
-    flipper_format_set_strict_mode(file, true);
-    string_t read_string;
-    string_init(read_string);
 
-    do {
-        uint32_t u32value;
-        StorageAnimation* storage_animation = NULL;
-
-        if(FSE_OK != storage_sd_status(storage)) break;
-        if(!flipper_format_file_open_existing(file, ANIMATION_MANIFEST_FILE)) break;
-        if(!flipper_format_read_header(file, read_string, &u32value)) break;
-        if(string_cmp_str(read_string, "Flipper Animation Manifest")) break;
-        do {
-            storage_animation = malloc(sizeof(StorageAnimation));
+    if(animation_storage_manifest_cache_update(storage)) {
+        for(size_t i = 0; i < manifest_cache.count; ++i) {
+            StorageAnimation* storage_animation = malloc(sizeof(StorageAnimation));
             storage_animation->external = true;
             storage_animation->animation = NULL;
-            storage_animation->manifest_info.name = NULL;
-
-            if(!flipper_format_read_string(file, "Name", read_string)) break;
-            storage_animation->manifest_info.name = malloc(string_size(read_string) + 1);
-            strcpy((char*)storage_animation->manifest_info.name, string_get_cstr(read_string));
-
-            if(!flipper_format_read_uint32(file, "Min butthurt", &u32value, 1)) break;
-            storage_animation->manifest_info.min_butthurt = u32value;
-            if(!flipper_format_read_uint32(file, "Max butthurt", &u32value, 1)) break;
-            storage_animation->manifest_info.max_butthurt = u32value;
-            if(!flipper_format_read_uint32(file, "Min level", &u32value, 1)) break;
-            storage_animation->manifest_info.min_level = u32value;
-            if(!flipper_format_read_uint32(file, "Max level", &u32value, 1)) break;
-            storage_animation->manifest_info.max_level = u32value;
-            if(!flipper_format_read_uint32(file, "Weight", &u32value, 1)) break;
-            storage_animation->manifest_info.weight = u32value;
-
+            animation_storage_copy_manifest_info(
+                &storage_animation->manifest_info, &manifest_cache.items[i]);
             StorageAnimationList_push_back(*animation_list, storage_animation);
-        } while(1);
-
-        animation_storage_free_storage_animation(&storage_animation);
-    } while(0);
-
-    string_clear(read_string);
-    flipper_format_free(file);
+        }
+    }
 
     // add hard-coded animations
     for(int i = 0; i < dolphin_internal_size; ++i) {
@@ -162,6 +260,7 @@ StorageAnimation* animation_storage_find_animation(const char* name) {
     if(!storage_animation) {
         storage_animation = malloc(sizeof(StorageAnimation));
         storage_animation->external = true;
+        storage_animation->animation = NULL;
 
         bool result = false;
         result =
@@ -201,12 +300,160 @@ void animation_storage_cache_animation(StorageAnimation* storage_animation) {
     }
 }
 
+static void animation_storage_free_frame_stream(AnimationFrameStream* stream) {
+    furi_assert(stream);
+
+    storage_file_free(stream->file);
+    furi_record_close("storage");
+    if(stream->offsets) {
+        free(stream->offsets);
+    }
+    if(stream->buffer) {
+        free(stream->buffer);
+    }
+    free(stream);
+}
+
+/* Returns slot with frame, reads it to not recently used slot if missing */
+static int8_t animation_storage_stream_frame(AnimationFrameStream* stream, uint8_t frame) {
+    for(int i = 0; i < ANIMATION_STREAM_SLOTS; ++i) {
+        if(stream->slot_frame[i] == frame) {
+            return i;
+        }
+    }
+
+    uint8_t slot = (stream->last_slot + 1) % ANIMATION_STREAM_SLOTS;
+    size_t frame_size = stream->offsets[frame + 1] - stream->offsets[frame];
+    stream->slot_frame[slot] = -1;
+
+    if(!storage_file_seek(stream->file, stream->offsets[frame], true)) return -1;
+    if(storage_file_read(stream->file, &stream->buffer[slot * stream->slot_size], frame_size) !=
+       frame_size) {
+        FURI_LOG_E(TAG, "Frame %d read failed", frame);
+        return -1;
+    }
+
+    stream->slot_frame[slot] = frame;
+    return slot;
+}
+
+const uint8_t*
+    animation_storage_get_frame(const BubbleAnimation* animation, uint8_t frame, size_t* size) {
+    furi_assert(animation);
+    furi_assert(frame < animation->icon_animation.frame_count);
+
+    AnimationFrameStream* stream = animation->frame_stream;
+    if(!stream) {
+        if(size) {
+            const Icon* icon = &animation->icon_animation;
+            *size = ROUND_UP_TO(icon->width, 8) * icon->height + 1;
+        }
+        return animation->icon_animation.frames[frame];
+    }
+
+    int8_t slot = animation_storage_stream_frame(stream, frame);
+    if(slot < 0) {
+        return NULL;
+    }
+
+    stream->last_slot = slot;
+    if(size) {
+        *size = stream->offsets[frame + 1] - stream->offsets[frame];
+    }
+    return &stream->buffer[slot * stream->slot_size];
+}
+
+void animation_storage_prefetch_frame(const BubbleAnimation* animation, uint8_t frame) {
+    furi_assert(animation);
+    furi_assert(frame < animation->icon_animation.frame_count);
+
+    if(animation->frame_stream) {
+        animation_storage_stream_frame(animation->frame_stream, frame);
+    }
+}
+
+struct AnimationFrameDecoder {
+    heatshrink_decoder* decoder;
+    /* input buffer, then expansion window */
+    uint8_t buffer[ANIMATION_DECODER_INPUT_SIZE + (1 << FURI_HAL_COMPRESS_EXP_BUFF_SIZE_LOG)];
+};
+
+AnimationFrameDecoder* animation_storage_frame_decoder_alloc(void) {
+    AnimationFrameDecoder* decoder = malloc(sizeof(AnimationFrameDecoder));
+    decoder->decoder = heatshrink_decoder_alloc(
+        decoder->buffer,
+        ANIMATION_DECODER_INPUT_SIZE,
+        FURI_HAL_COMPRESS_EXP_BUFF_SIZE_LOG,
+        FURI_HAL_COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG);
+    return decoder;
+}
+
+void animation_storage_frame_decoder_free(AnimationFrameDecoder* decoder) {
+    furi_assert(decoder);
+    heatshrink_decoder_free(decoder->decoder);
+    free(decoder);
+}
+
+bool animation_storage_decode_frame(
+    AnimationFrameDecoder* decoder,
+    const BubbleAnimation* animation,
+    uint8_t frame,
+    uint8_t* bitmap) {
+    furi_assert(decoder);
+    furi_assert(bitmap);
+
+    const uint8_t* data = animation_storage_get_frame(animation, frame, NULL);
+    if(!data) {
+        return false;
+    }
+
+    const Icon* icon = &animation->icon_animation;
+    size_t bitmap_size = ROUND_UP_TO(icon->width, 8) * icon->height;
+    /* same header as in furi_hal_compress_icon_decode() */
+    if(!data[0]) {
+        memcpy(bitmap, &data[1], bitmap_size);
+        return true;
+    }
+
+    size_t compressed_size = data[2] | (data[3] << 8);
+    size_t sunk = 0;
+    size_t decoded = 0;
+    size_t processed = 0;
+    heatshrink_decoder_reset(decoder->decoder);
+    memset(decoder->buffer, 0, sizeof(decoder->buffer));
+
+    while(sunk < compressed_size) {
+        heatshrink_decoder_sink(
+            decoder->decoder, (uint8_t*)&data[4 + sunk], compressed_size - sunk, &processed);
+        sunk += processed;
+        HSD_poll_res res;
+        do {
+            res = heatshrink_decoder_poll(
+                decoder->decoder, &bitmap[decoded], bitmap_size - decoded, &processed);
+            decoded += processed;
+        } while((res == HSDR_POLL_MORE) && (decoded < bitmap_size));
+        if(res < 0 || decoded == bitmap_size) {
+            break;
+        }
+    }
+
+    if(decoded != bitmap_size) {
+        FURI_LOG_E(TAG, "Frame %d decode failed", frame);
+        return false;
+    }
+    return true;
+}
+
 static void animation_storage_free_animation(BubbleAnimation** animation) {
     furi_assert(animation);
 
     if(*animation) {
         animation_storage_free_bubbles(*animation);
-        animation_storage_free_frames(*animation);
+        if((*animation)->frame_stream) {
+            animation_storage_free_frame_stream((*animation)->frame_stream);
+        } else {
+            animation_storage_free_frames(*animation);
+        }
         if((*animation)->frame_order) {
             free((void*)(*animation)->frame_order);
         }
@@ -427,8 +674,197 @@ static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFo
     return success;
 }
 
-static BubbleAnimation* animation_storage_load_animation(const char* name) {
-    furi_assert(name);
+static bool animation_storage_check_bundle_header(const AnimationBundleHeader* header) {
+    if(header->magic != ANIMATION_BUNDLE_MAGIC) return false;
+    if(header->version != ANIMATION_BUNDLE_VERSION) return false;
+    if((header->width == 0) || (header->width > 128)) return false;
+    if((header->height == 0) || (header->height > 128)) return false;
+    if((header->frame_count == 0) || (header->passive_frames == 0)) return false;
+    if(header->frame_rate == 0) return false;
+    if(header->bubble_slots > 20) return false;
+
+    return true;
+}
+
+static bool animation_storage_check_bundle_frames(
+    const AnimationBundleHeader* header,
+    const uint8_t* frame_order,
+    AnimationFrameStream* stream,
+    uint32_t data_offset) {
+    uint16_t frame_order_count = header->passive_frames + header->active_frames;
+    for(int i = 0; i < frame_order_count; ++i) {
+        if(frame_order[i] >= header->frame_count) return false;
+    }
+
+    size_t max_frame_size = ROUND_UP_TO(header->width, 8) * header->height + 1;
+    if(stream->offsets[0] < data_offset) return false;
+
+    stream->slot_size = 0;
+    for(int i = 0; i < header->frame_count; ++i) {
+        if(stream->offsets[i + 1] <= stream->offsets[i]) return false;
+        size_t frame_size = stream->offsets[i + 1] - stream->offsets[i];
+        if(frame_size > max_frame_size) return false;
+        stream->slot_size = MAX(stream->slot_size, frame_size);
+    }
+
+    return true;
+}
+
+static bool animation_storage_load_bundle_bubbles(
+    BubbleAnimation* animation,
+    File* file,
+    const AnimationBundleHeader* header) {
+    furi_assert(!animation->frame_bubble_sequences);
+
+    animation->frame_bubble_sequences_count = header->bubble_slots;
+    if(animation->frame_bubble_sequences_count == 0) {
+        return header->bubble_count == 0;
+    }
+
+    animation->frame_bubble_sequences =
+        malloc(sizeof(FrameBubble*) * animation->frame_bubble_sequences_count);
+    for(int i = 0; i < animation->frame_bubble_sequences_count; ++i) {
+        FURI_CONST_ASSIGN_PTR(animation->frame_bubble_sequences[i], malloc(sizeof(FrameBubble)));
+    }
+
+    const FrameBubble* bubble = animation->frame_bubble_sequences[0];
+    int8_t index = -1;
+    bool records_ok = true;
+    for(int i = 0; i < header->bubble_count; ++i) {
+        records_ok = false;
+        AnimationBundleBubble record;
+        if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+
+        /* same slots order rules as in meta.txt */
+        if(record.slot == index) {
+            FURI_CONST_ASSIGN_PTR(bubble->next_bubble, malloc(sizeof(FrameBubble)));
+            bubble = bubble->next_bubble;
+        } else if(record.slot == index + 1) {
+            ++index;
+            if(index >= animation->frame_bubble_sequences_count) break;
+            bubble = animation->frame_bubble_sequences[index];
+        } else {
+            break;
+        }
+
+        if((record.align_h > AlignCenter) || (record.align_v > AlignCenter)) break;
+        if(record.text_length > 100) break;
+
+        FrameBubble* frame_bubble = (FrameBubble*)bubble;
+        frame_bubble->bubble.x = record.x;
+        frame_bubble->bubble.y = record.y;
+        frame_bubble->bubble.align_h = record.align_h;
+        frame_bubble->bubble.align_v = record.align_v;
+        frame_bubble->start_frame = record.start_frame;
+        frame_bubble->end_frame = record.end_frame;
+
+        char* text = malloc(record.text_length + 1);
+        frame_bubble->bubble.text = text;
+        if(storage_file_read(file, text, record.text_length) != record.text_length) break;
+        text[record.text_length] = '\0';
+        records_ok = true;
+    }
+
+    bool success = records_ok && ((index + 1) == animation->frame_bubble_sequences_count);
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to load animation bubbles");
+        animation_storage_free_bubbles(animation);
+    }
+
+    return success;
+}
+
+static BubbleAnimation* animation_storage_load_bundle(const char* name) {
+    Storage* storage = furi_record_open("storage");
+    BubbleAnimation* animation = malloc(sizeof(BubbleAnimation));
+    animation->frame_bubble_sequences = NULL;
+    animation->frame_order = NULL;
+    animation->frame_stream = NULL;
+
+    AnimationFrameStream* stream = malloc(sizeof(AnimationFrameStream));
+    stream->file = storage_file_alloc(storage);
+    stream->offsets = NULL;
+    stream->buffer = NULL;
+
+    uint8_t* table = NULL;
+    string_t path;
+    string_init_printf(path, ANIMATION_DIR "/%s" ANIMATION_BUNDLE_EXT, name);
+
+    bool success = false;
+    do {
+        AnimationBundleHeader header;
+
+        if(FSE_OK != storage_sd_status(storage)) break;
+        if(!storage_file_open(
+               stream->file, string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(storage_file_read(stream->file, &header, sizeof(header)) != sizeof(header)) break;
+        if(!animation_storage_check_bundle_header(&header)) {
+            FURI_LOG_E(TAG, "Invalid bundle header: \'%s\'", string_get_cstr(path));
+            break;
+        }
+
+        /* frames order and offsets table are read at once */
+        uint16_t frame_order_count = header.passive_frames + header.active_frames;
+        size_t offsets_size = sizeof(uint32_t) * (header.frame_count + 1);
+        size_t table_size = frame_order_count + offsets_size;
+        table = malloc(table_size);
+        if(storage_file_read(stream->file, table, table_size) != table_size) break;
+
+        animation->frame_order = malloc(frame_order_count);
+        memcpy((void*)animation->frame_order, table, frame_order_count);
+        stream->offsets = malloc(offsets_size);
+        memcpy(stream->offsets, &table[frame_order_count], offsets_size);
+
+        if(!animation_storage_check_bundle_frames(
+               &header, animation->frame_order, stream, sizeof(header) + table_size)) {
+            FURI_LOG_E(TAG, "Invalid bundle frames: \'%s\'", string_get_cstr(path));
+            break;
+        }
+        if(!animation_storage_load_bundle_bubbles(animation, stream->file, &header)) break;
+
+        animation->passive_frames = header.passive_frames;
+        animation->active_frames = header.active_frames;
+        animation->active_cycles = header.active_cycles;
+        animation->duration = header.duration;
+        animation->active_cooldown = header.active_cooldown;
+
+        Icon* icon = (Icon*)&animation->icon_animation;
+        FURI_CONST_ASSIGN(icon->frame_count, header.frame_count);
+        FURI_CONST_ASSIGN(icon->frame_rate, header.frame_rate);
+        FURI_CONST_ASSIGN(icon->height, header.height);
+        FURI_CONST_ASSIGN(icon->width, header.width);
+        icon->frames = NULL;
+
+        stream->buffer = malloc(stream->slot_size * ANIMATION_STREAM_SLOTS);
+        for(int i = 0; i < ANIMATION_STREAM_SLOTS; ++i) {
+            stream->slot_frame[i] = -1;
+        }
+        stream->last_slot = 0;
+        animation->frame_stream = stream;
+        success = true;
+    } while(0);
+
+    string_clear(path);
+    if(table) {
+        free(table);
+    }
+
+    if(!success) {
+        /* stream owns storage record */
+        animation_storage_free_frame_stream(stream);
+        if(animation->frame_order) {
+            free((void*)animation->frame_order);
+        }
+        free(animation);
+        animation = NULL;
+    }
+
+    return animation;
+}
+
+static BubbleAnimation* animation_storage_load_directory(const char* name) {
     BubbleAnimation* animation = malloc(sizeof(BubbleAnimation));
 
     uint32_t height = 0;
@@ -441,6 +877,7 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     string_t str;
     string_init(str);
     animation->frame_bubble_sequences = NULL;
+    animation->frame_stream = NULL;
 
     bool success = false;
     do {
@@ -509,6 +946,18 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     return animation;
 }
 
+static BubbleAnimation* animation_storage_load_animation(const char* name) {
+    furi_assert(name);
+
+    /* bundle is preferred, directory with meta.txt and frames is fallback */
+    BubbleAnimation* animation = animation_storage_load_bundle(name);
+    if(!animation) {
+        animation = animation_storage_load_directory(name);
+    }
+
+    return animation;
+}
+
 static void animation_storage_free_bubbles(BubbleAnimation* animation) {
     if(!animation->frame_bubble_sequences) return;
 
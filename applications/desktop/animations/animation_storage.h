@@ -82,6 +82,71 @@ StorageAnimationManifestInfo* animation_storage_get_meta(StorageAnimation* stora
  */
 void animation_storage_free_storage_animation(StorageAnimation** storage_animation);
 
+/**
+ * Get frame bitmap of bubble animation.
+ * Frames of animations loaded from bundle are streamed from
+ * SD-card and only 2 of them are kept in memory, so returned
+ * pointer is valid until next frame request for same animation.
+ *
+ * @animation       bubble animation
+ * @frame           frame number in icon_animation
+ * @size            if not NULL, upper bound of frame data size
+ * @return          frame bitmap, NULL if failed to read
+ */
+const uint8_t*
+    animation_storage_get_frame(const BubbleAnimation* animation, uint8_t frame, size_t* size);
+
+/**
+ * Read frame ahead, so next animation_storage_get_frame()
+ * for it doesn't wait for SD-card. Does nothing for
+ * animations with all frames in memory.
+ *
+ * @animation       bubble animation
+ * @frame           frame number in icon_animation
+ */
+void animation_storage_prefetch_frame(const BubbleAnimation* animation, uint8_t frame);
+
+/** Frame decoder, each user owns one: GUI icon decoder is shared
+ * and may be used only from GUI thread */
+typedef struct AnimationFrameDecoder AnimationFrameDecoder;
+
+/**
+ * Allocate frame decoder.
+ *
+ * @return          frame decoder
+ */
+AnimationFrameDecoder* animation_storage_frame_decoder_alloc(void);
+
+/**
+ * Free frame decoder.
+ *
+ * @decoder         frame decoder
+ */
+void animation_storage_frame_decoder_free(AnimationFrameDecoder* decoder);
+
+/**
+ * Get frame and decode it to XBM bitmap, ready for canvas_draw_xbm().
+ * Streamed frames are read from SD-card, so don't call it
+ * from draw callback.
+ *
+ * @decoder         frame decoder
+ * @animation       bubble animation
+ * @frame           frame number in icon_animation
+ * @bitmap          ROUND_UP_TO(width, 8) * height bytes of icon_animation
+ * @return          true if frame is decoded
+ */
+bool animation_storage_decode_frame(
+    AnimationFrameDecoder* decoder,
+    const BubbleAnimation* animation,
+    uint8_t frame,
+    uint8_t* bitmap);
+
+/**
+ * Drop cached manifest, so it is parsed again on next
+ * animation list request. Call on SD-card change.
+ */
+void animation_storage_invalidate_manifest(void);
+
 /**
  * Has to be called at least 1 time to initialize runtime structures
  * of animations in inner flash.
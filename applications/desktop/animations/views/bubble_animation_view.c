@@ -27,35 +27,95 @@ typedef struct {
     uint8_t active_shift;
     TickType_t active_ended_at;
     Icon* freeze_frame;
+    /* current frame, decoded out of GUI and timer threads */
+    uint8_t* bitmap;
+    bool bitmap_valid;
 } BubbleAnimationViewModel;
 
 struct BubbleAnimationView {
     View* view;
     osTimerId_t timer;
+    /* guards frame stream and back bitmap: SD-card is read under it, not under
+     * model lock. Taken before model lock. */
+    osMutexId_t frame_mutex;
+    AnimationFrameDecoder* decoder;
+    /* next frame is decoded here, then swapped with model bitmap */
+    uint8_t* back_bitmap;
     BubbleAnimationInteractCallback interact_callback;
     void* interact_callback_context;
+    BubbleAnimationFrameCallback frame_callback;
+    void* frame_callback_context;
 };
 
 static void bubble_animation_activate(BubbleAnimationView* view, bool force);
 static void bubble_animation_activate_right_now(BubbleAnimationView* view);
 
-static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model) {
-    furi_assert(model);
+static uint8_t
+    bubble_animation_get_frame_index(const BubbleAnimation* animation, uint8_t current_frame) {
+    furi_assert(animation);
     uint8_t icon_index = 0;
-    const BubbleAnimation* animation = model->current;
 
-    if(model->current_frame < animation->passive_frames) {
-        icon_index = model->current_frame;
+    if(current_frame < animation->passive_frames) {
+        icon_index = current_frame;
     } else {
-        icon_index =
-            (model->current_frame - animation->passive_frames) % animation->active_frames +
-            animation->passive_frames;
+        icon_index = (current_frame - animation->passive_frames) % animation->active_frames +
+                     animation->passive_frames;
     }
     furi_assert(icon_index < (animation->passive_frames + animation->active_frames));
 
     return animation->frame_order[icon_index];
 }
 
+/* Called with frame mutex taken, frame is usually prefetched already.
+ * Decoding runs without model lock, so drawing is not blocked by it. */
+static void bubble_animation_load_frame(BubbleAnimationView* view) {
+    BubbleAnimationViewModel* model = view_get_model(view->view);
+    const BubbleAnimation* animation = model->current;
+    uint8_t current_frame = model->current_frame;
+    view_commit_model(view->view, false);
+
+    if(!animation) {
+        return;
+    }
+
+    uint8_t index = bubble_animation_get_frame_index(animation, current_frame);
+    bool valid =
+        animation_storage_decode_frame(view->decoder, animation, index, view->back_bitmap);
+
+    model = view_get_model(view->view);
+    uint8_t* bitmap = model->bitmap;
+    model->bitmap = view->back_bitmap;
+    model->bitmap_valid = valid;
+    view->back_bitmap = bitmap;
+    view_commit_model(view->view, true);
+}
+
+/* Streamed animations keep only current and next frame, read next
+ * one while current is shown. Model lock is released before reading. */
+static void bubble_animation_prefetch_next_frame(BubbleAnimationView* view) {
+    /* animation can't be replaced and freed until frame mutex is released */
+    furi_check(osMutexAcquire(view->frame_mutex, osWaitForever) == osOK);
+    BubbleAnimationViewModel* model = view_get_model(view->view);
+    const BubbleAnimation* animation = model->current;
+    if(!animation || model->freeze_frame) {
+        view_commit_model(view->view, false);
+        osMutexRelease(view->frame_mutex);
+        return;
+    }
+
+    uint8_t next_frame = model->current_frame + 1;
+    if(model->active_shift == 1) {
+        next_frame = animation->passive_frames;
+    } else if(model->current_frame < animation->passive_frames) {
+        next_frame %= animation->passive_frames;
+    }
+    uint8_t index = bubble_animation_get_frame_index(animation, next_frame);
+    view_commit_model(view->view, false);
+
+    animation_storage_prefetch_frame(animation, index);
+    osMutexRelease(view->frame_mutex);
+}
+
 static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     furi_assert(model_);
     furi_assert(canvas);
@@ -75,12 +135,12 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
 
     furi_assert(model->current_frame < 255);
 
-    uint8_t index = bubble_animation_get_frame_index(model);
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    if(model->bitmap_valid) {
+        canvas_draw_xbm(canvas, 0, y_offset, width, height, model->bitmap);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -182,13 +242,18 @@ static void bubble_animation_activate_right_now(BubbleAnimationView* view) {
 
     uint8_t frame_rate = 0;
 
+    furi_check(osMutexAcquire(view->frame_mutex, osWaitForever) == osOK);
     BubbleAnimationViewModel* model = view_get_model(view->view);
     if(model->current && (model->current->active_frames > 0) && (!model->freeze_frame)) {
         model->current_frame = model->current->passive_frames;
         model->current_bubble = bubble_animation_pick_bubble(model, true);
         frame_rate = model->current->icon_animation.frame_rate;
     }
-    view_commit_model(view->view, true);
+    view_commit_model(view->view, !frame_rate);
+    if(frame_rate) {
+        bubble_animation_load_frame(view);
+    }
+    osMutexRelease(view->frame_mutex);
 
     if(frame_rate) {
         osTimerStart(view->timer, 1000 / frame_rate);
@@ -225,11 +290,23 @@ static void bubble_animation_next_frame(BubbleAnimationViewModel* model) {
     }
 }
 
+/* Timer task only asks owner thread to advance the frame: reading SD-card
+ * and decoding there would stall all software timers */
 static void bubble_animation_timer_callback(void* context) {
     furi_assert(context);
     BubbleAnimationView* view = context;
+
+    if(view->frame_callback) {
+        view->frame_callback(view->frame_callback_context);
+    }
+}
+
+void bubble_animation_view_process_frame(BubbleAnimationView* view) {
+    furi_assert(view);
     bool activate = false;
+    bool load = false;
 
+    furi_check(osMutexAcquire(view->frame_mutex, osWaitForever) == osOK);
     BubbleAnimationViewModel* model = view_get_model(view->view);
 
     if(model->active_shift > 0) {
@@ -238,23 +315,30 @@ static void bubble_animation_timer_callback(void* context) {
 
     if(!model->freeze_frame && !activate) {
         bubble_animation_next_frame(model);
+        load = true;
     }
 
-    view_commit_model(view->view, !activate);
+    view_commit_model(view->view, !activate && !load);
+
+    if(load) {
+        bubble_animation_load_frame(view);
+    }
+    osMutexRelease(view->frame_mutex);
 
     if(activate) {
         bubble_animation_activate_right_now(view);
     }
+
+    bubble_animation_prefetch_next_frame(view);
 }
 
 /* always freeze first passive frame, because
  * animation is always activated at unfreezing and played
  * passive frame first, and 2 frames after - active
  */
-static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
-    furi_assert(icon_orig);
-    furi_assert(icon_orig->frames);
-    furi_assert(icon_orig->frames[0]);
+static Icon* bubble_animation_clone_first_frame(const BubbleAnimation* animation) {
+    furi_assert(animation);
+    const Icon* icon_orig = &animation->icon_animation;
 
     Icon* icon_clone = malloc(sizeof(Icon));
     memcpy(icon_clone, icon_orig, sizeof(Icon));
@@ -266,8 +350,15 @@ static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
      * for compressed header
      */
     size_t max_bitmap_size = ROUND_UP_TO(icon_orig->width, 8) * icon_orig->height + 1;
+    size_t frame_size = 0;
+    const uint8_t* frame = animation_storage_get_frame(animation, 0, &frame_size);
     FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], malloc(max_bitmap_size));
-    memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    if(frame) {
+        memcpy((void*)icon_clone->frames[0], frame, frame_size);
+    } else {
+        /* blank uncompressed bitmap */
+        memset((void*)icon_clone->frames[0], 0, max_bitmap_size);
+    }
     FURI_CONST_ASSIGN(icon_clone->frame_count, 1);
 
     return icon_clone;
@@ -308,6 +399,8 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
     view->view = view_alloc();
     view->interact_callback = NULL;
     view->timer = osTimerNew(bubble_animation_timer_callback, osTimerPeriodic, view, NULL);
+    view->frame_mutex = osMutexNew(NULL);
+    view->decoder = animation_storage_frame_decoder_alloc();
 
     view_allocate_model(view->view, ViewModelTypeLocking, sizeof(BubbleAnimationViewModel));
     view_set_context(view->view, view);
@@ -326,8 +419,19 @@ void bubble_animation_view_free(BubbleAnimationView* view) {
     view_set_input_callback(view->view, NULL);
     view_set_context(view->view, NULL);
 
+    BubbleAnimationViewModel* model = view_get_model(view->view);
+    if(model->bitmap) {
+        free(model->bitmap);
+    }
+    view_commit_model(view->view, false);
+    if(view->back_bitmap) {
+        free(view->back_bitmap);
+    }
+
     view_free(view->view);
     view->view = NULL;
+    animation_storage_frame_decoder_free(view->decoder);
+    osMutexDelete(view->frame_mutex);
     free(view);
 }
 
@@ -341,16 +445,43 @@ void bubble_animation_view_set_interact_callback(
     view->interact_callback = callback;
 }
 
+void bubble_animation_view_set_frame_callback(
+    BubbleAnimationView* view,
+    BubbleAnimationFrameCallback callback,
+    void* context) {
+    furi_assert(view);
+
+    view->frame_callback_context = context;
+    view->frame_callback = callback;
+}
+
 void bubble_animation_view_set_animation(
     BubbleAnimationView* view,
     const BubbleAnimation* new_animation) {
     furi_assert(view);
     furi_assert(new_animation);
 
+    /* new animation isn't shared yet, read its first frame without locks */
+    animation_storage_prefetch_frame(new_animation, new_animation->frame_order[0]);
+
+    /* previous animation is freed after return, wait for its prefetch */
+    furi_check(osMutexAcquire(view->frame_mutex, osWaitForever) == osOK);
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model);
     model->current = new_animation;
 
+    const Icon* icon = &new_animation->icon_animation;
+    size_t bitmap_size = ROUND_UP_TO(icon->width, 8) * icon->height;
+    if(model->bitmap) {
+        free(model->bitmap);
+    }
+    model->bitmap = malloc(bitmap_size);
+    model->bitmap_valid = false;
+    if(view->back_bitmap) {
+        free(view->back_bitmap);
+    }
+    view->back_bitmap = malloc(bitmap_size);
+
     model->active_ended_at = xTaskGetTickCount() - (model->current->active_cooldown * 1000);
     model->active_bubbles = 0;
     model->passive_bubbles = 0;
@@ -366,7 +497,9 @@ void bubble_animation_view_set_animation(
     model->current_bubble = bubble_animation_pick_bubble(model, false);
     model->current_frame = 0;
     model->active_cycle = 0;
-    view_commit_model(view->view, true);
+    view_commit_model(view->view, false);
+    bubble_animation_load_frame(view);
+    osMutexRelease(view->frame_mutex);
 
     osTimerStart(view->timer, 1000 / new_animation->icon_animation.frame_rate);
 }
@@ -374,12 +507,16 @@ void bubble_animation_view_set_animation(
 void bubble_animation_freeze(BubbleAnimationView* view) {
     furi_assert(view);
 
+    /* animation is freed after return, wait for its prefetch */
+    furi_check(osMutexAcquire(view->frame_mutex, osWaitForever) == osOK);
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model->current);
     furi_assert(!model->freeze_frame);
-    model->freeze_frame = bubble_animation_clone_first_frame(&model->current->icon_animation);
+    model->freeze_frame = bubble_animation_clone_first_frame(model->current);
     model->current = NULL;
+    model->bitmap_valid = false;
     view_commit_model(view->view, false);
+    osMutexRelease(view->frame_mutex);
     osTimerStop(view->timer);
 }
 
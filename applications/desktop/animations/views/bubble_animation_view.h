@@ -9,6 +9,9 @@ typedef struct BubbleAnimationView BubbleAnimationView;
 /** Callback type to be called when interact button pressed */
 typedef void (*BubbleAnimationInteractCallback)(void*);
 
+/** Callback type to be called from timer when next frame is due */
+typedef void (*BubbleAnimationFrameCallback)(void*);
+
 /**
  * Allocate bubble animation view.
  * This is animation with bubbles, and 2 phases:
@@ -38,6 +41,28 @@ void bubble_animation_view_set_interact_callback(
     BubbleAnimationInteractCallback callback,
     void* context);
 
+/**
+ * Set callback for frame timer.
+ * Called from timer task, it must only pass the event to the thread
+ * that calls bubble_animation_view_process_frame().
+ *
+ * @view        bubble animation view instance
+ * @callback    callback to call when next frame is due
+ * @context     context
+ */
+void bubble_animation_view_set_frame_callback(
+    BubbleAnimationView* view,
+    BubbleAnimationFrameCallback callback,
+    void* context);
+
+/**
+ * Advance animation by one frame: reads and decodes it.
+ * Call in owner thread as a response to frame callback.
+ *
+ * @view        bubble animation view instance
+ */
+void bubble_animation_view_process_frame(BubbleAnimationView* view);
+
 /**
  * Set new animation.
  * BubbleAnimation doesn't posses Bubble Animation object
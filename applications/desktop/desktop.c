@@ -25,6 +25,15 @@ static void desktop_loader_callback(const void* message, void* context) {
     }
 }
 
+static void desktop_animation_frame_callback(void* context) {
+    furi_assert(context);
+    Desktop* desktop = context;
+    // One frame event in queue at most: slow frames are dropped, timer task never blocks
+    if(!__atomic_exchange_n(&desktop->animation_frame_pending, true, __ATOMIC_ACQ_REL)) {
+        view_dispatcher_send_custom_event(desktop->view_dispatcher, DesktopGlobalAnimationFrame);
+    }
+}
+
 static void desktop_lock_icon_callback(Canvas* canvas, void* context) {
     furi_assert(canvas);
     canvas_draw_icon(canvas, 0, 0, &I_Lock_8x8);
@@ -41,6 +50,10 @@ static bool desktop_custom_event_callback(void* context, uint32_t event) {
     case DesktopGlobalAfterAppFinished:
         animation_manager_load_and_continue_animation(desktop->animation_manager);
         return true;
+    case DesktopGlobalAnimationFrame:
+        __atomic_store_n(&desktop->animation_frame_pending, false, __ATOMIC_RELEASE);
+        animation_manager_frame_process(desktop->animation_manager);
+        return true;
     }
 
     return scene_manager_handle_custom_event(desktop->scene_manager, event);
@@ -78,6 +91,8 @@ Desktop* desktop_alloc() {
         desktop->view_dispatcher, desktop_custom_event_callback);
     view_dispatcher_set_navigation_event_callback(
         desktop->view_dispatcher, desktop_back_event_callback);
+    animation_manager_set_frame_callback(
+        desktop->animation_manager, desktop_animation_frame_callback, desktop);
 
     desktop->lock_menu = desktop_lock_menu_alloc();
     desktop->debug_view = desktop_debug_alloc();
@@ -59,6 +59,8 @@ struct Desktop {
     ViewPort* lock_viewport;
 
     AnimationManager* animation_manager;
+    /* frame event is in view dispatcher queue */
+    bool animation_frame_pending;
     Loader* loader;
     FuriPubSubSubscription* app_start_stop_subscription;
 };
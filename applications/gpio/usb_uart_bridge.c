@@ -5,7 +5,8 @@
 #include "usb_cdc.h"
 
 #define USB_CDC_PKT_LEN CDC_DATA_SZ
-#define USB_UART_RX_BUF_SIZE (USB_CDC_PKT_LEN * 5)
+#define USB_UART_RX_BUF_SIZE (USB_CDC_PKT_LEN * 8)
+#define USB_UART_DMA_BUF_SIZE (USB_CDC_PKT_LEN * 4)
 
 #define USB_CDC_BIT_DTR (1 << 0)
 #define USB_CDC_BIT_RTS (1 << 1)
@@ -51,6 +52,7 @@ struct UsbUartBridge {
     UsbUartState st;
 
     uint8_t rx_buf[USB_CDC_PKT_LEN];
+    uint8_t dma_buf[USB_UART_DMA_BUF_SIZE];
 };
 
 static void vcp_on_cdc_tx_complete(void* context);
@@ -71,15 +73,15 @@ static const CdcCallbacks cdc_cb = {
 
 static int32_t usb_uart_tx_thread(void* context);
 
-static void usb_uart_on_irq_cb(UartIrqEvent ev, uint8_t data, void* context) {
+static void usb_uart_on_dma_rx_cb(uint8_t* data, size_t size, void* context) {
     UsbUartBridge* usb_uart = (UsbUartBridge*)context;
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    if(ev == UartIrqEventRXNE) {
-        xStreamBufferSendFromISR(usb_uart->rx_stream, &data, 1, &xHigherPriorityTaskWoken);
-        osThreadFlagsSet(furi_thread_get_thread_id(usb_uart->thread), WorkerEvtRxDone);
-        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-    }
+    size_t sent =
+        xStreamBufferSendFromISR(usb_uart->rx_stream, data, size, &xHigherPriorityTaskWoken);
+    FURI_TRACE_POINT(FuriTraceUsbUartRx, size, sent);
+    osThreadFlagsSet(furi_thread_get_thread_id(usb_uart->thread), WorkerEvtRxDone);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 static void usb_uart_vcp_init(UsbUartBridge* usb_uart, uint8_t vcp_ch) {
@@ -104,11 +106,12 @@ static void usb_uart_serial_init(UsbUartBridge* usb_uart, uint8_t uart_ch) {
     } else if(uart_ch == FuriHalUartIdLPUART1) {
         furi_hal_uart_init(uart_ch, 115200);
     }
-    furi_hal_uart_set_irq_cb(uart_ch, usb_uart_on_irq_cb, usb_uart);
+    furi_hal_uart_dma_rx_start(
+        uart_ch, usb_uart->dma_buf, USB_UART_DMA_BUF_SIZE, usb_uart_on_dma_rx_cb, usb_uart);
 }
 
 static void usb_uart_serial_deinit(UsbUartBridge* usb_uart, uint8_t uart_ch) {
-    furi_hal_uart_set_irq_cb(uart_ch, NULL, NULL);
+    furi_hal_uart_dma_rx_stop(uart_ch);
     if(uart_ch == FuriHalUartIdUSART1)
         furi_hal_console_enable();
     else if(uart_ch == FuriHalUartIdLPUART1)
@@ -177,9 +180,10 @@ static int32_t usb_uart_worker(void* context) {
         furi_check((events & osFlagsError) == 0);
         if(events & WorkerEvtStop) break;
         if(events & WorkerEvtRxDone) {
-            size_t len =
-                xStreamBufferReceive(usb_uart->rx_stream, usb_uart->rx_buf, USB_CDC_PKT_LEN, 0);
-            if(len > 0) {
+            // DMA delivers data in chunks, drain everything in full CDC packets
+            size_t len;
+            while((len = xStreamBufferReceive(
+                       usb_uart->rx_stream, usb_uart->rx_buf, USB_CDC_PKT_LEN, 0)) > 0) {
                 if(osSemaphoreAcquire(usb_uart->tx_sem, 100) == osOK) {
                     usb_uart->st.rx_cnt += len;
                     furi_check(osMutexAcquire(usb_uart->usb_mutex, osWaitForever) == osOK);
@@ -187,6 +191,7 @@ static int32_t usb_uart_worker(void* context) {
                     furi_check(osMutexRelease(usb_uart->usb_mutex) == osOK);
                 } else {
                     xStreamBufferReset(usb_uart->rx_stream);
+                    break;
                 }
             }
         }
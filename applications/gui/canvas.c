@@ -14,13 +14,54 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
     [FontBigNumbers] = {.leading_default = 18, .leading_min = 16, .height = 15, .descender = 0},
 };
 
+static void canvas_dirty_area_reset(CanvasDirtyArea* area) {
+    area->x_min = UINT8_MAX;
+    area->y_min = UINT8_MAX;
+    area->x_max = 0;
+    area->y_max = 0;
+}
+
+static void canvas_dirty_area_add(
+    CanvasDirtyArea* area,
+    uint8_t x_min,
+    uint8_t y_min,
+    uint8_t x_max,
+    uint8_t y_max) {
+    if(x_min < area->x_min) area->x_min = x_min;
+    if(y_min < area->y_min) area->y_min = y_min;
+    if(x_max > area->x_max) area->x_max = x_max;
+    if(y_max > area->y_max) area->y_max = y_max;
+}
+
+// Every u8g2 primitive ends here with clipped, rotated buffer coordinates
+static void canvas_ll_hvline(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t len,
+    uint8_t dir) {
+    // fb is the first member of Canvas
+    Canvas* canvas = (Canvas*)u8g2;
+    if(dir == 0) {
+        canvas_dirty_area_add(&canvas->dirty, x, y, x + len - 1, y);
+    } else {
+        canvas_dirty_area_add(&canvas->dirty, x, y, x, y + len - 1);
+    }
+    canvas->ll_hvline(u8g2, x, y, len, dir);
+}
+
 Canvas* canvas_init() {
     Canvas* canvas = malloc(sizeof(Canvas));
+    memset(canvas, 0, sizeof(Canvas));
 
     furi_hal_power_insomnia_enter();
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
+    canvas->ll_hvline = canvas->fb.ll_hvline;
+    canvas->fb.ll_hvline = canvas_ll_hvline;
+    canvas_dirty_area_reset(&canvas->dirty);
+    canvas_dirty_area_reset(&canvas->committed);
     canvas->orientation = CanvasOrientationHorizontal;
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
@@ -53,7 +94,49 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    uint16_t bytes_sent = 0;
+
+    if(canvas->full_refresh_countdown == 0) {
+        u8g2_SendBuffer(&canvas->fb);
+        bytes_sent = canvas_get_buffer_size(canvas);
+        canvas->full_refresh_countdown = CANVAS_FULL_REFRESH_INTERVAL;
+        canvas->stats.full_commits++;
+    } else {
+        // Buffer is cleared between frames: pixels that differ from display
+        // are either drawn now or were drawn in previous commit
+        CanvasDirtyArea area = canvas->committed;
+        canvas_dirty_area_add(
+            &area,
+            canvas->dirty.x_min,
+            canvas->dirty.y_min,
+            canvas->dirty.x_max,
+            canvas->dirty.y_max);
+        if(area.x_min <= area.x_max) {
+            uint8_t tx = area.x_min / 8;
+            uint8_t ty = area.y_min / 8;
+            uint8_t tw = area.x_max / 8 - tx + 1;
+            uint8_t th = area.y_max / 8 - ty + 1;
+            u8g2_UpdateDisplayArea(&canvas->fb, tx, ty, tw, th);
+            bytes_sent = tw * th * 8;
+        }
+        canvas->full_refresh_countdown--;
+    }
+
+    canvas->committed = canvas->dirty;
+    canvas->stats.commits++;
+    canvas->stats.bytes_sent += bytes_sent;
+    canvas->stats.last_bytes_sent = bytes_sent;
+}
+
+void canvas_invalidate(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->full_refresh_countdown = 0;
+}
+
+void canvas_get_commit_stats(Canvas* canvas, CanvasCommitStats* stats) {
+    furi_assert(canvas);
+    furi_assert(stats);
+    *stats = canvas->stats;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -61,6 +144,13 @@ uint8_t* canvas_get_buffer(Canvas* canvas) {
     return u8g2_GetBufferPtr(&canvas->fb);
 }
 
+void canvas_set_buffer(Canvas* canvas, uint8_t* buffer) {
+    furi_assert(canvas);
+    furi_assert(buffer);
+    // u8g2_SetBufferPtr exists only with U8G2_USE_DYNAMIC_ALLOC
+    canvas->fb.tile_buf_ptr = buffer;
+}
+
 size_t canvas_get_buffer_size(Canvas* canvas) {
     furi_assert(canvas);
     return u8g2_GetBufferTileWidth(&canvas->fb) * u8g2_GetBufferTileHeight(&canvas->fb) * 8;
@@ -109,6 +199,7 @@ CanvasFontParameters* canvas_get_font_params(Canvas* canvas, Font font) {
 void canvas_clear(Canvas* canvas) {
     furi_assert(canvas);
     u8g2_ClearBuffer(&canvas->fb);
+    canvas_dirty_area_reset(&canvas->dirty);
 }
 
 void canvas_set_color(Canvas* canvas, Color color) {
@@ -8,6 +8,27 @@
 #include "canvas.h"
 #include <u8g2.h>
 
+/** Full display refresh interval in commits, recovers from display glitches */
+#define CANVAS_FULL_REFRESH_INTERVAL 64
+
+/** Area touched by drawing, display pixels, empty when x_min > x_max
+ */
+typedef struct {
+    uint8_t x_min;
+    uint8_t y_min;
+    uint8_t x_max;
+    uint8_t y_max;
+} CanvasDirtyArea;
+
+/** Canvas commit statistics
+ */
+typedef struct {
+    uint32_t commits;
+    uint32_t full_commits;
+    uint32_t bytes_sent;
+    uint16_t last_bytes_sent;
+} CanvasCommitStats;
+
 /** Canvas structure
  */
 struct Canvas {
@@ -17,6 +38,12 @@ struct Canvas {
     uint8_t offset_y;
     uint8_t width;
     uint8_t height;
+    // Dirty area tracking
+    u8g2_draw_ll_hvline_cb ll_hvline;
+    CanvasDirtyArea dirty;
+    CanvasDirtyArea committed;
+    uint8_t full_refresh_countdown;
+    CanvasCommitStats stats;
 };
 
 /** Allocate memory and initialize canvas
@@ -38,11 +65,29 @@ void canvas_free(Canvas* canvas);
 void canvas_reset(Canvas* canvas);
 
 /** Commit canvas. Send buffer to display
+ *
+ * Only tiles covering the area drawn in this or previous commit are sent,
+ * whole buffer is sent every CANVAS_FULL_REFRESH_INTERVAL commits.
  *
  * @param      canvas  Canvas instance
  */
 void canvas_commit(Canvas* canvas);
 
+/** Force whole buffer send on next commit
+ *
+ * Use it when display content was changed or reset outside of canvas.
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_invalidate(Canvas* canvas);
+
+/** Get canvas commit statistics
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   CanvasCommitStats to fill
+ */
+void canvas_get_commit_stats(Canvas* canvas, CanvasCommitStats* stats);
+
 /** Get canvas buffer.
  *
  * @param      canvas  Canvas instance
@@ -51,6 +96,13 @@ void canvas_commit(Canvas* canvas);
  */
 uint8_t* canvas_get_buffer(Canvas* canvas);
 
+/** Set canvas buffer. Following drawing and commit use it.
+ *
+ * @param      canvas  Canvas instance
+ * @param      buffer  buffer of canvas_get_buffer_size bytes
+ */
+void canvas_set_buffer(Canvas* canvas, uint8_t* buffer);
+
 /** Get canvas buffer size.
  *
  * @param      canvas  Canvas instance
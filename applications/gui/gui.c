@@ -17,9 +17,39 @@ ViewPort* gui_view_port_find_enabled(ViewPortArray_t array) {
     return NULL;
 }
 
+static void gui_update_pending(Gui* gui, uint32_t pending) {
+    FURI_CRITICAL_ENTER();
+    gui->pending_layers |= pending;
+    FURI_CRITICAL_EXIT();
+    osThreadFlagsSet(gui->thread, GUI_THREAD_FLAG_DRAW);
+}
+
 void gui_update(Gui* gui) {
     furi_assert(gui);
-    osThreadFlagsSet(gui->thread, GUI_THREAD_FLAG_DRAW);
+    gui_update_pending(gui, GUI_PENDING_FORCED);
+}
+
+void gui_update_layer(Gui* gui, GuiLayer layer) {
+    furi_assert(gui);
+    furi_assert(layer < GuiLayerMAX);
+    gui_update_pending(gui, 1 << layer);
+}
+
+const char* gui_layer_get_name(GuiLayer layer) {
+    switch(layer) {
+    case GuiLayerDesktop:
+        return "desktop";
+    case GuiLayerWindow:
+        return "window";
+    case GuiLayerStatusBarLeft:
+        return "status_bar_left";
+    case GuiLayerStatusBarRight:
+        return "status_bar_right";
+    case GuiLayerFullscreen:
+        return "fullscreen";
+    default:
+        return "unknown";
+    }
 }
 
 void gui_input_events_callback(const void* value, void* ctx) {
@@ -189,10 +219,87 @@ bool gui_redraw_desktop(Gui* gui) {
     return false;
 }
 
+static GuiFrame* gui_frame_alloc(Gui* gui, uint8_t* data, size_t size) {
+    GuiFrame* frame = malloc(sizeof(GuiFrame));
+    frame->gui = gui;
+    frame->data = data;
+    frame->size = size;
+    frame->sequence = 0;
+    frame->refs = 1;
+    return frame;
+}
+
+static GuiFrame* gui_frame_get_free(Gui* gui) {
+    GuiFrame* free_frame = NULL;
+
+    FURI_CRITICAL_ENTER();
+    for
+        M_EACH(frame, gui->frames, GuiFrameArray_t) {
+            if((*frame)->refs == 0) {
+                free_frame = *frame;
+                free_frame->refs = 1;
+                break;
+            }
+        }
+    // Set with the pool scan, so release in between can't miss it and skip the redraw
+    if(!free_frame && GuiFrameArray_size(gui->frames) == GUI_FRAME_POOL_SIZE) {
+        gui->frame_dropped = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    // Every frame is held by subscribers or GUI itself
+    if(!free_frame && GuiFrameArray_size(gui->frames) < GUI_FRAME_POOL_SIZE) {
+        size_t size = canvas_get_buffer_size(gui->canvas);
+        free_frame = gui_frame_alloc(gui, malloc(size), size);
+        GuiFrameArray_push_back(gui->frames, free_frame);
+        FURI_LOG_D(TAG, "Frame pool grown to %d", GuiFrameArray_size(gui->frames));
+    }
+
+    return free_frame;
+}
+
+static void gui_frame_swap(Gui* gui) {
+    GuiFrame* rendered = gui->frame_back;
+
+    // Unchanged frame: keep rendering into the same buffer, subscribers may skip it
+    if(gui->frame_front && memcmp(gui->frame_front->data, rendered->data, rendered->size) == 0) {
+        return;
+    }
+
+    // Subscribers hold the whole pool: drop this frame, next one goes into the same buffer
+    GuiFrame* next = gui_frame_get_free(gui);
+    if(!next) {
+        gui->frames_dropped++;
+        return;
+    }
+
+    GuiFrame* previous = gui->frame_front;
+    rendered->sequence = ++gui->frame_sequence;
+    gui->frame_front = rendered;
+    if(previous) gui_frame_release(previous);
+
+    for
+        M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
+            p->callback(gui->frame_front, p->context);
+        }
+
+    gui->frame_back = next;
+    canvas_set_buffer(gui->canvas, gui->frame_back->data);
+}
+
 void gui_redraw(Gui* gui) {
     furi_assert(gui);
     gui_lock(gui);
 
+    // Requests arriving while drawing will trigger next frame
+    FURI_CRITICAL_ENTER();
+    FURI_TRACE_POINT(FuriTraceGuiRedrawBegin, gui->pending_layers, 0);
+    gui->pending_layers = 0;
+    FURI_CRITICAL_EXIT();
+    gui->input_boost = false;
+    gui->last_redraw_tick = osKernelGetTickCount();
+    gui->redraw_count++;
+
     canvas_reset(gui->canvas);
 
     if(gui->lockdown) {
@@ -211,12 +318,9 @@ void gui_redraw(Gui* gui) {
     }
 
     canvas_commit(gui->canvas);
-    for
-        M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
-            p->callback(
-                canvas_get_buffer(gui->canvas), canvas_get_buffer_size(gui->canvas), p->context);
-        }
+    gui_frame_swap(gui);
     gui_unlock(gui);
+    FURI_TRACE_POINT(FuriTraceGuiRedrawEnd, 0, 0);
 }
 
 void gui_input(Gui* gui, InputEvent* input_event) {
@@ -255,6 +359,9 @@ void gui_input(Gui* gui, InputEvent* input_event) {
         gui->ongoing_input_view_port = view_port;
     }
 
+    // Redraw caused by input is not rate limited
+    gui->input_boost = true;
+
     if(view_port && view_port == gui->ongoing_input_view_port) {
         view_port_input(view_port, input_event);
     } else if(gui->ongoing_input_view_port && input_event->type == InputTypeRelease) {
@@ -311,6 +418,7 @@ void gui_add_view_port(Gui* gui, ViewPort* view_port, GuiLayer layer) {
     }
     // Add view port and link with gui
     ViewPortArray_push_back(gui->layers[layer], view_port);
+    view_port->layer = layer;
     view_port_gui_set(view_port, gui);
     gui_unlock(gui);
 
@@ -404,6 +512,8 @@ void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, vo
 
     furi_assert(CanvasCallbackPairArray_count(gui->canvas_callback_pair, p) == 0);
     CanvasCallbackPairArray_push_back(gui->canvas_callback_pair, p);
+    // Unchanged frames are not dispatched, hand current one right away
+    if(gui->frame_front) callback(gui->frame_front, context);
 
     gui_unlock(gui);
     gui_update(gui);
@@ -427,6 +537,54 @@ size_t gui_get_framebuffer_size(Gui* gui) {
     return canvas_get_buffer_size(gui->canvas);
 }
 
+void gui_frame_acquire(GuiFrame* frame) {
+    furi_assert(frame);
+    FURI_CRITICAL_ENTER();
+    furi_assert(frame->refs > 0);
+    frame->refs++;
+    FURI_CRITICAL_EXIT();
+}
+
+void gui_frame_release(GuiFrame* frame) {
+    furi_assert(frame);
+    bool redraw = false;
+    FURI_CRITICAL_ENTER();
+    furi_assert(frame->refs > 0);
+    frame->refs--;
+    if(frame->refs == 0 && frame->gui->frame_dropped) {
+        frame->gui->frame_dropped = false;
+        redraw = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    // Dropped frame content is still not shown to subscribers
+    if(redraw) gui_update(frame->gui);
+}
+
+const uint8_t* gui_frame_get_data(GuiFrame* frame) {
+    furi_assert(frame);
+    return frame->data;
+}
+
+size_t gui_frame_get_size(GuiFrame* frame) {
+    furi_assert(frame);
+    return frame->size;
+}
+
+uint32_t gui_frame_get_sequence(GuiFrame* frame) {
+    furi_assert(frame);
+    return frame->sequence;
+}
+
+void gui_set_layer_max_fps(Gui* gui, GuiLayer layer, uint8_t max_fps) {
+    furi_assert(gui);
+    furi_check(layer < GuiLayerMAX);
+    gui_lock(gui);
+    gui->layer_interval[layer] = max_fps ? osKernelGetTickFreq() / max_fps : 0;
+    gui_unlock(gui);
+    gui_update(gui);
+}
+
 void gui_set_lockdown(Gui* gui, bool lockdown) {
     furi_assert(gui);
     gui_lock(gui);
@@ -449,6 +607,15 @@ Gui* gui_alloc() {
     // Drawing canvas
     gui->canvas = canvas_init();
     CanvasCallbackPairArray_init(gui->canvas_callback_pair);
+    // First back frame adopts canvas own buffer
+    GuiFrameArray_init(gui->frames);
+    gui->frame_back =
+        gui_frame_alloc(gui, canvas_get_buffer(gui->canvas), canvas_get_buffer_size(gui->canvas));
+    GuiFrameArray_push_back(gui->frames, gui->frame_back);
+    // Redraw governor
+    for(size_t i = 0; i < GuiLayerMAX; i++) {
+        gui->layer_interval[i] = osKernelGetTickFreq() / GUI_LAYER_MAX_FPS_DEFAULT;
+    }
 
     // Input
     gui->input_queue = osMessageQueueNew(8, sizeof(InputEvent), NULL);
@@ -460,13 +627,45 @@ Gui* gui_alloc() {
     return gui;
 }
 
+/** Get ticks to wait before serving pending redraw requests
+ *
+ * @return     0 to redraw now, osWaitForever if nothing is pending
+ */
+static uint32_t gui_redraw_delay(Gui* gui) {
+    FURI_CRITICAL_ENTER();
+    uint32_t pending = gui->pending_layers;
+    FURI_CRITICAL_EXIT();
+
+    if(!pending) return osWaitForever;
+    if(gui->input_boost || (pending & GUI_PENDING_FORCED)) return 0;
+
+    uint32_t elapsed = osKernelGetTickCount() - gui->last_redraw_tick;
+    uint32_t delay = osWaitForever;
+    for(size_t i = 0; i < GuiLayerMAX; i++) {
+        if(pending & (1 << i)) {
+            uint32_t interval = gui->layer_interval[i];
+            uint32_t layer_delay = (elapsed >= interval) ? 0 : interval - elapsed;
+            if(layer_delay < delay) delay = layer_delay;
+        }
+    }
+    return delay;
+}
+
 int32_t gui_srv(void* p) {
     Gui* gui = gui_alloc();
 
     furi_record_create("gui", gui);
 
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open("cli");
+    cli_add_command(cli, "gui", CliCommandFlagParallelSafe, gui_cli, gui);
+#endif
+
+    uint32_t timeout = osWaitForever;
     while(1) {
-        uint32_t flags = osThreadFlagsWait(GUI_THREAD_FLAG_ALL, osFlagsWaitAny, osWaitForever);
+        uint32_t flags = osThreadFlagsWait(GUI_THREAD_FLAG_ALL, osFlagsWaitAny, timeout);
+        // Timeout: deferred redraw is due
+        if(flags & osFlagsError) flags = 0;
         // Process and dispatch input
         if(flags & GUI_THREAD_FLAG_INPUT) {
             // Process till queue become empty
@@ -475,11 +674,13 @@ int32_t gui_srv(void* p) {
                 gui_input(gui, &input_event);
             }
         }
-        // Process and dispatch draw call
-        if(flags & GUI_THREAD_FLAG_DRAW) {
+        // Draw requests are collected in pending layers, flag only wakes us up
+        timeout = gui_redraw_delay(gui);
+        if(timeout == 0) {
             // Clear flags that arrived on input step
             osThreadFlagsClear(GUI_THREAD_FLAG_DRAW);
             gui_redraw(gui);
+            timeout = gui_redraw_delay(gui);
         }
     }
 
@@ -26,8 +26,15 @@ typedef enum {
     GuiLayerMAX /**< Don't use or move, special value */
 } GuiLayer;
 
-/** Gui Canvas Commit Callback */
-typedef void (*GuiCanvasCommitCallback)(uint8_t* data, size_t size, void* context);
+/** Committed frame, read-only and reference counted */
+typedef struct GuiFrame GuiFrame;
+
+/** Gui Canvas Commit Callback
+ *
+ * Called only when committed frame differs from the previous one. Frame is
+ * valid until callback returns, call gui_frame_acquire to keep it longer.
+ */
+typedef void (*GuiCanvasCommitCallback)(GuiFrame* frame, void* context);
 
 typedef struct Gui Gui;
 
@@ -71,7 +78,7 @@ void gui_view_port_send_to_back(Gui* gui, ViewPort* view_port);
 /** Add gui canvas commit callback
  *
  * This callback will be called upon Canvas commit Callback dispatched from GUI
- * thread and is time critical
+ * thread and is time critical: acquire the frame and process it elsewhere
  *
  * @param      gui       Gui instance
  * @param      callback  GuiCanvasCommitCallback
@@ -94,6 +101,59 @@ void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback,
  */
 size_t gui_get_framebuffer_size(Gui* gui);
 
+/** Take frame reference, GUI will not reuse frame buffer until it is released
+ *
+ * Frame pool is small: while subscribers hold more than one frame, new frames
+ * are dropped and the latest one is delivered after a release.
+ *
+ * @remark     thread safe
+ *
+ * @param      frame     GuiFrame instance
+ */
+void gui_frame_acquire(GuiFrame* frame);
+
+/** Release frame reference
+ *
+ * @remark     thread safe
+ *
+ * @param      frame     GuiFrame instance
+ */
+void gui_frame_release(GuiFrame* frame);
+
+/** Get frame data
+ *
+ * @param      frame     GuiFrame instance
+ * @return     pointer to frame buffer
+ */
+const uint8_t* gui_frame_get_data(GuiFrame* frame);
+
+/** Get frame data size
+ *
+ * @param      frame     GuiFrame instance
+ * @return     size of frame buffer in bytes
+ */
+size_t gui_frame_get_size(GuiFrame* frame);
+
+/** Get frame sequence number
+ *
+ * Sequence number is incremented on every frame that differs from the previous one
+ *
+ * @param      frame     GuiFrame instance
+ * @return     sequence number
+ */
+uint32_t gui_frame_get_sequence(GuiFrame* frame);
+
+/** Set redraw rate limit for layer
+ *
+ * Redraw requests from ViewPorts of this layer are coalesced and served not
+ * more often than given rate. Input driven redraws are never delayed.
+ *
+ * @param      gui       Gui instance
+ * @param      layer     GuiLayer
+ * @param      max_fps   frames per second, 0 - no limit
+ */
+void gui_set_layer_max_fps(Gui* gui, GuiLayer layer, uint8_t max_fps);
+
 /** Set lockdown mode
  *
  * When lockdown mode is enabled, only GuiLayerDesktop is shown.
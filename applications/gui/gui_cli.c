@@ -0,0 +1,118 @@
+#include "gui_i.h"
+
+#include <furi.h>
+#include <cli/cli.h>
+#include <toolbox/args.h>
+
+static void gui_cli_usage() {
+    printf("Usage:\r\n");
+    printf("gui <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+    printf("\tstats\t\t\t - show redraw and ViewPort update counters\r\n");
+    printf("\tfps <layer> <fps>\t - limit layer redraw rate, 0 - no limit\r\n");
+}
+
+static void gui_cli_stats(Cli* cli, string_t args, Gui* gui) {
+    string_t output;
+    string_init(output);
+
+    // Collect under lock, print without holding GUI
+    gui_lock(gui);
+    CanvasCommitStats canvas_stats;
+    canvas_get_commit_stats(gui->canvas, &canvas_stats);
+    string_cat_printf(
+        output,
+        "Redraws: %lu, changed frames: %lu, dropped: %lu, frame pool: %d\r\n",
+        gui->redraw_count,
+        gui->frame_sequence,
+        gui->frames_dropped,
+        GuiFrameArray_size(gui->frames));
+    string_cat_printf(
+        output,
+        "Display commits: %lu, full: %lu, bytes sent: %lu, last: %u\r\n",
+        canvas_stats.commits,
+        canvas_stats.full_commits,
+        canvas_stats.bytes_sent,
+        canvas_stats.last_bytes_sent);
+    for(size_t i = 0; i < GuiLayerMAX; i++) {
+        uint32_t interval = gui->layer_interval[i];
+        string_cat_printf(
+            output,
+            "Layer %s, max fps: %lu\r\n",
+            gui_layer_get_name(i),
+            interval ? osKernelGetTickFreq() / interval : 0);
+        for
+            M_EACH(item, gui->layers[i], ViewPortArray_t) {
+                ViewPort* view_port = *item;
+                string_cat_printf(
+                    output,
+                    "\t%p %s updates: %lu, draws: %lu\r\n",
+                    view_port,
+                    view_port->is_enabled ? "enabled " : "disabled",
+                    view_port->update_count,
+                    view_port->draw_count);
+            }
+    }
+    gui_unlock(gui);
+
+    printf("%s", string_get_cstr(output));
+    string_clear(output);
+}
+
+static void gui_cli_fps(Cli* cli, string_t args, Gui* gui) {
+    string_t layer_name;
+    string_init(layer_name);
+    int fps = 0;
+
+    do {
+        if(!args_read_string_and_trim(args, layer_name)) {
+            gui_cli_usage();
+            break;
+        }
+        GuiLayer layer = GuiLayerMAX;
+        for(size_t i = 0; i < GuiLayerMAX; i++) {
+            if(string_cmp_str(layer_name, gui_layer_get_name(i)) == 0) {
+                layer = i;
+                break;
+            }
+        }
+        if(layer == GuiLayerMAX) {
+            printf("Unknown layer: %s\r\n", string_get_cstr(layer_name));
+            break;
+        }
+        if(!args_read_int_and_trim(args, &fps) || fps < 0 || fps > UINT8_MAX) {
+            printf("Invalid fps, expected 0-255\r\n");
+            break;
+        }
+        gui_set_layer_max_fps(gui, layer, fps);
+    } while(false);
+
+    string_clear(layer_name);
+}
+
+void gui_cli(Cli* cli, string_t args, void* context) {
+    furi_assert(cli);
+    furi_assert(context);
+    Gui* gui = context;
+    string_t cmd;
+    string_init(cmd);
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            gui_cli_usage();
+            break;
+        }
+        if(string_cmp_str(cmd, "stats") == 0) {
+            gui_cli_stats(cli, args, gui);
+            break;
+        }
+        if(string_cmp_str(cmd, "fps") == 0) {
+            gui_cli_fps(cli, args, gui);
+            break;
+        }
+
+        gui_cli_usage();
+    } while(false);
+
+    string_clear(cmd);
+}
@@ -8,6 +8,7 @@
 #include "gui.h"
 
 #include <furi.h>
+#include <cli/cli.h>
 #include <m-array.h>
 #include <m-algo.h>
 #include <stdio.h>
@@ -41,8 +42,31 @@
 #define GUI_THREAD_FLAG_INPUT (1 << 1)
 #define GUI_THREAD_FLAG_ALL (GUI_THREAD_FLAG_DRAW | GUI_THREAD_FLAG_INPUT)
 
+/* Redraw request that bypasses layer rate limits: tree changes, lockdown */
+#define GUI_PENDING_FORCED (1 << GuiLayerMAX)
+
+#define GUI_LAYER_MAX_FPS_DEFAULT 30
+
+/** Back and front frames plus one held by subscriber, frames past that are dropped */
+#define GUI_FRAME_POOL_SIZE 3
+
 ARRAY_DEF(ViewPortArray, ViewPort*, M_PTR_OPLIST);
 
+#define M_OPL_ViewPortArray_t() ARRAY_OPLIST(ViewPortArray, M_PTR_OPLIST)
+
+/** Frame buffer, owned by GUI while rendered or shown, shared with subscribers */
+struct GuiFrame {
+    Gui* gui;
+    uint8_t* data;
+    size_t size;
+    uint32_t sequence;
+    volatile uint32_t refs;
+};
+
+ARRAY_DEF(GuiFrameArray, GuiFrame*, M_PTR_OPLIST);
+
+#define M_OPL_GuiFrameArray_t() ARRAY_OPLIST(GuiFrameArray, M_PTR_OPLIST)
+
 typedef struct {
     GuiCanvasCommitCallback callback;
     void* context;
@@ -66,6 +90,22 @@ struct Gui {
     Canvas* canvas;
     CanvasCallbackPairArray_t canvas_callback_pair;
 
+    // Frames: canvas renders into back, front is the last committed one
+    GuiFrameArray_t frames;
+    GuiFrame* frame_back;
+    GuiFrame* frame_front;
+    uint32_t frame_sequence;
+    uint32_t frames_dropped;
+    /** Frame was dropped, redraw once subscribers release one */
+    volatile bool frame_dropped;
+
+    // Redraw governor
+    volatile uint32_t pending_layers;
+    uint32_t layer_interval[GuiLayerMAX];
+    uint32_t last_redraw_tick;
+    uint32_t redraw_count;
+    bool input_boost;
+
     // Input
     osMessageQueueId_t input_queue;
     FuriPubSub* input_events;
@@ -75,12 +115,30 @@ struct Gui {
 
 ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
 
-/** Update GUI, request redraw
+/** Update GUI, request immediate redraw
  *
  * @param      gui   Gui instance
  */
 void gui_update(Gui* gui);
 
+/** Request redraw on behalf of layer, subject to layer rate limit
+ *
+ * @param      gui    Gui instance
+ * @param      layer  GuiLayer
+ */
+void gui_update_layer(Gui* gui, GuiLayer layer);
+
+/** Get layer name for diagnostics
+ *
+ * @param      layer  GuiLayer
+ *
+ * @return     layer name
+ */
+const char* gui_layer_get_name(GuiLayer layer);
+
+/** GUI CLI command handler */
+void gui_cli(Cli* cli, string_t args, void* context);
+
 void gui_input_events_callback(const void* value, void* ctx);
 
 void gui_lock(Gui* gui);
@@ -97,7 +97,8 @@ void view_port_input_callback_set(
 
 void view_port_update(ViewPort* view_port) {
     furi_assert(view_port);
-    if(view_port->gui && view_port->is_enabled) gui_update(view_port->gui);
+    view_port->update_count++;
+    if(view_port->gui && view_port->is_enabled) gui_update_layer(view_port->gui, view_port->layer);
 }
 
 void view_port_gui_set(ViewPort* view_port, Gui* gui) {
@@ -111,6 +112,7 @@ void view_port_draw(ViewPort* view_port, Canvas* canvas) {
     furi_check(view_port->gui);
 
     if(view_port->draw_callback) {
+        view_port->draw_count++;
         view_port_setup_canvas_orientation(view_port, canvas);
         view_port->draw_callback(canvas, view_port->draw_callback_context);
     }
@@ -10,6 +10,7 @@
 
 struct ViewPort {
     Gui* gui;
+    GuiLayer layer;
     bool is_enabled;
     ViewPortOrientation orientation;
 
@@ -21,6 +22,10 @@ struct ViewPort {
 
     ViewPortInputCallback input_callback;
     void* input_callback_context;
+
+    // Statistics
+    uint32_t update_count;
+    uint32_t draw_count;
 };
 
 /** Set GUI reference.
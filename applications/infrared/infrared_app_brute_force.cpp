@@ -6,73 +6,358 @@
 #include <m-string.h>
 #include <furi.h>
 #include <file_worker_cpp.h>
+#include <fnv1a-hash.h>
+#include <flipper_format/flipper_format_i.h>
+
+#define TAG "InfraredBruteForce"
+
+/** Index file header, followed by record table and entries.
+ * Record table: name length (uint8_t), name, amount (uint16_t) per record.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    /** InfraredProtocolMAX of firmware built the index */
+    uint8_t protocol_count;
+    uint8_t record_count;
+    uint8_t reserved;
+    uint32_t db_size;
+    /** Database mtime, FNV-1a hash of whole database if filesystem keeps none */
+    uint32_t db_stamp;
+    uint32_t entry_count;
+} __attribute__((packed)) InfraredBruteForceIndexHeader;
+
+static constexpr const uint32_t index_magic = 0x58444949; // "IIDX"
+static constexpr const uint8_t index_version = 3;
+/** Entries per index file read or write */
+static constexpr const size_t index_chunk_entries = 16;
+/** Database bytes per read while hashing */
+static constexpr const size_t fingerprint_chunk = 512;
 
 void InfraredAppBruteForce::add_record(int index, const char* name) {
     records[name].index = index;
     records[name].amount = 0;
+    records[name].id = 0;
 }
 
-bool InfraredAppBruteForce::calculate_messages() {
-    bool result = false;
+bool InfraredAppBruteForce::fingerprint_database(
+    Storage* storage,
+    uint32_t& db_size,
+    uint32_t& db_stamp) {
+    FileInfo info;
+    if(storage_common_stat(storage, universal_db_filename, &info) != FSE_OK) return false;
+    db_size = info.size;
+    db_stamp = info.mtime;
+    if(db_stamp) return true;
 
-    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
-    FlipperFormat* ff = flipper_format_file_alloc(storage);
-    result = flipper_format_file_open_existing(ff, universal_db_filename);
+    /* No timestamps: same size edit can be anywhere, hash it all */
+    File* file = storage_file_alloc(storage);
+    bool result = storage_file_open(file, universal_db_filename, FSAM_READ, FSOM_OPEN_EXISTING);
 
     if(result) {
+        uint8_t* buffer = static_cast<uint8_t*>(malloc(fingerprint_chunk));
+        uint32_t hashed = 0;
+        uint16_t read = 0;
+        db_stamp = FNV_1A_INIT;
+        do {
+            read = storage_file_read(file, buffer, fingerprint_chunk);
+            db_stamp = fnv1a_buffer_hash(buffer, read, db_stamp);
+            hashed += read;
+        } while(read == fingerprint_chunk);
+        free(buffer);
+        result = (hashed == db_size);
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    return result;
+}
+
+bool InfraredAppBruteForce::load_index(Storage* storage, uint32_t db_size, uint32_t db_stamp) {
+    File* file = storage_file_alloc(storage);
+    InfraredBruteForceIndexHeader header;
+    std::string name;
+    size_t matched = 0;
+    bool result = false;
+
+    for(auto& it : records) {
+        it.second.amount = 0;
+    }
+
+    do {
+        if(!storage_file_open(file, index_filename.c_str(), FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != index_magic || header.version != index_version) break;
+        if(header.protocol_count != InfraredProtocolMAX) break;
+        if(header.db_size != db_size || header.db_stamp != db_stamp) break;
+
+        uint8_t id = 0;
+        for(; id < header.record_count; ++id) {
+            uint8_t name_length = 0;
+            uint16_t amount = 0;
+            if(storage_file_read(file, &name_length, 1) != 1) break;
+            name.resize(name_length);
+            if(storage_file_read(file, &name[0], name_length) != name_length) break;
+            if(storage_file_read(file, &amount, sizeof(amount)) != sizeof(amount)) break;
+
+            auto element = records.find(name);
+            if(element != records.end()) {
+                element->second.id = id;
+                element->second.amount = amount;
+                ++matched;
+            }
+        }
+        if(id != header.record_count) break;
+
+        index_entries_offset = storage_file_tell(file);
+        if(storage_file_size(file) !=
+           index_entries_offset + header.entry_count * sizeof(IndexEntry))
+            break;
+        /* index built for other record set doesn't count them all */
+        result = (matched == records.size());
+    } while(0);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    return result;
+}
+
+bool InfraredAppBruteForce::build_index(Storage* storage, uint32_t db_size, uint32_t db_stamp) {
+    furi_check(records.size() <= UINT8_MAX);
+
+    InfraredBruteForceIndexHeader header = {
+        .magic = 0,
+        .version = index_version,
+        .protocol_count = InfraredProtocolMAX,
+        .record_count = static_cast<uint8_t>(records.size()),
+        .reserved = 0,
+        .db_size = db_size,
+        .db_stamp = db_stamp,
+        .entry_count = 0,
+    };
+
+    uint8_t id = 0;
+    for(auto& it : records) {
+        furi_check(it.first.size() <= UINT8_MAX);
+        it.second.id = id++;
+        it.second.amount = 0;
+    }
+
+    FlipperFormat* db = flipper_format_file_alloc(storage);
+    File* file = storage_file_alloc(storage);
+    std::vector<IndexEntry> chunk;
+    chunk.reserve(index_chunk_entries);
+
+    /* record table follows map order, it is unchanged while building */
+    auto write_head = [&]() {
+        std::string head(reinterpret_cast<const char*>(&header), sizeof(header));
+        for(const auto& it : records) {
+            uint16_t amount = it.second.amount;
+            head.push_back(static_cast<char>(it.first.size()));
+            head.append(it.first);
+            head.append(reinterpret_cast<const char*>(&amount), sizeof(amount));
+        }
+        index_entries_offset = head.size();
+        return storage_file_seek(file, 0, true) &&
+               (storage_file_write(file, head.data(), head.size()) == head.size());
+    };
+
+    auto write_chunk = [&]() {
+        size_t bytes = chunk.size() * sizeof(IndexEntry);
+        bool written = (storage_file_write(file, chunk.data(), bytes) == bytes);
+        chunk.clear();
+        return written;
+    };
+
+    bool result = false;
+    do {
+        if(!flipper_format_file_open_existing(db, universal_db_filename)) break;
+        if(!storage_file_open(file, index_filename.c_str(), FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        /* magic is written last, so interrupted build is never loaded */
+        if(!write_head()) break;
+
+        Stream* stream = flipper_format_get_raw_stream(db);
         InfraredAppSignal signal;
+        std::string signal_name;
+        string_t name;
+        string_init(name);
+        bool written = true;
+        while(written) {
+            uint32_t offset = stream_tell(stream);
+            if(!flipper_format_read_string(db, "name", name)) break;
+            auto element = records.find(string_get_cstr(name));
+            if(element == records.end()) continue;
 
-        string_t signal_name;
-        string_init(signal_name);
-        while(flipper_format_read_string(ff, "name", signal_name)) {
-            auto element = records.find(string_get_cstr(signal_name));
-            if(element != records.cend()) {
-                ++element->second.amount;
+            /* every known signal is parsed once, parsed ones are kept decoded */
+            stream_seek(stream, offset, StreamOffsetFromStart);
+            if(!infrared_parser_read_signal(db, signal, signal_name)) {
+                FURI_LOG_W(TAG, "Unreadable signal after %lu", offset);
+                continue;
+            }
+
+            IndexEntry entry = {
+                .record_id = element->second.id,
+                .protocol = index_raw_protocol,
+                .offset = offset,
+                .address = 0,
+                .command = 0,
+            };
+            if(!signal.is_raw()) {
+                const InfraredMessage& message = signal.get_message();
+                entry.protocol = message.protocol;
+                entry.address = message.address;
+                entry.command = message.command;
+            }
+            chunk.push_back(entry);
+            ++element->second.amount;
+            ++header.entry_count;
+
+            if(chunk.size() == index_chunk_entries) {
+                written = write_chunk();
             }
         }
-        string_clear(signal_name);
+        string_clear(name);
+
+        if(!written || !write_chunk()) break;
+        header.magic = index_magic;
+        result = write_head();
+    } while(0);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    flipper_format_free(db);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Failed to build %s", index_filename.c_str());
+        storage_common_remove(storage, index_filename.c_str());
+    }
+    return result;
+}
+
+bool InfraredAppBruteForce::calculate_messages() {
+    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
+
+    uint32_t db_size = 0;
+    uint32_t db_stamp = 0;
+    bool result = fingerprint_database(storage, db_size, db_stamp);
+    if(result && !load_index(storage, db_size, db_stamp)) {
+        FURI_LOG_I(TAG, "Building index for %s", universal_db_filename);
+        result = build_index(storage, db_size, db_stamp);
     }
 
-    flipper_format_free(ff);
     furi_record_close("storage");
     return result;
 }
 
+bool InfraredAppBruteForce::load_entries(Storage* storage, uint8_t record_id, int amount) {
+    File* file = storage_file_alloc(storage);
+    current_entries.clear();
+    current_entries.reserve(amount);
+
+    bool result =
+        storage_file_open(file, index_filename.c_str(), FSAM_READ, FSOM_OPEN_EXISTING) &&
+        storage_file_seek(file, index_entries_offset, true);
+
+    if(result) {
+        IndexEntry chunk[index_chunk_entries];
+        uint16_t read = 0;
+        do {
+            read = storage_file_read(file, chunk, sizeof(chunk));
+            for(size_t i = 0; i < read / sizeof(IndexEntry); ++i) {
+                if(chunk[i].record_id == record_id) {
+                    current_entries.push_back(chunk[i]);
+                }
+            }
+        } while(read == sizeof(chunk));
+        result = (current_entries.size() == static_cast<size_t>(amount));
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    return result;
+}
+
+bool InfraredAppBruteForce::read_raw_signal(uint32_t offset, InfraredAppSignal& signal) {
+    if(!ff) {
+        Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
+        ff = flipper_format_file_alloc(storage);
+        furi_record_close("storage");
+        if(!flipper_format_file_open_existing(ff, universal_db_filename)) {
+            flipper_format_free(ff);
+            ff = nullptr;
+            return false;
+        }
+    }
+
+    std::string signal_name;
+    Stream* stream = flipper_format_get_raw_stream(ff);
+    return stream_seek(stream, offset, StreamOffsetFromStart) &&
+           infrared_parser_read_signal(ff, signal, signal_name) && signal.is_raw() &&
+           !current_record.compare(signal_name);
+}
+
+bool InfraredAppBruteForce::load_next_signal(InfraredAppSignal& signal) {
+    while(current_position < current_entries.size()) {
+        const IndexEntry& entry = current_entries[current_position++];
+        if(entry.protocol != index_raw_protocol) {
+            InfraredMessage message = {
+                .protocol = static_cast<InfraredProtocol>(entry.protocol),
+                .address = entry.address,
+                .command = entry.command,
+                .repeat = false,
+            };
+            signal.set_message(&message);
+            return true;
+        }
+        if(read_raw_signal(entry.offset, signal)) {
+            return true;
+        }
+        FURI_LOG_W(TAG, "Skip unreadable signal after %lu", entry.offset);
+    }
+    return false;
+}
+
 void InfraredAppBruteForce::stop_bruteforce() {
     furi_assert((current_record.size()));
 
     if(current_record.size()) {
-        furi_assert(ff);
         current_record.clear();
-        flipper_format_free(ff);
+        current_entries.clear();
+        current_entries.shrink_to_fit();
+        next_signal_ready = false;
+        if(ff) {
+            flipper_format_free(ff);
+            ff = nullptr;
+        }
         furi_record_close("storage");
     }
 }
 
 bool InfraredAppBruteForce::send_next_bruteforce(void) {
     furi_assert(current_record.size());
-    furi_assert(ff);
 
-    InfraredAppSignal signal;
-    std::string signal_name;
-    bool result = false;
-    do {
-        result = infrared_parser_read_signal(ff, signal, signal_name);
-    } while(result && current_record.compare(signal_name));
+    if(!next_signal_ready) {
+        next_signal_ready = load_next_signal(next_signal);
+    }
 
+    bool result = next_signal_ready;
     if(result) {
-        signal.transmit();
+        next_signal.transmit();
+        /* prepare following signal now, next step only transmits */
+        next_signal_ready = load_next_signal(next_signal);
     }
     return result;
 }
 
 bool InfraredAppBruteForce::start_bruteforce(int index, int& record_amount) {
     bool result = false;
+    uint8_t record_id = 0;
     record_amount = 0;
 
     for(const auto& it : records) {
         if(it.second.index == index) {
             record_amount = it.second.amount;
+            record_id = it.second.id;
             if(record_amount) {
                 current_record = it.first;
             }
@@ -82,10 +367,12 @@ bool InfraredAppBruteForce::start_bruteforce(int index, int& record_amount) {
 
     if(record_amount) {
         Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
-        ff = flipper_format_file_alloc(storage);
-        result = flipper_format_file_open_existing(ff, universal_db_filename);
-        if(!result) {
-            flipper_format_free(ff);
+        result = load_entries(storage, record_id, record_amount);
+        if(result) {
+            current_position = 0;
+            next_signal_ready = false;
+        } else {
+            current_record.clear();
             furi_record_close("storage");
         }
     }
@@ -4,22 +4,65 @@
   */
 #pragma once
 
+#include "infrared_app_signal.h"
+
 #include <unordered_map>
 #include <memory>
+#include <string>
+#include <vector>
 #include <flipper_format/flipper_format.h>
+#include <storage/storage.h>
 
-/** Class handles brute force mechanic */
+/** Class handles brute force mechanic
+ *
+ * Database is described by sidecar index file (database name + ".idx"):
+ * file offset of every signal of known records and already decoded
+ * parsed signals. Index is rebuilt when database content changes,
+ * so brute force reads database only for raw signals.
+ */
 class InfraredAppBruteForce {
     /** Universal database filename */
     const char* universal_db_filename;
 
+    /** Sidecar index filename */
+    std::string index_filename;
+
     /** Current record name (POWER, MUTE, VOL+, etc).
      * This is the name of signal to brute force. */
     std::string current_record;
 
-    /** Flipper File Format instance */
+    /** Flipper File Format instance, opened on first raw signal */
     FlipperFormat* ff;
 
+    /** Index entry, one per signal of known record */
+    typedef struct {
+        /** Record id, position in index record table */
+        uint8_t record_id;
+        /** Protocol of parsed signal, index_raw_protocol for raw */
+        uint8_t protocol;
+        /** Offset of signal in database */
+        uint32_t offset;
+        /** Address of parsed signal */
+        uint32_t address;
+        /** Command of parsed signal */
+        uint32_t command;
+    } __attribute__((packed)) IndexEntry;
+
+    /** Protocol value of raw signal entries */
+    static constexpr const uint8_t index_raw_protocol = UINT8_MAX;
+
+    /** Entries of current record */
+    std::vector<IndexEntry> current_entries;
+
+    /** Next entry to send */
+    size_t current_position;
+
+    /** Signal prepared to be sent on next step */
+    InfraredAppSignal next_signal;
+
+    /** true if next_signal is prepared */
+    bool next_signal_ready;
+
     /** Data about every record - index in button panel view
      * and amount of signals, which is need for correct
      * progress bar displaying. */
@@ -28,6 +71,8 @@ class InfraredAppBruteForce {
         int index;
         /** Amount of signals of that type (POWER, MUTE, etc) */
         int amount;
+        /** Record id in index file */
+        uint8_t id;
     } Record;
 
     /** Container to hold Record info.
@@ -39,9 +84,30 @@ class InfraredAppBruteForce {
      */
     std::unordered_map<std::string, Record> records;
 
+    /** Offset of first entry in index file */
+    uint32_t index_entries_offset;
+
+    /** Size and mtime of database, FNV-1a hash of all of it if filesystem keeps no mtime */
+    bool fingerprint_database(Storage* storage, uint32_t& db_size, uint32_t& db_stamp);
+
+    /** Load record amounts from index, fails if index is missing or stale */
+    bool load_index(Storage* storage, uint32_t db_size, uint32_t db_stamp);
+
+    /** Walk through the database and write index */
+    bool build_index(Storage* storage, uint32_t db_size, uint32_t db_stamp);
+
+    /** Load entries of current record from index */
+    bool load_entries(Storage* storage, uint8_t record_id, int amount);
+
+    /** Prepare signal of next entry, skipping unreadable ones */
+    bool load_next_signal(InfraredAppSignal& signal);
+
+    /** Read raw signal of current record at database offset */
+    bool read_raw_signal(uint32_t offset, InfraredAppSignal& signal);
+
 public:
-    /** Calculate messages. Walk through the file ('universal_db_name')
-     * and calculate amount of records of certain type. */
+    /** Calculate messages. Load amount of records of certain
+     * type from index, rebuild index if database was changed. */
     bool calculate_messages();
 
     /** Start brute force */
@@ -58,7 +124,12 @@ public:
 
     /** Initialize class, set db file */
     InfraredAppBruteForce(const char* filename)
-        : universal_db_filename(filename) {
+        : universal_db_filename(filename)
+        , index_filename(std::string(filename) + ".idx")
+        , ff(nullptr)
+        , current_position(0)
+        , next_signal_ready(false)
+        , index_entries_offset(0) {
     }
 
     /** Deinitialize class */
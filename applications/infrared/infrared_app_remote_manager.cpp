@@ -1,5 +1,6 @@
 #include <file_worker_cpp.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
 #include "infrared_app_remote_manager.h"
 #include "infrared/helpers/infrared_parser.h"
 #include "infrared/infrared_app_signal.h"
@@ -13,7 +14,11 @@
 #include <storage/storage.h>
 #include "infrared_app.h"
 
+#define TAG "RemoteManager"
+
 static const std::string default_remote_name = "remote";
+/** Longest line prefix kept while scanning, enough for key and name */
+static constexpr const size_t scan_line_max = 128;
 
 std::string InfraredAppRemoteManager::make_full_name(
     const std::string& path,
@@ -45,8 +50,35 @@ std::string InfraredAppRemoteManager::find_vacant_remote_name(const std::string&
 }
 
 bool InfraredAppRemoteManager::add_button(const char* button_name, const InfraredAppSignal& signal) {
-    remote->buttons.emplace_back(button_name, signal);
-    return store();
+    furi_check(remote.get() != nullptr);
+    FileWorkerCpp file_worker;
+    if(!file_worker.mkdir(InfraredApp::infrared_directory)) return false;
+
+    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    Stream* stream = flipper_format_get_raw_stream(ff);
+
+    /* only new record is written, other signals stay untouched */
+    bool result =
+        flipper_format_file_open_append(ff, make_full_name(remote->path, remote->name).c_str());
+    if(result && (stream_size(stream) == 0)) {
+        result = flipper_format_write_header_cstr(ff, "IR signals file", 1);
+    }
+
+    size_t offset = stream_tell(stream);
+    if(result) {
+        result = infrared_parser_save_signal(ff, signal, button_name);
+    }
+    if(result) {
+        uint32_t id = remote->next_button_id++;
+        remote->buttons.emplace_back(
+            button_name, offset, stream_tell(stream) - offset, signal.is_raw(), id);
+        cache_signal(id, signal);
+    }
+
+    flipper_format_free(ff);
+    furi_record_close("storage");
+    return result;
 }
 
 bool InfraredAppRemoteManager::add_remote_with_button(
@@ -75,12 +107,108 @@ std::vector<std::string> InfraredAppRemoteManager::get_button_list(void) const {
     return name_vector;
 }
 
-const InfraredAppSignal& InfraredAppRemoteManager::get_button_data(size_t index) const {
+void InfraredAppRemoteManager::cache_signal(uint32_t id, const InfraredAppSignal& signal) {
+    auto& cache = remote->signal_cache;
+    cache.emplace_front(id, signal);
+    if(cache.size() > signal_cache_size) {
+        cache.pop_back();
+    }
+}
+
+bool InfraredAppRemoteManager::seek_to_button(
+    FlipperFormat* ff,
+    const InfraredAppRemoteButton& button) {
+    Stream* stream = flipper_format_get_raw_stream(ff);
+    string_t name;
+    string_init(name);
+
+    bool result = false;
+    do {
+        auto full_name = make_full_name(remote->path, remote->name);
+        if(!flipper_format_file_open_existing(ff, full_name.c_str())) break;
+        if(!stream_seek(stream, button.offset, StreamOffsetFromStart)) break;
+        if(!flipper_format_read_string(ff, "name", name)) break;
+        if(fnv1a_string_hash(string_get_cstr(name)) != button.name_hash) {
+            FURI_LOG_E(
+                TAG, "File was changed, no \'%s\' at %u", button.name.c_str(), button.offset);
+            break;
+        }
+        if(!stream_seek(stream, button.offset, StreamOffsetFromStart)) break;
+        result = true;
+    } while(false);
+
+    string_clear(name);
+    return result;
+}
+
+bool InfraredAppRemoteManager::get_button_data(size_t index, InfraredAppSignal& signal) {
     furi_check(remote.get() != nullptr);
     auto& buttons = remote->buttons;
     furi_check(index < buttons.size());
+    auto& button = buttons[index];
+
+    auto& cache = remote->signal_cache;
+    for(auto it = cache.begin(); it != cache.end(); ++it) {
+        if(it->first == button.id) {
+            cache.splice(cache.begin(), cache, it);
+            signal = it->second;
+            return true;
+        }
+    }
+
+    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    std::string signal_name;
+
+    bool result = seek_to_button(ff, button) &&
+                  infrared_parser_read_signal(ff, signal, signal_name);
+    if(result) {
+        cache_signal(button.id, signal);
+    }
+
+    flipper_format_free(ff);
+    furi_record_close("storage");
+    return result;
+}
+
+bool InfraredAppRemoteManager::replace_button_record(uint32_t index, FlipperFormat* record) {
+    auto& buttons = remote->buttons;
+    auto& button = buttons[index];
 
-    return buttons.at(index).signal;
+    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    Stream* stream = flipper_format_get_raw_stream(ff);
+
+    bool result = seek_to_button(ff, button);
+    size_t new_size = 0;
+    if(result && record) {
+        Stream* record_stream = flipper_format_get_raw_stream(record);
+        new_size = stream_size(record_stream);
+        result = stream_rewind(record_stream) &&
+                 stream_delete_and_insert(
+                     stream,
+                     button.size,
+                     [](Stream* to, const void* context) {
+                         Stream* from = static_cast<Stream*>(const_cast<void*>(context));
+                         size_t size = stream_size(from);
+                         return stream_copy(from, to, size) == size;
+                     },
+                     record_stream);
+    } else if(result) {
+        result = stream_delete(stream, button.size);
+    }
+
+    if(result) {
+        /* following records moved */
+        for(size_t i = index + 1; i < buttons.size(); ++i) {
+            buttons[i].offset = buttons[i].offset + new_size - button.size;
+        }
+        button.size = new_size;
+    }
+
+    flipper_format_free(ff);
+    furi_record_close("storage");
+    return result;
 }
 
 bool InfraredAppRemoteManager::delete_remote() {
@@ -101,8 +229,12 @@ bool InfraredAppRemoteManager::delete_button(uint32_t index) {
     auto& buttons = remote->buttons;
     furi_check(index < buttons.size());
 
+    if(!replace_button_record(index, nullptr)) return false;
+
+    uint32_t id = buttons[index].id;
+    remote->signal_cache.remove_if([id](const auto& item) { return item.first == id; });
     buttons.erase(buttons.begin() + index);
-    return store();
+    return true;
 }
 
 std::string InfraredAppRemoteManager::get_button_name(uint32_t index) {
@@ -144,8 +276,20 @@ bool InfraredAppRemoteManager::rename_button(uint32_t index, const char* str) {
     auto& buttons = remote->buttons;
     furi_check(index < buttons.size());
 
-    buttons[index].name = str;
-    return store();
+    InfraredAppSignal signal;
+    if(!get_button_data(index, signal)) return false;
+
+    /* serialize renamed record in memory, then swap it in file */
+    FlipperFormat* record = flipper_format_string_alloc();
+    bool result = infrared_parser_save_signal(record, signal, str) &&
+                  replace_button_record(index, record);
+    flipper_format_free(record);
+
+    if(result) {
+        buttons[index].name = str;
+        buttons[index].name_hash = fnv1a_string_hash(str);
+    }
+    return result;
 }
 
 size_t InfraredAppRemoteManager::get_number_of_buttons() {
@@ -153,34 +297,63 @@ size_t InfraredAppRemoteManager::get_number_of_buttons() {
     return remote->buttons.size();
 }
 
-bool InfraredAppRemoteManager::store(void) {
-    bool result = false;
-    FileWorkerCpp file_worker;
-
-    if(!file_worker.mkdir(InfraredApp::infrared_directory)) return false;
+bool InfraredAppRemoteManager::scan_buttons(Stream* stream) {
+    uint8_t buffer[64];
+    std::string line;
+    size_t position = stream_tell(stream);
+    size_t line_start = position;
+    /* record includes comment lines right before its name */
+    size_t comment_start = SIZE_MAX;
+    auto& buttons = remote->buttons;
 
-    Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
-    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    auto process_line = [&]() {
+        if(line[0] == '#') {
+            if(comment_start == SIZE_MAX) comment_start = line_start;
+            return;
+        }
 
-    FURI_LOG_I(
-        "RemoteManager", "store file: \'%s\'", make_full_name(remote->path, remote->name).c_str());
-    result =
-        flipper_format_file_open_always(ff, make_full_name(remote->path, remote->name).c_str());
-    if(result) {
-        result = flipper_format_write_header_cstr(ff, "IR signals file", 1);
-    }
-    if(result) {
-        for(const auto& button : remote->buttons) {
-            result = infrared_parser_save_signal(ff, button.signal, button.name.c_str());
-            if(!result) {
-                break;
+        size_t delimiter = line.find(':');
+        if(delimiter != std::string::npos) {
+            size_t value_start = line.find_first_not_of(' ', delimiter + 1);
+            std::string value = (value_start != std::string::npos) ? line.substr(value_start) :
+                                                                     std::string();
+            if(!line.compare(0, delimiter, "name")) {
+                size_t record_start = (comment_start != SIZE_MAX) ? comment_start : line_start;
+                if(!buttons.empty()) {
+                    buttons.back().size = record_start - buttons.back().offset;
+                }
+                buttons.emplace_back(
+                    value.c_str(), record_start, 0, false, remote->next_button_id++);
+            } else if(!line.compare(0, delimiter, "type") && !buttons.empty()) {
+                buttons.back().raw = !value.compare("raw");
             }
         }
+        comment_start = SIZE_MAX;
+    };
+
+    while(true) {
+        size_t was_read = stream_read(stream, buffer, sizeof(buffer));
+        if(was_read == 0) break;
+
+        for(size_t i = 0; i < was_read; ++i) {
+            char data = buffer[i];
+            if(data == '\n') {
+                if(!line.empty()) process_line();
+                line.clear();
+                line_start = position + i + 1;
+            } else if((data != '\r') && (line.size() < scan_line_max)) {
+                line.push_back(data);
+            }
+        }
+        position += was_read;
     }
+    if(!line.empty()) process_line();
 
-    flipper_format_free(ff);
-    furi_record_close("storage");
-    return result;
+    if(!buttons.empty()) {
+        buttons.back().size = position - buttons.back().offset;
+    }
+
+    return position == stream_size(stream);
 }
 
 bool InfraredAppRemoteManager::load(const std::string& path, const std::string& remote_name) {
@@ -188,7 +361,7 @@ bool InfraredAppRemoteManager::load(const std::string& path, const std::string&
     Storage* storage = static_cast<Storage*>(furi_record_open("storage"));
     FlipperFormat* ff = flipper_format_file_alloc(storage);
 
-    FURI_LOG_I("RemoteManager", "load file: \'%s\'", make_full_name(path, remote_name).c_str());
+    FURI_LOG_I(TAG, "load file: \'%s\'", make_full_name(path, remote_name).c_str());
     result = flipper_format_file_open_existing(ff, make_full_name(path, remote_name).c_str());
     if(result) {
         string_t header;
@@ -202,11 +375,7 @@ bool InfraredAppRemoteManager::load(const std::string& path, const std::string&
     }
     if(result) {
         remote = std::make_unique<InfraredAppRemote>(path, remote_name);
-        InfraredAppSignal signal;
-        std::string signal_name;
-        while(infrared_parser_read_signal(ff, signal, signal_name)) {
-            remote->buttons.emplace_back(signal_name.c_str(), std::move(signal));
-        }
+        result = scan_buttons(flipper_format_get_raw_stream(ff));
     }
 
     flipper_format_free(ff);
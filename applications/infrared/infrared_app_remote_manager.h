@@ -3,6 +3,8 @@
   * Infrared: Remote manager class.
   * It holds remote, can load/save/rename remote,
   * add/remove/rename buttons.
+  * Remote file is scanned once on load to build button index,
+  * signals are read on demand and edits touch only own record.
   */
 #pragma once
 
@@ -11,39 +13,51 @@
 #include <infrared_worker.h>
 #include <infrared.h>
 
+#include <flipper_format/flipper_format.h>
+#include <toolbox/stream/stream.h>
+#include <fnv1a-hash.h>
+
 #include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
+#include <list>
 
-/** Class to handle remote button */
+/** Class to handle remote button.
+ * Only index of signal in remote file is kept, signal
+ * itself is read from file on demand. */
 class InfraredAppRemoteButton {
     /** Allow field access */
     friend class InfraredAppRemoteManager;
     /** Name of signal */
     std::string name;
-    /** Signal data */
-    InfraredAppSignal signal;
+    /** Hash of name, to check that file record still belongs to button */
+    uint32_t name_hash;
+    /** Offset of signal record in remote file */
+    size_t offset;
+    /** Size of signal record in remote file */
+    size_t size;
+    /** true if signal is raw, false if signal is parsed */
+    bool raw;
+    /** Button id, unique within remote. Key in signal cache. */
+    uint32_t id;
 
 public:
     /** Initialize remote button
      *
      * @param name - button name
-     * @param signal - signal to copy for remote button
-     */
-    InfraredAppRemoteButton(const char* name, const InfraredAppSignal& signal)
-        : name(name)
-        , signal(signal) {
-    }
-
-    /** Initialize remote button
-     *
-     * @param name - button name
-     * @param signal - signal to move for remote button
+     * @param offset - offset of signal record in remote file
+     * @param size - size of signal record in remote file
+     * @param raw - type of signal
+     * @param id - unique button id
      */
-    InfraredAppRemoteButton(const char* name, InfraredAppSignal&& signal)
+    InfraredAppRemoteButton(const char* name, size_t offset, size_t size, bool raw, uint32_t id)
         : name(name)
-        , signal(std::move(signal)) {
+        , name_hash(fnv1a_string_hash(name))
+        , offset(offset)
+        , size(size)
+        , raw(raw)
+        , id(id) {
     }
 
     /** Deinitialize remote button */
@@ -57,6 +71,10 @@ class InfraredAppRemote {
     friend class InfraredAppRemoteManager;
     /** Button container */
     std::vector<InfraredAppRemoteButton> buttons;
+    /** Recently used signals, most recent first */
+    std::list<std::pair<uint32_t, InfraredAppSignal>> signal_cache;
+    /** Id for next added button */
+    uint32_t next_button_id;
     /** Name of remote */
     std::string name;
     /** Path to remote file */
@@ -69,7 +87,8 @@ public:
      * @param name - new remote name
      */
     InfraredAppRemote(const std::string& path, const std::string& name)
-        : name(name)
+        : next_button_id(0)
+        , name(name)
         , path(path) {
     }
 };
@@ -78,6 +97,8 @@ public:
 class InfraredAppRemoteManager {
     /** Remote instance. There can be 1 remote loaded at a time. */
     std::unique_ptr<InfraredAppRemote> remote;
+    /** Number of signals kept in memory after use */
+    static constexpr const size_t signal_cache_size = 4;
     /** Make full name from remote name
      *
      * @param remote_name name of remote
@@ -85,6 +106,37 @@ class InfraredAppRemoteManager {
      */
     std::string make_full_name(const std::string& path, const std::string& remote_name) const;
 
+    /** Build button index of current remote, file is read once
+     * and signal payloads are skipped without parsing
+     *
+     * @param stream - remote file stream, positioned after header
+     * @retval true for success, false otherwise
+     */
+    bool scan_buttons(Stream* stream);
+
+    /** Open remote file and check that button record is where index says
+     *
+     * @param ff - Flipper File Format instance to open file with
+     * @param button - button to find
+     * @retval true if stream is positioned at button record, false otherwise
+     */
+    bool seek_to_button(FlipperFormat* ff, const InfraredAppRemoteButton& button);
+
+    /** Put signal to cache of recently used signals
+     *
+     * @param id - button id
+     * @param signal - signal to copy
+     */
+    void cache_signal(uint32_t id, const InfraredAppSignal& signal);
+
+    /** Replace button record in remote file and shift following records
+     *
+     * @param index - index of button to replace
+     * @param record - new record, nullptr to delete record
+     * @retval true for success, false otherwise
+     */
+    bool replace_button_record(uint32_t index, FlipperFormat* record);
+
 public:
     /** Restriction to button name length. Buttons larger are ignored. */
     static constexpr const uint32_t max_button_name_length = 22;
@@ -154,12 +206,13 @@ public:
      */
     size_t get_number_of_buttons();
 
-    /** Get button's signal
+    /** Get button's signal, reads it from disk if not cached
      *
      * @param index - index of interested button
-     * @retval signal
+     * @param signal - signal to copy button signal to
+     * @retval true if success, false otherwise
      */
-    const InfraredAppSignal& get_button_data(size_t index) const;
+    bool get_button_data(size_t index, InfraredAppSignal& signal);
 
     /** Delete button
      *
@@ -177,12 +230,6 @@ public:
     /** Clean all loaded info in current remote */
     void reset_remote();
 
-    /** Store current remote data on disk
-     *
-     * @retval true if success, false otherwise
-     */
-    bool store();
-
     /** Load data from disk into current remote
      *
      * @param name - name of remote to load
@@ -20,9 +20,15 @@ void InfraredAppSceneEditDelete::on_enter(InfraredApp* app) {
     auto remote_manager = app->get_remote_manager();
 
     if(app->get_edit_element() == InfraredApp::EditElement::Button) {
-        auto signal = remote_manager->get_button_data(app->get_current_button());
+        InfraredAppSignal signal;
+        bool signal_loaded = remote_manager->get_button_data(app->get_current_button(), signal);
         dialog_ex_set_header(dialog_ex, "Delete button?", 64, 0, AlignCenter, AlignTop);
-        if(!signal.is_raw()) {
+        if(!signal_loaded) {
+            app->set_text_store(
+                0,
+                "%s\nUnreadable signal",
+                remote_manager->get_button_name(app->get_current_button()).c_str());
+        } else if(!signal.is_raw()) {
             auto message = &signal.get_message();
             app->set_text_store(
                 0,
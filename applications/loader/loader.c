@@ -6,7 +6,11 @@
 #define TAG "LoaderSrv"
 
 #define LOADER_THREAD_FLAG_SHOW_MENU (1 << 0)
-#define LOADER_THREAD_FLAG_ALL (LOADER_THREAD_FLAG_SHOW_MENU)
+#define LOADER_THREAD_FLAG_SAVE_STATS (1 << 1)
+#define LOADER_THREAD_FLAG_ALL (LOADER_THREAD_FLAG_SHOW_MENU | LOADER_THREAD_FLAG_SAVE_STATS)
+
+/** Runs that only bump counters are saved in one go after this delay */
+#define LOADER_STATS_SAVE_DELAY_MS 30000
 
 static Loader* loader_instance = NULL;
 
@@ -63,6 +67,7 @@ static void loader_cli_print_usage() {
     printf("Cmd list:\r\n");
     printf("\tlist\t - List available applications\r\n");
     printf("\topen <Application Name:string>\t - Open application by name\r\n");
+    printf("\tstats [reset]\t - Show or reset stack, heap and run time of apps\r\n");
 }
 
 const FlipperApplication* loader_find_application_by_name(const char* name) {
@@ -149,6 +154,37 @@ void loader_cli_list(Cli* cli, string_t args, Loader* instance) {
     }
 }
 
+void loader_cli_stats(Cli* cli, string_t args, Loader* instance) {
+    if(string_cmp_str(args, "reset") == 0) {
+        loader_reset_stats(instance);
+        return;
+    } else if(string_size(args)) {
+        cli_print_usage("loader stats", "[reset]", string_get_cstr(args));
+        return;
+    }
+
+    printf(
+        "%-24s %6s %10s %12s %10s %10s\r\n",
+        "Name",
+        "Runs",
+        "Last ms",
+        "Stack",
+        "Heap peak",
+        "Heap live");
+    LoaderAppStats stats;
+    for(size_t i = 0; loader_get_stats(instance, i, &stats); i++) {
+        printf(
+            "%-24s %6lu %10lu %5lu/%-6lu %10lu %10lu\r\n",
+            stats.name,
+            stats.runs,
+            stats.run_time,
+            stats.stack_peak,
+            stats.stack_size,
+            stats.heap_peak,
+            stats.heap_live);
+    }
+}
+
 void loader_cli(Cli* cli, string_t args, void* _ctx) {
     furi_assert(_ctx);
     Loader* instance = _ctx;
@@ -172,6 +208,11 @@ void loader_cli(Cli* cli, string_t args, void* _ctx) {
             break;
         }
 
+        if(string_cmp_str(cmd, "stats") == 0) {
+            loader_cli_stats(cli, args, instance);
+            break;
+        }
+
         loader_cli_print_usage();
     } while(false);
 
@@ -221,6 +262,67 @@ bool loader_is_locked(Loader* instance) {
     return instance->lock_count > 0;
 }
 
+/** Menu dispatcher runs on LoaderSrv thread and holds it while app is running, so request
+ * goes both ways: thread flag for idle LoaderSrv and one queued event for running menu */
+static void loader_request_stats_save(Loader* instance) {
+    osThreadFlagsSet(instance->loader_thread, LOADER_THREAD_FLAG_SAVE_STATS);
+    if(!__atomic_exchange_n(&instance->stats_event_pending, true, __ATOMIC_ACQ_REL)) {
+        view_dispatcher_send_custom_event(instance->view_dispatcher, LoaderCustomEventSaveStats);
+    }
+}
+
+static void loader_account_run(Loader* instance) {
+    FuriThread* thread = instance->application_thread;
+
+    LoaderAppStats run = {
+        .run_time = (osKernelGetTickCount() - instance->start_tick) * 1000 / osKernelGetTickFreq(),
+        .stack_size = instance->application->stack_size,
+        .heap_peak = furi_thread_get_heap_peak(thread),
+        .heap_live = furi_thread_get_heap_size(thread),
+    };
+    run.stack_peak = run.stack_size - MIN(furi_thread_get_stack_space(thread), run.stack_size);
+    strncpy(run.name, instance->application->name, LOADER_STATS_NAME_SIZE - 1);
+
+    FURI_LOG_I(
+        TAG,
+        "Stack used: %lu of %lu. Heap peak: %lu. Run time: %lums.",
+        run.stack_peak,
+        run.stack_size,
+        run.heap_peak,
+        run.run_time);
+
+    // Saving is up to LoaderSrv: no flash writes on app thread
+    if(loader_stats_add_run(instance->stats, &run)) {
+        loader_request_stats_save(instance);
+    } else {
+        osTimerStart(
+            instance->stats_timer, LOADER_STATS_SAVE_DELAY_MS * osKernelGetTickFreq() / 1000);
+    }
+}
+
+static void loader_stats_timer_callback(void* context) {
+    Loader* instance = context;
+    loader_request_stats_save(instance);
+}
+
+/** LoaderSrv thread only */
+static void loader_save_stats_if_requested(Loader* instance) {
+    uint32_t flags = osThreadFlagsClear(LOADER_THREAD_FLAG_SAVE_STATS);
+    if(!(flags & osFlagsError) && (flags & LOADER_THREAD_FLAG_SAVE_STATS)) {
+        loader_stats_save(instance->stats);
+    }
+}
+
+static bool loader_custom_event_callback(void* context, uint32_t event) {
+    Loader* instance = context;
+    if(event == LoaderCustomEventSaveStats) {
+        __atomic_store_n(&instance->stats_event_pending, false, __ATOMIC_RELEASE);
+        loader_save_stats_if_requested(instance);
+        return true;
+    }
+    return false;
+}
+
 static void loader_thread_state_callback(FuriThreadState thread_state, void* context) {
     furi_assert(context);
 
@@ -234,6 +336,7 @@ static void loader_thread_state_callback(FuriThreadState thread_state, void* con
 
         // Snapshot current memory usage
         instance->free_heap_size = memmgr_get_free_heap();
+        instance->start_tick = osKernelGetTickCount();
     } else if(thread_state == FuriThreadStateStopped) {
         /*
          * Current Leak Sanitizer assumes that memory is allocated and freed
@@ -252,6 +355,7 @@ static void loader_thread_state_callback(FuriThreadState thread_state, void* con
             "Application thread stopped. Heap allocation balance: %d. Thread allocation balance: %d.",
             heap_diff,
             furi_thread_get_heap_size(instance->application_thread));
+        loader_account_run(instance);
 
         if(loader_instance->application_arguments) {
             free(loader_instance->application_arguments);
@@ -280,6 +384,9 @@ static uint32_t loader_back_to_primary_menu(void* context) {
 static Loader* loader_alloc() {
     Loader* instance = malloc(sizeof(Loader));
 
+    instance->stats = loader_stats_alloc();
+    instance->stats_timer = osTimerNew(loader_stats_timer_callback, osTimerOnce, instance, NULL);
+
     instance->application_thread = furi_thread_alloc();
     furi_thread_enable_heap_trace(instance->application_thread);
     furi_thread_set_state_context(instance->application_thread, instance);
@@ -331,6 +438,9 @@ static Loader* loader_alloc() {
         submenu_get_view(instance->settings_menu));
 
     view_dispatcher_enable_queue(instance->view_dispatcher);
+    view_dispatcher_set_event_callback_context(instance->view_dispatcher, instance);
+    view_dispatcher_set_custom_event_callback(
+        instance->view_dispatcher, loader_custom_event_callback);
 
     return instance;
 }
@@ -346,6 +456,9 @@ static void loader_free(Loader* instance) {
 
     furi_thread_free(instance->application_thread);
 
+    osTimerDelete(instance->stats_timer);
+    loader_stats_free(instance->stats);
+
     menu_free(loader_instance->primary_menu);
     view_dispatcher_remove_view(loader_instance->view_dispatcher, LoaderMenuViewPrimary);
     submenu_free(loader_instance->plugins_menu);
@@ -467,6 +580,9 @@ int32_t loader_srv(void* p) {
 
     while(1) {
         uint32_t flags = osThreadFlagsWait(LOADER_THREAD_FLAG_ALL, osFlagsWaitAny, osWaitForever);
+        if(flags & LOADER_THREAD_FLAG_SAVE_STATS) {
+            loader_stats_save(loader_instance->stats);
+        }
         if(flags & LOADER_THREAD_FLAG_SHOW_MENU) {
             menu_set_selected_item(loader_instance->primary_menu, 0);
             view_dispatcher_switch_to_view(
@@ -484,3 +600,18 @@ int32_t loader_srv(void* p) {
 FuriPubSub* loader_get_pubsub(Loader* instance) {
     return instance->pubsub;
 }
+
+bool loader_get_stats(Loader* instance, size_t index, LoaderAppStats* stats) {
+    furi_assert(instance);
+    if(index == 0) {
+        // Someone looks at stats: persist pending runs now, not on timer
+        loader_request_stats_save(instance);
+    }
+    return loader_stats_get(instance->stats, index, stats);
+}
+
+void loader_reset_stats(Loader* instance) {
+    furi_assert(instance);
+    loader_stats_reset(instance->stats);
+    loader_request_stats_save(instance);
+}
@@ -2,6 +2,8 @@
 
 #include <furi/pubsub.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 
 typedef struct Loader Loader;
 
@@ -21,6 +23,20 @@ typedef struct {
     LoaderEventType type;
 } LoaderEvent;
 
+#define LOADER_STATS_NAME_SIZE 24
+
+/** Application run telemetry, kept per application for current firmware build */
+typedef struct {
+    char name[LOADER_STATS_NAME_SIZE];
+    uint32_t runs;
+    uint32_t run_time; /**< last run, ms */
+    uint32_t run_time_total; /**< all runs, ms */
+    uint32_t stack_size; /**< configured stack, bytes */
+    uint32_t stack_peak; /**< most stack used by any run, bytes */
+    uint32_t heap_peak; /**< most heap held by app thread in any run, bytes */
+    uint32_t heap_live; /**< heap left allocated by app thread after last run, bytes */
+} LoaderAppStats;
+
 /** Start application
  * @param name - application name
  * @param args - application arguments
@@ -47,3 +63,14 @@ void loader_update_menu();
 
 /** Show primary loader */
 FuriPubSub* loader_get_pubsub(Loader* instance);
+
+/** Get application run telemetry
+ * Reading record 0 makes LoaderSrv save pending telemetry.
+ * @param index - record index, records are in order of first run
+ * @param stats - record copy
+ * @retval false if index is out of range
+ */
+bool loader_get_stats(Loader* instance, size_t index, LoaderAppStats* stats);
+
+/** Reset application run telemetry */
+void loader_reset_stats(Loader* instance);
@@ -1,4 +1,5 @@
 #include "loader.h"
+#include "loader_stats.h"
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -31,6 +32,10 @@ struct Loader {
     Submenu* settings_menu;
 
     size_t free_heap_size;
+    uint32_t start_tick;
+    LoaderStats* stats;
+    osTimerId_t stats_timer;
+    bool stats_event_pending;
     volatile uint8_t lock_count;
 
     FuriPubSub* pubsub;
@@ -42,3 +47,7 @@ typedef enum {
     LoaderMenuViewDebug,
     LoaderMenuViewSettings,
 } LoaderMenuView;
+
+typedef enum {
+    LoaderCustomEventSaveStats,
+} LoaderCustomEvent;
@@ -0,0 +1,161 @@
+#include "loader_stats.h"
+
+#include <furi.h>
+#include <toolbox/saved_struct.h>
+#include <toolbox/version.h>
+
+#define TAG "LoaderStats"
+
+#define LOADER_STATS_HEADER_MAGIC 0x1D
+#define LOADER_STATS_HEADER_VERSION 0x01
+#define LOADER_STATS_BUILD_SIZE 16
+
+typedef struct {
+    char build[LOADER_STATS_BUILD_SIZE]; /**< git hash of firmware that collected stats */
+    uint32_t count;
+    LoaderAppStats apps[LOADER_STATS_COUNT];
+} LoaderStatsData;
+
+struct LoaderStats {
+    osMutexId_t mutex;
+    LoaderStatsData data;
+    /** Changed since last save */
+    bool dirty;
+};
+
+static void loader_stats_clear(LoaderStats* stats) {
+    memset(&stats->data, 0, sizeof(LoaderStatsData));
+    strncpy(
+        stats->data.build, version_get_githash(version_get()), LOADER_STATS_BUILD_SIZE - 1);
+}
+
+LoaderStats* loader_stats_alloc() {
+    LoaderStats* stats = malloc(sizeof(LoaderStats));
+    stats->mutex = osMutexNew(NULL);
+
+    bool loaded = saved_struct_load(
+        LOADER_STATS_PATH,
+        &stats->data,
+        sizeof(LoaderStatsData),
+        LOADER_STATS_HEADER_MAGIC,
+        LOADER_STATS_HEADER_VERSION);
+
+    if(!loaded || stats->data.count > LOADER_STATS_COUNT) {
+        FURI_LOG_W(TAG, "No stats, starting over");
+        loader_stats_clear(stats);
+    } else if(strncmp(
+                  stats->data.build,
+                  version_get_githash(version_get()),
+                  LOADER_STATS_BUILD_SIZE - 1) != 0) {
+        FURI_LOG_I(TAG, "Stats of build %s dropped", stats->data.build);
+        loader_stats_clear(stats);
+    }
+
+    return stats;
+}
+
+void loader_stats_free(LoaderStats* stats) {
+    furi_assert(stats);
+    osMutexDelete(stats->mutex);
+    free(stats);
+}
+
+static LoaderAppStats* loader_stats_find(LoaderStats* stats, const char* name) {
+    LoaderStatsData* data = &stats->data;
+
+    for(size_t i = 0; i < data->count; i++) {
+        if(strncmp(data->apps[i].name, name, LOADER_STATS_NAME_SIZE - 1) == 0) {
+            return &data->apps[i];
+        }
+    }
+
+    LoaderAppStats* record = NULL;
+    if(data->count < LOADER_STATS_COUNT) {
+        record = &data->apps[data->count++];
+    } else {
+        record = &data->apps[0];
+        for(size_t i = 1; i < data->count; i++) {
+            if(data->apps[i].runs < record->runs) record = &data->apps[i];
+        }
+        FURI_LOG_I(TAG, "Table is full, %s replaces %s", name, record->name);
+    }
+
+    memset(record, 0, sizeof(LoaderAppStats));
+    strncpy(record->name, name, LOADER_STATS_NAME_SIZE - 1);
+    return record;
+}
+
+bool loader_stats_add_run(LoaderStats* stats, const LoaderAppStats* run) {
+    furi_assert(stats);
+    furi_assert(run);
+    furi_check(osMutexAcquire(stats->mutex, osWaitForever) == osOK);
+
+    LoaderAppStats* record = loader_stats_find(stats, run->name);
+    bool changed = record->runs == 0 || run->stack_peak > record->stack_peak ||
+                   run->heap_peak > record->heap_peak;
+    record->runs++;
+    record->run_time = run->run_time;
+    record->run_time_total += run->run_time;
+    record->stack_size = run->stack_size;
+    record->stack_peak = MAX(record->stack_peak, run->stack_peak);
+    record->heap_peak = MAX(record->heap_peak, run->heap_peak);
+    record->heap_live = run->heap_live;
+    stats->dirty = true;
+
+    furi_check(osMutexRelease(stats->mutex) == osOK);
+    return changed;
+}
+
+bool loader_stats_get(LoaderStats* stats, size_t index, LoaderAppStats* record) {
+    furi_assert(stats);
+    furi_assert(record);
+    furi_check(osMutexAcquire(stats->mutex, osWaitForever) == osOK);
+
+    bool found = index < stats->data.count;
+    if(found) {
+        *record = stats->data.apps[index];
+    }
+
+    furi_check(osMutexRelease(stats->mutex) == osOK);
+    return found;
+}
+
+void loader_stats_reset(LoaderStats* stats) {
+    furi_assert(stats);
+    furi_check(osMutexAcquire(stats->mutex, osWaitForever) == osOK);
+    loader_stats_clear(stats);
+    stats->dirty = true;
+    furi_check(osMutexRelease(stats->mutex) == osOK);
+}
+
+bool loader_stats_save(LoaderStats* stats) {
+    furi_assert(stats);
+
+    // Snapshot, so that runs are not blocked by flash write
+    LoaderStatsData* data = NULL;
+    furi_check(osMutexAcquire(stats->mutex, osWaitForever) == osOK);
+    if(stats->dirty) {
+        data = malloc(sizeof(LoaderStatsData));
+        *data = stats->data;
+        stats->dirty = false;
+    }
+    furi_check(osMutexRelease(stats->mutex) == osOK);
+
+    if(!data) return true;
+
+    bool result = saved_struct_save(
+        LOADER_STATS_PATH,
+        data,
+        sizeof(LoaderStatsData),
+        LOADER_STATS_HEADER_MAGIC,
+        LOADER_STATS_HEADER_VERSION);
+    free(data);
+
+    if(!result) {
+        furi_check(osMutexAcquire(stats->mutex, osWaitForever) == osOK);
+        stats->dirty = true;
+        furi_check(osMutexRelease(stats->mutex) == osOK);
+    }
+
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "loader.h"
+
+#define LOADER_STATS_PATH "/int/loader.stats"
+#define LOADER_STATS_COUNT 32
+
+typedef struct LoaderStats LoaderStats;
+
+/** Allocate stats and load them from internal storage
+ *
+ * Stats saved by other firmware build are dropped.
+ */
+LoaderStats* loader_stats_alloc();
+
+void loader_stats_free(LoaderStats* stats);
+
+/** Account application run
+ *
+ * Record is created on first run. When table is full, record with least runs
+ * gives its slot.
+ *
+ * @param run - run telemetry, runs and run_time_total fields are ignored
+ *
+ * @return true if record was created or its stack or heap peak grew
+ */
+bool loader_stats_add_run(LoaderStats* stats, const LoaderAppStats* run);
+
+bool loader_stats_get(LoaderStats* stats, size_t index, LoaderAppStats* record);
+
+void loader_stats_reset(LoaderStats* stats);
+
+/** Save stats to internal storage if they changed since last save
+ *
+ * Table is not locked while writing. Call from one thread only.
+ */
+bool loader_stats_save(LoaderStats* stats);
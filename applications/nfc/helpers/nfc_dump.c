@@ -0,0 +1,562 @@
+#include "nfc_dump.h"
+
+#include <furi.h>
+#include <toolbox/crc32_calc.h>
+
+#define TAG "NfcDump"
+
+#define NFC_DUMP_MAGIC (0x4243464EUL) /* "NFCB" */
+#define NFC_DUMP_VERSION (2)
+/** Largest DESFire image with headroom, protects from allocating garbage size */
+#define NFC_DUMP_SIZE_MAX (32 * 1024)
+
+#define NFC_DUMP_MF_DF_HAS_FREE_MEMORY (1 << 0)
+#define NFC_DUMP_MF_DF_HAS_KEY_SETTINGS (1 << 1)
+#define NFC_DUMP_MF_DF_FILE_HAS_CONTENTS (1 << 0)
+
+typedef enum {
+    NfcDumpSectionCommon = 1,
+    NfcDumpSectionMfUl = 2,
+    NfcDumpSectionMfClassic = 3,
+    NfcDumpSectionEmv = 4,
+    NfcDumpSectionMfDf = 5,
+    NfcDumpSectionMfDfApp = 6,
+} NfcDumpSection;
+
+/** Fields are in target byte order, as saved_struct does */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t format;
+    uint16_t sections;
+    NfcDumpSource source;
+    /** Size of sections after header */
+    uint32_t size;
+    /** CRC32 of sections */
+    uint32_t crc;
+} NfcDumpHeader;
+
+/** Counts size and CRC of sections, writes only if stream is set */
+typedef struct {
+    Stream* stream;
+    uint32_t size;
+    uint32_t crc;
+    bool error;
+} NfcDumpWriter;
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool error;
+} NfcDumpReader;
+
+static void nfc_dump_put(NfcDumpWriter* writer, const void* data, size_t size) {
+    if(writer->error) return;
+    if(writer->stream) {
+        if(stream_write(writer->stream, data, size) != size) {
+            writer->error = true;
+            return;
+        }
+        writer->crc = crc32_calc_buffer(writer->crc, data, size);
+    }
+    writer->size += size;
+}
+
+static void nfc_dump_put_u8(NfcDumpWriter* writer, uint8_t value) {
+    nfc_dump_put(writer, &value, 1);
+}
+
+static void nfc_dump_put_u16(NfcDumpWriter* writer, uint16_t value) {
+    uint8_t data[2] = {value, value >> 8};
+    nfc_dump_put(writer, data, sizeof(data));
+}
+
+static void nfc_dump_put_u32(NfcDumpWriter* writer, uint32_t value) {
+    uint8_t data[4] = {value, value >> 8, value >> 16, value >> 24};
+    nfc_dump_put(writer, data, sizeof(data));
+}
+
+static const uint8_t* nfc_dump_get(NfcDumpReader* reader, size_t size) {
+    if(reader->error || reader->size - reader->pos < size) {
+        reader->error = true;
+        return NULL;
+    }
+    const uint8_t* data = &reader->data[reader->pos];
+    reader->pos += size;
+    return data;
+}
+
+static void nfc_dump_get_data(NfcDumpReader* reader, void* data, size_t size) {
+    const uint8_t* src = nfc_dump_get(reader, size);
+    if(src) memcpy(data, src, size);
+}
+
+static uint8_t nfc_dump_get_u8(NfcDumpReader* reader) {
+    const uint8_t* data = nfc_dump_get(reader, 1);
+    return data ? data[0] : 0;
+}
+
+static uint16_t nfc_dump_get_u16(NfcDumpReader* reader) {
+    const uint8_t* data = nfc_dump_get(reader, 2);
+    return data ? (data[0] | data[1] << 8) : 0;
+}
+
+static uint32_t nfc_dump_get_u32(NfcDumpReader* reader) {
+    const uint8_t* data = nfc_dump_get(reader, 4);
+    return data ? (data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24) : 0;
+}
+
+static void nfc_dump_put_common(NfcDumpWriter* writer, void* context) {
+    NfcDeviceData* data = context;
+    NfcDeviceCommonData* common = &data->nfc_data;
+    nfc_dump_put_u8(writer, common->uid_len);
+    nfc_dump_put(writer, common->uid, sizeof(common->uid));
+    nfc_dump_put(writer, common->atqa, sizeof(common->atqa));
+    nfc_dump_put_u8(writer, common->sak);
+    nfc_dump_put_u8(writer, common->device);
+    nfc_dump_put_u8(writer, common->protocol);
+}
+
+static bool nfc_dump_get_common(NfcDumpReader* reader, NfcDeviceData* data) {
+    NfcDeviceCommonData* common = &data->nfc_data;
+    common->uid_len = nfc_dump_get_u8(reader);
+    nfc_dump_get_data(reader, common->uid, sizeof(common->uid));
+    nfc_dump_get_data(reader, common->atqa, sizeof(common->atqa));
+    common->sak = nfc_dump_get_u8(reader);
+    common->device = nfc_dump_get_u8(reader);
+    common->protocol = nfc_dump_get_u8(reader);
+    return common->uid_len <= sizeof(common->uid);
+}
+
+static void nfc_dump_put_mf_ul(NfcDumpWriter* writer, void* context) {
+    NfcDeviceData* data = context;
+    MifareUlData* mf_ul = &data->mf_ul_data;
+    nfc_dump_put_u8(writer, mf_ul->type);
+    nfc_dump_put(writer, &mf_ul->version, sizeof(mf_ul->version));
+    nfc_dump_put(writer, mf_ul->signature, sizeof(mf_ul->signature));
+    for(size_t i = 0; i < COUNT_OF(mf_ul->counter); i++) {
+        nfc_dump_put_u32(writer, mf_ul->counter[i]);
+    }
+    nfc_dump_put(writer, mf_ul->tearing, sizeof(mf_ul->tearing));
+    nfc_dump_put_u16(writer, mf_ul->data_size);
+    nfc_dump_put(writer, mf_ul->data, mf_ul->data_size);
+}
+
+static bool nfc_dump_get_mf_ul(NfcDumpReader* reader, NfcDeviceData* data) {
+    MifareUlData* mf_ul = &data->mf_ul_data;
+    mf_ul->type = nfc_dump_get_u8(reader);
+    nfc_dump_get_data(reader, &mf_ul->version, sizeof(mf_ul->version));
+    nfc_dump_get_data(reader, mf_ul->signature, sizeof(mf_ul->signature));
+    for(size_t i = 0; i < COUNT_OF(mf_ul->counter); i++) {
+        mf_ul->counter[i] = nfc_dump_get_u32(reader);
+    }
+    nfc_dump_get_data(reader, mf_ul->tearing, sizeof(mf_ul->tearing));
+    mf_ul->data_size = nfc_dump_get_u16(reader);
+    if(mf_ul->data_size > sizeof(mf_ul->data)) return false;
+    nfc_dump_get_data(reader, mf_ul->data, mf_ul->data_size);
+    return mf_ul->type < MfUltralightTypeNum;
+}
+
+static uint16_t nfc_dump_mf_classic_blocks(MfClassicType type) {
+    if(type == MfClassicType1k) {
+        return 64;
+    } else if(type == MfClassicType4k) {
+        return 256;
+    }
+    return 0;
+}
+
+static void nfc_dump_put_mf_classic(NfcDumpWriter* writer, void* context) {
+    NfcDeviceData* data = context;
+    MfClassicData* mf_classic = &data->mf_classic_data;
+    uint16_t blocks = nfc_dump_mf_classic_blocks(mf_classic->type);
+    nfc_dump_put_u8(writer, mf_classic->type);
+    nfc_dump_put_u16(writer, blocks);
+    nfc_dump_put(writer, mf_classic->block, blocks * sizeof(MfClassicBlock));
+}
+
+static bool nfc_dump_get_mf_classic(NfcDumpReader* reader, NfcDeviceData* data) {
+    MfClassicData* mf_classic = &data->mf_classic_data;
+    mf_classic->type = nfc_dump_get_u8(reader);
+    uint16_t blocks = nfc_dump_get_u16(reader);
+    if(!blocks || blocks != nfc_dump_mf_classic_blocks(mf_classic->type)) return false;
+    nfc_dump_get_data(reader, mf_classic->block, blocks * sizeof(MfClassicBlock));
+    return true;
+}
+
+static void nfc_dump_put_emv(NfcDumpWriter* writer, void* context) {
+    NfcDeviceData* data = context;
+    NfcEmvData* emv = &data->emv_data;
+    nfc_dump_put(writer, emv->name, sizeof(emv->name));
+    nfc_dump_put_u8(writer, emv->aid_len);
+    nfc_dump_put(writer, emv->aid, emv->aid_len);
+    nfc_dump_put_u8(writer, emv->number_len);
+    nfc_dump_put(writer, emv->number, emv->number_len);
+    nfc_dump_put_u8(writer, emv->exp_mon);
+    nfc_dump_put_u8(writer, emv->exp_year);
+    nfc_dump_put_u16(writer, emv->country_code);
+    nfc_dump_put_u16(writer, emv->currency_code);
+}
+
+static bool nfc_dump_get_emv(NfcDumpReader* reader, NfcDeviceData* data) {
+    NfcEmvData* emv = &data->emv_data;
+    nfc_dump_get_data(reader, emv->name, sizeof(emv->name));
+    emv->name[sizeof(emv->name) - 1] = '\0';
+    emv->aid_len = nfc_dump_get_u8(reader);
+    if(emv->aid_len > sizeof(emv->aid)) return false;
+    nfc_dump_get_data(reader, emv->aid, emv->aid_len);
+    emv->number_len = nfc_dump_get_u8(reader);
+    if(emv->number_len > sizeof(emv->number)) return false;
+    nfc_dump_get_data(reader, emv->number, emv->number_len);
+    emv->exp_mon = nfc_dump_get_u8(reader);
+    emv->exp_year = nfc_dump_get_u8(reader);
+    emv->country_code = nfc_dump_get_u16(reader);
+    emv->currency_code = nfc_dump_get_u16(reader);
+    return true;
+}
+
+static void nfc_dump_put_mf_df_key_settings(NfcDumpWriter* writer, MifareDesfireKeySettings* ks) {
+    uint8_t key_versions = 0;
+    for(MifareDesfireKeyVersion* kv = ks->key_version_head; kv; kv = kv->next) {
+        key_versions++;
+    }
+    nfc_dump_put_u8(writer, ks->change_key_id);
+    nfc_dump_put_u8(
+        writer,
+        ks->config_changeable | ks->free_create_delete << 1 | ks->free_directory_list << 2 |
+            ks->master_key_changeable << 3);
+    nfc_dump_put_u8(writer, ks->max_keys);
+    nfc_dump_put_u8(writer, key_versions);
+    for(MifareDesfireKeyVersion* kv = ks->key_version_head; kv; kv = kv->next) {
+        nfc_dump_put_u8(writer, kv->id);
+        nfc_dump_put_u8(writer, kv->version);
+    }
+}
+
+static MifareDesfireKeySettings* nfc_dump_get_mf_df_key_settings(NfcDumpReader* reader) {
+    MifareDesfireKeySettings* ks = malloc(sizeof(MifareDesfireKeySettings));
+    memset(ks, 0, sizeof(MifareDesfireKeySettings));
+    ks->change_key_id = nfc_dump_get_u8(reader);
+    uint8_t flags = nfc_dump_get_u8(reader);
+    ks->config_changeable = flags & (1 << 0);
+    ks->free_create_delete = flags & (1 << 1);
+    ks->free_directory_list = flags & (1 << 2);
+    ks->master_key_changeable = flags & (1 << 3);
+    ks->max_keys = nfc_dump_get_u8(reader);
+    uint8_t key_versions = nfc_dump_get_u8(reader);
+    // List is kept even on error, so it is freed together with settings
+    MifareDesfireKeyVersion** kv_head = &ks->key_version_head;
+    for(uint8_t i = 0; i < key_versions && !reader->error; i++) {
+        MifareDesfireKeyVersion* kv = malloc(sizeof(MifareDesfireKeyVersion));
+        memset(kv, 0, sizeof(MifareDesfireKeyVersion));
+        kv->id = nfc_dump_get_u8(reader);
+        kv->version = nfc_dump_get_u8(reader);
+        *kv_head = kv;
+        kv_head = &kv->next;
+    }
+    return ks;
+}
+
+/** Same size as text format saves */
+static uint32_t nfc_dump_mf_df_contents_size(MifareDesfireFile* f) {
+    if(f->type == MifareDesfireFileTypeStandard || f->type == MifareDesfireFileTypeBackup) {
+        return f->settings.data.size;
+    } else if(f->type == MifareDesfireFileTypeValue) {
+        return 4;
+    } else if(
+        f->type == MifareDesfireFileTypeLinearRecord ||
+        f->type == MifareDesfireFileTypeCyclicRecord) {
+        return f->settings.record.size * f->settings.record.cur;
+    }
+    return 0;
+}
+
+static void nfc_dump_put_mf_df(NfcDumpWriter* writer, void* context) {
+    NfcDeviceData* data = context;
+    MifareDesfireData* mf_df = &data->mf_df_data;
+    uint8_t flags = 0;
+    if(mf_df->free_memory) flags |= NFC_DUMP_MF_DF_HAS_FREE_MEMORY;
+    if(mf_df->master_key_settings) flags |= NFC_DUMP_MF_DF_HAS_KEY_SETTINGS;
+    nfc_dump_put(writer, &mf_df->version, sizeof(mf_df->version));
+    nfc_dump_put_u8(writer, flags);
+    if(mf_df->free_memory) {
+        nfc_dump_put_u32(writer, mf_df->free_memory->bytes);
+    }
+    if(mf_df->master_key_settings) {
+        nfc_dump_put_mf_df_key_settings(writer, mf_df->master_key_settings);
+    }
+}
+
+static bool nfc_dump_get_mf_df(NfcDumpReader* reader, NfcDeviceData* data) {
+    MifareDesfireData* mf_df = &data->mf_df_data;
+    nfc_dump_get_data(reader, &mf_df->version, sizeof(mf_df->version));
+    uint8_t flags = nfc_dump_get_u8(reader);
+    if(flags & NFC_DUMP_MF_DF_HAS_FREE_MEMORY) {
+        mf_df->free_memory = malloc(sizeof(MifareDesfireFreeMemory));
+        mf_df->free_memory->bytes = nfc_dump_get_u32(reader);
+    }
+    if(flags & NFC_DUMP_MF_DF_HAS_KEY_SETTINGS) {
+        mf_df->master_key_settings = nfc_dump_get_mf_df_key_settings(reader);
+    }
+    return true;
+}
+
+static void nfc_dump_put_mf_df_app(NfcDumpWriter* writer, void* context) {
+    MifareDesfireApplication* app = context;
+    uint8_t files = 0;
+    for(MifareDesfireFile* f = app->file_head; f; f = f->next) {
+        files++;
+    }
+    nfc_dump_put(writer, app->id, sizeof(app->id));
+    nfc_dump_put_u8(writer, app->key_settings ? NFC_DUMP_MF_DF_HAS_KEY_SETTINGS : 0);
+    if(app->key_settings) {
+        nfc_dump_put_mf_df_key_settings(writer, app->key_settings);
+    }
+    nfc_dump_put_u8(writer, files);
+    for(MifareDesfireFile* f = app->file_head; f; f = f->next) {
+        nfc_dump_put_u8(writer, f->id);
+        nfc_dump_put_u8(writer, f->type);
+        nfc_dump_put_u8(writer, f->comm);
+        nfc_dump_put_u16(writer, f->access_rights);
+        if(f->type == MifareDesfireFileTypeValue) {
+            nfc_dump_put_u32(writer, f->settings.value.lo_limit);
+            nfc_dump_put_u32(writer, f->settings.value.hi_limit);
+            nfc_dump_put_u32(writer, f->settings.value.limited_credit_value);
+            nfc_dump_put_u8(writer, f->settings.value.limited_credit_enabled);
+        } else {
+            // Data size overlaps record size
+            nfc_dump_put_u32(writer, f->settings.record.size);
+            nfc_dump_put_u32(writer, f->settings.record.max);
+            nfc_dump_put_u32(writer, f->settings.record.cur);
+        }
+        uint32_t size = f->contents ? nfc_dump_mf_df_contents_size(f) : 0;
+        nfc_dump_put_u8(writer, f->contents ? NFC_DUMP_MF_DF_FILE_HAS_CONTENTS : 0);
+        nfc_dump_put_u32(writer, size);
+        if(f->contents) {
+            nfc_dump_put(writer, f->contents, size);
+        }
+    }
+}
+
+static bool nfc_dump_get_mf_df_app(NfcDumpReader* reader, NfcDeviceData* data) {
+    MifareDesfireApplication** app_head = &data->mf_df_data.app_head;
+    while(*app_head) {
+        app_head = &(*app_head)->next;
+    }
+    // Linked before parsing, so everything allocated is freed on error
+    MifareDesfireApplication* app = malloc(sizeof(MifareDesfireApplication));
+    memset(app, 0, sizeof(MifareDesfireApplication));
+    *app_head = app;
+
+    nfc_dump_get_data(reader, app->id, sizeof(app->id));
+    if(nfc_dump_get_u8(reader) & NFC_DUMP_MF_DF_HAS_KEY_SETTINGS) {
+        app->key_settings = nfc_dump_get_mf_df_key_settings(reader);
+    }
+    uint8_t files = nfc_dump_get_u8(reader);
+    MifareDesfireFile** file_head = &app->file_head;
+    for(uint8_t i = 0; i < files && !reader->error; i++) {
+        MifareDesfireFile* f = malloc(sizeof(MifareDesfireFile));
+        memset(f, 0, sizeof(MifareDesfireFile));
+        *file_head = f;
+        file_head = &f->next;
+
+        f->id = nfc_dump_get_u8(reader);
+        f->type = nfc_dump_get_u8(reader);
+        f->comm = nfc_dump_get_u8(reader);
+        f->access_rights = nfc_dump_get_u16(reader);
+        if(f->type == MifareDesfireFileTypeValue) {
+            f->settings.value.lo_limit = nfc_dump_get_u32(reader);
+            f->settings.value.hi_limit = nfc_dump_get_u32(reader);
+            f->settings.value.limited_credit_value = nfc_dump_get_u32(reader);
+            f->settings.value.limited_credit_enabled = nfc_dump_get_u8(reader);
+        } else {
+            f->settings.record.size = nfc_dump_get_u32(reader);
+            f->settings.record.max = nfc_dump_get_u32(reader);
+            f->settings.record.cur = nfc_dump_get_u32(reader);
+        }
+        bool has_contents = nfc_dump_get_u8(reader) & NFC_DUMP_MF_DF_FILE_HAS_CONTENTS;
+        uint32_t size = nfc_dump_get_u32(reader);
+        const uint8_t* contents = nfc_dump_get(reader, size);
+        if(has_contents && contents) {
+            // Text loader allocates at least one byte too
+            f->contents = malloc(size ? size : 1);
+            memcpy(f->contents, contents, size);
+        }
+    }
+    return true;
+}
+
+typedef void (*NfcDumpPutSection)(NfcDumpWriter* writer, void* context);
+
+/** Size goes first, so section is serialized twice: to count size and to write */
+static void nfc_dump_put_section(
+    NfcDumpWriter* writer,
+    NfcDumpSection type,
+    NfcDumpPutSection put,
+    void* context) {
+    NfcDumpWriter counter = {.stream = NULL};
+    put(&counter, context);
+    nfc_dump_put_u8(writer, type);
+    nfc_dump_put_u32(writer, counter.size);
+    put(writer, context);
+}
+
+static uint16_t nfc_dump_put_sections(
+    NfcDumpWriter* writer,
+    NfcDeviceSaveFormat format,
+    NfcDeviceData* data) {
+    uint16_t sections = 1;
+    nfc_dump_put_section(writer, NfcDumpSectionCommon, nfc_dump_put_common, data);
+    if(format == NfcDeviceSaveFormatMifareUl) {
+        nfc_dump_put_section(writer, NfcDumpSectionMfUl, nfc_dump_put_mf_ul, data);
+        sections++;
+    } else if(format == NfcDeviceSaveFormatMifareClassic) {
+        nfc_dump_put_section(writer, NfcDumpSectionMfClassic, nfc_dump_put_mf_classic, data);
+        sections++;
+    } else if(format == NfcDeviceSaveFormatBankCard) {
+        nfc_dump_put_section(writer, NfcDumpSectionEmv, nfc_dump_put_emv, data);
+        sections++;
+    } else if(format == NfcDeviceSaveFormatMifareDesfire) {
+        nfc_dump_put_section(writer, NfcDumpSectionMfDf, nfc_dump_put_mf_df, data);
+        sections++;
+        for(MifareDesfireApplication* app = data->mf_df_data.app_head; app; app = app->next) {
+            nfc_dump_put_section(writer, NfcDumpSectionMfDfApp, nfc_dump_put_mf_df_app, app);
+            sections++;
+        }
+    }
+    return sections;
+}
+
+bool nfc_dump_save(
+    Stream* stream,
+    NfcDeviceSaveFormat format,
+    NfcDeviceData* data,
+    const NfcDumpSource* source) {
+    furi_assert(stream);
+    furi_assert(data);
+
+    NfcDumpHeader header = {
+        .magic = NFC_DUMP_MAGIC,
+        .version = NFC_DUMP_VERSION,
+        .format = format,
+    };
+    if(source) {
+        header.source = *source;
+    }
+    size_t header_pos = stream_tell(stream);
+    // Header is written again when size and CRC are known
+    if(stream_write(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) return false;
+
+    NfcDumpWriter writer = {.stream = stream, .crc = CRC32_CALC_INIT};
+    header.sections = nfc_dump_put_sections(&writer, format, data);
+    if(writer.error) return false;
+    header.size = writer.size;
+    header.crc = writer.crc;
+
+    bool saved = false;
+    do {
+        if(!stream_seek(stream, header_pos, StreamOffsetFromStart)) break;
+        if(stream_write(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(!stream_seek(stream, header.size, StreamOffsetFromCurrent)) break;
+        saved = true;
+    } while(false);
+
+    return saved;
+}
+
+static bool nfc_dump_get_sections(
+    NfcDumpReader* reader,
+    NfcDeviceSaveFormat format,
+    uint16_t sections,
+    NfcDeviceData* data) {
+    bool common_loaded = false;
+    bool format_loaded = (format == NfcDeviceSaveFormatUid);
+
+    for(uint16_t i = 0; i < sections; i++) {
+        uint8_t type = nfc_dump_get_u8(reader);
+        uint32_t size = nfc_dump_get_u32(reader);
+        const uint8_t* section_data = nfc_dump_get(reader, size);
+        if(!section_data) return false;
+
+        NfcDumpReader section = {.data = section_data, .size = size};
+        bool loaded = true;
+        if(type == NfcDumpSectionCommon) {
+            loaded = nfc_dump_get_common(&section, data);
+            common_loaded = true;
+        } else if(type == NfcDumpSectionMfUl && format == NfcDeviceSaveFormatMifareUl) {
+            loaded = nfc_dump_get_mf_ul(&section, data);
+            format_loaded = true;
+        } else if(
+            type == NfcDumpSectionMfClassic && format == NfcDeviceSaveFormatMifareClassic) {
+            loaded = nfc_dump_get_mf_classic(&section, data);
+            format_loaded = true;
+        } else if(type == NfcDumpSectionEmv && format == NfcDeviceSaveFormatBankCard) {
+            loaded = nfc_dump_get_emv(&section, data);
+            format_loaded = true;
+        } else if(type == NfcDumpSectionMfDf && format == NfcDeviceSaveFormatMifareDesfire) {
+            loaded = nfc_dump_get_mf_df(&section, data);
+            format_loaded = true;
+        } else if(type == NfcDumpSectionMfDfApp && format == NfcDeviceSaveFormatMifareDesfire) {
+            loaded = nfc_dump_get_mf_df_app(&section, data);
+        }
+        // Sections of newer versions are skipped, fields appended to known ones are ignored
+        if(!loaded || section.error) return false;
+    }
+
+    return common_loaded && format_loaded;
+}
+
+bool nfc_dump_load(
+    Stream* stream,
+    NfcDeviceSaveFormat* format,
+    NfcDeviceData* data,
+    const NfcDumpSource* source) {
+    furi_assert(stream);
+    furi_assert(format);
+    furi_assert(data);
+
+    bool loaded = false;
+    NfcDumpHeader header = {0};
+    uint8_t* buffer = NULL;
+    memset(data, 0, sizeof(NfcDeviceData));
+
+    do {
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != NFC_DUMP_MAGIC || header.version != NFC_DUMP_VERSION) {
+            FURI_LOG_W(TAG, "Unknown dump version");
+            break;
+        }
+        if(source && memcmp(&header.source, source, sizeof(NfcDumpSource))) {
+            FURI_LOG_D(TAG, "Source file changed");
+            break;
+        }
+        if(header.size > NFC_DUMP_SIZE_MAX || header.format > NfcDeviceSaveFormatMifareDesfire) {
+            FURI_LOG_W(TAG, "Broken header");
+            break;
+        }
+        // Whole payload in one read: SD card is fast on large blocks only
+        buffer = malloc(header.size);
+        if(stream_read(stream, buffer, header.size) != header.size) break;
+        if(crc32_calc_buffer(CRC32_CALC_INIT, buffer, header.size) != header.crc) {
+            FURI_LOG_W(TAG, "CRC mismatch");
+            break;
+        }
+        NfcDumpReader reader = {.data = buffer, .size = header.size};
+        if(!nfc_dump_get_sections(&reader, header.format, header.sections, data)) {
+            FURI_LOG_W(TAG, "Broken sections");
+            break;
+        }
+        *format = header.format;
+        loaded = true;
+    } while(false);
+
+    if(!loaded) {
+        if(header.format == NfcDeviceSaveFormatMifareDesfire) {
+            mf_df_clear(&data->mf_df_data);
+        }
+        memset(data, 0, sizeof(NfcDeviceData));
+    }
+    free(buffer);
+    return loaded;
+}
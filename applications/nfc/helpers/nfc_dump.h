@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <toolbox/stream/stream.h>
+
+#include "../nfc_device.h"
+
+/** Binary NFC dump
+ *
+ * Same data as text .nfc file, stored as header, typed sections and CRC32, so loading
+ * is one read of the whole payload instead of parsing a hex line per block.
+ * Header keeps size and modification time of the text file the dump was made from: dump
+ * is a cache of that file and is rejected when the file changes.
+ */
+
+/** Text file the dump is made from */
+typedef struct {
+    uint32_t size;
+    /** FAT date and time, see FileInfo */
+    uint32_t mtime;
+} NfcDumpSource;
+
+/** Write dump
+ *
+ * @param stream destination, written from current position
+ * @param format save format of data
+ * @param data device data
+ * @param source text file with the same data or NULL
+ * @return true if all data is written
+ */
+bool nfc_dump_save(
+    Stream* stream,
+    NfcDeviceSaveFormat format,
+    NfcDeviceData* data,
+    const NfcDumpSource* source);
+
+/** Read dump
+ *
+ * Data is cleared on failure, DESFire lists are allocated on success
+ *
+ * @param stream source, read from current position
+ * @param format save format of data, output
+ * @param data device data, output
+ * @param source expected text file, NULL to skip the check
+ * @return true if dump is valid, matches source and data is loaded
+ */
+bool nfc_dump_load(
+    Stream* stream,
+    NfcDeviceSaveFormat* format,
+    NfcDeviceData* data,
+    const NfcDumpSource* source);
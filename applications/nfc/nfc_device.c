@@ -1,9 +1,13 @@
 #include "nfc_device.h"
 #include "nfc_types.h"
+#include "helpers/nfc_dump.h"
 
 #include <toolbox/path.h>
+#include <toolbox/stream/file_stream.h>
 #include <flipper_format/flipper_format.h>
 
+#define TAG "NfcDevice"
+
 static const char* nfc_file_header = "Flipper NFC device";
 static const uint32_t nfc_file_version = 2;
 
@@ -685,6 +689,60 @@ static bool nfc_device_load_mifare_classic_data(FlipperFormat* file, NfcDevice*
     return parsed;
 }
 
+/** Size and modification time of text file, false if filesystem keeps no time */
+static bool nfc_device_file_source(NfcDevice* dev, string_t path, NfcDumpSource* source) {
+    FileInfo info;
+    if(storage_common_stat(dev->storage, string_get_cstr(path), &info) != FSE_OK) return false;
+    source->size = info.size;
+    source->mtime = info.mtime;
+    return info.mtime != 0;
+}
+
+/** Path with NFC_APP_EXTENSION at its end replaced by extension */
+static void nfc_device_replace_extension(string_t path, const char* extension, string_t result) {
+    size_t name_length = string_size(path);
+    if(string_end_with_str_p(path, NFC_APP_EXTENSION)) {
+        name_length -= strlen(NFC_APP_EXTENSION);
+    }
+    string_set_n(result, path, 0, name_length);
+    string_cat_printf(result, "%s", extension);
+}
+
+/** Binary copy of text file at path, bound to its size and time. Text file stays the original */
+static void nfc_device_save_dump(NfcDevice* dev, string_t path, const NfcDumpSource* source) {
+    string_t dump_path;
+    string_init(dump_path);
+    nfc_device_replace_extension(path, NFC_APP_DUMP_EXTENSION, dump_path);
+    Stream* stream = file_stream_alloc(dev->storage);
+
+    bool saved =
+        file_stream_open(stream, string_get_cstr(dump_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+        nfc_dump_save(stream, dev->format, &dev->dev_data, source);
+    file_stream_close(stream);
+    if(!saved) {
+        FURI_LOG_W(TAG, "Can't save dump %s", string_get_cstr(dump_path));
+        storage_simply_remove(dev->storage, string_get_cstr(dump_path));
+    }
+
+    stream_free(stream);
+    string_clear(dump_path);
+}
+
+static bool nfc_device_load_dump(NfcDevice* dev, string_t path, const NfcDumpSource* source) {
+    string_t dump_path;
+    string_init(dump_path);
+    nfc_device_replace_extension(path, NFC_APP_DUMP_EXTENSION, dump_path);
+    Stream* stream = file_stream_alloc(dev->storage);
+
+    bool loaded =
+        file_stream_open(stream, string_get_cstr(dump_path), FSAM_READ, FSOM_OPEN_EXISTING) &&
+        nfc_dump_load(stream, &dev->format, &dev->dev_data, source);
+
+    stream_free(stream);
+    string_clear(dump_path);
+    return loaded;
+}
+
 void nfc_device_set_name(NfcDevice* dev, const char* name) {
     furi_assert(dev);
 
@@ -701,16 +759,17 @@ static bool nfc_device_save_file(
     bool saved = false;
     FlipperFormat* file = flipper_format_file_alloc(dev->storage);
     NfcDeviceCommonData* data = &dev->dev_data.nfc_data;
-    string_t temp_str;
+    string_t temp_str, path;
     string_init(temp_str);
+    string_init(path);
 
     do {
         // Create nfc directory if necessary
         if(!storage_simply_mkdir(dev->storage, NFC_APP_FOLDER)) break;
         // First remove nfc device file if it was saved
-        string_printf(temp_str, "%s/%s%s", folder, dev_name, extension);
+        string_printf(path, "%s/%s%s", folder, dev_name, extension);
         // Open file
-        if(!flipper_format_file_open_always(file, string_get_cstr(temp_str))) break;
+        if(!flipper_format_file_open_always(file, string_get_cstr(path))) break;
         // Write header
         if(!flipper_format_write_header_cstr(file, nfc_file_header, nfc_file_version)) break;
         // Write nfc device type
@@ -741,8 +800,15 @@ static bool nfc_device_save_file(
     if(!saved) {
         dialog_message_show_storage_error(dev->dialogs, "Can not save\nkey file");
     }
-    string_clear(temp_str);
     flipper_format_free(file);
+    // Shadow file is rewritten on every emulated write, only original gets a dump
+    NfcDumpSource source;
+    if(saved && !strcmp(extension, NFC_APP_EXTENSION) &&
+       nfc_device_file_source(dev, path, &source)) {
+        nfc_device_save_dump(dev, path, &source);
+    }
+    string_clear(temp_str);
+    string_clear(path);
     return saved;
 }
 
@@ -758,19 +824,26 @@ bool nfc_device_save_shadow(NfcDevice* dev, const char* dev_name) {
 static bool nfc_device_load_data(NfcDevice* dev, string_t path) {
     bool parsed = false;
     FlipperFormat* file = flipper_format_file_alloc(dev->storage);
+    // Desfire loader probes optional keys from the file start
+    flipper_format_set_index_mode(file, true);
     NfcDeviceCommonData* data = &dev->dev_data.nfc_data;
     uint32_t data_cnt = 0;
     string_t temp_str;
     string_init(temp_str);
     bool depricated_version = false;
+    NfcDumpSource source;
 
     do {
         // Check existance of shadow file
-        size_t ext_start = string_search_str(path, NFC_APP_EXTENSION);
-        string_set_n(temp_str, path, 0, ext_start);
-        string_cat_printf(temp_str, "%s", NFC_APP_SHADOW_EXTENSION);
+        nfc_device_replace_extension(path, NFC_APP_SHADOW_EXTENSION, temp_str);
         dev->shadow_file_exist =
             storage_common_stat(dev->storage, string_get_cstr(temp_str), NULL) == FSE_OK;
+        // Binary dump of original file is a few block reads instead of a line per block
+        if(!dev->shadow_file_exist && nfc_device_file_source(dev, path, &source) &&
+           nfc_device_load_dump(dev, path, &source)) {
+            parsed = true;
+            break;
+        }
         // Open shadow file if it exists. If not - open original
         if(dev->shadow_file_exist) {
             if(!flipper_format_file_open_existing(file, string_get_cstr(temp_str))) break;
@@ -887,6 +960,10 @@ bool nfc_device_delete(NfcDevice* dev) {
         // Delete original file
         string_init_printf(file_path, "%s/%s%s", NFC_APP_FOLDER, dev->dev_name, NFC_APP_EXTENSION);
         if(!storage_simply_remove(dev->storage, string_get_cstr(file_path))) break;
+        // Delete binary dump, it is a copy of original file
+        string_printf(
+            file_path, "%s/%s%s", NFC_APP_FOLDER, dev->dev_name, NFC_APP_DUMP_EXTENSION);
+        if(!storage_simply_remove(dev->storage, string_get_cstr(file_path))) break;
         // Delete shadow file if it exists
         if(dev->shadow_file_exist) {
             string_printf(
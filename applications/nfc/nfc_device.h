@@ -16,6 +16,8 @@
 #define NFC_APP_FOLDER "/any/nfc"
 #define NFC_APP_EXTENSION ".nfc"
 #define NFC_APP_SHADOW_EXTENSION ".shd"
+/** Binary copy of .nfc file, see helpers/nfc_dump.h */
+#define NFC_APP_DUMP_EXTENSION ".nfb"
 
 typedef enum {
     NfcDeviceNfca,
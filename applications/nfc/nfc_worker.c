@@ -682,6 +682,7 @@ void nfc_worker_emulate_mifare_ul(NfcWorker* nfc_worker) {
             mf_ul_emulate.data_changed = false;
         }
     }
+    mf_ul_free_emulation(&mf_ul_emulate);
 }
 
 void nfc_worker_mifare_classic_dict_attack(NfcWorker* nfc_worker) {
@@ -745,8 +746,13 @@ void nfc_worker_mifare_classic_dict_attack(NfcWorker* nfc_worker) {
             mf_classic_auth_init_context(&auth_ctx, reader.cuid, curr_sector);
             bool sector_key_found = false;
             while(nfc_mf_classic_dict_get_next_key(nfc_worker->dict_stream, &curr_key)) {
-                furi_hal_nfc_deactivate();
-                if(furi_hal_nfc_activate_nfca(300, &reader.cuid)) {
+                // Card stays authenticated after successful attempt, next one goes nested
+                bool card_present = auth_ctx.authenticated;
+                if(!card_present) {
+                    furi_hal_nfc_deactivate();
+                    card_present = furi_hal_nfc_activate_nfca(300, &reader.cuid);
+                }
+                if(card_present) {
                     if(!card_found_notified) {
                         if(reader.type == MfClassicType1k) {
                             event = NfcWorkerEventDetectedClassic1k;
@@ -814,8 +820,24 @@ void nfc_worker_mifare_classic_dict_attack(NfcWorker* nfc_worker) {
 
     if(nfc_worker->state == NfcWorkerStateReadMifareClassic) {
         FURI_LOG_I(TAG, "Found keys to %d sectors. Start reading sectors", reader.sectors_to_read);
+        uint32_t start = osKernelGetTickCount();
         uint8_t sectors_read =
             mf_classic_read_card(&tx_rx_ctx, &reader, &nfc_worker->dev_data->mf_classic_data);
+        FURI_LOG_I(
+            TAG,
+            "Read took %lu ms, %d card selections",
+            osKernelGetTickCount() - start,
+            reader.selections);
+        for(uint8_t i = 0; i < reader.sectors_to_read; i++) {
+            MfClassicSectorReader* sector_reader = &reader.sector_reader[i];
+            FURI_LOG_D(
+                TAG,
+                "Sector %d: %lu ms, %d selections, blocks read %04X",
+                sector_reader->sector_num,
+                sector_reader->read_time,
+                sector_reader->selections,
+                sector_reader->blocks_read);
+        }
         if(sectors_read) {
             dev = &dev_list[0];
             nfc_common = &nfc_worker->dev_data->nfc_data;
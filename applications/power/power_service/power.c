@@ -6,6 +6,8 @@
 #include <gui/view_port.h>
 #include <gui/view.h>
 
+#define TAG "Power"
+
 #define POWER_OFF_TIMEOUT 90
 
 void power_draw_battery_callback(Canvas* canvas, void* context) {
@@ -31,8 +33,15 @@ static ViewPort* power_battery_view_port_alloc(Power* power) {
     return battery_view_port;
 }
 
+static void power_hal_event_callback(void* context) {
+    furi_assert(context);
+    Power* power = context;
+    osThreadFlagsSet(power->thread, POWER_THREAD_FLAG_UPDATE);
+}
+
 Power* power_alloc() {
     Power* power = malloc(sizeof(Power));
+    power->thread = osThreadGetId();
 
     // Records
     power->notification = furi_record_open("notification");
@@ -44,8 +53,8 @@ Power* power_alloc() {
     // State initialization
     power->state = PowerStateNotCharging;
     power->battery_low = false;
-    power->power_off_timeout = POWER_OFF_TIMEOUT;
     power->api_mtx = osMutexNew(NULL);
+    power_poll_reset(&power->poll);
 
     // Gui
     power->view_dispatcher = view_dispatcher_alloc();
@@ -63,12 +72,17 @@ Power* power_alloc() {
     power->battery_view_port = power_battery_view_port_alloc(power);
     power->show_low_bat_level_message = true;
 
+    // Charging and OTG switches made by other apps
+    furi_hal_power_set_event_callback(power_hal_event_callback, power);
+
     return power;
 }
 
 void power_free(Power* power) {
     furi_assert(power);
 
+    furi_hal_power_set_event_callback(NULL, NULL);
+
     // Gui
     view_dispatcher_remove_view(power->view_dispatcher, PowerViewOff);
     power_off_free(power->power_off);
@@ -89,8 +103,9 @@ void power_free(Power* power) {
     free(power);
 }
 
-static void power_check_charging_state(Power* power) {
-    if(furi_hal_power_is_charging()) {
+static bool power_check_charging_state(Power* power, bool is_charging) {
+    PowerState state = power->state;
+    if(is_charging) {
         if(power->info.charge == 100) {
             if(power->state != PowerStateCharged) {
                 notification_internal_message(power->notification, &sequence_charged);
@@ -114,29 +129,35 @@ static void power_check_charging_state(Power* power) {
             furi_pubsub_publish(power->event_pubsub, &power->event);
         }
     }
+    return power->state != state;
 }
 
-static bool power_update_info(Power* power) {
-    PowerInfo info;
-
-    info.charge = furi_hal_power_get_pct();
-    info.health = furi_hal_power_get_bat_health_pct();
-    info.capacity_remaining = furi_hal_power_get_battery_remaining_capacity();
-    info.capacity_full = furi_hal_power_get_battery_full_capacity();
-    info.current_charger = furi_hal_power_get_battery_current(FuriHalPowerICCharger);
-    info.current_gauge = furi_hal_power_get_battery_current(FuriHalPowerICFuelGauge);
-    info.voltage_charger = furi_hal_power_get_battery_voltage(FuriHalPowerICCharger);
-    info.voltage_gauge = furi_hal_power_get_battery_voltage(FuriHalPowerICFuelGauge);
-    info.voltage_vbus = furi_hal_power_get_usb_voltage();
-    info.temperature_charger = furi_hal_power_get_battery_temperature(FuriHalPowerICCharger);
-    info.temperature_gauge = furi_hal_power_get_battery_temperature(FuriHalPowerICFuelGauge);
+static bool power_update_info(Power* power, FuriHalPowerReadout* readout) {
+    if(!furi_hal_power_read(readout)) {
+        FURI_LOG_E(TAG, "Failed to read charger and gauge");
+        return false;
+    }
+
+    PowerInfo info = {
+        .current_charger = readout->current_charger,
+        .current_gauge = readout->current_gauge,
+        .voltage_charger = readout->voltage_charger,
+        .voltage_gauge = readout->voltage_gauge,
+        .voltage_vbus = readout->voltage_vbus,
+        .capacity_remaining = readout->capacity_remaining,
+        .capacity_full = readout->capacity_full,
+        .temperature_charger = readout->temperature_charger,
+        .temperature_gauge = readout->temperature_gauge,
+        .charge = readout->charge,
+        .health = readout->health,
+    };
 
     osMutexAcquire(power->api_mtx, osWaitForever);
-    bool need_refresh = power->info.charge != info.charge;
     power->info = info;
+    power->info_tick = osKernelGetTickCount();
     osMutexRelease(power->api_mtx);
 
-    return need_refresh;
+    return true;
 }
 
 static void power_check_low_battery(Power* power) {
@@ -146,62 +167,84 @@ static void power_check_low_battery(Power* power) {
         if(!power->battery_low) {
             view_dispatcher_send_to_front(power->view_dispatcher);
             view_dispatcher_switch_to_view(power->view_dispatcher, PowerViewOff);
+            power->battery_low_tick = osKernelGetTickCount();
         }
         power->battery_low = true;
     } else {
         if(power->battery_low) {
             view_dispatcher_switch_to_view(power->view_dispatcher, VIEW_NONE);
-            power->power_off_timeout = POWER_OFF_TIMEOUT;
         }
         power->battery_low = false;
     }
     // If battery low, update view and switch off power after timeout
+    // Wake ups are not periodic, count time by ticks
     if(power->battery_low) {
-        if(power->power_off_timeout) {
-            power_off_set_time_left(power->power_off, power->power_off_timeout--);
+        uint32_t elapsed =
+            (osKernelGetTickCount() - power->battery_low_tick) / osKernelGetTickFreq();
+        if(elapsed < POWER_OFF_TIMEOUT) {
+            power_off_set_time_left(power->power_off, POWER_OFF_TIMEOUT - elapsed);
         } else {
             power_off(power);
         }
     }
 }
 
-static void power_check_battery_level_change(Power* power) {
+static bool power_check_battery_level_change(Power* power) {
     if(power->battery_level != power->info.charge) {
         power->battery_level = power->info.charge;
         power->event.type = PowerEventTypeBatteryLevelChanged;
         power->event.data.battery_level = power->battery_level;
         furi_pubsub_publish(power->event_pubsub, &power->event);
+        return true;
     }
+    return false;
+}
+
+static bool power_is_info_watched(Power* power) {
+    osMutexAcquire(power->api_mtx, osWaitForever);
+    bool watched = osKernelGetTickCount() - power->info_read_tick < POWER_POLL_INTERVAL_IDLE;
+    osMutexRelease(power->api_mtx);
+    return watched;
 }
 
 int32_t power_srv(void* p) {
     (void)p;
     Power* power = power_alloc();
-    power_update_info(power);
+    FuriHalPowerReadout readout;
+    power_update_info(power, &readout);
     furi_record_create("power", power);
 
+    uint32_t timeout = 0;
     while(1) {
+        // Sleep till next poll, HAL events and info readers cut it short
+        osThreadFlagsWait(POWER_THREAD_FLAG_UPDATE, osFlagsWaitAny, timeout);
+
         // Update data from gauge and charger
-        bool need_refresh = power_update_info(power);
+        if(!power_update_info(power, &readout)) {
+            timeout = POWER_POLL_INTERVAL_ACTIVE;
+            continue;
+        }
 
         // Check low battery level
         power_check_low_battery(power);
 
         // Check and notify about charging state
-        power_check_charging_state(power);
+        bool need_refresh = power_check_charging_state(power, readout.is_charging);
 
         // Check and notify about battery level change
-        power_check_battery_level_change(power);
+        need_refresh |= power_check_battery_level_change(power);
 
         // Update battery view port
         if(need_refresh) view_port_update(power->battery_view_port);
 
-        // Check OTG status and disable it in case of fault
-        if(furi_hal_power_is_otg_enabled()) {
-            furi_hal_power_check_otg_status();
+        // Disable OTG in case of fault
+        if(readout.is_otg_enabled && readout.is_otg_fault) {
+            furi_hal_power_disable_otg();
         }
 
-        osDelay(1000);
+        bool active = readout.is_charging || readout.is_otg_enabled || power->battery_low ||
+                      power_is_info_watched(power);
+        timeout = power_poll_next(&power->poll, &power->info, active);
     }
 
     power_free(power);
@@ -28,7 +28,15 @@ void power_get_info(Power* power, PowerInfo* info) {
 
     osMutexAcquire(power->api_mtx, osWaitForever);
     memcpy(info, &power->info, sizeof(power->info));
+    // Service polls fast while info is read
+    uint32_t tick = osKernelGetTickCount();
+    bool is_stale = tick - power->info_tick > POWER_POLL_INTERVAL_ACTIVE;
+    power->info_read_tick = tick;
     osMutexRelease(power->api_mtx);
+
+    if(is_stale) {
+        osThreadFlagsSet(power->thread, POWER_THREAD_FLAG_UPDATE);
+    }
 }
 
 FuriPubSub* power_get_pubsub(Power* power) {
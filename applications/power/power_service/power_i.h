@@ -1,6 +1,7 @@
 #pragma once
 
 #include "power.h"
+#include "power_poll.h"
 
 #include <stdint.h>
 #include <gui/view_dispatcher.h>
@@ -13,6 +14,8 @@
 
 #define POWER_BATTERY_HEALTHY_LEVEL 70
 
+#define POWER_THREAD_FLAG_UPDATE (1 << 0)
+
 typedef enum {
     PowerStateNotCharging,
     PowerStateCharging,
@@ -30,13 +33,18 @@ struct Power {
     FuriPubSub* event_pubsub;
     PowerEvent event;
 
+    osThreadId_t thread;
+    PowerPoll poll;
+
     PowerState state;
     PowerInfo info;
+    uint32_t info_tick;
+    uint32_t info_read_tick;
 
     bool battery_low;
     bool show_low_bat_level_message;
     uint8_t battery_level;
-    uint8_t power_off_timeout;
+    uint32_t battery_low_tick;
 
     osMutexId_t api_mtx;
 };
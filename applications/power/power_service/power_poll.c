@@ -0,0 +1,39 @@
+#include "power_poll.h"
+
+#include <furi.h>
+#include <math.h>
+
+void power_poll_reset(PowerPoll* poll) {
+    furi_assert(poll);
+    memset(&poll->info, 0, sizeof(PowerInfo));
+    // Impossible level, first readout always differs
+    poll->info.charge = UINT8_MAX;
+    poll->settle = 0;
+}
+
+static bool power_poll_is_changed(const PowerInfo* last, const PowerInfo* info) {
+    return (last->charge != info->charge) ||
+           ((last->voltage_vbus > POWER_POLL_VBUS_PRESENT) !=
+            (info->voltage_vbus > POWER_POLL_VBUS_PRESENT)) ||
+           (fabsf(last->voltage_gauge - info->voltage_gauge) >= POWER_POLL_VOLTAGE_STEP) ||
+           (fabsf(last->current_gauge - info->current_gauge) >= POWER_POLL_CURRENT_STEP);
+}
+
+uint32_t power_poll_next(PowerPoll* poll, const PowerInfo* info, bool active) {
+    furi_assert(poll);
+    furi_assert(info);
+
+    if(power_poll_is_changed(&poll->info, info)) {
+        poll->settle = POWER_POLL_SETTLE_COUNT;
+    } else if(poll->settle) {
+        poll->settle--;
+    }
+    poll->info = *info;
+
+    // USB may be plugged without charging: charged battery or suppressed charge
+    active |= info->voltage_vbus > POWER_POLL_VBUS_PRESENT;
+    active |= fabsf(info->current_gauge) >= POWER_POLL_LOAD_CURRENT;
+    active |= poll->settle > 0;
+
+    return active ? POWER_POLL_INTERVAL_ACTIVE : POWER_POLL_INTERVAL_IDLE;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "power.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Poll interval when battery is idle and nothing changes, ms */
+#define POWER_POLL_INTERVAL_IDLE 5000
+/** Poll interval while power state is moving, ms */
+#define POWER_POLL_INTERVAL_ACTIVE 1000
+/** Active polls after a change, changes come in series */
+#define POWER_POLL_SETTLE_COUNT 5
+
+/** Gauge current that counts as load, A */
+#define POWER_POLL_LOAD_CURRENT 0.1f
+/** VBUS voltage above which USB is plugged, V */
+#define POWER_POLL_VBUS_PRESENT 4.0f
+/** Gauge voltage step that counts as change, V */
+#define POWER_POLL_VOLTAGE_STEP 0.05f
+/** Gauge current step that counts as change, A */
+#define POWER_POLL_CURRENT_STEP 0.05f
+
+/** Poll scheduler state */
+typedef struct {
+    PowerInfo info;
+    uint8_t settle;
+} PowerPoll;
+
+/** Reset scheduler, next readout counts as change
+ *
+ * @param poll      PowerPoll instance
+ */
+void power_poll_reset(PowerPoll* poll);
+
+/** Take new readout and get delay to the next one
+ *
+ * Polling is fast while USB is plugged, battery is under load or readout
+ * crossed one of the thresholds recently, slow otherwise.
+ *
+ * @param poll      PowerPoll instance
+ * @param info      new readout
+ * @param active    caller needs fast polling: charging, OTG, low battery or info readers
+ *
+ * @return          delay in ms
+ */
+uint32_t power_poll_next(PowerPoll* poll, const PowerInfo* info, bool active);
+
+#ifdef __cplusplus
+}
+#endif
@@ -505,9 +505,13 @@ static int32_t rpc_session_worker(void* context) {
                 RpcHandlerDict_get(session->handlers, session->decoded_message->which_content);
 
             if(handler && handler->message_handler) {
+                pb_size_t content = session->decoded_message->which_content;
+                uint32_t command_id = session->decoded_message->command_id;
+                FURI_TRACE_POINT(FuriTraceRpcBegin, content, command_id);
                 furi_check(osMutexAcquire(rpc->busy_mutex, osWaitForever) == osOK);
                 handler->message_handler(session->decoded_message, handler->context);
                 furi_check(osMutexRelease(rpc->busy_mutex) == osOK);
+                FURI_TRACE_POINT(FuriTraceRpcEnd, content, command_id);
             } else if(session->decoded_message->which_content == 0) {
                 /* Receiving zeroes means message is 0-length, which
                  * is valid for proto3: all fields are filled with default values.
@@ -624,7 +628,8 @@ RpcSession* rpc_session_open(Rpc* rpc) {
 
     session->thread = furi_thread_alloc();
     furi_thread_set_name(session->thread, "RpcSessionWorker");
-    furi_thread_set_stack_size(session->thread, 2048);
+    // Storage read and write requests run FS code on this stack
+    furi_thread_set_stack_size(session->thread, 3072);
     furi_thread_set_context(session->thread, session);
     furi_thread_set_callback(session->thread, rpc_session_worker);
 
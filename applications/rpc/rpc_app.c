@@ -60,6 +60,54 @@ static void rpc_system_app_lock_status_process(const PB_Main* request, void* con
     pb_release(&PB_Main_msg, &response);
 }
 
+static void rpc_system_app_stats_process(const PB_Main* request, void* context) {
+    furi_assert(request);
+    furi_assert(request->which_content == PB_Main_app_stats_request_tag);
+    RpcSession* session = (RpcSession*)context;
+    furi_assert(session);
+
+    Loader* loader = furi_record_open("loader");
+
+    if(request->content.app_stats_request.reset) {
+        loader_reset_stats(loader);
+        furi_record_close("loader");
+        rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
+        return;
+    }
+
+    // One response per app, single empty response if nothing was run yet
+    LoaderAppStats stats;
+    bool has_stats = loader_get_stats(loader, 0, &stats);
+    for(size_t index = 1;; index++) {
+        LoaderAppStats next;
+        bool has_next = has_stats && loader_get_stats(loader, index, &next);
+
+        PB_Main response = {
+            .has_next = has_next,
+            .command_status = PB_CommandStatus_OK,
+            .command_id = request->command_id,
+            .which_content = PB_Main_app_stats_response_tag,
+        };
+        if(has_stats) {
+            PB_App_StatsResponse* stats_response = &response.content.app_stats_response;
+            stats_response->name = strdup(stats.name);
+            stats_response->runs = stats.runs;
+            stats_response->run_time = stats.run_time;
+            stats_response->run_time_total = stats.run_time_total;
+            stats_response->stack_size = stats.stack_size;
+            stats_response->stack_peak = stats.stack_peak;
+            stats_response->heap_peak = stats.heap_peak;
+            stats_response->heap_live = stats.heap_live;
+        }
+
+        rpc_send_and_release(session, &response);
+        if(!has_next) break;
+        stats = next;
+    }
+
+    furi_record_close("loader");
+}
+
 void* rpc_system_app_alloc(RpcSession* session) {
     furi_assert(session);
 
@@ -75,5 +123,8 @@ void* rpc_system_app_alloc(RpcSession* session) {
     rpc_handler.message_handler = rpc_system_app_lock_status_process;
     rpc_add_handler(session, PB_Main_app_lock_status_request_tag, &rpc_handler);
 
+    rpc_handler.message_handler = rpc_system_app_stats_process;
+    rpc_add_handler(session, PB_Main_app_stats_request_tag, &rpc_handler);
+
     return NULL;
 }
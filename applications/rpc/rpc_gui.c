@@ -23,22 +23,30 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    GuiFrame* pending_frame;
 
     bool virtual_display_not_empty;
     bool is_streaming;
 } RpcGuiSystem;
 
-static void
-    rpc_system_gui_screen_stream_frame_callback(uint8_t* data, size_t size, void* context) {
-    furi_assert(data);
+static GuiFrame* rpc_system_gui_screen_stream_swap_pending(RpcGuiSystem* rpc_gui, GuiFrame* frame) {
+    FURI_CRITICAL_ENTER();
+    GuiFrame* previous = rpc_gui->pending_frame;
+    rpc_gui->pending_frame = frame;
+    FURI_CRITICAL_EXIT();
+    return previous;
+}
+
+static void rpc_system_gui_screen_stream_frame_callback(GuiFrame* frame, void* context) {
+    furi_assert(frame);
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
-
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
 
-    memcpy(buffer, data, size);
+    // Keep only the latest frame, GUI thread is not blocked by transmission
+    gui_frame_acquire(frame);
+    GuiFrame* stale = rpc_system_gui_screen_stream_swap_pending(rpc_gui, frame);
+    if(stale) gui_frame_release(stale);
 
     osThreadFlagsSet(
         furi_thread_get_thread_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
@@ -48,11 +56,18 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
+    pb_bytes_array_t* data = rpc_gui->transmit_frame->content.gui_screen_frame.data;
 
     while(true) {
         uint32_t flags = osThreadFlagsWait(RpcGuiWorkerFlagAny, osFlagsWaitAny, osWaitForever);
         if(flags & RpcGuiWorkerFlagTransmit) {
-            rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
+            GuiFrame* frame = rpc_system_gui_screen_stream_swap_pending(rpc_gui, NULL);
+            if(frame) {
+                furi_assert(gui_frame_get_size(frame) == data->size);
+                memcpy(data->bytes, gui_frame_get_data(frame), data->size);
+                gui_frame_release(frame);
+                rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
+            }
         }
         if(flags & RpcGuiWorkerFlagExit) {
             break;
@@ -113,6 +128,9 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
             furi_thread_get_thread_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
         furi_thread_join(rpc_gui->transmit_thread);
         furi_thread_free(rpc_gui->transmit_thread);
+        // Release frame not yet transmitted
+        GuiFrame* frame = rpc_system_gui_screen_stream_swap_pending(rpc_gui, NULL);
+        if(frame) gui_frame_release(frame);
         // Release frame
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
@@ -355,6 +373,9 @@ void rpc_system_gui_free(void* context) {
             furi_thread_get_thread_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
         furi_thread_join(rpc_gui->transmit_thread);
         furi_thread_free(rpc_gui->transmit_thread);
+        // Release frame not yet transmitted
+        GuiFrame* frame = rpc_system_gui_screen_stream_swap_pending(rpc_gui, NULL);
+        if(frame) gui_frame_release(frame);
         // Release frame
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
@@ -282,6 +282,7 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     const char* path = request->content.storage_read_request.path;
     Storage* fs_api = furi_record_open("storage");
     File* file = storage_file_alloc(fs_api);
+    storage_file_enable_direct(file);
     bool result = false;
 
     if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
@@ -342,6 +343,7 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
     if(rpc_storage->state != RpcStorageStateWriting) {
         rpc_storage->api = furi_record_open("storage");
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
+        storage_file_enable_direct(rpc_storage->file);
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
         const char* path = request->content.storage_write_request.path;
@@ -242,6 +242,112 @@ static void rpc_system_system_get_power_info_process(const PB_Main* request, voi
     free(response);
 }
 
+static void rpc_system_system_profiler_dump_callback(
+    const uint8_t* data,
+    size_t size,
+    bool last,
+    void* context) {
+    furi_assert(data);
+    RpcSystemContext* ctx = context;
+
+    PB_System_ProfilerResponse* profiler_response =
+        &ctx->response->content.system_profiler_response;
+    profiler_response->data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
+    memcpy(profiler_response->data->bytes, data, size);
+    profiler_response->data->size = size;
+    ctx->response->has_next = !last;
+
+    rpc_send_and_release(ctx->session, ctx->response);
+}
+
+static void rpc_system_system_profiler_process(const PB_Main* request, void* context) {
+    furi_assert(request);
+    furi_assert(request->which_content == PB_Main_system_profiler_request_tag);
+
+    RpcSession* session = (RpcSession*)context;
+    furi_assert(session);
+
+    const PB_System_ProfilerRequest* profiler_request = &request->content.system_profiler_request;
+    PB_CommandStatus status = PB_CommandStatus_OK;
+
+    if(profiler_request->action == PB_System_ProfilerRequest_Action_START) {
+        uint32_t rate = profiler_request->rate ? profiler_request->rate :
+                                                 FURI_HAL_PROFILER_RATE_DEFAULT;
+        if(!furi_hal_profiler_start(rate)) {
+            status = PB_CommandStatus_ERROR_INVALID_PARAMETERS;
+        }
+    } else if(profiler_request->action == PB_System_ProfilerRequest_Action_STOP) {
+        furi_hal_profiler_stop();
+    } else if(profiler_request->action == PB_System_ProfilerRequest_Action_DUMP) {
+        PB_Main* response = malloc(sizeof(PB_Main));
+        response->command_id = request->command_id;
+        response->which_content = PB_Main_system_profiler_response_tag;
+        response->command_status = PB_CommandStatus_OK;
+
+        RpcSystemContext profiler_context = {
+            .session = session,
+            .response = response,
+        };
+        bool dumped =
+            furi_hal_profiler_dump(rpc_system_system_profiler_dump_callback, &profiler_context);
+        free(response);
+        if(dumped) return;
+
+        status = PB_CommandStatus_ERROR;
+    } else {
+        status = PB_CommandStatus_ERROR_INVALID_PARAMETERS;
+    }
+
+    rpc_send_and_release_empty(session, request->command_id, status);
+}
+
+static void rpc_system_system_trace_drain_callback(
+    const uint8_t* data,
+    size_t size,
+    bool last,
+    void* context) {
+    furi_assert(data);
+    RpcSystemContext* ctx = context;
+
+    PB_System_TraceResponse* trace_response = &ctx->response->content.system_trace_response;
+    trace_response->data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
+    memcpy(trace_response->data->bytes, data, size);
+    trace_response->data->size = size;
+    ctx->response->has_next = !last;
+
+    rpc_send_and_release(ctx->session, ctx->response);
+}
+
+static void rpc_system_system_trace_process(const PB_Main* request, void* context) {
+    furi_assert(request);
+    furi_assert(request->which_content == PB_Main_system_trace_request_tag);
+
+    RpcSession* session = (RpcSession*)context;
+    furi_assert(session);
+
+    if(!furi_trace_is_enabled()) {
+        rpc_send_and_release_empty(
+            session, request->command_id, PB_CommandStatus_ERROR_NOT_IMPLEMENTED);
+        return;
+    }
+
+    PB_Main* response = malloc(sizeof(PB_Main));
+    response->command_id = request->command_id;
+    response->which_content = PB_Main_system_trace_response_tag;
+    response->command_status = PB_CommandStatus_OK;
+
+    RpcSystemContext trace_context = {
+        .session = session,
+        .response = response,
+    };
+    bool drained = furi_trace_drain(rpc_system_system_trace_drain_callback, &trace_context);
+    free(response);
+
+    if(!drained) {
+        rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_ERROR_BUSY);
+    }
+}
+
 void* rpc_system_system_alloc(RpcSession* session) {
     RpcHandler rpc_handler = {
         .message_handler = NULL,
@@ -276,5 +382,11 @@ void* rpc_system_system_alloc(RpcSession* session) {
     rpc_handler.message_handler = rpc_system_system_get_power_info_process;
     rpc_add_handler(session, PB_Main_system_power_info_request_tag, &rpc_handler);
 
+    rpc_handler.message_handler = rpc_system_system_profiler_process;
+    rpc_add_handler(session, PB_Main_system_profiler_request_tag, &rpc_handler);
+
+    rpc_handler.message_handler = rpc_system_system_trace_process;
+    rpc_add_handler(session, PB_Main_system_trace_request_tag, &rpc_handler);
+
     return NULL;
 }
@@ -47,6 +47,7 @@ typedef struct File File;
 typedef struct {
     uint8_t flags; /**< flags from FS_Flags enum */
     uint64_t size; /**< file size */
+    uint32_t mtime; /**< FAT date and time of last change, 0 if filesystem keeps none */
 } FileInfo;
 
 /** Gets the error text from FS_Error
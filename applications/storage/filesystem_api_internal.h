@@ -12,6 +12,8 @@ struct File {
     FS_Error error_id; /**< Standart API error from FS_Error enum */
     int32_t internal_error_id; /**< Internal API error value */
     void* storage;
+    void* storage_data; /**< StorageData of opened file, used for direct access */
+    bool direct; /**< Opened file calls run in caller thread */
 };
 
 /** File api structure
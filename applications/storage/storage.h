@@ -19,6 +19,14 @@ File* storage_file_alloc(Storage* storage);
  */
 void storage_file_free(File* file);
 
+/** Run calls on opened file in caller thread, not in storage service
+ * Read, write, seek, tell, truncate, size, sync, eof, dir read and rewind
+ * skip the service queue, FatFs or LittleFS runs on caller stack then and
+ * needs about 1.5KB of it. Call before open.
+ * @param file pointer to file object
+ */
+void storage_file_enable_direct(File* file);
+
 typedef enum {
     StorageEventTypeCardMount,
     StorageEventTypeCardUnmount,
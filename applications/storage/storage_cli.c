@@ -7,6 +7,7 @@
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
 #include <power/power_service/power.h>
+#include <user_diskio.h>
 
 #define MAX_NAME_LENGTH 255
 
@@ -67,6 +68,17 @@ static void storage_cli_info(Cli* cli, string_t path) {
                 sd_info.kb_total,
                 sd_info.kb_free);
         }
+
+        SectorCacheStats cache_stats;
+        if(user_diskio_cache_get_stats(&cache_stats)) {
+            printf(
+                "Cache: %lu hits, %lu misses, %lu bypassed, %lu evictions, %lu writebacks\r\n",
+                cache_stats.hits,
+                cache_stats.misses,
+                cache_stats.bypassed,
+                cache_stats.evictions,
+                cache_stats.writebacks);
+        }
     } else {
         storage_cli_print_usage();
     }
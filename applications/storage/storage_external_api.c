@@ -7,9 +7,8 @@
 
 #define MAX_NAME_LENGTH 256
 
-#define S_API_PROLOGUE                                      \
-    osSemaphoreId_t semaphore = osSemaphoreNew(1, 0, NULL); \
-    furi_check(semaphore != NULL);
+// Caller waits on its own task notification slot: no semaphore per call
+#define S_API_PROLOGUE osThreadId_t thread = osThreadGetId();
 
 #define S_FILE_API_PROLOGUE           \
     Storage* storage = file->storage; \
@@ -17,13 +16,12 @@
 
 #define S_API_EPILOGUE                                                                         \
     furi_check(osMessageQueuePut(storage->message_queue, &message, 0, osWaitForever) == osOK); \
-    osSemaphoreAcquire(semaphore, osWaitForever);                                              \
-    osSemaphoreDelete(semaphore);
+    ulTaskNotifyTakeIndexed(STORAGE_API_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
 
 #define S_API_MESSAGE(_command)      \
     SAReturn return_data;            \
     StorageMessage message = {       \
-        .semaphore = semaphore,      \
+        .thread = thread,            \
         .command = _command,         \
         .data = &data,               \
         .return_data = &return_data, \
@@ -41,6 +39,17 @@
             .path = path, \
         }};
 
+// Opened files with direct access enabled are served in caller thread under storage lock
+#define S_FILE_DIRECT_CALL(_fn)                     \
+    StorageData* storage_data = file->storage_data; \
+    if(storage_data == NULL) {                      \
+        file->error_id = FSE_INVALID_PARAMETER;     \
+    } else {                                        \
+        storage_data_lock(storage_data);            \
+        ret = storage_data->fs_api->_fn;            \
+        storage_data_unlock(storage_data);          \
+    }
+
 #define S_RETURN_BOOL (return_data.bool_value);
 #define S_RETURN_UINT16 (return_data.uint16_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
@@ -130,6 +139,12 @@ bool storage_file_close(File* file) {
 }
 
 uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
+    if(file->direct) {
+        uint16_t ret = 0;
+        S_FILE_DIRECT_CALL(file.read(storage_data, file, buff, bytes_to_read));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
 
@@ -146,6 +161,12 @@ uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
 }
 
 uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write) {
+    if(file->direct) {
+        uint16_t ret = 0;
+        S_FILE_DIRECT_CALL(file.write(storage_data, file, buff, bytes_to_write));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
 
@@ -162,6 +183,12 @@ uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_writ
 }
 
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    if(file->direct) {
+        bool ret = false;
+        S_FILE_DIRECT_CALL(file.seek(storage_data, file, offset, from_start));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
 
@@ -178,6 +205,12 @@ bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
 }
 
 uint64_t storage_file_tell(File* file) {
+    if(file->direct) {
+        uint64_t ret = 0;
+        S_FILE_DIRECT_CALL(file.tell(storage_data, file));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -187,6 +220,12 @@ uint64_t storage_file_tell(File* file) {
 }
 
 bool storage_file_truncate(File* file) {
+    if(file->direct) {
+        bool ret = false;
+        S_FILE_DIRECT_CALL(file.truncate(storage_data, file));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -196,6 +235,12 @@ bool storage_file_truncate(File* file) {
 }
 
 uint64_t storage_file_size(File* file) {
+    if(file->direct) {
+        uint64_t ret = 0;
+        S_FILE_DIRECT_CALL(file.size(storage_data, file));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -205,6 +250,12 @@ uint64_t storage_file_size(File* file) {
 }
 
 bool storage_file_sync(File* file) {
+    if(file->direct) {
+        bool ret = false;
+        S_FILE_DIRECT_CALL(file.sync(storage_data, file));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -214,6 +265,12 @@ bool storage_file_sync(File* file) {
 }
 
 bool storage_file_eof(File* file) {
+    if(file->direct) {
+        bool ret = false;
+        S_FILE_DIRECT_CALL(file.eof(storage_data, file));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -275,6 +332,12 @@ bool storage_dir_close(File* file) {
 }
 
 bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length) {
+    if(file->direct) {
+        bool ret = false;
+        S_FILE_DIRECT_CALL(dir.read(storage_data, file, fileinfo, name, name_length));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
 
@@ -292,6 +355,12 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
 }
 
 bool storage_dir_rewind(File* file) {
+    if(file->direct) {
+        bool ret = false;
+        S_FILE_DIRECT_CALL(dir.rewind(storage_data, file));
+        return ret;
+    }
+
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
     S_API_DATA_FILE;
@@ -450,10 +519,18 @@ File* storage_file_alloc(Storage* storage) {
     File* file = malloc(sizeof(File));
     file->file_id = FILE_CLOSED;
     file->storage = storage;
+    file->storage_data = NULL;
+    file->direct = false;
 
     return file;
 }
 
+void storage_file_enable_direct(File* file) {
+    furi_assert(file);
+    furi_assert(file->file_id == FILE_CLOSED);
+    file->direct = true;
+}
+
 bool storage_file_is_open(File* file) {
     return (file->file_id != FILE_CLOSED);
 }
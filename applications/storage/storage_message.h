@@ -122,8 +122,11 @@ typedef enum {
     StorageCommandSDStatus,
 } StorageCommand;
 
+/** Task notification slot used to wake API caller, slot 0 belongs to CMSIS thread flags */
+#define STORAGE_API_NOTIFY_INDEX 1
+
 typedef struct {
-    osSemaphoreId_t semaphore;
+    osThreadId_t thread;
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
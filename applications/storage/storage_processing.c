@@ -108,8 +108,13 @@ bool storage_process_file_open(
         if(storage_path_already_open(real_path, storage->files)) {
             file->error_id = FSE_ALREADY_OPEN;
         } else {
+            // Opened files are accessed directly by API, so file list is guarded too
+            storage_data_lock(storage);
             storage_push_storage_file(file, real_path, type, storage);
-            FS_CALL(storage, file.open(storage, file, remove_vfs(path), access_mode, open_mode));
+            ret = storage->fs_api->file.open(
+                storage, file, remove_vfs(path), access_mode, open_mode);
+            file->storage_data = storage;
+            storage_data_unlock(storage);
         }
 
         string_clear(real_path);
@@ -125,8 +130,11 @@ bool storage_process_file_close(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.close(storage, file));
+        storage_data_lock(storage);
+        ret = storage->fs_api->file.close(storage, file);
         storage_pop_storage_file(file, storage);
+        file->storage_data = NULL;
+        storage_data_unlock(storage);
 
         StorageEvent event = {.type = StorageEventTypeFileClose};
         furi_pubsub_publish(app->pubsub, &event);
@@ -267,8 +275,11 @@ bool storage_process_dir_open(Storage* app, File* file, const char* path) {
         if(storage_path_already_open(real_path, storage->files)) {
             file->error_id = FSE_ALREADY_OPEN;
         } else {
+            storage_data_lock(storage);
             storage_push_storage_file(file, real_path, type, storage);
-            FS_CALL(storage, dir.open(storage, file, remove_vfs(path)));
+            ret = storage->fs_api->dir.open(storage, file, remove_vfs(path));
+            file->storage_data = storage;
+            storage_data_unlock(storage);
         }
         string_clear(real_path);
     }
@@ -283,8 +294,11 @@ bool storage_process_dir_close(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, dir.close(storage, file));
+        storage_data_lock(storage);
+        ret = storage->fs_api->dir.close(storage, file);
         storage_pop_storage_file(file, storage);
+        file->storage_data = NULL;
+        storage_data_unlock(storage);
 
         StorageEvent event = {.type = StorageEventTypeDirClose};
         furi_pubsub_publish(app->pubsub, &event);
@@ -569,9 +583,11 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         break;
     }
 
-    osSemaphoreRelease(message->semaphore);
+    xTaskNotifyGiveIndexed((TaskHandle_t)message->thread, STORAGE_API_NOTIFY_INDEX);
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
+    FURI_TRACE_POINT(FuriTraceStorageBegin, message->command, 0);
     storage_process_message_internal(app, message);
+    FURI_TRACE_POINT(FuriTraceStorageEnd, message->command, 0);
 }
@@ -65,6 +65,8 @@ static bool sd_mount_card(StorageData* storage, bool notify) {
 
                 if(status == FR_OK) {
                     storage->status = StorageStatusOK;
+                    // FAT and root directory are hit on every path lookup
+                    user_diskio_cache_set_priority(fs->fatbase, fs->database);
                 } else if(status == FR_NO_FILESYSTEM) {
                     storage->status = StorageStatusNoFS;
                 } else {
@@ -104,6 +106,11 @@ FS_Error sd_unmount_card(StorageData* storage) {
 
     // TODO do i need to close the files?
 
+    // Write back cached sectors while card is still there
+    if(hal_sd_detect() && sd_data->fs->fs_type) {
+        disk_ioctl(sd_data->fs->drv, CTRL_SYNC, NULL);
+    }
+
     f_mount(0, sd_data->path, 0);
     storage_data_unlock(storage);
     return storage_ext_parse_error(error);
@@ -438,6 +445,7 @@ static bool storage_ext_dir_read(
 
     if(fileinfo != NULL) {
         fileinfo->size = _fileinfo.fsize;
+        fileinfo->mtime = ((uint32_t)_fileinfo.fdate << 16) | _fileinfo.ftime;
         fileinfo->flags = 0;
 
         if(_fileinfo.fattrib & AM_DIR) fileinfo->flags |= FSF_DIRECTORY;
@@ -470,6 +478,7 @@ static FS_Error storage_ext_common_stat(void* ctx, const char* path, FileInfo* f
 
     if(fileinfo != NULL) {
         fileinfo->size = _fileinfo.fsize;
+        fileinfo->mtime = ((uint32_t)_fileinfo.fdate << 16) | _fileinfo.ftime;
         fileinfo->flags = 0;
 
         if(_fileinfo.fattrib & AM_DIR) fileinfo->flags |= FSF_DIRECTORY;
@@ -1,6 +1,8 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/protocols/came.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/string_stream.h>
 
 #include <furi.h>
 #include <m-string.h>
@@ -158,6 +160,8 @@ bool subghz_history_add_to_history(
     string_init(item->item_str);
     item->flipper_string = flipper_format_string_alloc();
     subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, frequency, preset);
+    // record is kept until history reset, drop pool slack
+    string_stream_shrink(flipper_format_get_raw_stream(item->flipper_string));
 
     do {
         if(!flipper_format_rewind(item->flipper_string)) {
@@ -0,0 +1,265 @@
+#include <furi.h>
+#include <bt/bt_service/bt_rpc_tx.h>
+#include "../minunit.h"
+
+#define TAG "BtRpcTxTest"
+
+/** Default ATT MTU of 247 bytes with DLE */
+#define BT_RPC_TX_TEST_PACKET_SIZE 244
+#define BT_RPC_TX_TEST_BUFFERS_MAX 8
+#define BT_RPC_TX_TEST_MESSAGE_SIZE 1000
+#define BT_RPC_TX_TEST_MESSAGES 16
+#define BT_RPC_TX_TEST_DATA_SIZE (BT_RPC_TX_TEST_MESSAGE_SIZE * BT_RPC_TX_TEST_MESSAGES)
+#define BT_RPC_TX_TEST_TIMEOUT 2000
+
+/** Local BLE stand-in: controller with limited TX buffers, one connection event per tick */
+typedef struct {
+    osMutexId_t mutex;
+    FuriThread* thread;
+    BtRpcTx* tx;
+    volatile bool running;
+
+    uint8_t buffers;
+    uint8_t packets_per_event;
+    bool busy;
+    uint8_t queue[BT_RPC_TX_TEST_BUFFERS_MAX][BT_RPC_TX_TEST_PACKET_SIZE];
+    uint16_t queue_size[BT_RPC_TX_TEST_BUFFERS_MAX];
+    uint8_t head;
+    uint8_t count;
+
+    uint8_t* rx;
+    volatile size_t rx_size;
+    uint32_t packets;
+} BtRpcTxTestLink;
+
+static BtRpcTxTestLink* test_link;
+static BtRpcTx* tx;
+static uint8_t* test_data;
+
+static FuriHalBtSerialTxStatus link_tx_callback(uint8_t* buffer, uint16_t size, void* context) {
+    BtRpcTxTestLink* link = context;
+    FuriHalBtSerialTxStatus status = SerialServiceTxStatusOk;
+
+    furi_check(osMutexAcquire(link->mutex, osWaitForever) == osOK);
+    if(size > BT_RPC_TX_TEST_PACKET_SIZE) {
+        status = SerialServiceTxStatusError;
+    } else if(link->count >= link->buffers) {
+        link->busy = true;
+        status = SerialServiceTxStatusBusy;
+    } else {
+        uint8_t slot = (link->head + link->count) % BT_RPC_TX_TEST_BUFFERS_MAX;
+        memcpy(link->queue[slot], buffer, size);
+        link->queue_size[slot] = size;
+        link->count++;
+    }
+    furi_check(osMutexRelease(link->mutex) == osOK);
+
+    return status;
+}
+
+static int32_t link_controller(void* context) {
+    BtRpcTxTestLink* link = context;
+
+    while(link->running) {
+        osDelay(1);
+
+        bool notify = false;
+        furi_check(osMutexAcquire(link->mutex, osWaitForever) == osOK);
+        for(uint8_t i = 0; i < link->packets_per_event && link->count; i++) {
+            uint16_t size = link->queue_size[link->head];
+            if(link->rx_size + size <= BT_RPC_TX_TEST_DATA_SIZE) {
+                memcpy(&link->rx[link->rx_size], link->queue[link->head], size);
+            }
+            link->rx_size += size;
+            link->packets++;
+            link->head = (link->head + 1) % BT_RPC_TX_TEST_BUFFERS_MAX;
+            link->count--;
+            // Stack reports free buffers only after it refused a packet
+            notify |= link->busy;
+            link->busy = false;
+        }
+        furi_check(osMutexRelease(link->mutex) == osOK);
+
+        if(notify) {
+            bt_rpc_tx_notify_sent(link->tx);
+        }
+    }
+
+    return 0;
+}
+
+static void link_start(uint8_t buffers, uint8_t packets_per_event) {
+    test_link->buffers = buffers;
+    test_link->packets_per_event = packets_per_event;
+    test_link->busy = false;
+    test_link->head = 0;
+    test_link->count = 0;
+    test_link->rx_size = 0;
+    test_link->packets = 0;
+    test_link->running = true;
+    bt_rpc_tx_reset(tx, BT_RPC_TX_TEST_PACKET_SIZE);
+    furi_thread_start(test_link->thread);
+}
+
+static void link_stop() {
+    test_link->running = false;
+    furi_thread_join(test_link->thread);
+}
+
+static bool link_wait_rx(size_t size) {
+    uint32_t start = osKernelGetTickCount();
+    while(test_link->rx_size < size) {
+        if(osKernelGetTickCount() - start > BT_RPC_TX_TEST_TIMEOUT) return false;
+        osDelay(1);
+    }
+    return test_link->rx_size == size;
+}
+
+static void test_setup(void) {
+    test_link = malloc(sizeof(BtRpcTxTestLink));
+    test_link->mutex = osMutexNew(NULL);
+    test_link->rx = malloc(BT_RPC_TX_TEST_DATA_SIZE);
+    test_link->thread = furi_thread_alloc();
+    furi_thread_set_name(test_link->thread, "BtRpcTxTestLink");
+    furi_thread_set_stack_size(test_link->thread, 1024);
+    furi_thread_set_context(test_link->thread, test_link);
+    furi_thread_set_callback(test_link->thread, link_controller);
+
+    tx = bt_rpc_tx_alloc(link_tx_callback, test_link);
+    test_link->tx = tx;
+
+    test_data = malloc(BT_RPC_TX_TEST_DATA_SIZE);
+    for(size_t i = 0; i < BT_RPC_TX_TEST_DATA_SIZE; i++) {
+        test_data[i] = (i * 31 + (i >> 8)) & 0xFF;
+    }
+}
+
+static void test_teardown(void) {
+    bt_rpc_tx_free(tx);
+    furi_thread_free(test_link->thread);
+    free(test_link->rx);
+    osMutexDelete(test_link->mutex);
+    free(test_link);
+    free(test_data);
+}
+
+/** Send test data as RPC messages, return ticks until last byte is received */
+static uint32_t link_transfer() {
+    uint32_t start = osKernelGetTickCount();
+    for(size_t i = 0; i < BT_RPC_TX_TEST_MESSAGES; i++) {
+        if(!bt_rpc_tx_send(
+               tx, &test_data[i * BT_RPC_TX_TEST_MESSAGE_SIZE], BT_RPC_TX_TEST_MESSAGE_SIZE)) {
+            return 0;
+        }
+    }
+    if(!bt_rpc_tx_flush(tx) || !link_wait_rx(BT_RPC_TX_TEST_DATA_SIZE)) {
+        return 0;
+    }
+    return osKernelGetTickCount() - start;
+}
+
+MU_TEST(bt_rpc_tx_throughput_test) {
+    // Indication: next packet only after previous one is confirmed
+    link_start(1, 1);
+    uint32_t stop_and_wait_ticks = link_transfer();
+    link_stop();
+    mu_check(stop_and_wait_ticks);
+    mu_check(memcmp(test_link->rx, test_data, BT_RPC_TX_TEST_DATA_SIZE) == 0);
+
+    // Notifications: several packets per connection event, up to controller buffers
+    link_start(6, 4);
+    uint32_t pipelined_ticks = link_transfer();
+    link_stop();
+    mu_check(pipelined_ticks);
+    mu_check(memcmp(test_link->rx, test_data, BT_RPC_TX_TEST_DATA_SIZE) == 0);
+
+    FURI_LOG_I(
+        TAG,
+        "%d bytes, stop-and-wait: %lu ticks, pipelined: %lu ticks",
+        BT_RPC_TX_TEST_DATA_SIZE,
+        stop_and_wait_ticks,
+        pipelined_ticks);
+    mu_assert_int_greater_than(pipelined_ticks * 2, stop_and_wait_ticks);
+}
+
+MU_TEST(bt_rpc_tx_coalesce_test) {
+    const size_t message_size = 10;
+    const size_t messages = 100;
+
+    link_start(6, 4);
+    bool sent = true;
+    for(size_t i = 0; i < messages; i++) {
+        sent &= bt_rpc_tx_send(tx, &test_data[i * message_size], message_size);
+    }
+    // Only full packets are sent before flush
+    osDelay(10);
+    size_t sent_before_flush = test_link->rx_size;
+    sent &= bt_rpc_tx_flush(tx);
+    bool received = link_wait_rx(message_size * messages);
+    link_stop();
+
+    mu_check(sent);
+    mu_check(received);
+    mu_assert_int_eq(
+        (message_size * messages) / BT_RPC_TX_TEST_PACKET_SIZE * BT_RPC_TX_TEST_PACKET_SIZE,
+        sent_before_flush);
+    mu_check(memcmp(test_link->rx, test_data, message_size * messages) == 0);
+    mu_assert_int_eq(
+        (message_size * messages + BT_RPC_TX_TEST_PACKET_SIZE - 1) / BT_RPC_TX_TEST_PACKET_SIZE,
+        test_link->packets);
+}
+
+static int32_t bt_rpc_tx_test_sender(void* context) {
+    bool* result = context;
+    *result = bt_rpc_tx_send(tx, test_data, BT_RPC_TX_TEST_MESSAGE_SIZE);
+    return 0;
+}
+
+MU_TEST(bt_rpc_tx_abort_test) {
+    // Controller doesn't transmit: sender blocks on second packet
+    link_start(1, 0);
+    bool sender_result = true;
+    FuriThread* sender = furi_thread_alloc();
+    furi_thread_set_name(sender, "BtRpcTxTestSender");
+    furi_thread_set_stack_size(sender, 1024);
+    furi_thread_set_context(sender, &sender_result);
+    furi_thread_set_callback(sender, bt_rpc_tx_test_sender);
+    furi_thread_start(sender);
+
+    osDelay(10);
+    FuriThreadState state = furi_thread_get_state(sender);
+    bt_rpc_tx_abort(tx);
+    furi_thread_join(sender);
+    furi_thread_free(sender);
+    // Everything is dropped until reset
+    bool sent_after_abort = bt_rpc_tx_send(tx, test_data, BT_RPC_TX_TEST_MESSAGE_SIZE);
+    link_stop();
+
+    mu_assert_int_eq(FuriThreadStateRunning, state);
+    mu_check(!sender_result);
+    mu_check(!sent_after_abort);
+
+    // Reset for new connection
+    link_start(6, 4);
+    bool sent = bt_rpc_tx_send(tx, test_data, BT_RPC_TX_TEST_MESSAGE_SIZE);
+    sent &= bt_rpc_tx_flush(tx);
+    bool received = link_wait_rx(BT_RPC_TX_TEST_MESSAGE_SIZE);
+    link_stop();
+
+    mu_check(sent);
+    mu_check(received);
+    mu_check(memcmp(test_link->rx, test_data, BT_RPC_TX_TEST_MESSAGE_SIZE) == 0);
+}
+
+MU_TEST_SUITE(bt_rpc_tx_suite) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(bt_rpc_tx_throughput_test);
+    MU_RUN_TEST(bt_rpc_tx_coalesce_test);
+    MU_RUN_TEST(bt_rpc_tx_abort_test);
+}
+
+int run_minunit_test_bt_rpc_tx() {
+    MU_RUN_SUITE(bt_rpc_tx_suite);
+    return MU_EXIT_CODE;
+}
@@ -322,12 +322,118 @@ MU_TEST(flipper_format_file_test) {
     stream_write_cstring(stream, test_data_win);
     MU_RUN_TEST_1(flipper_format_read_and_update_test, flipper_format);
 
+    // same with key index
+    flipper_format_set_index_mode(flipper_format, true);
+
+    stream_clean(stream);
+    stream_write_cstring(stream, test_data_nix);
+    MU_RUN_TEST_1(flipper_format_read_and_update_test, flipper_format);
+
+    stream_clean(stream);
+    stream_write_cstring(stream, test_data_win);
+    MU_RUN_TEST_1(flipper_format_read_and_update_test, flipper_format);
+
     flipper_format_free(flipper_format);
     furi_record_close("storage");
 }
 
+MU_TEST(flipper_format_string_index_test) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    string_t tmpstr;
+    string_init(tmpstr);
+    uint32_t value;
+
+    // duplicate keys are read in order
+    for(uint32_t i = 0; i < 4; i++) {
+        mu_check(flipper_format_write_uint32(flipper_format, "Block", &i, 1));
+        mu_check(flipper_format_write_comment_cstr(flipper_format, "Block: 666"));
+    }
+    mu_check(flipper_format_write_string_cstr(flipper_format, test_string_key, test_string_data));
+
+    mu_check(flipper_format_rewind(flipper_format));
+    for(uint32_t i = 0; i < 4; i++) {
+        mu_check(flipper_format_read_uint32(flipper_format, "Block", &value, 1));
+        mu_assert_int_eq(i, value);
+    }
+    mu_check(!flipper_format_read_uint32(flipper_format, "Block", &value, 1));
+
+    // keys after the updated one are found at their new offsets
+    mu_check(flipper_format_update_string_cstr(flipper_format, "Block", "Longer than it was"));
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_read_string(flipper_format, test_string_key, tmpstr));
+    mu_assert_string_eq(test_string_data, string_get_cstr(tmpstr));
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_read_string(flipper_format, "Block", tmpstr));
+    mu_assert_string_eq("Longer than it was", string_get_cstr(tmpstr));
+    mu_check(flipper_format_read_uint32(flipper_format, "Block", &value, 1));
+    mu_assert_int_eq(1, value);
+
+    mu_check(flipper_format_delete_key(flipper_format, "Block"));
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_read_uint32(flipper_format, "Block", &value, 1));
+    mu_assert_int_eq(1, value);
+
+    // changes made through the raw stream are picked up
+    stream_clean(stream);
+    stream_write_cstring(stream, "Block: 42\n");
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(!flipper_format_key_exist(flipper_format, test_string_key));
+    mu_check(flipper_format_read_uint32(flipper_format, "Block", &value, 1));
+    mu_assert_int_eq(42, value);
+
+    string_clear(tmpstr);
+    flipper_format_free(flipper_format);
+}
+
+MU_TEST(flipper_format_string_values_test) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    uint32_t count;
+
+    // long lines go through more than one write and read buffer
+    uint8_t hex_data[100];
+    uint8_t hex_read[COUNT_OF(hex_data)];
+    for(size_t i = 0; i < COUNT_OF(hex_data); i++) hex_data[i] = i * 37;
+
+    const int32_t int_data[] = {INT32_MIN, -1, 0, 1, INT32_MAX};
+    int32_t int_read[COUNT_OF(int_data)];
+    const uint32_t uint_data[] = {0, 1, INT32_MAX, 3000000000UL, UINT32_MAX};
+    uint32_t uint_read[COUNT_OF(uint_data)];
+    const float float_data[] = {-3.4e38f, -0.5f, 0.0f, 123456.0f, 3.4e38f};
+    float float_read[COUNT_OF(float_data)];
+
+    mu_check(flipper_format_write_hex(flipper_format, test_hex_key, ARRAY_W_COUNT(hex_data)));
+    mu_check(flipper_format_write_int32(flipper_format, test_int_key, ARRAY_W_COUNT(int_data)));
+    mu_check(
+        flipper_format_write_uint32(flipper_format, test_uint_key, ARRAY_W_COUNT(uint_data)));
+    mu_check(
+        flipper_format_write_float(flipper_format, test_float_key, ARRAY_W_COUNT(float_data)));
+
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(flipper_format_get_value_count(flipper_format, test_hex_key, &count));
+    mu_assert_int_eq(COUNT_OF(hex_data), count);
+    mu_check(flipper_format_read_hex(flipper_format, test_hex_key, ARRAY_W_COUNT(hex_read)));
+    mu_check(memcmp(hex_data, ARRAY_W_BSIZE(hex_read)) == 0);
+    mu_check(flipper_format_read_int32(flipper_format, test_int_key, ARRAY_W_COUNT(int_read)));
+    mu_check(memcmp(int_data, ARRAY_W_BSIZE(int_read)) == 0);
+    mu_check(
+        flipper_format_read_uint32(flipper_format, test_uint_key, ARRAY_W_COUNT(uint_read)));
+    mu_check(memcmp(uint_data, ARRAY_W_BSIZE(uint_read)) == 0);
+    mu_check(
+        flipper_format_read_float(flipper_format, test_float_key, ARRAY_W_COUNT(float_read)));
+    mu_check(memcmp(float_data, ARRAY_W_BSIZE(float_read)) == 0);
+
+    // not enough values
+    mu_check(flipper_format_rewind(flipper_format));
+    mu_check(!flipper_format_read_int32(flipper_format, test_int_key, int_read, 6));
+
+    flipper_format_free(flipper_format);
+}
+
 MU_TEST_SUITE(flipper_format_string_suite) {
     MU_RUN_TEST(flipper_format_string_test);
+    MU_RUN_TEST(flipper_format_string_index_test);
+    MU_RUN_TEST(flipper_format_string_values_test);
     MU_RUN_TEST(flipper_format_file_test);
 }
 
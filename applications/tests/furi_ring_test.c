@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include <stream_buffer.h>
+
+#include "minunit.h"
+
+#define TAG "FuriRingTest"
+
+#define TEST_RING_SIZE 8
+#define TEST_RING_ITEMS 20000
+#define TEST_RING_WATERMARK 3
+#define TEST_RING_FLAG 0x01
+#define TEST_RING_PUSH_DELAY 5
+#define TEST_RING_BENCH_ITEMS 4096
+#define TEST_RING_BENCH_BATCH 32
+
+static void test_furi_ring_batches() {
+    FuriRing* ring = furi_ring_alloc(sizeof(uint32_t), TEST_RING_SIZE);
+    uint32_t data[TEST_RING_SIZE + 3];
+    for(size_t i = 0; i < COUNT_OF(data); i++) {
+        data[i] = i;
+    }
+
+    // push is cut at capacity
+    mu_assert_int_eq(5, furi_ring_push(ring, data, 5));
+    mu_assert_int_eq(3, furi_ring_push(ring, &data[5], 5));
+    mu_assert_int_eq(0, furi_ring_push(ring, data, 1));
+    mu_assert_int_eq(TEST_RING_SIZE, furi_ring_count(ring));
+    mu_assert_int_eq(0, furi_ring_space(ring));
+
+    uint32_t out[TEST_RING_SIZE + 3];
+    mu_assert_int_eq(3, furi_ring_pop(ring, out, 3));
+    mu_check(memcmp(data, out, 3 * sizeof(uint32_t)) == 0);
+
+    // batch going over the buffer end
+    mu_assert_int_eq(3, furi_ring_push(ring, &data[8], 3));
+    mu_assert_int_eq(TEST_RING_SIZE, furi_ring_pop(ring, out, COUNT_OF(out)));
+    mu_check(memcmp(&data[3], out, TEST_RING_SIZE * sizeof(uint32_t)) == 0);
+    mu_assert_int_eq(0, furi_ring_pop(ring, out, COUNT_OF(out)));
+
+    furi_ring_push(ring, data, 2);
+    furi_ring_reset(ring);
+    mu_assert_int_eq(0, furi_ring_count(ring));
+
+    furi_ring_free(ring);
+}
+
+static int32_t test_furi_ring_producer(void* context) {
+    FuriRing* ring = context;
+    uint32_t batch[5];
+    uint32_t next = 0;
+
+    while(next < TEST_RING_ITEMS) {
+        size_t size = MIN(1 + next % COUNT_OF(batch), TEST_RING_ITEMS - next);
+        for(size_t i = 0; i < size; i++) {
+            batch[i] = next + i;
+        }
+        size_t pushed = furi_ring_push(ring, batch, size);
+        if(!pushed) osThreadYield();
+        next += pushed;
+    }
+
+    return 0;
+}
+
+static void test_furi_ring_threads() {
+    FuriRing* ring = furi_ring_alloc(sizeof(uint32_t), TEST_RING_SIZE);
+    furi_ring_set_notify(ring, osThreadGetId(), TEST_RING_FLAG, TEST_RING_WATERMARK);
+
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, "RingProducer");
+    furi_thread_set_stack_size(thread, 1024);
+    furi_thread_set_context(thread, ring);
+    furi_thread_set_callback(thread, test_furi_ring_producer);
+    furi_thread_start(thread);
+
+    // every item comes once and in order
+    uint32_t batch[2];
+    uint32_t next = 0;
+    uint32_t errors = 0;
+    while(next < TEST_RING_ITEMS) {
+        furi_ring_wait(ring, 1);
+        size_t count;
+        while((count = furi_ring_pop(ring, batch, COUNT_OF(batch)))) {
+            for(size_t i = 0; i < count; i++) {
+                errors += (batch[i] != next++);
+            }
+        }
+    }
+
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+    furi_ring_set_notify(ring, NULL, 0, 0);
+    osThreadFlagsClear(TEST_RING_FLAG);
+
+    mu_assert_int_eq(0, errors);
+    mu_assert_int_eq(0, furi_ring_count(ring));
+
+    furi_ring_free(ring);
+}
+
+static int32_t test_furi_ring_slow_producer(void* context) {
+    FuriRing* ring = context;
+
+    for(uint32_t i = 0; i < TEST_RING_WATERMARK; i++) {
+        osDelay(TEST_RING_PUSH_DELAY);
+        furi_ring_push(ring, &i, 1);
+    }
+
+    return 0;
+}
+
+static void test_furi_ring_watermark() {
+    FuriRing* ring = furi_ring_alloc(sizeof(uint32_t), TEST_RING_SIZE);
+    furi_ring_set_notify(ring, osThreadGetId(), TEST_RING_FLAG, TEST_RING_WATERMARK);
+    osThreadFlagsClear(TEST_RING_FLAG);
+
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, "RingProducer");
+    furi_thread_set_stack_size(thread, 1024);
+    furi_thread_set_context(thread, ring);
+    furi_thread_set_callback(thread, test_furi_ring_slow_producer);
+    furi_thread_start(thread);
+
+    // no timeout: only the push reaching watermark may wake consumer up
+    size_t count = furi_ring_wait(ring, osWaitForever);
+
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+    furi_ring_set_notify(ring, NULL, 0, 0);
+    osThreadFlagsClear(TEST_RING_FLAG);
+
+    mu_assert_int_eq(TEST_RING_WATERMARK, count);
+
+    furi_ring_free(ring);
+}
+
+static void test_furi_ring_cycles() {
+    FuriRing* ring = furi_ring_alloc(sizeof(uint32_t), TEST_RING_BENCH_BATCH);
+    StreamBufferHandle_t stream =
+        xStreamBufferCreate(TEST_RING_BENCH_BATCH * sizeof(uint32_t), sizeof(uint32_t));
+    uint32_t batch[TEST_RING_BENCH_BATCH];
+    size_t ring_count = 0;
+    size_t stream_count = 0;
+
+    // Item by item in, batch out: the way radio workers use it
+    uint32_t start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < TEST_RING_BENCH_ITEMS; i++) {
+        furi_ring_push(ring, &i, 1);
+        if(furi_ring_space(ring) == 0) {
+            ring_count += furi_ring_pop(ring, batch, TEST_RING_BENCH_BATCH);
+        }
+    }
+    uint32_t ring_cycles = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < TEST_RING_BENCH_ITEMS; i++) {
+        xStreamBufferSend(stream, &i, sizeof(uint32_t), 0);
+        if(xStreamBufferSpacesAvailable(stream) == 0) {
+            stream_count += xStreamBufferReceive(stream, batch, sizeof(batch), 0);
+        }
+    }
+    uint32_t stream_cycles = DWT->CYCCNT - start;
+
+    FURI_LOG_I(
+        TAG,
+        "Cycles per item: ring %lu, stream buffer %lu",
+        ring_cycles / TEST_RING_BENCH_ITEMS,
+        stream_cycles / TEST_RING_BENCH_ITEMS);
+
+    vStreamBufferDelete(stream);
+    furi_ring_free(ring);
+
+    mu_assert_int_eq(TEST_RING_BENCH_ITEMS, ring_count);
+    mu_assert_int_eq(TEST_RING_BENCH_ITEMS * sizeof(uint32_t), stream_count);
+    mu_check(ring_cycles < stream_cycles);
+}
+
+void test_furi_ring() {
+    test_furi_ring_batches();
+    test_furi_ring_threads();
+    test_furi_ring_watermark();
+    test_furi_ring_cycles();
+}
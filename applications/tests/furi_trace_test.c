@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+
+#include "minunit.h"
+
+#define TAG "FuriTraceTest"
+
+#define TEST_TRACE_MAGIC 0x7E57AC1D
+#define TEST_TRACE_STREAM_MAX (64 * 1024)
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    bool last;
+} TestTraceStream;
+
+static void test_furi_trace_callback(const uint8_t* data, size_t size, bool last, void* context) {
+    TestTraceStream* stream = context;
+    if(stream->size + size <= TEST_TRACE_STREAM_MAX) {
+        memcpy(&stream->data[stream->size], data, size);
+    }
+    stream->size += size;
+    stream->last = last;
+}
+
+/* Event of this thread carries the number of its thread record */
+void test_furi_trace() {
+    if(!furi_trace_is_enabled()) {
+        FURI_LOG_W(TAG, "Skipped, firmware is built without FURI_TRACE=1");
+        return;
+    }
+
+    TestTraceStream stream = {
+        .data = malloc(TEST_TRACE_STREAM_MAX),
+        .size = 0,
+        .last = false,
+    };
+    furi_trace_event(FuriTraceUsbUartRx, TEST_TRACE_MAGIC, 0);
+    mu_check(furi_trace_drain(test_furi_trace_callback, &stream));
+    mu_check(stream.last);
+    mu_check(stream.size <= TEST_TRACE_STREAM_MAX);
+
+    FuriTraceHeader header;
+    memcpy(&header, stream.data, sizeof(FuriTraceHeader));
+    mu_assert_int_eq(FURI_TRACE_MAGIC, header.magic);
+    size_t threads_offset =
+        sizeof(FuriTraceHeader) + header.point_count * sizeof(FuriTracePointInfo);
+    size_t events_offset = threads_offset + header.thread_count * sizeof(FuriTraceThread);
+    mu_assert_int_eq(events_offset + header.event_count * sizeof(FuriTraceEvent), stream.size);
+
+    FuriTraceEvent event;
+    bool found = false;
+    for(size_t i = 0; i < header.event_count && !found; i++) {
+        memcpy(&event, &stream.data[events_offset + i * sizeof(FuriTraceEvent)], sizeof(event));
+        found = (event.id == FuriTraceUsbUartRx) && (event.arg0 == TEST_TRACE_MAGIC);
+    }
+    mu_check(found);
+    mu_check(!(event.context & FURI_TRACE_CONTEXT_ISR));
+    mu_check(event.context != 0);
+
+    const char* name = osThreadGetName(osThreadGetId());
+    FuriTraceThread thread;
+    bool matched = false;
+    for(size_t i = 0; i < header.thread_count && !matched; i++) {
+        size_t offset = threads_offset + i * sizeof(FuriTraceThread);
+        memcpy(&thread, &stream.data[offset], sizeof(thread));
+        matched = (thread.number == event.context);
+    }
+    mu_check(matched);
+    mu_check(strncmp(thread.name, name, FURI_TRACE_NAME_SIZE) == 0);
+
+    free(stream.data);
+}
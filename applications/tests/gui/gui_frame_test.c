@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <furi.h>
+#include <gui/gui_i.h>
+#include "../minunit.h"
+
+#define TAG "UnitTestsGuiFrame"
+
+#define GUI_FRAME_TEST_QUEUE_SIZE 8
+#define GUI_FRAME_TEST_UPDATES 8
+#define GUI_FRAME_TEST_TIMEOUT 500
+
+static Gui* gui;
+static ViewPort* view_port;
+static osMessageQueueId_t frame_queue;
+static volatile uint32_t draw_counter;
+
+static void gui_frame_test_draw(Canvas* canvas, void* context) {
+    char text[16];
+    snprintf(text, sizeof(text), "%lu", draw_counter);
+    canvas_draw_str(canvas, 0, 10, text);
+}
+
+static void gui_frame_test_commit(GuiFrame* frame, void* context) {
+    gui_frame_acquire(frame);
+    if(osMessageQueuePut(frame_queue, &frame, 0, 0) != osOK) {
+        gui_frame_release(frame);
+    }
+}
+
+static GuiFrame* gui_frame_test_redraw(uint32_t timeout) {
+    draw_counter++;
+    view_port_update(view_port);
+
+    GuiFrame* frame = NULL;
+    osMessageQueueGet(frame_queue, &frame, NULL, timeout);
+    return frame;
+}
+
+static size_t gui_frame_test_pool_size() {
+    gui_lock(gui);
+    size_t size = GuiFrameArray_size(gui->frames);
+    gui_unlock(gui);
+    return size;
+}
+
+static void gui_frame_test_setup() {
+    gui = furi_record_open("gui");
+    frame_queue = osMessageQueueNew(GUI_FRAME_TEST_QUEUE_SIZE, sizeof(GuiFrame*), NULL);
+    view_port = view_port_alloc();
+    view_port_draw_callback_set(view_port, gui_frame_test_draw, NULL);
+    gui_add_view_port(gui, view_port, GuiLayerFullscreen);
+
+    gui_add_framebuffer_callback(gui, gui_frame_test_commit, NULL);
+    // Current frame is handed right away
+    GuiFrame* frame = NULL;
+    if(osMessageQueueGet(frame_queue, &frame, NULL, GUI_FRAME_TEST_TIMEOUT) == osOK) {
+        gui_frame_release(frame);
+    }
+}
+
+static void gui_frame_test_teardown() {
+    gui_remove_framebuffer_callback(gui, gui_frame_test_commit, NULL);
+    GuiFrame* frame;
+    while(osMessageQueueGet(frame_queue, &frame, NULL, 0) == osOK) {
+        gui_frame_release(frame);
+    }
+
+    gui_remove_view_port(gui, view_port);
+    view_port_free(view_port);
+    osMessageQueueDelete(frame_queue);
+    furi_record_close("gui");
+}
+
+MU_TEST(gui_frame_release_test) {
+    uint32_t sequence = 0;
+    for(size_t i = 0; i < GUI_FRAME_TEST_UPDATES; i++) {
+        GuiFrame* frame = gui_frame_test_redraw(GUI_FRAME_TEST_TIMEOUT);
+        mu_assert(frame, "changed frame is not dispatched");
+        mu_check(gui_frame_get_sequence(frame) > sequence);
+        mu_assert_int_eq(gui_get_framebuffer_size(gui), gui_frame_get_size(frame));
+        sequence = gui_frame_get_sequence(frame);
+        gui_frame_release(frame);
+    }
+
+    mu_check(gui_frame_test_pool_size() <= GUI_FRAME_POOL_SIZE);
+}
+
+MU_TEST(gui_frame_hold_test) {
+    GuiFrame* held[GUI_FRAME_TEST_UPDATES];
+    size_t held_count = 0;
+    uint32_t dropped = gui->frames_dropped;
+
+    // Subscriber keeps every frame: pool stays capped, frames past it are dropped
+    for(size_t i = 0; i < GUI_FRAME_TEST_UPDATES; i++) {
+        GuiFrame* frame = gui_frame_test_redraw(GUI_FRAME_TEST_TIMEOUT / 10);
+        if(frame) held[held_count++] = frame;
+    }
+
+    mu_check(held_count > 0);
+    mu_check(held_count < GUI_FRAME_POOL_SIZE);
+    mu_check(gui->frames_dropped > dropped);
+    mu_assert_int_eq(GUI_FRAME_POOL_SIZE, gui_frame_test_pool_size());
+    for(size_t i = 1; i < held_count; i++) {
+        mu_check(gui_frame_get_data(held[i]) != gui_frame_get_data(held[i - 1]));
+    }
+
+    // Released buffers are reused and the latest drawing is delivered without new update
+    uint32_t sequence = gui_frame_get_sequence(held[held_count - 1]);
+    for(size_t i = 0; i < held_count; i++) {
+        gui_frame_release(held[i]);
+    }
+    GuiFrame* frame = NULL;
+    osMessageQueueGet(frame_queue, &frame, NULL, GUI_FRAME_TEST_TIMEOUT);
+    mu_assert(frame, "dropped frame is not delivered after release");
+    mu_check(gui_frame_get_sequence(frame) > sequence);
+    gui_frame_release(frame);
+
+    mu_check(gui_frame_test_pool_size() <= GUI_FRAME_POOL_SIZE);
+}
+
+MU_TEST_SUITE(gui_frame_suite) {
+    MU_SUITE_CONFIGURE(&gui_frame_test_setup, &gui_frame_test_teardown);
+    MU_RUN_TEST(gui_frame_release_test);
+    MU_RUN_TEST(gui_frame_hold_test);
+}
+
+int run_minunit_test_gui_frame() {
+    MU_RUN_SUITE(gui_frame_suite);
+    return MU_EXIT_CODE;
+}
@@ -7,6 +7,8 @@ void test_furi_create_open();
 void test_furi_valuemutex();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
+void test_furi_ring();
+void test_furi_trace();
 
 void test_furi_memmgr();
 
@@ -41,6 +43,14 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_ring) {
+    test_furi_ring();
+}
+
+MU_TEST(mu_test_furi_trace) {
+    test_furi_trace();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
@@ -57,6 +67,8 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_valuemutex);
     MU_RUN_TEST(mu_test_furi_concurrent_access);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_ring);
+    MU_RUN_TEST(mu_test_furi_trace);
     MU_RUN_TEST(mu_test_furi_memmgr);
 }
 
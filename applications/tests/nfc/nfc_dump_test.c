@@ -0,0 +1,221 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/stream/string_stream.h>
+#include <toolbox/stream/file_stream.h>
+#include <nfc/nfc_device.h>
+#include <nfc/helpers/nfc_dump.h>
+#include "../minunit.h"
+
+#define TAG "NfcDumpTest"
+
+#define NFC_DUMP_TEST_NAME "unit_test_dump"
+#define NFC_DUMP_TEST_FILE NFC_APP_FOLDER "/" NFC_DUMP_TEST_NAME NFC_APP_EXTENSION
+#define NFC_DUMP_TEST_DUMP_FILE NFC_APP_FOLDER "/" NFC_DUMP_TEST_NAME NFC_APP_DUMP_EXTENSION
+/** FAT keeps modification time in 2 second steps */
+#define NFC_DUMP_TEST_MTIME_STEP_MS 2000
+
+static const NfcDumpSource test_source = {.size = 0x2D00, .mtime = 0x54A3A000};
+static NfcDeviceData* test_data;
+static NfcDeviceData* test_loaded;
+
+static void test_setup(void) {
+    test_data = malloc(sizeof(NfcDeviceData));
+    test_loaded = malloc(sizeof(NfcDeviceData));
+}
+
+static void test_teardown(void) {
+    free(test_data);
+    free(test_loaded);
+}
+
+static void nfc_dump_test_fill_mf_classic(NfcDeviceData* data) {
+    memset(data, 0, sizeof(NfcDeviceData));
+    data->nfc_data.uid_len = 4;
+    data->nfc_data.uid[0] = 0xDE;
+    data->nfc_data.atqa[0] = 0x02;
+    data->nfc_data.sak = 0x18;
+    data->nfc_data.protocol = NfcDeviceProtocolMifareClassic;
+    data->mf_classic_data.type = MfClassicType4k;
+    for(size_t i = 0; i < MF_CLASSIC_TOTAL_BLOCKS_MAX; i++) {
+        for(size_t j = 0; j < MF_CLASSIC_BLOCK_SIZE; j++) {
+            data->mf_classic_data.block[i].value[j] = i ^ (j * 3);
+        }
+    }
+}
+
+/** One application with data and value files, key versions for all keys as card gives them */
+static void nfc_dump_test_fill_mf_df(NfcDeviceData* data) {
+    memset(data, 0, sizeof(NfcDeviceData));
+    data->nfc_data.uid_len = 7;
+    data->nfc_data.protocol = NfcDeviceProtocolMifareDesfire;
+    MifareDesfireData* mf_df = &data->mf_df_data;
+    mf_df->version.hw_vendor = 0x04;
+    mf_df->master_key_settings = malloc(sizeof(MifareDesfireKeySettings));
+    memset(mf_df->master_key_settings, 0, sizeof(MifareDesfireKeySettings));
+    mf_df->master_key_settings->max_keys = 1;
+    mf_df->master_key_settings->key_version_head = malloc(sizeof(MifareDesfireKeyVersion));
+    memset(mf_df->master_key_settings->key_version_head, 0, sizeof(MifareDesfireKeyVersion));
+
+    MifareDesfireApplication* app = malloc(sizeof(MifareDesfireApplication));
+    memset(app, 0, sizeof(MifareDesfireApplication));
+    app->id[0] = 0xF2;
+    MifareDesfireFile* data_file = malloc(sizeof(MifareDesfireFile));
+    memset(data_file, 0, sizeof(MifareDesfireFile));
+    data_file->type = MifareDesfireFileTypeStandard;
+    data_file->settings.data.size = 32;
+    data_file->contents = malloc(32);
+    memset(data_file->contents, 0xA5, 32);
+    MifareDesfireFile* value_file = malloc(sizeof(MifareDesfireFile));
+    memset(value_file, 0, sizeof(MifareDesfireFile));
+    value_file->id = 1;
+    value_file->type = MifareDesfireFileTypeValue;
+    value_file->settings.value.hi_limit = 1000;
+    data_file->next = value_file;
+    app->file_head = data_file;
+    mf_df->app_head = app;
+}
+
+MU_TEST(nfc_dump_round_trip_test) {
+    Stream* stream = string_stream_alloc();
+    NfcDeviceSaveFormat format = NfcDeviceSaveFormatUid;
+
+    nfc_dump_test_fill_mf_classic(test_data);
+    mu_check(nfc_dump_save(
+        stream, NfcDeviceSaveFormatMifareClassic, test_data, &test_source));
+    // Block data and a few bytes of header and sections
+    mu_assert_int_greater_than(MF_CLASSIC_TOTAL_BLOCKS_MAX * 16, stream_size(stream));
+    mu_assert_int_less_than(MF_CLASSIC_TOTAL_BLOCKS_MAX * 16 + 64, stream_size(stream));
+    stream_rewind(stream);
+    mu_check(nfc_dump_load(stream, &format, test_loaded, &test_source));
+    mu_assert_int_eq(NfcDeviceSaveFormatMifareClassic, format);
+    mu_check(memcmp(test_data, test_loaded, sizeof(NfcDeviceData)) == 0);
+
+    // Dump of changed text file
+    NfcDumpSource changed = test_source;
+    changed.mtime++;
+    stream_rewind(stream);
+    mu_check(!nfc_dump_load(stream, &format, test_loaded, &changed));
+    changed = test_source;
+    changed.size++;
+    stream_rewind(stream);
+    mu_check(!nfc_dump_load(stream, &format, test_loaded, &changed));
+
+    // Damaged block data
+    uint8_t byte = 0;
+    stream_seek(stream, stream_size(stream) / 2, StreamOffsetFromStart);
+    stream_read(stream, &byte, 1);
+    byte ^= 0x80;
+    stream_seek(stream, -1, StreamOffsetFromCurrent);
+    stream_write(stream, &byte, 1);
+    stream_rewind(stream);
+    mu_check(!nfc_dump_load(stream, &format, test_loaded, NULL));
+
+    // DESFire lists are rebuilt
+    nfc_dump_test_fill_mf_df(test_data);
+    stream_clean(stream);
+    mu_check(nfc_dump_save(stream, NfcDeviceSaveFormatMifareDesfire, test_data, NULL));
+    stream_rewind(stream);
+    mu_check(nfc_dump_load(stream, &format, test_loaded, NULL));
+    mu_assert_int_eq(NfcDeviceSaveFormatMifareDesfire, format);
+    MifareDesfireApplication* app = test_loaded->mf_df_data.app_head;
+    mu_check(app && !app->next);
+    mu_check(test_loaded->mf_df_data.master_key_settings);
+    mu_check(!test_loaded->mf_df_data.free_memory);
+    if(app) {
+        mu_assert_int_eq(0xF2, app->id[0]);
+        MifareDesfireFile* data_file = app->file_head;
+        mu_check(data_file && data_file->contents);
+        mu_check(data_file && data_file->contents && data_file->contents[31] == 0xA5);
+        MifareDesfireFile* value_file = data_file ? data_file->next : NULL;
+        mu_check(value_file && !value_file->contents);
+        mu_check(value_file && value_file->settings.value.hi_limit == 1000);
+    }
+    mf_df_clear(&test_loaded->mf_df_data);
+    mf_df_clear(&test_data->mf_df_data);
+
+    stream_free(stream);
+}
+
+static bool nfc_dump_test_edit_text(Storage* storage) {
+    // Flip the first hex digit of the last block, file size stays the same
+    Stream* stream = file_stream_alloc(storage);
+    bool edited = false;
+    string_t line;
+    string_init(line);
+
+    if(file_stream_open(stream, NFC_DUMP_TEST_FILE, FSAM_READ_WRITE, FSOM_OPEN_EXISTING)) {
+        const char* key = "Block 255: ";
+        size_t line_start = 0;
+        while(!edited) {
+            line_start = stream_tell(stream);
+            if(!stream_read_line(stream, line)) break;
+            if(string_start_with_str_p(line, key)) {
+                char digit = string_get_char(line, strlen(key)) == 'A' ? 'B' : 'A';
+                stream_seek(stream, line_start + strlen(key), StreamOffsetFromStart);
+                edited = stream_write_char(stream, digit) == 1;
+            }
+        }
+    }
+
+    string_clear(line);
+    file_stream_close(stream);
+    stream_free(stream);
+    return edited;
+}
+
+MU_TEST(nfc_dump_device_file_test) {
+    Storage* storage = furi_record_open("storage");
+    NfcDevice* dev = nfc_device_alloc();
+
+    // Saving writes text file and its dump
+    dev->format = NfcDeviceSaveFormatMifareClassic;
+    nfc_dump_test_fill_mf_classic(&dev->dev_data);
+    memcpy(test_data, &dev->dev_data, sizeof(NfcDeviceData));
+    mu_check(nfc_device_save(dev, NFC_DUMP_TEST_NAME));
+    mu_check(storage_common_stat(storage, NFC_DUMP_TEST_DUMP_FILE, NULL) == FSE_OK);
+
+    uint32_t start = osKernelGetTickCount();
+    nfc_device_clear(dev);
+    mu_check(nfc_device_load(dev, NFC_DUMP_TEST_FILE));
+    uint32_t dump_ticks = osKernelGetTickCount() - start;
+    mu_check(memcmp(test_data, &dev->dev_data, sizeof(NfcDeviceData)) == 0);
+
+    // Without dump text file is parsed, loading doesn't write
+    mu_check(storage_simply_remove(storage, NFC_DUMP_TEST_DUMP_FILE));
+    start = osKernelGetTickCount();
+    nfc_device_clear(dev);
+    mu_check(nfc_device_load(dev, NFC_DUMP_TEST_FILE));
+    uint32_t text_ticks = osKernelGetTickCount() - start;
+    mu_check(memcmp(test_data, &dev->dev_data, sizeof(NfcDeviceData)) == 0);
+    mu_check(storage_common_stat(storage, NFC_DUMP_TEST_DUMP_FILE, NULL) == FSE_NOT_EXIST);
+    FURI_LOG_I(TAG, "Mifare Classic 4K load: text %lu, dump %lu ticks", text_ticks, dump_ticks);
+
+    // Edited text file of the same size wins over its old dump
+    mu_check(nfc_device_save(dev, NFC_DUMP_TEST_NAME));
+    mu_check(storage_common_stat(storage, NFC_DUMP_TEST_DUMP_FILE, NULL) == FSE_OK);
+    osDelay(NFC_DUMP_TEST_MTIME_STEP_MS);
+    mu_check(nfc_dump_test_edit_text(storage));
+    nfc_device_clear(dev);
+    mu_check(nfc_device_load(dev, NFC_DUMP_TEST_FILE));
+    MfClassicData* mf_classic = &dev->dev_data.mf_classic_data;
+    mu_check(mf_classic->block[255].value[0] != test_data->mf_classic_data.block[255].value[0]);
+
+    mu_check(nfc_device_delete(dev));
+    mu_check(storage_common_stat(storage, NFC_DUMP_TEST_FILE, NULL) == FSE_NOT_EXIST);
+    mu_check(storage_common_stat(storage, NFC_DUMP_TEST_DUMP_FILE, NULL) == FSE_NOT_EXIST);
+
+    nfc_device_free(dev);
+    furi_record_close("storage");
+}
+
+MU_TEST_SUITE(nfc_dump_suite) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(nfc_dump_round_trip_test);
+    MU_RUN_TEST(nfc_dump_device_file_test);
+}
+
+int run_minunit_test_nfc_dump() {
+    MU_RUN_SUITE(nfc_dump_suite);
+    return MU_EXIT_CODE;
+}
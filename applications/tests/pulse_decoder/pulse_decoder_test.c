@@ -0,0 +1,173 @@
+#include <furi.h>
+#include <one_wire/pulse_protocols/pulse_decoder.h>
+#include <one_wire/ibutton/pulse_protocols/protocol_cyfral.h>
+#include <one_wire/ibutton/pulse_protocols/protocol_metakom.h>
+#include <one_wire/ibutton/encoder/encoder_cyfral.h>
+#include "../minunit.h"
+
+#define PULSE_DECODER_TEST_MAX_PULSES 1000
+
+typedef enum {
+    PulseDecoderTestCyfral = 0,
+    PulseDecoderTestMetakom = 1,
+    PulseDecoderTestProbeA = 6,
+    PulseDecoderTestProbeB = 9,
+} PulseDecoderTestIndex;
+
+typedef struct {
+    PulseProtocol* protocol;
+    uint32_t timings[2];
+    uint8_t last_timing;
+} PulseDecoderTestProbe;
+
+static PulseDecoder* decoder;
+static ProtocolCyfral* cyfral;
+static ProtocolMetakom* metakom;
+
+static bool probe_symbol(void* context, const PulseSymbol* symbol) {
+    PulseDecoderTestProbe* probe = context;
+    probe->last_timing = symbol->timing;
+    return false;
+}
+
+static void probe_init(PulseDecoderTestProbe* probe, uint32_t low, uint32_t high) {
+    probe->timings[0] = low;
+    probe->timings[1] = high;
+    probe->last_timing = 0xFF;
+    probe->protocol = pulse_protocol_alloc();
+    pulse_protocol_set_context(probe->protocol, probe);
+    pulse_protocol_set_symbol_cb(probe->protocol, probe_symbol);
+    pulse_protocol_set_timings(probe->protocol, probe->timings, COUNT_OF(probe->timings));
+}
+
+static void test_setup(void) {
+    decoder = pulse_decoder_alloc();
+    cyfral = protocol_cyfral_alloc();
+    metakom = protocol_metakom_alloc();
+    pulse_decoder_add_protocol(
+        decoder, protocol_cyfral_get_protocol(cyfral), PulseDecoderTestCyfral);
+    pulse_decoder_add_protocol(
+        decoder, protocol_metakom_get_protocol(metakom), PulseDecoderTestMetakom);
+}
+
+static void test_teardown(void) {
+    pulse_decoder_free(decoder);
+    protocol_metakom_free(metakom);
+    protocol_cyfral_free(cyfral);
+}
+
+MU_TEST(pulse_decoder_cyfral_test) {
+    const uint8_t key[2] = {0x3A, 0xC5};
+    uint8_t data[4] = {0};
+
+    EncoderCyfral* encoder = encoder_cyfral_alloc();
+    encoder_cyfral_set_data(encoder, key, sizeof(key));
+    pulse_decoder_reset(decoder);
+
+    bool polarity;
+    uint32_t length;
+    for(size_t i = 0; i < PULSE_DECODER_TEST_MAX_PULSES; i++) {
+        encoder_cyfral_get_pulse(encoder, &polarity, &length);
+        pulse_decoder_process_pulse(decoder, polarity, length);
+        if(pulse_decoder_get_decoded_index(decoder) >= 0) break;
+    }
+    encoder_cyfral_free(encoder);
+
+    mu_assert_int_eq(PulseDecoderTestCyfral, pulse_decoder_get_decoded_index(decoder));
+    pulse_decoder_get_data(decoder, PulseDecoderTestCyfral, data, sizeof(data));
+    mu_check(memcmp(key, data, sizeof(key)) == 0);
+}
+
+// Metakom trace with 125us bit period at 64MHz, low then high level per bit
+#define METAKOM_TEST_PERIOD 8000
+#define METAKOM_TEST_SHORT (METAKOM_TEST_PERIOD / 3)
+#define METAKOM_TEST_LONG (METAKOM_TEST_PERIOD - METAKOM_TEST_SHORT)
+#define METAKOM_TEST_SYNC (METAKOM_TEST_PERIOD * 3 / 2)
+
+static void metakom_test_bit(uint32_t low, uint32_t high) {
+    pulse_decoder_process_pulse(decoder, true, low);
+    pulse_decoder_process_pulse(decoder, false, high);
+}
+
+static void metakom_test_value(bool value) {
+    if(value) {
+        metakom_test_bit(METAKOM_TEST_LONG, METAKOM_TEST_SHORT);
+    } else {
+        metakom_test_bit(METAKOM_TEST_SHORT, METAKOM_TEST_LONG);
+    }
+}
+
+MU_TEST(pulse_decoder_metakom_test) {
+    // every byte has even parity
+    const uint8_t key[4] = {0x12, 0x33, 0xA5, 0xC3};
+    const uint32_t expected = (key[0] << 24) | (key[1] << 16) | (key[2] << 8) | key[3];
+    uint8_t data[4] = {0};
+
+    pulse_decoder_reset(decoder);
+
+    // period sync, start bit and start word
+    for(size_t i = 0; i < 10; i++) metakom_test_value(false);
+    metakom_test_bit(METAKOM_TEST_SHORT, METAKOM_TEST_SYNC);
+    metakom_test_value(false);
+    metakom_test_value(true);
+    metakom_test_value(false);
+
+    // data, the last bit carries the stop bit
+    for(size_t byte = 0; byte < 4; byte++) {
+        for(int8_t bit = 7; bit >= 0; bit--) {
+            bool value = (key[byte] >> bit) & 1;
+            if(byte == 3 && bit == 0) {
+                metakom_test_bit(value ? METAKOM_TEST_LONG : METAKOM_TEST_SHORT, METAKOM_TEST_SYNC);
+            } else {
+                metakom_test_value(value);
+            }
+        }
+    }
+
+    // stop word
+    metakom_test_value(false);
+    metakom_test_value(true);
+    metakom_test_value(false);
+
+    mu_assert_int_eq(PulseDecoderTestMetakom, pulse_decoder_get_decoded_index(decoder));
+    pulse_decoder_get_data(decoder, PulseDecoderTestMetakom, data, sizeof(data));
+    mu_check(memcmp(&expected, data, sizeof(expected)) == 0);
+}
+
+MU_TEST(pulse_decoder_timing_test) {
+    PulseDecoderTestProbe probe_a;
+    PulseDecoderTestProbe probe_b;
+    probe_init(&probe_a, 100, 300);
+    probe_init(&probe_b, 200, 300);
+
+    // indexes beyond the former fixed protocol table
+    pulse_decoder_add_protocol(decoder, probe_a.protocol, PulseDecoderTestProbeA);
+    pulse_decoder_add_protocol(decoder, probe_b.protocol, PulseDecoderTestProbeB);
+
+    const uint32_t periods[] = {50, 100, 150, 200, 250, 300, 350};
+    const uint8_t expected_a[] = {0, 0, 1, 1, 1, 1, 2};
+    const uint8_t expected_b[] = {0, 0, 0, 0, 1, 1, 2};
+
+    for(size_t i = 0; i < COUNT_OF(periods); i++) {
+        pulse_decoder_reset(decoder);
+        pulse_decoder_process_pulse(decoder, true, periods[i]);
+        mu_assert_int_eq(expected_a[i], probe_a.last_timing);
+        mu_assert_int_eq(expected_b[i], probe_b.last_timing);
+    }
+
+    pulse_protocol_free(probe_a.protocol);
+    pulse_protocol_free(probe_b.protocol);
+}
+
+MU_TEST_SUITE(pulse_decoder_suite) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(pulse_decoder_cyfral_test);
+    MU_RUN_TEST(pulse_decoder_metakom_test);
+    MU_RUN_TEST(pulse_decoder_timing_test);
+}
+
+int run_minunit_test_pulse_decoder() {
+    MU_RUN_SUITE(pulse_decoder_suite);
+    return MU_EXIT_CODE;
+}
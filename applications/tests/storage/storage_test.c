@@ -1,8 +1,10 @@
 #include "../minunit.h"
 #include <furi.h>
-#include <furi_hal_delay.h>
+#include <furi_hal.h>
 #include <storage/storage.h>
 
+#define TAG "UnitTestsStorage"
+
 #define STORAGE_LOCKED_FILE "/ext/locked_file.test"
 #define STORAGE_LOCKED_DIR "/int"
 
@@ -88,10 +90,311 @@ MU_TEST(storage_file_open_close) {
     furi_record_close("storage");
 }
 
+#define STORAGE_CONCURRENT_FILE "/ext/concurrent_%d.test"
+#define STORAGE_CONCURRENT_WORKERS 3
+#define STORAGE_CONCURRENT_CHUNK 64
+#define STORAGE_CONCURRENT_CHUNKS 32
+
+typedef struct {
+    FuriThread* thread;
+    uint8_t index;
+    int32_t errors;
+} StorageConcurrentWorker;
+
+static int32_t storage_file_concurrent_worker(void* ctx) {
+    StorageConcurrentWorker* worker = ctx;
+    uint8_t index = worker->index;
+    Storage* storage = furi_record_open("storage");
+    File* file = storage_file_alloc(storage);
+    uint8_t chunk[STORAGE_CONCURRENT_CHUNK];
+    char path[32];
+    int32_t errors = 0;
+
+    snprintf(path, sizeof(path), STORAGE_CONCURRENT_FILE, index);
+    memset(chunk, 0, sizeof(chunk));
+    // Half of workers go through storage thread, half call FS directly
+    if(index % 2) storage_file_enable_direct(file);
+
+    // Interleaved small writes and reads from several threads share storage lock
+    if(storage_file_open(file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        for(size_t i = 0; i < STORAGE_CONCURRENT_CHUNKS; i++) {
+            memset(chunk, index + i, sizeof(chunk));
+            if(storage_file_write(file, chunk, sizeof(chunk)) != sizeof(chunk)) errors++;
+        }
+        if(!storage_file_seek(file, 0, true)) errors++;
+        for(size_t i = 0; i < STORAGE_CONCURRENT_CHUNKS; i++) {
+            if(storage_file_read(file, chunk, sizeof(chunk)) != sizeof(chunk)) errors++;
+            for(size_t j = 0; j < sizeof(chunk); j++) {
+                if(chunk[j] != (uint8_t)(index + i)) {
+                    errors++;
+                    break;
+                }
+            }
+        }
+        if(!storage_file_eof(file)) errors++;
+    } else {
+        errors++;
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+    storage_simply_remove(storage, path);
+    furi_record_close("storage");
+    worker->errors = errors;
+    return 0;
+}
+
+MU_TEST(storage_file_concurrent) {
+    StorageConcurrentWorker workers[STORAGE_CONCURRENT_WORKERS];
+
+    for(size_t i = 0; i < STORAGE_CONCURRENT_WORKERS; i++) {
+        workers[i].index = i;
+        workers[i].errors = -1;
+        workers[i].thread = furi_thread_alloc();
+        furi_thread_set_name(workers[i].thread, "StorageWorker");
+        furi_thread_set_stack_size(workers[i].thread, 2048);
+        furi_thread_set_context(workers[i].thread, &workers[i]);
+        furi_thread_set_callback(workers[i].thread, storage_file_concurrent_worker);
+        mu_check(furi_thread_start(workers[i].thread));
+    }
+
+    for(size_t i = 0; i < STORAGE_CONCURRENT_WORKERS; i++) {
+        mu_check(furi_thread_join(workers[i].thread) == osOK);
+        furi_thread_free(workers[i].thread);
+        mu_assert_int_eq(0, workers[i].errors);
+    }
+}
+
+#define STORAGE_STACK_FILE "%s/stack_depth.test"
+#define STORAGE_STACK_SIZE 2048
+/** Direct access is meant for 2048 byte stacks, see storage_file_enable_direct */
+#define STORAGE_STACK_MARGIN 512
+#define STORAGE_STACK_CHUNK 512
+#define STORAGE_STACK_CHUNKS 16
+
+typedef struct {
+    const char* root;
+    uint32_t used;
+    int32_t errors;
+} StorageStackProbe;
+
+/* Opened file calls run FS code on caller stack: write over several clusters, seek, read */
+static int32_t storage_file_stack_worker(void* ctx) {
+    StorageStackProbe* probe = ctx;
+    Storage* storage = furi_record_open("storage");
+    File* file = storage_file_alloc(storage);
+    storage_file_enable_direct(file);
+    // Off stack, so that only FS call depth is measured
+    uint8_t* chunk = malloc(STORAGE_STACK_CHUNK);
+    char path[32];
+    int32_t errors = 0;
+
+    snprintf(path, sizeof(path), STORAGE_STACK_FILE, probe->root);
+    if(storage_file_open(file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        for(size_t i = 0; i < STORAGE_STACK_CHUNKS; i++) {
+            memset(chunk, i, STORAGE_STACK_CHUNK);
+            if(storage_file_write(file, chunk, STORAGE_STACK_CHUNK) != STORAGE_STACK_CHUNK) {
+                errors++;
+            }
+        }
+        if(!storage_file_sync(file)) errors++;
+        if(!storage_file_seek(file, STORAGE_STACK_CHUNK * STORAGE_STACK_CHUNKS / 2, true)) {
+            errors++;
+        }
+        if(storage_file_read(file, chunk, STORAGE_STACK_CHUNK) != STORAGE_STACK_CHUNK) errors++;
+        if(chunk[0] != STORAGE_STACK_CHUNKS / 2) errors++;
+        if(!storage_file_seek(file, 0, true)) errors++;
+        if(!storage_file_truncate(file)) errors++;
+        if(storage_file_size(file) != 0) errors++;
+    } else {
+        errors++;
+    }
+    probe->used = STORAGE_STACK_SIZE - osThreadGetStackSpace(osThreadGetId());
+
+    storage_file_close(file);
+    storage_file_free(file);
+    storage_simply_remove(storage, path);
+    furi_record_close("storage");
+    free(chunk);
+    probe->errors = errors;
+    return 0;
+}
+
+MU_TEST(storage_file_stack_depth) {
+    StorageStackProbe probes[] = {{.root = "/int"}, {.root = "/ext"}};
+
+    for(size_t i = 0; i < COUNT_OF(probes); i++) {
+        FuriThread* thread = furi_thread_alloc();
+        furi_thread_set_name(thread, "StorageStackProbe");
+        furi_thread_set_stack_size(thread, STORAGE_STACK_SIZE);
+        furi_thread_set_context(thread, &probes[i]);
+        furi_thread_set_callback(thread, storage_file_stack_worker);
+        mu_check(furi_thread_start(thread));
+        mu_check(furi_thread_join(thread) == osOK);
+        furi_thread_free(thread);
+
+        FURI_LOG_I(TAG, "%s read/write/seek stack: %lu bytes", probes[i].root, probes[i].used);
+        mu_assert_int_eq(0, probes[i].errors);
+        mu_check(probes[i].used + STORAGE_STACK_MARGIN <= STORAGE_STACK_SIZE);
+    }
+}
+
+#define STORAGE_CONTENTION_FILE "/ext/contention_%d.test"
+#define STORAGE_CONTENTION_READ_CHUNK 512
+#define STORAGE_CONTENTION_READ_SIZE (16 * 1024)
+#define STORAGE_CONTENTION_APPEND_CHUNK 64
+#define STORAGE_CONTENTION_OPS 256
+
+typedef enum {
+    StorageContentionReader, /**< RPC alike: big reads of one file, rewinds on end */
+    StorageContentionAppender, /**< Sub-GHz capture alike: small appends */
+    StorageContentionBrowser, /**< Archive alike: stat and directory listing */
+    StorageContentionMAX,
+} StorageContentionRole;
+
+static const char* storage_contention_role_names[StorageContentionMAX] = {
+    "reader",
+    "appender",
+    "browser",
+};
+
+typedef struct {
+    FuriThread* thread;
+    StorageContentionRole role;
+    uint32_t total_us;
+    uint32_t max_us;
+    int32_t errors;
+} StorageContentionWorker;
+
+static bool storage_contention_op(
+    StorageContentionWorker* worker,
+    Storage* storage,
+    File* file,
+    uint8_t* chunk) {
+    bool ok = false;
+    char path[32];
+    FileInfo info;
+
+    switch(worker->role) {
+    case StorageContentionReader:
+        if(storage_file_eof(file)) storage_file_seek(file, 0, true);
+        ok = storage_file_read(file, chunk, STORAGE_CONTENTION_READ_CHUNK) ==
+             STORAGE_CONTENTION_READ_CHUNK;
+        break;
+    case StorageContentionAppender:
+        ok = storage_file_write(file, chunk, STORAGE_CONTENTION_APPEND_CHUNK) ==
+             STORAGE_CONTENTION_APPEND_CHUNK;
+        break;
+    default:
+        snprintf(path, sizeof(path), STORAGE_CONTENTION_FILE, StorageContentionReader);
+        ok = storage_common_stat(storage, path, &info) == FSE_OK;
+        ok &= storage_dir_read(file, &info, NULL, 0);
+        if(!ok) {
+            storage_dir_rewind(file);
+            ok = storage_dir_read(file, &info, NULL, 0);
+        }
+        break;
+    }
+
+    return ok;
+}
+
+static int32_t storage_contention_worker(void* ctx) {
+    StorageContentionWorker* worker = ctx;
+    Storage* storage = furi_record_open("storage");
+    File* file = storage_file_alloc(storage);
+    uint8_t* chunk = malloc(STORAGE_CONTENTION_READ_CHUNK);
+    char path[32];
+    bool opened;
+
+    snprintf(path, sizeof(path), STORAGE_CONTENTION_FILE, worker->role);
+    storage_file_enable_direct(file);
+    if(worker->role == StorageContentionReader) {
+        opened = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    } else if(worker->role == StorageContentionAppender) {
+        opened = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    } else {
+        opened = storage_dir_open(file, "/ext");
+    }
+
+    worker->errors = opened ? 0 : 1;
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    for(size_t i = 0; i < STORAGE_CONTENTION_OPS && opened; i++) {
+        uint32_t start = DWT->CYCCNT;
+        if(!storage_contention_op(worker, storage, file, chunk)) worker->errors++;
+        uint32_t op_us = (DWT->CYCCNT - start) / cycles_per_us;
+        worker->total_us += op_us;
+        worker->max_us = MAX(worker->max_us, op_us);
+    }
+
+    if(worker->role == StorageContentionBrowser) {
+        storage_dir_close(file);
+    } else {
+        storage_file_close(file);
+    }
+    if(worker->role == StorageContentionAppender) storage_simply_remove(storage, path);
+    storage_file_free(file);
+    furi_record_close("storage");
+    free(chunk);
+    return 0;
+}
+
+/* Three clients at once: reports per operation latency of each, direct calls share lock */
+MU_TEST(storage_file_contention) {
+    Storage* storage = furi_record_open("storage");
+    char path[32];
+    snprintf(path, sizeof(path), STORAGE_CONTENTION_FILE, StorageContentionReader);
+    File* file = storage_file_alloc(storage);
+    uint8_t* chunk = malloc(STORAGE_CONTENTION_READ_CHUNK);
+    memset(chunk, 0xA5, STORAGE_CONTENTION_READ_CHUNK);
+    mu_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < STORAGE_CONTENTION_READ_SIZE / STORAGE_CONTENTION_READ_CHUNK; i++) {
+        storage_file_write(file, chunk, STORAGE_CONTENTION_READ_CHUNK);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    free(chunk);
+
+    StorageContentionWorker workers[StorageContentionMAX] = {0};
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < StorageContentionMAX; i++) {
+        workers[i].role = i;
+        workers[i].thread = furi_thread_alloc();
+        furi_thread_set_name(workers[i].thread, "StorageContention");
+        furi_thread_set_stack_size(workers[i].thread, 2048);
+        furi_thread_set_context(workers[i].thread, &workers[i]);
+        furi_thread_set_callback(workers[i].thread, storage_contention_worker);
+        mu_check(furi_thread_start(workers[i].thread));
+    }
+
+    for(size_t i = 0; i < StorageContentionMAX; i++) {
+        mu_check(furi_thread_join(workers[i].thread) == osOK);
+        furi_thread_free(workers[i].thread);
+    }
+    uint32_t total_ms = (DWT->CYCCNT - start) / (SystemCoreClock / 1000);
+
+    FURI_LOG_I(TAG, "Contention: %lu ms for %d ops each", total_ms, STORAGE_CONTENTION_OPS);
+    for(size_t i = 0; i < StorageContentionMAX; i++) {
+        FURI_LOG_I(
+            TAG,
+            "\t%s: avg %lu us, max %lu us",
+            storage_contention_role_names[i],
+            workers[i].total_us / STORAGE_CONTENTION_OPS,
+            workers[i].max_us);
+        mu_assert_int_eq(0, workers[i].errors);
+    }
+
+    storage_simply_remove(storage, path);
+    furi_record_close("storage");
+}
+
 MU_TEST_SUITE(storage_file) {
     storage_file_open_lock_setup();
     MU_RUN_TEST(storage_file_open_close);
     MU_RUN_TEST(storage_file_open_lock);
+    MU_RUN_TEST(storage_file_concurrent);
+    MU_RUN_TEST(storage_file_stack_depth);
+    MU_RUN_TEST(storage_file_contention);
     storage_file_open_lock_teardown();
 }
 
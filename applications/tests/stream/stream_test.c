@@ -2,9 +2,12 @@
 #include <toolbox/stream/stream.h>
 #include <toolbox/stream/string_stream.h>
 #include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/compress_stream.h>
 #include <storage/storage.h>
 #include "../minunit.h"
 
+#define TAG "UnitTestsStream"
+
 static const char* stream_test_data = "I write differently from what I speak, "
                                       "I speak differently from what I think, "
                                       "I think differently from the way I ought to think, "
@@ -369,10 +372,138 @@ MU_TEST(stream_split_test) {
     furi_record_close("storage");
 }
 
+MU_TEST_1(stream_compress_subtest, Stream* base) {
+    const size_t data_size = strlen(stream_test_data);
+    const size_t repeat = 16;
+    uint8_t data[256] = {0};
+    Stream* encoder = compress_stream_alloc(CompressStreamModeEncode, 8, 4);
+    Stream* decoder = compress_stream_alloc(CompressStreamModeDecode, 8, 4);
+
+    // compress repeated text
+    compress_stream_attach(encoder, base);
+    for(size_t i = 0; i < repeat; i++) {
+        mu_assert_int_eq(data_size, stream_write_cstring(encoder, stream_test_data));
+    }
+    mu_check(compress_stream_finish(encoder));
+    mu_assert_int_eq(data_size * repeat, stream_size(encoder));
+    mu_check(stream_read(encoder, data, 1) == 0);
+    mu_check(stream_size(base) < data_size * repeat / 4);
+
+    // decompress in portions not aligned to written ones
+    mu_check(stream_rewind(base));
+    compress_stream_attach(decoder, base);
+    for(size_t i = 0; i < repeat; i++) {
+        memset(data, 0, sizeof(data));
+        mu_assert_int_eq(7, stream_read(decoder, data, 7));
+        mu_assert_int_eq(data_size - 7, stream_read(decoder, &data[7], data_size - 7));
+        mu_assert_string_eq(stream_test_data, (const char*)data);
+    }
+    mu_check(stream_read(decoder, data, 1) == 0);
+    mu_check(stream_eof(decoder));
+    mu_assert_int_eq(data_size * repeat, stream_tell(decoder));
+
+    // seek backward decodes again from the start, forward seek skips data
+    memset(data, 0, sizeof(data));
+    mu_check(stream_seek(decoder, data_size + 2, StreamOffsetFromStart));
+    mu_assert_int_eq(8, stream_read(decoder, data, 8));
+    mu_check(memcmp(data, &stream_test_data[2], 8) == 0);
+    mu_check(stream_seek(decoder, data_size - 10, StreamOffsetFromCurrent));
+    mu_assert_int_eq(8, stream_read(decoder, data, 8));
+    mu_check(memcmp(data, stream_test_data, 8) == 0);
+    mu_check(!stream_seek(decoder, 0, StreamOffsetFromEnd));
+
+    // buffers are reused on attach
+    stream_clean(base);
+    compress_stream_attach(encoder, base);
+    mu_assert_int_eq(
+        strlen(stream_test_left_data), stream_write_cstring(encoder, stream_test_left_data));
+    mu_check(compress_stream_finish(encoder));
+    mu_check(stream_write_cstring(encoder, stream_test_right_data) == 0);
+
+    memset(data, 0, sizeof(data));
+    mu_check(stream_rewind(base));
+    compress_stream_attach(decoder, base);
+    mu_assert_int_eq(strlen(stream_test_left_data), stream_read(decoder, data, sizeof(data)));
+    mu_assert_string_eq(stream_test_left_data, (const char*)data);
+
+    stream_free(encoder);
+    stream_free(decoder);
+}
+
+MU_TEST(stream_compress_test) {
+    // test string stream
+    Stream* stream;
+    stream = string_stream_alloc();
+    MU_RUN_TEST_1(stream_compress_subtest, stream);
+    stream_free(stream);
+
+    // test file stream
+    Storage* storage = furi_record_open("storage");
+    stream = file_stream_alloc(storage);
+    mu_check(file_stream_open(stream, "/ext/filestream.str", FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    MU_RUN_TEST_1(stream_compress_subtest, stream);
+    stream_free(stream);
+    furi_record_close("storage");
+}
+
+MU_TEST(stream_compress_throughput_test) {
+    const size_t block_size = 256;
+    const size_t block_count = 128;
+    uint8_t* block = malloc(block_size);
+    uint8_t* check = malloc(block_size);
+
+    // raw recording alike data: repeated durations with noise
+    for(size_t i = 0; i < block_size; i++) {
+        block[i] = (i % 4 < 2) ? (uint8_t)(i * 7) : (uint8_t)(0x30 + i % 3);
+    }
+
+    Storage* storage = furi_record_open("storage");
+    Stream* file = file_stream_alloc(storage);
+    Stream* encoder = compress_stream_alloc(CompressStreamModeEncode, 8, 4);
+    Stream* decoder = compress_stream_alloc(CompressStreamModeDecode, 8, 4);
+    mu_check(file_stream_open(file, "/ext/filestream.str", FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+
+    uint32_t start = osKernelGetTickCount();
+    compress_stream_attach(encoder, file);
+    for(size_t i = 0; i < block_count; i++) {
+        mu_assert_int_eq(block_size, stream_write(encoder, block, block_size));
+    }
+    mu_check(compress_stream_finish(encoder));
+    uint32_t encode_time = osKernelGetTickCount() - start;
+
+    start = osKernelGetTickCount();
+    mu_check(stream_rewind(file));
+    compress_stream_attach(decoder, file);
+    bool equal = true;
+    for(size_t i = 0; i < block_count; i++) {
+        mu_assert_int_eq(block_size, stream_read(decoder, check, block_size));
+        equal &= (memcmp(block, check, block_size) == 0);
+    }
+    mu_check(equal);
+    uint32_t decode_time = osKernelGetTickCount() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "%u bytes to %u, encode %lu ms, decode %lu ms",
+        block_size * block_count,
+        stream_size(file),
+        encode_time,
+        decode_time);
+
+    stream_free(encoder);
+    stream_free(decoder);
+    stream_free(file);
+    furi_record_close("storage");
+    free(block);
+    free(check);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
+    MU_RUN_TEST(stream_compress_test);
+    MU_RUN_TEST(stream_compress_throughput_test);
 }
 
 int run_minunit_test_stream() {
@@ -17,6 +17,10 @@ int run_minunit_test_flipper_format();
 int run_minunit_test_flipper_format_string();
 int run_minunit_test_stream();
 int run_minunit_test_storage();
+int run_minunit_test_pulse_decoder();
+int run_minunit_test_bt_rpc_tx();
+int run_minunit_test_nfc_dump();
+int run_minunit_test_gui_frame();
 
 void minunit_print_progress(void) {
     static char progress[] = {'\\', '|', '/', '-'};
@@ -60,6 +64,10 @@ void unit_tests_cli(Cli* cli, string_t args, void* context) {
         test_result |= run_minunit_test_flipper_format_string();
         test_result |= run_minunit_test_infrared_decoder_encoder();
         test_result |= run_minunit_test_rpc();
+        test_result |= run_minunit_test_pulse_decoder();
+        test_result |= run_minunit_test_bt_rpc_tx();
+        test_result |= run_minunit_test_nfc_dump();
+        test_result |= run_minunit_test_gui_frame();
         cycle_counter = (DWT->CYCCNT - cycle_counter);
 
         FURI_LOG_I(TAG, "Consumed: %0.2fs", (float)cycle_counter / (SystemCoreClock));
@@ -15,4 +15,10 @@ PB_BIND(PB_App_LockStatusRequest, PB_App_LockStatusRequest, AUTO)
 PB_BIND(PB_App_LockStatusResponse, PB_App_LockStatusResponse, AUTO)
 
 
+PB_BIND(PB_App_StatsRequest, PB_App_StatsRequest, AUTO)
+
+
+PB_BIND(PB_App_StatsResponse, PB_App_StatsResponse, AUTO)
+
+
 
@@ -19,10 +19,25 @@ typedef struct _PB_App_StartRequest {
     char *args; 
 } PB_App_StartRequest;
 
+typedef struct _PB_App_StatsResponse { 
+    char *name; 
+    uint32_t runs; 
+    uint32_t run_time; /* *< Last run, ms */
+    uint32_t run_time_total; /* *< All runs, ms */
+    uint32_t stack_size; 
+    uint32_t stack_peak; 
+    uint32_t heap_peak; 
+    uint32_t heap_live; /* *< Left allocated after last run */
+} PB_App_StatsResponse;
+
 typedef struct _PB_App_LockStatusResponse { 
     bool locked; 
 } PB_App_LockStatusResponse;
 
+typedef struct _PB_App_StatsRequest { 
+    bool reset; 
+} PB_App_StatsRequest;
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,14 +47,27 @@ extern "C" {
 #define PB_App_StartRequest_init_default         {NULL, NULL}
 #define PB_App_LockStatusRequest_init_default    {0}
 #define PB_App_LockStatusResponse_init_default   {0}
+#define PB_App_StatsRequest_init_default         {0}
+#define PB_App_StatsResponse_init_default        {NULL, 0, 0, 0, 0, 0, 0, 0}
 #define PB_App_StartRequest_init_zero            {NULL, NULL}
 #define PB_App_LockStatusRequest_init_zero       {0}
 #define PB_App_LockStatusResponse_init_zero      {0}
+#define PB_App_StatsRequest_init_zero            {0}
+#define PB_App_StatsResponse_init_zero           {NULL, 0, 0, 0, 0, 0, 0, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define PB_App_StartRequest_name_tag             1
 #define PB_App_StartRequest_args_tag             2
+#define PB_App_StatsResponse_name_tag            1
+#define PB_App_StatsResponse_runs_tag            2
+#define PB_App_StatsResponse_run_time_tag        3
+#define PB_App_StatsResponse_run_time_total_tag  4
+#define PB_App_StatsResponse_stack_size_tag      5
+#define PB_App_StatsResponse_stack_peak_tag      6
+#define PB_App_StatsResponse_heap_peak_tag       7
+#define PB_App_StatsResponse_heap_live_tag       8
 #define PB_App_LockStatusResponse_locked_tag     1
+#define PB_App_StatsRequest_reset_tag            1
 
 /* Struct field encoding specification for nanopb */
 #define PB_App_StartRequest_FIELDLIST(X, a) \
@@ -58,19 +86,42 @@ X(a, STATIC,   SINGULAR, BOOL,     locked,            1)
 #define PB_App_LockStatusResponse_CALLBACK NULL
 #define PB_App_LockStatusResponse_DEFAULT NULL
 
+#define PB_App_StatsRequest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, BOOL,     reset,             1)
+#define PB_App_StatsRequest_CALLBACK NULL
+#define PB_App_StatsRequest_DEFAULT NULL
+
+#define PB_App_StatsResponse_FIELDLIST(X, a) \
+X(a, POINTER,  SINGULAR, STRING,   name,              1) \
+X(a, STATIC,   SINGULAR, UINT32,   runs,              2) \
+X(a, STATIC,   SINGULAR, UINT32,   run_time,          3) \
+X(a, STATIC,   SINGULAR, UINT32,   run_time_total,    4) \
+X(a, STATIC,   SINGULAR, UINT32,   stack_size,        5) \
+X(a, STATIC,   SINGULAR, UINT32,   stack_peak,        6) \
+X(a, STATIC,   SINGULAR, UINT32,   heap_peak,         7) \
+X(a, STATIC,   SINGULAR, UINT32,   heap_live,         8)
+#define PB_App_StatsResponse_CALLBACK NULL
+#define PB_App_StatsResponse_DEFAULT NULL
+
 extern const pb_msgdesc_t PB_App_StartRequest_msg;
 extern const pb_msgdesc_t PB_App_LockStatusRequest_msg;
 extern const pb_msgdesc_t PB_App_LockStatusResponse_msg;
+extern const pb_msgdesc_t PB_App_StatsRequest_msg;
+extern const pb_msgdesc_t PB_App_StatsResponse_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define PB_App_StartRequest_fields &PB_App_StartRequest_msg
 #define PB_App_LockStatusRequest_fields &PB_App_LockStatusRequest_msg
 #define PB_App_LockStatusResponse_fields &PB_App_LockStatusResponse_msg
+#define PB_App_StatsRequest_fields &PB_App_StatsRequest_msg
+#define PB_App_StatsResponse_fields &PB_App_StatsResponse_msg
 
 /* Maximum encoded size of messages (where known) */
 /* PB_App_StartRequest_size depends on runtime parameters */
+/* PB_App_StatsResponse_size depends on runtime parameters */
 #define PB_App_LockStatusRequest_size            0
 #define PB_App_LockStatusResponse_size           2
+#define PB_App_StatsRequest_size                 2
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -103,6 +103,12 @@ typedef struct _PB_Main {
         PB_Storage_BackupRestoreRequest storage_backup_restore_request;
         PB_System_PowerInfoRequest system_power_info_request;
         PB_System_PowerInfoResponse system_power_info_response;
+        PB_System_ProfilerRequest system_profiler_request;
+        PB_System_ProfilerResponse system_profiler_response;
+        PB_System_TraceRequest system_trace_request;
+        PB_System_TraceResponse system_trace_response;
+        PB_App_StatsRequest app_stats_request;
+        PB_App_StatsResponse app_stats_response;
     } content; 
 } PB_Main;
 
@@ -171,6 +177,12 @@ extern "C" {
 #define PB_Main_storage_backup_restore_request_tag 43
 #define PB_Main_system_power_info_request_tag    44
 #define PB_Main_system_power_info_response_tag   45
+#define PB_Main_system_profiler_request_tag      46
+#define PB_Main_system_profiler_response_tag     47
+#define PB_Main_system_trace_request_tag         48
+#define PB_Main_system_trace_response_tag        49
+#define PB_Main_app_stats_request_tag            50
+#define PB_Main_app_stats_response_tag           51
 
 /* Struct field encoding specification for nanopb */
 #define PB_Empty_FIELDLIST(X, a) \
@@ -228,7 +240,13 @@ X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_update_request,content.system
 X(a, STATIC,   ONEOF,    MSG_W_CB, (content,storage_backup_create_request,content.storage_backup_create_request),  42) \
 X(a, STATIC,   ONEOF,    MSG_W_CB, (content,storage_backup_restore_request,content.storage_backup_restore_request),  43) \
 X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_power_info_request,content.system_power_info_request),  44) \
-X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_power_info_response,content.system_power_info_response),  45)
+X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_power_info_response,content.system_power_info_response),  45) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_profiler_request,content.system_profiler_request),  46) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_profiler_response,content.system_profiler_response),  47) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_trace_request,content.system_trace_request),  48) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_trace_response,content.system_trace_response),  49) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (content,app_stats_request,content.app_stats_request),  50) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (content,app_stats_response,content.app_stats_response),  51)
 #define PB_Main_CALLBACK NULL
 #define PB_Main_DEFAULT NULL
 #define PB_Main_content_empty_MSGTYPE PB_Empty
@@ -273,6 +291,12 @@ X(a, STATIC,   ONEOF,    MSG_W_CB, (content,system_power_info_response,content.s
 #define PB_Main_content_storage_backup_restore_request_MSGTYPE PB_Storage_BackupRestoreRequest
 #define PB_Main_content_system_power_info_request_MSGTYPE PB_System_PowerInfoRequest
 #define PB_Main_content_system_power_info_response_MSGTYPE PB_System_PowerInfoResponse
+#define PB_Main_content_system_profiler_request_MSGTYPE PB_System_ProfilerRequest
+#define PB_Main_content_system_profiler_response_MSGTYPE PB_System_ProfilerResponse
+#define PB_Main_content_system_trace_request_MSGTYPE PB_System_TraceRequest
+#define PB_Main_content_system_trace_response_MSGTYPE PB_System_TraceResponse
+#define PB_Main_content_app_stats_request_MSGTYPE PB_App_StatsRequest
+#define PB_Main_content_app_stats_response_MSGTYPE PB_App_StatsResponse
 
 extern const pb_msgdesc_t PB_Empty_msg;
 extern const pb_msgdesc_t PB_StopSession_msg;
@@ -286,9 +310,9 @@ extern const pb_msgdesc_t PB_Main_msg;
 /* Maximum encoded size of messages (where known) */
 #define PB_Empty_size                            0
 #define PB_StopSession_size                      0
-#if defined(PB_System_PingRequest_size) && defined(PB_System_PingResponse_size) && defined(PB_Storage_ListRequest_size) && defined(PB_Storage_ListResponse_size) && defined(PB_Storage_ReadRequest_size) && defined(PB_Storage_ReadResponse_size) && defined(PB_Storage_WriteRequest_size) && defined(PB_Storage_DeleteRequest_size) && defined(PB_Storage_MkdirRequest_size) && defined(PB_Storage_Md5sumRequest_size) && defined(PB_App_StartRequest_size) && defined(PB_Gui_ScreenFrame_size) && defined(PB_Storage_StatRequest_size) && defined(PB_Storage_StatResponse_size) && defined(PB_Gui_StartVirtualDisplayRequest_size) && defined(PB_Storage_InfoRequest_size) && defined(PB_Storage_RenameRequest_size) && defined(PB_System_DeviceInfoResponse_size) && defined(PB_System_UpdateRequest_size) && defined(PB_Storage_BackupCreateRequest_size) && defined(PB_Storage_BackupRestoreRequest_size) && defined(PB_System_PowerInfoResponse_size)
+#if defined(PB_System_PingRequest_size) && defined(PB_System_PingResponse_size) && defined(PB_Storage_ListRequest_size) && defined(PB_Storage_ListResponse_size) && defined(PB_Storage_ReadRequest_size) && defined(PB_Storage_ReadResponse_size) && defined(PB_Storage_WriteRequest_size) && defined(PB_Storage_DeleteRequest_size) && defined(PB_Storage_MkdirRequest_size) && defined(PB_Storage_Md5sumRequest_size) && defined(PB_App_StartRequest_size) && defined(PB_Gui_ScreenFrame_size) && defined(PB_Storage_StatRequest_size) && defined(PB_Storage_StatResponse_size) && defined(PB_Gui_StartVirtualDisplayRequest_size) && defined(PB_Storage_InfoRequest_size) && defined(PB_Storage_RenameRequest_size) && defined(PB_System_DeviceInfoResponse_size) && defined(PB_System_UpdateRequest_size) && defined(PB_Storage_BackupCreateRequest_size) && defined(PB_Storage_BackupRestoreRequest_size) && defined(PB_System_PowerInfoResponse_size) && defined(PB_System_ProfilerRequest_size) && defined(PB_System_ProfilerResponse_size) && defined(PB_System_TraceRequest_size) && defined(PB_System_TraceResponse_size) && defined(PB_App_StatsRequest_size) && defined(PB_App_StatsResponse_size)
 #define PB_Main_size                             (10 + sizeof(union PB_Main_content_size_union))
-union PB_Main_content_size_union {char f5[(6 + PB_System_PingRequest_size)]; char f6[(6 + PB_System_PingResponse_size)]; char f7[(6 + PB_Storage_ListRequest_size)]; char f8[(6 + PB_Storage_ListResponse_size)]; char f9[(6 + PB_Storage_ReadRequest_size)]; char f10[(6 + PB_Storage_ReadResponse_size)]; char f11[(6 + PB_Storage_WriteRequest_size)]; char f12[(6 + PB_Storage_DeleteRequest_size)]; char f13[(6 + PB_Storage_MkdirRequest_size)]; char f14[(6 + PB_Storage_Md5sumRequest_size)]; char f16[(7 + PB_App_StartRequest_size)]; char f22[(7 + PB_Gui_ScreenFrame_size)]; char f24[(7 + PB_Storage_StatRequest_size)]; char f25[(7 + PB_Storage_StatResponse_size)]; char f26[(7 + PB_Gui_StartVirtualDisplayRequest_size)]; char f28[(7 + PB_Storage_InfoRequest_size)]; char f30[(7 + PB_Storage_RenameRequest_size)]; char f33[(7 + PB_System_DeviceInfoResponse_size)]; char f41[(7 + PB_System_UpdateRequest_size)]; char f42[(7 + PB_Storage_BackupCreateRequest_size)]; char f43[(7 + PB_Storage_BackupRestoreRequest_size)]; char f45[(7 + PB_System_PowerInfoResponse_size)]; char f0[36];};
+union PB_Main_content_size_union {char f5[(6 + PB_System_PingRequest_size)]; char f6[(6 + PB_System_PingResponse_size)]; char f7[(6 + PB_Storage_ListRequest_size)]; char f8[(6 + PB_Storage_ListResponse_size)]; char f9[(6 + PB_Storage_ReadRequest_size)]; char f10[(6 + PB_Storage_ReadResponse_size)]; char f11[(6 + PB_Storage_WriteRequest_size)]; char f12[(6 + PB_Storage_DeleteRequest_size)]; char f13[(6 + PB_Storage_MkdirRequest_size)]; char f14[(6 + PB_Storage_Md5sumRequest_size)]; char f16[(7 + PB_App_StartRequest_size)]; char f22[(7 + PB_Gui_ScreenFrame_size)]; char f24[(7 + PB_Storage_StatRequest_size)]; char f25[(7 + PB_Storage_StatResponse_size)]; char f26[(7 + PB_Gui_StartVirtualDisplayRequest_size)]; char f28[(7 + PB_Storage_InfoRequest_size)]; char f30[(7 + PB_Storage_RenameRequest_size)]; char f33[(7 + PB_System_DeviceInfoResponse_size)]; char f41[(7 + PB_System_UpdateRequest_size)]; char f42[(7 + PB_Storage_BackupCreateRequest_size)]; char f43[(7 + PB_Storage_BackupRestoreRequest_size)]; char f45[(7 + PB_System_PowerInfoResponse_size)]; char f46[(7 + PB_System_ProfilerRequest_size)]; char f47[(7 + PB_System_ProfilerResponse_size)]; char f48[(7 + PB_System_TraceRequest_size)]; char f49[(7 + PB_System_TraceResponse_size)]; char f50[(7 + PB_App_StatsRequest_size)]; char f51[(7 + PB_App_StatsResponse_size)]; char f0[36];};
 #endif
 
 #ifdef __cplusplus
@@ -54,5 +54,16 @@ PB_BIND(PB_System_PowerInfoRequest, PB_System_PowerInfoRequest, AUTO)
 PB_BIND(PB_System_PowerInfoResponse, PB_System_PowerInfoResponse, AUTO)
 
 
+PB_BIND(PB_System_ProfilerRequest, PB_System_ProfilerRequest, AUTO)
+
+
+PB_BIND(PB_System_ProfilerResponse, PB_System_ProfilerResponse, AUTO)
+
+
+PB_BIND(PB_System_TraceRequest, PB_System_TraceRequest, AUTO)
+
+
+PB_BIND(PB_System_TraceResponse, PB_System_TraceResponse, AUTO)
+
 
 
@@ -15,6 +15,12 @@ typedef enum _PB_System_RebootRequest_RebootMode {
     PB_System_RebootRequest_RebootMode_DFU = 1 
 } PB_System_RebootRequest_RebootMode;
 
+typedef enum _PB_System_ProfilerRequest_Action { 
+    PB_System_ProfilerRequest_Action_START = 0, 
+    PB_System_ProfilerRequest_Action_STOP = 1, 
+    PB_System_ProfilerRequest_Action_DUMP = 2 
+} PB_System_ProfilerRequest_Action;
+
 /* Struct definitions */
 typedef struct _PB_System_DeviceInfoRequest { 
     char dummy_field;
@@ -54,10 +60,22 @@ typedef struct _PB_System_PowerInfoResponse {
     char *value; 
 } PB_System_PowerInfoResponse;
 
+typedef struct _PB_System_ProfilerResponse { 
+    pb_bytes_array_t *data; 
+} PB_System_ProfilerResponse;
+
 typedef struct _PB_System_ProtobufVersionRequest { 
     char dummy_field;
 } PB_System_ProtobufVersionRequest;
 
+typedef struct _PB_System_TraceRequest { 
+    char dummy_field;
+} PB_System_TraceRequest;
+
+typedef struct _PB_System_TraceResponse { 
+    pb_bytes_array_t *data; 
+} PB_System_TraceResponse;
+
 typedef struct _PB_System_UpdateRequest { 
     char *update_folder; 
 } PB_System_UpdateRequest;
@@ -74,6 +92,11 @@ typedef struct _PB_System_DateTime {
     uint8_t weekday; /* *< Current weekday: 1-7 */
 } PB_System_DateTime;
 
+typedef struct _PB_System_ProfilerRequest { 
+    PB_System_ProfilerRequest_Action action; 
+    uint32_t rate; /* *< Samples per second for START, 0 for default */
+} PB_System_ProfilerRequest;
+
 typedef struct _PB_System_ProtobufVersionResponse { 
     uint32_t major; 
     uint32_t minor; 
@@ -99,6 +122,10 @@ typedef struct _PB_System_SetDateTimeRequest {
 #define _PB_System_RebootRequest_RebootMode_MAX PB_System_RebootRequest_RebootMode_DFU
 #define _PB_System_RebootRequest_RebootMode_ARRAYSIZE ((PB_System_RebootRequest_RebootMode)(PB_System_RebootRequest_RebootMode_DFU+1))
 
+#define _PB_System_ProfilerRequest_Action_MIN PB_System_ProfilerRequest_Action_START
+#define _PB_System_ProfilerRequest_Action_MAX PB_System_ProfilerRequest_Action_DUMP
+#define _PB_System_ProfilerRequest_Action_ARRAYSIZE ((PB_System_ProfilerRequest_Action)(PB_System_ProfilerRequest_Action_DUMP+1))
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -121,6 +148,10 @@ extern "C" {
 #define PB_System_UpdateRequest_init_default     {NULL}
 #define PB_System_PowerInfoRequest_init_default  {0}
 #define PB_System_PowerInfoResponse_init_default {NULL, NULL}
+#define PB_System_ProfilerRequest_init_default   {_PB_System_ProfilerRequest_Action_MIN, 0}
+#define PB_System_ProfilerResponse_init_default  {NULL}
+#define PB_System_TraceRequest_init_default      {0}
+#define PB_System_TraceResponse_init_default     {NULL}
 #define PB_System_PingRequest_init_zero          {NULL}
 #define PB_System_PingResponse_init_zero         {NULL}
 #define PB_System_RebootRequest_init_zero        {_PB_System_RebootRequest_RebootMode_MIN}
@@ -137,6 +168,10 @@ extern "C" {
 #define PB_System_UpdateRequest_init_zero        {NULL}
 #define PB_System_PowerInfoRequest_init_zero     {0}
 #define PB_System_PowerInfoResponse_init_zero    {NULL, NULL}
+#define PB_System_ProfilerRequest_init_zero      {_PB_System_ProfilerRequest_Action_MIN, 0}
+#define PB_System_ProfilerResponse_init_zero     {NULL}
+#define PB_System_TraceRequest_init_zero         {0}
+#define PB_System_TraceResponse_init_zero        {NULL}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define PB_System_DeviceInfoResponse_key_tag     1
@@ -145,6 +180,8 @@ extern "C" {
 #define PB_System_PingResponse_data_tag          1
 #define PB_System_PowerInfoResponse_key_tag      1
 #define PB_System_PowerInfoResponse_value_tag    2
+#define PB_System_ProfilerResponse_data_tag      1
+#define PB_System_TraceResponse_data_tag         1
 #define PB_System_UpdateRequest_update_folder_tag 1
 #define PB_System_DateTime_hour_tag              1
 #define PB_System_DateTime_minute_tag            2
@@ -153,6 +190,8 @@ extern "C" {
 #define PB_System_DateTime_month_tag             5
 #define PB_System_DateTime_year_tag              6
 #define PB_System_DateTime_weekday_tag           7
+#define PB_System_ProfilerRequest_action_tag     1
+#define PB_System_ProfilerRequest_rate_tag       2
 #define PB_System_ProtobufVersionResponse_major_tag 1
 #define PB_System_ProtobufVersionResponse_minor_tag 2
 #define PB_System_RebootRequest_mode_tag         1
@@ -251,6 +290,27 @@ X(a, POINTER,  SINGULAR, STRING,   value,             2)
 #define PB_System_PowerInfoResponse_CALLBACK NULL
 #define PB_System_PowerInfoResponse_DEFAULT NULL
 
+#define PB_System_ProfilerRequest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    action,            1) \
+X(a, STATIC,   SINGULAR, UINT32,   rate,              2)
+#define PB_System_ProfilerRequest_CALLBACK NULL
+#define PB_System_ProfilerRequest_DEFAULT NULL
+
+#define PB_System_ProfilerResponse_FIELDLIST(X, a) \
+X(a, POINTER,  SINGULAR, BYTES,    data,              1)
+#define PB_System_ProfilerResponse_CALLBACK NULL
+#define PB_System_ProfilerResponse_DEFAULT NULL
+
+#define PB_System_TraceRequest_FIELDLIST(X, a) \
+
+#define PB_System_TraceRequest_CALLBACK NULL
+#define PB_System_TraceRequest_DEFAULT NULL
+
+#define PB_System_TraceResponse_FIELDLIST(X, a) \
+X(a, POINTER,  SINGULAR, BYTES,    data,              1)
+#define PB_System_TraceResponse_CALLBACK NULL
+#define PB_System_TraceResponse_DEFAULT NULL
+
 extern const pb_msgdesc_t PB_System_PingRequest_msg;
 extern const pb_msgdesc_t PB_System_PingResponse_msg;
 extern const pb_msgdesc_t PB_System_RebootRequest_msg;
@@ -267,6 +327,10 @@ extern const pb_msgdesc_t PB_System_ProtobufVersionResponse_msg;
 extern const pb_msgdesc_t PB_System_UpdateRequest_msg;
 extern const pb_msgdesc_t PB_System_PowerInfoRequest_msg;
 extern const pb_msgdesc_t PB_System_PowerInfoResponse_msg;
+extern const pb_msgdesc_t PB_System_ProfilerRequest_msg;
+extern const pb_msgdesc_t PB_System_ProfilerResponse_msg;
+extern const pb_msgdesc_t PB_System_TraceRequest_msg;
+extern const pb_msgdesc_t PB_System_TraceResponse_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define PB_System_PingRequest_fields &PB_System_PingRequest_msg
@@ -285,6 +349,10 @@ extern const pb_msgdesc_t PB_System_PowerInfoResponse_msg;
 #define PB_System_UpdateRequest_fields &PB_System_UpdateRequest_msg
 #define PB_System_PowerInfoRequest_fields &PB_System_PowerInfoRequest_msg
 #define PB_System_PowerInfoResponse_fields &PB_System_PowerInfoResponse_msg
+#define PB_System_ProfilerRequest_fields &PB_System_ProfilerRequest_msg
+#define PB_System_ProfilerResponse_fields &PB_System_ProfilerResponse_msg
+#define PB_System_TraceRequest_fields &PB_System_TraceRequest_msg
+#define PB_System_TraceResponse_fields &PB_System_TraceResponse_msg
 
 /* Maximum encoded size of messages (where known) */
 /* PB_System_PingRequest_size depends on runtime parameters */
@@ -292,6 +360,8 @@ extern const pb_msgdesc_t PB_System_PowerInfoResponse_msg;
 /* PB_System_DeviceInfoResponse_size depends on runtime parameters */
 /* PB_System_UpdateRequest_size depends on runtime parameters */
 /* PB_System_PowerInfoResponse_size depends on runtime parameters */
+/* PB_System_ProfilerResponse_size depends on runtime parameters */
+/* PB_System_TraceResponse_size depends on runtime parameters */
 #define PB_System_DateTime_size                  22
 #define PB_System_DeviceInfoRequest_size         0
 #define PB_System_FactoryResetRequest_size       0
@@ -299,10 +369,12 @@ extern const pb_msgdesc_t PB_System_PowerInfoResponse_msg;
 #define PB_System_GetDateTimeResponse_size       24
 #define PB_System_PlayAudiovisualAlertRequest_size 0
 #define PB_System_PowerInfoRequest_size          0
+#define PB_System_ProfilerRequest_size           8
 #define PB_System_ProtobufVersionRequest_size    0
 #define PB_System_ProtobufVersionResponse_size   12
 #define PB_System_RebootRequest_size             2
 #define PB_System_SetDateTimeRequest_size        24
+#define PB_System_TraceRequest_size              0
 
 #ifdef __cplusplus
 } /* extern "C" */
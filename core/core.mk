@@ -6,3 +6,9 @@ C_SOURCES		+= $(wildcard $(CORE_DIR)/*.c)
 C_SOURCES		+= $(wildcard $(CORE_DIR)/furi/*.c)
 C_SOURCES		+= $(wildcard $(CORE_DIR)/furi_hal/*.c)
 CPP_SOURCES		+= $(wildcard $(CORE_DIR)/*.cpp)
+
+# Hot path trace points, see furi/trace.h. Unit test builds enable them for furi_trace_test
+FURI_TRACE ?= $(APP_UNIT_TESTS)
+ifeq ($(FURI_TRACE), 1)
+CFLAGS			+= -DFURI_TRACE
+endif
@@ -12,8 +12,10 @@
 #include <furi/memmgr_heap.h>
 #include <furi/pubsub.h>
 #include <furi/record.h>
+#include <furi/ring.h>
 #include <furi/stdglue.h>
 #include <furi/thread.h>
+#include <furi/trace.h>
 #include <furi/valuemutex.h>
 #include <furi/log.h>
 
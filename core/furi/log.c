@@ -2,6 +2,7 @@
 #include "check.h"
 #include <cmsis_os2.h>
 #include <furi_hal.h>
+#include <inttypes.h>
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
@@ -27,7 +28,7 @@ void furi_log_print(FuriLogLevel level, const char* format, ...) {
         string_t string;
 
         // Timestamp
-        string_init_printf(string, "%lu ", furi_log.timetamp());
+        string_init_printf(string, "%" PRIu32 " ", furi_log.timetamp());
         furi_log.puts(string_get_cstr(string));
         string_clear(string);
 
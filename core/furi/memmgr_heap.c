@@ -123,13 +123,23 @@ DICT_DEF2(
     MemmgrHeapAllocDict_t,
     DICT_OPLIST(MemmgrHeapAllocDict))
 
+/* Running totals, so peak is known without walking allocations */
+typedef struct {
+    size_t live;
+    size_t peak;
+} MemmgrHeapThreadUsage;
+
+DICT_DEF2(MemmgrHeapUsageDict, uint32_t, M_DEFAULT_OPLIST, MemmgrHeapThreadUsage, M_POD_OPLIST)
+
 /* Thread allocation tracing storage */
 static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
+static MemmgrHeapUsageDict_t memmgr_heap_usage_dict = {0};
 static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
 
 /* Initialize tracing storage on start */
 void memmgr_heap_init() {
     MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+    MemmgrHeapUsageDict_init(memmgr_heap_usage_dict);
 }
 
 void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
@@ -141,6 +151,8 @@ void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
         MemmgrHeapAllocDict_init(alloc_dict);
         MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
         MemmgrHeapAllocDict_clear(alloc_dict);
+        MemmgrHeapThreadUsage usage = {0};
+        MemmgrHeapUsageDict_set_at(memmgr_heap_usage_dict, (uint32_t)thread_id, usage);
         memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
@@ -152,6 +164,7 @@ void memmgr_heap_disable_thread_trace(osThreadId_t thread_id) {
         memmgr_heap_thread_trace_depth++;
         furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) != NULL);
         MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id);
+        MemmgrHeapUsageDict_erase(memmgr_heap_usage_dict, (uint32_t)thread_id);
         memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
@@ -180,6 +193,22 @@ size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id) {
     return leftovers;
 }
 
+size_t memmgr_heap_get_thread_memory_peak(osThreadId_t thread_id) {
+    size_t peak = MEMMGR_HEAP_UNKNOWN;
+    vTaskSuspendAll();
+    {
+        memmgr_heap_thread_trace_depth++;
+        MemmgrHeapThreadUsage* usage =
+            MemmgrHeapUsageDict_get(memmgr_heap_usage_dict, (uint32_t)thread_id);
+        if(usage) {
+            peak = usage->peak;
+        }
+        memmgr_heap_thread_trace_depth--;
+    }
+    (void)xTaskResumeAll();
+    return peak;
+}
+
 #undef traceMALLOC
 static inline void traceMALLOC(void* pointer, size_t size) {
     osThreadId_t thread_id = osThreadGetId();
@@ -189,6 +218,10 @@ static inline void traceMALLOC(void* pointer, size_t size) {
             MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
         if(alloc_dict) {
             MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
+            MemmgrHeapThreadUsage* usage =
+                MemmgrHeapUsageDict_get(memmgr_heap_usage_dict, (uint32_t)thread_id);
+            usage->live += size;
+            usage->peak = MAX(usage->peak, usage->live);
         }
         memmgr_heap_thread_trace_depth--;
     }
@@ -202,7 +235,14 @@ static inline void traceFREE(void* pointer, size_t size) {
         MemmgrHeapAllocDict_t* alloc_dict =
             MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
         if(alloc_dict) {
-            MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
+            // Blocks allocated by other threads are not in the dict
+            uint32_t* allocated = MemmgrHeapAllocDict_get(*alloc_dict, (uint32_t)pointer);
+            if(allocated) {
+                MemmgrHeapThreadUsage* usage =
+                    MemmgrHeapUsageDict_get(memmgr_heap_usage_dict, (uint32_t)thread_id);
+                usage->live -= *allocated;
+                MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
+            }
         }
         memmgr_heap_thread_trace_depth--;
     }
@@ -34,6 +34,14 @@ void memmgr_heap_disable_thread_trace(osThreadId_t thread_id);
  */
 size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id);
 
+/** Memmgr heap get peak of allocated thread memory since trace was enabled
+ *
+ * @param      thread_id  - thread id to track
+ *
+ * @return     bytes, MEMMGR_HEAP_UNKNOWN if thread is not traced
+ */
+size_t memmgr_heap_get_thread_memory_peak(osThreadId_t thread_id);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
@@ -0,0 +1,183 @@
+#include "ring.h"
+#include "check.h"
+#include "common_defines.h"
+#include "memmgr.h"
+
+#include <string.h>
+
+/** Producer and consumer indices live on separate lines, so that one side
+ * writing its index does not evict the other side's one */
+#define FURI_RING_CACHE_LINE 64
+
+struct FuriRing {
+    // Written by producer
+    uint32_t head;
+    /** Tail seen by producer last time, space is at least that big */
+    uint32_t tail_cache;
+    uint8_t reserved_producer[FURI_RING_CACHE_LINE - 2 * sizeof(uint32_t)];
+
+    // Written by consumer, armed is cleared by producer
+    uint32_t tail;
+    /** Head seen by consumer last time, item count is at least that big */
+    uint32_t head_cache;
+    uint32_t armed;
+    uint8_t reserved_consumer[FURI_RING_CACHE_LINE - 3 * sizeof(uint32_t)];
+
+    // Set up before use
+    uint8_t* buffer;
+    size_t item_size;
+    uint32_t capacity;
+    // Set by consumer, read by producer once armed
+    osThreadId_t thread;
+    uint32_t flags;
+    uint32_t watermark;
+};
+
+FuriRing* furi_ring_alloc(size_t item_size, size_t capacity) {
+    furi_check(item_size);
+    furi_check(capacity && capacity <= (1UL << 31));
+    furi_check((capacity & (capacity - 1)) == 0);
+
+    FuriRing* ring = malloc(sizeof(FuriRing));
+    ring->buffer = malloc(item_size * capacity);
+    ring->item_size = item_size;
+    ring->capacity = capacity;
+
+    return ring;
+}
+
+void furi_ring_free(FuriRing* ring) {
+    furi_assert(ring);
+    free(ring->buffer);
+    free(ring);
+}
+
+void furi_ring_set_notify(FuriRing* ring, osThreadId_t thread, uint32_t flags, size_t watermark) {
+    furi_assert(ring);
+    furi_check(!thread || (watermark && watermark <= ring->capacity));
+
+    __atomic_store_n(&ring->armed, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->thread, thread, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->flags, flags, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->watermark, watermark, __ATOMIC_RELAXED);
+}
+
+/** Wake up armed consumer, ring head is already published */
+static void furi_ring_notify(FuriRing* ring, uint32_t head) {
+    // Pairs with furi_ring_arm: either we see armed or consumer sees new head
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(!__atomic_load_n(&ring->armed, __ATOMIC_ACQUIRE)) return;
+
+    uint32_t watermark = __atomic_load_n(&ring->watermark, __ATOMIC_RELAXED);
+    if(head - __atomic_load_n(&ring->tail, __ATOMIC_RELAXED) < watermark) return;
+
+    if(__atomic_exchange_n(&ring->armed, 0, __ATOMIC_RELAXED)) {
+        osThreadFlagsSet(
+            __atomic_load_n(&ring->thread, __ATOMIC_RELAXED),
+            __atomic_load_n(&ring->flags, __ATOMIC_RELAXED));
+    }
+}
+
+size_t furi_ring_push(FuriRing* ring, const void* items, size_t count) {
+    furi_assert(ring);
+    furi_assert(items);
+
+    uint32_t head = ring->head;
+    uint32_t space = ring->capacity - (head - ring->tail_cache);
+    if(space < count) {
+        ring->tail_cache = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        space = ring->capacity - (head - ring->tail_cache);
+    }
+    count = MIN(count, space);
+    if(!count) return 0;
+
+    uint32_t index = head & (ring->capacity - 1);
+    size_t first = MIN(count, ring->capacity - index);
+    memcpy(&ring->buffer[index * ring->item_size], items, first * ring->item_size);
+    memcpy(
+        ring->buffer,
+        (const uint8_t*)items + first * ring->item_size,
+        (count - first) * ring->item_size);
+
+    // Items must be in memory before consumer sees them
+    __atomic_store_n(&ring->head, head + count, __ATOMIC_RELEASE);
+    furi_ring_notify(ring, head + count);
+
+    return count;
+}
+
+size_t furi_ring_pop(FuriRing* ring, void* items, size_t count) {
+    furi_assert(ring);
+    furi_assert(items);
+
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->head_cache - tail;
+    if(available < count) {
+        ring->head_cache = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        available = ring->head_cache - tail;
+    }
+    count = MIN(count, available);
+    if(!count) return 0;
+
+    uint32_t index = tail & (ring->capacity - 1);
+    size_t first = MIN(count, ring->capacity - index);
+    memcpy(items, &ring->buffer[index * ring->item_size], first * ring->item_size);
+    memcpy(
+        (uint8_t*)items + first * ring->item_size,
+        ring->buffer,
+        (count - first) * ring->item_size);
+
+    // Items must be copied out before producer reuses their slots
+    __atomic_store_n(&ring->tail, tail + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+bool furi_ring_arm(FuriRing* ring) {
+    furi_assert(ring);
+    furi_assert(ring->thread);
+
+    // Publishes notify settings to producer
+    __atomic_store_n(&ring->armed, 1, __ATOMIC_RELEASE);
+    // Pairs with furi_ring_notify
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    bool ready = furi_ring_count(ring) >= ring->watermark;
+    if(ready) {
+        __atomic_store_n(&ring->armed, 0, __ATOMIC_RELAXED);
+    }
+    return ready;
+}
+
+size_t furi_ring_wait(FuriRing* ring, uint32_t timeout) {
+    furi_assert(ring);
+    furi_assert(ring->thread == osThreadGetId());
+
+    if(!furi_ring_arm(ring)) {
+        osThreadFlagsWait(ring->flags, osFlagsWaitAny, timeout);
+        // Timed out: producer must not use settings consumer may change now
+        __atomic_store_n(&ring->armed, 0, __ATOMIC_RELAXED);
+    }
+
+    return furi_ring_count(ring);
+}
+
+size_t furi_ring_count(FuriRing* ring) {
+    furi_assert(ring);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    return head - tail;
+}
+
+size_t furi_ring_space(FuriRing* ring) {
+    return ring->capacity - furi_ring_count(ring);
+}
+
+void furi_ring_reset(FuriRing* ring) {
+    furi_assert(ring);
+    ring->head = 0;
+    ring->tail_cache = 0;
+    ring->tail = 0;
+    ring->head_cache = 0;
+    __atomic_store_n(&ring->armed, 0, __ATOMIC_RELAXED);
+}
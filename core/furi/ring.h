@@ -0,0 +1,126 @@
+/**
+ * @file ring.h
+ * Furi ring: lock-free single producer, single consumer ring of fixed size items
+ *
+ * One side pushes, the other one pops, ISR can be either of them. No critical
+ * sections: indices are free running counters, each written by one side only.
+ * Push and pop take batches, copy is done with at most two memcpy calls.
+ *
+ * Consumer thread can be woken up with thread flags. Producer sets them only
+ * when consumer asked for it and item count reached the watermark, so waking
+ * up costs one flag set per batch, not per item. Low rate data is picked up by
+ * consumer on wait timeout.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <cmsis_os2.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** FuriRing type */
+typedef struct FuriRing FuriRing;
+
+/** Allocate FuriRing
+ *
+ * @param   item_size   item size in bytes
+ * @param   capacity    item count, power of 2
+ *
+ * @return  pointer to FuriRing instance
+ */
+FuriRing* furi_ring_alloc(size_t item_size, size_t capacity);
+
+/** Free FuriRing
+ *
+ * @param   ring    FuriRing instance
+ */
+void furi_ring_free(FuriRing* ring);
+
+/** Set consumer wake up
+ *
+ * Call while consumer is not armed: before producer starts or from consumer
+ * thread itself. Producer reads these settings only for armed consumer.
+ *
+ * @param   ring        FuriRing instance
+ * @param   thread      consumer thread, NULL to disable wake up
+ * @param   flags       thread flags to set
+ * @param   watermark   item count to wake up on, from 1 to capacity
+ */
+void furi_ring_set_notify(FuriRing* ring, osThreadId_t thread, uint32_t flags, size_t watermark);
+
+/** Push items, producer side
+ *
+ * Never blocks, can be called from ISR.
+ *
+ * @param   ring    FuriRing instance
+ * @param   items   items to push
+ * @param   count   item count
+ *
+ * @return  pushed item count, less than count if ring is full
+ */
+size_t furi_ring_push(FuriRing* ring, const void* items, size_t count);
+
+/** Pop items, consumer side
+ *
+ * Never blocks, can be called from ISR.
+ *
+ * @param   ring    FuriRing instance
+ * @param   items   buffer for count items
+ * @param   count   max item count
+ *
+ * @return  popped item count
+ */
+size_t furi_ring_pop(FuriRing* ring, void* items, size_t count);
+
+/** Ask producer for wake up, consumer side
+ *
+ * Use when consumer waits for thread flags on its own.
+ *
+ * @param   ring    FuriRing instance
+ *
+ * @return  true if ring is already at watermark, consumer should not wait
+ */
+bool furi_ring_arm(FuriRing* ring);
+
+/** Wait for watermark or timeout, consumer thread
+ *
+ * May return early on flags left from previous batch.
+ *
+ * @param   ring    FuriRing instance
+ * @param   timeout timeout in ticks
+ *
+ * @return  item count in ring
+ */
+size_t furi_ring_wait(FuriRing* ring, uint32_t timeout);
+
+/** Get item count, either side
+ *
+ * @param   ring    FuriRing instance
+ *
+ * @return  item count
+ */
+size_t furi_ring_count(FuriRing* ring);
+
+/** Get free space, either side
+ *
+ * @param   ring    FuriRing instance
+ *
+ * @return  item count that can be pushed
+ */
+size_t furi_ring_space(FuriRing* ring);
+
+/** Drop all items
+ *
+ * Neither producer nor consumer may run at the moment.
+ *
+ * @param   ring    FuriRing instance
+ */
+void furi_ring_reset(FuriRing* ring);
+
+#ifdef __cplusplus
+}
+#endif
@@ -20,6 +20,8 @@ struct FuriThread {
 
     bool heap_trace_enabled;
     size_t heap_size;
+    size_t heap_peak;
+    size_t stack_space;
 };
 
 void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
@@ -46,8 +48,10 @@ void furi_thread_body(void* context) {
 
     if(thread->heap_trace_enabled == true) {
         thread->heap_size = memmgr_heap_get_thread_memory(thread_id);
+        thread->heap_peak = memmgr_heap_get_thread_memory_peak(thread_id);
         memmgr_heap_disable_thread_trace(thread_id);
     }
+    thread->stack_space = osThreadGetStackSpace(thread_id);
 
     furi_assert(thread->state == FuriThreadStateRunning);
     furi_thread_set_state(thread, FuriThreadStateStopped);
@@ -167,3 +171,14 @@ size_t furi_thread_get_heap_size(FuriThread* thread) {
     furi_assert(thread->heap_trace_enabled == true);
     return thread->heap_size;
 }
+
+size_t furi_thread_get_heap_peak(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->heap_trace_enabled == true);
+    return thread->heap_peak;
+}
+
+size_t furi_thread_get_stack_space(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->stack_space;
+}
@@ -150,6 +150,24 @@ void furi_thread_disable_heap_trace(FuriThread* thread);
  */
 size_t furi_thread_get_heap_size(FuriThread* thread);
 
+/** Get thread heap peak
+ *
+ * @param      thread  FuriThread instance
+ *
+ * @return     most bytes held by thread at once during last run
+ */
+size_t furi_thread_get_heap_peak(FuriThread* thread);
+
+/** Get thread stack space
+ *
+ * Stack high-water mark, valid after thread returns from its callback.
+ *
+ * @param      thread  FuriThread instance
+ *
+ * @return     least free stack during last run, bytes
+ */
+size_t furi_thread_get_stack_space(FuriThread* thread);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,220 @@
+#include "trace.h"
+#include "check.h"
+#include "common_defines.h"
+#include "memmgr.h"
+
+#ifdef FURI_TRACE
+
+#include <furi_hal.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <task_control_block.h>
+#include <string.h>
+
+#define FURI_TRACE_EVENTS_MASK (FURI_TRACE_EVENTS - 1)
+#define FURI_TRACE_DRAIN_CHUNK 512
+/** Thread number as stored in event context, ISR bit stays clear */
+#define FURI_TRACE_THREAD_NUMBER(number) ((number) & ~FURI_TRACE_CONTEXT_ISR & 0xFFFF)
+
+#define FURI_TRACE_POINT_INFO(id, kind, name, arg0, arg1) \
+    {FuriTraceKind##kind, {0}, name, arg0, arg1},
+
+static const FuriTracePointInfo furi_trace_points[] = {FURI_TRACE_POINTS(FURI_TRACE_POINT_INFO)};
+
+typedef struct {
+    /** Event index + 1 once event is complete, 0 while it is written */
+    volatile uint32_t seq;
+    FuriTraceEvent event;
+} FuriTraceSlot;
+
+typedef struct {
+    FuriTraceSlot slots[FURI_TRACE_EVENTS];
+    // Reserved by writers with atomic increment
+    volatile uint32_t head;
+    // Written by drain only
+    uint32_t tail;
+    volatile bool draining;
+} FuriTrace;
+
+static FuriTrace furi_trace = {0};
+
+typedef struct {
+    FuriTraceDrainCallback callback;
+    void* context;
+    uint8_t* buffer;
+    size_t size;
+} FuriTraceDrain;
+
+bool furi_trace_is_enabled() {
+    return true;
+}
+
+void furi_trace_event(uint16_t id, uint32_t arg0, uint32_t arg1) {
+    // LDREX/STREX: writers preempting each other get different slots
+    uint32_t index = __atomic_fetch_add(&furi_trace.head, 1, __ATOMIC_RELAXED);
+    FuriTraceSlot* slot = &furi_trace.slots[index & FURI_TRACE_EVENTS_MASK];
+
+    slot->seq = 0;
+    __DMB();
+
+    uint32_t ipsr = __get_IPSR();
+    slot->event.timestamp = DWT->CYCCNT;
+    slot->event.id = id;
+    if(ipsr) {
+        slot->event.context = FURI_TRACE_CONTEXT_ISR | ipsr;
+    } else {
+        // Plain TCB read: TCB number is what uxTaskGetSystemState reports as xTaskNumber,
+        // uxTaskNumber is never set and reads 0
+        TaskControlBlock* tcb = (TaskControlBlock*)xTaskGetCurrentTaskHandle();
+        bool started = tcb && (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED);
+        slot->event.context = started ? FURI_TRACE_THREAD_NUMBER(tcb->uxTCBNumber) : 0;
+    }
+    slot->event.arg0 = arg0;
+    slot->event.arg1 = arg1;
+
+    // Event must be in memory before drain can see it
+    __DMB();
+    slot->seq = index + 1;
+}
+
+static void furi_trace_drain_write(FuriTraceDrain* drain, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    while(size) {
+        if(drain->size == FURI_TRACE_DRAIN_CHUNK) {
+            drain->callback(drain->buffer, drain->size, false, drain->context);
+            drain->size = 0;
+        }
+        size_t chunk = MIN(size, FURI_TRACE_DRAIN_CHUNK - drain->size);
+        memcpy(&drain->buffer[drain->size], bytes, chunk);
+        drain->size += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+/** Copy complete events out of the ring and advance tail
+ *
+ * Slot is read twice around the copy: writer that lapped the drain changes
+ * sequence number, event is counted as lost then.
+ */
+static size_t furi_trace_collect(FuriTraceEvent* events, uint32_t head, uint32_t* lost) {
+    uint32_t index = furi_trace.tail;
+    size_t count = 0;
+
+    if(head - index > FURI_TRACE_EVENTS) {
+        *lost += head - index - FURI_TRACE_EVENTS;
+        index = head - FURI_TRACE_EVENTS;
+    }
+
+    for(; index != head; index++) {
+        FuriTraceSlot* slot = &furi_trace.slots[index & FURI_TRACE_EVENTS_MASK];
+        uint32_t seq = slot->seq;
+        __DMB();
+
+        if((int32_t)(seq - (index + 1)) < 0) {
+            // Slot is still written: by our writer, or by one from the next lap
+            if(furi_trace.head - index > FURI_TRACE_EVENTS) {
+                (*lost)++;
+                continue;
+            }
+            break;
+        } else if(seq != index + 1) {
+            (*lost)++;
+            continue;
+        }
+
+        memcpy(&events[count], &slot->event, sizeof(FuriTraceEvent));
+        __DMB();
+        if(slot->seq == seq) {
+            count++;
+        } else {
+            (*lost)++;
+        }
+    }
+
+    furi_trace.tail = index;
+    return count;
+}
+
+static UBaseType_t furi_trace_get_threads(TaskStatus_t** status) {
+    vTaskSuspendAll();
+    UBaseType_t count = uxTaskGetNumberOfTasks();
+    *status = pvPortMalloc(count * sizeof(TaskStatus_t));
+    if(*status) {
+        count = uxTaskGetSystemState(*status, count, NULL);
+    } else {
+        count = 0;
+    }
+    xTaskResumeAll();
+    return count;
+}
+
+bool furi_trace_drain(FuriTraceDrainCallback callback, void* context) {
+    furi_assert(callback);
+    furi_assert(!FURI_IS_IRQ_MODE());
+    if(__atomic_exchange_n(&furi_trace.draining, true, __ATOMIC_ACQUIRE)) return false;
+
+    FuriTraceDrain drain = {
+        .callback = callback,
+        .context = context,
+        .buffer = malloc(FURI_TRACE_DRAIN_CHUNK),
+        .size = 0,
+    };
+
+    TaskStatus_t* status;
+    UBaseType_t thread_count = furi_trace_get_threads(&status);
+
+    // Events coming after this point go to the next drain
+    uint32_t head = furi_trace.head;
+    uint32_t lost = 0;
+    FuriTraceEvent* events = malloc(sizeof(FuriTraceEvent) * FURI_TRACE_EVENTS);
+    size_t event_count = furi_trace_collect(events, head, &lost);
+
+    FuriTraceHeader header = {
+        .magic = FURI_TRACE_MAGIC,
+        .version = FURI_TRACE_VERSION,
+        .point_count = FuriTracePointCount,
+        .thread_count = thread_count,
+        .core_clock = SystemCoreClock,
+        .timestamp = DWT->CYCCNT,
+        .uptime = osKernelGetTickCount() * 1000 / osKernelGetTickFreq(),
+        .event_count = event_count,
+        .lost = lost,
+    };
+    furi_trace_drain_write(&drain, &header, sizeof(FuriTraceHeader));
+    furi_trace_drain_write(&drain, furi_trace_points, sizeof(furi_trace_points));
+
+    for(UBaseType_t i = 0; i < thread_count; i++) {
+        FuriTraceThread thread = {
+            .number = FURI_TRACE_THREAD_NUMBER(status[i].xTaskNumber),
+        };
+        strncpy(thread.name, status[i].pcTaskName, FURI_TRACE_NAME_SIZE);
+        furi_trace_drain_write(&drain, &thread, sizeof(FuriTraceThread));
+    }
+    vPortFree(status);
+
+    furi_trace_drain_write(&drain, events, sizeof(FuriTraceEvent) * event_count);
+    free(events);
+
+    callback(drain.buffer, drain.size, true, context);
+    free(drain.buffer);
+
+    __atomic_store_n(&furi_trace.draining, false, __ATOMIC_RELEASE);
+    return true;
+}
+
+#else
+
+bool furi_trace_is_enabled() {
+    return false;
+}
+
+void furi_trace_event(uint16_t id, uint32_t arg0, uint32_t arg1) {
+}
+
+bool furi_trace_drain(FuriTraceDrainCallback callback, void* context) {
+    furi_assert(callback);
+    return false;
+}
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @file trace.h
+ * Furi trace points: hot path events in a binary ring
+ *
+ * Trace point stores a timestamp, point id, current context and two arguments
+ * into a static ring. It takes no locks and can be used from threads and ISRs.
+ * Ring keeps the latest FURI_TRACE_EVENTS events, drain streams them together
+ * with point and thread names. Stream decoder: scripts/tracepoints.py.
+ *
+ * Points are compiled in with FURI_TRACE=1 build flag and compile to nothing
+ * otherwise. Traced firmware never enters STOP mode: cycle counter must run.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Ring capacity, power of 2 */
+#ifndef FURI_TRACE_EVENTS
+#define FURI_TRACE_EVENTS 512
+#endif
+
+/** Drain stream magic, "FZTR" */
+#define FURI_TRACE_MAGIC 0x52545A46
+#define FURI_TRACE_VERSION 1
+#define FURI_TRACE_NAME_SIZE 16
+#define FURI_TRACE_ARG_NAME_SIZE 12
+
+/** Event context bit: event came from ISR, lower bits are exception number */
+#define FURI_TRACE_CONTEXT_ISR 0x8000
+
+typedef enum {
+    FuriTraceKindInstant,
+    FuriTraceKindBegin, /**< opens a span, closed by End point of the same name */
+    FuriTraceKindEnd,
+} FuriTraceKind;
+
+/** Trace point list: id, kind, name, arg0 name, arg1 name
+ *
+ * Append new points to the end, decoder gets names from the stream.
+ */
+#define FURI_TRACE_POINTS(X)                                            \
+    X(FuriTraceSubGhzRx, Instant, "subghz_rx", "level", "duration")     \
+    X(FuriTraceSubGhzOverrun, Instant, "subghz_overrun", "", "")        \
+    X(FuriTraceInfraredRx, Instant, "infrared_rx", "level", "duration") \
+    X(FuriTraceInfraredOverrun, Instant, "infrared_overrun", "", "")    \
+    X(FuriTraceUsbUartRx, Instant, "usb_uart_rx", "size", "sent")       \
+    X(FuriTraceStorageBegin, Begin, "storage", "command", "")           \
+    X(FuriTraceStorageEnd, End, "storage", "command", "")               \
+    X(FuriTraceRpcBegin, Begin, "rpc", "content", "command_id")         \
+    X(FuriTraceRpcEnd, End, "rpc", "content", "command_id")             \
+    X(FuriTraceGuiRedrawBegin, Begin, "gui_redraw", "layers", "")       \
+    X(FuriTraceGuiRedrawEnd, End, "gui_redraw", "", "")
+
+#define FURI_TRACE_POINT_ID(id, kind, name, arg0, arg1) id,
+
+typedef enum { FURI_TRACE_POINTS(FURI_TRACE_POINT_ID) FuriTracePointCount } FuriTracePoint;
+
+/** Drain stream layout, little endian. Header goes first, then point_count
+ * FuriTracePointInfo records indexed by point id, then thread_count
+ * FuriTraceThread records, then event_count FuriTraceEvent records, oldest first
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t point_count;
+    uint16_t thread_count;
+    uint16_t reserved2;
+    uint32_t core_clock; /**< Hz, unit of event timestamp */
+    uint32_t timestamp; /**< cycle counter at drain */
+    uint32_t uptime; /**< ms since boot at drain */
+    uint32_t event_count;
+    uint32_t lost; /**< events overwritten since previous drain */
+} __attribute__((packed)) FuriTraceHeader;
+
+typedef struct {
+    uint8_t kind; /**< FuriTraceKind */
+    uint8_t reserved[3];
+    char name[FURI_TRACE_NAME_SIZE];
+    char arg0[FURI_TRACE_ARG_NAME_SIZE];
+    char arg1[FURI_TRACE_ARG_NAME_SIZE];
+} __attribute__((packed)) FuriTracePointInfo;
+
+typedef struct {
+    uint32_t number; /**< thread number as in FuriTraceEvent context */
+    char name[FURI_TRACE_NAME_SIZE];
+} __attribute__((packed)) FuriTraceThread;
+
+typedef struct {
+    uint32_t timestamp; /**< core clock cycles, wraps */
+    uint16_t id;
+    /** Thread number, 0 before scheduler start, FURI_TRACE_CONTEXT_ISR | exception in ISR */
+    uint16_t context;
+    uint32_t arg0;
+    uint32_t arg1;
+} __attribute__((packed)) FuriTraceEvent;
+
+/** Drain stream chunk callback
+ *
+ * @param   data        chunk data
+ * @param   size        chunk size
+ * @param   last        true for the last chunk of the stream
+ * @param   context     callback context
+ */
+typedef void (*FuriTraceDrainCallback)(const uint8_t* data, size_t size, bool last, void* context);
+
+#ifdef FURI_TRACE
+#define FURI_TRACE_POINT(id, arg0, arg1) \
+    furi_trace_event((id), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define FURI_TRACE_POINT(id, arg0, arg1) ((void)sizeof(arg0), (void)sizeof(arg1))
+#endif
+
+/** Check if trace points are compiled in
+ *
+ * @return  true if firmware is built with FURI_TRACE
+ */
+bool furi_trace_is_enabled();
+
+/** Store event, use FURI_TRACE_POINT instead
+ *
+ * @param   id      FuriTracePoint
+ * @param   arg0    first argument
+ * @param   arg1    second argument
+ */
+void furi_trace_event(uint16_t id, uint32_t arg0, uint32_t arg1);
+
+/** Drain collected events
+ *
+ * Events stored while drain runs go to the next one. Stream size is known
+ * from header. Not available from ISR.
+ *
+ * @param   callback    chunk callback, called at least once on success
+ * @param   context     callback context
+ *
+ * @return  false if tracing is not compiled in or other drain is running
+ */
+bool furi_trace_drain(FuriTraceDrainCallback callback, void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,7 +25,7 @@ extern uint32_t SystemCoreClock;
 /* Heap size determined automatically by linker */
 // #define configTOTAL_HEAP_SIZE                    ((size_t)0)
 #define configMAX_TASK_NAME_LEN (16)
-#define configGENERATE_RUN_TIME_STATS 0
+#define configGENERATE_RUN_TIME_STATS 1
 #define configUSE_TRACE_FACILITY 1
 #define configUSE_16_BIT_TICKS 0
 #define configUSE_MUTEXES 1
@@ -45,6 +45,12 @@ extern uint32_t SystemCoreClock;
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 1
 #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 4
 
+/* Run time stats count core clock cycles with DWT CYCCNT, enabled by furi_hal_delay_init.
+   Per thread counter is 64 bit, 32 bit one overflows after 67 seconds of run time. */
+#define configRUN_TIME_COUNTER_TYPE uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE() (*(volatile uint32_t*)0xE0001004UL)
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 0
 
@@ -9,6 +9,12 @@
 
 #define FAST_ADV_TIMEOUT 30000
 #define INITIAL_ADV_TIMEOUT 60000
+/** Bulk transfer connection parameters are kept while transfer is active plus this time */
+#define BULK_TRANSFER_TIMEOUT 2000
+
+/** Longest link layer payload and its air time on 1M PHY, so full MTU fits in 2 packets */
+#define GAP_DATA_LENGTH_TX_OCTETS 251
+#define GAP_DATA_LENGTH_TX_TIME 2120
 
 #define GAP_INTERVAL_TO_MS(x) (uint16_t)((x)*1.25)
 
@@ -31,15 +37,22 @@ typedef struct {
     GapEventCallback on_event_cb;
     void* context;
     osTimerId_t advertise_timer;
+    osTimerId_t bulk_timer;
     FuriThread* thread;
     osMessageQueueId_t command_queue;
     bool enable_adv;
+    /** Bulk connection parameters are requested */
+    bool conn_param_bulk;
+    /** Bulk command is queued or active, set from any thread */
+    volatile bool bulk_requested;
 } Gap;
 
 typedef enum {
     GapCommandAdvFast,
     GapCommandAdvLowPower,
     GapCommandAdvStop,
+    GapCommandConnParamsBulk,
+    GapCommandConnParamsDefault,
     GapCommandKillThread,
 } GapCommand;
 
@@ -55,6 +68,12 @@ static const uint8_t gap_irk[16] =
 static const uint8_t gap_erk[16] =
     {0xfe, 0xdc, 0xba, 0x09, 0x87, 0x65, 0x43, 0x21, 0xfe, 0xdc, 0xba, 0x09, 0x87, 0x65, 0x43, 0x21};
 
+// 15 ms interval: shortest one accepted by all major centrals
+static const GapConnectionParamsRequest gap_conn_param_bulk = {
+    .conn_int_min = 0x0C,
+    .conn_int_max = 0x0C,
+};
+
 static Gap* gap = NULL;
 static GapScan* gap_scan = NULL;
 
@@ -73,7 +92,8 @@ static void gap_verify_connection_parameters(Gap* gap) {
         gap->connection_params.supervisor_timeout);
 
     // Send connection parameters request update if necessary
-    GapConnectionParamsRequest* params = &gap->config->conn_param;
+    const GapConnectionParamsRequest* params =
+        gap->conn_param_bulk ? &gap_conn_param_bulk : &gap->config->conn_param;
     if(params->conn_int_min > gap->connection_params.conn_interval ||
        params->conn_int_max < gap->connection_params.conn_interval) {
         FURI_LOG_W(TAG, "Unsupported connection interval. Request connection parameters update");
@@ -109,6 +129,7 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void* pckt) {
         if(disconnection_complete_event->Connection_Handle == gap->service.connection_handle) {
             gap->service.connection_handle = 0;
             gap->state = GapStateIdle;
+            gap->conn_param_bulk = false;
             FURI_LOG_I(
                 TAG, "Disconnect from client. Reason: %02X", disconnection_complete_event->Reason);
         }
@@ -167,10 +188,29 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void* pckt) {
             gap->service.connection_handle = event->Connection_Handle;
 
             gap_verify_connection_parameters(gap);
+            // Request longest packets, so notification doesn't take several connection events
+            ret = hci_le_set_data_length(
+                event->Connection_Handle, GAP_DATA_LENGTH_TX_OCTETS, GAP_DATA_LENGTH_TX_TIME);
+            if(ret) {
+                FURI_LOG_W(TAG, "Set data length failed, status: %d", ret);
+            }
             // Start pairing by sending security request
             aci_gap_slave_security_req(event->Connection_Handle);
             break;
 
+        case EVT_LE_DATA_LENGTH_CHANGE: {
+            hci_le_data_length_change_event_rp0* event =
+                (hci_le_data_length_change_event_rp0*)meta_evt->data;
+            FURI_LOG_I(
+                TAG,
+                "Data length: TX %d bytes (%d us), RX %d bytes (%d us)",
+                event->MaxTxOctets,
+                event->MaxTxTime,
+                event->MaxRxOctets,
+                event->MaxRxTime);
+            break;
+        }
+
         case EVT_LE_ADVERTISING_REPORT: {
             if(gap_scan) {
                 GapAddress address;
@@ -482,6 +522,25 @@ static void gap_advetise_timer_callback(void* context) {
     furi_check(osMessageQueuePut(gap->command_queue, &command, 0, 0) == osOK);
 }
 
+static void gap_bulk_timer_callback(void* context) {
+    gap->bulk_requested = false;
+    GapCommand command = GapCommandConnParamsDefault;
+    osMessageQueuePut(gap->command_queue, &command, 0, 0);
+}
+
+void gap_request_bulk_transfer() {
+    // No state mutex: called from data path, which GAP events may wait for
+    if(!gap) return;
+    osTimerStart(gap->bulk_timer, BULK_TRANSFER_TIMEOUT);
+    if(!gap->bulk_requested) {
+        gap->bulk_requested = true;
+        GapCommand command = GapCommandConnParamsBulk;
+        if(osMessageQueuePut(gap->command_queue, &command, 0, 0) != osOK) {
+            gap->bulk_requested = false;
+        }
+    }
+}
+
 bool gap_init(GapConfig* config, GapEventCallback on_event_cb, void* context) {
     if(!ble_glue_is_radio_stack_ready()) {
         return false;
@@ -492,6 +551,8 @@ bool gap_init(GapConfig* config, GapEventCallback on_event_cb, void* context) {
     srand(DWT->CYCCNT);
     // Create advertising timer
     gap->advertise_timer = osTimerNew(gap_advetise_timer_callback, osTimerOnce, NULL, NULL);
+    // Create bulk transfer timer
+    gap->bulk_timer = osTimerNew(gap_bulk_timer_callback, osTimerOnce, NULL, NULL);
     // Initialization of GATT & GAP layer
     gap->service.adv_name = config->adv_name;
     gap_init_svc(gap);
@@ -570,6 +631,9 @@ void gap_thread_stop() {
         osTimerStop(gap->advertise_timer);
         while(xTimerIsTimerActive(gap->advertise_timer) == pdTRUE) osDelay(1);
         furi_check(osTimerDelete(gap->advertise_timer) == osOK);
+        osTimerStop(gap->bulk_timer);
+        while(xTimerIsTimerActive(gap->bulk_timer) == pdTRUE) osDelay(1);
+        furi_check(osTimerDelete(gap->bulk_timer) == osOK);
         free(gap);
         gap = NULL;
     }
@@ -593,6 +657,11 @@ static int32_t gap_app(void* context) {
             gap_advertise_start(GapStateAdvLowPower);
         } else if(command == GapCommandAdvStop) {
             gap_advertise_stop();
+        } else if(command == GapCommandConnParamsBulk || command == GapCommandConnParamsDefault) {
+            gap->conn_param_bulk = (command == GapCommandConnParamsBulk);
+            if(gap->state == GapStateConnected) {
+                gap_verify_connection_parameters(gap);
+            }
         }
         osMutexRelease(gap->state_mutex);
     }
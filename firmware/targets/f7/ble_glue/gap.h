@@ -88,6 +88,13 @@ GapState gap_get_state();
 
 void gap_thread_stop();
 
+/** Request short connection interval for bulk transfer
+ *
+ * Connection parameters return to profile defaults after BULK_TRANSFER_TIMEOUT
+ * without new requests. Safe to call from any thread.
+ */
+void gap_request_bulk_transfer();
+
 void gap_start_scan(GapScanCallback callback, void* context);
 
 void gap_stop_scan();
@@ -14,6 +14,10 @@ typedef struct {
     osMutexId_t buff_size_mtx;
     uint32_t buff_size;
     uint16_t bytes_ready_to_receive;
+    /** Client subscribed to TX notifications, otherwise indications are used */
+    volatile bool tx_notify_enabled;
+    /** Indication is sent, but not confirmed by client yet */
+    volatile bool tx_indication_pending;
     SerialServiceEventCallback callback;
     void* context;
 } SerialSvc;
@@ -41,6 +45,13 @@ static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
                 // Descriptor handle
                 ret = SVCCTL_EvtAckFlowEnable;
                 FURI_LOG_D(TAG, "RX descriptor event");
+            } else if(attribute_modified->Attr_Handle == serial_svc->tx_char_handle + 2) {
+                // TX client configuration descriptor: bit 0 - notify, bit 1 - indicate
+                serial_svc->tx_notify_enabled = attribute_modified->Attr_Data_Length &&
+                                                (attribute_modified->Attr_Data[0] & 0x01);
+                FURI_LOG_D(
+                    TAG, "TX %s", serial_svc->tx_notify_enabled ? "notifications" : "indications");
+                ret = SVCCTL_EvtAckFlowEnable;
             } else if(attribute_modified->Attr_Handle == serial_svc->rx_char_handle + 1) {
                 FURI_LOG_D(TAG, "Received %d bytes", attribute_modified->Attr_Data_Length);
                 if(serial_svc->callback) {
@@ -68,6 +79,7 @@ static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
             }
         } else if(blecore_evt->ecode == ACI_GATT_SERVER_CONFIRMATION_VSEVT_CODE) {
             FURI_LOG_T(TAG, "Ack received", blecore_evt->ecode);
+            serial_svc->tx_indication_pending = false;
             if(serial_svc->callback) {
                 SerialServiceEvent event = {
                     .event = SerialServiceEventTypeDataSent,
@@ -75,6 +87,15 @@ static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
                 serial_svc->callback(event, serial_svc->context);
             }
             ret = SVCCTL_EvtAckFlowEnable;
+        } else if(blecore_evt->ecode == ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE) {
+            // Stack has free buffers again after insufficient resources on notification
+            FURI_LOG_T(TAG, "TX pool available");
+            if(serial_svc->callback) {
+                SerialServiceEvent event = {
+                    .event = SerialServiceEventTypeDataSent,
+                };
+                serial_svc->callback(event, serial_svc->context);
+            }
         }
     }
     return ret;
@@ -115,7 +136,7 @@ void serial_svc_start() {
         UUID_TYPE_128,
         (const Char_UUID_t*)char_tx_uuid,
         SERIAL_SVC_DATA_LEN_MAX,
-        CHAR_PROP_READ | CHAR_PROP_INDICATE,
+        CHAR_PROP_READ | CHAR_PROP_INDICATE | CHAR_PROP_NOTIFY,
         ATTR_PERMISSION_AUTHEN_READ,
         GATT_DONT_NOTIFY_EVENTS,
         10,
@@ -150,6 +171,9 @@ void serial_svc_set_callbacks(
     furi_assert(serial_svc);
     serial_svc->callback = callback;
     serial_svc->context = context;
+    // New connection: indications until client subscribes to notifications
+    serial_svc->tx_notify_enabled = false;
+    serial_svc->tx_indication_pending = false;
     serial_svc->buff_size = buff_size;
     serial_svc->bytes_ready_to_receive = buff_size;
     uint32_t buff_size_reversed = REVERSE_BYTES_U32(serial_svc->buff_size);
@@ -212,9 +236,19 @@ bool serial_svc_is_started() {
     return serial_svc != NULL;
 }
 
-bool serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
+SerialServiceTxStatus serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
     if(data_len > SERIAL_SVC_DATA_LEN_MAX) {
-        return false;
+        return SerialServiceTxStatusError;
+    }
+
+    // Indications are acknowledged one by one, notifications are limited by stack buffers only
+    bool notify = serial_svc->tx_notify_enabled;
+    if(!notify) {
+        if(serial_svc->tx_indication_pending) {
+            return SerialServiceTxStatusBusy;
+        }
+        // Set before update: confirmation may arrive before update returns
+        serial_svc->tx_indication_pending = true;
     }
 
     for(uint16_t remained = data_len; remained > 0;) {
@@ -226,17 +260,24 @@ bool serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
             0,
             serial_svc->svc_handle,
             serial_svc->tx_char_handle,
-            remained ? 0x00 : 0x02,
+            remained ? 0x00 : (notify ? 0x01 : 0x02),
             data_len,
             value_offset,
             value_len,
             data + value_offset);
 
         if(result) {
+            if(!notify) {
+                serial_svc->tx_indication_pending = false;
+            }
+            if(result == BLE_STATUS_INSUFFICIENT_RESOURCES) {
+                // ACI_GATT_TX_POOL_AVAILABLE event follows
+                return SerialServiceTxStatusBusy;
+            }
             FURI_LOG_E(TAG, "Failed updating TX characteristic: %d", result);
-            return false;
+            return SerialServiceTxStatusError;
         }
     }
 
-    return true;
+    return SerialServiceTxStatusOk;
 }
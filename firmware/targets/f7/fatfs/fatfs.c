@@ -17,6 +17,7 @@
   */
 
 #include "fatfs.h"
+#include <furi_hal_rtc.h>
 
 uint8_t retUSER; /* Return value for USER */
 char USERPath[4]; /* USER logical drive path */
@@ -43,7 +44,11 @@ void MX_FATFS_Init(void) {
   */
 DWORD get_fattime(void) {
     /* USER CODE BEGIN get_fattime */
-    return 0;
+    FuriHalRtcDateTime datetime;
+    furi_hal_rtc_get_datetime(&datetime);
+    return ((DWORD)(datetime.year - 1980) << 25) | ((DWORD)datetime.month << 21) |
+           ((DWORD)datetime.day << 16) | ((DWORD)datetime.hour << 11) |
+           ((DWORD)datetime.minute << 5) | (datetime.second / 2);
     /* USER CODE END get_fattime */
 }
 
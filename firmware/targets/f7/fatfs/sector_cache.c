@@ -0,0 +1,229 @@
+#include "sector_cache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <furi/check.h>
+
+typedef struct {
+    uint32_t sector;
+    uint32_t last_use;
+    bool valid;
+    bool dirty;
+    uint8_t* data;
+} SectorCacheLine;
+
+struct SectorCache {
+    size_t sets;
+    size_t ways;
+    SectorCacheLine* lines;
+    uint8_t* data;
+    uint32_t use_counter;
+
+    uint32_t priority_start;
+    uint32_t priority_end;
+
+    SectorCacheReadCallback read;
+    SectorCacheWriteCallback write;
+    void* context;
+
+    SectorCacheStats stats;
+};
+
+SectorCache* sector_cache_alloc(
+    size_t sets,
+    size_t ways,
+    SectorCacheReadCallback read,
+    SectorCacheWriteCallback write,
+    void* context) {
+    furi_assert(sets > 0);
+    furi_assert(ways > 0);
+    furi_assert(read);
+    furi_assert(write);
+
+    SectorCache* cache = malloc(sizeof(SectorCache));
+    memset(cache, 0, sizeof(SectorCache));
+    cache->sets = sets;
+    cache->ways = ways;
+    cache->read = read;
+    cache->write = write;
+    cache->context = context;
+
+    cache->lines = malloc(sets * ways * sizeof(SectorCacheLine));
+    cache->data = malloc(sets * ways * SECTOR_CACHE_SECTOR_SIZE);
+    for(size_t i = 0; i < sets * ways; i++) {
+        cache->lines[i].valid = false;
+        cache->lines[i].dirty = false;
+        cache->lines[i].data = &cache->data[i * SECTOR_CACHE_SECTOR_SIZE];
+    }
+
+    return cache;
+}
+
+void sector_cache_free(SectorCache* cache) {
+    furi_assert(cache);
+    free(cache->data);
+    free(cache->lines);
+    free(cache);
+}
+
+static SectorCacheLine* sector_cache_get_set(SectorCache* cache, uint32_t sector) {
+    return &cache->lines[(sector % cache->sets) * cache->ways];
+}
+
+static SectorCacheLine* sector_cache_find(SectorCache* cache, uint32_t sector) {
+    SectorCacheLine* set = sector_cache_get_set(cache, sector);
+    for(size_t i = 0; i < cache->ways; i++) {
+        if(set[i].valid && set[i].sector == sector) return &set[i];
+    }
+    return NULL;
+}
+
+static bool sector_cache_is_priority(SectorCache* cache, uint32_t sector) {
+    return sector >= cache->priority_start && sector < cache->priority_end;
+}
+
+static bool sector_cache_line_write_back(SectorCache* cache, SectorCacheLine* line) {
+    if(!line->dirty) return true;
+    if(!cache->write(cache->context, line->data, line->sector, 1)) return false;
+    line->dirty = false;
+    cache->stats.writebacks++;
+    return true;
+}
+
+/** Pick line for sector: free one, else least recently used, sparing priority
+ * sectors unless incoming sector is priority itself or set holds nothing else
+ */
+static SectorCacheLine* sector_cache_get_victim(SectorCache* cache, uint32_t sector) {
+    SectorCacheLine* set = sector_cache_get_set(cache, sector);
+    bool incoming_priority = sector_cache_is_priority(cache, sector);
+    SectorCacheLine* victim = NULL;
+    SectorCacheLine* victim_priority = NULL;
+
+    for(size_t i = 0; i < cache->ways; i++) {
+        SectorCacheLine* line = &set[i];
+        if(!line->valid) return line;
+        if(!incoming_priority && sector_cache_is_priority(cache, line->sector)) {
+            if(!victim_priority || line->last_use < victim_priority->last_use) {
+                victim_priority = line;
+            }
+        } else if(!victim || line->last_use < victim->last_use) {
+            victim = line;
+        }
+    }
+
+    return victim ? victim : victim_priority;
+}
+
+static SectorCacheLine* sector_cache_allocate(SectorCache* cache, uint32_t sector) {
+    SectorCacheLine* line = sector_cache_get_victim(cache, sector);
+    if(line->valid) {
+        if(!sector_cache_line_write_back(cache, line)) return NULL;
+        cache->stats.evictions++;
+    }
+    line->valid = false;
+    line->sector = sector;
+    return line;
+}
+
+static void sector_cache_touch(SectorCache* cache, SectorCacheLine* line) {
+    line->last_use = ++cache->use_counter;
+}
+
+bool sector_cache_read(SectorCache* cache, uint8_t* buff, uint32_t sector, uint32_t count) {
+    furi_assert(cache);
+    furi_assert(buff);
+
+    if(count == 1) {
+        SectorCacheLine* line = sector_cache_find(cache, sector);
+        if(line) {
+            cache->stats.hits++;
+        } else {
+            cache->stats.misses++;
+            line = sector_cache_allocate(cache, sector);
+            if(!line) return false;
+            if(!cache->read(cache->context, line->data, sector, 1)) return false;
+            line->valid = true;
+            line->dirty = false;
+        }
+        sector_cache_touch(cache, line);
+        memcpy(buff, line->data, SECTOR_CACHE_SECTOR_SIZE);
+        return true;
+    }
+
+    // Bulk transfers are not cached to keep cache for metadata
+    cache->stats.bypassed++;
+    if(!cache->read(cache->context, buff, sector, count)) return false;
+    for(uint32_t i = 0; i < count; i++) {
+        SectorCacheLine* line = sector_cache_find(cache, sector + i);
+        if(line && line->dirty) {
+            memcpy(&buff[i * SECTOR_CACHE_SECTOR_SIZE], line->data, SECTOR_CACHE_SECTOR_SIZE);
+        }
+    }
+    return true;
+}
+
+bool sector_cache_write(SectorCache* cache, const uint8_t* buff, uint32_t sector, uint32_t count) {
+    furi_assert(cache);
+    furi_assert(buff);
+
+    if(count == 1) {
+        SectorCacheLine* line = sector_cache_find(cache, sector);
+        if(line) {
+            cache->stats.hits++;
+        } else {
+            cache->stats.misses++;
+            line = sector_cache_allocate(cache, sector);
+            if(!line) return false;
+        }
+        memcpy(line->data, buff, SECTOR_CACHE_SECTOR_SIZE);
+        line->valid = true;
+        line->dirty = true;
+        sector_cache_touch(cache, line);
+        return true;
+    }
+
+    cache->stats.bypassed++;
+    if(!cache->write(cache->context, buff, sector, count)) return false;
+    for(uint32_t i = 0; i < count; i++) {
+        SectorCacheLine* line = sector_cache_find(cache, sector + i);
+        if(line) {
+            memcpy(line->data, &buff[i * SECTOR_CACHE_SECTOR_SIZE], SECTOR_CACHE_SECTOR_SIZE);
+            line->dirty = false;
+        }
+    }
+    return true;
+}
+
+bool sector_cache_flush(SectorCache* cache) {
+    furi_assert(cache);
+    bool result = true;
+    for(size_t i = 0; i < cache->sets * cache->ways; i++) {
+        SectorCacheLine* line = &cache->lines[i];
+        if(line->valid && !sector_cache_line_write_back(cache, line)) {
+            result = false;
+        }
+    }
+    return result;
+}
+
+void sector_cache_reset(SectorCache* cache) {
+    furi_assert(cache);
+    for(size_t i = 0; i < cache->sets * cache->ways; i++) {
+        cache->lines[i].valid = false;
+        cache->lines[i].dirty = false;
+    }
+    cache->priority_start = 0;
+    cache->priority_end = 0;
+}
+
+void sector_cache_set_priority(SectorCache* cache, uint32_t start, uint32_t end) {
+    furi_assert(cache);
+    furi_assert(start <= end);
+    cache->priority_start = start;
+    cache->priority_end = end;
+}
+
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats) {
+    furi_assert(cache);
+    furi_assert(stats);
+    *stats = cache->stats;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file sector_cache.h
+ * Set associative write-back sector cache for block devices
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SECTOR_CACHE_SECTOR_SIZE 512
+
+typedef struct SectorCache SectorCache;
+
+/** Device access callback, returns true on success */
+typedef bool (*SectorCacheReadCallback)(void* context, uint8_t* buff, uint32_t sector, uint32_t count);
+typedef bool (
+    *SectorCacheWriteCallback)(void* context, const uint8_t* buff, uint32_t sector, uint32_t count);
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t bypassed;
+    uint32_t evictions;
+    uint32_t writebacks;
+} SectorCacheStats;
+
+/** Allocate cache
+ *
+ * @param      sets      number of sets, sector N goes to set N % sets
+ * @param      ways      number of lines in set
+ * @param      read      device read callback
+ * @param      write     device write callback
+ * @param      context   callbacks context
+ *
+ * @return     SectorCache instance
+ */
+SectorCache* sector_cache_alloc(
+    size_t sets,
+    size_t ways,
+    SectorCacheReadCallback read,
+    SectorCacheWriteCallback write,
+    void* context);
+
+/** Free cache, dirty lines are dropped
+ *
+ * @param      cache     SectorCache instance
+ */
+void sector_cache_free(SectorCache* cache);
+
+/** Read sectors
+ *
+ * Single sector reads are cached, multi sector reads go to device and are
+ * patched with dirty cached sectors.
+ *
+ * @param      cache     SectorCache instance
+ * @param      buff      destination, count * SECTOR_CACHE_SECTOR_SIZE bytes
+ * @param      sector    first sector
+ * @param      count     sectors count
+ *
+ * @return     true on success
+ */
+bool sector_cache_read(SectorCache* cache, uint8_t* buff, uint32_t sector, uint32_t count);
+
+/** Write sectors
+ *
+ * Single sector writes stay in cache until eviction or flush, multi sector
+ * writes go to device and update cached copies.
+ *
+ * @param      cache     SectorCache instance
+ * @param      buff      source, count * SECTOR_CACHE_SECTOR_SIZE bytes
+ * @param      sector    first sector
+ * @param      count     sectors count
+ *
+ * @return     true on success
+ */
+bool sector_cache_write(SectorCache* cache, const uint8_t* buff, uint32_t sector, uint32_t count);
+
+/** Write all dirty sectors to device
+ *
+ * @param      cache     SectorCache instance
+ *
+ * @return     true on success
+ */
+bool sector_cache_flush(SectorCache* cache);
+
+/** Drop all cached sectors including dirty ones, use on media change
+ *
+ * @param      cache     SectorCache instance
+ */
+void sector_cache_reset(SectorCache* cache);
+
+/** Set priority sectors: they are evicted only when set has no other choice
+ *
+ * @param      cache     SectorCache instance
+ * @param      start     first priority sector
+ * @param      end       sector after last priority sector, equal to start to disable
+ */
+void sector_cache_set_priority(SectorCache* cache, uint32_t start, uint32_t end);
+
+/** Get statistics
+ *
+ * @param      cache     SectorCache instance
+ * @param      stats     SectorCacheStats to fill
+ */
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
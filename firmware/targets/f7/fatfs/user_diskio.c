@@ -42,6 +42,46 @@
 /* Private variables ---------------------------------------------------------*/
 /* Disk status */
 static volatile DSTATUS Stat = STA_NOINIT;
+/* Sector cache, allocated on first initialization */
+static SectorCache* Cache = NULL;
+
+static bool User_ReadBlocks(void* context, uint8_t* buff, uint32_t sector, uint32_t count) {
+    bool result = false;
+
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
+    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
+
+    if(BSP_SD_ReadBlocks((uint32_t*)buff, sector, count, SD_DATATIMEOUT) == MSD_OK) {
+        /* wait until the read operation is finished */
+        while(BSP_SD_GetCardState() != MSD_OK) {
+        }
+        result = true;
+    }
+
+    furi_hal_sd_spi_handle = NULL;
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
+
+    return result;
+}
+
+static bool User_WriteBlocks(void* context, const uint8_t* buff, uint32_t sector, uint32_t count) {
+    bool result = false;
+
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
+    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
+
+    if(BSP_SD_WriteBlocks((uint32_t*)buff, sector, count, SD_DATATIMEOUT) == MSD_OK) {
+        /* wait until the Write operation is finished */
+        while(BSP_SD_GetCardState() != MSD_OK) {
+        }
+        result = true;
+    }
+
+    furi_hal_sd_spi_handle = NULL;
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
+
+    return result;
+}
 
 static DSTATUS User_CheckStatus(BYTE lun) {
     Stat = STA_NOINIT;
@@ -95,6 +135,13 @@ DSTATUS USER_initialize(BYTE pdrv) {
     furi_hal_sd_spi_handle = NULL;
     furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
 
+    /* Card may have been changed: cached sectors are not valid anymore */
+    if(!Cache) {
+        Cache = sector_cache_alloc(
+            USER_CACHE_SETS, USER_CACHE_WAYS, User_ReadBlocks, User_WriteBlocks, NULL);
+    }
+    sector_cache_reset(Cache);
+
     return status;
     /* USER CODE END INIT */
 }
@@ -120,22 +167,11 @@ DSTATUS USER_status(BYTE pdrv) {
   */
 DRESULT USER_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
     /* USER CODE BEGIN READ */
-    DRESULT res = RES_ERROR;
-
-    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
-    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
-
-    if(BSP_SD_ReadBlocks((uint32_t*)buff, (uint32_t)(sector), count, SD_DATATIMEOUT) == MSD_OK) {
-        /* wait until the read operation is finished */
-        while(BSP_SD_GetCardState() != MSD_OK) {
-        }
-        res = RES_OK;
+    if(sector_cache_read(Cache, buff, sector, count)) {
+        return RES_OK;
     }
 
-    furi_hal_sd_spi_handle = NULL;
-    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
-
-    return res;
+    return RES_ERROR;
     /* USER CODE END READ */
 }
 
@@ -151,22 +187,11 @@ DRESULT USER_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
 DRESULT USER_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
     /* USER CODE BEGIN WRITE */
     /* USER CODE HERE */
-    DRESULT res = RES_ERROR;
-
-    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
-    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
-
-    if(BSP_SD_WriteBlocks((uint32_t*)buff, (uint32_t)(sector), count, SD_DATATIMEOUT) == MSD_OK) {
-        /* wait until the Write operation is finished */
-        while(BSP_SD_GetCardState() != MSD_OK) {
-        }
-        res = RES_OK;
+    if(sector_cache_write(Cache, buff, sector, count)) {
+        return RES_OK;
     }
 
-    furi_hal_sd_spi_handle = NULL;
-    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
-
-    return res;
+    return RES_ERROR;
     /* USER CODE END WRITE */
 }
 #endif /* _USE_WRITE == 1 */
@@ -186,15 +211,15 @@ DRESULT USER_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
 
     if(Stat & STA_NOINIT) return RES_NOTRDY;
 
+    /* Make sure that no pending write process */
+    if(cmd == CTRL_SYNC) {
+        return sector_cache_flush(Cache) ? RES_OK : RES_ERROR;
+    }
+
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
     furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
 
     switch(cmd) {
-    /* Make sure that no pending write process */
-    case CTRL_SYNC:
-        res = RES_OK;
-        break;
-
     /* Get number of sectors on the disk (DWORD) */
     case GET_SECTOR_COUNT:
         BSP_SD_GetCardInfo(&CardInfo);
@@ -228,4 +253,16 @@ DRESULT USER_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
 }
 #endif /* _USE_IOCTL == 1 */
 
+/* USER CODE BEGIN CACHE */
+void user_diskio_cache_set_priority(uint32_t start, uint32_t end) {
+    if(Cache) sector_cache_set_priority(Cache, start, end);
+}
+
+bool user_diskio_cache_get_stats(SectorCacheStats* stats) {
+    if(!Cache) return false;
+    sector_cache_get_stats(Cache, stats);
+    return true;
+}
+/* USER CODE END CACHE */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
\ No newline at end of file
@@ -32,11 +32,25 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "stm32_adafruit_sd.h"
 #include "fatfs/ff_gen_drv.h"
+#include "sector_cache.h"
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+/* Sector cache geometry, USER_CACHE_SETS * USER_CACHE_WAYS * 512 bytes of RAM */
+#ifndef USER_CACHE_SETS
+#define USER_CACHE_SETS 4
+#endif
+#ifndef USER_CACHE_WAYS
+#define USER_CACHE_WAYS 2
+#endif
 /* Exported functions ------------------------------------------------------- */
 extern Diskio_drvTypeDef USER_Driver;
 
+/** Keep sectors [start, end) in cache preferably, meant for FAT and root directory */
+void user_diskio_cache_set_priority(uint32_t start, uint32_t end);
+
+/** Get sector cache statistics, false if cache is not allocated yet */
+bool user_diskio_cache_get_stats(SectorCacheStats* stats);
+
 /* USER CODE END 0 */
 
 #ifdef __cplusplus
@@ -264,6 +264,10 @@ void furi_hal_bt_stop_advertising() {
     }
 }
 
+void furi_hal_bt_request_bulk_transfer() {
+    gap_request_bulk_transfer();
+}
+
 void furi_hal_bt_update_battery_level(uint8_t battery_level) {
     if(battery_svc_is_started()) {
         battery_svc_update_level(battery_level);
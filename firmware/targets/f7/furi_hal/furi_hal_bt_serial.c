@@ -31,9 +31,9 @@ void furi_hal_bt_serial_notify_buffer_is_empty() {
     serial_svc_notify_buffer_is_empty();
 }
 
-bool furi_hal_bt_serial_tx(uint8_t* data, uint16_t size) {
+FuriHalBtSerialTxStatus furi_hal_bt_serial_tx(uint8_t* data, uint16_t size) {
     if(size > FURI_HAL_BT_SERIAL_PACKET_SIZE_MAX) {
-        return false;
+        return SerialServiceTxStatusError;
     }
     return serial_svc_update_tx(data, size);
 }
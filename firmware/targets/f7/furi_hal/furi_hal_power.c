@@ -21,10 +21,18 @@ typedef struct {
     volatile uint8_t insomnia;
     volatile uint8_t deep_insomnia;
     volatile uint8_t suppress_charge;
+
+    FuriHalPowerEventCallback event_callback;
+    void* event_context;
 } FuriHalPower;
 
 static volatile FuriHalPower furi_hal_power = {
+#ifdef FURI_TRACE
+    // Trace timestamps come from cycle counter, it stops in STOP mode
+    .insomnia = 1,
+#else
     .insomnia = 0,
+#endif
     .deep_insomnia = 1,
     .suppress_charge = 0,
 };
@@ -199,16 +207,29 @@ void furi_hal_power_reset() {
     NVIC_SystemReset();
 }
 
+static void furi_hal_power_notify() {
+    FURI_CRITICAL_ENTER();
+    FuriHalPowerEventCallback callback = furi_hal_power.event_callback;
+    void* context = furi_hal_power.event_context;
+    FURI_CRITICAL_EXIT();
+
+    if(callback) {
+        callback(context);
+    }
+}
+
 void furi_hal_power_enable_otg() {
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
     bq25896_enable_otg(&furi_hal_i2c_handle_power);
     furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+    furi_hal_power_notify();
 }
 
 void furi_hal_power_disable_otg() {
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
     bq25896_disable_otg(&furi_hal_i2c_handle_power);
     furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+    furi_hal_power_notify();
 }
 
 bool furi_hal_power_is_otg_enabled() {
@@ -274,14 +295,24 @@ float furi_hal_power_get_battery_current(FuriHalPowerIC ic) {
     return ret;
 }
 
+static float furi_hal_power_charger_temperature(uint32_t ntc_mpct) {
+    // Linear approximation, +/- 5 C
+    return (71.0f - (float)ntc_mpct / 1000) / 0.6f;
+}
+
+static float furi_hal_power_gauge_temperature(uint16_t temperature) {
+    return ((float)temperature - 2731.0f) / 10.0f;
+}
+
 static float furi_hal_power_get_battery_temperature_internal(FuriHalPowerIC ic) {
     float ret = 0.0f;
 
     if(ic == FuriHalPowerICCharger) {
-        // Linear approximation, +/- 5 C
-        ret = (71.0f - (float)bq25896_get_ntc_mpct(&furi_hal_i2c_handle_power) / 1000) / 0.6f;
+        ret = furi_hal_power_charger_temperature(
+            bq25896_get_ntc_mpct(&furi_hal_i2c_handle_power));
     } else if(ic == FuriHalPowerICFuelGauge) {
-        ret = ((float)bq27220_get_temperature(&furi_hal_i2c_handle_power) - 2731.0f) / 10.0f;
+        ret = furi_hal_power_gauge_temperature(
+            bq27220_get_temperature(&furi_hal_i2c_handle_power));
     }
 
     return ret;
@@ -302,6 +333,43 @@ float furi_hal_power_get_usb_voltage() {
     return ret;
 }
 
+bool furi_hal_power_read(FuriHalPowerReadout* readout) {
+    furi_assert(readout);
+    GaugeData gauge;
+    ChargerData charger;
+
+    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
+    bool ret = bq27220_get_data(&furi_hal_i2c_handle_power, &gauge) &&
+               bq25896_get_data(&furi_hal_i2c_handle_power, &charger);
+    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+
+    if(ret) {
+        readout->is_charging = charger.is_charging;
+        readout->is_otg_enabled = charger.is_otg_enabled;
+        readout->is_otg_fault = charger.is_otg_fault;
+        readout->charge = gauge.state_of_charge;
+        readout->health = gauge.state_of_health;
+        readout->capacity_remaining = gauge.remaining_capacity;
+        readout->capacity_full = gauge.full_charge_capacity;
+        readout->current_charger = (float)charger.vbat_current / 1000.0f;
+        readout->current_gauge = (float)gauge.current / 1000.0f;
+        readout->voltage_charger = (float)charger.vbat_voltage / 1000.0f;
+        readout->voltage_gauge = (float)gauge.voltage / 1000.0f;
+        readout->voltage_vbus = (float)charger.vbus_voltage / 1000.0f;
+        readout->temperature_charger = furi_hal_power_charger_temperature(charger.ntc_mpct);
+        readout->temperature_gauge = furi_hal_power_gauge_temperature(gauge.temperature);
+    }
+
+    return ret;
+}
+
+void furi_hal_power_set_event_callback(FuriHalPowerEventCallback callback, void* context) {
+    FURI_CRITICAL_ENTER();
+    furi_hal_power.event_callback = callback;
+    furi_hal_power.event_context = context;
+    FURI_CRITICAL_EXIT();
+}
+
 void furi_hal_power_dump_state() {
     BatteryStatus battery_status;
     OperationStatus operation_status;
@@ -391,6 +459,7 @@ void furi_hal_power_suppress_charge_enter() {
         furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
         bq25896_disable_charging(&furi_hal_i2c_handle_power);
         furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+        furi_hal_power_notify();
     }
 }
 
@@ -404,6 +473,7 @@ void furi_hal_power_suppress_charge_exit() {
         furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
         bq25896_enable_charging(&furi_hal_i2c_handle_power);
         furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+        furi_hal_power_notify();
     }
 }
 
@@ -0,0 +1,269 @@
+#include <furi_hal_profiler.h>
+#include <furi_hal_power.h>
+#include <task_control_block.h>
+
+#include <stm32wbxx_ll_lptim.h>
+#include <stm32wbxx_ll_rcc.h>
+#include <stm32wbxx_ll_system.h>
+
+#include <furi.h>
+
+#define TAG "FuriHalProfiler"
+
+#define FURI_HAL_PROFILER_TIMER LPTIM1
+#define FURI_HAL_PROFILER_TIMER_IRQ LPTIM1_IRQn
+#define FURI_HAL_PROFILER_TIMER_CLK 32768
+
+// Above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY: samples land inside critical sections and
+// other ISRs. Sample ISR must not call kernel API because of that.
+#define FURI_HAL_PROFILER_IRQ_PRIORITY 1
+
+#define FURI_HAL_PROFILER_SAMPLES_MASK (FURI_HAL_PROFILER_SAMPLES - 1)
+#define FURI_HAL_PROFILER_DUMP_CHUNK 512
+
+// EXC_RETURN bits: return to thread mode, return with process stack
+#define FURI_HAL_PROFILER_EXC_RETURN_THREAD (1 << 3)
+// xPSR bits holding exception number of stacked context
+#define FURI_HAL_PROFILER_XPSR_EXCEPTION 0x1FF
+
+typedef struct {
+    FuriHalProfilerSample* samples;
+    // Written by sample ISR only
+    volatile uint32_t head;
+    volatile uint32_t dropped;
+    // Written by dump only
+    volatile uint32_t tail;
+    uint32_t dropped_reported;
+
+    uint32_t rate;
+    uint32_t start_tick;
+    bool running;
+    // One dump at a time, CLI and RPC may ask together
+    volatile bool draining;
+} FuriHalProfiler;
+
+static FuriHalProfiler furi_hal_profiler = {0};
+
+typedef struct {
+    FuriHalProfilerDumpCallback callback;
+    void* context;
+    uint8_t* buffer;
+    size_t size;
+} FuriHalProfilerDump;
+
+void furi_hal_profiler_isr(const uint32_t* frame, uint32_t exc_return);
+
+// Exception frame is on the stack that was active when timer fired: r0-r3, r12, lr, pc, xpsr
+void LPTIM1_IRQHandler(void) __attribute__((naked));
+void LPTIM1_IRQHandler(void) {
+    asm volatile("tst lr, #4                \n"
+                 "ite eq                    \n"
+                 "mrseq r0, msp             \n"
+                 "mrsne r0, psp             \n"
+                 "mov r1, lr                \n"
+                 "b furi_hal_profiler_isr   \n");
+}
+
+void furi_hal_profiler_isr(const uint32_t* frame, uint32_t exc_return) {
+    if(!LL_LPTIM_IsActiveFlag_ARRM(FURI_HAL_PROFILER_TIMER)) return;
+    LL_LPTIM_ClearFLAG_ARRM(FURI_HAL_PROFILER_TIMER);
+
+    uint32_t head = furi_hal_profiler.head;
+    if(head - furi_hal_profiler.tail >= FURI_HAL_PROFILER_SAMPLES) {
+        furi_hal_profiler.dropped++;
+        return;
+    }
+
+    FuriHalProfilerSample* sample =
+        &furi_hal_profiler.samples[head & FURI_HAL_PROFILER_SAMPLES_MASK];
+    sample->lr = frame[5];
+    sample->pc = frame[6];
+    if(exc_return & FURI_HAL_PROFILER_EXC_RETURN_THREAD) {
+        // Plain read of current TCB pointer, safe at any priority
+        sample->context = (uint32_t)xTaskGetCurrentTaskHandle();
+    } else {
+        sample->context = frame[7] & FURI_HAL_PROFILER_XPSR_EXCEPTION;
+    }
+
+    // Sample must be in memory before dump can see it
+    __DMB();
+    furi_hal_profiler.head = head + 1;
+}
+
+static void furi_hal_profiler_timer_start(uint32_t reload) {
+    LL_DBGMCU_APB1_GRP1_FreezePeriph(LL_DBGMCU_APB1_GRP1_LPTIM1_STOP);
+    LL_RCC_SetLPTIMClockSource(LL_RCC_LPTIM1_CLKSOURCE_LSE);
+
+    // Interrupt enable register can be changed only while timer is disabled
+    LL_LPTIM_EnableIT_ARRM(FURI_HAL_PROFILER_TIMER);
+    LL_LPTIM_Enable(FURI_HAL_PROFILER_TIMER);
+    while(!LL_LPTIM_IsEnabled(FURI_HAL_PROFILER_TIMER))
+        ;
+    LL_LPTIM_SetAutoReload(FURI_HAL_PROFILER_TIMER, reload - 1);
+    LL_LPTIM_StartCounter(FURI_HAL_PROFILER_TIMER, LL_LPTIM_OPERATING_MODE_CONTINUOUS);
+
+    NVIC_SetPriority(
+        FURI_HAL_PROFILER_TIMER_IRQ,
+        NVIC_EncodePriority(NVIC_GetPriorityGrouping(), FURI_HAL_PROFILER_IRQ_PRIORITY, 0));
+    NVIC_EnableIRQ(FURI_HAL_PROFILER_TIMER_IRQ);
+}
+
+static void furi_hal_profiler_timer_stop() {
+    NVIC_DisableIRQ(FURI_HAL_PROFILER_TIMER_IRQ);
+    // The only reliable way to stop LPTIM according to errata
+    LL_LPTIM_DeInit(FURI_HAL_PROFILER_TIMER);
+    NVIC_ClearPendingIRQ(FURI_HAL_PROFILER_TIMER_IRQ);
+}
+
+static void furi_hal_profiler_reset_runtime() {
+    vTaskSuspendAll();
+    UBaseType_t count = uxTaskGetNumberOfTasks();
+    TaskStatus_t* status = pvPortMalloc(count * sizeof(TaskStatus_t));
+    if(status) {
+        count = uxTaskGetSystemState(status, count, NULL);
+        for(UBaseType_t i = 0; i < count; i++) {
+            ((TaskControlBlock*)status[i].xHandle)->ulRunTimeCounter = 0;
+        }
+    }
+    xTaskResumeAll();
+    vPortFree(status);
+}
+
+bool furi_hal_profiler_start(uint32_t rate) {
+    if(furi_hal_profiler.running || furi_hal_profiler.draining) return false;
+    if(rate < FURI_HAL_PROFILER_RATE_MIN || rate > FURI_HAL_PROFILER_RATE_MAX) return false;
+
+    if(!furi_hal_profiler.samples) {
+        furi_hal_profiler.samples =
+            malloc(sizeof(FuriHalProfilerSample) * FURI_HAL_PROFILER_SAMPLES);
+    }
+    furi_hal_profiler.head = 0;
+    furi_hal_profiler.tail = 0;
+    furi_hal_profiler.dropped = 0;
+    furi_hal_profiler.dropped_reported = 0;
+
+    // Odd period: OS tick runs from the same clock, even one may lock samples in phase with it
+    uint32_t reload = (FURI_HAL_PROFILER_TIMER_CLK / rate) | 1;
+    furi_hal_profiler.rate = FURI_HAL_PROFILER_TIMER_CLK / reload;
+
+    furi_hal_profiler_reset_runtime();
+    furi_hal_profiler.start_tick = osKernelGetTickCount();
+    furi_hal_profiler.running = true;
+
+    // Core clock must run all the time, it is the unit of thread run time
+    furi_hal_power_insomnia_enter();
+    furi_hal_profiler_timer_start(reload);
+
+    FURI_LOG_I(TAG, "Started at %luHz", furi_hal_profiler.rate);
+    return true;
+}
+
+void furi_hal_profiler_stop() {
+    if(!furi_hal_profiler.running) return;
+
+    furi_hal_profiler_timer_stop();
+    furi_hal_power_insomnia_exit();
+    furi_hal_profiler.running = false;
+
+    FURI_LOG_I(TAG, "Stopped");
+}
+
+bool furi_hal_profiler_is_running() {
+    return furi_hal_profiler.running;
+}
+
+static void
+    furi_hal_profiler_dump_write(FuriHalProfilerDump* dump, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    while(size) {
+        if(dump->size == FURI_HAL_PROFILER_DUMP_CHUNK) {
+            dump->callback(dump->buffer, dump->size, false, dump->context);
+            dump->size = 0;
+        }
+        size_t chunk = MIN(size, FURI_HAL_PROFILER_DUMP_CHUNK - dump->size);
+        memcpy(&dump->buffer[dump->size], bytes, chunk);
+        dump->size += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+static UBaseType_t furi_hal_profiler_get_threads(TaskStatus_t** status) {
+    vTaskSuspendAll();
+    UBaseType_t count = uxTaskGetNumberOfTasks();
+    *status = pvPortMalloc(count * sizeof(TaskStatus_t));
+    if(*status) {
+        count = uxTaskGetSystemState(*status, count, NULL);
+    } else {
+        count = 0;
+    }
+    xTaskResumeAll();
+    return count;
+}
+
+bool furi_hal_profiler_dump(FuriHalProfilerDumpCallback callback, void* context) {
+    furi_assert(callback);
+    if(__atomic_exchange_n(&furi_hal_profiler.draining, true, __ATOMIC_ACQUIRE)) return false;
+    if(!furi_hal_profiler.samples) {
+        __atomic_store_n(&furi_hal_profiler.draining, false, __ATOMIC_RELEASE);
+        return false;
+    }
+
+    FuriHalProfilerDump dump = {
+        .callback = callback,
+        .context = context,
+        .buffer = malloc(FURI_HAL_PROFILER_DUMP_CHUNK),
+        .size = 0,
+    };
+
+    TaskStatus_t* status;
+    UBaseType_t thread_count = furi_hal_profiler_get_threads(&status);
+
+    // Samples coming after this point go to the next dump
+    uint32_t tail = furi_hal_profiler.tail;
+    uint32_t sample_count = furi_hal_profiler.head - tail;
+    uint32_t dropped = furi_hal_profiler.dropped;
+
+    FuriHalProfilerHeader header = {
+        .magic = FURI_HAL_PROFILER_DUMP_MAGIC,
+        .version = FURI_HAL_PROFILER_DUMP_VERSION,
+        .thread_count = thread_count,
+        .core_clock = SystemCoreClock,
+        .rate = furi_hal_profiler.rate,
+        .duration = (osKernelGetTickCount() - furi_hal_profiler.start_tick) * 1000 /
+                    osKernelGetTickFreq(),
+        .sample_count = sample_count,
+        .dropped = dropped - furi_hal_profiler.dropped_reported,
+    };
+    furi_hal_profiler.dropped_reported = dropped;
+    furi_hal_profiler_dump_write(&dump, &header, sizeof(FuriHalProfilerHeader));
+
+    for(UBaseType_t i = 0; i < thread_count; i++) {
+        FuriHalProfilerThread thread = {
+            .id = (uint32_t)status[i].xHandle,
+            .runtime = status[i].ulRunTimeCounter,
+        };
+        strncpy(thread.name, status[i].pcTaskName, FURI_HAL_PROFILER_THREAD_NAME_SIZE);
+        furi_hal_profiler_dump_write(&dump, &thread, sizeof(FuriHalProfilerThread));
+    }
+    vPortFree(status);
+
+    for(uint32_t i = 0; i < sample_count; i++) {
+        furi_hal_profiler_dump_write(
+            &dump,
+            &furi_hal_profiler.samples[(tail + i) & FURI_HAL_PROFILER_SAMPLES_MASK],
+            sizeof(FuriHalProfilerSample));
+        // Free slot as soon as sample is copied, slow transport shouldn't cause drops
+        furi_hal_profiler.tail = tail + i + 1;
+    }
+    callback(dump.buffer, dump.size, true, context);
+    free(dump.buffer);
+
+    if(!furi_hal_profiler.running) {
+        free(furi_hal_profiler.samples);
+        furi_hal_profiler.samples = NULL;
+    }
+
+    __atomic_store_n(&furi_hal_profiler.draining, false, __ATOMIC_RELEASE);
+    return true;
+}
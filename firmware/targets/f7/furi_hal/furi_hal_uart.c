@@ -1,9 +1,12 @@
 #include <furi_hal_uart.h>
+#include <furi_hal_uart_dma_rx.h>
 #include <stdbool.h>
 #include <stm32wbxx_ll_lpuart.h>
 #include <stm32wbxx_ll_usart.h>
 #include <stm32wbxx_ll_rcc.h>
+#include <stm32wbxx_ll_dma.h>
 #include <furi_hal_resources.h>
+#include <furi_hal_interrupt.h>
 
 #include <furi.h>
 #include <furi_hal_delay.h>
@@ -11,6 +14,20 @@
 static void (*irq_cb[2])(uint8_t ev, uint8_t data, void* context);
 static void* irq_ctx[2];
 
+#define FURI_HAL_UART_DMA DMA2
+
+static FuriHalUartDmaRx dma_rx[2];
+
+static const uint32_t dma_rx_channel[2] = {
+    [FuriHalUartIdUSART1] = LL_DMA_CHANNEL_6,
+    [FuriHalUartIdLPUART1] = LL_DMA_CHANNEL_7,
+};
+
+static const FuriHalInterruptId dma_rx_irq[2] = {
+    [FuriHalUartIdUSART1] = FuriHalInterruptIdDma2Ch6,
+    [FuriHalUartIdLPUART1] = FuriHalInterruptIdDma2Ch7,
+};
+
 static void furi_hal_usart_init(uint32_t baud) {
     furi_hal_gpio_init_ex(
         &gpio_usart_tx,
@@ -124,6 +141,7 @@ void furi_hal_uart_set_br(FuriHalUartId ch, uint32_t baud) {
 }
 
 void furi_hal_uart_deinit(FuriHalUartId ch) {
+    if(dma_rx[ch].callback) furi_hal_uart_dma_rx_stop(ch);
     furi_hal_uart_set_irq_cb(ch, NULL, NULL);
     if(ch == FuriHalUartIdUSART1) {
         LL_USART_Disable(USART1);
@@ -185,8 +203,149 @@ void furi_hal_uart_set_irq_cb(
     }
 }
 
+static void furi_hal_uart_dma_rx_process(FuriHalUartId ch) {
+    furi_hal_uart_dma_rx_process_remaining(
+        &dma_rx[ch], LL_DMA_GetDataLength(FURI_HAL_UART_DMA, dma_rx_channel[ch]));
+}
+
+static void furi_hal_usart_dma_rx_isr(void* context) {
+    if(LL_DMA_IsActiveFlag_HT6(FURI_HAL_UART_DMA)) {
+        LL_DMA_ClearFlag_HT6(FURI_HAL_UART_DMA);
+        furi_hal_uart_dma_rx_process(FuriHalUartIdUSART1);
+    }
+    if(LL_DMA_IsActiveFlag_TC6(FURI_HAL_UART_DMA)) {
+        LL_DMA_ClearFlag_TC6(FURI_HAL_UART_DMA);
+        furi_hal_uart_dma_rx_process(FuriHalUartIdUSART1);
+    }
+    if(LL_DMA_IsActiveFlag_TE6(FURI_HAL_UART_DMA)) {
+        LL_DMA_ClearFlag_TE6(FURI_HAL_UART_DMA);
+    }
+}
+
+static void furi_hal_lpuart_dma_rx_isr(void* context) {
+    if(LL_DMA_IsActiveFlag_HT7(FURI_HAL_UART_DMA)) {
+        LL_DMA_ClearFlag_HT7(FURI_HAL_UART_DMA);
+        furi_hal_uart_dma_rx_process(FuriHalUartIdLPUART1);
+    }
+    if(LL_DMA_IsActiveFlag_TC7(FURI_HAL_UART_DMA)) {
+        LL_DMA_ClearFlag_TC7(FURI_HAL_UART_DMA);
+        furi_hal_uart_dma_rx_process(FuriHalUartIdLPUART1);
+    }
+    if(LL_DMA_IsActiveFlag_TE7(FURI_HAL_UART_DMA)) {
+        LL_DMA_ClearFlag_TE7(FURI_HAL_UART_DMA);
+    }
+}
+
+void furi_hal_uart_dma_rx_start(
+    FuriHalUartId ch,
+    uint8_t* buffer,
+    size_t buffer_size,
+    FuriHalUartDmaRxCallback callback,
+    void* context) {
+    furi_assert(buffer);
+    furi_assert(buffer_size > 1);
+    furi_assert(callback);
+    furi_assert(dma_rx[ch].callback == NULL);
+
+    dma_rx[ch].buffer = buffer;
+    dma_rx[ch].size = buffer_size;
+    dma_rx[ch].pos = 0;
+    dma_rx[ch].context = context;
+    dma_rx[ch].callback = callback;
+
+    LL_DMA_InitTypeDef dma_config = {0};
+    if(ch == FuriHalUartIdUSART1) {
+        dma_config.PeriphOrM2MSrcAddress = (uint32_t) & (USART1->RDR);
+        dma_config.PeriphRequest = LL_DMAMUX_REQ_USART1_RX;
+    } else {
+        dma_config.PeriphOrM2MSrcAddress = (uint32_t) & (LPUART1->RDR);
+        dma_config.PeriphRequest = LL_DMAMUX_REQ_LPUART1_RX;
+    }
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)buffer;
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dma_config.Mode = LL_DMA_MODE_CIRCULAR;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_BYTE;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_BYTE;
+    dma_config.NbData = buffer_size;
+    dma_config.Priority = LL_DMA_PRIORITY_HIGH;
+    LL_DMA_Init(FURI_HAL_UART_DMA, dma_rx_channel[ch], &dma_config);
+
+    furi_hal_interrupt_set_isr(
+        dma_rx_irq[ch],
+        (ch == FuriHalUartIdUSART1) ? furi_hal_usart_dma_rx_isr : furi_hal_lpuart_dma_rx_isr,
+        NULL);
+    LL_DMA_EnableIT_HT(FURI_HAL_UART_DMA, dma_rx_channel[ch]);
+    LL_DMA_EnableIT_TC(FURI_HAL_UART_DMA, dma_rx_channel[ch]);
+    LL_DMA_EnableIT_TE(FURI_HAL_UART_DMA, dma_rx_channel[ch]);
+    LL_DMA_EnableChannel(FURI_HAL_UART_DMA, dma_rx_channel[ch]);
+
+    if(ch == FuriHalUartIdUSART1) {
+        dma_rx[ch].rxne_enabled = LL_USART_IsEnabledIT_RXNE_RXFNE(USART1);
+        dma_rx[ch].idle_enabled = LL_USART_IsEnabledIT_IDLE(USART1);
+        LL_USART_DisableIT_RXNE_RXFNE(USART1);
+        LL_USART_ClearFlag_IDLE(USART1);
+        LL_USART_ClearFlag_ORE(USART1);
+        LL_USART_EnableIT_IDLE(USART1);
+        LL_USART_EnableIT_ERROR(USART1);
+        LL_USART_EnableDMAReq_RX(USART1);
+        NVIC_EnableIRQ(USART1_IRQn);
+    } else {
+        dma_rx[ch].rxne_enabled = LL_LPUART_IsEnabledIT_RXNE_RXFNE(LPUART1);
+        dma_rx[ch].idle_enabled = LL_LPUART_IsEnabledIT_IDLE(LPUART1);
+        LL_LPUART_DisableIT_RXNE_RXFNE(LPUART1);
+        LL_LPUART_ClearFlag_IDLE(LPUART1);
+        LL_LPUART_ClearFlag_ORE(LPUART1);
+        LL_LPUART_EnableIT_IDLE(LPUART1);
+        LL_LPUART_EnableIT_ERROR(LPUART1);
+        LL_LPUART_EnableDMAReq_RX(LPUART1);
+        NVIC_EnableIRQ(LPUART1_IRQn);
+    }
+}
+
+void furi_hal_uart_dma_rx_stop(FuriHalUartId ch) {
+    furi_assert(dma_rx[ch].callback);
+
+    if(ch == FuriHalUartIdUSART1) {
+        LL_USART_DisableDMAReq_RX(USART1);
+        LL_USART_DisableIT_ERROR(USART1);
+        if(!dma_rx[ch].idle_enabled) LL_USART_DisableIT_IDLE(USART1);
+        if(irq_cb[ch] == NULL) NVIC_DisableIRQ(USART1_IRQn);
+    } else {
+        LL_LPUART_DisableDMAReq_RX(LPUART1);
+        LL_LPUART_DisableIT_ERROR(LPUART1);
+        if(!dma_rx[ch].idle_enabled) LL_LPUART_DisableIT_IDLE(LPUART1);
+        if(irq_cb[ch] == NULL) NVIC_DisableIRQ(LPUART1_IRQn);
+    }
+
+    LL_DMA_DisableChannel(FURI_HAL_UART_DMA, dma_rx_channel[ch]);
+    furi_hal_interrupt_set_isr(dma_rx_irq[ch], NULL, NULL);
+    LL_DMA_DeInit(FURI_HAL_UART_DMA, dma_rx_channel[ch]);
+
+    dma_rx[ch].callback = NULL;
+    dma_rx[ch].context = NULL;
+    dma_rx[ch].buffer = NULL;
+
+    if(!dma_rx[ch].rxne_enabled) return;
+    if(ch == FuriHalUartIdUSART1) {
+        LL_USART_EnableIT_RXNE_RXFNE(USART1);
+    } else {
+        LL_LPUART_EnableIT_RXNE_RXFNE(LPUART1);
+    }
+}
+
 void LPUART1_IRQHandler(void) {
-    if(LL_LPUART_IsActiveFlag_RXNE_RXFNE(LPUART1)) {
+    if(dma_rx[FuriHalUartIdLPUART1].callback) {
+        // RXNE is serviced by DMA, reading RDR here would steal data from it
+        if(LL_LPUART_IsActiveFlag_IDLE(LPUART1)) {
+            LL_LPUART_ClearFlag_IDLE(LPUART1);
+            furi_hal_uart_dma_rx_process(FuriHalUartIdLPUART1);
+        }
+        if(LL_LPUART_IsActiveFlag_ORE(LPUART1)) LL_LPUART_ClearFlag_ORE(LPUART1);
+        if(LL_LPUART_IsActiveFlag_FE(LPUART1)) LL_LPUART_ClearFlag_FE(LPUART1);
+        if(LL_LPUART_IsActiveFlag_NE(LPUART1)) LL_LPUART_ClearFlag_NE(LPUART1);
+    } else if(LL_LPUART_IsActiveFlag_RXNE_RXFNE(LPUART1)) {
         uint8_t data = LL_LPUART_ReceiveData8(LPUART1);
         irq_cb[FuriHalUartIdLPUART1](UartIrqEventRXNE, data, irq_ctx[FuriHalUartIdLPUART1]);
     } else if(LL_LPUART_IsActiveFlag_IDLE(LPUART1)) {
@@ -199,7 +358,16 @@ void LPUART1_IRQHandler(void) {
 }
 
 void USART1_IRQHandler(void) {
-    if(LL_USART_IsActiveFlag_RXNE_RXFNE(USART1)) {
+    if(dma_rx[FuriHalUartIdUSART1].callback) {
+        // RXNE is serviced by DMA, reading RDR here would steal data from it
+        if(LL_USART_IsActiveFlag_IDLE(USART1)) {
+            LL_USART_ClearFlag_IDLE(USART1);
+            furi_hal_uart_dma_rx_process(FuriHalUartIdUSART1);
+        }
+        if(LL_USART_IsActiveFlag_ORE(USART1)) LL_USART_ClearFlag_ORE(USART1);
+        if(LL_USART_IsActiveFlag_FE(USART1)) LL_USART_ClearFlag_FE(USART1);
+        if(LL_USART_IsActiveFlag_NE(USART1)) LL_USART_ClearFlag_NE(USART1);
+    } else if(LL_USART_IsActiveFlag_RXNE_RXFNE(USART1)) {
         uint8_t data = LL_USART_ReceiveData8(USART1);
         irq_cb[FuriHalUartIdUSART1](UartIrqEventRXNE, data, irq_ctx[FuriHalUartIdUSART1]);
     } else if(LL_USART_IsActiveFlag_IDLE(USART1)) {
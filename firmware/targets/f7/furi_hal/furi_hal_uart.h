@@ -31,6 +31,17 @@ typedef enum {
     //TODO: more events
 } UartIrqEvent;
 
+/**
+ * UART DMA receive callback
+ * Called from interrupt context on DMA half/full transfer and on line idle.
+ * Data points into the circular buffer given to furi_hal_uart_dma_rx_start and
+ * stays valid until DMA wraps around to it again.
+ * @param data received data
+ * @param size received data size (in bytes)
+ * @param context callback context
+ */
+typedef void (*FuriHalUartDmaRxCallback)(uint8_t* data, size_t size, void* context);
+
 /**
  * Init UART
  * Configures GPIO to UART function, сonfigures UART hardware, enables UART hardware
@@ -72,6 +83,29 @@ void furi_hal_uart_set_irq_cb(
     void (*callback)(UartIrqEvent event, uint8_t data, void* context),
     void* context);
 
+/**
+ * Starts circular DMA reception with idle line detection
+ * Per byte RX interrupt is disabled while DMA reception is active
+ * @param channel UART channel
+ * @param buffer circular buffer, must stay allocated until furi_hal_uart_dma_rx_stop
+ * @param buffer_size buffer size (in bytes)
+ * @param callback callback pointer
+ * @param context callback context
+ */
+void furi_hal_uart_dma_rx_start(
+    FuriHalUartId channel,
+    uint8_t* buffer,
+    size_t buffer_size,
+    FuriHalUartDmaRxCallback callback,
+    void* context);
+
+/**
+ * Stops circular DMA reception, per byte RX and idle interrupts are restored
+ * to the state they had on start
+ * @param channel UART channel
+ */
+void furi_hal_uart_dma_rx_stop(FuriHalUartId channel);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+/**
+ * @file furi_hal_uart_dma_rx.h
+ * UART circular DMA reception bookkeeping
+ *
+ * Not an API: private to furi_hal_uart.c. Host loopback includes it from here,
+ * so that the bench runs the same chunking as the device.
+ */
+#pragma once
+
+#include <furi_hal_uart.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint8_t* buffer;
+    size_t size;
+    /** Where the next chunk starts */
+    size_t pos;
+    FuriHalUartDmaRxCallback callback;
+    void* context;
+    /** Per byte RX and idle interrupt state before reception started */
+    bool rxne_enabled;
+    bool idle_enabled;
+} FuriHalUartDmaRx;
+
+/** Hand everything DMA wrote since the last call to the callback
+ *
+ * @param rx reception state
+ * @param remaining DMA transfer counter, bytes left till the buffer end
+ */
+static inline void furi_hal_uart_dma_rx_process_remaining(FuriHalUartDmaRx* rx, size_t remaining) {
+    size_t pos = rx->size - remaining;
+
+    if(pos == rx->pos) return;
+
+    if(pos > rx->pos) {
+        rx->callback(&rx->buffer[rx->pos], pos - rx->pos, rx->context);
+    } else {
+        // Buffer wrapped: tail first, then head
+        rx->callback(&rx->buffer[rx->pos], rx->size - rx->pos, rx->context);
+        if(pos > 0) rx->callback(&rx->buffer[0], pos, rx->context);
+    }
+    rx->pos = (pos == rx->size) ? 0 : pos;
+}
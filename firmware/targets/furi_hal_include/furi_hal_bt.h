@@ -98,6 +98,12 @@ void furi_hal_bt_start_advertising();
  */
 void furi_hal_bt_stop_advertising();
 
+/** Request fast connection parameters for bulk data transfer
+ *
+ * Call on every burst of data, defaults are restored when requests stop
+ */
+void furi_hal_bt_request_bulk_transfer();
+
 /** Get BT/BLE system component state
  *
  * @param[in]  buffer  string_t buffer to write to
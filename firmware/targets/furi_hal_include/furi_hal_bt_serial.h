@@ -7,6 +7,9 @@
 /** Serial service callback type */
 typedef SerialServiceEventCallback FuriHalBtSerialCallback;
 
+/** Serial transmit status type */
+typedef SerialServiceTxStatus FuriHalBtSerialTxStatus;
+
 /** Start Serial Profile
  */
 void furi_hal_bt_serial_start();
@@ -31,10 +34,13 @@ void furi_hal_bt_serial_set_event_callback(
 void furi_hal_bt_serial_notify_buffer_is_empty();
 
 /** Send data through BLE
+ *
+ * Doesn't wait for delivery. Busy status means that no more packets can be queued
+ * now: retry the same packet after SerialServiceEventTypeDataSent event.
  *
  * @param data  data buffer
  * @param size  data buffer size
  *
- * @return      true on success
+ * @return      FuriHalBtSerialTxStatus
  */
-bool furi_hal_bt_serial_tx(uint8_t* data, uint16_t size);
+FuriHalBtSerialTxStatus furi_hal_bt_serial_tx(uint8_t* data, uint16_t size);
@@ -19,6 +19,29 @@ typedef enum {
     FuriHalPowerICFuelGauge,
 } FuriHalPowerIC;
 
+/** Charger and fuel gauge measurements */
+typedef struct {
+    bool is_charging;
+    bool is_otg_enabled;
+    bool is_otg_fault;
+
+    uint8_t charge; /**< remaining battery capacity in percents */
+    uint8_t health; /**< battery health in percents */
+    uint32_t capacity_remaining; /**< mAh */
+    uint32_t capacity_full; /**< mAh */
+
+    float current_charger; /**< A */
+    float current_gauge; /**< A */
+    float voltage_charger; /**< V */
+    float voltage_gauge; /**< V */
+    float voltage_vbus; /**< V */
+    float temperature_charger; /**< C */
+    float temperature_gauge; /**< C */
+} FuriHalPowerReadout;
+
+/** Power state change callback, see furi_hal_power_set_event_callback */
+typedef void (*FuriHalPowerEventCallback)(void* context);
+
 /** Initialize drivers
  */
 void furi_hal_power_init();
@@ -155,6 +178,28 @@ float furi_hal_power_get_system_voltage();
  */
 float furi_hal_power_get_usb_voltage();
 
+/** Read charger and fuel gauge at once
+ *
+ * Bus is acquired once and every IC is read with one burst transfer, prefer
+ * it to a row of single value getters.
+ *
+ * @param      readout  FuriHalPowerReadout to fill
+ *
+ * @return     true on success
+ */
+bool furi_hal_power_read(FuriHalPowerReadout* readout);
+
+/** Set callback for power state changes made through HAL
+ *
+ * Called from the caller thread after charging is suppressed or restored and
+ * after OTG is switched. Charger and gauge interrupt lines are not routed on
+ * this target, so changes coming from outside, like USB plug, have to be polled.
+ *
+ * @param      callback  FuriHalPowerEventCallback, NULL to disable
+ * @param      context   context to pass to callback
+ */
+void furi_hal_power_set_event_callback(FuriHalPowerEventCallback callback, void* context);
+
 /** Get power system component state
  */
 void furi_hal_power_dump_state();
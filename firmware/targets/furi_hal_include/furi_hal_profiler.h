@@ -0,0 +1,109 @@
+/**
+ * @file furi_hal_profiler.h
+ * Sampling CPU profiler HAL API
+ *
+ * Timer interrupt samples PC and LR of interrupted context into a ring buffer.
+ * Kernel run time counters give per thread CPU time for the same session.
+ * Dump is a binary stream, addresses are resolved on host against firmware
+ * ELF: see scripts/profiler.py.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default sampling rate, Hz */
+#define FURI_HAL_PROFILER_RATE_DEFAULT 1000
+#define FURI_HAL_PROFILER_RATE_MIN 10
+#define FURI_HAL_PROFILER_RATE_MAX 8192
+
+/** Sample buffer capacity, power of 2. Dump drains it, so long sessions need periodic dumps */
+#define FURI_HAL_PROFILER_SAMPLES 1024
+
+/** Dump stream magic, "FZPR" */
+#define FURI_HAL_PROFILER_DUMP_MAGIC 0x52505A46
+#define FURI_HAL_PROFILER_DUMP_VERSION 1
+#define FURI_HAL_PROFILER_THREAD_NAME_SIZE 16
+
+/** Dump stream layout, little endian. Header goes first, then thread_count
+ * FuriHalProfilerThread records, then sample_count FuriHalProfilerSample records
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t thread_count;
+    uint32_t core_clock; /**< Hz, unit of thread run time */
+    uint32_t rate; /**< samples per second */
+    uint32_t duration; /**< ms since profiler start */
+    uint32_t sample_count;
+    uint32_t dropped; /**< samples lost to full buffer since previous dump */
+} __attribute__((packed)) FuriHalProfilerHeader;
+
+typedef struct {
+    uint32_t id; /**< thread id as in FuriHalProfilerSample context */
+    char name[FURI_HAL_PROFILER_THREAD_NAME_SIZE];
+    uint64_t runtime; /**< core clock cycles since profiler start */
+} __attribute__((packed)) FuriHalProfilerThread;
+
+typedef struct {
+    uint32_t pc;
+    uint32_t lr;
+    /** Thread id when thread was interrupted, exception number (below 256) for ISR */
+    uint32_t context;
+} __attribute__((packed)) FuriHalProfilerSample;
+
+/** Dump stream chunk callback
+ *
+ * @param   data        chunk data
+ * @param   size        chunk size
+ * @param   last        true for the last chunk of the dump
+ * @param   context     callback context
+ */
+typedef void (*FuriHalProfilerDumpCallback)(
+    const uint8_t* data,
+    size_t size,
+    bool last,
+    void* context);
+
+/** Start sampling
+ *
+ * Allocates sample buffer, resets thread run time counters and keeps core out
+ * of STOP mode till profiler is stopped. Samples left from previous session are
+ * dropped.
+ *
+ * @param   rate    samples per second, FURI_HAL_PROFILER_RATE_MIN..MAX
+ *
+ * @return  true if started, false if already running or rate is out of range
+ */
+bool furi_hal_profiler_start(uint32_t rate);
+
+/** Stop sampling, collected samples are kept for dump */
+void furi_hal_profiler_stop();
+
+/** Check if sampling is running
+ *
+ * @return  true if running
+ */
+bool furi_hal_profiler_is_running();
+
+/** Dump threads and drain collected samples
+ *
+ * Can be called while sampling is running to stream long sessions. Dump of
+ * stopped profiler releases sample buffer. Stream size is known from header.
+ *
+ * @param   callback    chunk callback, called at least once
+ * @param   context     callback context
+ *
+ * @return  false if profiler was never started or another dump is running
+ */
+bool furi_hal_profiler_dump(FuriHalProfilerDumpCallback callback, void* context);
+
+#ifdef __cplusplus
+}
+#endif
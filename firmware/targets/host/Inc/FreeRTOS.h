@@ -0,0 +1,28 @@
+/**
+ * @file FreeRTOS.h
+ * Host target: FreeRTOS types and macros used by furi and libs.
+ * Scheduler is replaced by pthreads, see posix/cmsis_os2.c.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS (pdTRUE)
+#define pdFAIL (pdFALSE)
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 56
+
+#define pdMS_TO_TICKS(xTimeInMs) \
+    ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000))
@@ -0,0 +1,59 @@
+/**
+ * @file cmsis_compiler.h
+ * Host target: compiler abstraction and core register access.
+ * Host code never runs in interrupt context and never masks interrupts.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM __asm
+#endif
+#ifndef __INLINE
+#define __INLINE inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_STRUCT
+#define __PACKED_STRUCT struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#endif
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void) {
+    return 0U;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void) {
+    return 0U;
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void) {
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void) {
+}
+
+#define __NOP() __ASM volatile("" ::: "memory")
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
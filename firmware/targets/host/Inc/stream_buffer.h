@@ -0,0 +1,60 @@
+/**
+ * @file stream_buffer.h
+ * Host target: stream buffer API subset, see posix/stream_buffer.c.
+ * Semantics follow FreeRTOS: blocked receiver wakes up when trigger level is reached
+ * or on timeout, FromISR variants never block.
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct StreamBufferDef_t* StreamBufferHandle_t;
+
+StreamBufferHandle_t xStreamBufferCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes);
+
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer);
+
+size_t xStreamBufferSend(
+    StreamBufferHandle_t xStreamBuffer,
+    const void* pvTxData,
+    size_t xDataLengthBytes,
+    TickType_t xTicksToWait);
+
+size_t xStreamBufferSendFromISR(
+    StreamBufferHandle_t xStreamBuffer,
+    const void* pvTxData,
+    size_t xDataLengthBytes,
+    BaseType_t* const pxHigherPriorityTaskWoken);
+
+size_t xStreamBufferReceive(
+    StreamBufferHandle_t xStreamBuffer,
+    void* pvRxData,
+    size_t xBufferLengthBytes,
+    TickType_t xTicksToWait);
+
+size_t xStreamBufferReceiveFromISR(
+    StreamBufferHandle_t xStreamBuffer,
+    void* pvRxData,
+    size_t xBufferLengthBytes,
+    BaseType_t* const pxHigherPriorityTaskWoken);
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer);
+
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer);
+
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer);
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer);
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer);
+
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file task.h
+ * Host target: task API subset.
+ * There are no interrupts on host, critical section is one process wide recursive lock.
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* TaskHandle_t;
+
+void vTaskSuspendAll(void);
+
+BaseType_t xTaskResumeAll(void);
+
+TickType_t xTaskGetTickCount(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+void vPortEnterCritical(void);
+
+void vPortExitCritical(void);
+
+#define taskENTER_CRITICAL() vPortEnterCritical()
+#define taskEXIT_CRITICAL() vPortExitCritical()
+#define taskENTER_CRITICAL_FROM_ISR() (vPortEnterCritical(), 0U)
+#define taskEXIT_CRITICAL_FROM_ISR(x) ((void)(x), vPortExitCritical())
+
+#ifdef __cplusplus
+}
+#endif
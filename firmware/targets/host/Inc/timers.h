@@ -0,0 +1,25 @@
+/**
+ * @file timers.h
+ * Host target: software timer API subset, timers are CMSIS timers from posix/cmsis_os2.c.
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* TimerHandle_t;
+
+/** Set period and start timer, block time is ignored: there is no timer command queue */
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t block_time);
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t block_time);
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,122 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TAG "Bench"
+
+/** Samples per benchmark, odd for exact median */
+#define BENCH_SAMPLES 21
+/** Iterations are doubled until one sample takes that long */
+#define BENCH_SAMPLE_NS 10000000ULL
+#define BENCH_MAX_ITERATIONS (1UL << 30)
+
+struct BenchRunner {
+    const char* filter;
+    uint32_t run;
+    uint32_t failed;
+};
+
+static volatile uint32_t bench_sink_value;
+
+void bench_sink(uint32_t value) {
+    bench_sink_value += value;
+}
+
+static uint64_t bench_now_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static uint64_t bench_measure(BenchCallback callback, void* context, uint32_t iterations) {
+    uint64_t start = bench_now_ns();
+    callback(context, iterations);
+    return bench_now_ns() - start;
+}
+
+static int bench_compare(const void* a, const void* b) {
+    double value_a = *(const double*)a;
+    double value_b = *(const double*)b;
+    return (value_a > value_b) - (value_a < value_b);
+}
+
+BenchRunner* bench_runner_alloc(const char* filter) {
+    BenchRunner* runner = malloc(sizeof(BenchRunner));
+    runner->filter = filter;
+    runner->run = 0;
+    runner->failed = 0;
+    return runner;
+}
+
+uint32_t bench_runner_free(BenchRunner* runner) {
+    uint32_t failed = runner->failed;
+    FURI_LOG_I(TAG, "%lu run, %lu failed", runner->run, runner->failed);
+    free(runner);
+    return failed;
+}
+
+bool bench_runner_enabled(BenchRunner* runner, const char* name) {
+    return (runner->filter == NULL) || (strstr(name, runner->filter) != NULL);
+}
+
+void bench_runner_run(
+    BenchRunner* runner,
+    const char* name,
+    size_t bytes_per_op,
+    BenchCallback callback,
+    void* context) {
+    if(!bench_runner_enabled(runner, name)) return;
+
+    // warm up caches and lazy allocations
+    bench_measure(callback, context, 1);
+
+    uint32_t iterations = 1;
+    while(bench_measure(callback, context, iterations) < BENCH_SAMPLE_NS &&
+          iterations < BENCH_MAX_ITERATIONS) {
+        iterations *= 2;
+    }
+
+    double samples[BENCH_SAMPLES];
+    for(size_t i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = (double)bench_measure(callback, context, iterations) / iterations;
+    }
+    qsort(samples, BENCH_SAMPLES, sizeof(double), bench_compare);
+
+    double median = samples[BENCH_SAMPLES / 2];
+    double ops_per_s = median > 0 ? 1e9 / median : 0;
+    printf(
+        "{\"name\":\"%s\",\"iterations\":%u,\"samples\":%d,"
+        "\"ns_per_op\":{\"min\":%.1f,\"median\":%.1f,\"p90\":%.1f,\"max\":%.1f},"
+        "\"ops_per_s\":%.1f,\"bytes_per_s\":%.1f}\n",
+        name,
+        (unsigned)iterations,
+        BENCH_SAMPLES,
+        samples[0],
+        median,
+        samples[(BENCH_SAMPLES * 9) / 10],
+        samples[BENCH_SAMPLES - 1],
+        ops_per_s,
+        ops_per_s * bytes_per_op);
+    fflush(stdout);
+
+    runner->run++;
+}
+
+void bench_runner_report(BenchRunner* runner, const char* name, const char* metrics) {
+    if(!bench_runner_enabled(runner, name)) return;
+
+    printf("{\"name\":\"%s\",%s}\n", name, metrics);
+    fflush(stdout);
+    runner->run++;
+}
+
+void bench_runner_fail(BenchRunner* runner, const char* name, const char* reason) {
+    if(!bench_runner_enabled(runner, name)) return;
+
+    printf("{\"name\":\"%s\",\"error\":\"%s\"}\n", name, reason);
+    fflush(stdout);
+    runner->failed++;
+}
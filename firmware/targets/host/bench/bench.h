@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct BenchRunner BenchRunner;
+
+/**
+ * Benchmark body
+ * @param context benchmark context
+ * @param iterations how many operations to do in a row
+ */
+typedef void (*BenchCallback)(void* context, uint32_t iterations);
+
+/**
+ * Allocate runner, results go to stdout as one JSON object per line
+ * @param filter only benchmarks with names containing filter are run, NULL to run all
+ * @return BenchRunner*
+ */
+BenchRunner* bench_runner_alloc(const char* filter);
+
+/**
+ * Free runner
+ * @param runner
+ * @return number of failed benchmarks
+ */
+uint32_t bench_runner_free(BenchRunner* runner);
+
+/**
+ * Check if benchmark passes filter, so setup can be skipped
+ * @param runner
+ * @param name benchmark name
+ * @return true if benchmark should run
+ */
+bool bench_runner_enabled(BenchRunner* runner, const char* name);
+
+/**
+ * Run benchmark: iterations are calibrated to the sample time, then samples are taken
+ * and latency percentiles with throughput are printed.
+ * @param runner
+ * @param name benchmark name, "suite/case" form
+ * @param bytes_per_op payload bytes of one operation, 0 if throughput has no meaning
+ * @param callback benchmark body
+ * @param context benchmark context
+ */
+void bench_runner_run(
+    BenchRunner* runner,
+    const char* name,
+    size_t bytes_per_op,
+    BenchCallback callback,
+    void* context);
+
+/**
+ * Report failed self check of benchmark, printed instead of the result
+ * @param runner
+ * @param name benchmark name
+ * @param reason
+ */
+void bench_runner_fail(BenchRunner* runner, const char* name, const char* reason);
+
+/**
+ * Report result of simulation, where time taken on host means nothing
+ * @param runner
+ * @param name benchmark name
+ * @param metrics JSON object members without braces, "key":value,...
+ */
+void bench_runner_report(BenchRunner* runner, const char* name, const char* metrics);
+
+/**
+ * Keep value computed by benchmark body from being optimized away
+ * @param value
+ */
+void bench_sink(uint32_t value);
+
+void bench_furi(BenchRunner* runner);
+void bench_stream(BenchRunner* runner);
+void bench_flipper_format(BenchRunner* runner);
+void bench_compress(BenchRunner* runner);
+void bench_heatshrink(BenchRunner* runner);
+void bench_gui(BenchRunner* runner);
+void bench_infrared(BenchRunner* runner);
+void bench_subghz(BenchRunner* runner);
+void bench_nfc(BenchRunner* runner);
+void bench_nfc_mf_classic(BenchRunner* runner);
+void bench_nfc_dump(BenchRunner* runner);
+void bench_power(BenchRunner* runner);
+void bench_uart(BenchRunner* runner);
+void bench_fatfs(BenchRunner* runner);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,109 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <toolbox/stream/stream.h>
+#include <toolbox/stream/string_stream.h>
+#include <toolbox/stream/compress_stream.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#define BENCH_COMPRESS_SIZE 4096
+#define BENCH_COMPRESS_CHUNK_SIZE 64
+#define BENCH_COMPRESS_WINDOW_BITS 8
+#define BENCH_COMPRESS_LOOKAHEAD_BITS 4
+
+typedef struct {
+    uint8_t plain[BENCH_COMPRESS_SIZE];
+    uint8_t chunk[BENCH_COMPRESS_CHUNK_SIZE];
+    Stream* compressed;
+    Stream* encoder;
+    Stream* decoder;
+} BenchCompress;
+
+static void bench_compress_encode_once(BenchCompress* bench) {
+    stream_clean(bench->compressed);
+    compress_stream_attach(bench->encoder, bench->compressed);
+    for(size_t i = 0; i < BENCH_COMPRESS_SIZE; i += BENCH_COMPRESS_CHUNK_SIZE) {
+        stream_write(bench->encoder, &bench->plain[i], BENCH_COMPRESS_CHUNK_SIZE);
+    }
+    furi_check(compress_stream_finish(bench->encoder));
+}
+
+static size_t bench_compress_decode_once(BenchCompress* bench, bool verify) {
+    stream_rewind(bench->compressed);
+    compress_stream_attach(bench->decoder, bench->compressed);
+    size_t size = 0;
+    size_t read;
+    do {
+        read = stream_read(bench->decoder, bench->chunk, BENCH_COMPRESS_CHUNK_SIZE);
+        if(verify && (size + read > BENCH_COMPRESS_SIZE ||
+                      memcmp(bench->chunk, &bench->plain[size], read) != 0)) {
+            return 0;
+        }
+        size += read;
+    } while(read);
+    return size;
+}
+
+static void bench_compress_encode(void* context, uint32_t iterations) {
+    BenchCompress* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_compress_encode_once(bench);
+    }
+}
+
+static void bench_compress_decode(void* context, uint32_t iterations) {
+    BenchCompress* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_sink(bench_compress_decode_once(bench, false));
+    }
+}
+
+void bench_compress(BenchRunner* runner) {
+    BenchCompress* bench = malloc(sizeof(BenchCompress));
+
+    // text with repeats of key file, typical data for the stream
+    size_t size = 0;
+    for(uint32_t line = 0; size < BENCH_COMPRESS_SIZE; line++) {
+        char text[64];
+        int length = snprintf(
+            text,
+            sizeof(text),
+            "Page %" PRIu32 ": %02" PRIX32 " %02" PRIX32 " 00 A5\n",
+            line,
+            line & 0xFF,
+            ~line & 0xFF);
+        for(int i = 0; i < length && size < BENCH_COMPRESS_SIZE; i++) {
+            bench->plain[size++] = text[i];
+        }
+    }
+
+    bench->compressed = string_stream_alloc();
+    bench->encoder = compress_stream_alloc(
+        CompressStreamModeEncode, BENCH_COMPRESS_WINDOW_BITS, BENCH_COMPRESS_LOOKAHEAD_BITS);
+    bench->decoder = compress_stream_alloc(
+        CompressStreamModeDecode, BENCH_COMPRESS_WINDOW_BITS, BENCH_COMPRESS_LOOKAHEAD_BITS);
+
+    bench_compress_encode_once(bench);
+    if(bench_compress_decode_once(bench, true) != BENCH_COMPRESS_SIZE) {
+        bench_runner_fail(runner, "compress/stream_decode_4k", "round trip mismatch");
+    } else {
+        bench_runner_run(
+            runner,
+            "compress/stream_encode_4k",
+            BENCH_COMPRESS_SIZE,
+            bench_compress_encode,
+            bench);
+        bench_runner_run(
+            runner,
+            "compress/stream_decode_4k",
+            BENCH_COMPRESS_SIZE,
+            bench_compress_decode,
+            bench);
+    }
+
+    stream_free(bench->decoder);
+    stream_free(bench->encoder);
+    stream_free(bench->compressed);
+    free(bench);
+}
@@ -0,0 +1,298 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <fatfs/ff_gen_drv.h>
+#include <sector_cache.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TAG "BenchFatfs"
+
+#define BENCH_FATFS_DIR "/ext/bench"
+#define BENCH_FATFS_IMAGE BENCH_FATFS_DIR "/fatfs.img"
+#define BENCH_FATFS_SECTORS (16 * 1024 * 1024 / SECTOR_CACHE_SECTOR_SIZE)
+/** Same as USER_CACHE_SETS and USER_CACHE_WAYS defaults of SD diskio */
+#define BENCH_FATFS_CACHE_SETS 4
+#define BENCH_FATFS_CACHE_WAYS 2
+
+#define BENCH_FATFS_DIRS 8
+#define BENCH_FATFS_FILES_PER_DIR 9
+#define BENCH_FATFS_APPENDS 8
+#define BENCH_FATFS_APPEND_SIZE 48
+#define BENCH_FATFS_STATS 4
+#define BENCH_FATFS_PATH_SIZE 32
+#define BENCH_FATFS_METRICS_SIZE 256
+
+typedef struct {
+    uint32_t reads;
+    uint32_t writes;
+} BenchFatfsDeviceStats;
+
+/* Disk image is a file on storage_posix, diskio goes through sector cache as SD one does */
+typedef struct {
+    File* image;
+    SectorCache* cache;
+    BenchFatfsDeviceStats device;
+    bool io_error;
+    FATFS fs;
+    char drive[4];
+} BenchFatfs;
+
+static BenchFatfs* bench_fatfs_disk;
+
+static bool bench_fatfs_image_read(void* context, uint8_t* buff, uint32_t sector, uint32_t count) {
+    BenchFatfs* bench = context;
+    bench->device.reads += count;
+    if(!storage_file_seek(bench->image, sector * SECTOR_CACHE_SECTOR_SIZE, true)) return false;
+    for(uint32_t i = 0; i < count; i++) {
+        uint8_t* data = &buff[i * SECTOR_CACHE_SECTOR_SIZE];
+        uint16_t read = storage_file_read(bench->image, data, SECTOR_CACHE_SECTOR_SIZE);
+        if(read != SECTOR_CACHE_SECTOR_SIZE) return false;
+    }
+    return true;
+}
+
+static bool
+    bench_fatfs_image_write(void* context, const uint8_t* buff, uint32_t sector, uint32_t count) {
+    BenchFatfs* bench = context;
+    bench->device.writes += count;
+    if(!storage_file_seek(bench->image, sector * SECTOR_CACHE_SECTOR_SIZE, true)) return false;
+    for(uint32_t i = 0; i < count; i++) {
+        const uint8_t* data = &buff[i * SECTOR_CACHE_SECTOR_SIZE];
+        uint16_t written = storage_file_write(bench->image, data, SECTOR_CACHE_SECTOR_SIZE);
+        if(written != SECTOR_CACHE_SECTOR_SIZE) return false;
+    }
+    return true;
+}
+
+static DSTATUS bench_fatfs_initialize(BYTE pdrv) {
+    if(bench_fatfs_disk->cache) sector_cache_reset(bench_fatfs_disk->cache);
+    return 0;
+}
+
+static DSTATUS bench_fatfs_status(BYTE pdrv) {
+    return 0;
+}
+
+static DRESULT bench_fatfs_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
+    bool result = bench_fatfs_disk->cache ?
+                      sector_cache_read(bench_fatfs_disk->cache, buff, sector, count) :
+                      bench_fatfs_image_read(bench_fatfs_disk, buff, sector, count);
+    bench_fatfs_disk->io_error |= !result;
+    return result ? RES_OK : RES_ERROR;
+}
+
+static DRESULT bench_fatfs_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
+    bool result = bench_fatfs_disk->cache ?
+                      sector_cache_write(bench_fatfs_disk->cache, buff, sector, count) :
+                      bench_fatfs_image_write(bench_fatfs_disk, buff, sector, count);
+    bench_fatfs_disk->io_error |= !result;
+    return result ? RES_OK : RES_ERROR;
+}
+
+static DRESULT bench_fatfs_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
+    switch(cmd) {
+    case CTRL_SYNC:
+        if(!bench_fatfs_disk->cache) return RES_OK;
+        return sector_cache_flush(bench_fatfs_disk->cache) ? RES_OK : RES_ERROR;
+    case GET_SECTOR_COUNT:
+        *(DWORD*)buff = BENCH_FATFS_SECTORS;
+        return RES_OK;
+    case GET_SECTOR_SIZE:
+        *(WORD*)buff = SECTOR_CACHE_SECTOR_SIZE;
+        return RES_OK;
+    case GET_BLOCK_SIZE:
+        *(DWORD*)buff = 1;
+        return RES_OK;
+    default:
+        return RES_PARERR;
+    }
+}
+
+static const Diskio_drvTypeDef bench_fatfs_driver = {
+    bench_fatfs_initialize,
+    bench_fatfs_status,
+    bench_fatfs_read,
+    bench_fatfs_write,
+    bench_fatfs_ioctl,
+};
+
+static void bench_fatfs_file_path(BenchFatfs* bench, char* path, size_t dir, size_t file) {
+    if(file < BENCH_FATFS_FILES_PER_DIR) {
+        snprintf(path, BENCH_FATFS_PATH_SIZE, "%sdir%zu/file%zu.txt", bench->drive, dir, file);
+    } else {
+        snprintf(path, BENCH_FATFS_PATH_SIZE, "%sdir%zu", bench->drive, dir);
+    }
+}
+
+static uint8_t bench_fatfs_pattern(size_t dir, size_t file, size_t offset) {
+    return (dir * 31 + file * 7 + offset) & 0xFF;
+}
+
+/** Storage-like workload: small appends across many files, stat storm, readback */
+static bool bench_fatfs_workload(BenchFatfs* bench) {
+    char path[BENCH_FATFS_PATH_SIZE];
+    uint8_t data[BENCH_FATFS_APPEND_SIZE];
+    FIL file;
+    UINT done;
+    bool ok = true;
+
+    for(size_t dir = 0; dir < BENCH_FATFS_DIRS; dir++) {
+        bench_fatfs_file_path(bench, path, dir, BENCH_FATFS_FILES_PER_DIR);
+        ok &= (f_mkdir(path) == FR_OK);
+    }
+
+    for(size_t append = 0; append < BENCH_FATFS_APPENDS && ok; append++) {
+        for(size_t dir = 0; dir < BENCH_FATFS_DIRS; dir++) {
+            for(size_t i = 0; i < BENCH_FATFS_FILES_PER_DIR; i++) {
+                bench_fatfs_file_path(bench, path, dir, i);
+                for(size_t j = 0; j < sizeof(data); j++) {
+                    data[j] = bench_fatfs_pattern(dir, i, append * sizeof(data) + j);
+                }
+                ok &= (f_open(&file, path, FA_OPEN_APPEND | FA_WRITE) == FR_OK);
+                ok &= (f_write(&file, data, sizeof(data), &done) == FR_OK);
+                ok &= (done == sizeof(data));
+                ok &= (f_close(&file) == FR_OK);
+            }
+        }
+    }
+
+    FILINFO info;
+    for(size_t n = 0; n < BENCH_FATFS_STATS && ok; n++) {
+        for(size_t dir = 0; dir < BENCH_FATFS_DIRS; dir++) {
+            for(size_t i = 0; i < BENCH_FATFS_FILES_PER_DIR; i++) {
+                bench_fatfs_file_path(bench, path, dir, i);
+                ok &= (f_stat(path, &info) == FR_OK);
+                ok &= (info.fsize == BENCH_FATFS_APPENDS * BENCH_FATFS_APPEND_SIZE);
+            }
+        }
+    }
+
+    return ok;
+}
+
+/** Read back every file, works on any mounted image that went through workload */
+static bool bench_fatfs_verify(BenchFatfs* bench) {
+    char path[BENCH_FATFS_PATH_SIZE];
+    uint8_t data[BENCH_FATFS_APPEND_SIZE];
+    FIL file;
+    UINT done;
+    bool ok = true;
+
+    for(size_t dir = 0; dir < BENCH_FATFS_DIRS && ok; dir++) {
+        for(size_t i = 0; i < BENCH_FATFS_FILES_PER_DIR && ok; i++) {
+            bench_fatfs_file_path(bench, path, dir, i);
+            ok &= (f_open(&file, path, FA_READ) == FR_OK);
+            for(size_t append = 0; append < BENCH_FATFS_APPENDS && ok; append++) {
+                ok &= (f_read(&file, data, sizeof(data), &done) == FR_OK);
+                ok &= (done == sizeof(data));
+                for(size_t j = 0; j < sizeof(data); j++) {
+                    ok &= (data[j] == bench_fatfs_pattern(dir, i, append * sizeof(data) + j));
+                }
+            }
+            f_close(&file);
+        }
+    }
+
+    return ok;
+}
+
+static bool bench_fatfs_mount(BenchFatfs* bench) {
+    if(f_mount(&bench->fs, bench->drive, 1) != FR_OK) return false;
+    // As storage_ext does after mount
+    if(bench->cache) {
+        sector_cache_set_priority(bench->cache, bench->fs.fatbase, bench->fs.database);
+    }
+    return true;
+}
+
+/** Fresh image, mkfs, workload and readback, then sync as on unmount */
+static bool bench_fatfs_run(BenchFatfs* bench, Storage* storage, bool cached) {
+    bench->image = storage_file_alloc(storage);
+    bool ok = storage_file_open(
+        bench->image, BENCH_FATFS_IMAGE, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+    uint32_t image_size = BENCH_FATFS_SECTORS * SECTOR_CACHE_SECTOR_SIZE;
+    ok = ok && storage_file_seek(bench->image, image_size, true);
+    ok = ok && storage_file_truncate(bench->image);
+    if(cached) {
+        bench->cache = sector_cache_alloc(
+            BENCH_FATFS_CACHE_SETS,
+            BENCH_FATFS_CACHE_WAYS,
+            bench_fatfs_image_read,
+            bench_fatfs_image_write,
+            bench);
+    }
+
+    memset(&bench->device, 0, sizeof(bench->device));
+    bench->io_error = false;
+    uint8_t* work = malloc(_MAX_SS);
+    ok = ok && (f_mkfs(bench->drive, FM_FAT, 0, work, _MAX_SS) == FR_OK);
+    free(work);
+
+    ok = ok && bench_fatfs_mount(bench);
+    ok = ok && bench_fatfs_workload(bench);
+    ok = ok && bench_fatfs_verify(bench);
+    ok = ok && (disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK);
+    f_mount(NULL, bench->drive, 0);
+
+    return ok && !bench->io_error;
+}
+
+void bench_fatfs(BenchRunner* runner) {
+    const char* name = "fatfs/sector_cache";
+    if(!bench_runner_enabled(runner, name)) return;
+
+    Storage* storage = furi_record_open("storage");
+    storage_simply_mkdir(storage, BENCH_FATFS_DIR);
+    BenchFatfs* bench = malloc(sizeof(BenchFatfs));
+    bench_fatfs_disk = bench;
+    furi_check(FATFS_LinkDriver(&bench_fatfs_driver, bench->drive) == 0);
+
+    bool uncached_ok = bench_fatfs_run(bench, storage, false);
+    BenchFatfsDeviceStats uncached = bench->device;
+    storage_file_free(bench->image);
+
+    bool cached_ok = bench_fatfs_run(bench, storage, true);
+    BenchFatfsDeviceStats cached = bench->device;
+    SectorCacheStats stats;
+    sector_cache_get_stats(bench->cache, &stats);
+    sector_cache_free(bench->cache);
+    bench->cache = NULL;
+
+    // What went through cache must be on the image: remount it without cache and read back
+    bool image_ok = cached_ok && bench_fatfs_mount(bench) && bench_fatfs_verify(bench);
+    f_mount(NULL, bench->drive, 0);
+    storage_file_free(bench->image);
+    storage_simply_remove(storage, BENCH_FATFS_IMAGE);
+
+    FATFS_UnLinkDriver(bench->drive);
+    bench_fatfs_disk = NULL;
+    free(bench);
+    furi_record_close("storage");
+
+    if(!uncached_ok || !cached_ok) {
+        bench_runner_fail(runner, name, "workload failed");
+    } else if(!image_ok) {
+        bench_runner_fail(runner, name, "image differs after cache sync");
+    } else {
+        char metrics[BENCH_FATFS_METRICS_SIZE];
+        snprintf(
+            metrics,
+            sizeof(metrics),
+            "\"reads_uncached\":%" PRIu32 ",\"reads_cached\":%" PRIu32 ","
+            "\"writes_uncached\":%" PRIu32 ",\"writes_cached\":%" PRIu32 ","
+            "\"hits\":%" PRIu32 ",\"misses\":%" PRIu32 ",\"evictions\":%" PRIu32
+            ",\"writebacks\":%" PRIu32,
+            uncached.reads,
+            cached.reads,
+            uncached.writes,
+            cached.writes,
+            stats.hits,
+            stats.misses,
+            stats.evictions,
+            stats.writebacks);
+        bench_runner_report(runner, name, metrics);
+    }
+}
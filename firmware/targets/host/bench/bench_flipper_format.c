@@ -0,0 +1,169 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <stdio.h>
+
+#define BENCH_FF_NFC_PAGES 64
+#define BENCH_FF_IR_SAMPLES 512
+#define BENCH_FF_DIR "/ext/bench"
+#define BENCH_FF_FILE BENCH_FF_DIR "/dump.nfc"
+
+typedef struct {
+    FlipperFormat* flipper_format;
+    Storage* storage;
+    char keys[BENCH_FF_NFC_PAGES][16];
+    uint32_t samples[BENCH_FF_IR_SAMPLES];
+    size_t size;
+} BenchFlipperFormat;
+
+/** Mifare Ultralight like dump, as NFC app saves it */
+static bool bench_ff_nfc_save(BenchFlipperFormat* bench, FlipperFormat* flipper_format) {
+    const uint8_t uid[7] = {0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+    const uint8_t atqa[2] = {0x44, 0x00};
+    const uint8_t sak = 0x00;
+    const uint32_t pages = BENCH_FF_NFC_PAGES;
+    bool result = false;
+
+    do {
+        if(!flipper_format_write_header_cstr(flipper_format, "Flipper NFC device", 2)) break;
+        if(!flipper_format_write_string_cstr(flipper_format, "Device type", "NTAG216")) break;
+        if(!flipper_format_write_hex(flipper_format, "UID", uid, sizeof(uid))) break;
+        if(!flipper_format_write_hex(flipper_format, "ATQA", atqa, sizeof(atqa))) break;
+        if(!flipper_format_write_hex(flipper_format, "SAK", &sak, 1)) break;
+        if(!flipper_format_write_uint32(flipper_format, "Pages total", &pages, 1)) break;
+        size_t page = 0;
+        for(; page < BENCH_FF_NFC_PAGES; page++) {
+            uint8_t data[4] = {page & 0xFF, page >> 8, ~page & 0xFF, 0xA5};
+            if(!flipper_format_write_hex(flipper_format, bench->keys[page], data, 4)) break;
+        }
+        result = (page == BENCH_FF_NFC_PAGES);
+    } while(false);
+
+    return result;
+}
+
+static bool bench_ff_nfc_load(BenchFlipperFormat* bench, FlipperFormat* flipper_format) {
+    string_t value;
+    string_init(value);
+    uint8_t data[8];
+    uint32_t version = 0;
+    uint32_t pages = 0;
+    bool result = false;
+
+    do {
+        if(!flipper_format_read_header(flipper_format, value, &version)) break;
+        if(!flipper_format_read_string(flipper_format, "Device type", value)) break;
+        if(!flipper_format_read_hex(flipper_format, "UID", data, 7)) break;
+        if(!flipper_format_read_hex(flipper_format, "ATQA", data, 2)) break;
+        if(!flipper_format_read_hex(flipper_format, "SAK", data, 1)) break;
+        if(!flipper_format_read_uint32(flipper_format, "Pages total", &pages, 1)) break;
+        size_t page = 0;
+        for(; page < pages; page++) {
+            if(!flipper_format_read_hex(flipper_format, bench->keys[page], data, 4)) break;
+        }
+        result = (page == BENCH_FF_NFC_PAGES);
+    } while(false);
+
+    string_clear(value);
+    return result;
+}
+
+static void bench_ff_nfc_save_string(void* context, uint32_t iterations) {
+    BenchFlipperFormat* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        stream_clean(flipper_format_get_raw_stream(bench->flipper_format));
+        furi_check(bench_ff_nfc_save(bench, bench->flipper_format));
+    }
+}
+
+static void bench_ff_nfc_load_string(void* context, uint32_t iterations) {
+    BenchFlipperFormat* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        flipper_format_rewind(bench->flipper_format);
+        furi_check(bench_ff_nfc_load(bench, bench->flipper_format));
+    }
+}
+
+/** Includes open and close, as NFC app loads a dump */
+static void bench_ff_nfc_load_file(void* context, uint32_t iterations) {
+    BenchFlipperFormat* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        FlipperFormat* flipper_format = flipper_format_file_alloc(bench->storage);
+        flipper_format_set_index_mode(flipper_format, true);
+        furi_check(flipper_format_file_open_existing(flipper_format, BENCH_FF_FILE));
+        furi_check(bench_ff_nfc_load(bench, flipper_format));
+        flipper_format_free(flipper_format);
+    }
+}
+
+static void bench_ff_ir_raw_load(void* context, uint32_t iterations) {
+    BenchFlipperFormat* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint32_t count = 0;
+        flipper_format_rewind(bench->flipper_format);
+        furi_check(flipper_format_get_value_count(bench->flipper_format, "data", &count));
+        furi_check(count == BENCH_FF_IR_SAMPLES);
+        furi_check(flipper_format_read_uint32(
+            bench->flipper_format, "data", bench->samples, BENCH_FF_IR_SAMPLES));
+    }
+    bench_sink(bench->samples[0]);
+}
+
+void bench_flipper_format(BenchRunner* runner) {
+    BenchFlipperFormat* bench = malloc(sizeof(BenchFlipperFormat));
+    bench->storage = furi_record_open("storage");
+    bench->flipper_format = flipper_format_string_alloc();
+    for(size_t page = 0; page < BENCH_FF_NFC_PAGES; page++) {
+        snprintf(bench->keys[page], sizeof(bench->keys[page]), "Page %u", (unsigned)page);
+    }
+
+    bench_ff_nfc_save(bench, bench->flipper_format);
+    bench->size = stream_size(flipper_format_get_raw_stream(bench->flipper_format));
+    bench_runner_run(
+        runner, "flipper_format/nfc_save", bench->size, bench_ff_nfc_save_string, bench);
+    bench_runner_run(
+        runner, "flipper_format/nfc_load", bench->size, bench_ff_nfc_load_string, bench);
+
+    if(bench_runner_enabled(runner, "flipper_format/nfc_load_file")) {
+        storage_simply_mkdir(bench->storage, BENCH_FF_DIR);
+        FlipperFormat* flipper_format = flipper_format_file_alloc(bench->storage);
+        bool saved = flipper_format_file_open_always(flipper_format, BENCH_FF_FILE) &&
+                     bench_ff_nfc_save(bench, flipper_format);
+        flipper_format_free(flipper_format);
+
+        if(saved) {
+            bench_runner_run(
+                runner,
+                "flipper_format/nfc_load_file",
+                bench->size,
+                bench_ff_nfc_load_file,
+                bench);
+        } else {
+            bench_runner_fail(runner, "flipper_format/nfc_load_file", "dump is not saved");
+        }
+        storage_simply_remove(bench->storage, BENCH_FF_FILE);
+    }
+
+    // raw signal of infrared remote: one long line of timings
+    uint32_t frequency = 38000;
+    stream_clean(flipper_format_get_raw_stream(bench->flipper_format));
+    for(size_t i = 0; i < BENCH_FF_IR_SAMPLES; i++) {
+        bench->samples[i] = 500 + (i % 4) * 1100;
+    }
+    flipper_format_write_header_cstr(bench->flipper_format, "IR signals file", 1);
+    flipper_format_write_string_cstr(bench->flipper_format, "name", "Power");
+    flipper_format_write_string_cstr(bench->flipper_format, "type", "raw");
+    flipper_format_write_uint32(bench->flipper_format, "frequency", &frequency, 1);
+    flipper_format_write_uint32(
+        bench->flipper_format, "data", bench->samples, BENCH_FF_IR_SAMPLES);
+    bench->size = stream_size(flipper_format_get_raw_stream(bench->flipper_format));
+    bench_runner_run(
+        runner, "flipper_format/ir_raw_load", bench->size, bench_ff_ir_raw_load, bench);
+
+    flipper_format_free(bench->flipper_format);
+    furi_record_close("storage");
+    free(bench);
+}
@@ -0,0 +1,308 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <stream_buffer.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#define BENCH_FURI_CHUNK_SIZE 64
+#define BENCH_FURI_STREAM_SIZE 1024
+#define BENCH_FURI_STOP UINT32_MAX
+#define BENCH_FURI_ITEM_COUNT 1024
+#define BENCH_FURI_RING_BATCH 64
+#define BENCH_FURI_RING_TIMEOUT 10
+#define BENCH_FURI_RING_FLAG 0x01
+#define BENCH_FURI_STRESS_SIZE 16
+#define BENCH_FURI_STRESS_WATERMARK 4
+#define BENCH_FURI_STRESS_ITEMS (1UL << 20)
+
+typedef struct {
+    osMutexId_t mutex;
+    osMessageQueueId_t request;
+    osMessageQueueId_t response;
+    StreamBufferHandle_t stream;
+    StreamBufferHandle_t item_stream;
+    FuriRing* ring;
+    /** Items in one ring push, 0 for random 1 to 7 */
+    size_t push_size;
+    /** Items in one ring pop, 0 for random 1 to 5 */
+    size_t pop_size;
+    uint32_t errors;
+    FuriThread* thread;
+} BenchFuri;
+
+/** xorshift32, deterministic batch sizes for ring stress */
+static uint32_t bench_furi_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void bench_furi_mutex(void* context, uint32_t iterations) {
+    BenchFuri* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        furi_check(osMutexAcquire(bench->mutex, osWaitForever) == osOK);
+        furi_check(osMutexRelease(bench->mutex) == osOK);
+    }
+}
+
+static int32_t bench_furi_echo_thread(void* context) {
+    BenchFuri* bench = context;
+    uint32_t message;
+    do {
+        furi_check(osMessageQueueGet(bench->request, &message, NULL, osWaitForever) == osOK);
+        furi_check(osMessageQueuePut(bench->response, &message, 0, osWaitForever) == osOK);
+    } while(message != BENCH_FURI_STOP);
+    return 0;
+}
+
+/** One op is request to the other thread and response back */
+static void bench_furi_queue_round_trip(void* context, uint32_t iterations) {
+    BenchFuri* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint32_t message = i;
+        furi_check(osMessageQueuePut(bench->request, &message, 0, osWaitForever) == osOK);
+        furi_check(osMessageQueueGet(bench->response, &message, NULL, osWaitForever) == osOK);
+    }
+}
+
+static int32_t bench_furi_producer_thread(void* context) {
+    BenchFuri* bench = context;
+    uint8_t chunk[BENCH_FURI_CHUNK_SIZE] = {0};
+    uint32_t chunks;
+    do {
+        furi_check(osMessageQueueGet(bench->request, &chunks, NULL, osWaitForever) == osOK);
+        for(uint32_t i = 0; i < chunks && chunks != BENCH_FURI_STOP; i++) {
+            size_t sent = 0;
+            while(sent < sizeof(chunk)) {
+                sent += xStreamBufferSend(
+                    bench->stream, &chunk[sent], sizeof(chunk) - sent, osWaitForever);
+            }
+        }
+    } while(chunks != BENCH_FURI_STOP);
+    return 0;
+}
+
+/** One op is chunk passed from producer thread through stream buffer */
+static void bench_furi_stream_buffer(void* context, uint32_t iterations) {
+    BenchFuri* bench = context;
+    uint8_t chunk[BENCH_FURI_CHUNK_SIZE];
+    furi_check(osMessageQueuePut(bench->request, &iterations, 0, osWaitForever) == osOK);
+
+    size_t left = (size_t)iterations * BENCH_FURI_CHUNK_SIZE;
+    while(left) {
+        size_t size = left < sizeof(chunk) ? left : sizeof(chunk);
+        left -= xStreamBufferReceive(bench->stream, chunk, size, osWaitForever);
+    }
+}
+
+/** Sequence numbers one by one, as capture ISR sends samples */
+static int32_t bench_furi_item_producer_thread(void* context) {
+    BenchFuri* bench = context;
+    uint32_t items;
+    do {
+        furi_check(osMessageQueueGet(bench->request, &items, NULL, osWaitForever) == osOK);
+        for(uint32_t i = 0; i < items && items != BENCH_FURI_STOP;) {
+            if(xStreamBufferSendFromISR(bench->item_stream, &i, sizeof(uint32_t), NULL)) {
+                i++;
+            } else {
+                osThreadYield();
+            }
+        }
+    } while(items != BENCH_FURI_STOP);
+    return 0;
+}
+
+/** One op is item received one by one with timeout, as radio workers did */
+static void bench_furi_stream_buffer_item(void* context, uint32_t iterations) {
+    BenchFuri* bench = context;
+    furi_check(osMessageQueuePut(bench->request, &iterations, 0, osWaitForever) == osOK);
+
+    for(uint32_t i = 0; i < iterations;) {
+        uint32_t item;
+        if(xStreamBufferReceive(
+               bench->item_stream, &item, sizeof(uint32_t), BENCH_FURI_RING_TIMEOUT) ==
+           sizeof(uint32_t)) {
+            bench->errors += (item != i);
+            i++;
+        }
+    }
+}
+
+static int32_t bench_furi_ring_producer_thread(void* context) {
+    BenchFuri* bench = context;
+    uint32_t batch[BENCH_FURI_RING_BATCH];
+    uint32_t random = 0x2545F491;
+    uint32_t items;
+    do {
+        furi_check(osMessageQueueGet(bench->request, &items, NULL, osWaitForever) == osOK);
+        for(uint32_t i = 0; i < items && items != BENCH_FURI_STOP;) {
+            size_t size = bench->push_size ? bench->push_size :
+                                             1 + bench_furi_random(&random) % 7;
+            size = MIN(size, items - i);
+            for(size_t j = 0; j < size; j++) {
+                batch[j] = i + j;
+            }
+
+            size_t pushed = furi_ring_push(bench->ring, batch, size);
+            if(!pushed) osThreadYield();
+            i += pushed;
+        }
+    } while(items != BENCH_FURI_STOP);
+    return 0;
+}
+
+/** Pop and check sequence numbers, wake up on watermark or timeout */
+static void bench_furi_ring_receive(BenchFuri* bench, uint32_t items, size_t watermark) {
+    uint32_t batch[BENCH_FURI_RING_BATCH];
+    uint32_t random = 0x9E3779B9;
+    uint32_t next = 0;
+
+    while(next < items) {
+        // Tail of the sequence is below watermark, do not wait for timeout
+        size_t left = items - next;
+        furi_ring_set_notify(
+            bench->ring, osThreadGetId(), BENCH_FURI_RING_FLAG, MIN(watermark, left));
+        furi_ring_wait(bench->ring, BENCH_FURI_RING_TIMEOUT);
+
+        size_t size = bench->pop_size ? bench->pop_size : 1 + bench_furi_random(&random) % 5;
+        size_t count;
+        while((count = furi_ring_pop(bench->ring, batch, size))) {
+            for(size_t i = 0; i < count; i++) {
+                bench->errors += (batch[i] != next++);
+            }
+        }
+    }
+}
+
+/** One op is item pushed one by one and popped in batches */
+static void bench_furi_ring(void* context, uint32_t iterations) {
+    BenchFuri* bench = context;
+    furi_check(osMessageQueuePut(bench->request, &iterations, 0, osWaitForever) == osOK);
+    bench_furi_ring_receive(bench, iterations, BENCH_FURI_RING_BATCH);
+}
+
+static void
+    bench_furi_thread_start(BenchFuri* bench, const char* name, FuriThreadCallback callback) {
+    bench->thread = furi_thread_alloc();
+    furi_thread_set_name(bench->thread, name);
+    furi_thread_set_stack_size(bench->thread, 1024);
+    furi_thread_set_context(bench->thread, bench);
+    furi_thread_set_callback(bench->thread, callback);
+    furi_thread_start(bench->thread);
+}
+
+static void bench_furi_thread_stop(BenchFuri* bench) {
+    uint32_t message = BENCH_FURI_STOP;
+    furi_check(osMessageQueuePut(bench->request, &message, 0, osWaitForever) == osOK);
+    furi_thread_join(bench->thread);
+    furi_thread_free(bench->thread);
+    osMessageQueueReset(bench->response);
+}
+
+static void bench_furi_check(BenchRunner* runner, BenchFuri* bench, const char* name) {
+    if(bench->errors) {
+        bench_runner_fail(runner, name, "items lost or reordered");
+        bench->errors = 0;
+    }
+}
+
+/** Small ring, random batch sizes on both sides: every item comes once and in order */
+static void bench_furi_ring_stress(BenchRunner* runner, BenchFuri* bench) {
+    if(!bench_runner_enabled(runner, "furi/ring_stress")) return;
+
+    FuriRing* ring = bench->ring;
+    bench->ring = furi_ring_alloc(sizeof(uint32_t), BENCH_FURI_STRESS_SIZE);
+    bench->push_size = 0;
+    bench->pop_size = 0;
+    bench->errors = 0;
+
+    bench_furi_thread_start(bench, "BenchProducer", bench_furi_ring_producer_thread);
+    uint32_t items = BENCH_FURI_STRESS_ITEMS;
+    furi_check(osMessageQueuePut(bench->request, &items, 0, osWaitForever) == osOK);
+    bench_furi_ring_receive(bench, items, BENCH_FURI_STRESS_WATERMARK);
+    bench_furi_thread_stop(bench);
+
+    if(bench->errors || furi_ring_count(bench->ring)) {
+        bench_runner_fail(runner, "furi/ring_stress", "items lost or reordered");
+    } else {
+        char metrics[64];
+        snprintf(metrics, sizeof(metrics), "\"items\":%" PRIu32 ",\"errors\":0", items);
+        bench_runner_report(runner, "furi/ring_stress", metrics);
+    }
+
+    furi_ring_free(bench->ring);
+    bench->ring = ring;
+}
+
+void bench_furi(BenchRunner* runner) {
+    BenchFuri* bench = malloc(sizeof(BenchFuri));
+    bench->mutex = osMutexNew(NULL);
+    bench->request = osMessageQueueNew(1, sizeof(uint32_t), NULL);
+    bench->response = osMessageQueueNew(1, sizeof(uint32_t), NULL);
+    bench->stream = xStreamBufferCreate(BENCH_FURI_STREAM_SIZE, BENCH_FURI_CHUNK_SIZE);
+    bench->item_stream =
+        xStreamBufferCreate(sizeof(uint32_t) * BENCH_FURI_ITEM_COUNT, sizeof(uint32_t));
+    bench->ring = furi_ring_alloc(sizeof(uint32_t), BENCH_FURI_ITEM_COUNT);
+
+    bench_runner_run(runner, "furi/mutex_acquire_release", 0, bench_furi_mutex, bench);
+
+    if(bench_runner_enabled(runner, "furi/message_queue_round_trip")) {
+        bench_furi_thread_start(bench, "BenchEcho", bench_furi_echo_thread);
+        bench_runner_run(
+            runner, "furi/message_queue_round_trip", 0, bench_furi_queue_round_trip, bench);
+        bench_furi_thread_stop(bench);
+    }
+
+    if(bench_runner_enabled(runner, "furi/stream_buffer_64b")) {
+        bench_furi_thread_start(bench, "BenchProducer", bench_furi_producer_thread);
+        bench_runner_run(
+            runner,
+            "furi/stream_buffer_64b",
+            BENCH_FURI_CHUNK_SIZE,
+            bench_furi_stream_buffer,
+            bench);
+        bench_furi_thread_stop(bench);
+    }
+
+    if(bench_runner_enabled(runner, "furi/stream_buffer_item")) {
+        bench_furi_thread_start(bench, "BenchProducer", bench_furi_item_producer_thread);
+        bench_runner_run(
+            runner,
+            "furi/stream_buffer_item",
+            sizeof(uint32_t),
+            bench_furi_stream_buffer_item,
+            bench);
+        bench_furi_thread_stop(bench);
+        bench_furi_check(runner, bench, "furi/stream_buffer_item");
+    }
+
+    bench->pop_size = BENCH_FURI_RING_BATCH;
+    if(bench_runner_enabled(runner, "furi/ring_item")) {
+        bench->push_size = 1;
+        bench_furi_thread_start(bench, "BenchProducer", bench_furi_ring_producer_thread);
+        bench_runner_run(runner, "furi/ring_item", sizeof(uint32_t), bench_furi_ring, bench);
+        bench_furi_thread_stop(bench);
+        bench_furi_check(runner, bench, "furi/ring_item");
+    }
+
+    if(bench_runner_enabled(runner, "furi/ring_batch_64")) {
+        bench->push_size = BENCH_FURI_RING_BATCH;
+        bench_furi_thread_start(bench, "BenchProducer", bench_furi_ring_producer_thread);
+        bench_runner_run(
+            runner, "furi/ring_batch_64", sizeof(uint32_t), bench_furi_ring, bench);
+        bench_furi_thread_stop(bench);
+        bench_furi_check(runner, bench, "furi/ring_batch_64");
+    }
+
+    bench_furi_ring_stress(runner, bench);
+
+    furi_ring_free(bench->ring);
+    vStreamBufferDelete(bench->item_stream);
+    vStreamBufferDelete(bench->stream);
+    osMessageQueueDelete(bench->response);
+    osMessageQueueDelete(bench->request);
+    osMutexDelete(bench->mutex);
+    free(bench);
+}
@@ -0,0 +1,220 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <furi_hal_spi.h>
+#include <gui/canvas_i.h>
+#include <assets_icons.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#define TAG "BenchGui"
+
+/** Four full refresh periods of canvas_commit */
+#define BENCH_GUI_FRAMES (CANVAS_FULL_REFRESH_INTERVAL * 4)
+#define BENCH_GUI_WIDTH 128
+#define BENCH_GUI_HEIGHT 64
+#define BENCH_GUI_STATUS_BAR_HEIGHT 13
+#define BENCH_GUI_MENU_ITEMS 12
+#define BENCH_GUI_MENU_LINES 4
+#define BENCH_GUI_METRICS_SIZE 256
+
+typedef void (*BenchGuiDraw)(Canvas* canvas, uint32_t frame);
+
+typedef struct {
+    const char* name;
+    BenchGuiDraw draw;
+    bool status_bar; /**< windowed view, status bar is redrawn with it */
+} BenchGuiView;
+
+typedef struct {
+    uint32_t bytes; /**< framebuffer bytes, as counted by canvas_commit */
+    FuriHalSpiStats spi; /**< with controller commands */
+} BenchGuiResult;
+
+static const char* const bench_gui_menu_items[BENCH_GUI_MENU_ITEMS] = {
+    "Sub-GHz",
+    "125 kHz RFID",
+    "NFC",
+    "Infrared",
+    "GPIO",
+    "iButton",
+    "Bad USB",
+    "U2F",
+    "Clock",
+    "Snake Game",
+    "Music Player",
+    "Settings",
+};
+
+/* Status bar as gui draws it: background, battery and clock, clock ticks every minute */
+static void bench_gui_draw_status_bar(Canvas* canvas, uint32_t frame) {
+    canvas_frame_set(canvas, 0, 0, BENCH_GUI_WIDTH, BENCH_GUI_STATUS_BAR_HEIGHT);
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, 1, 1, 9, 7);
+    canvas_draw_box(canvas, 7, 3, 58, 6);
+    canvas_draw_box(canvas, 61, 1, 32, 7);
+    canvas_draw_box(canvas, 89, 3, 38, 6);
+    canvas_set_color(canvas, ColorBlack);
+    canvas_set_bitmap_mode(canvas, 1);
+    canvas_draw_icon(canvas, 0, 0, &I_Background_128x11);
+    canvas_set_bitmap_mode(canvas, 0);
+    canvas_draw_icon(canvas, 96, 2, &I_Battery_26x8);
+    canvas_draw_box(canvas, 98, 4, 18, 4);
+
+    char clock[8];
+    uint32_t minutes = 12 * 60 + frame / 60;
+    snprintf(
+        clock, sizeof(clock), "%02" PRIu32 ":%02" PRIu32, (minutes / 60) % 24, minutes % 60);
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str(canvas, 4, 8, clock);
+}
+
+/* Desktop: dolphin and clock, nothing else moves */
+static void bench_gui_draw_idle(Canvas* canvas, uint32_t frame) {
+    UNUSED(frame);
+    canvas_draw_icon(canvas, 0, 0, &I_Flipper_young_80x60);
+}
+
+/* Main menu, cursor steps every 8 frames and list scrolls under it */
+static void bench_gui_draw_menu(Canvas* canvas, uint32_t frame) {
+    size_t selected = (frame / 8) % BENCH_GUI_MENU_ITEMS;
+    size_t first = MIN(selected, BENCH_GUI_MENU_ITEMS - BENCH_GUI_MENU_LINES);
+    canvas_set_font(canvas, FontSecondary);
+    for(size_t i = 0; i < BENCH_GUI_MENU_LINES; i++) {
+        size_t item = first + i;
+        uint8_t y = i * 12;
+        if(item == selected) {
+            canvas_set_color(canvas, ColorBlack);
+            canvas_draw_rbox(canvas, 0, y, 120, 12, 2);
+            canvas_set_color(canvas, ColorWhite);
+        } else {
+            canvas_set_color(canvas, ColorBlack);
+        }
+        canvas_draw_str(canvas, 6, y + 9, bench_gui_menu_items[item]);
+    }
+
+    canvas_set_color(canvas, ColorBlack);
+    uint8_t thumb = 48 / BENCH_GUI_MENU_ITEMS;
+    canvas_draw_line(canvas, 124, 0, 124, 47);
+    canvas_draw_box(canvas, 123, selected * thumb, 3, thumb);
+}
+
+/* File transfer: bar grows one pixel per frame, percent text follows */
+static void bench_gui_draw_progress(Canvas* canvas, uint32_t frame) {
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str_aligned(canvas, 64, 4, AlignCenter, AlignTop, "Writing...");
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, 64, 16, AlignCenter, AlignTop, "/ext/subghz/Garage.sub");
+
+    uint8_t progress = frame % 101;
+    canvas_draw_rframe(canvas, 8, 30, 112, 10, 2);
+    canvas_draw_box(canvas, 10, 32, 108 * progress / 100, 6);
+
+    char percent[8];
+    snprintf(percent, sizeof(percent), "%u%%", progress);
+    canvas_draw_str_aligned(canvas, 64, 49, AlignCenter, AlignBottom, percent);
+}
+
+/* Fullscreen stopwatch: big digits change every frame */
+static void bench_gui_draw_stopwatch(Canvas* canvas, uint32_t frame) {
+    char counter[16];
+    snprintf(
+        counter,
+        sizeof(counter),
+        "%02" PRIu32 ":%02" PRIu32,
+        (frame / 100) % 100,
+        frame % 100);
+    canvas_set_font(canvas, FontBigNumbers);
+    canvas_draw_str_aligned(canvas, 64, 28, AlignCenter, AlignCenter, counter);
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_icon(canvas, 50, 52, &I_ButtonCenter_7x7);
+    canvas_draw_str(canvas, 60, 59, "Pause");
+}
+
+/* Fullscreen loading: spinner dot runs around the center */
+static void bench_gui_draw_loading(Canvas* canvas, uint32_t frame) {
+    static const int8_t spinner[8][2] = {
+        {0, -6}, {4, -4}, {6, 0}, {4, 4}, {0, 6}, {-4, 4}, {-6, 0}, {-4, -4}};
+    const int8_t* dot = spinner[frame % 8];
+    canvas_draw_circle(canvas, 64, 32, 6);
+    canvas_draw_disc(canvas, 64 + dot[0], 32 + dot[1], 2);
+}
+
+static const BenchGuiView bench_gui_views[] = {
+    {.name = "idle", .draw = bench_gui_draw_idle, .status_bar = true},
+    {.name = "menu", .draw = bench_gui_draw_menu, .status_bar = true},
+    {.name = "progress", .draw = bench_gui_draw_progress, .status_bar = true},
+    {.name = "stopwatch", .draw = bench_gui_draw_stopwatch, .status_bar = false},
+    {.name = "loading", .draw = bench_gui_draw_loading, .status_bar = false},
+};
+
+/* Same frames as gui renders them, invalidate turns every commit into full flush */
+static void bench_gui_render(
+    Canvas* canvas,
+    const BenchGuiView* view,
+    bool invalidate,
+    BenchGuiResult* result) {
+    CanvasCommitStats before;
+    CanvasCommitStats after;
+
+    canvas_invalidate(canvas);
+    canvas_commit(canvas);
+    canvas_get_commit_stats(canvas, &before);
+    furi_hal_spi_reset_stats(&furi_hal_spi_bus_handle_display);
+
+    for(uint32_t frame = 0; frame < BENCH_GUI_FRAMES; frame++) {
+        canvas_reset(canvas);
+        if(view->status_bar) {
+            bench_gui_draw_status_bar(canvas, frame);
+            canvas_frame_set(
+                canvas,
+                0,
+                BENCH_GUI_STATUS_BAR_HEIGHT,
+                BENCH_GUI_WIDTH,
+                BENCH_GUI_HEIGHT - BENCH_GUI_STATUS_BAR_HEIGHT);
+        } else {
+            canvas_frame_set(canvas, 0, 0, BENCH_GUI_WIDTH, BENCH_GUI_HEIGHT);
+        }
+        view->draw(canvas, frame);
+        if(invalidate) canvas_invalidate(canvas);
+        canvas_commit(canvas);
+    }
+
+    canvas_get_commit_stats(canvas, &after);
+    result->bytes = after.bytes_sent - before.bytes_sent;
+    furi_hal_spi_get_stats(&furi_hal_spi_bus_handle_display, &result->spi);
+}
+
+void bench_gui(BenchRunner* runner) {
+    Canvas* canvas = NULL;
+
+    for(size_t i = 0; i < COUNT_OF(bench_gui_views); i++) {
+        const BenchGuiView* view = &bench_gui_views[i];
+        char name[32];
+        snprintf(name, sizeof(name), "gui/flush/%s", view->name);
+        if(!bench_runner_enabled(runner, name)) continue;
+        if(!canvas) canvas = canvas_init();
+
+        BenchGuiResult full;
+        BenchGuiResult partial;
+        bench_gui_render(canvas, view, true, &full);
+        bench_gui_render(canvas, view, false, &partial);
+
+        char metrics[BENCH_GUI_METRICS_SIZE];
+        snprintf(
+            metrics,
+            sizeof(metrics),
+            "\"frames\":%u,\"full_bytes_per_frame\":%.1f,\"partial_bytes_per_frame\":%.1f,"
+            "\"full_spi_us_per_frame\":%.1f,\"partial_spi_us_per_frame\":%.1f,"
+            "\"partial_transfers\":%" PRIu32,
+            BENCH_GUI_FRAMES,
+            (double)full.bytes / BENCH_GUI_FRAMES,
+            (double)partial.bytes / BENCH_GUI_FRAMES,
+            (double)full.spi.bus_time_us / BENCH_GUI_FRAMES,
+            (double)partial.spi.bus_time_us / BENCH_GUI_FRAMES,
+            partial.spi.transfers);
+        bench_runner_report(runner, name, metrics);
+    }
+
+    if(canvas) canvas_free(canvas);
+}
@@ -0,0 +1,348 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <gui/icon_i.h>
+#include <assets_icons.h>
+#include <heatshrink_encoder.h>
+#include <heatshrink_decoder.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_HEATSHRINK_ICONS_SIZE (64 * 1024)
+#define BENCH_HEATSHRINK_SUB_SIZE (64 * 1024)
+#define BENCH_HEATSHRINK_LOOKAHEAD_BITS 4
+#define BENCH_HEATSHRINK_DECODER_INPUT_SIZE 256
+/** Icon decoder input, same as furi_hal_compress */
+#define BENCH_HEATSHRINK_ICON_INPUT_SIZE 1024
+#define BENCH_HEATSHRINK_ICON_WINDOW_BITS 8
+/** Depth used by compress stream */
+#define BENCH_HEATSHRINK_MAX_CHAIN 64
+#define BENCH_HEATSHRINK_NAME_SIZE 48
+#define BENCH_HEATSHRINK_METRICS_SIZE 192
+
+/** Icons header, same as furi_hal_compress icon decoder reads */
+typedef struct {
+    uint8_t is_compressed;
+    uint8_t reserved;
+    uint16_t compressed_buff_size;
+} BenchHeatshrinkIconHeader;
+
+/** Big pictures, animations and small glyphs */
+static const Icon* const bench_heatshrink_icons[] = {
+    &A_Levelup1_128x64,
+    &A_Levelup2_128x64,
+    &I_BLE_Pairing_128x64,
+    &I_DFU_128x50,
+    &I_InfraredLearn_128x64,
+    &I_InfraredSend_128x64,
+    &I_DolphinFirstStart0_70x53,
+    &I_DolphinFirstStart1_59x53,
+    &I_DolphinFirstStart2_59x51,
+    &I_DolphinFirstStart3_57x48,
+    &I_DolphinFirstStart4_67x53,
+    &I_DolphinFirstStart5_54x49,
+    &I_DolphinFirstStart6_58x54,
+    &I_DolphinFirstStart7_61x51,
+    &I_DolphinFirstStart8_56x51,
+    &I_DolphinReadingSuccess_59x63,
+    &I_RFIDDolphinReceive_97x61,
+    &I_RFIDDolphinSend_97x61,
+    &I_RFIDDolphinSuccess_108x57,
+    &I_passport_happy1_46x49,
+    &I_passport_okay1_46x49,
+    &I_passport_bad1_46x49,
+    &A_Loading_24,
+    &A_125khz_14,
+    &A_BadUsb_14,
+    &A_Infrared_14,
+    &A_NFC_14,
+    &A_Sub1ghz_14,
+    &A_iButton_14,
+    &I_BatteryBody_52x28,
+    &I_Battery_16x16,
+    &I_Button_18x18,
+    &I_ButtonCenter_7x7,
+    &I_Ok_btn_9x9,
+    &I_Power_25x27,
+    &I_Vol_up_25x27,
+};
+
+typedef struct {
+    const char* name;
+    uint8_t* data;
+    size_t size;
+} BenchHeatshrinkData;
+
+typedef struct {
+    const char* name;
+    HSE_match_finder match_finder;
+    uint16_t max_chain;
+} BenchHeatshrinkFinder;
+
+static const BenchHeatshrinkFinder bench_heatshrink_finders[] = {
+    {"index", HSEM_INDEX, 0},
+    {"chain_all", HSEM_HASH_CHAIN, 0},
+    {"chain_64", HSEM_HASH_CHAIN, BENCH_HEATSHRINK_MAX_CHAIN},
+};
+
+#define BENCH_HEATSHRINK_FINDERS COUNT_OF(bench_heatshrink_finders)
+
+static const uint8_t bench_heatshrink_window_bits[] = {8, 12};
+
+typedef struct {
+    const BenchHeatshrinkData* data;
+    heatshrink_encoder* encoder;
+    uint8_t* buffer;
+    size_t buffer_size;
+    uint8_t* output;
+    size_t output_capacity;
+} BenchHeatshrink;
+
+static size_t bench_heatshrink_encode_once(BenchHeatshrink* bench) {
+    heatshrink_encoder* encoder = bench->encoder;
+    const BenchHeatshrinkData* data = bench->data;
+    uint8_t* output = bench->output;
+    size_t capacity = bench->output_capacity;
+
+    // Reset keeps the window, decoder starts from zeroed one
+    memset(bench->buffer, 0, bench->buffer_size);
+    heatshrink_encoder_reset(encoder);
+    size_t sunk = 0;
+    size_t polled = 0;
+    size_t count;
+    while(sunk < data->size) {
+        furi_check(
+            heatshrink_encoder_sink(encoder, &data->data[sunk], data->size - sunk, &count) >= 0);
+        sunk += count;
+        HSE_poll_res res;
+        do {
+            res = heatshrink_encoder_poll(encoder, &output[polled], capacity - polled, &count);
+            polled += count;
+        } while(res == HSER_POLL_MORE);
+        furi_check(res == HSER_POLL_EMPTY);
+    }
+    while(heatshrink_encoder_finish(encoder) == HSER_FINISH_MORE) {
+        heatshrink_encoder_poll(encoder, &output[polled], capacity - polled, &count);
+        polled += count;
+    }
+    return polled;
+}
+
+static bool bench_heatshrink_round_trip(
+    const BenchHeatshrinkData* data,
+    uint8_t window_bits,
+    const uint8_t* compressed,
+    size_t size) {
+    uint8_t* buffer = malloc(BENCH_HEATSHRINK_DECODER_INPUT_SIZE + (1 << window_bits));
+    heatshrink_decoder* decoder = heatshrink_decoder_alloc(
+        buffer, BENCH_HEATSHRINK_DECODER_INPUT_SIZE, window_bits, BENCH_HEATSHRINK_LOOKAHEAD_BITS);
+    uint8_t* output = malloc(data->size + 1);
+    size_t sunk = 0;
+    size_t polled = 0;
+    size_t count;
+    bool overflow = false;
+    while(sunk < size && !overflow) {
+        heatshrink_decoder_sink(decoder, (uint8_t*)&compressed[sunk], size - sunk, &count);
+        sunk += count;
+        HSD_poll_res res;
+        do {
+            res = heatshrink_decoder_poll(
+                decoder, &output[polled], data->size + 1 - polled, &count);
+            polled += count;
+            overflow = (polled > data->size);
+        } while(res == HSDR_POLL_MORE && !overflow);
+    }
+    while(!overflow && heatshrink_decoder_finish(decoder) == HSDR_FINISH_MORE) {
+        heatshrink_decoder_poll(decoder, &output[polled], data->size + 1 - polled, &count);
+        polled += count;
+        overflow = (polled > data->size);
+    }
+    bool result = !overflow && (polled == data->size) &&
+                  (memcmp(output, data->data, data->size) == 0);
+    free(output);
+    heatshrink_decoder_free(decoder);
+    free(buffer);
+    return result;
+}
+
+static void bench_heatshrink_encode(void* context, uint32_t iterations) {
+    BenchHeatshrink* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_sink(bench_heatshrink_encode_once(bench));
+    }
+}
+
+/** Decoded frames of compiled icons, repeated up to the data size */
+static void bench_heatshrink_icons_data(BenchHeatshrinkData* data) {
+    uint8_t* buffer = malloc(
+        BENCH_HEATSHRINK_ICON_INPUT_SIZE + (1 << BENCH_HEATSHRINK_ICON_WINDOW_BITS));
+    heatshrink_decoder* decoder = heatshrink_decoder_alloc(
+        buffer,
+        BENCH_HEATSHRINK_ICON_INPUT_SIZE,
+        BENCH_HEATSHRINK_ICON_WINDOW_BITS,
+        BENCH_HEATSHRINK_LOOKAHEAD_BITS);
+    data->name = "icons";
+    data->data = malloc(BENCH_HEATSHRINK_ICONS_SIZE);
+    data->size = 0;
+
+    while(data->size < BENCH_HEATSHRINK_ICONS_SIZE) {
+        for(size_t i = 0; i < COUNT_OF(bench_heatshrink_icons); i++) {
+            const Icon* icon = bench_heatshrink_icons[i];
+            size_t frame_size = ((icon->width + 7) / 8) * icon->height;
+            for(size_t frame = 0; frame < icon->frame_count; frame++) {
+                if(data->size + frame_size > BENCH_HEATSHRINK_ICONS_SIZE) {
+                    frame_size = BENCH_HEATSHRINK_ICONS_SIZE - data->size;
+                }
+                const uint8_t* icon_data = icon->frames[frame];
+                BenchHeatshrinkIconHeader header;
+                memcpy(&header, icon_data, sizeof(header));
+                if(!header.is_compressed) {
+                    memcpy(&data->data[data->size], &icon_data[1], frame_size);
+                    data->size += frame_size;
+                    continue;
+                }
+
+                heatshrink_decoder_reset(decoder);
+                size_t count;
+                heatshrink_decoder_sink(
+                    decoder,
+                    (uint8_t*)&icon_data[sizeof(header)],
+                    header.compressed_buff_size,
+                    &count);
+                size_t decoded = 0;
+                HSD_poll_res res;
+                do {
+                    res = heatshrink_decoder_poll(
+                        decoder, &data->data[data->size + decoded], frame_size - decoded, &count);
+                    decoded += count;
+                } while(res == HSDR_POLL_MORE && decoded < frame_size);
+                data->size += decoded;
+            }
+        }
+    }
+
+    heatshrink_decoder_free(decoder);
+    free(buffer);
+}
+
+/** Sub-GHz RAW capture: jittered pulses of a remote between noise */
+static void bench_heatshrink_sub_data(BenchHeatshrinkData* data) {
+    static const char header[] = "Filetype: Flipper SubGhz RAW File\n"
+                                 "Version: 1\n"
+                                 "Frequency: 433920000\n"
+                                 "Preset: FuriHalSubGhzPresetOok650Async\n"
+                                 "Protocol: RAW\n";
+    data->name = "sub_raw";
+    data->data = malloc(BENCH_HEATSHRINK_SUB_SIZE);
+    data->size = strlen(header);
+    memcpy(data->data, header, data->size);
+
+    uint32_t seed = 0x5EED;
+    uint32_t count = 0;
+    char text[16];
+    while(data->size < BENCH_HEATSHRINK_SUB_SIZE) {
+        if(count % 512 == 0) {
+            const char* key = count ? "\nRAW_Data:" : "RAW_Data:";
+            size_t length = MIN(strlen(key), BENCH_HEATSHRINK_SUB_SIZE - data->size);
+            memcpy(&data->data[data->size], key, length);
+            data->size += length;
+        }
+        seed = seed * 1103515245 + 12345;
+        uint32_t random = seed >> 16;
+        // Bit of the key is short and long pulse, noise between key repeats
+        int32_t duration;
+        if((count / 64) % 4 == 3) {
+            duration = 50 + random % 2000;
+        } else {
+            duration = ((random & 0x100) ? 1200 : 400) + (int32_t)(random % 61) - 30;
+        }
+        if(count & 1) duration = -duration;
+        int length = snprintf(text, sizeof(text), " %ld", (long)duration);
+        length = MIN((size_t)length, BENCH_HEATSHRINK_SUB_SIZE - data->size);
+        memcpy(&data->data[data->size], text, length);
+        data->size += length;
+        count++;
+    }
+}
+
+static void bench_heatshrink_compare(
+    BenchRunner* runner,
+    BenchHeatshrinkData* data,
+    uint8_t window_bits) {
+    char name[BENCH_HEATSHRINK_NAME_SIZE];
+    bool enabled = false;
+    for(size_t i = 0; i <= BENCH_HEATSHRINK_FINDERS; i++) {
+        const char* suffix =
+            (i < BENCH_HEATSHRINK_FINDERS) ? bench_heatshrink_finders[i].name : "ratio";
+        snprintf(name, sizeof(name), "heatshrink/%s_w%u_%s", data->name, window_bits, suffix);
+        enabled |= bench_runner_enabled(runner, name);
+    }
+    if(!enabled) return;
+
+    BenchHeatshrink bench = {
+        .data = data,
+        .buffer_size = 2 << window_bits,
+        .output_capacity = data->size + data->size / 8 + 64,
+    };
+    bench.buffer = malloc(bench.buffer_size);
+    uint8_t* outputs[BENCH_HEATSHRINK_FINDERS];
+    size_t sizes[BENCH_HEATSHRINK_FINDERS];
+    bool round_trip = true;
+
+    for(size_t i = 0; i < BENCH_HEATSHRINK_FINDERS; i++) {
+        const BenchHeatshrinkFinder* finder = &bench_heatshrink_finders[i];
+        bench.encoder = heatshrink_encoder_alloc_ex(
+            bench.buffer,
+            window_bits,
+            BENCH_HEATSHRINK_LOOKAHEAD_BITS,
+            finder->match_finder,
+            finder->max_chain);
+        bench.output = malloc(bench.output_capacity);
+        sizes[i] = bench_heatshrink_encode_once(&bench);
+        outputs[i] = bench.output;
+        round_trip &= bench_heatshrink_round_trip(data, window_bits, outputs[i], sizes[i]);
+
+        snprintf(
+            name, sizeof(name), "heatshrink/%s_w%u_%s", data->name, window_bits, finder->name);
+        bench_runner_run(runner, name, data->size, bench_heatshrink_encode, &bench);
+        heatshrink_encoder_free(bench.encoder);
+    }
+
+    // Every match is two bytes or longer, so all chain candidates find what index finds
+    snprintf(name, sizeof(name), "heatshrink/%s_w%u_ratio", data->name, window_bits);
+    if(!round_trip) {
+        bench_runner_fail(runner, name, "round trip mismatch");
+    } else if(sizes[1] != sizes[0] || memcmp(outputs[1], outputs[0], sizes[0]) != 0) {
+        bench_runner_fail(runner, name, "chain_all output differs from index");
+    } else {
+        char metrics[BENCH_HEATSHRINK_METRICS_SIZE];
+        snprintf(
+            metrics,
+            sizeof(metrics),
+            "\"bytes\":%zu,\"index\":%.3f,\"chain_all\":%.3f,\"chain_64\":%.3f,"
+            "\"chain_all_identical\":true",
+            data->size,
+            (double)sizes[0] / data->size,
+            (double)sizes[1] / data->size,
+            (double)sizes[2] / data->size);
+        bench_runner_report(runner, name, metrics);
+    }
+
+    for(size_t i = 0; i < BENCH_HEATSHRINK_FINDERS; i++) {
+        free(outputs[i]);
+    }
+    free(bench.buffer);
+}
+
+void bench_heatshrink(BenchRunner* runner) {
+    BenchHeatshrinkData data[2];
+    bench_heatshrink_icons_data(&data[0]);
+    bench_heatshrink_sub_data(&data[1]);
+
+    for(size_t i = 0; i < COUNT_OF(data); i++) {
+        for(size_t w = 0; w < COUNT_OF(bench_heatshrink_window_bits); w++) {
+            bench_heatshrink_compare(runner, &data[i], bench_heatshrink_window_bits[w]);
+        }
+        free(data[i].data);
+    }
+}
@@ -0,0 +1,120 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <infrared.h>
+#include <stdio.h>
+
+#define BENCH_INFRARED_TIMINGS_MAX 200
+
+typedef struct {
+    InfraredEncoderHandler* encoder;
+    InfraredDecoderHandler* decoder;
+    InfraredMessage message;
+    uint32_t timings[BENCH_INFRARED_TIMINGS_MAX];
+    uint32_t timings_count;
+    bool start_level;
+} BenchInfrared;
+
+/** Encode message, same levels merged as they come to decoder from the receiver */
+static void bench_infrared_encode_message(BenchInfrared* bench) {
+    infrared_reset_encoder(bench->encoder, &bench->message);
+
+    uint32_t duration;
+    bool level = false;
+    bool level_read;
+    uint32_t i = 0;
+    bool first = true;
+    InfraredStatus status;
+    do {
+        status = infrared_encode(bench->encoder, &duration, &level_read);
+        if(first) {
+            bench->start_level = level_read;
+            bench->timings[0] = 0;
+            first = false;
+        } else if(level_read != level) {
+            furi_check(++i < BENCH_INFRARED_TIMINGS_MAX);
+            bench->timings[i] = 0;
+        }
+        level = level_read;
+        bench->timings[i] += duration;
+        furi_check((status == InfraredStatusOk) || (status == InfraredStatusDone));
+    } while(status != InfraredStatusDone);
+
+    bench->timings_count = i + 1;
+}
+
+static const InfraredMessage* bench_infrared_decode_message(BenchInfrared* bench) {
+    const InfraredMessage* message = NULL;
+    bool level = bench->start_level;
+
+    infrared_reset_decoder(bench->decoder);
+    for(uint32_t i = 0; i < bench->timings_count && !message; i++) {
+        message = infrared_decode(bench->decoder, level, bench->timings[i]);
+        level = !level;
+    }
+    if(!message) {
+        message = infrared_check_decoder_ready(bench->decoder);
+    }
+    return message;
+}
+
+static void bench_infrared_encode(void* context, uint32_t iterations) {
+    BenchInfrared* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_infrared_encode_message(bench);
+    }
+    bench_sink(bench->timings_count);
+}
+
+static void bench_infrared_decode(void* context, uint32_t iterations) {
+    BenchInfrared* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        const InfraredMessage* message = bench_infrared_decode_message(bench);
+        bench_sink(message ? message->command : 0);
+    }
+}
+
+void bench_infrared(BenchRunner* runner) {
+    BenchInfrared* bench = malloc(sizeof(BenchInfrared));
+    bench->encoder = infrared_alloc_encoder();
+    bench->decoder = infrared_alloc_decoder();
+
+    for(InfraredProtocol protocol = 0; protocol < InfraredProtocolMAX; protocol++) {
+        if(!infrared_is_protocol_valid(protocol)) continue;
+
+        char encode_name[64];
+        char decode_name[64];
+        const char* protocol_name = infrared_get_protocol_name(protocol);
+        snprintf(encode_name, sizeof(encode_name), "infrared/encode/%s", protocol_name);
+        snprintf(decode_name, sizeof(decode_name), "infrared/decode/%s", protocol_name);
+
+        // all bits set: longest marks for pulse distance protocols
+        bench->message.protocol = protocol;
+        bench->message.address = (1UL << infrared_get_protocol_address_length(protocol)) - 1;
+        bench->message.command = (1UL << infrared_get_protocol_command_length(protocol)) - 1;
+        bench->message.repeat = false;
+        bench_infrared_encode_message(bench);
+
+        // RC5X spec length includes command bit sent as start bit, keep what decoder sees
+        const InfraredMessage* decoded = bench_infrared_decode_message(bench);
+        if(decoded && decoded->protocol == protocol) {
+            bench->message.command = decoded->command;
+            bench_infrared_encode_message(bench);
+            decoded = bench_infrared_decode_message(bench);
+        }
+
+        if(!decoded || decoded->protocol != protocol ||
+           decoded->address != bench->message.address ||
+           decoded->command != bench->message.command) {
+            bench_runner_fail(runner, decode_name, "decoded message mismatch");
+            continue;
+        }
+
+        bench_runner_run(runner, encode_name, 0, bench_infrared_encode, bench);
+        bench_runner_run(runner, decode_name, 0, bench_infrared_decode, bench);
+    }
+
+    infrared_free_decoder(bench->decoder);
+    infrared_free_encoder(bench->encoder);
+    free(bench);
+}
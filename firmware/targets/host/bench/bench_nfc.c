@@ -0,0 +1,218 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <nfc_protocols/crypto1.h>
+#include <nfc_protocols/nfca.h>
+#include <nfc_protocols/mifare_ultralight.h>
+
+#define BENCH_NFC_KEYSTREAM_SIZE 1024
+#define BENCH_NFC_FRAME_SIZE 18
+/** NTAG215 */
+#define BENCH_NFC_MF_UL_PAGES 135
+#define BENCH_NFC_MF_UL_FAST_READ_PAGES 16
+#define BENCH_NFC_MF_UL_TRACE_MAX 64
+#define BENCH_NFC_MF_UL_TX_SIZE 256
+
+typedef struct {
+    uint8_t data[8];
+    uint8_t size;
+} BenchNfcCommand;
+
+/** Reader commands as phone sends them reading a tag, then a page update */
+typedef struct {
+    MifareUlDevice device;
+    BenchNfcCommand trace[BENCH_NFC_MF_UL_TRACE_MAX];
+    size_t trace_size;
+    size_t trace_tx_bytes;
+    uint8_t tx[BENCH_NFC_MF_UL_TX_SIZE];
+} BenchNfcMfUl;
+
+typedef struct {
+    Crypto1 crypto;
+    uint8_t frame[BENCH_NFC_FRAME_SIZE];
+} BenchNfc;
+
+/** Sector auth as reader does it: key load, uid^nt feed, then encrypted block read */
+static void bench_nfc_crypto1_auth(void* context, uint32_t iterations) {
+    BenchNfc* bench = context;
+    const uint32_t uid = 0xDEADBEEF;
+    for(uint32_t i = 0; i < iterations; i++) {
+        uint32_t nt = prng_successor(i, 32);
+        crypto1_init(&bench->crypto, 0xFFFFFFFFFFFFULL);
+        crypto1_word(&bench->crypto, uid ^ nt, 0);
+        for(size_t j = 0; j < BENCH_NFC_FRAME_SIZE; j++) {
+            bench->frame[j] ^= crypto1_byte(&bench->crypto, 0, 0);
+        }
+    }
+    bench_sink(bench->frame[0]);
+}
+
+static void bench_nfc_crypto1_keystream(void* context, uint32_t iterations) {
+    BenchNfc* bench = context;
+    uint8_t value = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        for(size_t j = 0; j < BENCH_NFC_KEYSTREAM_SIZE; j++) {
+            value ^= crypto1_byte(&bench->crypto, 0, 0);
+        }
+    }
+    bench_sink(value);
+}
+
+static void bench_nfc_crc16(void* context, uint32_t iterations) {
+    BenchNfc* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        nfca_append_crc16(bench->frame, BENCH_NFC_FRAME_SIZE - 2);
+    }
+    bench_sink(bench->frame[BENCH_NFC_FRAME_SIZE - 1]);
+}
+
+static void bench_nfc_mf_ul_add(BenchNfcMfUl* bench, const uint8_t* data, uint8_t size) {
+    furi_check(bench->trace_size < BENCH_NFC_MF_UL_TRACE_MAX);
+    BenchNfcCommand* command = &bench->trace[bench->trace_size++];
+    memcpy(command->data, data, size);
+    command->size = size;
+}
+
+static uint16_t bench_nfc_mf_ul_response(BenchNfcMfUl* bench, const BenchNfcCommand* command) {
+    uint8_t rx[8];
+    uint16_t tx_bits = 0;
+    uint32_t data_type = 0;
+    memcpy(rx, command->data, command->size);
+    mf_ul_prepare_emulation_response(
+        rx, command->size, bench->tx, &tx_bits, &data_type, &bench->device);
+    return tx_bits;
+}
+
+static BenchNfcMfUl* bench_nfc_mf_ul_alloc() {
+    BenchNfcMfUl* bench = malloc(sizeof(BenchNfcMfUl));
+    memset(bench, 0, sizeof(BenchNfcMfUl));
+
+    MifareUlData* data = malloc(sizeof(MifareUlData));
+    memset(data, 0, sizeof(MifareUlData));
+    const MfUltralightVersion version = {0x00, 0x04, 0x04, 0x02, 0x01, 0x00, 0x11, 0x03};
+    data->version = version;
+    data->data_size = BENCH_NFC_MF_UL_PAGES * 4;
+    for(size_t i = 0; i < data->data_size; i++) {
+        data->data[i] = i * 7 + 1;
+    }
+    for(size_t i = 0; i < sizeof(data->signature); i++) {
+        data->signature[i] = i;
+    }
+    mf_ul_prepare_emulation(&bench->device, data);
+    free(data);
+    // Emulation keeps pointer to source auth data, point it to own copy
+    bench->device.auth_data =
+        (MifareUlAuthData*)&bench->device.data.data[(BENCH_NFC_MF_UL_PAGES - 2) * 4];
+
+    const uint8_t get_version[] = {MF_UL_GET_VERSION_CMD};
+    const uint8_t read_sig[] = {MF_UL_READ_SIG, 0x00};
+    const uint8_t read_cnt[] = {MF_UL_READ_CNT, 0x02};
+    bench_nfc_mf_ul_add(bench, get_version, sizeof(get_version));
+    bench_nfc_mf_ul_add(bench, read_sig, sizeof(read_sig));
+    bench_nfc_mf_ul_add(bench, read_cnt, sizeof(read_cnt));
+    for(uint8_t page = 0; page < BENCH_NFC_MF_UL_PAGES; page += 4) {
+        const uint8_t read[] = {MF_UL_READ_CMD, page};
+        bench_nfc_mf_ul_add(bench, read, sizeof(read));
+    }
+    for(uint8_t page = 0; page < BENCH_NFC_MF_UL_PAGES; page += BENCH_NFC_MF_UL_FAST_READ_PAGES) {
+        uint8_t end = MIN(page + BENCH_NFC_MF_UL_FAST_READ_PAGES, BENCH_NFC_MF_UL_PAGES) - 1;
+        const uint8_t fast_read[] = {MF_UL_FAST_READ_CMD, page, end};
+        bench_nfc_mf_ul_add(bench, fast_read, sizeof(fast_read));
+    }
+    const uint8_t write[] = {MF_UL_WRITE, 0x04, 0xDE, 0xAD, 0xBE, 0xEF};
+    const uint8_t read_written[] = {MF_UL_READ_CMD, 0x04};
+    bench_nfc_mf_ul_add(bench, write, sizeof(write));
+    bench_nfc_mf_ul_add(bench, read_written, sizeof(read_written));
+
+    for(size_t i = 0; i < bench->trace_size; i++) {
+        bench->trace_tx_bytes += bench_nfc_mf_ul_response(bench, &bench->trace[i]) / 8;
+    }
+    return bench;
+}
+
+/** Auth pages are hidden, READ rolls over, writes show up in next READ */
+static bool bench_nfc_mf_ul_check(BenchNfcMfUl* bench) {
+    const uint8_t* data = bench->device.data.data;
+    const uint8_t zero[4] = {0};
+    bool result = true;
+
+    BenchNfcCommand read_auth = {{MF_UL_READ_CMD, BENCH_NFC_MF_UL_PAGES - 3}, 2};
+    result &= bench_nfc_mf_ul_response(bench, &read_auth) == 16 * 8;
+    result &= memcmp(bench->tx, &data[(BENCH_NFC_MF_UL_PAGES - 3) * 4], 4) == 0;
+    result &= memcmp(&bench->tx[4], zero, 4) == 0;
+    result &= memcmp(&bench->tx[8], zero, 2) == 0;
+    result &= memcmp(&bench->tx[10], &data[(BENCH_NFC_MF_UL_PAGES - 1) * 4 + 2], 2) == 0;
+    result &= memcmp(&bench->tx[12], data, 4) == 0;
+
+    BenchNfcCommand read_last = {{MF_UL_READ_CMD, BENCH_NFC_MF_UL_PAGES - 1}, 2};
+    result &= bench_nfc_mf_ul_response(bench, &read_last) == 16 * 8;
+    result &= memcmp(bench->tx, zero, 2) == 0;
+    result &= memcmp(&bench->tx[2], &data[(BENCH_NFC_MF_UL_PAGES - 1) * 4 + 2], 2) == 0;
+    result &= memcmp(&bench->tx[4], data, 12) == 0;
+
+    BenchNfcCommand write = {{MF_UL_WRITE, 0x02, 0x01, 0x02, 0x03, 0x04}, 6};
+    result &= bench_nfc_mf_ul_response(bench, &write) == 4;
+    result &= bench_nfc_mf_ul_response(bench, &read_last) == 16 * 8;
+    result &= memcmp(&bench->tx[12], &write.data[2], 4) == 0;
+
+    return result;
+}
+
+static void bench_nfc_mf_ul_trace(void* context, uint32_t iterations) {
+    BenchNfcMfUl* bench = context;
+    uint32_t bits = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        for(size_t j = 0; j < bench->trace_size; j++) {
+            bits += bench_nfc_mf_ul_response(bench, &bench->trace[j]);
+        }
+    }
+    bench_sink(bits);
+}
+
+static void bench_nfc_mf_ul_read(void* context, uint32_t iterations) {
+    BenchNfcMfUl* bench = context;
+    BenchNfcCommand read = {{MF_UL_READ_CMD, 0}, 2};
+    uint32_t bits = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        // Last pages cover auth masking and roll-over
+        read.data[1] = BENCH_NFC_MF_UL_PAGES - 1 - (i & 0x07);
+        bits += bench_nfc_mf_ul_response(bench, &read);
+    }
+    bench_sink(bits);
+}
+
+void bench_nfc(BenchRunner* runner) {
+    BenchNfc* bench = malloc(sizeof(BenchNfc));
+    memset(bench, 0, sizeof(BenchNfc));
+    crypto1_init(&bench->crypto, 0xA0A1A2A3A4A5ULL);
+
+    bench_runner_run(
+        runner, "nfc/crypto1_auth_read", BENCH_NFC_FRAME_SIZE, bench_nfc_crypto1_auth, bench);
+    bench_runner_run(
+        runner,
+        "nfc/crypto1_keystream_1k",
+        BENCH_NFC_KEYSTREAM_SIZE,
+        bench_nfc_crypto1_keystream,
+        bench);
+    bench_runner_run(runner, "nfc/crc16_a_frame", BENCH_NFC_FRAME_SIZE, bench_nfc_crc16, bench);
+
+    free(bench);
+
+    BenchNfcMfUl* mf_ul = bench_nfc_mf_ul_alloc();
+    if(bench_nfc_mf_ul_check(mf_ul)) {
+        bench_runner_run(
+            runner,
+            "nfc/mf_ul_emulate_trace",
+            mf_ul->trace_tx_bytes,
+            bench_nfc_mf_ul_trace,
+            mf_ul);
+        bench_runner_run(runner, "nfc/mf_ul_emulate_read", 16, bench_nfc_mf_ul_read, mf_ul);
+    } else {
+        bench_runner_fail(runner, "nfc/mf_ul_emulate_trace", "response mismatch");
+    }
+    mf_ul_free_emulation(&mf_ul->device);
+    free(mf_ul);
+
+    bench_nfc_mf_classic(runner);
+    bench_nfc_dump(runner);
+}
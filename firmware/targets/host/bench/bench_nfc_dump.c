@@ -0,0 +1,450 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+#include <toolbox/stream/string_stream.h>
+#include <toolbox/stream/file_stream.h>
+#include <nfc/helpers/nfc_dump.h>
+
+#define BENCH_NFC_DUMP_DIR "/ext/bench"
+#define BENCH_NFC_DUMP_TEXT_FILE BENCH_NFC_DUMP_DIR "/dump" NFC_APP_EXTENSION
+#define BENCH_NFC_DUMP_FILE BENCH_NFC_DUMP_DIR "/dump" NFC_APP_DUMP_EXTENSION
+#define BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS 256
+#define BENCH_NFC_DUMP_MF_DF_APPS 8
+#define BENCH_NFC_DUMP_MF_DF_FILES 4
+#define BENCH_NFC_DUMP_MF_DF_FILE_SIZE 256
+
+typedef struct {
+    Storage* storage;
+    NfcDeviceData data;
+    NfcDeviceData loaded;
+    char keys[BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS][12];
+    NfcDumpSource source;
+    size_t text_size;
+    size_t dump_size;
+} BenchNfcDump;
+
+static void bench_nfc_dump_fill_common(NfcDeviceData* data, NfcProtocol protocol) {
+    const uint8_t uid[7] = {0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+    memcpy(data->nfc_data.uid, uid, sizeof(uid));
+    data->nfc_data.uid_len = sizeof(uid);
+    data->nfc_data.atqa[0] = 0x44;
+    data->nfc_data.sak = 0x18;
+    data->nfc_data.protocol = protocol;
+}
+
+static void bench_nfc_dump_fill_mf_classic(NfcDeviceData* data) {
+    memset(data, 0, sizeof(NfcDeviceData));
+    bench_nfc_dump_fill_common(data, NfcDeviceProtocolMifareClassic);
+    data->mf_classic_data.type = MfClassicType4k;
+    for(size_t i = 0; i < BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS; i++) {
+        for(size_t j = 0; j < 16; j++) {
+            data->mf_classic_data.block[i].value[j] = (i * 16 + j) * 7;
+        }
+    }
+}
+
+static void bench_nfc_dump_fill_mf_ul(NfcDeviceData* data) {
+    memset(data, 0, sizeof(NfcDeviceData));
+    bench_nfc_dump_fill_common(data, NfcDeviceProtocolMifareUl);
+    MifareUlData* mf_ul = &data->mf_ul_data;
+    mf_ul->type = MfUltralightTypeNTAG216;
+    mf_ul->version.storage_size = 0x13;
+    mf_ul->counter[2] = 0x123456;
+    memset(mf_ul->tearing, MF_UL_TEARING_FLAG_DEFAULT, sizeof(mf_ul->tearing));
+    memset(mf_ul->signature, 0x5A, sizeof(mf_ul->signature));
+    mf_ul->data_size = 231 * 4;
+    for(size_t i = 0; i < mf_ul->data_size; i++) {
+        mf_ul->data[i] = i * 13;
+    }
+}
+
+static void bench_nfc_dump_fill_emv(NfcDeviceData* data) {
+    memset(data, 0, sizeof(NfcDeviceData));
+    bench_nfc_dump_fill_common(data, NfcDeviceProtocolEMV);
+    NfcEmvData* emv = &data->emv_data;
+    snprintf(emv->name, sizeof(emv->name), "MASTERCARD");
+    const uint8_t aid[7] = {0xA0, 0x00, 0x00, 0x00, 0x04, 0x10, 0x10};
+    memcpy(emv->aid, aid, sizeof(aid));
+    emv->aid_len = sizeof(aid);
+    memset(emv->number, 0x42, 8);
+    emv->number_len = 8;
+    emv->exp_mon = 0x12;
+    emv->exp_year = 0x29;
+    emv->country_code = 643;
+}
+
+static MifareDesfireKeySettings* bench_nfc_dump_mf_df_key_settings(uint8_t keys) {
+    MifareDesfireKeySettings* ks = malloc(sizeof(MifareDesfireKeySettings));
+    memset(ks, 0, sizeof(MifareDesfireKeySettings));
+    ks->change_key_id = 0x0E;
+    ks->free_directory_list = true;
+    ks->master_key_changeable = true;
+    ks->max_keys = keys;
+    MifareDesfireKeyVersion** kv_head = &ks->key_version_head;
+    for(uint8_t i = 0; i < keys; i++) {
+        MifareDesfireKeyVersion* kv = malloc(sizeof(MifareDesfireKeyVersion));
+        memset(kv, 0, sizeof(MifareDesfireKeyVersion));
+        kv->id = i;
+        kv->version = i + 1;
+        *kv_head = kv;
+        kv_head = &kv->next;
+    }
+    return ks;
+}
+
+/** Transit card like image: apps with standard, backup, value and record files */
+static void bench_nfc_dump_fill_mf_df(NfcDeviceData* data) {
+    memset(data, 0, sizeof(NfcDeviceData));
+    bench_nfc_dump_fill_common(data, NfcDeviceProtocolMifareDesfire);
+    MifareDesfireData* mf_df = &data->mf_df_data;
+    mf_df->version.hw_vendor = 0x04;
+    mf_df->version.sw_storage = 0x18;
+    mf_df->free_memory = malloc(sizeof(MifareDesfireFreeMemory));
+    mf_df->free_memory->bytes = 1024;
+    mf_df->master_key_settings = bench_nfc_dump_mf_df_key_settings(1);
+
+    MifareDesfireApplication** app_head = &mf_df->app_head;
+    for(uint8_t i = 0; i < BENCH_NFC_DUMP_MF_DF_APPS; i++) {
+        MifareDesfireApplication* app = malloc(sizeof(MifareDesfireApplication));
+        memset(app, 0, sizeof(MifareDesfireApplication));
+        app->id[2] = i + 1;
+        app->key_settings = bench_nfc_dump_mf_df_key_settings(2);
+        MifareDesfireFile** file_head = &app->file_head;
+        for(uint8_t j = 0; j < BENCH_NFC_DUMP_MF_DF_FILES; j++) {
+            MifareDesfireFile* f = malloc(sizeof(MifareDesfireFile));
+            memset(f, 0, sizeof(MifareDesfireFile));
+            f->id = j;
+            f->type = j % (MifareDesfireFileTypeCyclicRecord + 1);
+            f->access_rights = 0x1230 | j;
+            size_t size = BENCH_NFC_DUMP_MF_DF_FILE_SIZE;
+            if(f->type == MifareDesfireFileTypeValue) {
+                f->settings.value.hi_limit = 1000;
+                f->settings.value.limited_credit_enabled = true;
+                size = 4;
+            } else if(f->type >= MifareDesfireFileTypeLinearRecord) {
+                f->settings.record.size = 32;
+                f->settings.record.max = 16;
+                f->settings.record.cur = size / 32;
+            } else {
+                f->settings.data.size = size;
+            }
+            f->contents = malloc(size);
+            for(size_t k = 0; k < size; k++) {
+                f->contents[k] = k ^ j ^ i;
+            }
+            *file_head = f;
+            file_head = &f->next;
+        }
+        *app_head = app;
+        app_head = &app->next;
+    }
+}
+
+static bool bench_nfc_dump_mf_df_key_settings_equal(
+    MifareDesfireKeySettings* a,
+    MifareDesfireKeySettings* b) {
+    if(!a || !b) return a == b;
+    if(a->change_key_id != b->change_key_id || a->max_keys != b->max_keys ||
+       a->config_changeable != b->config_changeable ||
+       a->free_create_delete != b->free_create_delete ||
+       a->free_directory_list != b->free_directory_list ||
+       a->master_key_changeable != b->master_key_changeable) {
+        return false;
+    }
+    MifareDesfireKeyVersion* kv_a = a->key_version_head;
+    MifareDesfireKeyVersion* kv_b = b->key_version_head;
+    for(; kv_a && kv_b; kv_a = kv_a->next, kv_b = kv_b->next) {
+        if(kv_a->id != kv_b->id || kv_a->version != kv_b->version) return false;
+    }
+    return kv_a == kv_b;
+}
+
+static bool bench_nfc_dump_mf_df_equal(MifareDesfireData* a, MifareDesfireData* b) {
+    if(memcmp(&a->version, &b->version, sizeof(a->version))) return false;
+    if(!a->free_memory != !b->free_memory) return false;
+    if(a->free_memory && a->free_memory->bytes != b->free_memory->bytes) return false;
+    if(!bench_nfc_dump_mf_df_key_settings_equal(a->master_key_settings, b->master_key_settings))
+        return false;
+
+    MifareDesfireApplication* app_a = a->app_head;
+    MifareDesfireApplication* app_b = b->app_head;
+    for(; app_a && app_b; app_a = app_a->next, app_b = app_b->next) {
+        if(memcmp(app_a->id, app_b->id, sizeof(app_a->id))) return false;
+        if(!bench_nfc_dump_mf_df_key_settings_equal(app_a->key_settings, app_b->key_settings))
+            return false;
+        MifareDesfireFile* f_a = app_a->file_head;
+        MifareDesfireFile* f_b = app_b->file_head;
+        for(; f_a && f_b; f_a = f_a->next, f_b = f_b->next) {
+            if(f_a->id != f_b->id || f_a->type != f_b->type || f_a->comm != f_b->comm ||
+               f_a->access_rights != f_b->access_rights ||
+               memcmp(&f_a->settings, &f_b->settings, sizeof(f_a->settings))) {
+                return false;
+            }
+            if(!f_a->contents != !f_b->contents) return false;
+            size_t size = BENCH_NFC_DUMP_MF_DF_FILE_SIZE;
+            if(f_a->type == MifareDesfireFileTypeValue) size = 4;
+            if(f_a->contents && memcmp(f_a->contents, f_b->contents, size)) return false;
+        }
+        if(f_a || f_b) return false;
+    }
+    return app_a == app_b;
+}
+
+/** Save and load through memory, then check that broken dumps are rejected */
+static bool bench_nfc_dump_round_trip(BenchNfcDump* bench, NfcDeviceSaveFormat format) {
+    NfcDeviceData* data = &bench->data;
+    NfcDeviceData* loaded = &bench->loaded;
+    NfcDeviceSaveFormat loaded_format = NfcDeviceSaveFormatUid;
+    Stream* stream = string_stream_alloc();
+    bool result = false;
+
+    do {
+        if(!nfc_dump_save(stream, format, data, &bench->source)) break;
+        stream_rewind(stream);
+        if(!nfc_dump_load(stream, &loaded_format, loaded, &bench->source)) break;
+        if(loaded_format != format) break;
+        if(memcmp(&data->nfc_data, &loaded->nfc_data, sizeof(data->nfc_data))) break;
+        if(format == NfcDeviceSaveFormatMifareDesfire) {
+            bool equal = bench_nfc_dump_mf_df_equal(&data->mf_df_data, &loaded->mf_df_data);
+            mf_df_clear(&loaded->mf_df_data);
+            if(!equal) break;
+        } else if(memcmp(data, loaded, sizeof(NfcDeviceData))) {
+            break;
+        }
+
+        // Dump of changed text file
+        NfcDumpSource changed = bench->source;
+        changed.mtime++;
+        stream_rewind(stream);
+        if(nfc_dump_load(stream, &loaded_format, loaded, &changed)) break;
+        // Damaged payload
+        size_t size = stream_size(stream);
+        stream_seek(stream, size / 2, StreamOffsetFromStart);
+        uint8_t byte = 0;
+        stream_read(stream, &byte, 1);
+        byte ^= 0x01;
+        stream_seek(stream, size / 2, StreamOffsetFromStart);
+        stream_write(stream, &byte, 1);
+        stream_rewind(stream);
+        if(nfc_dump_load(stream, &loaded_format, loaded, &bench->source)) break;
+        // Nothing is left in data after failed load
+        NfcDeviceData empty = {};
+        if(memcmp(loaded, &empty, sizeof(NfcDeviceData))) break;
+        result = true;
+    } while(false);
+
+    stream_free(stream);
+    return result;
+}
+
+/** Mifare Classic part of text format, as NFC app saves and loads it */
+static bool bench_nfc_dump_text_save(BenchNfcDump* bench, FlipperFormat* file) {
+    MfClassicData* data = &bench->data.mf_classic_data;
+    NfcDeviceCommonData* common = &bench->data.nfc_data;
+    bool saved = false;
+
+    do {
+        if(!flipper_format_write_header_cstr(file, "Flipper NFC device", 2)) break;
+        if(!flipper_format_write_string_cstr(file, "Device type", "Mifare Classic")) break;
+        if(!flipper_format_write_hex(file, "UID", common->uid, common->uid_len)) break;
+        if(!flipper_format_write_hex(file, "ATQA", common->atqa, 2)) break;
+        if(!flipper_format_write_hex(file, "SAK", &common->sak, 1)) break;
+        if(!flipper_format_write_string_cstr(file, "Mifare Classic type", "4K")) break;
+        size_t i = 0;
+        for(; i < BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS; i++) {
+            if(!flipper_format_write_hex(file, bench->keys[i], data->block[i].value, 16)) break;
+        }
+        saved = (i == BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS);
+    } while(false);
+
+    return saved;
+}
+
+static bool bench_nfc_dump_text_load(BenchNfcDump* bench, FlipperFormat* file) {
+    MfClassicData* data = &bench->loaded.mf_classic_data;
+    NfcDeviceCommonData* common = &bench->loaded.nfc_data;
+    string_t value;
+    string_init(value);
+    uint32_t version = 0;
+    uint32_t count = 0;
+    bool loaded = false;
+
+    do {
+        if(!flipper_format_read_header(file, value, &version)) break;
+        if(!flipper_format_read_string(file, "Device type", value)) break;
+        common->protocol = NfcDeviceProtocolMifareClassic;
+        if(!flipper_format_get_value_count(file, "UID", &count)) break;
+        common->uid_len = count;
+        if(!flipper_format_read_hex(file, "UID", common->uid, common->uid_len)) break;
+        if(!flipper_format_read_hex(file, "ATQA", common->atqa, 2)) break;
+        if(!flipper_format_read_hex(file, "SAK", &common->sak, 1)) break;
+        if(!flipper_format_read_string(file, "Mifare Classic type", value)) break;
+        data->type = MfClassicType4k;
+        size_t i = 0;
+        for(; i < BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS; i++) {
+            if(!flipper_format_read_hex(file, bench->keys[i], data->block[i].value, 16)) break;
+        }
+        loaded = (i == BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS);
+    } while(false);
+
+    string_clear(value);
+    return loaded;
+}
+
+static NfcDumpSource bench_nfc_dump_file_source(Storage* storage, const char* path) {
+    FileInfo info = {};
+    storage_common_stat(storage, path, &info);
+    NfcDumpSource source = {.size = info.size, .mtime = info.mtime};
+    return source;
+}
+
+/** Includes open and close, as NFC app loads a dump */
+static void bench_nfc_dump_text_load_file(void* context, uint32_t iterations) {
+    BenchNfcDump* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        FlipperFormat* file = flipper_format_file_alloc(bench->storage);
+        flipper_format_set_index_mode(file, true);
+        furi_check(flipper_format_file_open_existing(file, BENCH_NFC_DUMP_TEXT_FILE));
+        furi_check(bench_nfc_dump_text_load(bench, file));
+        flipper_format_free(file);
+    }
+    bench_sink(bench->loaded.mf_classic_data.block[0].value[0]);
+}
+
+static void bench_nfc_dump_load_file(void* context, uint32_t iterations) {
+    BenchNfcDump* bench = context;
+    NfcDeviceSaveFormat format;
+    for(uint32_t i = 0; i < iterations; i++) {
+        Stream* stream = file_stream_alloc(bench->storage);
+        furi_check(file_stream_open(stream, BENCH_NFC_DUMP_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+        furi_check(nfc_dump_load(stream, &format, &bench->loaded, NULL));
+        stream_free(stream);
+        if(format == NfcDeviceSaveFormatMifareDesfire) {
+            mf_df_clear(&bench->loaded.mf_df_data);
+        }
+    }
+    bench_sink(bench->loaded.nfc_data.uid[0]);
+}
+
+/** As NFC app loads a file with dump: text file stat, then dump */
+static void bench_nfc_dump_load_file_checked(void* context, uint32_t iterations) {
+    BenchNfcDump* bench = context;
+    NfcDeviceSaveFormat format;
+    for(uint32_t i = 0; i < iterations; i++) {
+        NfcDumpSource source =
+            bench_nfc_dump_file_source(bench->storage, BENCH_NFC_DUMP_TEXT_FILE);
+        Stream* stream = file_stream_alloc(bench->storage);
+        furi_check(file_stream_open(stream, BENCH_NFC_DUMP_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+        furi_check(nfc_dump_load(stream, &format, &bench->loaded, &source));
+        stream_free(stream);
+    }
+    bench_sink(bench->loaded.mf_classic_data.block[0].value[0]);
+}
+
+static bool bench_nfc_dump_save_file(BenchNfcDump* bench, NfcDeviceSaveFormat format) {
+    Stream* stream = file_stream_alloc(bench->storage);
+    bool saved =
+        file_stream_open(stream, BENCH_NFC_DUMP_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+        nfc_dump_save(stream, format, &bench->data, &bench->source);
+    bench->dump_size = stream_size(stream);
+    stream_free(stream);
+    return saved;
+}
+
+static void bench_nfc_dump_mf_classic_files(BenchRunner* runner, BenchNfcDump* bench) {
+    FlipperFormat* file = flipper_format_file_alloc(bench->storage);
+    bool saved = flipper_format_file_open_always(file, BENCH_NFC_DUMP_TEXT_FILE) &&
+                 bench_nfc_dump_text_save(bench, file);
+    flipper_format_free(file);
+    if(saved) {
+        bench->source = bench_nfc_dump_file_source(bench->storage, BENCH_NFC_DUMP_TEXT_FILE);
+        saved = bench_nfc_dump_save_file(bench, NfcDeviceSaveFormatMifareClassic);
+    }
+
+    // Both formats must give the same data
+    memset(&bench->loaded, 0, sizeof(NfcDeviceData));
+    file = flipper_format_file_alloc(bench->storage);
+    flipper_format_set_index_mode(file, true);
+    bool equal = saved && flipper_format_file_open_existing(file, BENCH_NFC_DUMP_TEXT_FILE) &&
+                 bench_nfc_dump_text_load(bench, file) &&
+                 !memcmp(&bench->data, &bench->loaded, sizeof(NfcDeviceData));
+    flipper_format_free(file);
+
+    if(equal) {
+        File* text = storage_file_alloc(bench->storage);
+        storage_file_open(text, BENCH_NFC_DUMP_TEXT_FILE, FSAM_READ, FSOM_OPEN_EXISTING);
+        bench->text_size = storage_file_size(text);
+        storage_file_close(text);
+        storage_file_free(text);
+
+        bench_runner_run(
+            runner,
+            "nfc_dump/mf_classic_4k_text_load",
+            bench->text_size,
+            bench_nfc_dump_text_load_file,
+            bench);
+        bench_runner_run(
+            runner,
+            "nfc_dump/mf_classic_4k_load",
+            bench->dump_size,
+            bench_nfc_dump_load_file,
+            bench);
+        bench_runner_run(
+            runner,
+            "nfc_dump/mf_classic_4k_load_checked",
+            bench->dump_size,
+            bench_nfc_dump_load_file_checked,
+            bench);
+    } else {
+        bench_runner_fail(runner, "nfc_dump/mf_classic_4k_load", "text and dump mismatch");
+    }
+
+    storage_simply_remove(bench->storage, BENCH_NFC_DUMP_TEXT_FILE);
+    storage_simply_remove(bench->storage, BENCH_NFC_DUMP_FILE);
+}
+
+void bench_nfc_dump(BenchRunner* runner) {
+    BenchNfcDump* bench = malloc(sizeof(BenchNfcDump));
+    bench->storage = furi_record_open("storage");
+    bench->source.size = 0x1234;
+    bench->source.mtime = 0x12345678;
+    for(size_t i = 0; i < BENCH_NFC_DUMP_MF_CLASSIC_BLOCKS; i++) {
+        snprintf(bench->keys[i], sizeof(bench->keys[i]), "Block %u", (unsigned)i);
+    }
+
+    bool round_trip = true;
+    bench_nfc_dump_fill_mf_ul(&bench->data);
+    round_trip &= bench_nfc_dump_round_trip(bench, NfcDeviceSaveFormatMifareUl);
+    bench_nfc_dump_fill_emv(&bench->data);
+    round_trip &= bench_nfc_dump_round_trip(bench, NfcDeviceSaveFormatBankCard);
+    bench_nfc_dump_fill_mf_df(&bench->data);
+    round_trip &= bench_nfc_dump_round_trip(bench, NfcDeviceSaveFormatMifareDesfire);
+    mf_df_clear(&bench->data.mf_df_data);
+    bench_nfc_dump_fill_mf_classic(&bench->data);
+    round_trip &= bench_nfc_dump_round_trip(bench, NfcDeviceSaveFormatMifareClassic);
+
+    if(!round_trip) {
+        bench_runner_fail(runner, "nfc_dump/mf_classic_4k_load", "round trip mismatch");
+    } else if(bench_runner_enabled(runner, "nfc_dump/mf_classic_4k")) {
+        storage_simply_mkdir(bench->storage, BENCH_NFC_DUMP_DIR);
+        bench_nfc_dump_mf_classic_files(runner, bench);
+    }
+
+    if(round_trip && bench_runner_enabled(runner, "nfc_dump/mf_df_load")) {
+        bench_nfc_dump_fill_mf_df(&bench->data);
+        storage_simply_mkdir(bench->storage, BENCH_NFC_DUMP_DIR);
+        if(bench_nfc_dump_save_file(bench, NfcDeviceSaveFormatMifareDesfire)) {
+            bench_runner_run(
+                runner, "nfc_dump/mf_df_load", bench->dump_size, bench_nfc_dump_load_file, bench);
+        } else {
+            bench_runner_fail(runner, "nfc_dump/mf_df_load", "dump is not saved");
+        }
+        mf_df_clear(&bench->data.mf_df_data);
+        storage_simply_remove(bench->storage, BENCH_NFC_DUMP_FILE);
+    }
+
+    furi_record_close("storage");
+    free(bench);
+}
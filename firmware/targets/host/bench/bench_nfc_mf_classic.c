@@ -0,0 +1,351 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <furi_hal_nfc.h>
+#include <nfc_protocols/crypto1.h>
+#include <nfc_protocols/nfca.h>
+#include <nfc_protocols/nfc_util.h>
+#include <nfc_protocols/mifare_classic.h>
+
+#define TAG "BenchNfcMfClassic"
+
+#define BENCH_MF_CLASSIC_CUID 0x04A1B2C3
+#define BENCH_MF_CLASSIC_KEY_A 0xA0A1A2A3A4A5ULL
+#define BENCH_MF_CLASSIC_KEY_B 0xB0B1B2B3B4B5ULL
+#define BENCH_MF_CLASSIC_NO_FAULT 0xFFFF
+#define BENCH_MF_CLASSIC_CMD_SIZE 4
+#define BENCH_MF_CLASSIC_READ_RESPONSE_SIZE (MF_CLASSIC_BLOCK_SIZE + 2)
+
+typedef enum {
+    BenchMfClassicStateIdle,
+    BenchMfClassicStateSelected,
+    BenchMfClassicStateAuth,
+    BenchMfClassicStateAuthenticated,
+} BenchMfClassicState;
+
+/** MIFARE Classic 4K as reader sees it through furi_hal_nfc */
+typedef struct {
+    MfClassicData data;
+    uint64_t key_a[MF_CLASSIC_4K_TOTAL_SECTORS_NUM];
+    uint64_t key_b[MF_CLASSIC_4K_TOTAL_SECTORS_NUM];
+
+    BenchMfClassicState state;
+    Crypto1 crypto;
+    uint32_t nt;
+    uint8_t sector;
+
+    /** Response to READ of this block is corrupted once */
+    uint16_t corrupt_block;
+    /** Card doesn't answer READ of this block once and drops session */
+    uint16_t drop_block;
+
+    uint32_t activations;
+    uint16_t reads[MF_CLASSIC_TOTAL_BLOCKS_MAX];
+} BenchMfClassicCard;
+
+static uint8_t bench_mf_classic_sector(uint8_t block) {
+    return block < 128 ? block / 4 : 32 + (block - 128) / 16;
+}
+
+static bool bench_mf_classic_is_trailer(uint8_t block) {
+    return block < 128 ? (block % 4) == 3 : (block % 16) == 15;
+}
+
+static bool bench_mf_classic_activate(void* context, uint32_t* cuid) {
+    BenchMfClassicCard* card = context;
+    card->activations++;
+    card->state = BenchMfClassicStateSelected;
+    *cuid = BENCH_MF_CLASSIC_CUID;
+    return true;
+}
+
+static void bench_mf_classic_deactivate(void* context) {
+    BenchMfClassicCard* card = context;
+    card->state = BenchMfClassicStateIdle;
+}
+
+/** Decrypt reader frame in place, false on parity error */
+static bool bench_mf_classic_decrypt(BenchMfClassicCard* card, FuriHalNfcTxRxContext* tx_rx) {
+    uint8_t size = tx_rx->tx_bits / 8;
+    bool parity_ok = true;
+    for(uint8_t i = 0; i < size; i++) {
+        tx_rx->tx_data[i] ^= crypto1_byte(&card->crypto, 0x00, 0);
+        uint8_t parity = crypto1_filter(card->crypto.odd) ^
+                         nfc_util_odd_parity8(tx_rx->tx_data[i]);
+        parity_ok &= (parity & 0x01) == FURI_BIT(tx_rx->tx_parity[i / 8], 7 - i % 8);
+    }
+    return parity_ok;
+}
+
+static void bench_mf_classic_encrypt(
+    BenchMfClassicCard* card,
+    FuriHalNfcTxRxContext* tx_rx,
+    const uint8_t* plain,
+    uint8_t size) {
+    memset(tx_rx->rx_parity, 0, sizeof(tx_rx->rx_parity));
+    for(uint8_t i = 0; i < size; i++) {
+        tx_rx->rx_data[i] = crypto1_byte(&card->crypto, 0x00, 0) ^ plain[i];
+        tx_rx->rx_parity[i / 8] |=
+            ((crypto1_filter(card->crypto.odd) ^ nfc_util_odd_parity8(plain[i])) & 0x01)
+            << (7 - i % 8);
+    }
+    tx_rx->rx_bits = size * 8;
+}
+
+/** AUTH command: pick nonce and load key, nonce goes encrypted in nested auth */
+static bool bench_mf_classic_auth(BenchMfClassicCard* card, FuriHalNfcTxRxContext* tx_rx) {
+    uint8_t cmd = tx_rx->tx_data[0];
+    uint8_t block = tx_rx->tx_data[1];
+    if(cmd != 0x60 && cmd != 0x61) return false;
+
+    bool nested = card->state == BenchMfClassicStateAuthenticated;
+    card->sector = bench_mf_classic_sector(block);
+    card->nt = prng_successor(card->nt, 16);
+    crypto1_init(
+        &card->crypto, cmd == 0x60 ? card->key_a[card->sector] : card->key_b[card->sector]);
+    uint32_t ks = crypto1_word(&card->crypto, card->nt ^ BENCH_MF_CLASSIC_CUID, 0);
+    nfc_util_num2bytes(nested ? card->nt ^ ks : card->nt, 4, tx_rx->rx_data);
+    memset(tx_rx->rx_parity, 0, sizeof(tx_rx->rx_parity));
+    tx_rx->rx_bits = 4 * 8;
+    card->state = BenchMfClassicStateAuth;
+    return true;
+}
+
+/** Reader answer: encrypted nr and ar, card answers with encrypted at */
+static bool bench_mf_classic_auth_answer(BenchMfClassicCard* card, FuriHalNfcTxRxContext* tx_rx) {
+    if(tx_rx->tx_rx_type != FURI_HAL_NFC_TXRX_RAW || tx_rx->tx_bits != 8 * 8) return false;
+
+    bool valid = true;
+    for(uint8_t i = 0; i < 4; i++) {
+        uint8_t nr = crypto1_byte(&card->crypto, tx_rx->tx_data[i], 1) ^ tx_rx->tx_data[i];
+        uint8_t parity = crypto1_filter(card->crypto.odd) ^ nfc_util_odd_parity8(nr);
+        valid &= (parity & 0x01) == FURI_BIT(tx_rx->tx_parity[0], 7 - i);
+    }
+    uint32_t nt = prng_successor(card->nt, 32);
+    for(uint8_t i = 4; i < 8; i++) {
+        nt = prng_successor(nt, 8);
+        uint8_t ar = crypto1_byte(&card->crypto, 0x00, 0) ^ tx_rx->tx_data[i];
+        uint8_t parity = crypto1_filter(card->crypto.odd) ^ nfc_util_odd_parity8(ar);
+        valid &= ar == (nt & 0xFF);
+        valid &= (parity & 0x01) == FURI_BIT(tx_rx->tx_parity[0], 7 - i);
+    }
+    if(!valid) return false;
+
+    uint8_t at[4];
+    for(uint8_t i = 0; i < 4; i++) {
+        nt = prng_successor(nt, 8);
+        at[i] = nt & 0xFF;
+    }
+    bench_mf_classic_encrypt(card, tx_rx, at, sizeof(at));
+    card->state = BenchMfClassicStateAuthenticated;
+    return true;
+}
+
+static bool bench_mf_classic_read(BenchMfClassicCard* card, FuriHalNfcTxRxContext* tx_rx) {
+    uint8_t block = tx_rx->tx_data[1];
+    if(bench_mf_classic_sector(block) != card->sector) {
+        // NAK, 4 bits can't be split into data and parity
+        tx_rx->rx_bits = 0;
+        card->state = BenchMfClassicStateIdle;
+        return true;
+    }
+    card->reads[block]++;
+    if(block == card->drop_block) {
+        card->drop_block = BENCH_MF_CLASSIC_NO_FAULT;
+        card->state = BenchMfClassicStateIdle;
+        return false;
+    }
+
+    uint8_t plain[BENCH_MF_CLASSIC_READ_RESPONSE_SIZE];
+    memcpy(plain, card->data.block[block].value, MF_CLASSIC_BLOCK_SIZE);
+    if(bench_mf_classic_is_trailer(block)) {
+        // Key A is never readable
+        memset(plain, 0, 6);
+    }
+    nfca_append_crc16(plain, MF_CLASSIC_BLOCK_SIZE);
+    bench_mf_classic_encrypt(card, tx_rx, plain, sizeof(plain));
+    if(block == card->corrupt_block) {
+        card->corrupt_block = BENCH_MF_CLASSIC_NO_FAULT;
+        tx_rx->rx_data[3] ^= 0x10;
+    }
+    return true;
+}
+
+static bool bench_mf_classic_tx_rx(void* context, FuriHalNfcTxRxContext* tx_rx) {
+    BenchMfClassicCard* card = context;
+    bool answer = false;
+
+    if(card->state == BenchMfClassicStateSelected) {
+        answer = (tx_rx->tx_bits == 2 * 8) && bench_mf_classic_auth(card, tx_rx);
+    } else if(card->state == BenchMfClassicStateAuth) {
+        answer = bench_mf_classic_auth_answer(card, tx_rx);
+    } else if(card->state == BenchMfClassicStateAuthenticated) {
+        if(tx_rx->tx_rx_type == FURI_HAL_NFC_TXRX_RAW &&
+           tx_rx->tx_bits == BENCH_MF_CLASSIC_CMD_SIZE * 8 &&
+           bench_mf_classic_decrypt(card, tx_rx) &&
+           nfca_get_crc16(tx_rx->tx_data, BENCH_MF_CLASSIC_CMD_SIZE) == 0) {
+            if(tx_rx->tx_data[0] == 0x30) {
+                answer = bench_mf_classic_read(card, tx_rx);
+            } else {
+                answer = bench_mf_classic_auth(card, tx_rx);
+            }
+        }
+    }
+
+    if(!answer) {
+        card->state = BenchMfClassicStateIdle;
+    }
+    return answer;
+}
+
+static const FuriHalNfcCard bench_mf_classic_card = {
+    .activate = bench_mf_classic_activate,
+    .deactivate = bench_mf_classic_deactivate,
+    .tx_rx = bench_mf_classic_tx_rx,
+};
+
+static BenchMfClassicCard* bench_mf_classic_card_alloc() {
+    BenchMfClassicCard* card = malloc(sizeof(BenchMfClassicCard));
+    memset(card, 0, sizeof(BenchMfClassicCard));
+    card->data.type = MfClassicType4k;
+    card->nt = 0x01200145;
+    card->corrupt_block = BENCH_MF_CLASSIC_NO_FAULT;
+    card->drop_block = BENCH_MF_CLASSIC_NO_FAULT;
+
+    for(size_t i = 0; i < MF_CLASSIC_TOTAL_BLOCKS_MAX; i++) {
+        for(size_t j = 0; j < MF_CLASSIC_BLOCK_SIZE; j++) {
+            card->data.block[i].value[j] = i * 13 + j * 7 + 1;
+        }
+    }
+    const uint8_t access_bits[4] = {0xFF, 0x07, 0x80, 0x69};
+    for(uint8_t sector = 0; sector < MF_CLASSIC_4K_TOTAL_SECTORS_NUM; sector++) {
+        card->key_a[sector] = BENCH_MF_CLASSIC_KEY_A + sector;
+        card->key_b[sector] = BENCH_MF_CLASSIC_KEY_B + sector;
+    }
+    for(size_t i = 0; i < MF_CLASSIC_TOTAL_BLOCKS_MAX; i++) {
+        if(!bench_mf_classic_is_trailer(i)) continue;
+        uint8_t sector = bench_mf_classic_sector(i);
+        MfClassicSectorTrailer* trailer = (MfClassicSectorTrailer*)card->data.block[i].value;
+        nfc_util_num2bytes(card->key_a[sector], 6, trailer->key_a);
+        memcpy(trailer->access_bits, access_bits, sizeof(access_bits));
+        nfc_util_num2bytes(card->key_b[sector], 6, trailer->key_b);
+    }
+
+    furi_hal_nfc_set_card(&bench_mf_classic_card, card);
+    return card;
+}
+
+static void bench_mf_classic_card_free(BenchMfClassicCard* card) {
+    furi_hal_nfc_set_card(NULL, NULL);
+    free(card);
+}
+
+typedef struct {
+    BenchMfClassicCard* card;
+    FuriHalNfcTxRxContext tx_rx;
+    MfClassicReader reader;
+    MfClassicData data;
+} BenchMfClassic;
+
+static void bench_mf_classic_reader_init(BenchMfClassic* bench) {
+    const uint8_t uid[4] = {0x04, 0xA1, 0xB2, 0xC3};
+    mf_classic_get_type((uint8_t*)uid, sizeof(uid), 0x02, 0x00, 0x18, &bench->reader);
+    for(uint8_t sector = 0; sector < MF_CLASSIC_4K_TOTAL_SECTORS_NUM; sector++) {
+        mf_classic_reader_add_sector(
+            &bench->reader, sector, bench->card->key_a[sector], bench->card->key_b[sector]);
+    }
+}
+
+static bool bench_mf_classic_read_card(BenchMfClassic* bench) {
+    memset(&bench->data, 0, sizeof(MfClassicData));
+    bench->card->state = BenchMfClassicStateIdle;
+    uint8_t sectors = mf_classic_read_card(&bench->tx_rx, &bench->reader, &bench->data);
+    return sectors == MF_CLASSIC_4K_TOTAL_SECTORS_NUM &&
+           memcmp(&bench->data, &bench->card->data, sizeof(MfClassicData)) == 0;
+}
+
+/** Whole card is read in one selection, faults cost one selection and only failed blocks */
+static bool bench_mf_classic_check(BenchMfClassic* bench) {
+    BenchMfClassicCard* card = bench->card;
+    bool result = true;
+
+    card->activations = 0;
+    memset(card->reads, 0, sizeof(card->reads));
+    result &= bench_mf_classic_read_card(bench);
+    result &= card->activations == 1;
+    result &= bench->reader.selections == 1;
+    FURI_LOG_I(
+        TAG,
+        "4K card read: %lu selections, %d with selection per sector",
+        card->activations,
+        MF_CLASSIC_4K_TOTAL_SECTORS_NUM);
+
+    card->activations = 0;
+    memset(card->reads, 0, sizeof(card->reads));
+    card->corrupt_block = 5;
+    card->drop_block = 130;
+    result &= bench_mf_classic_read_card(bench);
+    result &= card->activations == 2;
+    for(size_t i = 0; i < MF_CLASSIC_TOTAL_BLOCKS_MAX; i++) {
+        result &= card->reads[i] == ((i == 5 || i == 130) ? 2 : 1);
+    }
+    result &= bench->reader.sector_reader[1].selections == 0;
+    result &= bench->reader.sector_reader[32].selections == 1;
+    result &= bench->reader.sector_reader[32].blocks_read == 0xFFFF;
+
+    // Keys search: card is selected again only after wrong key
+    const uint64_t dict[] = {0xFFFFFFFFFFFFULL, BENCH_MF_CLASSIC_KEY_A, BENCH_MF_CLASSIC_KEY_B};
+    MfClassicAuthContext auth_ctx = {};
+    card->activations = 0;
+    card->state = BenchMfClassicStateIdle;
+    for(uint8_t sector = 0; sector < 2; sector++) {
+        mf_classic_auth_init_context(&auth_ctx, BENCH_MF_CLASSIC_CUID, sector);
+        for(size_t i = 0; i < COUNT_OF(dict); i++) {
+            if(!auth_ctx.authenticated) {
+                furi_hal_nfc_deactivate();
+                furi_hal_nfc_activate_nfca(300, &auth_ctx.cuid);
+            }
+            mf_classic_auth_attempt(&bench->tx_rx, &auth_ctx, dict[i] + sector);
+        }
+        result &= auth_ctx.key_a == card->key_a[sector];
+        result &= auth_ctx.key_b == card->key_b[sector];
+    }
+    // First selection, then one after each wrong key: 3 in every sector
+    result &= card->activations == 7;
+
+    return result;
+}
+
+static void bench_mf_classic_read_4k(void* context, uint32_t iterations) {
+    BenchMfClassic* bench = context;
+    uint32_t selections = 0;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench->card->state = BenchMfClassicStateIdle;
+        mf_classic_read_card(&bench->tx_rx, &bench->reader, &bench->data);
+        selections += bench->reader.selections;
+    }
+    bench_sink(selections);
+}
+
+void bench_nfc_mf_classic(BenchRunner* runner) {
+    if(!bench_runner_enabled(runner, "nfc/mf_classic_read_4k")) return;
+
+    BenchMfClassic* bench = malloc(sizeof(BenchMfClassic));
+    memset(bench, 0, sizeof(BenchMfClassic));
+    bench->card = bench_mf_classic_card_alloc();
+    bench_mf_classic_reader_init(bench);
+
+    if(bench_mf_classic_check(bench)) {
+        bench_runner_run(
+            runner,
+            "nfc/mf_classic_read_4k",
+            sizeof(MfClassicBlock) * MF_CLASSIC_TOTAL_BLOCKS_MAX,
+            bench_mf_classic_read_4k,
+            bench);
+    } else {
+        bench_runner_fail(runner, "nfc/mf_classic_read_4k", "read mismatch");
+    }
+
+    bench_mf_classic_card_free(bench->card);
+    free(bench);
+}
@@ -0,0 +1,437 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <furi_hal_i2c.h>
+#include <bq27220.h>
+#include <bq27220_reg.h>
+#include <bq25896.h>
+#include <bq25896_reg.h>
+#include <power/power_service/power_poll.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#define TAG "BenchPower"
+
+#define BENCH_POWER_GAUGE_REGS 0x80
+#define BENCH_POWER_CHARGER_REGS 0x15
+#define BENCH_POWER_CHARGER_FAULT_REG 0x0C
+
+#define BENCH_POWER_CAPACITY_MAH 2100
+/** One hour of device life, see bench_power_phase */
+#define BENCH_POWER_SIM_SECONDS 3600
+#define BENCH_POWER_USB_PLUG_S 2103
+#define BENCH_POWER_USB_UNPLUG_S 3000
+#define BENCH_POWER_OTG_ON_S 1800
+#define BENCH_POWER_OTG_OFF_S 1920
+
+#define BENCH_POWER_METRICS_SIZE 256
+
+typedef struct {
+    uint8_t regs[BENCH_POWER_GAUGE_REGS];
+} BenchPowerGauge;
+
+typedef struct {
+    uint8_t regs[BENCH_POWER_CHARGER_REGS];
+} BenchPowerCharger;
+
+typedef struct {
+    float charge; /**< % */
+    float current; /**< A, positive goes into battery */
+    bool usb;
+} BenchPowerBattery;
+
+typedef struct {
+    BenchPowerGauge gauge;
+    BenchPowerCharger charger;
+    BenchPowerBattery battery;
+} BenchPower;
+
+typedef struct {
+    PowerInfo info;
+    bool is_charging;
+    bool is_otg_enabled;
+} BenchPowerReadout;
+
+typedef struct {
+    uint32_t wakeups;
+    FuriHalI2cStats stats;
+    uint32_t usb_plug_latency_ms;
+    uint32_t usb_unplug_latency_ms;
+    uint32_t level_lag_max_ms;
+    bool decode_mismatch;
+} BenchPowerResult;
+
+typedef enum {
+    BenchPowerPolicyLegacy,
+    BenchPowerPolicyAdaptive,
+} BenchPowerPolicy;
+
+/* Fuel gauge: standard commands are little endian words, incremental read */
+
+static bool bench_power_gauge_read(void* context, uint8_t reg, uint8_t* data, size_t size) {
+    BenchPowerGauge* gauge = context;
+    if(reg + size > BENCH_POWER_GAUGE_REGS) return false;
+    memcpy(data, &gauge->regs[reg], size);
+    return true;
+}
+
+static bool bench_power_gauge_write(void* context, uint8_t reg, const uint8_t* data, size_t size) {
+    // Control and data memory writes are accepted, profile update is not simulated
+    (void)context;
+    (void)data;
+    return reg + size <= BENCH_POWER_GAUGE_REGS;
+}
+
+static const FuriHalI2cDevice bench_power_gauge_device = {
+    .read = bench_power_gauge_read,
+    .write = bench_power_gauge_write,
+};
+
+static void bench_power_gauge_set(BenchPowerGauge* gauge, uint8_t command, uint16_t value) {
+    gauge->regs[command] = value & 0xFF;
+    gauge->regs[command + 1] = value >> 8;
+}
+
+/* Charger: byte registers, fault register is latched and cleared by read */
+
+static bool bench_power_charger_read(void* context, uint8_t reg, uint8_t* data, size_t size) {
+    BenchPowerCharger* charger = context;
+    if(reg + size > BENCH_POWER_CHARGER_REGS) return false;
+    memcpy(data, &charger->regs[reg], size);
+    if(reg <= BENCH_POWER_CHARGER_FAULT_REG && reg + size > BENCH_POWER_CHARGER_FAULT_REG) {
+        charger->regs[BENCH_POWER_CHARGER_FAULT_REG] = 0;
+    }
+    return true;
+}
+
+static bool
+    bench_power_charger_write(void* context, uint8_t reg, const uint8_t* data, size_t size) {
+    BenchPowerCharger* charger = context;
+    if(reg + size > BENCH_POWER_CHARGER_REGS) return false;
+    memcpy(&charger->regs[reg], data, size);
+    return true;
+}
+
+static const FuriHalI2cDevice bench_power_charger_device = {
+    .read = bench_power_charger_read,
+    .write = bench_power_charger_write,
+};
+
+/** Put battery state into registers, as both ICs would measure it */
+static void bench_power_apply(BenchPower* bench) {
+    BenchPowerBattery* battery = &bench->battery;
+    uint16_t charge = battery->charge;
+    uint16_t voltage = 3300 + battery->charge * 9 + battery->current * 100;
+    int16_t current = battery->current * 1000;
+
+    BenchPowerGauge* gauge = &bench->gauge;
+    BatteryStatus status = {.DSG = current < 0, .BATTPRES = true, .FC = charge >= 100};
+    uint16_t status_word = 0;
+    memcpy(&status_word, &status, sizeof(BatteryStatus));
+    bench_power_gauge_set(gauge, CommandTemperature, 2981);
+    bench_power_gauge_set(gauge, CommandVoltage, voltage);
+    bench_power_gauge_set(gauge, CommandBatteryStatus, status_word);
+    bench_power_gauge_set(gauge, CommandCurrent, current);
+    bench_power_gauge_set(
+        gauge, CommandRemainingCapacity, battery->charge * BENCH_POWER_CAPACITY_MAH / 100);
+    bench_power_gauge_set(gauge, CommandFullChargeCapacity, BENCH_POWER_CAPACITY_MAH);
+    bench_power_gauge_set(gauge, CommandStateOfCharge, charge);
+    bench_power_gauge_set(gauge, CommandStateOfHealth, 100);
+
+    BenchPowerCharger* charger = &bench->charger;
+    REG0B r0b = {.RES = 1, .PG_STAT = battery->usb};
+    if(battery->usb) r0b.CHRG_STAT = charge < 100 ? ChrgStatFast : ChrgStatDone;
+    REG0E r0e = {.BATV = (voltage - 2304) / 20};
+    REG10 r10 = {.TSPCT = 60};
+    REG11 r11 = {.VBUS_GD = battery->usb, .VBUSV = battery->usb ? 24 : 0};
+    REG12 r12 = {.ICHGR = current > 0 ? current / 50 : 0};
+    memcpy(&charger->regs[0x0B], &r0b, 1);
+    memcpy(&charger->regs[0x0E], &r0e, 1);
+    memcpy(&charger->regs[0x10], &r10, 1);
+    memcpy(&charger->regs[0x11], &r11, 1);
+    memcpy(&charger->regs[0x12], &r12, 1);
+}
+
+static void bench_power_init(BenchPower* bench) {
+    memset(bench, 0, sizeof(BenchPower));
+    bench->battery.charge = 50.02f;
+    bench_power_apply(bench);
+
+    furi_hal_i2c_set_device(
+        &furi_hal_i2c_handle_power, BQ27220_ADDRESS, &bench_power_gauge_device, &bench->gauge);
+    furi_hal_i2c_set_device(
+        &furi_hal_i2c_handle_power, BQ25896_ADDRESS, &bench_power_charger_device, &bench->charger);
+    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
+    bq25896_init(&furi_hal_i2c_handle_power);
+    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+    furi_hal_i2c_reset_stats(&furi_hal_i2c_handle_power);
+}
+
+static void bench_power_deinit() {
+    furi_hal_i2c_set_device(&furi_hal_i2c_handle_power, BQ27220_ADDRESS, NULL, NULL);
+    furi_hal_i2c_set_device(&furi_hal_i2c_handle_power, BQ25896_ADDRESS, NULL, NULL);
+}
+
+/** Battery current of the scenario: idle, radio load, OTG, charging, idle */
+static float bench_power_phase(uint32_t second, bool* usb) {
+    *usb = second >= BENCH_POWER_USB_PLUG_S && second < BENCH_POWER_USB_UNPLUG_S;
+    if(*usb) {
+        return 1.0f;
+    } else if(second >= BENCH_POWER_OTG_ON_S && second < BENCH_POWER_OTG_OFF_S) {
+        return -0.3f;
+    } else if(second >= 900 && second < 1500) {
+        return -0.25f;
+    } else {
+        return -0.03f;
+    }
+}
+
+static void bench_power_step(BenchPower* bench, uint32_t second) {
+    BenchPowerBattery* battery = &bench->battery;
+    battery->current = bench_power_phase(second, &battery->usb);
+    battery->charge += battery->current * 1000 / 3600 / BENCH_POWER_CAPACITY_MAH * 100;
+    if(battery->charge > 100) battery->charge = 100;
+    bench_power_apply(bench);
+}
+
+/* Readouts: single value getters as power service used to do them, and burst */
+
+static void bench_power_read_registers(BenchPowerReadout* readout) {
+    FuriHalI2cBusHandle* handle = &furi_hal_i2c_handle_power;
+    PowerInfo* info = &readout->info;
+    // Each furi_hal_power getter takes the bus on its own
+    furi_hal_i2c_acquire(handle);
+    info->charge = bq27220_get_state_of_charge(handle);
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->health = bq27220_get_state_of_health(handle);
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->capacity_remaining = bq27220_get_remaining_capacity(handle);
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->capacity_full = bq27220_get_full_charge_capacity(handle);
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->current_charger = (float)bq25896_get_vbat_current(handle) / 1000.0f;
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->current_gauge = (float)bq27220_get_current(handle) / 1000.0f;
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->voltage_charger = (float)bq25896_get_vbat_voltage(handle) / 1000.0f;
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->voltage_gauge = (float)bq27220_get_voltage(handle) / 1000.0f;
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->voltage_vbus = (float)bq25896_get_vbus_voltage(handle) / 1000.0f;
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->temperature_charger = (71.0f - (float)bq25896_get_ntc_mpct(handle) / 1000) / 0.6f;
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    info->temperature_gauge = ((float)bq27220_get_temperature(handle) - 2731.0f) / 10.0f;
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    readout->is_charging = bq25896_is_charging(handle);
+    furi_hal_i2c_release(handle);
+    furi_hal_i2c_acquire(handle);
+    readout->is_otg_enabled = bq25896_is_otg_enabled(handle);
+    furi_hal_i2c_release(handle);
+}
+
+/** Same as furi_hal_power_read on device */
+static void bench_power_read_burst(BenchPowerReadout* readout) {
+    FuriHalI2cBusHandle* handle = &furi_hal_i2c_handle_power;
+    PowerInfo* info = &readout->info;
+    GaugeData gauge;
+    ChargerData charger;
+
+    furi_hal_i2c_acquire(handle);
+    bool ret = bq27220_get_data(handle, &gauge) && bq25896_get_data(handle, &charger);
+    furi_hal_i2c_release(handle);
+    furi_check(ret);
+
+    info->charge = gauge.state_of_charge;
+    info->health = gauge.state_of_health;
+    info->capacity_remaining = gauge.remaining_capacity;
+    info->capacity_full = gauge.full_charge_capacity;
+    info->current_charger = (float)charger.vbat_current / 1000.0f;
+    info->current_gauge = (float)gauge.current / 1000.0f;
+    info->voltage_charger = (float)charger.vbat_voltage / 1000.0f;
+    info->voltage_gauge = (float)gauge.voltage / 1000.0f;
+    info->voltage_vbus = (float)charger.vbus_voltage / 1000.0f;
+    info->temperature_charger = (71.0f - (float)charger.ntc_mpct / 1000) / 0.6f;
+    info->temperature_gauge = ((float)gauge.temperature - 2731.0f) / 10.0f;
+    readout->is_charging = charger.is_charging;
+    readout->is_otg_enabled = charger.is_otg_enabled;
+}
+
+static void bench_power_read_registers_callback(void* context, uint32_t iterations) {
+    (void)context;
+    BenchPowerReadout readout;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_power_read_registers(&readout);
+    }
+    bench_sink(readout.info.charge);
+}
+
+static void bench_power_read_burst_callback(void* context, uint32_t iterations) {
+    (void)context;
+    BenchPowerReadout readout;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_power_read_burst(&readout);
+    }
+    bench_sink(readout.info.charge);
+}
+
+static void bench_power_set_otg(bool enable) {
+    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
+    if(enable) {
+        bq25896_enable_otg(&furi_hal_i2c_handle_power);
+    } else {
+        bq25896_disable_otg(&furi_hal_i2c_handle_power);
+    }
+    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+}
+
+/**
+ * Run power service loop over the scenario with 1 second time step.
+ * Legacy: readout with single value getters and OTG check every second.
+ * Adaptive: burst readout when power_poll_next says so or HAL reports OTG switch.
+ */
+static void
+    bench_power_simulate(BenchPower* bench, BenchPowerPolicy policy, BenchPowerResult* result) {
+    bench_power_init(bench);
+    memset(result, 0, sizeof(BenchPowerResult));
+
+    PowerPoll poll;
+    power_poll_reset(&poll);
+    BenchPowerReadout readout;
+    PowerInfo* info = &readout.info;
+    uint32_t next_poll_ms = 0;
+    uint32_t level_change_ms = 0;
+    uint8_t level = bench->battery.charge;
+    uint8_t level_seen = level;
+    bool usb_seen = false;
+
+    for(uint32_t second = 0; second < BENCH_POWER_SIM_SECONDS; second++) {
+        uint32_t now_ms = second * 1000;
+        bench_power_step(bench, second);
+        if((uint8_t)bench->battery.charge != level) {
+            level = bench->battery.charge;
+            level_change_ms = now_ms;
+        }
+
+        // OTG is switched by other apps through HAL
+        bool hal_event = false;
+        if(second == BENCH_POWER_OTG_ON_S || second == BENCH_POWER_OTG_OFF_S) {
+            bench_power_set_otg(second == BENCH_POWER_OTG_ON_S);
+            hal_event = true;
+        }
+
+        bool is_poll = policy == BenchPowerPolicyLegacy || hal_event || now_ms >= next_poll_ms;
+        if(!is_poll) continue;
+        result->wakeups++;
+
+        if(policy == BenchPowerPolicyLegacy) {
+            bench_power_read_registers(&readout);
+            if(readout.is_otg_enabled) {
+                furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
+                bq25896_check_otg_fault(&furi_hal_i2c_handle_power);
+                furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+            }
+        } else {
+            bench_power_read_burst(&readout);
+        }
+
+        // Detection latencies
+        if(info->charge != level_seen) {
+            level_seen = info->charge;
+            uint32_t lag = now_ms - level_change_ms;
+            if(lag > result->level_lag_max_ms) result->level_lag_max_ms = lag;
+        }
+        bool usb = info->voltage_vbus > POWER_POLL_VBUS_PRESENT;
+        if(usb != usb_seen) {
+            usb_seen = usb;
+            if(usb) {
+                result->usb_plug_latency_ms = now_ms - BENCH_POWER_USB_PLUG_S * 1000;
+            } else {
+                result->usb_unplug_latency_ms = now_ms - BENCH_POWER_USB_UNPLUG_S * 1000;
+            }
+        }
+
+        bool active = readout.is_charging || readout.is_otg_enabled;
+        uint32_t interval = power_poll_next(&poll, info, active);
+        next_poll_ms = now_ms + interval;
+    }
+
+    furi_hal_i2c_get_stats(&furi_hal_i2c_handle_power, &result->stats);
+
+    // Both readouts of the final state must be the same
+    // Padding is compared as well
+    BenchPowerReadout registers;
+    memset(&registers, 0, sizeof(BenchPowerReadout));
+    memset(&readout, 0, sizeof(BenchPowerReadout));
+    bench_power_read_registers(&registers);
+    bench_power_read_burst(&readout);
+    result->decode_mismatch = memcmp(&readout, &registers, sizeof(BenchPowerReadout)) != 0;
+
+    bench_power_deinit();
+}
+
+static void bench_power_report(BenchRunner* runner, const char* name, BenchPowerResult* result) {
+    char metrics[BENCH_POWER_METRICS_SIZE];
+    snprintf(
+        metrics,
+        sizeof(metrics),
+        "\"seconds\":%u,\"wakeups\":%" PRIu32 ",\"bus_acquires\":%" PRIu32
+        ",\"transfers\":%" PRIu32 ",\"bytes\":%" PRIu32 ",\"bus_time_ms\":%.1f,"
+        "\"usb_plug_latency_ms\":%" PRIu32 ",\"usb_unplug_latency_ms\":%" PRIu32
+        ",\"level_lag_max_ms\":%" PRIu32,
+        BENCH_POWER_SIM_SECONDS,
+        result->wakeups,
+        result->stats.acquires,
+        result->stats.transfers,
+        result->stats.bytes,
+        (double)result->stats.bus_time_us / 1000,
+        result->usb_plug_latency_ms,
+        result->usb_unplug_latency_ms,
+        result->level_lag_max_ms);
+    bench_runner_report(runner, name, metrics);
+}
+
+void bench_power(BenchRunner* runner) {
+    BenchPower* bench = malloc(sizeof(BenchPower));
+
+    const char* legacy_name = "power/poll_legacy";
+    const char* adaptive_name = "power/poll_adaptive";
+    if(bench_runner_enabled(runner, legacy_name) || bench_runner_enabled(runner, adaptive_name)) {
+        BenchPowerResult legacy;
+        BenchPowerResult adaptive;
+        bench_power_simulate(bench, BenchPowerPolicyLegacy, &legacy);
+        bench_power_simulate(bench, BenchPowerPolicyAdaptive, &adaptive);
+
+        if(adaptive.decode_mismatch) {
+            bench_runner_fail(runner, adaptive_name, "burst and register readouts differ");
+        } else if(adaptive.usb_plug_latency_ms > POWER_POLL_INTERVAL_IDLE) {
+            bench_runner_fail(runner, adaptive_name, "USB plug noticed too late");
+        } else if(adaptive.usb_unplug_latency_ms > POWER_POLL_INTERVAL_ACTIVE) {
+            bench_runner_fail(runner, adaptive_name, "USB unplug noticed too late");
+        } else if(adaptive.level_lag_max_ms > POWER_POLL_INTERVAL_IDLE) {
+            bench_runner_fail(runner, adaptive_name, "battery level change noticed too late");
+        } else {
+            bench_power_report(runner, legacy_name, &legacy);
+            bench_power_report(runner, adaptive_name, &adaptive);
+        }
+    }
+
+    bench_power_init(bench);
+    bench_runner_run(
+        runner, "power/read_registers", 0, bench_power_read_registers_callback, bench);
+    bench_runner_run(runner, "power/read_burst", 0, bench_power_read_burst_callback, bench);
+    bench_power_deinit();
+
+    free(bench);
+}
@@ -0,0 +1,83 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/stream/stream.h>
+#include <toolbox/stream/string_stream.h>
+#include <toolbox/stream/file_stream.h>
+
+#define BENCH_STREAM_CHUNK_SIZE 64
+#define BENCH_STREAM_STRING_SIZE 4096
+#define BENCH_STREAM_FILE_SIZE 16384
+#define BENCH_STREAM_DIR "/ext/bench"
+#define BENCH_STREAM_FILE BENCH_STREAM_DIR "/stream.bin"
+
+typedef struct {
+    Storage* storage;
+    Stream* stream;
+    uint8_t chunk[BENCH_STREAM_CHUNK_SIZE];
+} BenchStream;
+
+static void bench_stream_write_read(Stream* stream, uint8_t* chunk, size_t size) {
+    for(size_t i = 0; i < size; i += BENCH_STREAM_CHUNK_SIZE) {
+        stream_write(stream, chunk, BENCH_STREAM_CHUNK_SIZE);
+    }
+    stream_rewind(stream);
+    for(size_t i = 0; i < size; i += BENCH_STREAM_CHUNK_SIZE) {
+        stream_read(stream, chunk, BENCH_STREAM_CHUNK_SIZE);
+    }
+}
+
+static void bench_stream_string(void* context, uint32_t iterations) {
+    BenchStream* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        stream_clean(bench->stream);
+        bench_stream_write_read(bench->stream, bench->chunk, BENCH_STREAM_STRING_SIZE);
+    }
+    bench_sink(bench->chunk[0]);
+}
+
+/** Includes open and close, as apps save and load whole files */
+static void bench_stream_file(void* context, uint32_t iterations) {
+    BenchStream* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        furi_check(file_stream_open(
+            bench->stream, BENCH_STREAM_FILE, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+        bench_stream_write_read(bench->stream, bench->chunk, BENCH_STREAM_FILE_SIZE);
+        file_stream_close(bench->stream);
+    }
+    bench_sink(bench->chunk[0]);
+}
+
+void bench_stream(BenchRunner* runner) {
+    BenchStream* bench = malloc(sizeof(BenchStream));
+    bench->storage = furi_record_open("storage");
+    for(size_t i = 0; i < BENCH_STREAM_CHUNK_SIZE; i++) {
+        bench->chunk[i] = i;
+    }
+
+    bench->stream = string_stream_alloc();
+    bench_runner_run(
+        runner,
+        "stream/string_write_read_4k",
+        BENCH_STREAM_STRING_SIZE,
+        bench_stream_string,
+        bench);
+    stream_free(bench->stream);
+
+    if(bench_runner_enabled(runner, "stream/file_write_read_16k")) {
+        storage_simply_mkdir(bench->storage, BENCH_STREAM_DIR);
+        bench->stream = file_stream_alloc(bench->storage);
+        bench_runner_run(
+            runner,
+            "stream/file_write_read_16k",
+            BENCH_STREAM_FILE_SIZE,
+            bench_stream_file,
+            bench);
+        stream_free(bench->stream);
+        storage_simply_remove(bench->storage, BENCH_STREAM_FILE);
+    }
+
+    furi_record_close("storage");
+    free(bench);
+}
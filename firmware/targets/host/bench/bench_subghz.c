@@ -0,0 +1,141 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <flipper_format/flipper_format_i.h>
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/transmitter.h>
+#include <lib/subghz/protocols/princeton.h>
+#include <lib/subghz/protocols/came.h>
+#include <lib/subghz/protocols/nice_flo.h>
+#include <stdio.h>
+
+#define BENCH_SUBGHZ_UPLOAD_MAX 1024
+
+typedef struct {
+    const char* protocol;
+    uint32_t bit;
+    uint64_t key;
+    uint32_t te;
+} BenchSubGhzKey;
+
+static const BenchSubGhzKey bench_subghz_keys[] = {
+    {SUBGHZ_PROTOCOL_PRINCETON_NAME, 24, 0x00A5A5A5, 400},
+    {SUBGHZ_PROTOCOL_CAME_NAME, 24, 0x00A5A5A5, 0},
+    {SUBGHZ_PROTOCOL_NICE_FLO_NAME, 24, 0x00A5A5A5, 0},
+};
+
+typedef struct {
+    SubGhzEnvironment* environment;
+    SubGhzReceiver* receiver;
+    FlipperFormat* flipper_format;
+    const char* protocol;
+    LevelDuration upload[BENCH_SUBGHZ_UPLOAD_MAX];
+    size_t upload_count;
+    uint32_t decoded;
+} BenchSubGhz;
+
+static void bench_subghz_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    UNUSED(decoder_base);
+    BenchSubGhz* bench = context;
+    bench->decoded++;
+}
+
+/** Deserialize key file and pull whole upload out of transmitter */
+static void bench_subghz_transmit(BenchSubGhz* bench) {
+    SubGhzTransmitter* transmitter =
+        subghz_transmitter_alloc_init(bench->environment, bench->protocol);
+    subghz_transmitter_deserialize(transmitter, bench->flipper_format);
+
+    bench->upload_count = 0;
+    while(bench->upload_count < BENCH_SUBGHZ_UPLOAD_MAX) {
+        LevelDuration level_duration = subghz_transmitter_yield(transmitter);
+        if(level_duration_is_reset(level_duration)) break;
+        bench->upload[bench->upload_count++] = level_duration;
+    }
+
+    subghz_transmitter_free(transmitter);
+}
+
+/** Feed upload to all decoders, as worker does with captured signal */
+static void bench_subghz_receive(BenchSubGhz* bench) {
+    subghz_receiver_reset(bench->receiver);
+    for(size_t i = 0; i < bench->upload_count; i++) {
+        subghz_receiver_decode(
+            bench->receiver,
+            level_duration_get_level(bench->upload[i]),
+            level_duration_get_duration(bench->upload[i]));
+    }
+}
+
+static void bench_subghz_transmitter(void* context, uint32_t iterations) {
+    BenchSubGhz* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_subghz_transmit(bench);
+    }
+    bench_sink(bench->upload_count);
+}
+
+static void bench_subghz_receiver(void* context, uint32_t iterations) {
+    BenchSubGhz* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_subghz_receive(bench);
+    }
+    bench_sink(bench->decoded);
+}
+
+static void bench_subghz_key_write(FlipperFormat* flipper_format, const BenchSubGhzKey* key) {
+    stream_clean(flipper_format_get_raw_stream(flipper_format));
+
+    uint8_t key_data[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[sizeof(uint64_t) - i - 1] = (key->key >> (i * 8)) & 0xFF;
+    }
+    uint32_t repeat = 1;
+
+    flipper_format_write_header_cstr(flipper_format, "Flipper SubGhz Key File", 1);
+    flipper_format_write_string_cstr(flipper_format, "Protocol", key->protocol);
+    flipper_format_write_uint32(flipper_format, "Bit", &key->bit, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(uint64_t));
+    if(key->te) flipper_format_write_uint32(flipper_format, "TE", &key->te, 1);
+    flipper_format_write_uint32(flipper_format, "Repeat", &repeat, 1);
+}
+
+void bench_subghz(BenchRunner* runner) {
+    BenchSubGhz* bench = malloc(sizeof(BenchSubGhz));
+    bench->environment = subghz_environment_alloc();
+    bench->receiver = subghz_receiver_alloc_init(bench->environment);
+    subghz_receiver_set_filter(bench->receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(bench->receiver, bench_subghz_rx_callback, bench);
+    bench->flipper_format = flipper_format_string_alloc();
+
+    for(size_t i = 0; i < COUNT_OF(bench_subghz_keys); i++) {
+        const BenchSubGhzKey* key = &bench_subghz_keys[i];
+        char transmit_name[64];
+        char receive_name[64];
+        snprintf(transmit_name, sizeof(transmit_name), "subghz/transmit/%s", key->protocol);
+        snprintf(receive_name, sizeof(receive_name), "subghz/receive/%s", key->protocol);
+
+        bench->protocol = key->protocol;
+        bench_subghz_key_write(bench->flipper_format, key);
+        bench_subghz_transmit(bench);
+
+        bench->decoded = 0;
+        bench_subghz_receive(bench);
+        if(bench->upload_count == 0 || bench->decoded == 0) {
+            bench_runner_fail(runner, receive_name, "transmitted key is not decoded");
+            continue;
+        }
+
+        bench_runner_run(runner, transmit_name, 0, bench_subghz_transmitter, bench);
+        bench_runner_run(runner, receive_name, 0, bench_subghz_receiver, bench);
+    }
+
+    flipper_format_free(bench->flipper_format);
+    subghz_receiver_free(bench->receiver);
+    subghz_environment_free(bench->environment);
+    free(bench);
+}
@@ -0,0 +1,373 @@
+#include "bench.h"
+
+#include <furi.h>
+#include <furi_hal_uart.h>
+#include <firmware/targets/f7/furi_hal/furi_hal_uart_dma_rx.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TAG "BenchUart"
+
+#define BENCH_UART_CHANNEL FuriHalUartIdUSART1
+#define BENCH_UART_BAUD 115200
+/** Odd size, so that half transfer point moves across bursts */
+#define BENCH_UART_DMA_SIZE 97
+#define BENCH_UART_BURST_MAX 300
+#define BENCH_UART_STREAM_SIZE 4096
+
+/* Reception at line rate is simulated, time taken on host means nothing there.
+ * Device cost model: Cortex-M4 at 64MHz, every interrupt pays entry and exit, flag
+ * checks and a callback that hands data to a stream buffer as usb_uart_bridge does,
+ * copy comes on top. Higher priority interrupts and critical sections keep UART
+ * interrupts masked for a while every millisecond. */
+#define BENCH_UART_SIM_BYTES (256 * 1024)
+#define BENCH_UART_SIM_IRQ_NS 2000.0
+#define BENCH_UART_SIM_COPY_NS 16.0
+#define BENCH_UART_SIM_MASK_NS 50000.0
+#define BENCH_UART_SIM_MASK_PERIOD_NS 1000000.0
+/** 8 data bits, start and stop */
+#define BENCH_UART_SIM_CHAR_BITS 10
+/** USART RX FIFO */
+#define BENCH_UART_SIM_FIFO_SIZE 8
+/** usb_uart_bridge DMA buffer */
+#define BENCH_UART_SIM_DMA_SIZE 256
+/** Line stays idle for two characters after every burst */
+#define BENCH_UART_SIM_GAP_CHARS 2
+#define BENCH_UART_SIM_METRICS_SIZE 256
+
+typedef struct {
+    uint8_t dma_buffer[BENCH_UART_DMA_SIZE];
+    uint8_t tx[BENCH_UART_BURST_MAX];
+    uint8_t next_tx;
+    uint8_t next_rx;
+    size_t received;
+    uint32_t chunks;
+    uint32_t errors;
+    uint32_t rxne;
+    uint32_t idle;
+} BenchUart;
+
+typedef enum {
+    BenchUartSimModeRxne,
+    BenchUartSimModeDma,
+} BenchUartSimMode;
+
+typedef enum {
+    BenchUartSimIrqNone,
+    BenchUartSimIrqRxne,
+    BenchUartSimIrqDma,
+    BenchUartSimIrqIdle,
+} BenchUartSimIrq;
+
+typedef struct {
+    BenchUartSimMode mode;
+    double char_ns;
+
+    /* CPU */
+    double cpu_free; /**< running interrupt ends */
+    double busy_ns;
+    uint32_t irqs;
+
+    /* Receiver, stamp is byte number in stream */
+    uint32_t sent;
+    uint32_t fifo_stamp[BENCH_UART_SIM_FIFO_SIZE];
+    double fifo_time[BENCH_UART_SIM_FIFO_SIZE];
+    size_t fifo_head;
+    size_t fifo_count;
+    uint8_t dma_buffer[BENCH_UART_SIM_DMA_SIZE];
+    uint32_t dma_stamp[BENCH_UART_SIM_DMA_SIZE];
+    uint32_t dma_written;
+    FuriHalUartDmaRx dma_rx;
+
+    /* Interrupt requests, flags merge until serviced */
+    bool dma_pending;
+    double dma_time;
+    bool idle_pending;
+    double idle_time;
+
+    /* Consumer */
+    uint32_t next;
+    uint32_t delivered;
+    uint32_t lost;
+    uint32_t corrupted; /**< stale buffer content handed out after DMA lapped the reader */
+    size_t chunk;
+} BenchUartSim;
+
+static void bench_uart_dma_rx_callback(uint8_t* data, size_t size, void* context) {
+    BenchUart* bench = context;
+    for(size_t i = 0; i < size; i++) {
+        bench->errors += (data[i] != bench->next_rx++);
+    }
+    bench->received += size;
+    bench->chunks++;
+}
+
+static void bench_uart_irq_callback(UartIrqEvent event, uint8_t data, void* context) {
+    BenchUart* bench = context;
+    if(event == UartIrqEventRXNE) {
+        bench->errors += (data != bench->next_rx++);
+        bench->rxne++;
+    } else if(event == UartIrqEventIDLE) {
+        bench->idle++;
+    }
+}
+
+/* Bursts of every length from 1 to BENCH_UART_BURST_MAX, each ends with idle line */
+static size_t bench_uart_send_bursts(BenchUart* bench, size_t total) {
+    size_t sent = 0;
+    size_t burst = 1;
+    while(sent < total) {
+        size_t size = MIN(burst, total - sent);
+        for(size_t i = 0; i < size; i++) {
+            bench->tx[i] = bench->next_tx++;
+        }
+        furi_hal_uart_tx(BENCH_UART_CHANNEL, bench->tx, size);
+        sent += size;
+        burst = burst % BENCH_UART_BURST_MAX + 1;
+    }
+    return sent;
+}
+
+static void bench_uart_dma_rx(void* context, uint32_t iterations) {
+    BenchUart* bench = context;
+    for(uint32_t i = 0; i < iterations; i++) {
+        bench_uart_send_bursts(bench, BENCH_UART_STREAM_SIZE);
+    }
+    bench_sink(bench->received);
+}
+
+static void bench_uart_loopback(BenchRunner* runner) {
+    const char* name = "uart/dma_rx_loopback";
+    if(!bench_runner_enabled(runner, name)) return;
+
+    BenchUart* bench = malloc(sizeof(BenchUart));
+    furi_hal_uart_init(BENCH_UART_CHANNEL, BENCH_UART_BAUD);
+    furi_hal_uart_set_irq_cb(BENCH_UART_CHANNEL, bench_uart_irq_callback, bench);
+
+    // Self check: stream comes out of DMA whole and in order, wraps included
+    furi_hal_uart_dma_rx_start(
+        BENCH_UART_CHANNEL,
+        bench->dma_buffer,
+        sizeof(bench->dma_buffer),
+        bench_uart_dma_rx_callback,
+        bench);
+    size_t sent = bench_uart_send_bursts(bench, BENCH_UART_STREAM_SIZE * 8);
+    bool dma_ok = !bench->errors && bench->received == sent && !bench->rxne && !bench->idle;
+    uint32_t chunks = bench->chunks;
+
+    if(dma_ok) {
+        bench_runner_run(runner, name, BENCH_UART_STREAM_SIZE, bench_uart_dma_rx, bench);
+    }
+    furi_hal_uart_dma_rx_stop(BENCH_UART_CHANNEL);
+
+    // Per byte interrupt is back after stop
+    bench->received = 0;
+    sent = bench_uart_send_bursts(bench, BENCH_UART_BURST_MAX);
+    bool rxne_ok = !bench->errors && !bench->received && bench->rxne == sent && bench->idle;
+
+    furi_hal_uart_deinit(BENCH_UART_CHANNEL);
+    free(bench);
+
+    if(!dma_ok) {
+        bench_runner_fail(runner, name, "DMA stream mismatch");
+    } else if(!rxne_ok) {
+        bench_runner_fail(runner, name, "RX interrupts not restored on stop");
+    } else {
+        char metrics[64];
+        snprintf(
+            metrics,
+            sizeof(metrics),
+            "\"bytes\":%u,\"chunks\":%" PRIu32,
+            BENCH_UART_STREAM_SIZE * 8,
+            chunks);
+        bench_runner_report(runner, "uart/dma_rx_chunks", metrics);
+    }
+}
+
+static void bench_uart_sim_deliver(BenchUartSim* sim, uint32_t stamp) {
+    if(stamp < sim->next) {
+        sim->corrupted++;
+    } else {
+        sim->lost += stamp - sim->next;
+        sim->next = stamp + 1;
+        sim->delivered++;
+    }
+}
+
+static void bench_uart_sim_dma_callback(uint8_t* data, size_t size, void* context) {
+    BenchUartSim* sim = context;
+    size_t slot = data - sim->dma_buffer;
+    for(size_t i = 0; i < size; i++) {
+        bench_uart_sim_deliver(sim, sim->dma_stamp[slot + i]);
+    }
+    sim->chunk += size;
+}
+
+/** Earliest time interrupt can start, masked windows are skipped */
+static double bench_uart_sim_unmasked(double time) {
+    double phase = time - (uint64_t)(time / BENCH_UART_SIM_MASK_PERIOD_NS) *
+                              BENCH_UART_SIM_MASK_PERIOD_NS;
+    return (phase < BENCH_UART_SIM_MASK_NS) ? time + BENCH_UART_SIM_MASK_NS - phase : time;
+}
+
+/** Oldest pending interrupt request, USART handler takes RXNE before IDLE */
+static BenchUartSimIrq bench_uart_sim_request(BenchUartSim* sim, double* time) {
+    BenchUartSimIrq irq = BenchUartSimIrqNone;
+    if(sim->fifo_count) {
+        irq = BenchUartSimIrqRxne;
+        *time = sim->fifo_time[sim->fifo_head];
+    } else if(sim->idle_pending) {
+        irq = BenchUartSimIrqIdle;
+        *time = sim->idle_time;
+    }
+    if(sim->dma_pending && (irq == BenchUartSimIrqNone || sim->dma_time < *time)) {
+        irq = BenchUartSimIrqDma;
+        *time = sim->dma_time;
+    }
+    return irq;
+}
+
+static void bench_uart_sim_serve(BenchUartSim* sim, BenchUartSimIrq irq, double start) {
+    double cost = BENCH_UART_SIM_IRQ_NS;
+
+    if(irq == BenchUartSimIrqRxne) {
+        bench_uart_sim_deliver(sim, sim->fifo_stamp[sim->fifo_head]);
+        sim->fifo_head = (sim->fifo_head + 1) % BENCH_UART_SIM_FIFO_SIZE;
+        sim->fifo_count--;
+        cost += BENCH_UART_SIM_COPY_NS;
+    } else {
+        if(irq == BenchUartSimIrqDma) {
+            sim->dma_pending = false;
+        } else {
+            sim->idle_pending = false;
+        }
+        if(sim->mode == BenchUartSimModeDma) {
+            sim->chunk = 0;
+            furi_hal_uart_dma_rx_process_remaining(
+                &sim->dma_rx,
+                BENCH_UART_SIM_DMA_SIZE - sim->dma_written % BENCH_UART_SIM_DMA_SIZE);
+            cost += BENCH_UART_SIM_COPY_NS * sim->chunk;
+        }
+    }
+
+    sim->cpu_free = start + cost;
+    sim->busy_ns += cost;
+    sim->irqs++;
+}
+
+/* Byte is complete on stop bit: DMA takes it from FIFO at once, RXNE waits in FIFO */
+static void bench_uart_sim_receive(BenchUartSim* sim, double time) {
+    uint32_t stamp = sim->sent++;
+
+    if(sim->mode == BenchUartSimModeRxne) {
+        // Overrun: FIFO is full, new byte is lost
+        if(sim->fifo_count == BENCH_UART_SIM_FIFO_SIZE) return;
+        size_t tail = (sim->fifo_head + sim->fifo_count) % BENCH_UART_SIM_FIFO_SIZE;
+        sim->fifo_stamp[tail] = stamp;
+        sim->fifo_time[tail] = time;
+        sim->fifo_count++;
+    } else {
+        size_t slot = sim->dma_written % BENCH_UART_SIM_DMA_SIZE;
+        sim->dma_stamp[slot] = stamp;
+        sim->dma_buffer[slot] = stamp;
+        sim->dma_written++;
+        // Half transfer and transfer complete
+        if(sim->dma_written % (BENCH_UART_SIM_DMA_SIZE / 2) == 0 && !sim->dma_pending) {
+            sim->dma_pending = true;
+            sim->dma_time = time;
+        }
+    }
+}
+
+static void bench_uart_sim_run(BenchUartSim* sim) {
+    double line = 0;
+    size_t burst = 1;
+    size_t burst_left = burst;
+
+    while(true) {
+        bool receiving = sim->sent < BENCH_UART_SIM_BYTES;
+        double arrival = line + sim->char_ns;
+        double request = 0;
+        BenchUartSimIrq irq = bench_uart_sim_request(sim, &request);
+        if(!receiving && irq == BenchUartSimIrqNone) break;
+
+        if(irq != BenchUartSimIrqNone) {
+            double start = bench_uart_sim_unmasked(MAX(sim->cpu_free, request));
+            if(!receiving || start < arrival) {
+                bench_uart_sim_serve(sim, irq, start);
+                continue;
+            }
+        }
+
+        line = arrival;
+        bench_uart_sim_receive(sim, arrival);
+        if(--burst_left == 0 || sim->sent == BENCH_UART_SIM_BYTES) {
+            // Idle is detected after one character of idle line
+            if(!sim->idle_pending) {
+                sim->idle_pending = true;
+                sim->idle_time = line + sim->char_ns;
+            }
+            line += BENCH_UART_SIM_GAP_CHARS * sim->char_ns;
+            burst = burst % BENCH_UART_BURST_MAX + 1;
+            burst_left = burst;
+        }
+    }
+
+    sim->lost += sim->sent - sim->next;
+}
+
+static void bench_uart_sim(BenchRunner* runner, BenchUartSimMode mode, uint32_t baud) {
+    char name[32];
+    snprintf(
+        name,
+        sizeof(name),
+        "uart/rx_sim/%s_%" PRIu32 "mbaud",
+        (mode == BenchUartSimModeDma) ? "dma" : "rxne",
+        baud / 1000000);
+    if(!bench_runner_enabled(runner, name)) return;
+
+    BenchUartSim* sim = malloc(sizeof(BenchUartSim));
+    memset(sim, 0, sizeof(BenchUartSim));
+    sim->mode = mode;
+    sim->char_ns = 1e9 * BENCH_UART_SIM_CHAR_BITS / baud;
+    sim->dma_rx.buffer = sim->dma_buffer;
+    sim->dma_rx.size = BENCH_UART_SIM_DMA_SIZE;
+    sim->dma_rx.callback = bench_uart_sim_dma_callback;
+    sim->dma_rx.context = sim;
+
+    bench_uart_sim_run(sim);
+
+    if(sim->delivered + sim->lost != sim->sent) {
+        bench_runner_fail(runner, name, "delivered and lost bytes don't add up");
+    } else {
+        double seconds = sim->cpu_free / 1e9;
+        char metrics[BENCH_UART_SIM_METRICS_SIZE];
+        snprintf(
+            metrics,
+            sizeof(metrics),
+            "\"baud\":%" PRIu32 ",\"bytes\":%" PRIu32 ",\"drop_rate\":%.5f,"
+            "\"corrupted\":%" PRIu32 ",\"bytes_per_s\":%.0f,\"line_bytes_per_s\":%" PRIu32
+            ",\"irqs\":%" PRIu32 ",\"irq_load\":%.3f",
+            baud,
+            sim->sent,
+            (double)sim->lost / sim->sent,
+            sim->corrupted,
+            sim->delivered / seconds,
+            baud / BENCH_UART_SIM_CHAR_BITS,
+            sim->irqs,
+            sim->busy_ns / sim->cpu_free);
+        bench_runner_report(runner, name, metrics);
+    }
+
+    free(sim);
+}
+
+void bench_uart(BenchRunner* runner) {
+    bench_uart_loopback(runner);
+
+    for(uint32_t baud = 1000000; baud <= 3000000; baud += 1000000) {
+        bench_uart_sim(runner, BenchUartSimModeRxne, baud);
+        bench_uart_sim(runner, BenchUartSimModeDma, baud);
+    }
+}
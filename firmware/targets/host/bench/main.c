@@ -0,0 +1,33 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "bench.h"
+#include <storage_posix.h>
+
+#define TAG "Main"
+
+int main(int argc, char** argv) {
+    const char* filter = (argc > 1) ? argv[1] : NULL;
+
+    osKernelInitialize();
+    furi_init();
+    furi_hal_init();
+    osKernelStart();
+
+    storage_posix_init();
+
+    BenchRunner* runner = bench_runner_alloc(filter);
+    bench_furi(runner);
+    bench_stream(runner);
+    bench_flipper_format(runner);
+    bench_compress(runner);
+    bench_heatshrink(runner);
+    bench_gui(runner);
+    bench_infrared(runner);
+    bench_subghz(runner);
+    bench_nfc(runner);
+    bench_power(runner);
+    bench_uart(runner);
+    bench_fatfs(runner);
+
+    return bench_runner_free(runner) ? 1 : 0;
+}
@@ -0,0 +1,13 @@
+#include <furi_hal.h>
+#include <furi.h>
+
+#define TAG "FuriHal"
+
+void furi_hal_init() {
+    furi_hal_console_init();
+    furi_hal_delay_init();
+    furi_hal_crypto_init();
+    furi_hal_spi_init();
+    furi_hal_compress_icon_init();
+    FURI_LOG_I(TAG, "Init OK");
+}
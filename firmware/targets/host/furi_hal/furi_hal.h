@@ -0,0 +1,32 @@
+/**
+ * @file furi_hal.h
+ * Furi HAL API, host target
+ * Only peripherals without hardware behind them: console, time, random,
+ * types of radio HALs used by protocol libs, I2C bus with device models,
+ * UART wired in loopback and display SPI bus that only counts traffic.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+template <unsigned int N> struct STOP_EXTERNING_ME {};
+#endif
+
+#include "furi_hal_console.h"
+#include "furi_hal_gpio.h"
+#include "furi_hal_resources.h"
+#include "furi_hal_crypto.h"
+#include "furi_hal_delay.h"
+#include "furi_hal_random.h"
+#include "furi_hal_i2c.h"
+#include "furi_hal_subghz.h"
+#include "furi_hal_infrared.h"
+#include "furi_hal_nfc.h"
+#include "furi_hal_uart.h"
+#include "furi_hal_spi.h"
+#include "furi_hal_power.h"
+#include "furi_hal_version.h"
+#include "furi_hal_compress.h"
+
+/** Init furi_hal */
+void furi_hal_init();
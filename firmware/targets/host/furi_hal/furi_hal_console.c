@@ -0,0 +1,44 @@
+#include <furi_hal_console.h>
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+static volatile bool furi_hal_console_alive = true;
+
+void furi_hal_console_init() {
+    furi_hal_console_alive = true;
+}
+
+void furi_hal_console_enable() {
+    furi_hal_console_alive = true;
+}
+
+void furi_hal_console_disable() {
+    fflush(stderr);
+    furi_hal_console_alive = false;
+}
+
+void furi_hal_console_tx(const uint8_t* buffer, size_t buffer_size) {
+    if(!furi_hal_console_alive) return;
+    fwrite(buffer, 1, buffer_size, stderr);
+}
+
+void furi_hal_console_tx_with_new_line(const uint8_t* buffer, size_t buffer_size) {
+    if(!furi_hal_console_alive) return;
+    fwrite(buffer, 1, buffer_size, stderr);
+    fwrite("\r\n", 1, 2, stderr);
+}
+
+void furi_hal_console_printf(const char format[], ...) {
+    if(!furi_hal_console_alive) return;
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+void furi_hal_console_puts(const char* data) {
+    furi_hal_console_tx((const uint8_t*)data, strlen(data));
+}
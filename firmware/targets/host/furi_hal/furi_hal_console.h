@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Console goes to stderr, stdout is left for benchmark results */
+void furi_hal_console_init();
+
+void furi_hal_console_enable();
+
+void furi_hal_console_disable();
+
+void furi_hal_console_tx(const uint8_t* buffer, size_t buffer_size);
+
+void furi_hal_console_tx_with_new_line(const uint8_t* buffer, size_t buffer_size);
+
+/**
+ * Printf-like plain console interface
+ * @param format 
+ * @param ... 
+ */
+void furi_hal_console_printf(const char format[], ...);
+
+void furi_hal_console_puts(const char* data);
+
+#ifdef __cplusplus
+}
+#endif
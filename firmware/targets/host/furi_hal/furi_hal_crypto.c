@@ -0,0 +1,55 @@
+#include <furi_hal_crypto.h>
+#include <furi.h>
+
+#define TAG "FuriHalCrypto"
+
+/**
+ * There is no secure enclave on host: key slots are never available,
+ * so encrypted files fail to load the same way as on device without provisioned keys.
+ */
+
+void furi_hal_crypto_init() {
+    FURI_LOG_I(TAG, "Init OK, no enclave");
+}
+
+bool furi_hal_crypto_verify_enclave(uint8_t* keys_nb, uint8_t* valid_keys_nb) {
+    if(keys_nb) *keys_nb = 0;
+    if(valid_keys_nb) *valid_keys_nb = 0;
+    return false;
+}
+
+bool furi_hal_crypto_verify_key(uint8_t key_slot) {
+    UNUSED(key_slot);
+    return false;
+}
+
+bool furi_hal_crypto_store_add_key(FuriHalCryptoKey* key, uint8_t* slot) {
+    UNUSED(key);
+    UNUSED(slot);
+    return false;
+}
+
+bool furi_hal_crypto_store_load_key(uint8_t slot, const uint8_t* iv) {
+    UNUSED(slot);
+    UNUSED(iv);
+    return false;
+}
+
+bool furi_hal_crypto_store_unload_key(uint8_t slot) {
+    UNUSED(slot);
+    return false;
+}
+
+bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
+
+bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
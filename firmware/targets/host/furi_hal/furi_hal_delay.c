@@ -0,0 +1,35 @@
+#include "furi_hal_delay.h"
+
+#include <furi.h>
+#include <time.h>
+
+#define TAG "FuriHalDelay"
+
+void furi_hal_delay_init(void) {
+    FURI_LOG_I(TAG, "Init OK");
+}
+
+void furi_hal_tick(void) {
+}
+
+uint32_t furi_hal_get_tick(void) {
+    return osKernelGetTickCount();
+}
+
+void furi_hal_delay_us(float microseconds) {
+    // busy wait as on device, sleep granularity is too coarse for short delays
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double elapsed;
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (now.tv_sec - start.tv_sec) * 1e6 + (now.tv_nsec - start.tv_nsec) / 1e3;
+    } while(elapsed < microseconds);
+}
+
+void furi_hal_delay_ms(float milliseconds) {
+    uint32_t ticks = milliseconds / (1000.0f / osKernelGetTickFreq());
+    osStatus_t result = osDelay(ticks);
+    (void)result;
+    furi_assert(result == osOK);
+}
@@ -0,0 +1,214 @@
+#include <furi_hal_i2c.h>
+#include <furi.h>
+
+// START, address and STOP of every transfer, RESTART with address for read after write
+#define FURI_HAL_I2C_FRAME_BITS (1 + 9 + 1)
+#define FURI_HAL_I2C_RESTART_BITS (1 + 9)
+
+FuriHalI2cBusHandle furi_hal_i2c_handle_power = {
+    .speed = 400000,
+};
+
+FuriHalI2cBusHandle furi_hal_i2c_handle_external = {
+    .speed = 100000,
+};
+
+void furi_hal_i2c_init() {
+}
+
+void furi_hal_i2c_acquire(FuriHalI2cBusHandle* handle) {
+    FURI_CRITICAL_ENTER();
+    furi_check(!handle->acquired);
+    handle->acquired = true;
+    handle->stats.acquires++;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_i2c_release(FuriHalI2cBusHandle* handle) {
+    FURI_CRITICAL_ENTER();
+    furi_check(handle->acquired);
+    handle->acquired = false;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_i2c_set_device(
+    FuriHalI2cBusHandle* handle,
+    uint8_t address,
+    const FuriHalI2cDevice* device,
+    void* context) {
+    FuriHalI2cDeviceSlot* free_slot = NULL;
+    for(size_t i = 0; i < FURI_HAL_I2C_DEVICES_MAX; i++) {
+        FuriHalI2cDeviceSlot* slot = &handle->devices[i];
+        if(slot->device && slot->address == address) {
+            free_slot = slot;
+            break;
+        } else if(!slot->device && !free_slot) {
+            free_slot = slot;
+        }
+    }
+    furi_check(free_slot);
+
+    free_slot->address = address;
+    free_slot->device = device;
+    free_slot->context = context;
+}
+
+void furi_hal_i2c_get_stats(FuriHalI2cBusHandle* handle, FuriHalI2cStats* stats) {
+    *stats = handle->stats;
+}
+
+void furi_hal_i2c_reset_stats(FuriHalI2cBusHandle* handle) {
+    memset(&handle->stats, 0, sizeof(FuriHalI2cStats));
+}
+
+static FuriHalI2cDeviceSlot* furi_hal_i2c_find(FuriHalI2cBusHandle* handle, uint8_t address) {
+    furi_check(handle->acquired);
+    for(size_t i = 0; i < FURI_HAL_I2C_DEVICES_MAX; i++) {
+        if(handle->devices[i].device && handle->devices[i].address == address) {
+            return &handle->devices[i];
+        }
+    }
+    return NULL;
+}
+
+static void furi_hal_i2c_account(FuriHalI2cBusHandle* handle, size_t payload, bool restart) {
+    uint32_t bits = FURI_HAL_I2C_FRAME_BITS + payload * 9;
+    if(restart) bits += FURI_HAL_I2C_RESTART_BITS;
+
+    handle->stats.transfers++;
+    handle->stats.bytes += payload + (restart ? 2 : 1);
+    handle->stats.bus_time_us += (uint64_t)bits * 1000000 / handle->speed;
+}
+
+bool furi_hal_i2c_tx(
+    FuriHalI2cBusHandle* handle,
+    const uint8_t address,
+    const uint8_t* data,
+    const uint8_t size,
+    uint32_t timeout) {
+    furi_assert(timeout > 0);
+    furi_assert(size > 0);
+
+    furi_hal_i2c_account(handle, size, false);
+    FuriHalI2cDeviceSlot* slot = furi_hal_i2c_find(handle, address);
+    if(!slot) return false;
+    // First byte selects register
+    return slot->device->write(slot->context, data[0], &data[1], size - 1);
+}
+
+bool furi_hal_i2c_rx(
+    FuriHalI2cBusHandle* handle,
+    const uint8_t address,
+    uint8_t* data,
+    const uint8_t size,
+    uint32_t timeout) {
+    furi_assert(timeout > 0);
+
+    furi_hal_i2c_account(handle, size, false);
+    FuriHalI2cDeviceSlot* slot = furi_hal_i2c_find(handle, address);
+    if(!slot) return false;
+    // Models don't keep register pointer between transfers, plain read starts from 0
+    return slot->device->read(slot->context, 0, data, size);
+}
+
+bool furi_hal_i2c_trx(
+    FuriHalI2cBusHandle* handle,
+    const uint8_t address,
+    const uint8_t* tx_data,
+    const uint8_t tx_size,
+    uint8_t* rx_data,
+    const uint8_t rx_size,
+    uint32_t timeout) {
+    furi_assert(timeout > 0);
+    furi_assert(tx_size > 0);
+
+    furi_hal_i2c_account(handle, tx_size + rx_size, true);
+    FuriHalI2cDeviceSlot* slot = furi_hal_i2c_find(handle, address);
+    if(!slot) return false;
+    bool ret = true;
+    if(tx_size > 1) {
+        ret = slot->device->write(slot->context, tx_data[0], &tx_data[1], tx_size - 1);
+    }
+    return ret && slot->device->read(slot->context, tx_data[0], rx_data, rx_size);
+}
+
+bool furi_hal_i2c_is_device_ready(FuriHalI2cBusHandle* handle, uint8_t i2c_addr, uint32_t timeout) {
+    furi_assert(timeout > 0);
+
+    furi_hal_i2c_account(handle, 0, false);
+    return furi_hal_i2c_find(handle, i2c_addr) != NULL;
+}
+
+bool furi_hal_i2c_read_reg_8(
+    FuriHalI2cBusHandle* handle,
+    uint8_t i2c_addr,
+    uint8_t reg_addr,
+    uint8_t* data,
+    uint32_t timeout) {
+    return furi_hal_i2c_trx(handle, i2c_addr, &reg_addr, 1, data, 1, timeout);
+}
+
+bool furi_hal_i2c_read_reg_16(
+    FuriHalI2cBusHandle* handle,
+    uint8_t i2c_addr,
+    uint8_t reg_addr,
+    uint16_t* data,
+    uint32_t timeout) {
+    uint8_t reg_data[2];
+    bool ret = furi_hal_i2c_trx(handle, i2c_addr, &reg_addr, 1, reg_data, 2, timeout);
+    *data = (reg_data[0] << 8) | (reg_data[1]);
+
+    return ret;
+}
+
+bool furi_hal_i2c_read_mem(
+    FuriHalI2cBusHandle* handle,
+    uint8_t i2c_addr,
+    uint8_t mem_addr,
+    uint8_t* data,
+    uint8_t len,
+    uint32_t timeout) {
+    return furi_hal_i2c_trx(handle, i2c_addr, &mem_addr, 1, data, len, timeout);
+}
+
+bool furi_hal_i2c_write_reg_8(
+    FuriHalI2cBusHandle* handle,
+    uint8_t i2c_addr,
+    uint8_t reg_addr,
+    uint8_t data,
+    uint32_t timeout) {
+    uint8_t tx_data[2];
+    tx_data[0] = reg_addr;
+    tx_data[1] = data;
+
+    return furi_hal_i2c_tx(handle, i2c_addr, tx_data, 2, timeout);
+}
+
+bool furi_hal_i2c_write_reg_16(
+    FuriHalI2cBusHandle* handle,
+    uint8_t i2c_addr,
+    uint8_t reg_addr,
+    uint16_t data,
+    uint32_t timeout) {
+    uint8_t tx_data[3];
+    tx_data[0] = reg_addr;
+    tx_data[1] = (data >> 8) & 0xFF;
+    tx_data[2] = data & 0xFF;
+
+    return furi_hal_i2c_tx(handle, i2c_addr, tx_data, 3, timeout);
+}
+
+bool furi_hal_i2c_write_mem(
+    FuriHalI2cBusHandle* handle,
+    uint8_t i2c_addr,
+    uint8_t mem_addr,
+    uint8_t* data,
+    uint8_t len,
+    uint32_t timeout) {
+    furi_assert(timeout > 0);
+
+    furi_hal_i2c_account(handle, len + 1, false);
+    FuriHalI2cDeviceSlot* slot = furi_hal_i2c_find(handle, i2c_addr);
+    if(!slot) return false;
+    return slot->device->write(slot->context, mem_addr, data, len);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Host has no I2C controller, transfers go to device models attached to the
+ * handle with furi_hal_i2c_set_device. Register address auto increments as on
+ * real chips. Bus statistics count transfers and their time on the wire.
+ */
+
+#define FURI_HAL_I2C_DEVICES_MAX 4
+
+/** Simulated device on the bus, reg is the first register of the transfer */
+typedef struct {
+    bool (*read)(void* context, uint8_t reg, uint8_t* data, size_t size);
+    bool (*write)(void* context, uint8_t reg, const uint8_t* data, size_t size);
+} FuriHalI2cDevice;
+
+typedef struct {
+    uint32_t acquires; /**< bus lock, clock and pin setup on device */
+    uint32_t transfers;
+    uint32_t bytes; /**< address and payload bytes */
+    uint32_t bus_time_us; /**< time on the wire at handle speed */
+} FuriHalI2cStats;
+
+typedef struct {
+    uint8_t address;
+    const FuriHalI2cDevice* device;
+    void* context;
+} FuriHalI2cDeviceSlot;
+
+typedef struct {
+    /** Bits per second */
+    uint32_t speed;
+    bool acquired;
+    FuriHalI2cDeviceSlot devices[FURI_HAL_I2C_DEVICES_MAX];
+    FuriHalI2cStats stats;
+} FuriHalI2cBusHandle;
+
+/** Internal(power) i2c bus, 400khz */
+extern FuriHalI2cBusHandle furi_hal_i2c_handle_power;
+
+/** External i2c bus, 100khz */
+extern FuriHalI2cBusHandle furi_hal_i2c_handle_external;
+
+/** Attach device model to the bus, NULL to detach. Host only */
+void furi_hal_i2c_set_device(
+    FuriHalI2cBusHandle* handle,
+    uint8_t address,
+    const FuriHalI2cDevice* device,
+    void* context);
+
+/** Get bus statistics since the last reset. Host only */
+void furi_hal_i2c_get_stats(FuriHalI2cBusHandle* handle, FuriHalI2cStats* stats);
+
+/** Reset bus statistics. Host only */
+void furi_hal_i2c_reset_stats(FuriHalI2cBusHandle* handle);
+
+#ifdef __cplusplus
+}
+#endif
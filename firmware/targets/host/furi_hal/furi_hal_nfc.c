@@ -0,0 +1,28 @@
+#include "furi_hal_nfc.h"
+
+#include <stddef.h>
+
+static const FuriHalNfcCard* furi_hal_nfc_card = NULL;
+static void* furi_hal_nfc_card_context = NULL;
+
+void furi_hal_nfc_set_card(const FuriHalNfcCard* card, void* context) {
+    furi_hal_nfc_card = card;
+    furi_hal_nfc_card_context = context;
+}
+
+bool furi_hal_nfc_activate_nfca(uint32_t timeout, uint32_t* cuid) {
+    (void)timeout;
+    if(!furi_hal_nfc_card) return false;
+    return furi_hal_nfc_card->activate(furi_hal_nfc_card_context, cuid);
+}
+
+bool furi_hal_nfc_tx_rx(FuriHalNfcTxRxContext* tx_rx_ctx) {
+    if(!furi_hal_nfc_card) return false;
+    return furi_hal_nfc_card->tx_rx(furi_hal_nfc_card_context, tx_rx_ctx);
+}
+
+void furi_hal_nfc_deactivate() {
+    if(furi_hal_nfc_card) {
+        furi_hal_nfc_card->deactivate(furi_hal_nfc_card_context);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Host has no NFC frontend, transceive flags and emulation callback are kept
+ * so protocol libs shared with the device compile. Flag values are opaque.
+ * Reader side goes to the card set with furi_hal_nfc_set_card.
+ */
+
+#define FURI_HAL_NFC_DATA_BUFF_SIZE (64)
+#define FURI_HAL_NFC_PARITY_BUFF_SIZE (FURI_HAL_NFC_DATA_BUFF_SIZE / 8)
+
+#define FURI_HAL_NFC_TXRX_DEFAULT ((uint32_t)0x01)
+#define FURI_HAL_NFC_TX_DEFAULT_RX_NO_CRC ((uint32_t)0x02)
+#define FURI_HAL_NFC_TXRX_WITH_PAR ((uint32_t)0x04)
+#define FURI_HAL_NFC_TXRX_RAW ((uint32_t)0x08)
+
+typedef bool (*FuriHalNfcEmulateCallback)(
+    uint8_t* buff_rx,
+    uint16_t buff_rx_len,
+    uint8_t* buff_tx,
+    uint16_t* buff_tx_len,
+    uint32_t* flags,
+    void* context);
+
+/** Same as on device: data and parity bits are split in FURI_HAL_NFC_TXRX_RAW mode */
+typedef struct {
+    uint8_t tx_data[FURI_HAL_NFC_DATA_BUFF_SIZE];
+    uint8_t tx_parity[FURI_HAL_NFC_PARITY_BUFF_SIZE];
+    uint16_t tx_bits;
+    uint8_t rx_data[FURI_HAL_NFC_DATA_BUFF_SIZE];
+    uint8_t rx_parity[FURI_HAL_NFC_PARITY_BUFF_SIZE];
+    uint16_t rx_bits;
+    uint32_t tx_rx_type;
+} FuriHalNfcTxRxContext;
+
+/** Simulated card in the field */
+typedef struct {
+    /** Field on, card is selected. Return false if card doesn't answer */
+    bool (*activate)(void* context, uint32_t* cuid);
+    /** Field off, card loses its state */
+    void (*deactivate)(void* context);
+    /** Answer reader frame. Return false if card doesn't answer */
+    bool (*tx_rx)(void* context, FuriHalNfcTxRxContext* tx_rx_ctx);
+} FuriHalNfcCard;
+
+/** Put card in the field, NULL to remove it. Host only */
+void furi_hal_nfc_set_card(const FuriHalNfcCard* card, void* context);
+
+bool furi_hal_nfc_activate_nfca(uint32_t timeout, uint32_t* cuid);
+
+bool furi_hal_nfc_tx_rx(FuriHalNfcTxRxContext* tx_rx_ctx);
+
+void furi_hal_nfc_deactivate();
+
+#ifdef __cplusplus
+}
+#endif
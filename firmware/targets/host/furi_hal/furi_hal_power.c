@@ -0,0 +1,23 @@
+#include <furi_hal_power.h>
+#include <furi.h>
+
+// Host doesn't sleep, insomnia is only balanced
+static volatile uint8_t furi_hal_power_insomnia = 0;
+
+uint16_t furi_hal_power_insomnia_level() {
+    return furi_hal_power_insomnia;
+}
+
+void furi_hal_power_insomnia_enter() {
+    FURI_CRITICAL_ENTER();
+    furi_assert(furi_hal_power_insomnia < UINT8_MAX);
+    furi_hal_power_insomnia++;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_power_insomnia_exit() {
+    FURI_CRITICAL_ENTER();
+    furi_assert(furi_hal_power_insomnia > 0);
+    furi_hal_power_insomnia--;
+    FURI_CRITICAL_EXIT();
+}
@@ -0,0 +1,21 @@
+#include "furi_hal_random.h"
+#include <furi.h>
+
+#include <sys/random.h>
+
+uint32_t furi_hal_random_get() {
+    uint32_t random_val;
+    furi_hal_random_fill_buf((uint8_t*)&random_val, sizeof(random_val));
+    return random_val;
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    while(len) {
+        ssize_t got = getrandom(buf, len, 0);
+        if(got < 0) {
+            furi_crash("RNG error");
+        }
+        buf += got;
+        len -= got;
+    }
+}
@@ -0,0 +1,4 @@
+#include <furi_hal_resources.h>
+
+const GpioPin gpio_display_rst = {.pin = 0};
+const GpioPin gpio_display_di = {.pin = 1};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <furi_hal_gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Display pins, writes are dropped */
+extern const GpioPin gpio_display_rst;
+extern const GpioPin gpio_display_di;
+
+#ifdef __cplusplus
+}
+#endif
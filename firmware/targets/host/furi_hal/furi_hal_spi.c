@@ -0,0 +1,79 @@
+#include <furi_hal_spi.h>
+#include <furi.h>
+
+FuriHalSpiBusHandle furi_hal_spi_bus_handle_display = {
+    .speed = 4000000,
+};
+
+void furi_hal_spi_init() {
+}
+
+void furi_hal_spi_acquire(FuriHalSpiBusHandle* handle) {
+    FURI_CRITICAL_ENTER();
+    furi_check(!handle->acquired);
+    handle->acquired = true;
+    handle->stats.acquires++;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_spi_release(FuriHalSpiBusHandle* handle) {
+    FURI_CRITICAL_ENTER();
+    furi_check(handle->acquired);
+    handle->acquired = false;
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_spi_get_stats(FuriHalSpiBusHandle* handle, FuriHalSpiStats* stats) {
+    *stats = handle->stats;
+}
+
+void furi_hal_spi_reset_stats(FuriHalSpiBusHandle* handle) {
+    memset(&handle->stats, 0, sizeof(FuriHalSpiStats));
+}
+
+static void furi_hal_spi_account(FuriHalSpiBusHandle* handle, size_t size) {
+    furi_check(handle->acquired);
+    handle->stats.transfers++;
+    handle->stats.bytes += size;
+    handle->stats.bus_time_us += (uint64_t)size * 8 * 1000000 / handle->speed;
+}
+
+bool furi_hal_spi_bus_rx(
+    FuriHalSpiBusHandle* handle,
+    uint8_t* buffer,
+    size_t size,
+    uint32_t timeout) {
+    furi_assert(buffer);
+    furi_assert(size > 0);
+
+    furi_hal_spi_account(handle, size);
+    memset(buffer, 0xFF, size);
+    return true;
+}
+
+bool furi_hal_spi_bus_tx(
+    FuriHalSpiBusHandle* handle,
+    uint8_t* buffer,
+    size_t size,
+    uint32_t timeout) {
+    furi_assert(buffer);
+    furi_assert(size > 0);
+
+    furi_hal_spi_account(handle, size);
+    return true;
+}
+
+bool furi_hal_spi_bus_trx(
+    FuriHalSpiBusHandle* handle,
+    uint8_t* tx_buffer,
+    uint8_t* rx_buffer,
+    size_t size,
+    uint32_t timeout) {
+    furi_assert(tx_buffer);
+    furi_assert(rx_buffer);
+    furi_assert(size > 0);
+
+    furi_hal_spi_account(handle, size);
+    memset(rx_buffer, 0xFF, size);
+    return true;
+}
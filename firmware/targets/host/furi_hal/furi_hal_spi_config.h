@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Host has no SPI controller, transmitted bytes are dropped and received bytes
+ * read as 0xFF, as on a bus with nothing behind it. Bus statistics count
+ * transfers and their time on the wire, so drivers can be measured by traffic.
+ */
+
+typedef struct {
+    uint32_t acquires; /**< bus lock, preset and CS switch on device */
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t bus_time_us; /**< time on the wire at handle speed */
+} FuriHalSpiStats;
+
+typedef struct FuriHalSpiBus FuriHalSpiBus;
+
+typedef struct {
+    /** Clock, Hz */
+    uint32_t speed;
+    bool acquired;
+    FuriHalSpiStats stats;
+} FuriHalSpiBusHandle;
+
+/** ST7567(Display), 4MHz */
+extern FuriHalSpiBusHandle furi_hal_spi_bus_handle_display;
+
+/** Get bus statistics since the last reset. Host only */
+void furi_hal_spi_get_stats(FuriHalSpiBusHandle* handle, FuriHalSpiStats* stats);
+
+/** Reset bus statistics. Host only */
+void furi_hal_spi_reset_stats(FuriHalSpiBusHandle* handle);
+
+#ifdef __cplusplus
+}
+#endif
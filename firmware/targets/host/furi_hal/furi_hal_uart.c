@@ -0,0 +1,124 @@
+#include <furi_hal_uart.h>
+#include <firmware/targets/f7/furi_hal/furi_hal_uart_dma_rx.h>
+#include <stdbool.h>
+
+#include <furi.h>
+
+/* Loopback model: TX line of each channel is wired to its own RX line.
+ * Transmitted bytes go either into per byte RX interrupt or into circular DMA
+ * buffer with transfer counter, half/full transfer and idle line events, in
+ * the same order as on device. Events are delivered on the caller thread. */
+
+typedef struct {
+    bool enabled;
+    bool rxne_it;
+    bool idle_it;
+    /** DMA transfer counter, bytes left till the buffer end */
+    size_t dma_remaining;
+} FuriHalUartLoopback;
+
+static void (*irq_cb[2])(UartIrqEvent ev, uint8_t data, void* context);
+static void* irq_ctx[2];
+
+static FuriHalUartDmaRx dma_rx[2];
+static FuriHalUartLoopback loopback[2];
+
+void furi_hal_uart_init(FuriHalUartId ch, uint32_t baud) {
+    UNUSED(baud);
+    loopback[ch].enabled = true;
+    loopback[ch].rxne_it = true;
+    loopback[ch].idle_it = true;
+}
+
+void furi_hal_uart_set_br(FuriHalUartId ch, uint32_t baud) {
+    UNUSED(ch);
+    UNUSED(baud);
+}
+
+void furi_hal_uart_deinit(FuriHalUartId ch) {
+    furi_hal_uart_set_irq_cb(ch, NULL, NULL);
+    loopback[ch].enabled = false;
+    loopback[ch].rxne_it = false;
+    loopback[ch].idle_it = false;
+}
+
+static void furi_hal_uart_dma_rx_process(FuriHalUartId ch) {
+    furi_hal_uart_dma_rx_process_remaining(&dma_rx[ch], loopback[ch].dma_remaining);
+}
+
+static void furi_hal_uart_loopback_rx(FuriHalUartId ch, uint8_t data) {
+    FuriHalUartDmaRx* rx = &dma_rx[ch];
+    if(rx->callback) {
+        rx->buffer[rx->size - loopback[ch].dma_remaining] = data;
+        loopback[ch].dma_remaining--;
+        if(loopback[ch].dma_remaining == rx->size / 2) {
+            furi_hal_uart_dma_rx_process(ch);
+        } else if(loopback[ch].dma_remaining == 0) {
+            // Circular mode reloads the counter before transfer complete is serviced
+            loopback[ch].dma_remaining = rx->size;
+            furi_hal_uart_dma_rx_process(ch);
+        }
+    } else if(loopback[ch].rxne_it && irq_cb[ch]) {
+        irq_cb[ch](UartIrqEventRXNE, data, irq_ctx[ch]);
+    }
+}
+
+void furi_hal_uart_tx(FuriHalUartId ch, uint8_t* buffer, size_t buffer_size) {
+    if(!loopback[ch].enabled) return;
+
+    for(size_t i = 0; i < buffer_size; i++) {
+        furi_hal_uart_loopback_rx(ch, buffer[i]);
+    }
+
+    // Line goes idle after every transfer
+    if(!buffer_size || !loopback[ch].idle_it) return;
+    if(dma_rx[ch].callback) {
+        furi_hal_uart_dma_rx_process(ch);
+    } else if(irq_cb[ch]) {
+        irq_cb[ch](UartIrqEventIDLE, 0, irq_ctx[ch]);
+    }
+}
+
+void furi_hal_uart_set_irq_cb(
+    FuriHalUartId ch,
+    void (*cb)(UartIrqEvent ev, uint8_t data, void* ctx),
+    void* ctx) {
+    irq_ctx[ch] = ctx;
+    irq_cb[ch] = cb;
+}
+
+void furi_hal_uart_dma_rx_start(
+    FuriHalUartId ch,
+    uint8_t* buffer,
+    size_t buffer_size,
+    FuriHalUartDmaRxCallback callback,
+    void* context) {
+    furi_assert(buffer);
+    furi_assert(buffer_size > 1);
+    furi_assert(callback);
+    furi_assert(dma_rx[ch].callback == NULL);
+
+    dma_rx[ch].buffer = buffer;
+    dma_rx[ch].size = buffer_size;
+    dma_rx[ch].pos = 0;
+    dma_rx[ch].context = context;
+    dma_rx[ch].callback = callback;
+    loopback[ch].dma_remaining = buffer_size;
+
+    dma_rx[ch].rxne_enabled = loopback[ch].rxne_it;
+    dma_rx[ch].idle_enabled = loopback[ch].idle_it;
+    loopback[ch].rxne_it = false;
+    loopback[ch].idle_it = true;
+}
+
+void furi_hal_uart_dma_rx_stop(FuriHalUartId ch) {
+    furi_assert(dma_rx[ch].callback);
+
+    loopback[ch].idle_it = dma_rx[ch].idle_enabled;
+
+    dma_rx[ch].callback = NULL;
+    dma_rx[ch].context = NULL;
+    dma_rx[ch].buffer = NULL;
+
+    loopback[ch].rxne_it = dma_rx[ch].rxne_enabled;
+}
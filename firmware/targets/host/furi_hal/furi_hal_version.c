@@ -0,0 +1,6 @@
+#include <furi_hal_version.h>
+
+// Host has no OTP, drivers take defaults for unknown hardware
+const FuriHalVersionDisplay furi_hal_version_get_hw_display() {
+    return FuriHalVersionDisplayUnknown;
+}
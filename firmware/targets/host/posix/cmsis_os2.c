@@ -0,0 +1,1078 @@
+#include "host_os_i.h"
+
+#include <cmsis_os2.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <timers.h>
+
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * CMSIS-RTOS2 over pthreads.
+ * Every kernel object is a mutex and condition variable pair, ticks are milliseconds of
+ * monotonic clock. Priorities are stored but not used, every timer runs callbacks on its own
+ * thread. Memory pools, suspend and terminate of other threads are not available: libs built
+ * for host don't use them.
+ */
+
+#define HOST_OS_NS_IN_S 1000000000L
+#define HOST_OS_NS_IN_TICK (HOST_OS_NS_IN_S / configTICK_RATE_HZ)
+
+typedef struct HostThread HostThread;
+
+struct HostThread {
+    pthread_t pthread;
+    char* name;
+    osThreadFunc_t func;
+    void* argument;
+    osPriority_t priority;
+    bool joinable;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t flags;
+
+    HostThread* next;
+};
+
+typedef struct {
+    const char* name;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t flags;
+} HostEventFlags;
+
+typedef struct {
+    const char* name;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    HostThread* owner;
+    uint32_t lock_count;
+    bool recursive;
+} HostMutex;
+
+typedef struct {
+    const char* name;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max_count;
+} HostSemaphore;
+
+typedef struct {
+    const char* name;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint8_t* buffer;
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t head;
+    uint32_t count;
+} HostMessageQueue;
+
+typedef struct {
+    const char* name;
+    pthread_t pthread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    osTimerFunc_t func;
+    void* argument;
+    bool periodic;
+    bool active;
+    bool deleted;
+    uint32_t period;
+    struct timespec deadline;
+} HostTimer;
+
+static struct timespec host_os_start;
+static pthread_once_t host_os_start_once = PTHREAD_ONCE_INIT;
+static osKernelState_t host_os_state = osKernelInactive;
+
+/** Scheduler lock and critical section: one lock, nesting is tracked per thread */
+static pthread_mutex_t host_os_critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static __thread uint32_t host_os_critical_nesting = 0;
+
+/** All threads known to kernel, including adopted foreign threads like main */
+static pthread_mutex_t host_os_threads_mutex = PTHREAD_MUTEX_INITIALIZER;
+static HostThread* host_os_threads = NULL;
+static __thread HostThread* host_thread_self = NULL;
+
+static void host_os_start_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &host_os_start);
+}
+
+static uint64_t host_os_elapsed_ns(void) {
+    pthread_once(&host_os_start_once, host_os_start_init);
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - host_os_start.tv_sec) * HOST_OS_NS_IN_S + now.tv_nsec -
+           host_os_start.tv_nsec;
+}
+
+void host_os_cond_init(pthread_cond_t* cond) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+void host_os_deadline(uint32_t timeout, struct timespec* deadline) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    if(timeout == osWaitForever) return;
+
+    deadline->tv_sec += timeout / configTICK_RATE_HZ;
+    deadline->tv_nsec += (long)(timeout % configTICK_RATE_HZ) * HOST_OS_NS_IN_TICK;
+    if(deadline->tv_nsec >= HOST_OS_NS_IN_S) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= HOST_OS_NS_IN_S;
+    }
+}
+
+bool host_os_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    uint32_t timeout,
+    const struct timespec* deadline) {
+    if(timeout == osWaitForever) {
+        pthread_cond_wait(cond, mutex);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, mutex, deadline) != ETIMEDOUT;
+}
+
+static void host_os_mutex_init(pthread_mutex_t* mutex) {
+    pthread_mutex_init(mutex, NULL);
+}
+
+/** Wait for flags, shared by thread and event flags. Caller checks parameters. */
+static uint32_t host_os_flags_wait(
+    uint32_t* value,
+    pthread_mutex_t* mutex,
+    pthread_cond_t* cond,
+    uint32_t flags,
+    uint32_t options,
+    uint32_t timeout) {
+    struct timespec deadline;
+    host_os_deadline(timeout, &deadline);
+
+    pthread_mutex_lock(mutex);
+    bool expired = false;
+    uint32_t rflags;
+    while(true) {
+        rflags = *value;
+        bool ready = (options & osFlagsWaitAll) ? ((rflags & flags) == flags) :
+                                                  ((rflags & flags) != 0);
+        if(ready) {
+            if(!(options & osFlagsNoClear)) *value &= ~flags;
+            break;
+        } else if(timeout == 0) {
+            rflags = osFlagsErrorResource;
+            break;
+        } else if(expired) {
+            rflags = osFlagsErrorTimeout;
+            break;
+        }
+        expired = !host_os_cond_wait(cond, mutex, timeout, &deadline);
+    }
+    pthread_mutex_unlock(mutex);
+
+    return rflags;
+}
+
+/* Kernel */
+
+osStatus_t osKernelInitialize(void) {
+    pthread_once(&host_os_start_once, host_os_start_init);
+    if(host_os_state != osKernelInactive) return osError;
+    host_os_state = osKernelReady;
+    return osOK;
+}
+
+osStatus_t osKernelGetInfo(osVersion_t* version, char* id_buf, uint32_t id_size) {
+    if(version) {
+        version->api = 20010003U;
+        version->kernel = 0U;
+    }
+    if(id_buf && id_size) {
+        strncpy(id_buf, "POSIX threads", id_size - 1);
+        id_buf[id_size - 1] = '\0';
+    }
+    return osOK;
+}
+
+osKernelState_t osKernelGetState(void) {
+    return host_os_state;
+}
+
+/** Unlike the device, returns: calling thread carries on as one of the kernel threads */
+osStatus_t osKernelStart(void) {
+    if(host_os_state != osKernelReady) return osError;
+    host_os_state = osKernelRunning;
+    return osOK;
+}
+
+int32_t osKernelLock(void) {
+    int32_t lock = (host_os_critical_nesting > 0);
+    vTaskSuspendAll();
+    return lock;
+}
+
+int32_t osKernelUnlock(void) {
+    if(host_os_critical_nesting == 0) return 0;
+    xTaskResumeAll();
+    return 1;
+}
+
+int32_t osKernelRestoreLock(int32_t lock) {
+    if(lock && host_os_critical_nesting == 0) {
+        vTaskSuspendAll();
+    } else if(!lock && host_os_critical_nesting > 0) {
+        xTaskResumeAll();
+    }
+    return lock;
+}
+
+uint32_t osKernelSuspend(void) {
+    return 0U;
+}
+
+void osKernelResume(uint32_t sleep_ticks) {
+    (void)sleep_ticks;
+}
+
+uint32_t osKernelGetTickCount(void) {
+    return (uint32_t)(host_os_elapsed_ns() / HOST_OS_NS_IN_TICK);
+}
+
+uint32_t osKernelGetTickFreq(void) {
+    return configTICK_RATE_HZ;
+}
+
+uint32_t osKernelGetSysTimerCount(void) {
+    return (uint32_t)(host_os_elapsed_ns() / 1000U);
+}
+
+uint32_t osKernelGetSysTimerFreq(void) {
+    return 1000000U;
+}
+
+void vTaskSuspendAll(void) {
+    pthread_mutex_lock(&host_os_critical);
+    host_os_critical_nesting++;
+}
+
+BaseType_t xTaskResumeAll(void) {
+    host_os_critical_nesting--;
+    pthread_mutex_unlock(&host_os_critical);
+    return pdFALSE;
+}
+
+void vPortEnterCritical(void) {
+    vTaskSuspendAll();
+}
+
+void vPortExitCritical(void) {
+    xTaskResumeAll();
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return osKernelGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return osThreadGetId();
+}
+
+/* Threads */
+
+static HostThread* host_thread_alloc(const char* name) {
+    HostThread* thread = malloc(sizeof(HostThread));
+    memset(thread, 0, sizeof(HostThread));
+    thread->name = name ? strdup(name) : NULL;
+    thread->priority = osPriorityNormal;
+    host_os_mutex_init(&thread->mutex);
+    host_os_cond_init(&thread->cond);
+
+    pthread_mutex_lock(&host_os_threads_mutex);
+    thread->next = host_os_threads;
+    host_os_threads = thread;
+    pthread_mutex_unlock(&host_os_threads_mutex);
+
+    return thread;
+}
+
+static void host_thread_free(HostThread* thread) {
+    pthread_mutex_lock(&host_os_threads_mutex);
+    for(HostThread** item = &host_os_threads; *item; item = &(*item)->next) {
+        if(*item == thread) {
+            *item = thread->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&host_os_threads_mutex);
+
+    pthread_cond_destroy(&thread->cond);
+    pthread_mutex_destroy(&thread->mutex);
+    free(thread->name);
+    free(thread);
+}
+
+/** Current thread, threads not created by kernel are adopted on first use */
+static HostThread* host_thread_current(void) {
+    if(host_thread_self == NULL) {
+        host_thread_self = host_thread_alloc(NULL);
+        host_thread_self->pthread = pthread_self();
+    }
+    return host_thread_self;
+}
+
+static void* host_thread_body(void* context) {
+    HostThread* thread = context;
+    host_thread_self = thread;
+    thread->func(thread->argument);
+    osThreadExit();
+    return NULL;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void* argument, const osThreadAttr_t* attr) {
+    if(func == NULL) return NULL;
+
+    HostThread* thread = host_thread_alloc(attr ? attr->name : NULL);
+    thread->func = func;
+    thread->argument = argument;
+    thread->joinable = attr && (attr->attr_bits & osThreadJoinable);
+    if(attr && attr->priority != osPriorityNone) thread->priority = attr->priority;
+
+    // stack size is a hint for 32 bit target, host threads get default stack
+    pthread_attr_t pthread_attr;
+    pthread_attr_init(&pthread_attr);
+    if(!thread->joinable) {
+        pthread_attr_setdetachstate(&pthread_attr, PTHREAD_CREATE_DETACHED);
+    }
+    int result = pthread_create(&thread->pthread, &pthread_attr, host_thread_body, thread);
+    pthread_attr_destroy(&pthread_attr);
+
+    if(result != 0) {
+        host_thread_free(thread);
+        return NULL;
+    }
+    return thread;
+}
+
+const char* osThreadGetName(osThreadId_t thread_id) {
+    HostThread* thread = thread_id;
+    return thread ? thread->name : NULL;
+}
+
+osThreadId_t osThreadGetId(void) {
+    return host_thread_current();
+}
+
+osThreadState_t osThreadGetState(osThreadId_t thread_id) {
+    if(thread_id == NULL) return osThreadError;
+    return (thread_id == host_thread_self) ? osThreadRunning : osThreadReady;
+}
+
+uint32_t osThreadGetStackSize(osThreadId_t thread_id) {
+    (void)thread_id;
+    return 0U;
+}
+
+uint32_t osThreadGetStackSpace(osThreadId_t thread_id) {
+    (void)thread_id;
+    return 0U;
+}
+
+osStatus_t osThreadSetPriority(osThreadId_t thread_id, osPriority_t priority) {
+    HostThread* thread = thread_id;
+    if(thread == NULL || priority < osPriorityIdle || priority > osPriorityISR) {
+        return osErrorParameter;
+    }
+    thread->priority = priority;
+    return osOK;
+}
+
+osPriority_t osThreadGetPriority(osThreadId_t thread_id) {
+    HostThread* thread = thread_id;
+    return thread ? thread->priority : osPriorityError;
+}
+
+osStatus_t osThreadYield(void) {
+    sched_yield();
+    return osOK;
+}
+
+osStatus_t osThreadSuspend(osThreadId_t thread_id) {
+    (void)thread_id;
+    return osErrorResource;
+}
+
+osStatus_t osThreadResume(osThreadId_t thread_id) {
+    (void)thread_id;
+    return osErrorResource;
+}
+
+osStatus_t osThreadDetach(osThreadId_t thread_id) {
+    HostThread* thread = thread_id;
+    if(thread == NULL) return osErrorParameter;
+    if(!thread->joinable) return osErrorResource;
+
+    thread->joinable = false;
+    pthread_detach(thread->pthread);
+    return osOK;
+}
+
+osStatus_t osThreadJoin(osThreadId_t thread_id) {
+    HostThread* thread = thread_id;
+    if(thread == NULL) return osErrorParameter;
+    if(!thread->joinable || thread == host_thread_self) return osErrorResource;
+
+    pthread_join(thread->pthread, NULL);
+    host_thread_free(thread);
+    return osOK;
+}
+
+__NO_RETURN void osThreadExit(void) {
+    HostThread* thread = host_thread_self;
+    host_thread_self = NULL;
+    if(thread && !thread->joinable) {
+        host_thread_free(thread);
+    }
+    pthread_exit(NULL);
+}
+
+/** Other thread can't be stopped safely with pthreads, thread must return by itself */
+osStatus_t osThreadTerminate(osThreadId_t thread_id) {
+    if(thread_id == NULL) return osErrorParameter;
+    if(thread_id == host_thread_self) osThreadExit();
+    return osErrorResource;
+}
+
+uint32_t osThreadGetCount(void) {
+    uint32_t count = 0;
+    pthread_mutex_lock(&host_os_threads_mutex);
+    for(HostThread* thread = host_os_threads; thread; thread = thread->next) {
+        count++;
+    }
+    pthread_mutex_unlock(&host_os_threads_mutex);
+    return count;
+}
+
+uint32_t osThreadEnumerate(osThreadId_t* thread_array, uint32_t array_items) {
+    if(thread_array == NULL || array_items == 0U) return 0U;
+
+    uint32_t count = 0;
+    pthread_mutex_lock(&host_os_threads_mutex);
+    for(HostThread* thread = host_os_threads; thread && count < array_items;
+        thread = thread->next) {
+        thread_array[count++] = thread;
+    }
+    pthread_mutex_unlock(&host_os_threads_mutex);
+    return count;
+}
+
+/* Thread flags */
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+    HostThread* thread = thread_id;
+    if(thread == NULL || (flags & osFlagsError)) return osFlagsErrorParameter;
+
+    pthread_mutex_lock(&thread->mutex);
+    thread->flags |= flags;
+    uint32_t rflags = thread->flags;
+    pthread_cond_broadcast(&thread->cond);
+    pthread_mutex_unlock(&thread->mutex);
+
+    return rflags;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags) {
+    if(flags & osFlagsError) return osFlagsErrorParameter;
+    HostThread* thread = host_thread_current();
+
+    pthread_mutex_lock(&thread->mutex);
+    uint32_t rflags = thread->flags;
+    thread->flags &= ~flags;
+    pthread_mutex_unlock(&thread->mutex);
+
+    return rflags;
+}
+
+uint32_t osThreadFlagsGet(void) {
+    HostThread* thread = host_thread_current();
+
+    pthread_mutex_lock(&thread->mutex);
+    uint32_t rflags = thread->flags;
+    pthread_mutex_unlock(&thread->mutex);
+
+    return rflags;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    if(flags & osFlagsError) return osFlagsErrorParameter;
+    HostThread* thread = host_thread_current();
+    return host_os_flags_wait(
+        &thread->flags, &thread->mutex, &thread->cond, flags, options, timeout);
+}
+
+/* Delay */
+
+osStatus_t osDelay(uint32_t ticks) {
+    if(ticks != 0U) {
+        struct timespec deadline;
+        host_os_deadline(ticks, &deadline);
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR)
+            ;
+    }
+    return osOK;
+}
+
+osStatus_t osDelayUntil(uint32_t ticks) {
+    uint32_t delay = ticks - osKernelGetTickCount();
+    if(delay == 0U || delay >= 0x7FFFFFFFU) return osErrorParameter;
+    return osDelay(delay);
+}
+
+/* Timers */
+
+static bool host_timer_expired(HostTimer* timer) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > timer->deadline.tv_sec ||
+           (now.tv_sec == timer->deadline.tv_sec && now.tv_nsec >= timer->deadline.tv_nsec);
+}
+
+/** Timer thread owns timer memory, so timer can be deleted from its own callback */
+static void* host_timer_body(void* context) {
+    HostTimer* timer = context;
+
+    pthread_mutex_lock(&timer->mutex);
+    while(!timer->deleted) {
+        if(!timer->active) {
+            pthread_cond_wait(&timer->cond, &timer->mutex);
+        } else if(!host_timer_expired(timer)) {
+            pthread_cond_timedwait(&timer->cond, &timer->mutex, &timer->deadline);
+        } else {
+            if(timer->periodic) {
+                host_os_deadline(timer->period, &timer->deadline);
+            } else {
+                timer->active = false;
+            }
+            pthread_mutex_unlock(&timer->mutex);
+            timer->func(timer->argument);
+            pthread_mutex_lock(&timer->mutex);
+        }
+    }
+    pthread_mutex_unlock(&timer->mutex);
+
+    pthread_cond_destroy(&timer->cond);
+    pthread_mutex_destroy(&timer->mutex);
+    free(timer);
+    return NULL;
+}
+
+osTimerId_t
+    osTimerNew(osTimerFunc_t func, osTimerType_t type, void* argument, const osTimerAttr_t* attr) {
+    if(func == NULL) return NULL;
+
+    HostTimer* timer = malloc(sizeof(HostTimer));
+    memset(timer, 0, sizeof(HostTimer));
+    timer->name = attr ? attr->name : NULL;
+    host_os_mutex_init(&timer->mutex);
+    host_os_cond_init(&timer->cond);
+    timer->func = func;
+    timer->argument = argument;
+    timer->periodic = (type == osTimerPeriodic);
+
+    pthread_attr_t pthread_attr;
+    pthread_attr_init(&pthread_attr);
+    pthread_attr_setdetachstate(&pthread_attr, PTHREAD_CREATE_DETACHED);
+    int result = pthread_create(&timer->pthread, &pthread_attr, host_timer_body, timer);
+    pthread_attr_destroy(&pthread_attr);
+
+    if(result != 0) {
+        pthread_cond_destroy(&timer->cond);
+        pthread_mutex_destroy(&timer->mutex);
+        free(timer);
+        return NULL;
+    }
+    return timer;
+}
+
+const char* osTimerGetName(osTimerId_t timer_id) {
+    HostTimer* timer = timer_id;
+    return timer ? timer->name : NULL;
+}
+
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks) {
+    HostTimer* timer = timer_id;
+    if(timer == NULL || ticks == 0U) return osErrorParameter;
+
+    pthread_mutex_lock(&timer->mutex);
+    timer->period = ticks;
+    timer->active = true;
+    host_os_deadline(ticks, &timer->deadline);
+    pthread_cond_signal(&timer->cond);
+    pthread_mutex_unlock(&timer->mutex);
+
+    return osOK;
+}
+
+osStatus_t osTimerStop(osTimerId_t timer_id) {
+    HostTimer* timer = timer_id;
+    if(timer == NULL) return osErrorParameter;
+
+    osStatus_t status = osOK;
+    pthread_mutex_lock(&timer->mutex);
+    if(!timer->active) {
+        status = osErrorResource;
+    } else {
+        timer->active = false;
+        pthread_cond_signal(&timer->cond);
+    }
+    pthread_mutex_unlock(&timer->mutex);
+
+    return status;
+}
+
+uint32_t osTimerIsRunning(osTimerId_t timer_id) {
+    HostTimer* timer = timer_id;
+    if(timer == NULL) return 0U;
+
+    pthread_mutex_lock(&timer->mutex);
+    bool active = timer->active;
+    pthread_mutex_unlock(&timer->mutex);
+
+    return active;
+}
+
+osStatus_t osTimerDelete(osTimerId_t timer_id) {
+    HostTimer* timer = timer_id;
+    if(timer == NULL) return osErrorParameter;
+
+    pthread_mutex_lock(&timer->mutex);
+    timer->active = false;
+    timer->deleted = true;
+    pthread_cond_signal(&timer->cond);
+    pthread_mutex_unlock(&timer->mutex);
+
+    return osOK;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t block_time) {
+    (void)block_time;
+    return (osTimerStart(timer, period) == osOK) ? pdPASS : pdFAIL;
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t block_time) {
+    (void)block_time;
+    // FreeRTOS accepts stop of dormant timer
+    osTimerStop(timer);
+    return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer) {
+    return osTimerIsRunning(timer) ? pdTRUE : pdFALSE;
+}
+
+/* Event flags */
+
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t* attr) {
+    HostEventFlags* event_flags = malloc(sizeof(HostEventFlags));
+    event_flags->name = attr ? attr->name : NULL;
+    host_os_mutex_init(&event_flags->mutex);
+    host_os_cond_init(&event_flags->cond);
+    event_flags->flags = 0;
+    return event_flags;
+}
+
+const char* osEventFlagsGetName(osEventFlagsId_t ef_id) {
+    HostEventFlags* event_flags = ef_id;
+    return event_flags ? event_flags->name : NULL;
+}
+
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags) {
+    HostEventFlags* event_flags = ef_id;
+    if(event_flags == NULL || (flags & osFlagsError)) return osFlagsErrorParameter;
+
+    pthread_mutex_lock(&event_flags->mutex);
+    event_flags->flags |= flags;
+    uint32_t rflags = event_flags->flags;
+    pthread_cond_broadcast(&event_flags->cond);
+    pthread_mutex_unlock(&event_flags->mutex);
+
+    return rflags;
+}
+
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags) {
+    HostEventFlags* event_flags = ef_id;
+    if(event_flags == NULL || (flags & osFlagsError)) return osFlagsErrorParameter;
+
+    pthread_mutex_lock(&event_flags->mutex);
+    uint32_t rflags = event_flags->flags;
+    event_flags->flags &= ~flags;
+    pthread_mutex_unlock(&event_flags->mutex);
+
+    return rflags;
+}
+
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id) {
+    HostEventFlags* event_flags = ef_id;
+    if(event_flags == NULL) return 0U;
+
+    pthread_mutex_lock(&event_flags->mutex);
+    uint32_t rflags = event_flags->flags;
+    pthread_mutex_unlock(&event_flags->mutex);
+
+    return rflags;
+}
+
+uint32_t
+    osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout) {
+    HostEventFlags* event_flags = ef_id;
+    if(event_flags == NULL || (flags & osFlagsError)) return osFlagsErrorParameter;
+    return host_os_flags_wait(
+        &event_flags->flags, &event_flags->mutex, &event_flags->cond, flags, options, timeout);
+}
+
+osStatus_t osEventFlagsDelete(osEventFlagsId_t ef_id) {
+    HostEventFlags* event_flags = ef_id;
+    if(event_flags == NULL) return osErrorParameter;
+
+    pthread_cond_destroy(&event_flags->cond);
+    pthread_mutex_destroy(&event_flags->mutex);
+    free(event_flags);
+    return osOK;
+}
+
+/* Mutex */
+
+osMutexId_t osMutexNew(const osMutexAttr_t* attr) {
+    HostMutex* mutex = malloc(sizeof(HostMutex));
+    mutex->name = attr ? attr->name : NULL;
+    host_os_mutex_init(&mutex->mutex);
+    host_os_cond_init(&mutex->cond);
+    mutex->owner = NULL;
+    mutex->lock_count = 0;
+    mutex->recursive = attr && (attr->attr_bits & osMutexRecursive);
+    return mutex;
+}
+
+const char* osMutexGetName(osMutexId_t mutex_id) {
+    HostMutex* mutex = mutex_id;
+    return mutex ? mutex->name : NULL;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout) {
+    HostMutex* mutex = mutex_id;
+    if(mutex == NULL) return osErrorParameter;
+    HostThread* self = host_thread_current();
+
+    struct timespec deadline;
+    host_os_deadline(timeout, &deadline);
+
+    osStatus_t status = osOK;
+    pthread_mutex_lock(&mutex->mutex);
+    if(mutex->recursive && mutex->owner == self) {
+        mutex->lock_count++;
+    } else {
+        bool expired = false;
+        while(mutex->owner != NULL) {
+            if(timeout == 0U) {
+                status = osErrorResource;
+                break;
+            } else if(expired) {
+                status = osErrorTimeout;
+                break;
+            }
+            expired = !host_os_cond_wait(&mutex->cond, &mutex->mutex, timeout, &deadline);
+        }
+        if(status == osOK) {
+            mutex->owner = self;
+            mutex->lock_count = 1;
+        }
+    }
+    pthread_mutex_unlock(&mutex->mutex);
+
+    return status;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id) {
+    HostMutex* mutex = mutex_id;
+    if(mutex == NULL) return osErrorParameter;
+
+    osStatus_t status = osOK;
+    pthread_mutex_lock(&mutex->mutex);
+    if(mutex->owner != host_thread_self || mutex->owner == NULL) {
+        status = osErrorResource;
+    } else if(--mutex->lock_count == 0) {
+        mutex->owner = NULL;
+        pthread_cond_signal(&mutex->cond);
+    }
+    pthread_mutex_unlock(&mutex->mutex);
+
+    return status;
+}
+
+osThreadId_t osMutexGetOwner(osMutexId_t mutex_id) {
+    HostMutex* mutex = mutex_id;
+    if(mutex == NULL) return NULL;
+
+    pthread_mutex_lock(&mutex->mutex);
+    HostThread* owner = mutex->owner;
+    pthread_mutex_unlock(&mutex->mutex);
+
+    return owner;
+}
+
+osStatus_t osMutexDelete(osMutexId_t mutex_id) {
+    HostMutex* mutex = mutex_id;
+    if(mutex == NULL) return osErrorParameter;
+
+    pthread_cond_destroy(&mutex->cond);
+    pthread_mutex_destroy(&mutex->mutex);
+    free(mutex);
+    return osOK;
+}
+
+/* Semaphore */
+
+osSemaphoreId_t
+    osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t* attr) {
+    if(max_count == 0U || initial_count > max_count) return NULL;
+
+    HostSemaphore* semaphore = malloc(sizeof(HostSemaphore));
+    semaphore->name = attr ? attr->name : NULL;
+    host_os_mutex_init(&semaphore->mutex);
+    host_os_cond_init(&semaphore->cond);
+    semaphore->count = initial_count;
+    semaphore->max_count = max_count;
+    return semaphore;
+}
+
+const char* osSemaphoreGetName(osSemaphoreId_t semaphore_id) {
+    HostSemaphore* semaphore = semaphore_id;
+    return semaphore ? semaphore->name : NULL;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout) {
+    HostSemaphore* semaphore = semaphore_id;
+    if(semaphore == NULL) return osErrorParameter;
+
+    struct timespec deadline;
+    host_os_deadline(timeout, &deadline);
+
+    osStatus_t status = osOK;
+    bool expired = false;
+    pthread_mutex_lock(&semaphore->mutex);
+    while(semaphore->count == 0U) {
+        if(timeout == 0U) {
+            status = osErrorResource;
+            break;
+        } else if(expired) {
+            status = osErrorTimeout;
+            break;
+        }
+        expired = !host_os_cond_wait(&semaphore->cond, &semaphore->mutex, timeout, &deadline);
+    }
+    if(status == osOK) semaphore->count--;
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return status;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id) {
+    HostSemaphore* semaphore = semaphore_id;
+    if(semaphore == NULL) return osErrorParameter;
+
+    osStatus_t status = osOK;
+    pthread_mutex_lock(&semaphore->mutex);
+    if(semaphore->count == semaphore->max_count) {
+        status = osErrorResource;
+    } else {
+        semaphore->count++;
+        pthread_cond_signal(&semaphore->cond);
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return status;
+}
+
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id) {
+    HostSemaphore* semaphore = semaphore_id;
+    if(semaphore == NULL) return 0U;
+
+    pthread_mutex_lock(&semaphore->mutex);
+    uint32_t count = semaphore->count;
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return count;
+}
+
+osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id) {
+    HostSemaphore* semaphore = semaphore_id;
+    if(semaphore == NULL) return osErrorParameter;
+
+    pthread_cond_destroy(&semaphore->cond);
+    pthread_mutex_destroy(&semaphore->mutex);
+    free(semaphore);
+    return osOK;
+}
+
+/* Message queue, priority is ignored as in FreeRTOS glue */
+
+osMessageQueueId_t
+    osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t* attr) {
+    if(msg_count == 0U || msg_size == 0U) return NULL;
+
+    HostMessageQueue* queue = malloc(sizeof(HostMessageQueue));
+    queue->name = attr ? attr->name : NULL;
+    host_os_mutex_init(&queue->mutex);
+    host_os_cond_init(&queue->not_empty);
+    host_os_cond_init(&queue->not_full);
+    queue->buffer = malloc((size_t)msg_count * msg_size);
+    queue->msg_count = msg_count;
+    queue->msg_size = msg_size;
+    queue->head = 0;
+    queue->count = 0;
+    return queue;
+}
+
+const char* osMessageQueueGetName(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    return queue ? queue->name : NULL;
+}
+
+osStatus_t osMessageQueuePut(
+    osMessageQueueId_t mq_id,
+    const void* msg_ptr,
+    uint8_t msg_prio,
+    uint32_t timeout) {
+    (void)msg_prio;
+    HostMessageQueue* queue = mq_id;
+    if(queue == NULL || msg_ptr == NULL) return osErrorParameter;
+
+    struct timespec deadline;
+    host_os_deadline(timeout, &deadline);
+
+    osStatus_t status = osOK;
+    bool expired = false;
+    pthread_mutex_lock(&queue->mutex);
+    while(queue->count == queue->msg_count) {
+        if(timeout == 0U) {
+            status = osErrorResource;
+            break;
+        } else if(expired) {
+            status = osErrorTimeout;
+            break;
+        }
+        expired = !host_os_cond_wait(&queue->not_full, &queue->mutex, timeout, &deadline);
+    }
+    if(status == osOK) {
+        uint32_t tail = (queue->head + queue->count) % queue->msg_count;
+        memcpy(&queue->buffer[(size_t)tail * queue->msg_size], msg_ptr, queue->msg_size);
+        queue->count++;
+        pthread_cond_signal(&queue->not_empty);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return status;
+}
+
+osStatus_t osMessageQueueGet(
+    osMessageQueueId_t mq_id,
+    void* msg_ptr,
+    uint8_t* msg_prio,
+    uint32_t timeout) {
+    HostMessageQueue* queue = mq_id;
+    if(queue == NULL || msg_ptr == NULL) return osErrorParameter;
+
+    struct timespec deadline;
+    host_os_deadline(timeout, &deadline);
+
+    osStatus_t status = osOK;
+    bool expired = false;
+    pthread_mutex_lock(&queue->mutex);
+    while(queue->count == 0U) {
+        if(timeout == 0U) {
+            status = osErrorResource;
+            break;
+        } else if(expired) {
+            status = osErrorTimeout;
+            break;
+        }
+        expired = !host_os_cond_wait(&queue->not_empty, &queue->mutex, timeout, &deadline);
+    }
+    if(status == osOK) {
+        memcpy(msg_ptr, &queue->buffer[(size_t)queue->head * queue->msg_size], queue->msg_size);
+        queue->head = (queue->head + 1) % queue->msg_count;
+        queue->count--;
+        pthread_cond_signal(&queue->not_full);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    if(msg_prio) *msg_prio = 0U;
+    return status;
+}
+
+uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    return queue ? queue->msg_count : 0U;
+}
+
+uint32_t osMessageQueueGetMsgSize(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    return queue ? queue->msg_size : 0U;
+}
+
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    if(queue == NULL) return 0U;
+
+    pthread_mutex_lock(&queue->mutex);
+    uint32_t count = queue->count;
+    pthread_mutex_unlock(&queue->mutex);
+
+    return count;
+}
+
+uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    if(queue == NULL) return 0U;
+
+    pthread_mutex_lock(&queue->mutex);
+    uint32_t space = queue->msg_count - queue->count;
+    pthread_mutex_unlock(&queue->mutex);
+
+    return space;
+}
+
+osStatus_t osMessageQueueReset(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    if(queue == NULL) return osErrorParameter;
+
+    pthread_mutex_lock(&queue->mutex);
+    queue->head = 0;
+    queue->count = 0;
+    pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return osOK;
+}
+
+osStatus_t osMessageQueueDelete(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    if(queue == NULL) return osErrorParameter;
+
+    pthread_cond_destroy(&queue->not_full);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue->buffer);
+    free(queue);
+    return osOK;
+}
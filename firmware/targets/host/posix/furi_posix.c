@@ -0,0 +1,103 @@
+#include <furi.h>
+#include <furi_hal_console.h>
+
+#include <execinfo.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define FURI_POSIX_BACKTRACE_DEPTH 32
+
+/**
+ * Furi core parts that touch hardware or FreeRTOS heap.
+ * Crash aborts the process so it can be inspected in debugger or core dump,
+ * heap is libc heap and stdout stays libc stdout.
+ */
+
+/** Device heap wipes allocations and code relies on it, malloc is wrapped at link time */
+void* __wrap_malloc(size_t size) {
+    return calloc(1, size);
+}
+
+static void furi_posix_print_name() {
+    const char* name = osThreadGetName(osThreadGetId());
+    furi_hal_console_puts("[");
+    furi_hal_console_puts(name ? name : "main");
+    furi_hal_console_puts("] ");
+}
+
+void furi_crash(const char* message) {
+    if(message == NULL) {
+        message = "Fatal Error";
+    }
+
+    furi_hal_console_puts("\r\n\033[0;31m[CRASH]");
+    furi_posix_print_name();
+    furi_hal_console_puts(message);
+    furi_hal_console_puts("\033[0m\r\n");
+
+    void* backtrace_buffer[FURI_POSIX_BACKTRACE_DEPTH];
+    int depth = backtrace(backtrace_buffer, FURI_POSIX_BACKTRACE_DEPTH);
+    backtrace_symbols_fd(backtrace_buffer, depth, STDERR_FILENO);
+    abort();
+}
+
+void furi_halt(const char* message) {
+    if(message == NULL) {
+        message = "System halt requested.";
+    }
+
+    furi_hal_console_puts("\r\n\033[0;31m[HALT]");
+    furi_posix_print_name();
+    furi_hal_console_puts(message);
+    furi_hal_console_puts("\033[0m\r\n");
+    abort();
+}
+
+size_t memmgr_get_free_heap(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.fordblks;
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    return memmgr_get_free_heap();
+}
+
+void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
+    UNUSED(thread_id);
+}
+
+void memmgr_heap_disable_thread_trace(osThreadId_t thread_id) {
+    UNUSED(thread_id);
+}
+
+size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id) {
+    UNUSED(thread_id);
+    return MEMMGR_HEAP_UNKNOWN;
+}
+
+size_t memmgr_heap_get_thread_memory_peak(osThreadId_t thread_id) {
+    UNUSED(thread_id);
+    return MEMMGR_HEAP_UNKNOWN;
+}
+
+size_t memmgr_heap_get_max_free_block() {
+    return memmgr_get_free_heap();
+}
+
+void memmgr_heap_printf_free_blocks() {
+    malloc_stats();
+}
+
+void furi_stdglue_init() {
+}
+
+bool furi_stdglue_set_global_stdout_callback(FuriStdglueWriteCallback callback) {
+    UNUSED(callback);
+    return false;
+}
+
+bool furi_stdglue_set_thread_stdout_callback(FuriStdglueWriteCallback callback) {
+    UNUSED(callback);
+    return false;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Init condition variable on monotonic clock, so timeouts don't jump with wall time
+ * @param cond
+ */
+void host_os_cond_init(pthread_cond_t* cond);
+
+/**
+ * Get absolute deadline for timeout
+ * @param timeout timeout in ticks, osWaitForever is accepted
+ * @param deadline
+ */
+void host_os_deadline(uint32_t timeout, struct timespec* deadline);
+
+/**
+ * Wait for condition variable until deadline
+ * @param cond
+ * @param mutex locked mutex
+ * @param timeout timeout in ticks, deadline is ignored for osWaitForever
+ * @param deadline deadline from host_os_deadline
+ * @return false if deadline passed
+ */
+bool host_os_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    uint32_t timeout,
+    const struct timespec* deadline);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,640 @@
+#include "storage_posix.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <storage/filesystem_api_internal.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#define TAG "StoragePosix"
+
+#define STORAGE_POSIX_FILE_CLOSED 0
+#define STORAGE_POSIX_FILE_OPENED_FILE 1
+#define STORAGE_POSIX_FILE_OPENED_DIR 2
+
+#define STORAGE_POSIX_COPY_BUFFER_SIZE 4096
+#define STORAGE_POSIX_REMOVE_MAX_FD 16
+
+struct Storage {
+    char root[PATH_MAX];
+    FuriPubSub* pubsub;
+};
+
+typedef struct {
+    int fd;
+    DIR* dir;
+    bool writable;
+} StoragePosixFile;
+
+static FS_Error storage_posix_parse_error(int error) {
+    switch(error) {
+    case 0:
+        return FSE_OK;
+    case ENOENT:
+    case ENOTDIR:
+        return FSE_NOT_EXIST;
+    case EEXIST:
+        return FSE_EXIST;
+    case EACCES:
+    case EPERM:
+    case EISDIR:
+    case EROFS:
+    case ENOTEMPTY:
+        return FSE_DENIED;
+    case ENAMETOOLONG:
+    case EINVAL:
+        return FSE_INVALID_NAME;
+    case EBADF:
+        return FSE_INVALID_PARAMETER;
+    default:
+        return FSE_INTERNAL;
+    }
+}
+
+/** Map /ext/.. and /int/.. to host directory, /any is /ext as on device with card */
+static FS_Error storage_posix_path(Storage* storage, const char* path, char* host_path) {
+    const char* storage_name = NULL;
+    if(strncmp(path, "/ext", 4) == 0 || strncmp(path, "/any", 4) == 0) {
+        storage_name = "/ext";
+    } else if(strncmp(path, "/int", 4) == 0) {
+        storage_name = "/int";
+    }
+
+    if(storage_name == NULL || (path[4] != '\0' && path[4] != '/')) {
+        return FSE_INVALID_NAME;
+    }
+
+    int length = snprintf(host_path, PATH_MAX, "%s%s%s", storage->root, storage_name, &path[4]);
+    return (length < PATH_MAX) ? FSE_OK : FSE_INVALID_NAME;
+}
+
+static void storage_posix_publish(Storage* storage, StorageEventType type) {
+    StorageEvent event = {.type = type};
+    furi_pubsub_publish(storage->pubsub, &event);
+}
+
+static bool storage_posix_file_result(File* file, int error) {
+    file->internal_error_id = error;
+    file->error_id = storage_posix_parse_error(error);
+    return (file->error_id == FSE_OK);
+}
+
+void storage_posix_init() {
+    Storage* storage = malloc(sizeof(Storage));
+    const char* root = getenv(STORAGE_POSIX_ROOT_ENV);
+    snprintf(
+        storage->root, sizeof(storage->root), "%s", root ? root : STORAGE_POSIX_ROOT_DEFAULT);
+    storage->pubsub = furi_pubsub_alloc();
+
+    char path[sizeof(storage->root) + sizeof("/ext")];
+    mkdir(storage->root, 0777);
+    snprintf(path, sizeof(path), "%s/ext", storage->root);
+    mkdir(path, 0777);
+    snprintf(path, sizeof(path), "%s/int", storage->root);
+    mkdir(path, 0777);
+
+    FURI_LOG_I(TAG, "Root: %s", storage->root);
+    furi_record_create("storage", storage);
+}
+
+FuriPubSub* storage_get_pubsub(Storage* storage) {
+    furi_assert(storage);
+    return storage->pubsub;
+}
+
+/* File */
+
+File* storage_file_alloc(Storage* storage) {
+    File* file = malloc(sizeof(File));
+    file->file_id = STORAGE_POSIX_FILE_CLOSED;
+    file->error_id = FSE_OK;
+    file->internal_error_id = 0;
+    file->storage = storage;
+    file->storage_data = NULL;
+
+    return file;
+}
+
+void storage_file_free(File* file) {
+    if(storage_file_is_open(file)) {
+        if(storage_file_is_dir(file)) {
+            storage_dir_close(file);
+        } else {
+            storage_file_close(file);
+        }
+    }
+
+    free(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    furi_assert(!storage_file_is_open(file));
+
+    char host_path[PATH_MAX];
+    file->error_id = storage_posix_path(file->storage, path, host_path);
+    if(file->error_id != FSE_OK) return false;
+
+    int flags = O_CLOEXEC;
+    if(access_mode == FSAM_READ_WRITE) {
+        flags |= O_RDWR;
+    } else if(access_mode == FSAM_WRITE) {
+        flags |= O_WRONLY;
+    } else {
+        flags |= O_RDONLY;
+    }
+
+    if(open_mode & (FSOM_OPEN_ALWAYS | FSOM_OPEN_APPEND)) flags |= O_CREAT;
+    if(open_mode & FSOM_CREATE_NEW) flags |= O_CREAT | O_EXCL;
+    if(open_mode & FSOM_CREATE_ALWAYS) flags |= O_CREAT | O_TRUNC;
+
+    int fd = open(host_path, flags, 0666);
+    if(fd < 0) return storage_posix_file_result(file, errno);
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || S_ISDIR(info.st_mode)) {
+        close(fd);
+        return storage_posix_file_result(file, ENOENT);
+    }
+
+    if((open_mode & FSOM_OPEN_APPEND) && lseek(fd, 0, SEEK_END) < 0) {
+        int error = errno;
+        close(fd);
+        return storage_posix_file_result(file, error);
+    }
+
+    StoragePosixFile* file_data = malloc(sizeof(StoragePosixFile));
+    file_data->fd = fd;
+    file_data->dir = NULL;
+    file_data->writable = (access_mode & FSAM_WRITE);
+    file->storage_data = file_data;
+    file->file_id = STORAGE_POSIX_FILE_OPENED_FILE;
+
+    return storage_posix_file_result(file, 0);
+}
+
+bool storage_file_close(File* file) {
+    if(file->file_id != STORAGE_POSIX_FILE_OPENED_FILE) {
+        file->error_id = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    StoragePosixFile* file_data = file->storage_data;
+    int result = close(file_data->fd);
+    free(file_data);
+    file->storage_data = NULL;
+    file->file_id = STORAGE_POSIX_FILE_CLOSED;
+    storage_posix_publish(file->storage, StorageEventTypeFileClose);
+
+    return storage_posix_file_result(file, result ? errno : 0);
+}
+
+bool storage_file_is_open(File* file) {
+    return (file->file_id != STORAGE_POSIX_FILE_CLOSED);
+}
+
+bool storage_file_is_dir(File* file) {
+    return (file->file_id == STORAGE_POSIX_FILE_OPENED_DIR);
+}
+
+/** Opened file data, or NULL with error set */
+static StoragePosixFile* storage_posix_file_data(File* file) {
+    if(file->file_id != STORAGE_POSIX_FILE_OPENED_FILE) {
+        file->error_id = FSE_INVALID_PARAMETER;
+        return NULL;
+    }
+    return file->storage_data;
+}
+
+uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return 0;
+
+    size_t done = 0;
+    int error = 0;
+    while(done < bytes_to_read) {
+        ssize_t result = read(file_data->fd, (uint8_t*)buff + done, bytes_to_read - done);
+        if(result < 0 && errno == EINTR) continue;
+        if(result < 0) error = errno;
+        if(result <= 0) break;
+        done += result;
+    }
+
+    storage_posix_file_result(file, error);
+    return done;
+}
+
+uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return 0;
+
+    size_t done = 0;
+    int error = 0;
+    while(done < bytes_to_write) {
+        ssize_t result =
+            write(file_data->fd, (const uint8_t*)buff + done, bytes_to_write - done);
+        if(result < 0 && errno == EINTR) continue;
+        if(result < 0) error = errno;
+        if(result <= 0) break;
+        done += result;
+    }
+
+    storage_posix_file_result(file, error);
+    return done;
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return false;
+
+    off_t position = offset;
+    if(!from_start) {
+        position += lseek(file_data->fd, 0, SEEK_CUR);
+    }
+
+    // as FatFs: file opened for read can't be extended by seek
+    struct stat info;
+    if(!file_data->writable && fstat(file_data->fd, &info) == 0 && position > info.st_size) {
+        position = info.st_size;
+    }
+
+    off_t result = lseek(file_data->fd, position, SEEK_SET);
+    return storage_posix_file_result(file, result < 0 ? errno : 0);
+}
+
+uint64_t storage_file_tell(File* file) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return 0;
+
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    storage_posix_file_result(file, position < 0 ? errno : 0);
+    return position < 0 ? 0 : position;
+}
+
+bool storage_file_truncate(File* file) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return false;
+
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    int result = (position < 0) ? -1 : ftruncate(file_data->fd, position);
+    return storage_posix_file_result(file, result ? errno : 0);
+}
+
+uint64_t storage_file_size(File* file) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return 0;
+
+    struct stat info;
+    int result = fstat(file_data->fd, &info);
+    storage_posix_file_result(file, result ? errno : 0);
+    return result ? 0 : info.st_size;
+}
+
+bool storage_file_sync(File* file) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return false;
+
+    int result = fsync(file_data->fd);
+    return storage_posix_file_result(file, result ? errno : 0);
+}
+
+bool storage_file_eof(File* file) {
+    StoragePosixFile* file_data = storage_posix_file_data(file);
+    if(!file_data) return false;
+
+    struct stat info;
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    if(position < 0 || fstat(file_data->fd, &info) != 0) {
+        storage_posix_file_result(file, errno);
+        return false;
+    }
+
+    storage_posix_file_result(file, 0);
+    return position >= info.st_size;
+}
+
+/* Dir */
+
+bool storage_dir_open(File* file, const char* path) {
+    furi_assert(!storage_file_is_open(file));
+
+    char host_path[PATH_MAX];
+    file->error_id = storage_posix_path(file->storage, path, host_path);
+    if(file->error_id != FSE_OK) return false;
+
+    DIR* dir = opendir(host_path);
+    if(dir == NULL) return storage_posix_file_result(file, errno);
+
+    StoragePosixFile* file_data = malloc(sizeof(StoragePosixFile));
+    file_data->fd = -1;
+    file_data->dir = dir;
+    file_data->writable = false;
+    file->storage_data = file_data;
+    file->file_id = STORAGE_POSIX_FILE_OPENED_DIR;
+
+    return storage_posix_file_result(file, 0);
+}
+
+bool storage_dir_close(File* file) {
+    if(file->file_id != STORAGE_POSIX_FILE_OPENED_DIR) {
+        file->error_id = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    StoragePosixFile* file_data = file->storage_data;
+    int result = closedir(file_data->dir);
+    free(file_data);
+    file->storage_data = NULL;
+    file->file_id = STORAGE_POSIX_FILE_CLOSED;
+    storage_posix_publish(file->storage, StorageEventTypeDirClose);
+
+    return storage_posix_file_result(file, result ? errno : 0);
+}
+
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length) {
+    if(file->file_id != STORAGE_POSIX_FILE_OPENED_DIR) {
+        file->error_id = FSE_INVALID_PARAMETER;
+        return false;
+    }
+    StoragePosixFile* file_data = file->storage_data;
+
+    struct dirent* entry;
+    do {
+        errno = 0;
+        entry = readdir(file_data->dir);
+    } while(entry && (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0));
+
+    if(entry == NULL) {
+        // end of directory is reported the same way as FatFs does
+        storage_posix_file_result(file, errno ? errno : ENOENT);
+        return false;
+    }
+
+    if(fileinfo != NULL) {
+        struct stat info;
+        fileinfo->flags = 0;
+        fileinfo->size = 0;
+        fileinfo->mtime = 0;
+        if(fstatat(dirfd(file_data->dir), entry->d_name, &info, 0) == 0) {
+            fileinfo->size = S_ISDIR(info.st_mode) ? 0 : info.st_size;
+            fileinfo->mtime = info.st_mtime;
+            if(S_ISDIR(info.st_mode)) fileinfo->flags |= FSF_DIRECTORY;
+        }
+    }
+
+    if(name != NULL) {
+        snprintf(name, name_length, "%s", entry->d_name);
+    }
+
+    return storage_posix_file_result(file, 0);
+}
+
+bool storage_dir_rewind(File* file) {
+    if(file->file_id != STORAGE_POSIX_FILE_OPENED_DIR) {
+        file->error_id = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    StoragePosixFile* file_data = file->storage_data;
+    rewinddir(file_data->dir);
+    return storage_posix_file_result(file, 0);
+}
+
+/* Common */
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    char host_path[PATH_MAX];
+    FS_Error error = storage_posix_path(storage, path, host_path);
+    if(error != FSE_OK) return error;
+
+    struct stat info;
+    if(stat(host_path, &info) != 0) return storage_posix_parse_error(errno);
+
+    if(fileinfo != NULL) {
+        fileinfo->flags = S_ISDIR(info.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = S_ISDIR(info.st_mode) ? 0 : info.st_size;
+        fileinfo->mtime = info.st_mtime;
+    }
+    return FSE_OK;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    char host_path[PATH_MAX];
+    FS_Error error = storage_posix_path(storage, path, host_path);
+    if(error != FSE_OK) return error;
+
+    struct stat info;
+    if(stat(host_path, &info) != 0) return storage_posix_parse_error(errno);
+
+    int result = S_ISDIR(info.st_mode) ? rmdir(host_path) : unlink(host_path);
+    return storage_posix_parse_error(result ? errno : 0);
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    char host_old_path[PATH_MAX];
+    char host_new_path[PATH_MAX];
+    FS_Error error = storage_posix_path(storage, old_path, host_old_path);
+    if(error == FSE_OK) error = storage_posix_path(storage, new_path, host_new_path);
+    if(error != FSE_OK) return error;
+
+    // device never overwrites destination
+    if(access(host_new_path, F_OK) == 0) return FSE_EXIST;
+
+    int result = rename(host_old_path, host_new_path);
+    return storage_posix_parse_error(result ? errno : 0);
+}
+
+FS_Error storage_common_copy(Storage* storage, const char* old_path, const char* new_path) {
+    char host_old_path[PATH_MAX];
+    char host_new_path[PATH_MAX];
+    FS_Error error = storage_posix_path(storage, old_path, host_old_path);
+    if(error == FSE_OK) error = storage_posix_path(storage, new_path, host_new_path);
+    if(error != FSE_OK) return error;
+
+    struct stat info;
+    if(stat(host_old_path, &info) != 0) return storage_posix_parse_error(errno);
+    if(S_ISDIR(info.st_mode)) {
+        return storage_posix_parse_error(mkdir(host_new_path, 0777) ? errno : 0);
+    }
+
+    int from = open(host_old_path, O_RDONLY | O_CLOEXEC);
+    if(from < 0) return storage_posix_parse_error(errno);
+    int to = open(host_new_path, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if(to < 0) {
+        error = storage_posix_parse_error(errno);
+        close(from);
+        return error;
+    }
+
+    uint8_t* buffer = malloc(STORAGE_POSIX_COPY_BUFFER_SIZE);
+    int result = 0;
+    while(true) {
+        ssize_t was_read = read(from, buffer, STORAGE_POSIX_COPY_BUFFER_SIZE);
+        if(was_read < 0) result = errno;
+        if(was_read <= 0) break;
+        if(write(to, buffer, was_read) != was_read) {
+            result = errno ? errno : EIO;
+            break;
+        }
+    }
+    free(buffer);
+    close(to);
+    close(from);
+
+    return storage_posix_parse_error(result);
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    char host_path[PATH_MAX];
+    FS_Error error = storage_posix_path(storage, path, host_path);
+    if(error != FSE_OK) return error;
+
+    return storage_posix_parse_error(mkdir(host_path, 0777) ? errno : 0);
+}
+
+FS_Error storage_common_fs_info(
+    Storage* storage,
+    const char* fs_path,
+    uint64_t* total_space,
+    uint64_t* free_space) {
+    char host_path[PATH_MAX];
+    FS_Error error = storage_posix_path(storage, fs_path, host_path);
+    if(error != FSE_OK) return error;
+
+    struct statvfs info;
+    if(statvfs(host_path, &info) != 0) return storage_posix_parse_error(errno);
+
+    if(total_space) *total_space = (uint64_t)info.f_blocks * info.f_frsize;
+    if(free_space) *free_space = (uint64_t)info.f_bavail * info.f_frsize;
+    return FSE_OK;
+}
+
+/* Error */
+
+const char* storage_error_get_desc(FS_Error error_id) {
+    return filesystem_api_error_get_desc(error_id);
+}
+
+FS_Error storage_file_get_error(File* file) {
+    furi_check(file != NULL);
+    return file->error_id;
+}
+
+int32_t storage_file_get_internal_error(File* file) {
+    furi_check(file != NULL);
+    return file->internal_error_id;
+}
+
+const char* storage_file_get_error_desc(File* file) {
+    furi_check(file != NULL);
+    return filesystem_api_error_get_desc(file->error_id);
+}
+
+/* SD card is always there */
+
+FS_Error storage_sd_format(Storage* api) {
+    UNUSED(api);
+    return FSE_NOT_IMPLEMENTED;
+}
+
+FS_Error storage_sd_unmount(Storage* api) {
+    UNUSED(api);
+    return FSE_NOT_IMPLEMENTED;
+}
+
+FS_Error storage_sd_info(Storage* api, SDInfo* info) {
+    uint64_t total_space = 0;
+    uint64_t free_space = 0;
+    FS_Error error = storage_common_fs_info(api, "/ext", &total_space, &free_space);
+
+    memset(info, 0, sizeof(SDInfo));
+    info->fs_type = FST_UNKNOWN;
+    info->kb_total = total_space / 1024;
+    info->kb_free = free_space / 1024;
+    info->cluster_size = 1;
+    info->sector_size = 512;
+    snprintf(info->label, SD_LABEL_LENGTH, "HOST");
+    info->error = error;
+
+    return error;
+}
+
+FS_Error storage_sd_status(Storage* api) {
+    UNUSED(api);
+    return FSE_OK;
+}
+
+/* Simply API */
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    FS_Error result;
+    result = storage_common_remove(storage, path);
+    return result == FSE_OK || result == FSE_NOT_EXIST;
+}
+
+static int storage_posix_remove_callback(
+    const char* path,
+    const struct stat* info,
+    int type,
+    struct FTW* ftw) {
+    UNUSED(info);
+    UNUSED(ftw);
+    return (type == FTW_DP) ? rmdir(path) : unlink(path);
+}
+
+bool storage_simply_remove_recursive(Storage* storage, const char* path) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    char host_path[PATH_MAX];
+    if(storage_posix_path(storage, path, host_path) != FSE_OK) return false;
+    if(access(host_path, F_OK) != 0) return (errno == ENOENT);
+
+    return nftw(
+               host_path,
+               storage_posix_remove_callback,
+               STORAGE_POSIX_REMOVE_MAX_FD,
+               FTW_DEPTH | FTW_PHYS) == 0;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    FS_Error result;
+    result = storage_common_mkdir(storage, path);
+    return result == FSE_OK || result == FSE_EXIST;
+}
+
+void storage_get_next_filename(
+    Storage* storage,
+    const char* dirname,
+    const char* filename,
+    const char* fileextension,
+    string_t nextfilename,
+    uint8_t max_len) {
+    string_t temp_str;
+    uint16_t num = 0;
+
+    string_init_printf(temp_str, "%s/%s%s", dirname, filename, fileextension);
+
+    while(storage_common_stat(storage, string_get_cstr(temp_str), NULL) == FSE_OK) {
+        num++;
+        string_printf(temp_str, "%s/%s%d%s", dirname, filename, num, fileextension);
+    }
+    if(num && (max_len > strlen(filename))) {
+        string_printf(nextfilename, "%s%d", filename, num);
+    } else {
+        string_printf(nextfilename, "%s", filename);
+    }
+
+    string_clear(temp_str);
+}
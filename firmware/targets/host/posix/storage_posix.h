@@ -0,0 +1,20 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Directory that holds /int and /ext, relative to working directory if not absolute */
+#define STORAGE_POSIX_ROOT_ENV "FURI_HOST_STORAGE"
+#define STORAGE_POSIX_ROOT_DEFAULT "storage"
+
+/**
+ * Create storage record backed by host directory.
+ * Storage API calls go straight to the host file system from the calling thread,
+ * there is no storage service thread and no concurrent open checks.
+ */
+void storage_posix_init();
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,205 @@
+#include "host_os_i.h"
+
+#include <stream_buffer.h>
+#include <cmsis_os2.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+struct StreamBufferDef_t {
+    pthread_mutex_t mutex;
+    /** Trigger level reached */
+    pthread_cond_t data;
+    /** Data was taken out */
+    pthread_cond_t space;
+
+    uint8_t* buffer;
+    size_t size;
+    size_t head;
+    size_t count;
+    size_t trigger;
+};
+
+StreamBufferHandle_t xStreamBufferCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes) {
+    if(xBufferSizeBytes == 0 || xTriggerLevelBytes > xBufferSizeBytes) return NULL;
+
+    StreamBufferHandle_t stream_buffer = malloc(sizeof(struct StreamBufferDef_t));
+    pthread_mutex_init(&stream_buffer->mutex, NULL);
+    host_os_cond_init(&stream_buffer->data);
+    host_os_cond_init(&stream_buffer->space);
+    stream_buffer->buffer = malloc(xBufferSizeBytes);
+    stream_buffer->size = xBufferSizeBytes;
+    stream_buffer->head = 0;
+    stream_buffer->count = 0;
+    stream_buffer->trigger = xTriggerLevelBytes ? xTriggerLevelBytes : 1;
+    return stream_buffer;
+}
+
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer) {
+    pthread_cond_destroy(&xStreamBuffer->space);
+    pthread_cond_destroy(&xStreamBuffer->data);
+    pthread_mutex_destroy(&xStreamBuffer->mutex);
+    free(xStreamBuffer->buffer);
+    free(xStreamBuffer);
+}
+
+/** Copy as much as fits, wake receiver if trigger level is reached. Mutex is held. */
+static size_t
+    stream_buffer_put(StreamBufferHandle_t stream_buffer, const uint8_t* data, size_t size) {
+    size_t written = stream_buffer->size - stream_buffer->count;
+    if(size < written) written = size;
+
+    size_t tail = (stream_buffer->head + stream_buffer->count) % stream_buffer->size;
+    size_t first = stream_buffer->size - tail;
+    if(first > written) first = written;
+    memcpy(&stream_buffer->buffer[tail], data, first);
+    memcpy(stream_buffer->buffer, &data[first], written - first);
+    stream_buffer->count += written;
+
+    if(stream_buffer->count >= stream_buffer->trigger) {
+        pthread_cond_broadcast(&stream_buffer->data);
+    }
+    return written;
+}
+
+/** Copy out what is available, wake sender if anything was taken. Mutex is held. */
+static size_t stream_buffer_take(StreamBufferHandle_t stream_buffer, uint8_t* data, size_t size) {
+    size_t read = stream_buffer->count;
+    if(size < read) read = size;
+
+    size_t first = stream_buffer->size - stream_buffer->head;
+    if(first > read) first = read;
+    memcpy(data, &stream_buffer->buffer[stream_buffer->head], first);
+    memcpy(&data[first], stream_buffer->buffer, read - first);
+    stream_buffer->head = (stream_buffer->head + read) % stream_buffer->size;
+    stream_buffer->count -= read;
+
+    if(read) {
+        pthread_cond_broadcast(&stream_buffer->space);
+    }
+    return read;
+}
+
+size_t xStreamBufferSend(
+    StreamBufferHandle_t xStreamBuffer,
+    const void* pvTxData,
+    size_t xDataLengthBytes,
+    TickType_t xTicksToWait) {
+    // as on device: wait for space for all data, on timeout write as much as possible
+    size_t required = xDataLengthBytes;
+    if(required > xStreamBuffer->size) required = xStreamBuffer->size;
+
+    struct timespec deadline;
+    host_os_deadline(xTicksToWait, &deadline);
+
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    while(xTicksToWait && (xStreamBuffer->size - xStreamBuffer->count) < required) {
+        if(!host_os_cond_wait(
+               &xStreamBuffer->space, &xStreamBuffer->mutex, xTicksToWait, &deadline)) {
+            break;
+        }
+    }
+    size_t written = stream_buffer_put(xStreamBuffer, pvTxData, xDataLengthBytes);
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return written;
+}
+
+size_t xStreamBufferSendFromISR(
+    StreamBufferHandle_t xStreamBuffer,
+    const void* pvTxData,
+    size_t xDataLengthBytes,
+    BaseType_t* const pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    size_t written = stream_buffer_put(xStreamBuffer, pvTxData, xDataLengthBytes);
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return written;
+}
+
+size_t xStreamBufferReceive(
+    StreamBufferHandle_t xStreamBuffer,
+    void* pvRxData,
+    size_t xBufferLengthBytes,
+    TickType_t xTicksToWait) {
+    struct timespec deadline;
+    host_os_deadline(xTicksToWait, &deadline);
+
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    // as on device: only empty buffer blocks, blocked receiver waits for trigger level
+    if(xStreamBuffer->count == 0 && xTicksToWait) {
+        while(xStreamBuffer->count < xStreamBuffer->trigger) {
+            if(!host_os_cond_wait(
+                   &xStreamBuffer->data, &xStreamBuffer->mutex, xTicksToWait, &deadline)) {
+                break;
+            }
+        }
+    }
+    size_t read = stream_buffer_take(xStreamBuffer, pvRxData, xBufferLengthBytes);
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return read;
+}
+
+size_t xStreamBufferReceiveFromISR(
+    StreamBufferHandle_t xStreamBuffer,
+    void* pvRxData,
+    size_t xBufferLengthBytes,
+    BaseType_t* const pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    size_t read = stream_buffer_take(xStreamBuffer, pvRxData, xBufferLengthBytes);
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return read;
+}
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer) {
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    xStreamBuffer->head = 0;
+    xStreamBuffer->count = 0;
+    pthread_cond_broadcast(&xStreamBuffer->space);
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return pdPASS;
+}
+
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer) {
+    return xStreamBufferBytesAvailable(xStreamBuffer) == 0 ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer) {
+    return xStreamBufferSpacesAvailable(xStreamBuffer) == 0 ? pdTRUE : pdFALSE;
+}
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer) {
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    size_t count = xStreamBuffer->count;
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return count;
+}
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer) {
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    size_t space = xStreamBuffer->size - xStreamBuffer->count;
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return space;
+}
+
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel) {
+    if(xTriggerLevel > xStreamBuffer->size) return pdFALSE;
+
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    xStreamBuffer->trigger = xTriggerLevel ? xTriggerLevel : 1;
+    if(xStreamBuffer->count >= xStreamBuffer->trigger) {
+        pthread_cond_broadcast(&xStreamBuffer->data);
+    }
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+
+    return pdTRUE;
+}
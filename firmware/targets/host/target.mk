@@ -0,0 +1,112 @@
+TOOLCHAIN = host
+
+HARDWARE_TARGET = 0
+
+# Host build: pure software libs on top of POSIX, used for benchmarks
+CFLAGS			+= -DFURI_HOST -D_GNU_SOURCE -pthread -Wall
+LDFLAGS			+= -pthread
+# Device heap returns zeroed memory, see furi_posix.c
+LDFLAGS			+= -Wl,--wrap,malloc
+
+SANITIZE ?= 0
+ifeq ($(SANITIZE), 1)
+CFLAGS			+= -fsanitize=address,undefined -fno-omit-frame-pointer
+LDFLAGS			+= -fsanitize=address,undefined
+endif
+
+CORE_DIR		= $(PROJECT_ROOT)/core
+LIB_DIR			= $(PROJECT_ROOT)/lib
+APP_DIR			= $(PROJECT_ROOT)/applications
+
+# FreeRTOS and CMSIS shims, glue headers are shared with device
+CFLAGS += \
+	-I$(TARGET_DIR)/Inc \
+	-I$(LIB_DIR)/FreeRTOS-glue/
+
+# Furi HAL, host headers go first
+FURI_HAL_DIR = $(TARGET_DIR)/furi_hal
+CFLAGS += \
+	-I$(FURI_HAL_DIR) \
+	-Itargets/furi_hal_include
+C_SOURCES += $(wildcard $(FURI_HAL_DIR)/*.c)
+
+# Kernel, furi and storage over POSIX
+POSIX_DIR = $(TARGET_DIR)/posix
+CFLAGS += -I$(POSIX_DIR)
+C_SOURCES += $(wildcard $(POSIX_DIR)/*.c)
+
+# Furi core without memory manager, crash handler and stdio glue
+CFLAGS += -I$(CORE_DIR)
+C_SOURCES += \
+	$(CORE_DIR)/furi.c \
+	$(CORE_DIR)/furi/log.c \
+	$(CORE_DIR)/furi/pubsub.c \
+	$(CORE_DIR)/furi/record.c \
+	$(CORE_DIR)/furi/ring.c \
+	$(CORE_DIR)/furi/thread.c \
+	$(CORE_DIR)/furi/trace.c \
+	$(CORE_DIR)/furi/valuemutex.c
+
+# Libs without hardware behind them
+# random_name reads DWT cycle counter, subghz tx_rx worker drives the radio
+# NFC dump codec sees only data types, GUI headers come with nfc_device.h
+# Power ICs are driven over simulated I2C bus, service poll policy is plain code
+CFLAGS += \
+	-I$(APP_DIR) \
+	-I$(PROJECT_ROOT)/assets/compiled \
+	-I$(LIB_DIR) \
+	-I$(LIB_DIR)/mlib \
+	-I$(LIB_DIR)/fnv1a-hash \
+	-I$(LIB_DIR)/heatshrink \
+	-I$(LIB_DIR)/drivers \
+	-I$(LIB_DIR)/flipper_format \
+	-I$(LIB_DIR)/nfc_protocols \
+	-I$(LIB_DIR)/infrared/encoder_decoder
+C_SOURCES += \
+	$(APP_DIR)/storage/filesystem_api.c \
+	$(filter-out %/random_name.c, $(wildcard $(LIB_DIR)/toolbox/*.c)) \
+	$(wildcard $(LIB_DIR)/toolbox/stream/*.c) \
+	$(LIB_DIR)/fnv1a-hash/fnv1a-hash.c \
+	$(wildcard $(LIB_DIR)/heatshrink/*.c) \
+	$(wildcard $(LIB_DIR)/flipper_format/*.c) \
+	$(LIB_DIR)/nfc_protocols/crypto1.c \
+	$(LIB_DIR)/nfc_protocols/mifare_classic.c \
+	$(LIB_DIR)/nfc_protocols/mifare_desfire.c \
+	$(LIB_DIR)/nfc_protocols/mifare_ultralight.c \
+	$(LIB_DIR)/nfc_protocols/nfc_util.c \
+	$(LIB_DIR)/nfc_protocols/nfca.c \
+	$(APP_DIR)/nfc/helpers/nfc_dump.c \
+	$(LIB_DIR)/drivers/bq27220.c \
+	$(LIB_DIR)/drivers/bq25896.c \
+	$(APP_DIR)/power/power_service/power_poll.c \
+	$(wildcard $(LIB_DIR)/infrared/encoder_decoder/*.c) \
+	$(wildcard $(LIB_DIR)/infrared/encoder_decoder/*/*.c) \
+	$(filter-out %/subghz_tx_rx_worker.c, $(wildcard $(LIB_DIR)/subghz/*.c)) \
+	$(wildcard $(LIB_DIR)/subghz/*/*.c)
+
+# FatFs over disk image on host storage, SD sector cache and config are shared with device
+FATFS_DIR = $(LIB_DIR)/fatfs
+CFLAGS += \
+	-I$(FATFS_DIR) \
+	-Itargets/f7/fatfs
+C_SOURCES += \
+	$(FATFS_DIR)/ff.c \
+	$(FATFS_DIR)/ff_gen_drv.c \
+	$(FATFS_DIR)/diskio.c \
+	$(FATFS_DIR)/option/unicode.c \
+	targets/f7/fatfs/sector_cache.c
+
+# Canvas over u8g2 on display SPI bus model, icon decoder is shared with device
+U8G2_DIR = $(LIB_DIR)/u8g2
+CFLAGS += -I$(U8G2_DIR)
+C_SOURCES += \
+	$(wildcard $(U8G2_DIR)/*.c) \
+	targets/f7/furi_hal/furi_hal_compress.c \
+	$(APP_DIR)/gui/canvas.c \
+	$(APP_DIR)/gui/icon.c \
+	$(APP_DIR)/gui/icon_animation.c \
+	$(PROJECT_ROOT)/assets/compiled/assets_icons.c
+
+# Benchmarks, compiled icons are also sample data for compression
+BENCH_DIR = $(TARGET_DIR)/bench
+C_SOURCES += $(wildcard $(BENCH_DIR)/*.c)
@@ -130,9 +130,7 @@ bool bq25896_check_otg_fault(FuriHalI2cBusHandle* handle) {
     return bq25896_regs.r0C.BOOST_FAULT;
 }
 
-uint16_t bq25896_get_vbus_voltage(FuriHalI2cBusHandle* handle) {
-    furi_hal_i2c_read_reg_8(
-        handle, BQ25896_ADDRESS, 0x11, (uint8_t*)&bq25896_regs.r11, BQ25896_I2C_TIMEOUT);
+static uint16_t bq25896_vbus_voltage(void) {
     if(bq25896_regs.r11.VBUS_GD) {
         return (uint16_t)bq25896_regs.r11.VBUSV * 100 + 2600;
     } else {
@@ -140,26 +138,71 @@ uint16_t bq25896_get_vbus_voltage(FuriHalI2cBusHandle* handle) {
     }
 }
 
+static uint16_t bq25896_vsys_voltage(void) {
+    return (uint16_t)bq25896_regs.r0F.SYSV * 20 + 2304;
+}
+
+static uint16_t bq25896_vbat_voltage(void) {
+    return (uint16_t)bq25896_regs.r0E.BATV * 20 + 2304;
+}
+
+static uint16_t bq25896_vbat_current(void) {
+    return (uint16_t)bq25896_regs.r12.ICHGR * 50;
+}
+
+static uint32_t bq25896_ntc_mpct(void) {
+    return (uint32_t)bq25896_regs.r10.TSPCT * 465 + 21000;
+}
+
+uint16_t bq25896_get_vbus_voltage(FuriHalI2cBusHandle* handle) {
+    furi_hal_i2c_read_reg_8(
+        handle, BQ25896_ADDRESS, 0x11, (uint8_t*)&bq25896_regs.r11, BQ25896_I2C_TIMEOUT);
+    return bq25896_vbus_voltage();
+}
+
 uint16_t bq25896_get_vsys_voltage(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x0F, (uint8_t*)&bq25896_regs.r0F, BQ25896_I2C_TIMEOUT);
-    return (uint16_t)bq25896_regs.r0F.SYSV * 20 + 2304;
+    return bq25896_vsys_voltage();
 }
 
 uint16_t bq25896_get_vbat_voltage(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x0E, (uint8_t*)&bq25896_regs.r0E, BQ25896_I2C_TIMEOUT);
-    return (uint16_t)bq25896_regs.r0E.BATV * 20 + 2304;
+    return bq25896_vbat_voltage();
 }
 
 uint16_t bq25896_get_vbat_current(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x12, (uint8_t*)&bq25896_regs.r12, BQ25896_I2C_TIMEOUT);
-    return (uint16_t)bq25896_regs.r12.ICHGR * 50;
+    return bq25896_vbat_current();
 }
 
 uint32_t bq25896_get_ntc_mpct(FuriHalI2cBusHandle* handle) {
     furi_hal_i2c_read_reg_8(
         handle, BQ25896_ADDRESS, 0x10, (uint8_t*)&bq25896_regs.r10, BQ25896_I2C_TIMEOUT);
-    return (uint32_t)bq25896_regs.r10.TSPCT * 465 + 21000;
+    return bq25896_ntc_mpct();
+}
+
+bool bq25896_get_data(FuriHalI2cBusHandle* handle, ChargerData* data) {
+    // Control register with OTG bit, status, fault and ADC results: REG03..REG12
+    bool ret = furi_hal_i2c_read_mem(
+        handle,
+        BQ25896_ADDRESS,
+        0x03,
+        (uint8_t*)&bq25896_regs.r03,
+        offsetof(bq25896_regs_t, r13) - offsetof(bq25896_regs_t, r03),
+        BQ25896_I2C_TIMEOUT);
+    if(!ret) return false;
+
+    data->is_charging = bq25896_regs.r0B.CHRG_STAT != ChrgStatNo;
+    data->is_otg_enabled = bq25896_regs.r03.OTG_CONFIG;
+    data->is_otg_fault = bq25896_regs.r0C.BOOST_FAULT;
+    data->vbus_voltage = bq25896_vbus_voltage();
+    data->vsys_voltage = bq25896_vsys_voltage();
+    data->vbat_voltage = bq25896_vbat_voltage();
+    data->vbat_current = bq25896_vbat_current();
+    data->ntc_mpct = bq25896_ntc_mpct();
+
+    return true;
 }
@@ -4,6 +4,17 @@
 #include <stdint.h>
 #include <furi_hal_i2c.h>
 
+typedef struct {
+    bool is_charging;
+    bool is_otg_enabled;
+    bool is_otg_fault; // Boost fault, cleared on read
+    uint16_t vbus_voltage; // mV, 0 if VBUS is not good
+    uint16_t vsys_voltage; // mV
+    uint16_t vbat_voltage; // mV
+    uint16_t vbat_current; // mA
+    uint32_t ntc_mpct; // mpct of REGN
+} ChargerData;
+
 /** Initialize Driver */
 void bq25896_init(FuriHalI2cBusHandle* handle);
 
@@ -45,3 +56,8 @@ uint16_t bq25896_get_vbat_current(FuriHalI2cBusHandle* handle);
 
 /** Get NTC voltage in mpct of REGN */
 uint32_t bq25896_get_ntc_mpct(FuriHalI2cBusHandle* handle);
+
+/** Get all ChargerData fields with one burst read
+ * @return true on success, false otherwise
+ */
+bool bq25896_get_data(FuriHalI2cBusHandle* handle, ChargerData* data);
@@ -21,7 +21,8 @@ typedef struct {
     uint8_t IINLIM : 6; // Input Current Limit, mA, offset: +100mA
     bool EN_ILIM : 1; // Enable ILIM Pin
     bool EN_HIZ : 1; // Enable HIZ Mode
-} REG00;
+} __attribute__((packed)) REG00;
+_Static_assert(sizeof(REG00) == 1, "REG00 size mismatch");
 
 #define VINDPM_OS_1600 (1 << 4)
 #define VINDPM_OS_800 (1 << 3)
@@ -40,7 +41,8 @@ typedef struct {
     uint8_t VINDPM_OS : 5; // Input Voltage Limit Offset, mV
     bool BCOLD : 1; // Boost Mode Cold Temperature Monitor Threshold
     Bhot BHOT : 2; // Boost Mode Hot Temperature Monitor Threshold
-} REG01;
+} __attribute__((packed)) REG01;
+_Static_assert(sizeof(REG01) == 1, "REG01 size mismatch");
 
 typedef struct {
     bool AUTO_DPDM_EN : 1; // Automatic Input Detection Enable
@@ -50,7 +52,8 @@ typedef struct {
     bool BOOST_FREQ : 1; // Boost Mode Frequency Selection
     bool CONV_RATE : 1; // ADC Conversion Rate Selection
     bool CONV_START : 1; // ADC Conversion Start Control
-} REG02;
+} __attribute__((packed)) REG02;
+_Static_assert(sizeof(REG02) == 1, "REG02 size mismatch");
 
 #define SYS_MIN_400 (1 << 2)
 #define SYS_MIN_200 (1 << 1)
@@ -63,7 +66,8 @@ typedef struct {
     bool OTG_CONFIG : 1; // Boost (OTG) Mode Configuration
     bool WD_RST : 1; // I2C Watchdog Timer Reset
     bool BAT_LOADEN : 1; // Battery Load (IBATLOAD) Enable
-} REG03;
+} __attribute__((packed)) REG03;
+_Static_assert(sizeof(REG03) == 1, "REG03 size mismatch");
 
 #define ICHG_4096 (1 << 6)
 #define ICHG_2048 (1 << 5)
@@ -76,7 +80,8 @@ typedef struct {
 typedef struct {
     uint8_t ICHG : 7; // Fast Charge Current Limit, mA
     bool EN_PUMPX : 1; // Current pulse control Enable
-} REG04;
+} __attribute__((packed)) REG04;
+_Static_assert(sizeof(REG04) == 1, "REG04 size mismatch");
 
 #define IPRETERM_512 (1 << 3)
 #define IPRETERM_256 (1 << 2)
@@ -86,7 +91,8 @@ typedef struct {
 typedef struct {
     uint8_t ITERM : 4; // Termination Current Limit, offset: +64mA
     uint8_t IPRECHG : 4; // Precharge Current Limit, offset: +64mA
-} REG05;
+} __attribute__((packed)) REG05;
+_Static_assert(sizeof(REG05) == 1, "REG05 size mismatch");
 
 #define VREG_512 (1 << 5)
 #define VREG_256 (1 << 4)
@@ -99,7 +105,8 @@ typedef struct {
     bool VRECHG : 1; // Battery Recharge Threshold Offset
     bool BATLOWV : 1; // Battery Precharge to Fast Charge Threshold
     uint8_t VREG : 6; // Charge Voltage Limit, offset: +3840mV
-} REG06;
+} __attribute__((packed)) REG06;
+_Static_assert(sizeof(REG06) == 1, "REG06 size mismatch");
 
 typedef enum {
     WatchdogDisable = 0b00,
@@ -122,7 +129,8 @@ typedef struct {
     Watchdog WATCHDOG : 2; // I2C Watchdog Timer Setting
     bool STAT_DIS : 1; // STAT Pin Disable
     bool EN_TERM : 1; // Charging Termination Enable
-} REG07;
+} __attribute__((packed)) REG07;
+_Static_assert(sizeof(REG07) == 1, "REG07 size mismatch");
 
 #define BAT_COMP_80 (1 << 2)
 #define BAT_COMP_40 (1 << 1)
@@ -141,7 +149,8 @@ typedef struct {
     uint8_t TREG : 2; // Thermal Regulation Threshold
     uint8_t VCLAMP : 3; // IR Compensation Voltage Clamp
     uint8_t BAT_COMP : 3; // IR Compensation Resistor Setting
-} REG08;
+} __attribute__((packed)) REG08;
+_Static_assert(sizeof(REG08) == 1, "REG08 size mismatch");
 
 typedef struct {
     bool PUMPX_DN : 1; // Current pulse control voltage down enable
@@ -152,7 +161,8 @@ typedef struct {
     bool BATFET_DIS : 1; // Force BATFET off to enable ship mode
     bool TMR2X_EN : 1; // Safety Timer Setting during DPM or Thermal Regulation
     bool FORCE_ICO : 1; // Force Start Input Current Optimizer
-} REG09;
+} __attribute__((packed)) REG09;
+_Static_assert(sizeof(REG09) == 1, "REG09 size mismatch");
 
 #define BOOSTV_512 (1 << 3)
 #define BOOSTV_256 (1 << 2)
@@ -172,7 +182,8 @@ typedef struct {
     uint8_t BOOST_LIM : 3; // Boost Mode Current Limit
     bool PFM_OTG_DIS : 1; // PFM mode allowed in boost mode
     uint8_t BOOSTV : 4; // Boost Mode Voltage Regulation, offset: +4550mV
-} REG0A;
+} __attribute__((packed)) REG0A;
+_Static_assert(sizeof(REG0A) == 1, "REG0A size mismatch");
 
 typedef enum {
     VBusStatNo = 0b000,
@@ -194,7 +205,8 @@ typedef struct {
     bool PG_STAT : 1; // Power Good Status
     ChrgStat CHRG_STAT : 2; // Charging Status
     VBusStat VBUS_STAT : 3; // VBUS Status register
-} REG0B;
+} __attribute__((packed)) REG0B;
+_Static_assert(sizeof(REG0B) == 1, "REG0B size mismatch");
 
 typedef enum {
     ChrgFaultNO = 0b00,
@@ -217,7 +229,8 @@ typedef struct {
     ChrgFault CHRG_FAULT : 2; // Charge Fault Status
     bool BOOST_FAULT : 1; // Boost Mode Fault Status
     bool WATCHDOG_FAULT : 1; // Watchdog Fault Status
-} REG0C;
+} __attribute__((packed)) REG0C;
+_Static_assert(sizeof(REG0C) == 1, "REG0C size mismatch");
 
 #define VINDPM_6400 (1 << 6)
 #define VINDPM_3200 (1 << 5)
@@ -230,39 +243,46 @@ typedef struct {
 typedef struct {
     uint8_t VINDPM : 7; // Absolute VINDPM Threshold, offset: +2600mV
     bool FORCE_VINDPM : 1; // VINDPM Threshold Setting Method
-} REG0D;
+} __attribute__((packed)) REG0D;
+_Static_assert(sizeof(REG0D) == 1, "REG0D size mismatch");
 
 typedef struct {
     uint8_t BATV : 7; // ADC conversion of Battery Voltage (VBAT), offset: +2304mV
     bool THERM_STAT : 1; // Thermal Regulation Status
-} REG0E;
+} __attribute__((packed)) REG0E;
+_Static_assert(sizeof(REG0E) == 1, "REG0E size mismatch");
 
 typedef struct {
     uint8_t SYSV : 7; // ADDC conversion of System Voltage (VSYS), offset: +2304mV
     uint8_t RES : 1; // Reserved: Always reads 0
-} REG0F;
+} __attribute__((packed)) REG0F;
+_Static_assert(sizeof(REG0F) == 1, "REG0F size mismatch");
 
 typedef struct {
     uint8_t TSPCT : 7; // ADC conversion of TS Voltage (TS) as percentage of REGN, offset: +21%
     uint8_t RES : 1; // Reserved: Always reads 0
-} REG10;
+} __attribute__((packed)) REG10;
+_Static_assert(sizeof(REG10) == 1, "REG10 size mismatch");
 
 typedef struct {
     uint8_t VBUSV : 7; // ADC conversion of VBUS voltage (VBUS), offset: +2600mV
     bool VBUS_GD : 1; // VBUS Good Status
-} REG11;
+} __attribute__((packed)) REG11;
+_Static_assert(sizeof(REG11) == 1, "REG11 size mismatch");
 
 typedef struct {
     uint8_t ICHGR : 7; // ADC conversion of Charge Current (IBAT) when VBAT > VBATSHORT
     uint8_t RES : 1; // Reserved: Always reads 0
-} REG12;
+} __attribute__((packed)) REG12;
+_Static_assert(sizeof(REG12) == 1, "REG12 size mismatch");
 
 typedef struct {
     uint8_t
         IDPM_LIM : 6; // Input Current Limit in effect while Input Current Optimizer (ICO) is enabled, offset: 100mA (default)
     bool IDPM_STAT : 1; // IINDPM Status
     bool VDPM_STAT : 1; // VINDPM Status
-} REG13;
+} __attribute__((packed)) REG13;
+_Static_assert(sizeof(REG13) == 1, "REG13 size mismatch");
 
 typedef struct {
     uint8_t DEV_REV : 2; // Device Revision
@@ -270,4 +290,5 @@ typedef struct {
     uint8_t PN : 3; // Device Configuration
     bool ICO_OPTIMIZED : 1; // Input Current Optimizer (ICO) Status
     bool REG_RST : 1; // Register Reset
-} REG14;
+} __attribute__((packed)) REG14;
+_Static_assert(sizeof(REG14) == 1, "REG14 size mismatch");
@@ -4,9 +4,13 @@
 #include <furi_hal_delay.h>
 #include <furi/log.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define TAG "Gauge"
 
+// Standard commands are laid out back to back, GaugeData spans Temperature..StateOfHealth
+#define BQ27220_DATA_SIZE (CommandStateOfHealth + 2 - CommandTemperature)
+
 uint16_t bq27220_read_word(FuriHalI2cBusHandle* handle, uint8_t address) {
     uint16_t buf = 0;
 
@@ -159,3 +163,28 @@ uint16_t bq27220_get_state_of_charge(FuriHalI2cBusHandle* handle) {
 uint16_t bq27220_get_state_of_health(FuriHalI2cBusHandle* handle) {
     return bq27220_read_word(handle, CommandStateOfHealth);
 }
+
+static uint16_t bq27220_data_word(const uint8_t* buffer, uint8_t command) {
+    const uint8_t* word = &buffer[command - CommandTemperature];
+    return word[0] | (word[1] << 8);
+}
+
+bool bq27220_get_data(FuriHalI2cBusHandle* handle, GaugeData* data) {
+    uint8_t buffer[BQ27220_DATA_SIZE];
+
+    bool ret = furi_hal_i2c_read_mem(
+        handle, BQ27220_ADDRESS, CommandTemperature, buffer, sizeof(buffer), BQ27220_I2C_TIMEOUT);
+    if(!ret) return false;
+
+    data->temperature = bq27220_data_word(buffer, CommandTemperature);
+    data->voltage = bq27220_data_word(buffer, CommandVoltage);
+    uint16_t battery_status = bq27220_data_word(buffer, CommandBatteryStatus);
+    memcpy(&data->battery_status, &battery_status, sizeof(BatteryStatus));
+    data->current = bq27220_data_word(buffer, CommandCurrent);
+    data->remaining_capacity = bq27220_data_word(buffer, CommandRemainingCapacity);
+    data->full_charge_capacity = bq27220_data_word(buffer, CommandFullChargeCapacity);
+    data->state_of_charge = bq27220_data_word(buffer, CommandStateOfCharge);
+    data->state_of_health = bq27220_data_word(buffer, CommandStateOfHealth);
+
+    return true;
+}
@@ -92,6 +92,17 @@ typedef struct {
     uint16_t DOD100;
 } ParamCEDV;
 
+typedef struct {
+    uint16_t temperature; // 0.1°K
+    uint16_t voltage; // mV
+    BatteryStatus battery_status;
+    int16_t current; // mA
+    uint16_t remaining_capacity; // mAh
+    uint16_t full_charge_capacity; // mAh
+    uint16_t state_of_charge; // %
+    uint16_t state_of_health; // %
+} GaugeData;
+
 /** Initialize Driver
  * @return true on success, false otherwise
  */
@@ -128,4 +139,9 @@ uint16_t bq27220_get_state_of_charge(FuriHalI2cBusHandle* handle);
 /** Get ratio of full charge capacity over design capacity in percents */
 uint16_t bq27220_get_state_of_health(FuriHalI2cBusHandle* handle);
 
+/** Get all GaugeData fields with one incremental read
+ * @return true on success, false otherwise
+ */
+bool bq27220_get_data(FuriHalI2cBusHandle* handle, GaugeData* data);
+
 void bq27220_change_design_capacity(FuriHalI2cBusHandle* handle, uint16_t capacity);
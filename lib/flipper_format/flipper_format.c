@@ -6,11 +6,13 @@
 #include "flipper_format_i.h"
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
+#include "flipper_format_index_i.h"
 
 /********************************** Private **********************************/
 struct FlipperFormat {
     Stream* stream;
     bool strict_mode;
+    FlipperFormatIndex* index;
 };
 
 static const char* const flipper_format_filetype_key = "Filetype";
@@ -20,12 +22,88 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+static bool flipper_format_seek_to_key(FlipperFormat* flipper_format, const char* key) {
+    if(flipper_format->index) {
+        return flipper_format_index_seek_to_key(
+            flipper_format->index, flipper_format->stream, key, flipper_format->strict_mode);
+    } else {
+        return flipper_format_stream_seek_to_key(
+            flipper_format->stream, key, flipper_format->strict_mode);
+    }
+}
+
+static bool flipper_format_read_value(
+    FlipperFormat* flipper_format,
+    const char* key,
+    FlipperStreamValue type,
+    void* data,
+    size_t data_size) {
+    return flipper_format_seek_to_key(flipper_format, key) &&
+           flipper_format_stream_read_values(flipper_format->stream, type, data, data_size);
+}
+
+/** Index follows appended lines, after any other write it is built again on the next read */
+static bool flipper_format_index_follows_write(FlipperFormat* flipper_format) {
+    Stream* stream = flipper_format->stream;
+    return flipper_format->index && (stream_tell(stream) == stream_size(stream)) &&
+           flipper_format_index_is_synced(flipper_format->index, stream);
+}
+
+static bool
+    flipper_format_write_value(FlipperFormat* flipper_format, FlipperStreamWriteData* write_data) {
+    Stream* stream = flipper_format->stream;
+    size_t offset = stream_tell(stream);
+    bool indexed = flipper_format_index_follows_write(flipper_format);
+
+    bool result = flipper_format_stream_write_value_line(stream, write_data);
+
+    if(result && indexed) {
+        flipper_format_index_append(flipper_format->index, stream, write_data->key, offset);
+    }
+    return result;
+}
+
+static bool flipper_format_update_value(
+    FlipperFormat* flipper_format,
+    FlipperStreamWriteData* write_data) {
+    Stream* stream = flipper_format->stream;
+    if(!flipper_format->index) {
+        return flipper_format_stream_delete_key_and_write(
+            stream, write_data, flipper_format->strict_mode);
+    }
+
+    bool result = false;
+    do {
+        size_t size = stream_size(stream);
+        if(size == 0) break;
+        if(!stream_rewind(stream)) break;
+        if(!flipper_format_seek_to_key(flipper_format, write_data->key)) break;
+
+        bool indexed = flipper_format_index_is_synced(flipper_format->index, stream);
+        size_t offset = stream_tell(stream) - strlen(write_data->key) - 2;
+        if(!flipper_format_stream_rewrite_key(stream, write_data)) break;
+
+        if(indexed) {
+            flipper_format_index_replace(
+                flipper_format->index,
+                stream,
+                offset,
+                write_data->type == FlipperStreamValueIgnore,
+                (int32_t)stream_size(stream) - (int32_t)size);
+        }
+        result = true;
+    } while(false);
+
+    return result;
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc() {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = string_stream_alloc();
     flipper_format->strict_mode = false;
+    flipper_format->index = flipper_format_index_alloc();
     return flipper_format;
 }
 
@@ -33,6 +111,7 @@ FlipperFormat* flipper_format_file_alloc(Storage* storage) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = file_stream_alloc(storage);
     flipper_format->strict_mode = false;
+    flipper_format->index = NULL;
     return flipper_format;
 }
 
@@ -90,6 +169,9 @@ bool flipper_format_file_close(FlipperFormat* flipper_format) {
 void flipper_format_free(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
     stream_free(flipper_format->stream);
+    if(flipper_format->index) {
+        flipper_format_index_free(flipper_format->index);
+    }
     free(flipper_format);
 }
 
@@ -97,6 +179,16 @@ void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_m
     flipper_format->strict_mode = strict_mode;
 }
 
+void flipper_format_set_index_mode(FlipperFormat* flipper_format, bool index_mode) {
+    furi_assert(flipper_format);
+    if(index_mode && !flipper_format->index) {
+        flipper_format->index = flipper_format_index_alloc();
+    } else if(!index_mode && flipper_format->index) {
+        flipper_format_index_free(flipper_format->index);
+        flipper_format->index = NULL;
+    }
+}
+
 bool flipper_format_rewind(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
     return stream_rewind(flipper_format->stream);
@@ -110,7 +202,10 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
-    bool result = flipper_format_stream_seek_to_key(flipper_format->stream, key, false);
+    bool strict_mode = flipper_format->strict_mode;
+    flipper_format->strict_mode = false;
+    bool result = flipper_format_seek_to_key(flipper_format, key);
+    flipper_format->strict_mode = strict_mode;
     stream_seek(flipper_format->stream, pos, StreamOffsetFromStart);
 
     return result;
@@ -148,14 +243,20 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count) {
     furi_assert(flipper_format);
-    return flipper_format_stream_get_value_count(
-        flipper_format->stream, key, count, flipper_format->strict_mode);
+    size_t position = stream_tell(flipper_format->stream);
+    bool result = flipper_format_seek_to_key(flipper_format, key) &&
+                  flipper_format_stream_count_values(flipper_format->stream, count);
+
+    if(!stream_seek(flipper_format->stream, position, StreamOffsetFromStart)) {
+        result = false;
+    }
+
+    return result;
 }
 
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, string_t data) {
     furi_assert(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream, key, FlipperStreamValueStr, data, 1, flipper_format->strict_mode);
+    return flipper_format_read_value(flipper_format, key, FlipperStreamValueStr, data, 1);
 }
 
 bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key, string_t data) {
@@ -166,7 +267,7 @@ bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key,
         .data = string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value(flipper_format, &write_data);
     return result;
 }
 
@@ -181,7 +282,7 @@ bool flipper_format_write_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value(flipper_format, &write_data);
     return result;
 }
 
@@ -191,13 +292,8 @@ bool flipper_format_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueUint32,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value(
+        flipper_format, key, FlipperStreamValueUint32, data, data_size);
 }
 
 bool flipper_format_write_uint32(
@@ -212,7 +308,7 @@ bool flipper_format_write_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value(flipper_format, &write_data);
     return result;
 }
 
@@ -221,13 +317,8 @@ bool flipper_format_read_int32(
     const char* key,
     int32_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueInt32,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value(
+        flipper_format, key, FlipperStreamValueInt32, data, data_size);
 }
 
 bool flipper_format_write_int32(
@@ -242,7 +333,7 @@ bool flipper_format_write_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value(flipper_format, &write_data);
     return result;
 }
 
@@ -251,13 +342,7 @@ bool flipper_format_read_bool(
     const char* key,
     bool* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueBool,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value(flipper_format, key, FlipperStreamValueBool, data, data_size);
 }
 
 bool flipper_format_write_bool(
@@ -272,7 +357,7 @@ bool flipper_format_write_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value(flipper_format, &write_data);
     return result;
 }
 
@@ -281,13 +366,8 @@ bool flipper_format_read_float(
     const char* key,
     float* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueFloat,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value(
+        flipper_format, key, FlipperStreamValueFloat, data, data_size);
 }
 
 bool flipper_format_write_float(
@@ -302,7 +382,7 @@ bool flipper_format_write_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value(flipper_format, &write_data);
     return result;
 }
 
@@ -311,13 +391,7 @@ bool flipper_format_read_hex(
     const char* key,
     uint8_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueHex,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value(flipper_format, key, FlipperStreamValueHex, data, data_size);
 }
 
 bool flipper_format_write_hex(
@@ -332,7 +406,7 @@ bool flipper_format_write_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value(flipper_format, &write_data);
     return result;
 }
 
@@ -343,7 +417,14 @@ bool flipper_format_write_comment(FlipperFormat* flipper_format, string_t data)
 
 bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
     furi_assert(flipper_format);
-    return flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
+    bool indexed = flipper_format_index_follows_write(flipper_format);
+
+    bool result = flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
+
+    if(result && indexed) {
+        flipper_format_index_append(flipper_format->index, flipper_format->stream, NULL, 0);
+    }
+    return result;
 }
 
 bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
@@ -354,8 +435,7 @@ bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
         .data = NULL,
         .data_size = 0,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -367,8 +447,7 @@ bool flipper_format_update_string(FlipperFormat* flipper_format, const char* key
         .data = string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -383,8 +462,7 @@ bool flipper_format_update_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -400,8 +478,7 @@ bool flipper_format_update_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -416,8 +493,7 @@ bool flipper_format_update_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -432,8 +508,7 @@ bool flipper_format_update_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -448,8 +523,7 @@ bool flipper_format_update_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -464,8 +538,7 @@ bool flipper_format_update_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_update_value(flipper_format, &write_data);
     return result;
 }
 
@@ -172,6 +172,17 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/**
+ * Set key index mode. Indexed FlipperFormat records offset of every key with one pass
+ * on the first key lookup, then reads seek straight to the key instead of scanning
+ * the data. Writes and updates made through FlipperFormat keep the index, any other
+ * change of data makes it to be built again. Useful for big files read out of order.
+ * On by default for string FlipperFormat, off for file.
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @param index_mode True enables key index
+ */
+void flipper_format_set_index_mode(FlipperFormat* flipper_format, bool index_mode);
+
 /**
  * Rewind the RW pointer.
  * @param flipper_format Pointer to a FlipperFormat instance
@@ -0,0 +1,237 @@
+#include <furi/check.h>
+#include <furi/common_defines.h>
+#include <m-array.h>
+#include <fnv1a-hash.h>
+#include "flipper_format_index_i.h"
+#include "flipper_format_stream_i.h"
+
+#define FLIPPER_FORMAT_INDEX_BUFFER_SIZE 64
+/** Build reads whole stream, bigger reads pay off for file streams */
+#define FLIPPER_FORMAT_INDEX_BUILD_BUFFER_SIZE 512
+
+typedef struct {
+    uint32_t hash;
+    uint32_t offset;
+} FlipperFormatIndexEntry;
+
+ARRAY_DEF(FlipperFormatIndexEntryArray, FlipperFormatIndexEntry, M_POD_OPLIST)
+
+struct FlipperFormatIndex {
+    /** Key lines, ordered by offset */
+    FlipperFormatIndexEntryArray_t entries;
+    uint32_t revision;
+    bool valid;
+};
+
+static uint32_t flipper_format_index_hash(const char* key, size_t key_length) {
+    return fnv1a_buffer_hash((const uint8_t*)key, key_length, FNV_1A_INIT);
+}
+
+FlipperFormatIndex* flipper_format_index_alloc() {
+    FlipperFormatIndex* index = malloc(sizeof(FlipperFormatIndex));
+    FlipperFormatIndexEntryArray_init(index->entries);
+    index->revision = 0;
+    index->valid = false;
+    return index;
+}
+
+void flipper_format_index_free(FlipperFormatIndex* index) {
+    furi_assert(index);
+    FlipperFormatIndexEntryArray_clear(index->entries);
+    free(index);
+}
+
+bool flipper_format_index_is_synced(FlipperFormatIndex* index, Stream* stream) {
+    furi_assert(index);
+    uint32_t revision = stream_get_revision(stream);
+
+    if(!index->valid || index->revision != revision) {
+        if(stream_size(stream) == 0) {
+            FlipperFormatIndexEntryArray_reset(index->entries);
+            index->revision = revision;
+            index->valid = true;
+        } else {
+            index->valid = false;
+        }
+    }
+
+    return index->valid;
+}
+
+/** One pass over the stream, same key rules as flipper_format_stream_read_valid_key */
+static void flipper_format_index_build(FlipperFormatIndex* index, Stream* stream) {
+    FlipperFormatIndexEntryArray_reset(index->entries);
+    uint8_t* buffer = malloc(FLIPPER_FORMAT_INDEX_BUILD_BUFFER_SIZE);
+
+    size_t position = stream_tell(stream);
+    bool result = stream_rewind(stream);
+
+    size_t offset = 0;
+    size_t line_start = 0;
+    uint32_t hash = FNV_1A_INIT;
+    bool accumulate = true;
+    bool new_line = true;
+
+    while(result) {
+        size_t was_read = stream_read(stream, buffer, FLIPPER_FORMAT_INDEX_BUILD_BUFFER_SIZE);
+        if(was_read == 0) break;
+
+        for(size_t i = 0; i < was_read; i++, offset++) {
+            uint8_t data = buffer[i];
+            if(data == flipper_format_eoln) {
+                line_start = offset + 1;
+                hash = FNV_1A_INIT;
+                accumulate = true;
+                new_line = true;
+            } else if(data == flipper_format_eolr) {
+                // ignore
+            } else if(data == flipper_format_comment && new_line) {
+                accumulate = false;
+                new_line = false;
+            } else if(data == flipper_format_delimiter) {
+                if(accumulate && !new_line) {
+                    FlipperFormatIndexEntry entry = {.hash = hash, .offset = line_start};
+                    FlipperFormatIndexEntryArray_push_back(index->entries, entry);
+                }
+                accumulate = false;
+                new_line = false;
+            } else {
+                new_line = false;
+                if(accumulate) {
+                    hash = fnv1a_buffer_hash(&data, 1, hash);
+                }
+            }
+        }
+    }
+
+    free(buffer);
+
+    result &= stream_seek(stream, position, StreamOffsetFromStart);
+    index->revision = stream_get_revision(stream);
+    index->valid = result;
+}
+
+/** First entry at or after offset */
+static size_t flipper_format_index_lower_bound(FlipperFormatIndex* index, size_t offset) {
+    size_t low = 0;
+    size_t high = FlipperFormatIndexEntryArray_size(index->entries);
+
+    while(low < high) {
+        size_t middle = low + (high - low) / 2;
+        if(FlipperFormatIndexEntryArray_get(index->entries, middle)->offset < offset) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/** Hash can collide, so the key and delimiter are compared */
+static bool flipper_format_index_check_key(
+    Stream* stream,
+    size_t offset,
+    const char* key,
+    size_t key_length) {
+    uint8_t buffer[FLIPPER_FORMAT_INDEX_BUFFER_SIZE];
+    if(!stream_seek(stream, offset, StreamOffsetFromStart)) return false;
+
+    size_t checked = 0;
+    while(checked <= key_length) {
+        size_t size = MIN(key_length + 1 - checked, sizeof(buffer));
+        if(stream_read(stream, buffer, size) != size) return false;
+        for(size_t i = 0; i < size; i++, checked++) {
+            char expected = (checked < key_length) ? key[checked] : flipper_format_delimiter;
+            if(buffer[i] != expected) return false;
+        }
+    }
+
+    return true;
+}
+
+bool flipper_format_index_seek_to_key(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    bool strict_mode) {
+    furi_assert(index);
+
+    if(!flipper_format_index_is_synced(index, stream)) {
+        flipper_format_index_build(index, stream);
+        if(!index->valid) {
+            return flipper_format_stream_seek_to_key(stream, key, strict_mode);
+        }
+    }
+
+    size_t i = flipper_format_index_lower_bound(index, stream_tell(stream));
+    size_t count = FlipperFormatIndexEntryArray_size(index->entries);
+
+    if(strict_mode && i < count) {
+        // only the next key may match, let the stream stop where it always does
+        const FlipperFormatIndexEntry* entry =
+            FlipperFormatIndexEntryArray_cget(index->entries, i);
+        stream_seek(stream, entry->offset, StreamOffsetFromStart);
+        return flipper_format_stream_seek_to_key(stream, key, strict_mode);
+    }
+
+    size_t key_length = strlen(key);
+    uint32_t hash = flipper_format_index_hash(key, key_length);
+
+    for(; i < count; i++) {
+        const FlipperFormatIndexEntry* entry =
+            FlipperFormatIndexEntryArray_cget(index->entries, i);
+        if(entry->hash == hash &&
+           flipper_format_index_check_key(stream, entry->offset, key, key_length)) {
+            return stream_seek(stream, entry->offset + key_length + 2, StreamOffsetFromStart);
+        }
+    }
+
+    stream_seek(stream, 0, StreamOffsetFromEnd);
+    return false;
+}
+
+void flipper_format_index_append(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    size_t offset) {
+    furi_assert(index);
+
+    if(key) {
+        FlipperFormatIndexEntry entry = {
+            .hash = flipper_format_index_hash(key, strlen(key)),
+            .offset = offset,
+        };
+        FlipperFormatIndexEntryArray_push_back(index->entries, entry);
+    }
+    index->revision = stream_get_revision(stream);
+}
+
+void flipper_format_index_replace(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    size_t offset,
+    bool deleted,
+    int32_t size_delta) {
+    furi_assert(index);
+
+    size_t i = flipper_format_index_lower_bound(index, offset);
+    size_t count = FlipperFormatIndexEntryArray_size(index->entries);
+    if(i == count || FlipperFormatIndexEntryArray_get(index->entries, i)->offset != offset) {
+        index->valid = false;
+        return;
+    }
+
+    if(deleted) {
+        FlipperFormatIndexEntryArray_remove_v(index->entries, i, i + 1);
+        count--;
+    } else {
+        i++;
+    }
+
+    for(; i < count; i++) {
+        FlipperFormatIndexEntryArray_get(index->entries, i)->offset += size_delta;
+    }
+    index->revision = stream_get_revision(stream);
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Key offset table of Flipper Format stream.
+ * Table describes stream at certain stream revision, any change not reported to the table
+ * makes it stale and it is rebuilt with one pass on the next lookup.
+ */
+typedef struct FlipperFormatIndex FlipperFormatIndex;
+
+/**
+ * Allocate key offset table
+ * @return FlipperFormatIndex*
+ */
+FlipperFormatIndex* flipper_format_index_alloc();
+
+/**
+ * Free key offset table
+ * @param index
+ */
+void flipper_format_index_free(FlipperFormatIndex* index);
+
+/**
+ * Check if the table describes current stream data, so the change about to be made
+ * to the stream can be reported. Table of the empty stream is synced without reading.
+ * @param index
+ * @param stream
+ * @return true if table is up to date
+ */
+bool flipper_format_index_is_synced(FlipperFormatIndex* index, Stream* stream);
+
+/**
+ * Seek to the key from the current position of the stream.
+ * Result and position are the same as of flipper_format_stream_seek_to_key.
+ * @param index
+ * @param stream
+ * @param key
+ * @param strict_mode
+ * @return true key is found
+ * @return false key is not found
+ */
+bool flipper_format_index_seek_to_key(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    bool strict_mode);
+
+/**
+ * Report data written at the end of the synced stream
+ * @param index
+ * @param stream
+ * @param key key of written line, NULL if line has no key
+ * @param offset line start
+ */
+void flipper_format_index_append(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    size_t offset);
+
+/**
+ * Report key line of the synced stream replaced or deleted
+ * @param index
+ * @param stream
+ * @param offset line start
+ * @param deleted line was deleted
+ * @param size_delta stream size change
+ */
+void flipper_format_index_replace(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    size_t offset,
+    bool deleted,
+    int32_t size_delta);
+
+#ifdef __cplusplus
+}
+#endif
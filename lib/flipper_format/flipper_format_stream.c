@@ -1,9 +1,16 @@
 #include <inttypes.h>
+#include <strings.h>
 #include <toolbox/hex.h>
 #include <furi/check.h>
+#include <furi/common_defines.h>
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
 
+/** Read and write buffer of value line */
+#define FLIPPER_FORMAT_STREAM_BUFFER_SIZE 64
+/** Longest number value, float max printed with "%f" takes 47 chars */
+#define FLIPPER_FORMAT_STREAM_TOKEN_SIZE 48
+
 static bool flipper_format_stream_write(Stream* stream, const void* data, size_t data_size) {
     size_t bytes_written = stream_write(stream, data, data_size);
     return bytes_written == data_size;
@@ -26,8 +33,17 @@ bool flipper_format_stream_write_eol(Stream* stream) {
     return flipper_format_stream_write(stream, &flipper_format_eoln, 1);
 }
 
-static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
-    string_reset(key);
+/**
+ * Find next valid key, key is compared on the fly instead of being accumulated
+ * @param stream
+ * @param key key to compare with
+ * @param match found key is equal to the key, output
+ * @return true if any valid key is found
+ */
+static bool flipper_format_stream_read_valid_key(Stream* stream, const char* key, bool* match) {
+    const size_t key_length = strlen(key);
+    size_t length = 0;
+    bool equal = true;
     const size_t buffer_size = 32;
     uint8_t buffer[buffer_size];
 
@@ -44,7 +60,8 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
             uint8_t data = buffer[i];
             if(data == flipper_format_eoln) {
                 // EOL found, clean data, start accumulating data and set the new_line flag
-                string_reset(key);
+                length = 0;
+                equal = true;
                 accumulate = true;
                 new_line = true;
             } else if(data == flipper_format_eolr) {
@@ -60,7 +77,8 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
                     // this can only be if we have previously found some kind of key, so
                     // clear the data, set the flag that we no longer want to accumulate data
                     // and reset the new_line flag
-                    string_reset(key);
+                    length = 0;
+                    equal = true;
                     accumulate = false;
                     new_line = false;
                 } else {
@@ -73,6 +91,7 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
                             break;
                         }
 
+                        *match = equal && (length == key_length);
                         found = true;
                         break;
                     }
@@ -81,8 +100,11 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
                 // just new symbol, reset the new_line flag
                 new_line = false;
                 if(accumulate) {
-                    // and accumulate data if we want
-                    string_push_back(key, data);
+                    // and compare data if we want
+                    if(length >= key_length || (uint8_t)key[length] != data) {
+                        equal = false;
+                    }
+                    length++;
                 }
             }
         }
@@ -95,13 +117,11 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
 
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
     bool found = false;
-    string_t read_key;
-
-    string_init(read_key);
+    bool match = false;
 
     while(!stream_eof(stream)) {
-        if(flipper_format_stream_read_valid_key(stream, read_key)) {
-            if(string_cmp_str(read_key, key) == 0) {
+        if(flipper_format_stream_read_valid_key(stream, key, &match)) {
+            if(match) {
                 if(!stream_seek(stream, 2, StreamOffsetFromCurrent)) break;
 
                 found = true;
@@ -112,65 +132,128 @@ bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool str
             }
         }
     }
-    string_clear(read_key);
 
     return found;
 }
 
-static bool flipper_format_stream_read_value(Stream* stream, string_t value, bool* last) {
-    string_reset(value);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
-    bool result = false;
-    bool error = false;
+/** Values are parsed right from this buffer, no strings in between */
+typedef struct {
+    Stream* stream;
+    uint8_t buffer[FLIPPER_FORMAT_STREAM_BUFFER_SIZE];
+    size_t size;
+    size_t index;
+} FlipperFormatStreamReader;
+
+static void flipper_format_stream_reader_init(FlipperFormatStreamReader* reader, Stream* stream) {
+    reader->stream = stream;
+    reader->size = 0;
+    reader->index = 0;
+}
+
+/** Return unparsed data to the stream, position is right after the last parsed value */
+static bool flipper_format_stream_reader_finish(FlipperFormatStreamReader* reader) {
+    int32_t unparsed = reader->size - reader->index;
+    return (unparsed == 0) || stream_seek(reader->stream, -unparsed, StreamOffsetFromCurrent);
+}
+
+/**
+ * Read next value token of the line. Token is cut to token_size - 1 chars, full length
+ * is returned, so truncation is visible to the caller. Position is left on the separator.
+ * @param reader
+ * @param token null terminated token, output
+ * @param token_size token buffer size
+ * @param length full token length, output
+ * @param last token is the last one in the line, output
+ * @return true if token was read
+ */
+static bool flipper_format_stream_read_token(
+    FlipperFormatStreamReader* reader,
+    char* token,
+    size_t token_size,
+    size_t* length,
+    bool* last) {
+    *length = 0;
 
     while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
+        if(reader->index == reader->size) {
+            reader->size = stream_read(reader->stream, reader->buffer, sizeof(reader->buffer));
+            reader->index = 0;
 
-        if(was_read == 0) {
-            // check EOF
-            if(stream_eof(stream) && string_size(value) > 0) {
-                result = true;
+            if(reader->size == 0) {
+                // EOF ends the last value
                 *last = true;
                 break;
             }
         }
 
-        for(uint16_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
-            if(data == flipper_format_eoln) {
-                if(string_size(value) > 0) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                        break;
-                    }
+        uint8_t data = reader->buffer[reader->index];
+        if(data == flipper_format_eoln) {
+            *last = true;
+            break;
+        } else if(data == ' ') {
+            if(*length > 0) {
+                *last = false;
+                break;
+            }
+        } else if(data != flipper_format_eolr) {
+            if(*length < token_size - 1) {
+                token[*length] = data;
+            }
+            *length = *length + 1;
+        }
 
-                    result = true;
-                    *last = true;
-                    break;
-                } else {
-                    error = true;
-                }
-            } else if(data == ' ') {
-                if(string_size(value) > 0) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                        break;
-                    }
+        reader->index++;
+    }
 
-                    result = true;
-                    *last = false;
-                    break;
-                }
+    token[MIN(*length, token_size - 1)] = '\0';
+    return (*length > 0);
+}
 
-            } else if(data == flipper_format_eolr) {
-                // Ignore
-            } else {
-                string_push_back(value, data);
-            }
-        }
+static bool flipper_format_stream_parse_value(
+    FlipperStreamValue type,
+    void* _data,
+    size_t i,
+    const char* token,
+    size_t length) {
+    bool result = false;
+    char* end_char;
+
+    // long numbers are cut, parse only what fits
+    if(type != FlipperStreamValueHex && type != FlipperStreamValueBool &&
+       length >= FLIPPER_FORMAT_STREAM_TOKEN_SIZE) {
+        return false;
+    }
 
-        if(error || result) break;
+    switch(type) {
+    case FlipperStreamValueHex: {
+        uint8_t* data = _data;
+        result = (length >= 2) && hex_chars_to_uint8(token[0], token[1], &data[i]);
+    }; break;
+    case FlipperStreamValueFloat: {
+        float* data = _data;
+        // newlib-nano does not have sscanf for floats
+        data[i] = strtof(token, &end_char);
+        result = (*end_char == 0);
+    }; break;
+    case FlipperStreamValueInt32: {
+        int32_t* data = _data;
+        // same as sscanf "%i", base is detected from prefix
+        data[i] = strtol(token, &end_char, 0);
+        result = (end_char != token);
+    }; break;
+    case FlipperStreamValueUint32: {
+        uint32_t* data = _data;
+        // same as sscanf "%d", values were always written signed
+        data[i] = strtol(token, &end_char, 10);
+        result = (end_char != token);
+    }; break;
+    case FlipperStreamValueBool: {
+        bool* data = _data;
+        data[i] = (strcasecmp(token, "true") == 0);
+        result = true;
+    }; break;
+    default:
+        furi_crash("Unknown FF type");
     }
 
     return result;
@@ -248,198 +331,226 @@ static bool flipper_format_stream_seek_to_next_line(Stream* stream) {
     return result;
 }
 
+/** Values are formatted right into this buffer, stream gets few big writes */
+typedef struct {
+    Stream* stream;
+    char buffer[FLIPPER_FORMAT_STREAM_BUFFER_SIZE];
+    size_t size;
+    bool error;
+} FlipperFormatStreamWriter;
+
+static void flipper_format_stream_writer_flush(FlipperFormatStreamWriter* writer) {
+    if(writer->size > 0 && !writer->error) {
+        writer->error = !flipper_format_stream_write(writer->stream, writer->buffer, writer->size);
+    }
+    writer->size = 0;
+}
+
+/** Get room for the value of given type and the separator after it */
+static char* flipper_format_stream_writer_reserve(
+    FlipperFormatStreamWriter* writer,
+    FlipperStreamValue type) {
+    size_t size;
+    switch(type) {
+    case FlipperStreamValueHex:
+        size = 2 + 1;
+        break;
+    case FlipperStreamValueInt32:
+    case FlipperStreamValueUint32:
+        size = 11 + 1;
+        break;
+    case FlipperStreamValueBool:
+        size = 5 + 1;
+        break;
+    default:
+        size = FLIPPER_FORMAT_STREAM_TOKEN_SIZE;
+        break;
+    }
+
+    if(sizeof(writer->buffer) - writer->size < size) {
+        flipper_format_stream_writer_flush(writer);
+    }
+    return &writer->buffer[writer->size];
+}
+
+static size_t flipper_format_stream_format_int32(char* buffer, int32_t value) {
+    char digits[10];
+    size_t count = 0;
+    size_t size = 0;
+    uint32_t magnitude = (value < 0) ? -(uint32_t)value : (uint32_t)value;
+
+    do {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while(magnitude);
+
+    if(value < 0) buffer[size++] = '-';
+    while(count) buffer[size++] = digits[--count];
+
+    return size;
+}
+
+static void flipper_format_stream_format_value(
+    FlipperFormatStreamWriter* writer,
+    FlipperStreamValue type,
+    const void* _data,
+    size_t i) {
+    static const char hex_chars[] = "0123456789ABCDEF";
+    char* buffer = flipper_format_stream_writer_reserve(writer, type);
+    size_t size = 0;
+
+    switch(type) {
+    case FlipperStreamValueHex: {
+        const uint8_t* data = _data;
+        buffer[0] = hex_chars[data[i] >> 4];
+        buffer[1] = hex_chars[data[i] & 0xF];
+        size = 2;
+    }; break;
+    case FlipperStreamValueFloat: {
+        const float* data = _data;
+        int printed = snprintf(buffer, FLIPPER_FORMAT_STREAM_TOKEN_SIZE, "%f", (double)data[i]);
+        size = MIN((size_t)MAX(printed, 0), (size_t)FLIPPER_FORMAT_STREAM_TOKEN_SIZE - 1);
+    }; break;
+    case FlipperStreamValueInt32: {
+        const int32_t* data = _data;
+        size = flipper_format_stream_format_int32(buffer, data[i]);
+    }; break;
+    case FlipperStreamValueUint32: {
+        // written signed, as it always was, so older readers still get the same value
+        const uint32_t* data = _data;
+        size = flipper_format_stream_format_int32(buffer, (int32_t)data[i]);
+    }; break;
+    case FlipperStreamValueBool: {
+        const bool* data = _data;
+        size = data[i] ? 4 : 5;
+        memcpy(buffer, data[i] ? "true" : "false", size);
+    }; break;
+    default:
+        furi_crash("Unknown FF type");
+    }
+
+    writer->size += size;
+}
+
 bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteData* write_data) {
     bool result = false;
 
     if(write_data->type == FlipperStreamValueIgnore) {
         result = true;
     } else {
-        string_t value;
-        string_init(value);
-
         do {
             if(!flipper_format_stream_write_key(stream, write_data->key)) break;
 
-            if(write_data->type == FlipperStreamValueStr) write_data->data_size = 1;
-
-            bool cycle_error = false;
-            for(uint16_t i = 0; i < write_data->data_size; i++) {
-                switch(write_data->type) {
-                case FlipperStreamValueStr: {
-                    const char* data = write_data->data;
-                    string_printf(value, "%s", data);
-                }; break;
-                case FlipperStreamValueHex: {
-                    const uint8_t* data = write_data->data;
-                    string_printf(value, "%02X", data[i]);
-                }; break;
-                case FlipperStreamValueFloat: {
-                    const float* data = write_data->data;
-                    string_printf(value, "%f", data[i]);
-                }; break;
-                case FlipperStreamValueInt32: {
-                    const int32_t* data = write_data->data;
-                    string_printf(value, "%" PRIi32, data[i]);
-                }; break;
-                case FlipperStreamValueUint32: {
-                    const uint32_t* data = write_data->data;
-                    string_printf(value, "%" PRId32, data[i]);
-                }; break;
-                case FlipperStreamValueBool: {
-                    const bool* data = write_data->data;
-                    string_printf(value, data[i] ? "true" : "false");
-                }; break;
-                default:
-                    furi_crash("Unknown FF type");
-                }
+            if(write_data->type == FlipperStreamValueStr) {
+                const char* data = write_data->data;
+                if(!flipper_format_stream_write(stream, data, strlen(data))) break;
+            } else {
+                FlipperFormatStreamWriter writer = {.stream = stream, .size = 0, .error = false};
 
-                if((i + 1) < write_data->data_size) {
-                    string_cat(value, " ");
+                for(size_t i = 0; i < write_data->data_size; i++) {
+                    flipper_format_stream_format_value(
+                        &writer, write_data->type, write_data->data, i);
+                    if((i + 1) < write_data->data_size) {
+                        writer.buffer[writer.size++] = ' ';
+                    }
                 }
 
-                if(!flipper_format_stream_write(
-                       stream, string_get_cstr(value), string_size(value))) {
-                    cycle_error = true;
-                    break;
-                }
+                flipper_format_stream_writer_flush(&writer);
+                if(writer.error) break;
             }
-            if(cycle_error) break;
 
             if(!flipper_format_stream_write_eol(stream)) break;
             result = true;
         } while(false);
-
-        string_clear(value);
     }
 
     return result;
 }
 
-bool flipper_format_stream_read_value_line(
+bool flipper_format_stream_read_values(
     Stream* stream,
-    const char* key,
     FlipperStreamValue type,
     void* _data,
-    size_t data_size,
-    bool strict_mode) {
+    size_t data_size) {
     bool result = false;
 
-    do {
-        if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
+    if(type == FlipperStreamValueStr) {
+        string_ptr data = (string_ptr)_data;
+        result = flipper_format_stream_read_line(stream, data);
+    } else {
+        FlipperFormatStreamReader reader;
+        flipper_format_stream_reader_init(&reader, stream);
+        char token[FLIPPER_FORMAT_STREAM_TOKEN_SIZE];
+        size_t length;
+        bool last = false;
 
-        if(type == FlipperStreamValueStr) {
-            string_ptr data = (string_ptr)_data;
-            if(flipper_format_stream_read_line(stream, data)) {
-                result = true;
+        result = true;
+        for(size_t i = 0; i < data_size; i++) {
+            if(last ||
+               !flipper_format_stream_read_token(&reader, token, sizeof(token), &length, &last) ||
+               !flipper_format_stream_parse_value(type, _data, i, token, length)) {
+                result = false;
                 break;
             }
-        } else {
-            result = true;
-            string_t value;
-            string_init(value);
-
-            for(uint16_t i = 0; i < data_size; i++) {
-                bool last = false;
-                result = flipper_format_stream_read_value(stream, value, &last);
-                if(result) {
-                    int scan_values = 0;
-
-                    switch(type) {
-                    case FlipperStreamValueHex: {
-                        uint8_t* data = _data;
-                        if(string_size(value) >= 2) {
-                            // sscanf "%02X" does not work here
-                            if(hex_chars_to_uint8(
-                                   string_get_char(value, 0),
-                                   string_get_char(value, 1),
-                                   &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
-                    case FlipperStreamValueFloat: {
-                        float* data = _data;
-                        // newlib-nano does not have sscanf for floats
-                        // scan_values = sscanf(string_get_cstr(value), "%f", &data[i]);
-                        char* end_char;
-                        data[i] = strtof(string_get_cstr(value), &end_char);
-                        if(*end_char == 0) {
-                            // most likely ok
-                            scan_values = 1;
-                        }
-                    }; break;
-                    case FlipperStreamValueInt32: {
-                        int32_t* data = _data;
-                        scan_values = sscanf(string_get_cstr(value), "%" PRIi32, &data[i]);
-                    }; break;
-                    case FlipperStreamValueUint32: {
-                        uint32_t* data = _data;
-                        scan_values = sscanf(string_get_cstr(value), "%" PRId32, &data[i]);
-                    }; break;
-                    case FlipperStreamValueBool: {
-                        bool* data = _data;
-                        data[i] = !string_cmpi_str(value, "true");
-                        scan_values = 1;
-                    }; break;
-                    default:
-                        furi_crash("Unknown FF type");
-                    }
-
-                    if(scan_values != 1) {
-                        result = false;
-                        break;
-                    }
-                } else {
-                    break;
-                }
-
-                if(last && ((i + 1) != data_size)) {
-                    result = false;
-                    break;
-                }
-            }
+        }
 
-            string_clear(value);
+        if(!flipper_format_stream_reader_finish(&reader)) {
+            result = false;
         }
-    } while(false);
+    }
 
     return result;
 }
 
-bool flipper_format_stream_get_value_count(
+bool flipper_format_stream_read_value_line(
     Stream* stream,
     const char* key,
-    uint32_t* count,
+    FlipperStreamValue type,
+    void* data,
+    size_t data_size,
     bool strict_mode) {
-    bool result = false;
-    bool last = false;
+    return flipper_format_stream_seek_to_key(stream, key, strict_mode) &&
+           flipper_format_stream_read_values(stream, type, data, data_size);
+}
 
-    string_t value;
-    string_init(value);
+bool flipper_format_stream_count_values(Stream* stream, uint32_t* count) {
+    FlipperFormatStreamReader reader;
+    flipper_format_stream_reader_init(&reader, stream);
+    // only presence of the value matters
+    char token[1];
+    size_t length;
+    bool last = false;
+    bool result = true;
 
-    uint32_t position = stream_tell(stream);
-    do {
-        if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
-        *count = 0;
+    *count = 0;
+    while(!last) {
+        if(!flipper_format_stream_read_token(&reader, token, sizeof(token), &length, &last)) {
+            result = false;
+            break;
+        }
+        *count = *count + 1;
+    }
 
-        result = true;
-        while(true) {
-            if(!flipper_format_stream_read_value(stream, value, &last)) {
-                result = false;
-                break;
-            }
+    if(!flipper_format_stream_reader_finish(&reader)) {
+        result = false;
+    }
 
-            *count = *count + 1;
-            if(last) break;
-        }
+    return result;
+}
 
-    } while(false);
+bool flipper_format_stream_get_value_count(
+    Stream* stream,
+    const char* key,
+    uint32_t* count,
+    bool strict_mode) {
+    uint32_t position = stream_tell(stream);
+    bool result = flipper_format_stream_seek_to_key(stream, key, strict_mode) &&
+                  flipper_format_stream_count_values(stream, count);
 
     if(!stream_seek(stream, position, StreamOffsetFromStart)) {
         result = false;
     }
 
-    string_clear(value);
     return result;
 }
 
@@ -458,6 +569,18 @@ bool flipper_format_stream_delete_key_and_write(
         // find key
         if(!flipper_format_stream_seek_to_key(stream, write_data->key, strict_mode)) break;
 
+        result = flipper_format_stream_rewrite_key(stream, write_data);
+    } while(false);
+
+    return result;
+}
+
+bool flipper_format_stream_rewrite_key(Stream* stream, FlipperStreamWriteData* write_data) {
+    bool result = false;
+
+    do {
+        size_t size = stream_size(stream);
+
         // get key start position
         size_t start_position = stream_tell(stream) - strlen(write_data->key);
         if(start_position >= 2) {
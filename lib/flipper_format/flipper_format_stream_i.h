@@ -29,6 +29,37 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Read values of the key, stream must be at the beginning of the value, as after seek to key.
+ * @param stream 
+ * @param type 
+ * @param data 
+ * @param data_size 
+ * @return true on success
+ */
+bool flipper_format_stream_read_values(
+    Stream* stream,
+    FlipperStreamValue type,
+    void* data,
+    size_t data_size);
+
+/**
+ * Count values of the key, stream must be at the beginning of the value, as after seek to key.
+ * @param stream 
+ * @param count 
+ * @return true on success
+ */
+bool flipper_format_stream_count_values(Stream* stream, uint32_t* count);
+
+/**
+ * Replace the key line with the new one or delete it, if type is FlipperStreamValueIgnore.
+ * Stream must be at the beginning of the value, as after seek to key.
+ * @param stream 
+ * @param write_data 
+ * @return true on success
+ */
+bool flipper_format_stream_rewrite_key(Stream* stream, FlipperStreamWriteData* write_data);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
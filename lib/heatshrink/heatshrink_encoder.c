@@ -52,6 +52,12 @@ typedef struct {
 
 #define MATCH_NOT_FOUND ((uint16_t)-1)
 
+#if HEATSHRINK_DYNAMIC_ALLOC && HEATSHRINK_USE_INDEX
+#define USE_HASH_CHAIN(HSE) ((HSE)->match_finder == HSEM_HASH_CHAIN)
+#else
+#define USE_HASH_CHAIN(HSE) 0
+#endif
+
 static uint16_t get_input_offset(heatshrink_encoder *hse);
 static uint16_t get_input_buffer_size(heatshrink_encoder *hse);
 static uint16_t get_lookahead_size(heatshrink_encoder *hse);
@@ -69,12 +75,22 @@ static void push_literal_byte(heatshrink_encoder *hse, output_info *oi);
 #if HEATSHRINK_DYNAMIC_ALLOC
 heatshrink_encoder *heatshrink_encoder_alloc(uint8_t* buffer, uint8_t window_sz2,
         uint8_t lookahead_sz2) {
+    return heatshrink_encoder_alloc_ex(buffer, window_sz2, lookahead_sz2,
+        HSEM_INDEX, 0);
+}
+
+heatshrink_encoder *heatshrink_encoder_alloc_ex(uint8_t* buffer, uint8_t window_sz2,
+        uint8_t lookahead_sz2, HSE_match_finder match_finder, uint16_t max_chain) {
     if ((window_sz2 < HEATSHRINK_MIN_WINDOW_BITS) ||
         (window_sz2 > HEATSHRINK_MAX_WINDOW_BITS) ||
         (lookahead_sz2 < HEATSHRINK_MIN_LOOKAHEAD_BITS) ||
         (lookahead_sz2 >= window_sz2)) {
         return NULL;
     }
+#if !HEATSHRINK_USE_INDEX
+    if (match_finder != HSEM_INDEX) { return NULL; }
+    (void)max_chain;
+#endif
     
     /* Note: 2 * the window size is used because the buffer needs to fit
      * (1 << window_sz2) bytes for the current input, and an additional
@@ -97,6 +113,20 @@ heatshrink_encoder *heatshrink_encoder_alloc(uint8_t* buffer, uint8_t window_sz2
         return NULL;
     }
     hse->search_index->size = index_sz;
+
+    hse->match_finder = match_finder;
+    hse->max_chain = max_chain;
+    hse->hash_head = NULL;
+    if (match_finder == HSEM_HASH_CHAIN) {
+        /* One head per buffer position, up to 8 KB */
+        hse->hash_sz2 = window_sz2 + 1 > 12 ? 12 : window_sz2 + 1;
+        hse->hash_head = HEATSHRINK_MALLOC(sizeof(int16_t) << hse->hash_sz2);
+        if (hse->hash_head == NULL) {
+            HEATSHRINK_FREE(hse->search_index, index_sz + sizeof(struct hs_index));
+            HEATSHRINK_FREE(hse, sizeof(*hse));
+            return NULL;
+        }
+    }
 #endif
 
     LOG("-- allocated encoder with buffer size of %zu (%u byte input size)\n",
@@ -109,6 +139,9 @@ void heatshrink_encoder_free(heatshrink_encoder *hse) {
     size_t index_sz = sizeof(struct hs_index) + hse->search_index->size;
     HEATSHRINK_FREE(hse->search_index, index_sz);
     (void)index_sz;
+    if (hse->hash_head != NULL) {
+        HEATSHRINK_FREE(hse->hash_head, sizeof(int16_t) << hse->hash_sz2);
+    }
 #endif
     HEATSHRINK_FREE(hse, sizeof(heatshrink_encoder));
 }
@@ -415,15 +448,35 @@ static void do_indexing(heatshrink_encoder *hse) {
      *    dynamically improve the index.
      * */
     struct hs_index *hsi = HEATSHRINK_ENCODER_INDEX(hse);
-    int16_t last[256];
-    memset(last, 0xFF, sizeof(last));
-
     uint8_t * const data = hse->buffer;
     int16_t * const index = hsi->index;
 
     const uint16_t input_offset = get_input_offset(hse);
     const uint16_t end = input_offset + hse->input_size;
 
+#if HEATSHRINK_DYNAMIC_ALLOC
+    if (USE_HASH_CHAIN(hse)) {
+        /* Same flattened lists, but linking previous positions starting
+         * with the same two bytes (or colliding ones). Every accepted
+         * match is at least 2 bytes long, so nothing is lost. */
+        int16_t * const head = hse->hash_head;
+        const uint8_t shift = 32 - hse->hash_sz2;
+        memset(head, 0xFF, sizeof(int16_t) << hse->hash_sz2);
+
+        for (uint16_t i=0; i + 1 < end; i++) {
+            uint32_t h = ((uint32_t)data[i] << 8) | data[i + 1];
+            h = (uint32_t)(h * 2654435761UL) >> shift;
+            index[i] = head[h];
+            head[h] = i;
+        }
+        if (end > 0) { index[end - 1] = -1; }
+        return;
+    }
+#endif
+
+    int16_t last[256];
+    memset(last, 0xFF, sizeof(last));
+
     for (uint16_t i=0; i<end; i++) {
         uint8_t v = data[i];
         int16_t lv = last[v];
@@ -443,6 +496,24 @@ static int can_take_byte(output_info *oi) {
     return *oi->output_size < oi->buf_size;
 }
 
+/* Count equal leading bytes of A and B, at most MAXLEN. */
+static uint16_t count_match_length(const uint8_t *a, const uint8_t *b,
+        const uint16_t maxlen) {
+    uint16_t len = 0;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    /* Word at a time, first differing byte is the lowest non-zero one */
+    while (len + sizeof(uint32_t) <= maxlen) {
+        uint32_t wa, wb;
+        memcpy(&wa, &a[len], sizeof(wa));
+        memcpy(&wb, &b[len], sizeof(wb));
+        if (wa != wb) { return len + (__builtin_ctz(wa ^ wb) >> 3); }
+        len += sizeof(uint32_t);
+    }
+#endif
+    while ((len < maxlen) && (a[len] == b[len])) { len++; }
+    return len;
+}
+
 /* Return the longest match for the bytes at buf[end:end+maxlen] between
  * buf[start] and buf[end-1]. If no match is found, return -1. */
 static uint16_t find_longest_match(heatshrink_encoder *hse, uint16_t start,
@@ -459,28 +530,33 @@ static uint16_t find_longest_match(heatshrink_encoder *hse, uint16_t start,
 #if HEATSHRINK_USE_INDEX
     struct hs_index *hsi = HEATSHRINK_ENCODER_INDEX(hse);
     int16_t pos = hsi->index[end];
+#if HEATSHRINK_DYNAMIC_ALLOC
+    uint16_t chain_left = USE_HASH_CHAIN(hse) ? hse->max_chain : 0;
+#else
+    const uint16_t chain_left = 0;
+#endif
 
     while (pos - (int16_t)start >= 0) {
         uint8_t * const pospoint = &buf[pos];
-        len = 0;
 
         /* Only check matches that will potentially beat the current maxlen.
          * This is redundant with the index if match_maxlen is 0, but the
          * added branch overhead to check if it == 0 seems to be worse. */
-        if (pospoint[match_maxlen] != needlepoint[match_maxlen]) {
-            pos = hsi->index[pos];
-            continue;
-        }
-
-        for (len = 1; len < maxlen; len++) {
-            if (pospoint[len] != needlepoint[len]) break;
+        if (pospoint[match_maxlen] == needlepoint[match_maxlen]) {
+            len = count_match_length(pospoint, needlepoint, maxlen);
+            if (len > match_maxlen) {
+                match_maxlen = len;
+                match_index = pos;
+                if (len == maxlen) { break; } /* won't find better */
+            }
         }
 
-        if (len > match_maxlen) {
-            match_maxlen = len;
-            match_index = pos;
-            if (len == maxlen) { break; } /* won't find better */
-        }
+#if HEATSHRINK_DYNAMIC_ALLOC
+        /* Bounded chain: good enough match is better than slow one */
+        if (chain_left && (--chain_left == 0)) { break; }
+#else
+        (void)chain_left;
+#endif
         pos = hsi->index[pos];
     }
 #else    
@@ -19,6 +19,11 @@ typedef enum {
     HSER_POLL_ERROR_MISUSE=-2,  /* API misuse */
 } HSE_poll_res;
 
+typedef enum {
+    HSEM_INDEX,                 /* per byte linked index, exhaustive search */
+    HSEM_HASH_CHAIN,            /* 2 byte prefix hash chains, bounded depth */
+} HSE_match_finder;
+
 typedef enum {
     HSER_FINISH_DONE,           /* encoding is complete */
     HSER_FINISH_MORE,           /* more output remaining; use poll */
@@ -65,6 +70,10 @@ typedef struct {
     uint8_t lookahead_sz2;      /* 2^n size of lookahead */
 #if HEATSHRINK_USE_INDEX
     struct hs_index *search_index;
+    uint8_t match_finder;       /* HSE_match_finder */
+    uint8_t hash_sz2;           /* 2^n hash chain heads */
+    uint16_t max_chain;         /* chain candidates to check, 0 - all */
+    int16_t *hash_head;         /* most recent position of every hash */
 #endif
     /* input buffer and / sliding window for expansion */
     uint8_t* buffer;
@@ -83,6 +92,15 @@ typedef struct {
 heatshrink_encoder *heatshrink_encoder_alloc(uint8_t* buffer, uint8_t window_sz2,
     uint8_t lookahead_sz2);
 
+/* Allocate a new encoder struct with given match finder.
+ * HSEM_HASH_CHAIN checks at most MAX_CHAIN candidates per position (0 - all
+ * of them, output is then the same as with HSEM_INDEX), it requires
+ * HEATSHRINK_USE_INDEX. Output is decoded by any decoder with the same
+ * window and lookahead.
+ * Returns NULL on error. */
+heatshrink_encoder *heatshrink_encoder_alloc_ex(uint8_t* buffer, uint8_t window_sz2,
+    uint8_t lookahead_sz2, HSE_match_finder match_finder, uint16_t max_chain);
+
 /* Free an encoder. */
 void heatshrink_encoder_free(heatshrink_encoder *hse);
 #endif
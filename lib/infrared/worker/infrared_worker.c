@@ -9,9 +9,10 @@
 #include <furi.h>
 
 #include <notification/notification_messages.h>
-#include <stream_buffer.h>
 
 #define INFRARED_WORKER_RX_TIMEOUT INFRARED_RAW_RX_TIMING_DELAY_US
+/** Worker takes samples in batches, the rest is taken on rx timeout */
+#define INFRARED_WORKER_RX_WATERMARK 32
 
 #define INFRARED_WORKER_RX_RECEIVED 0x01
 #define INFRARED_WORKER_RX_TIMEOUT_RECEIVED 0x02
@@ -50,7 +51,8 @@ struct InfraredWorkerSignal {
 
 struct InfraredWorker {
     FuriThread* thread;
-    StreamBufferHandle_t stream;
+    /** LevelDuration on rx, InfraredWorkerTiming on tx */
+    FuriRing* ring;
 
     InfraredWorkerSignal signal;
     InfraredWorkerState state;
@@ -100,18 +102,17 @@ static void infrared_worker_rx_timeout_callback(void* context) {
 static void infrared_worker_rx_callback(void* context, bool level, uint32_t duration) {
     InfraredWorker* instance = context;
 
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     furi_assert(duration != 0);
+    FURI_TRACE_POINT(FuriTraceInfraredRx, level, duration);
     LevelDuration level_duration = level_duration_make(level, duration);
 
-    size_t ret = xStreamBufferSendFromISR(
-        instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
-    uint32_t events = (ret == sizeof(LevelDuration)) ? INFRARED_WORKER_RX_RECEIVED :
-                                                       INFRARED_WORKER_OVERRUN;
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-
-    uint32_t flags_set = osThreadFlagsSet(furi_thread_get_thread_id(instance->thread), events);
-    furi_check(flags_set & events);
+    // Ring wakes worker up with INFRARED_WORKER_RX_RECEIVED on watermark
+    if(!furi_ring_push(instance->ring, &level_duration, 1)) {
+        FURI_TRACE_POINT(FuriTraceInfraredOverrun, 0, 0);
+        uint32_t flags_set = osThreadFlagsSet(
+            furi_thread_get_thread_id(instance->thread), INFRARED_WORKER_OVERRUN);
+        furi_check(flags_set & INFRARED_WORKER_OVERRUN);
+    }
 }
 
 static void infrared_worker_process_timeout(InfraredWorker* instance) {
@@ -160,17 +161,39 @@ static void
     }
 }
 
+static void infrared_worker_rx_process_ring(InfraredWorker* instance) {
+    LevelDuration batch[INFRARED_WORKER_RX_WATERMARK];
+    size_t count;
+    while((count = furi_ring_pop(instance->ring, batch, COUNT_OF(batch)))) {
+        for(size_t i = 0; i < count && !instance->rx.overrun; i++) {
+            bool level = level_duration_get_level(batch[i]);
+            uint32_t duration = level_duration_get_duration(batch[i]);
+            infrared_worker_process_timings(instance, duration, level);
+        }
+    }
+}
+
 static int32_t infrared_worker_rx_thread(void* thread_context) {
     InfraredWorker* instance = thread_context;
     uint32_t events = 0;
-    LevelDuration level_duration;
     TickType_t last_blink_time = 0;
 
+    furi_ring_set_notify(
+        instance->ring,
+        osThreadGetId(),
+        INFRARED_WORKER_RX_RECEIVED,
+        INFRARED_WORKER_RX_WATERMARK);
+
     while(1) {
+        // Samples that came while worker was busy are taken in the next round
+        if(furi_ring_arm(instance->ring)) {
+            osThreadFlagsSet(osThreadGetId(), INFRARED_WORKER_RX_RECEIVED);
+        }
         events = osThreadFlagsWait(INFRARED_WORKER_ALL_RX_EVENTS, 0, osWaitForever);
         furi_check(events & INFRARED_WORKER_ALL_RX_EVENTS); /* at least one caught */
 
-        if(events & INFRARED_WORKER_RX_RECEIVED) {
+        // Timeout means signal end, samples below watermark are still in ring
+        if(events & (INFRARED_WORKER_RX_RECEIVED | INFRARED_WORKER_RX_TIMEOUT_RECEIVED)) {
             if(!instance->rx.overrun && instance->blink_enable &&
                ((xTaskGetTickCount() - last_blink_time) > 80)) {
                 last_blink_time = xTaskGetTickCount();
@@ -178,15 +201,7 @@ static int32_t infrared_worker_rx_thread(void* thread_context) {
             }
             if(instance->signal.timings_cnt == 0)
                 notification_message(instance->notification, &sequence_display_on);
-            while(sizeof(LevelDuration) ==
-                  xStreamBufferReceive(
-                      instance->stream, &level_duration, sizeof(LevelDuration), 0)) {
-                if(!instance->rx.overrun) {
-                    bool level = level_duration_get_level(level_duration);
-                    uint32_t duration = level_duration_get_duration(level_duration);
-                    infrared_worker_process_timings(instance, duration, level);
-                }
-            }
+            infrared_worker_rx_process_ring(instance);
         }
         if(events & INFRARED_WORKER_OVERRUN) {
             printf("#");
@@ -229,10 +244,6 @@ InfraredWorker* infrared_worker_alloc() {
     furi_thread_set_stack_size(instance->thread, 2048);
     furi_thread_set_context(instance->thread, instance);
 
-    size_t buffer_size =
-        MAX(sizeof(InfraredWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1),
-            sizeof(LevelDuration) * MAX_TIMINGS_AMOUNT);
-    instance->stream = xStreamBufferCreate(buffer_size, sizeof(InfraredWorkerTiming));
     instance->infrared_decoder = infrared_alloc_decoder();
     instance->infrared_encoder = infrared_alloc_encoder();
     instance->blink_enable = false;
@@ -249,7 +260,6 @@ void infrared_worker_free(InfraredWorker* instance) {
     furi_record_close("notification");
     infrared_free_decoder(instance->infrared_decoder);
     infrared_free_encoder(instance->infrared_encoder);
-    vStreamBufferDelete(instance->stream);
     furi_thread_free(instance->thread);
 
     free(instance);
@@ -259,7 +269,7 @@ void infrared_worker_rx_start(InfraredWorker* instance) {
     furi_assert(instance);
     furi_assert(instance->state == InfraredWorkerStateIdle);
 
-    xStreamBufferSetTriggerLevel(instance->stream, sizeof(LevelDuration));
+    instance->ring = furi_ring_alloc(sizeof(LevelDuration), MAX_TIMINGS_AMOUNT);
 
     furi_thread_set_callback(instance->thread, infrared_worker_rx_thread);
     furi_thread_start(instance->thread);
@@ -285,9 +295,8 @@ void infrared_worker_rx_stop(InfraredWorker* instance) {
     osThreadFlagsSet(furi_thread_get_thread_id(instance->thread), INFRARED_WORKER_EXIT);
     furi_thread_join(instance->thread);
 
-    BaseType_t xReturn = xStreamBufferReset(instance->stream);
-    furi_assert(xReturn == pdPASS);
-    (void)xReturn;
+    furi_ring_free(instance->ring);
+    instance->ring = NULL;
 
     instance->state = InfraredWorkerStateIdle;
 }
@@ -325,7 +334,7 @@ void infrared_worker_tx_start(InfraredWorker* instance) {
     furi_assert(instance->tx.get_signal_callback);
 
     // size have to be greater than api hal infrared async tx buffer size
-    xStreamBufferSetTriggerLevel(instance->stream, sizeof(InfraredWorkerTiming));
+    instance->ring = furi_ring_alloc(sizeof(InfraredWorkerTiming), MAX_TIMINGS_AMOUNT);
 
     furi_thread_set_callback(instance->thread, infrared_worker_tx_thread);
 
@@ -357,8 +366,7 @@ static FuriHalInfraredTxGetDataState
     InfraredWorkerTiming timing;
     FuriHalInfraredTxGetDataState state;
 
-    if(sizeof(InfraredWorkerTiming) ==
-       xStreamBufferReceiveFromISR(instance->stream, &timing, sizeof(InfraredWorkerTiming), 0)) {
+    if(furi_ring_pop(instance->ring, &timing, 1)) {
         *level = timing.level;
         *duration = timing.duration;
         state = timing.state;
@@ -420,7 +428,7 @@ static bool infrared_worker_tx_fill_buffer(InfraredWorker* instance) {
     InfraredWorkerTiming timing;
     InfraredStatus status = InfraredStatusError;
 
-    while(!xStreamBufferIsFull(instance->stream) && !instance->tx.need_reinitialization &&
+    while(furi_ring_space(instance->ring) && !instance->tx.need_reinitialization &&
           new_data_available) {
         if(instance->signal.decoded) {
             status = infrared_encode(instance->infrared_encoder, &timing.duration, &timing.level);
@@ -453,10 +461,9 @@ static bool infrared_worker_tx_fill_buffer(InfraredWorker* instance) {
         } else {
             furi_assert(0);
         }
-        uint32_t written_size =
-            xStreamBufferSend(instance->stream, &timing, sizeof(InfraredWorkerTiming), 0);
-        furi_assert(sizeof(InfraredWorkerTiming) == written_size);
-        (void)written_size;
+        size_t pushed = furi_ring_push(instance->ring, &timing, 1);
+        furi_assert(pushed == 1);
+        (void)pushed;
     }
 
     return new_data_available;
@@ -564,10 +571,8 @@ void infrared_worker_tx_stop(InfraredWorker* instance) {
     furi_hal_infrared_async_tx_set_signal_sent_isr_callback(NULL, NULL);
 
     instance->signal.timings_cnt = 0;
-    BaseType_t xReturn = pdFAIL;
-    xReturn = xStreamBufferReset(instance->stream);
-    furi_assert(xReturn == pdPASS);
-    (void)xReturn;
+    furi_ring_free(instance->ring);
+    instance->ring = NULL;
     instance->state = InfraredWorkerStateIdle;
 }
 
@@ -58,7 +58,7 @@ uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     return out;
 }
 
-uint8_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint32_t out = 0;
     for(uint8_t i = 0; i < 32; i++) {
@@ -67,6 +67,26 @@ uint8_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     return out;
 }
 
+void crypto1_keystream(Crypto1* crypto1, uint8_t* out, size_t size) {
+    furi_assert(crypto1);
+    furi_assert(out);
+    // No input and no feedback from output: state is shifted without per bit calls
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    for(size_t i = 0; i < size; i++) {
+        uint8_t byte = 0;
+        for(uint8_t j = 0; j < 8; j++) {
+            byte |= crypto1_filter(odd) << j;
+            uint32_t feed = (LF_POLY_ODD & odd) ^ (LF_POLY_EVEN & even);
+            even = even << 1 | nfc_util_even_parity32(feed);
+            FURI_SWAP(odd, even);
+        }
+        out[i] = byte;
+    }
+    crypto1->odd = odd;
+    crypto1->even = even;
+}
+
 uint32_t prng_successor(uint32_t x, uint32_t n) {
     SWAPENDIAN(x);
     while(n--) x = x >> 1 | (x >> 16 ^ x >> 18 ^ x >> 19 ^ x >> 21) << 31;
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 typedef struct {
     uint32_t odd;
@@ -16,7 +17,10 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted);
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted);
 
-uint8_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted);
+uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted);
+
+/** Keystream of size bytes, same as crypto1_byte(crypto1, 0x00, 0) for each byte */
+void crypto1_keystream(Crypto1* crypto1, uint8_t* out, size_t size);
 
 uint32_t crypto1_filter(uint32_t in);
 
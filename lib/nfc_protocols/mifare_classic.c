@@ -2,6 +2,9 @@
 #include "nfca.h"
 #include "nfc_util.h"
 
+#include <furi.h>
+#include <furi_hal_random.h>
+
 // Algorithm from https://github.com/RfidResearchGroup/proxmark3.git
 
 #define TAG "MfClassic"
@@ -10,6 +13,13 @@
 #define MF_CLASSIC_AUTH_KEY_B_CMD (0x61U)
 #define MF_CLASSIC_READ_SECT_CMD (0x30)
 
+#define MF_CLASSIC_CMD_SIZE (4U)
+#define MF_CLASSIC_READ_RESPONSE_SIZE (MF_CLASSIC_BLOCK_SIZE + 2U)
+/** Keystream one READ takes: encrypted command and encrypted response */
+#define MF_CLASSIC_READ_KEYSTREAM_SIZE (MF_CLASSIC_CMD_SIZE + MF_CLASSIC_READ_RESPONSE_SIZE)
+/** Block is given up after that many failed READs */
+#define MF_CLASSIC_READ_RETRIES_MAX (2U)
+
 static uint8_t mf_classic_get_first_block_num_of_sector(uint8_t sector) {
     furi_assert(sector < 40);
     if(sector < 32) {
@@ -83,7 +93,7 @@ void mf_classic_reader_add_sector(
     furi_assert(sector < MF_CLASSIC_SECTORS_MAX);
     furi_assert((key_a != MF_CLASSIC_NO_KEY) || (key_b != MF_CLASSIC_NO_KEY));
 
-    if(reader->sectors_to_read < MF_CLASSIC_SECTORS_MAX - 1) {
+    if(reader->sectors_to_read < MF_CLASSIC_SECTORS_MAX) {
         reader->sector_reader[reader->sectors_to_read].key_a = key_a;
         reader->sector_reader[reader->sectors_to_read].key_b = key_b;
         reader->sector_reader[reader->sectors_to_read].sector_num = sector;
@@ -99,34 +109,102 @@ void mf_classic_auth_init_context(MfClassicAuthContext* auth_ctx, uint32_t cuid,
     auth_ctx->key_b = MF_CLASSIC_NO_KEY;
 }
 
+/** Card state shared by sectors read in a row */
+typedef struct {
+    Crypto1* crypto;
+    uint32_t cuid;
+    bool authenticated;
+    uint8_t selections;
+} MfClassicSession;
+
+/** Generate size keystream bytes, byte after them holds next keystream bit for last parity */
+static void mf_classic_keystream(Crypto1* crypto, uint8_t* keystream, size_t size) {
+    crypto1_keystream(crypto, keystream, size);
+    keystream[size] = crypto1_filter(crypto->odd);
+}
+
+/** Parity bit of encrypted byte is odd parity of plain byte encrypted with next keystream bit */
+static void mf_classic_encrypt(
+    const uint8_t* keystream,
+    const uint8_t* plain,
+    size_t size,
+    uint8_t* data,
+    uint8_t* parity) {
+    memset(parity, 0, (size + 7) / 8);
+    for(size_t i = 0; i < size; i++) {
+        data[i] = plain[i] ^ keystream[i];
+        parity[i / 8] |= ((keystream[i + 1] ^ nfc_util_odd_parity8(plain[i])) & 0x01)
+                         << (7 - i % 8);
+    }
+}
+
+/** Decrypt frame, return false on parity error */
+static bool mf_classic_decrypt(
+    const uint8_t* keystream,
+    const uint8_t* data,
+    const uint8_t* parity,
+    size_t size,
+    uint8_t* plain) {
+    uint8_t parity_error = 0;
+    for(size_t i = 0; i < size; i++) {
+        plain[i] = data[i] ^ keystream[i];
+        parity_error |= (FURI_BIT(parity[i / 8], 7 - i % 8) ^ keystream[i + 1] ^
+                         nfc_util_odd_parity8(plain[i])) &
+                        0x01;
+    }
+    return !parity_error;
+}
+
 static bool mf_classic_auth(
     FuriHalNfcTxRxContext* tx_rx,
     uint32_t cuid,
     uint32_t block,
     uint64_t key,
     MfClassicKey key_type,
-    Crypto1* crypto) {
+    Crypto1* crypto,
+    bool nested) {
     bool auth_success = false;
     memset(tx_rx, 0, sizeof(FuriHalNfcTxRxContext));
 
     do {
+        uint8_t auth_cmd[MF_CLASSIC_CMD_SIZE] = {};
         if(key_type == MfClassicKeyA) {
-            tx_rx->tx_data[0] = MF_CLASSIC_AUTH_KEY_A_CMD;
+            auth_cmd[0] = MF_CLASSIC_AUTH_KEY_A_CMD;
         } else {
-            tx_rx->tx_data[0] = MF_CLASSIC_AUTH_KEY_B_CMD;
+            auth_cmd[0] = MF_CLASSIC_AUTH_KEY_B_CMD;
+        }
+        auth_cmd[1] = block;
+
+        uint32_t nt;
+        if(nested) {
+            // Command goes in current session, nonce comes back encrypted with new key
+            uint8_t keystream[MF_CLASSIC_CMD_SIZE + 1];
+            nfca_append_crc16(auth_cmd, 2);
+            mf_classic_keystream(crypto, keystream, MF_CLASSIC_CMD_SIZE);
+            mf_classic_encrypt(
+                keystream, auth_cmd, MF_CLASSIC_CMD_SIZE, tx_rx->tx_data, tx_rx->tx_parity);
+            tx_rx->tx_rx_type = FURI_HAL_NFC_TXRX_RAW;
+            tx_rx->tx_bits = MF_CLASSIC_CMD_SIZE * 8;
+            if(!furi_hal_nfc_tx_rx(tx_rx)) break;
+            if(tx_rx->rx_bits != 32) break;
+
+            uint32_t nt_enc = (uint32_t)nfc_util_bytes2num(tx_rx->rx_data, 4);
+            crypto1_init(crypto, key);
+            nt = crypto1_word(crypto, nt_enc ^ cuid, 1) ^ nt_enc;
+        } else {
+            memcpy(tx_rx->tx_data, auth_cmd, 2);
+            tx_rx->tx_rx_type = FURI_HAL_NFC_TX_DEFAULT_RX_NO_CRC;
+            tx_rx->tx_bits = 2 * 8;
+            if(!furi_hal_nfc_tx_rx(tx_rx)) break;
+
+            nt = (uint32_t)nfc_util_bytes2num(tx_rx->rx_data, 4);
+            crypto1_init(crypto, key);
+            crypto1_word(crypto, nt ^ cuid, 0);
         }
-        tx_rx->tx_data[1] = block;
-        tx_rx->tx_rx_type = FURI_HAL_NFC_TX_DEFAULT_RX_NO_CRC;
-        tx_rx->tx_bits = 2 * 8;
-        if(!furi_hal_nfc_tx_rx(tx_rx)) break;
 
-        uint32_t nt = (uint32_t)nfc_util_bytes2num(tx_rx->rx_data, 4);
-        crypto1_init(crypto, key);
-        crypto1_word(crypto, nt ^ cuid, 0);
         uint8_t nr[4] = {};
-        // uint8_t parity = 0;
-        nfc_util_num2bytes(prng_successor(DWT->CYCCNT, 32), 4, nr);
-        // uint8_t nr_ar[8] = {};
+        nfc_util_num2bytes(prng_successor(furi_hal_random_get(), 32), 4, nr);
+        memset(tx_rx->tx_parity, 0, sizeof(tx_rx->tx_parity));
         for(uint8_t i = 0; i < 4; i++) {
             tx_rx->tx_data[i] = crypto1_byte(crypto, nr[i], 0) ^ nr[i];
             tx_rx->tx_parity[0] |=
@@ -152,6 +230,12 @@ static bool mf_classic_auth(
     return auth_success;
 }
 
+/** Select card again: card drops session after any failed command */
+static bool mf_classic_select(uint32_t* cuid) {
+    furi_hal_nfc_deactivate();
+    return furi_hal_nfc_activate_nfca(300, cuid);
+}
+
 bool mf_classic_auth_attempt(
     FuriHalNfcTxRxContext* tx_rx,
     MfClassicAuthContext* auth_ctx,
@@ -159,38 +243,41 @@ bool mf_classic_auth_attempt(
     furi_assert(tx_rx);
     furi_assert(auth_ctx);
     bool found_key = false;
-    bool need_halt = (auth_ctx->key_a == MF_CLASSIC_NO_KEY) &&
-                     (auth_ctx->key_b == MF_CLASSIC_NO_KEY);
+    bool need_select = false;
+    uint8_t block = mf_classic_get_first_block_num_of_sector(auth_ctx->sector);
 
-    Crypto1 crypto;
     if(auth_ctx->key_a == MF_CLASSIC_NO_KEY) {
         // Try AUTH with key A
-        if(mf_classic_auth(
-               tx_rx,
-               auth_ctx->cuid,
-               mf_classic_get_first_block_num_of_sector(auth_ctx->sector),
-               key,
-               MfClassicKeyA,
-               &crypto)) {
+        auth_ctx->authenticated = mf_classic_auth(
+            tx_rx,
+            auth_ctx->cuid,
+            block,
+            key,
+            MfClassicKeyA,
+            &auth_ctx->crypto,
+            auth_ctx->authenticated);
+        if(auth_ctx->authenticated) {
             auth_ctx->key_a = key;
             found_key = true;
+        } else {
+            need_select = true;
         }
     }
 
-    if(need_halt) {
-        furi_hal_nfc_deactivate();
-        furi_hal_nfc_activate_nfca(300, &auth_ctx->cuid);
-    }
-
     if(auth_ctx->key_b == MF_CLASSIC_NO_KEY) {
+        if(need_select && !mf_classic_select(&auth_ctx->cuid)) {
+            return found_key;
+        }
         // Try AUTH with key B
-        if(mf_classic_auth(
-               tx_rx,
-               auth_ctx->cuid,
-               mf_classic_get_first_block_num_of_sector(auth_ctx->sector),
-               key,
-               MfClassicKeyB,
-               &crypto)) {
+        auth_ctx->authenticated = mf_classic_auth(
+            tx_rx,
+            auth_ctx->cuid,
+            block,
+            key,
+            MfClassicKeyB,
+            &auth_ctx->crypto,
+            auth_ctx->authenticated);
+        if(auth_ctx->authenticated) {
             auth_ctx->key_b = key;
             found_key = true;
         }
@@ -199,78 +286,126 @@ bool mf_classic_auth_attempt(
     return found_key;
 }
 
-bool mf_classic_read_block(
+/** Read pending blocks of sector, all READ frames are encrypted before the first one is sent
+ *
+ * Keystream doesn't depend on data, so corrupted response leaves session in sync and reading
+ * goes on. Card drops session only when it doesn't answer.
+ *
+ * @return mask of blocks which failed
+ */
+static uint16_t mf_classic_read_blocks(
     FuriHalNfcTxRxContext* tx_rx,
-    Crypto1* crypto,
-    uint8_t block_num,
-    MfClassicBlock* block) {
-    furi_assert(tx_rx);
-    furi_assert(crypto);
-    furi_assert(block_num < MF_CLASSIC_TOTAL_BLOCKS_MAX);
-    furi_assert(block);
-
-    bool read_block_success = false;
-    uint8_t plain_cmd[4] = {MF_CLASSIC_READ_SECT_CMD, block_num, 0x00, 0x00};
-    nfca_append_crc16(plain_cmd, 2);
-    memset(tx_rx, 0, sizeof(FuriHalNfcTxRxContext));
+    MfClassicSession* session,
+    uint8_t first_block,
+    uint16_t* pending,
+    MfClassicSector* sector) {
+    uint8_t blocks[MF_CLASSIC_BLOCKS_IN_SECTOR_MAX];
+    uint8_t blocks_num = 0;
+    for(uint8_t i = 0; i < sector->total_blocks; i++) {
+        if(*pending & (1U << i)) blocks[blocks_num++] = i;
+    }
 
-    for(uint8_t i = 0; i < 4; i++) {
-        tx_rx->tx_data[i] = crypto1_byte(crypto, 0x00, 0) ^ plain_cmd[i];
-        tx_rx->tx_parity[0] |=
-            ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_cmd[i])) & 0x01) << (7 - i);
+    uint8_t keystream[MF_CLASSIC_BLOCKS_IN_SECTOR_MAX * MF_CLASSIC_READ_KEYSTREAM_SIZE + 1];
+    uint8_t frames[MF_CLASSIC_BLOCKS_IN_SECTOR_MAX][MF_CLASSIC_CMD_SIZE];
+    uint8_t frames_parity[MF_CLASSIC_BLOCKS_IN_SECTOR_MAX];
+    mf_classic_keystream(session->crypto, keystream, blocks_num * MF_CLASSIC_READ_KEYSTREAM_SIZE);
+    for(uint8_t i = 0; i < blocks_num; i++) {
+        uint8_t plain_cmd[MF_CLASSIC_CMD_SIZE] = {
+            MF_CLASSIC_READ_SECT_CMD, first_block + blocks[i]};
+        nfca_append_crc16(plain_cmd, 2);
+        mf_classic_encrypt(
+            &keystream[i * MF_CLASSIC_READ_KEYSTREAM_SIZE],
+            plain_cmd,
+            MF_CLASSIC_CMD_SIZE,
+            frames[i],
+            &frames_parity[i]);
     }
-    tx_rx->tx_bits = 4 * 9;
+
+    uint16_t failed = 0;
+    memset(tx_rx, 0, sizeof(FuriHalNfcTxRxContext));
     tx_rx->tx_rx_type = FURI_HAL_NFC_TXRX_RAW;
+    tx_rx->tx_bits = MF_CLASSIC_CMD_SIZE * 8;
+    for(uint8_t i = 0; i < blocks_num; i++) {
+        memcpy(tx_rx->tx_data, frames[i], MF_CLASSIC_CMD_SIZE);
+        tx_rx->tx_parity[0] = frames_parity[i];
+        if(!furi_hal_nfc_tx_rx(tx_rx) || tx_rx->rx_bits != MF_CLASSIC_READ_RESPONSE_SIZE * 8) {
+            // No answer or NAK: card is out of session, the rest is not sent
+            session->authenticated = false;
+            failed |= 1U << blocks[i];
+            break;
+        }
 
-    if(furi_hal_nfc_tx_rx(tx_rx)) {
-        if(tx_rx->rx_bits == 8 * 18) {
-            for(uint8_t i = 0; i < 18; i++) {
-                block->value[i] = crypto1_byte(crypto, 0, 0) ^ tx_rx->rx_data[i];
-            }
-            read_block_success = true;
+        uint8_t plain[MF_CLASSIC_READ_RESPONSE_SIZE];
+        const uint8_t* response_keystream =
+            &keystream[i * MF_CLASSIC_READ_KEYSTREAM_SIZE + MF_CLASSIC_CMD_SIZE];
+        if(mf_classic_decrypt(
+               response_keystream,
+               tx_rx->rx_data,
+               tx_rx->rx_parity,
+               MF_CLASSIC_READ_RESPONSE_SIZE,
+               plain) &&
+           nfca_get_crc16(plain, MF_CLASSIC_READ_RESPONSE_SIZE) == 0) {
+            memcpy(sector->block[blocks[i]].value, plain, MF_CLASSIC_BLOCK_SIZE);
+            *pending &= ~(1U << blocks[i]);
+        } else {
+            failed |= 1U << blocks[i];
         }
     }
-    return read_block_success;
+
+    return failed;
 }
 
-bool mf_classic_read_sector(
+/** Authenticate to sector and read it, card is selected only if session is lost */
+static bool mf_classic_read_sector_in_session(
     FuriHalNfcTxRxContext* tx_rx,
-    Crypto1* crypto,
+    MfClassicSession* session,
     MfClassicSectorReader* sector_reader,
     MfClassicSector* sector) {
-    furi_assert(tx_rx);
-    furi_assert(sector_reader);
-    furi_assert(sector);
-
-    uint32_t cuid = 0;
     uint64_t key;
     MfClassicKey key_type;
-    uint8_t first_block;
+    if(sector_reader->key_a != MF_CLASSIC_NO_KEY) {
+        key = sector_reader->key_a;
+        key_type = MfClassicKeyA;
+    } else if(sector_reader->key_b != MF_CLASSIC_NO_KEY) {
+        key = sector_reader->key_b;
+        key_type = MfClassicKeyB;
+    } else {
+        return false;
+    }
+
+    uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector_reader->sector_num);
+    sector->total_blocks = mf_classic_get_blocks_num_in_sector(sector_reader->sector_num);
+    uint16_t pending = (1UL << sector->total_blocks) - 1;
+    uint8_t failures[MF_CLASSIC_BLOCKS_IN_SECTOR_MAX] = {};
     bool sector_read = false;
 
-    furi_hal_nfc_deactivate();
-    do {
-        // Activate card
-        if(!furi_hal_nfc_activate_nfca(200, &cuid)) break;
-        first_block = mf_classic_get_first_block_num_of_sector(sector_reader->sector_num);
-        if(sector_reader->key_a != MF_CLASSIC_NO_KEY) {
-            key = sector_reader->key_a;
-            key_type = MfClassicKeyA;
-        } else if(sector_reader->key_b != MF_CLASSIC_NO_KEY) {
-            key = sector_reader->key_b;
-            key_type = MfClassicKeyB;
-        } else {
+    while(pending) {
+        if(!session->authenticated) {
+            session->selections++;
+            sector_reader->selections++;
+            if(!mf_classic_select(&session->cuid)) break;
+        }
+        bool nested = session->authenticated;
+        session->authenticated = mf_classic_auth(
+            tx_rx, session->cuid, first_block, key, key_type, session->crypto, nested);
+        if(!session->authenticated) {
+            // Nested auth failure may be a glitch, plain one with known key is final
+            if(nested) continue;
             break;
         }
+        sector_read = true;
 
-        // Auth to first block in sector
-        if(!mf_classic_auth(tx_rx, cuid, first_block, key, key_type, crypto)) break;
-        sector->total_blocks = mf_classic_get_blocks_num_in_sector(sector_reader->sector_num);
-
-        // Read blocks
+        uint16_t failed = mf_classic_read_blocks(tx_rx, session, first_block, &pending, sector);
         for(uint8_t i = 0; i < sector->total_blocks; i++) {
-            mf_classic_read_block(tx_rx, crypto, first_block + i, &sector->block[i]);
+            if((failed & (1U << i)) && (++failures[i] > MF_CLASSIC_READ_RETRIES_MAX)) {
+                FURI_LOG_D(TAG, "Block %d is not readable", first_block + i);
+                pending &= ~(1U << i);
+            }
         }
+    }
+
+    if(sector_read) {
+        sector_reader->blocks_read = ((1UL << sector->total_blocks) - 1) & ~pending;
         // Save sector keys in last block
         if(sector_reader->key_a != MF_CLASSIC_NO_KEY) {
             nfc_util_num2bytes(
@@ -280,13 +415,25 @@ bool mf_classic_read_sector(
             nfc_util_num2bytes(
                 sector_reader->key_b, 6, &sector->block[sector->total_blocks - 1].value[10]);
         }
-
-        sector_read = true;
-    } while(false);
+    }
 
     return sector_read;
 }
 
+bool mf_classic_read_sector(
+    FuriHalNfcTxRxContext* tx_rx,
+    Crypto1* crypto,
+    MfClassicSectorReader* sector_reader,
+    MfClassicSector* sector) {
+    furi_assert(tx_rx);
+    furi_assert(crypto);
+    furi_assert(sector_reader);
+    furi_assert(sector);
+
+    MfClassicSession session = {.crypto = crypto};
+    return mf_classic_read_sector_in_session(tx_rx, &session, sector_reader, sector);
+}
+
 uint8_t mf_classic_read_card(
     FuriHalNfcTxRxContext* tx_rx,
     MfClassicReader* reader,
@@ -297,18 +444,26 @@ uint8_t mf_classic_read_card(
 
     uint8_t sectors_read = 0;
     data->type = reader->type;
+    MfClassicSession session = {.crypto = &reader->crypto, .cuid = reader->cuid};
     MfClassicSector temp_sector = {};
     for(uint8_t i = 0; i < reader->sectors_to_read; i++) {
-        if(mf_classic_read_sector(
-               tx_rx, &reader->crypto, &reader->sector_reader[i], &temp_sector)) {
+        MfClassicSectorReader* sector_reader = &reader->sector_reader[i];
+        sector_reader->selections = 0;
+        sector_reader->blocks_read = 0;
+        uint32_t start = osKernelGetTickCount();
+        if(mf_classic_read_sector_in_session(tx_rx, &session, sector_reader, &temp_sector)) {
             uint8_t first_block =
-                mf_classic_get_first_block_num_of_sector(reader->sector_reader[i].sector_num);
+                mf_classic_get_first_block_num_of_sector(sector_reader->sector_num);
             for(uint8_t j = 0; j < temp_sector.total_blocks; j++) {
-                data->block[first_block + j] = temp_sector.block[j];
+                if(sector_reader->blocks_read & (1U << j)) {
+                    data->block[first_block + j] = temp_sector.block[j];
+                }
             }
             sectors_read++;
         }
+        sector_reader->read_time = osKernelGetTickCount() - start;
     }
+    reader->selections = session.selections;
 
     return sectors_read;
 }
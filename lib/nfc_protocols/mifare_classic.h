@@ -49,12 +49,19 @@ typedef struct {
     uint8_t sector;
     uint64_t key_a;
     uint64_t key_b;
+    /** Card is authenticated, next attempt is nested and needs no card selection */
+    bool authenticated;
+    Crypto1 crypto;
 } MfClassicAuthContext;
 
 typedef struct {
     uint8_t sector_num;
     uint64_t key_a;
     uint64_t key_b;
+    /** Filled by mf_classic_read_card: time in ms, card selections, mask of blocks read */
+    uint32_t read_time;
+    uint8_t selections;
+    uint16_t blocks_read;
 } MfClassicSectorReader;
 
 typedef struct {
@@ -63,6 +70,8 @@ typedef struct {
     uint8_t sectors_to_read;
     Crypto1 crypto;
     MfClassicSectorReader sector_reader[MF_CLASSIC_SECTORS_MAX];
+    /** Card selections done by mf_classic_read_card */
+    uint8_t selections;
 } MfClassicReader;
 
 bool mf_classic_check_card_type(uint8_t ATQA0, uint8_t ATQA1, uint8_t SAK);
@@ -77,8 +86,17 @@ bool mf_classic_get_type(
 
 uint8_t mf_classic_get_total_sectors_num(MfClassicReader* reader);
 
+/** Prepare context for keys search in sector
+ *
+ * Authenticated session is kept from previous sector, so context must be zeroed before first use
+ */
 void mf_classic_auth_init_context(MfClassicAuthContext* auth_ctx, uint32_t cuid, uint8_t sector);
 
+/** Try key as key A and key B of sector, whichever is not found yet
+ *
+ * Card is selected again only after failed attempt, successful one leaves card authenticated
+ * and the next attempt goes nested.
+ */
 bool mf_classic_auth_attempt(
     FuriHalNfcTxRxContext* tx_rx,
     MfClassicAuthContext* auth_ctx,
@@ -90,12 +108,21 @@ void mf_classic_reader_add_sector(
     uint64_t key_a,
     uint64_t key_b);
 
+/** Select card and read sector */
 bool mf_classic_read_sector(
     FuriHalNfcTxRxContext* tx_rx,
     Crypto1* crypto,
     MfClassicSectorReader* sector_reader,
     MfClassicSector* sector);
 
+/** Read all sectors added to reader
+ *
+ * Card is selected once and stays authenticated: each next sector is entered with nested
+ * authentication. All READ frames of sector are encrypted at once and only failed blocks are
+ * read again. Read time and selections of each sector are saved in sector reader.
+ *
+ * @return number of sectors read
+ */
 uint8_t mf_classic_read_card(
     FuriHalNfcTxRxContext* tx_rx,
     MfClassicReader* reader,
@@ -152,8 +152,29 @@ uint16_t mf_ul_prepare_write(uint8_t* dest, uint16_t page_addr, uint32_t data) {
     return 6;
 }
 
+/** Copy page to read image, mask auth data, keep roll-over copy in sync */
+static void mf_ul_update_read_image(MifareUlDevice* mf_ul_emulate, uint16_t page) {
+    uint16_t page_num = mf_ul_emulate->data.data_size / 4;
+    uint8_t* image_page = &mf_ul_emulate->read_image[page * 4];
+    memcpy(image_page, &mf_ul_emulate->data.data[page * 4], 4);
+
+    if(mf_ul_emulate->data.type >= MfUltralightTypeNTAG213) {
+        uint16_t pwd_page = page_num - 2;
+        uint16_t pack_page = pwd_page + 1;
+        if(page == pwd_page) {
+            memset(image_page, 0, 4);
+        } else if(page == pack_page) {
+            memset(image_page, 0, 2);
+        }
+    }
+    if(page < MF_UL_READ_WRAP_PAGES) {
+        memcpy(&mf_ul_emulate->read_image[(page_num + page) * 4], image_page, 4);
+    }
+}
+
 void mf_ul_prepare_emulation(MifareUlDevice* mf_ul_emulate, MifareUlData* data) {
     mf_ul_emulate->data = *data;
+    mf_ul_emulate->read_image = malloc(MF_UL_MAX_DUMP_SIZE + MF_UL_READ_WRAP_PAGES * 4);
     mf_ul_emulate->auth_data = NULL;
     mf_ul_emulate->data_changed = false;
     mf_ul_emulate->comp_write_cmd_started = false;
@@ -181,25 +202,20 @@ void mf_ul_prepare_emulation(MifareUlDevice* mf_ul_emulate, MifareUlData* data)
         uint16_t pwd_page = (data->data_size / 4) - 2;
         mf_ul_emulate->auth_data = (MifareUlAuthData*)&data->data[pwd_page * 4];
     }
-}
 
-void mf_ul_protect_auth_data_on_read_command(
-    uint8_t* tx_buff,
-    uint8_t start_page,
-    uint8_t end_page,
-    MifareUlDevice* mf_ul_emulate) {
-    if(mf_ul_emulate->data.type >= MfUltralightTypeNTAG213) {
-        uint8_t pwd_page = (mf_ul_emulate->data.data_size / 4) - 2;
-        uint8_t pack_page = pwd_page + 1;
-        if((start_page <= pwd_page) && (end_page >= pwd_page)) {
-            memset(&tx_buff[(pwd_page - start_page) * 4], 0, 4);
-        }
-        if((start_page <= pack_page) && (end_page >= pack_page)) {
-            memset(&tx_buff[(pack_page - start_page) * 4], 0, 2);
-        }
+    // Reader has a few hundred microseconds for answer, prepare READ responses now
+    uint16_t page_num = MAX(data->data_size / 4, MF_UL_READ_WRAP_PAGES);
+    for(uint16_t page = 0; page < page_num; page++) {
+        mf_ul_update_read_image(mf_ul_emulate, page);
     }
 }
 
+void mf_ul_free_emulation(MifareUlDevice* mf_ul_emulate) {
+    furi_assert(mf_ul_emulate->read_image);
+    free(mf_ul_emulate->read_image);
+    mf_ul_emulate->read_image = NULL;
+}
+
 bool mf_ul_prepare_emulation_response(
     uint8_t* buff_rx,
     uint16_t buff_rx_len,
@@ -220,6 +236,7 @@ bool mf_ul_prepare_emulation_response(
         // Compatibility write is the only one composit command
         if(buff_rx_len == 16) {
             memcpy(&mf_ul_emulate->data.data[mf_ul_emulate->comp_write_page_addr * 4], buff_rx, 4);
+            mf_ul_update_read_image(mf_ul_emulate, mf_ul_emulate->comp_write_page_addr);
             mf_ul_emulate->data_changed = true;
             // Send ACK message
             buff_tx[0] = 0x0A;
@@ -238,20 +255,9 @@ bool mf_ul_prepare_emulation_response(
     } else if(cmd == MF_UL_READ_CMD) {
         uint8_t start_page = buff_rx[1];
         if(start_page < page_num) {
+            // Roll-over pages follow the last page in read image
             tx_bytes = 16;
-            if(start_page + 4 > page_num) {
-                // Handle roll-over mechanism
-                uint8_t end_pages_num = page_num - start_page;
-                memcpy(buff_tx, &mf_ul_emulate->data.data[start_page * 4], end_pages_num * 4);
-                memcpy(
-                    &buff_tx[end_pages_num * 4],
-                    mf_ul_emulate->data.data,
-                    (4 - end_pages_num) * 4);
-            } else {
-                memcpy(buff_tx, &mf_ul_emulate->data.data[start_page * 4], tx_bytes);
-            }
-            mf_ul_protect_auth_data_on_read_command(
-                buff_tx, start_page, (start_page + 4), mf_ul_emulate);
+            memcpy(buff_tx, &mf_ul_emulate->read_image[start_page * 4], tx_bytes);
             *data_type = FURI_HAL_NFC_TXRX_DEFAULT;
             command_parsed = true;
         }
@@ -261,9 +267,7 @@ bool mf_ul_prepare_emulation_response(
             uint8_t end_page = buff_rx[2];
             if((start_page < page_num) && (end_page < page_num) && (start_page < (end_page + 1))) {
                 tx_bytes = ((end_page + 1) - start_page) * 4;
-                memcpy(buff_tx, &mf_ul_emulate->data.data[start_page * 4], tx_bytes);
-                mf_ul_protect_auth_data_on_read_command(
-                    buff_tx, start_page, end_page, mf_ul_emulate);
+                memcpy(buff_tx, &mf_ul_emulate->read_image[start_page * 4], tx_bytes);
                 *data_type = FURI_HAL_NFC_TXRX_DEFAULT;
                 command_parsed = true;
             }
@@ -272,6 +276,7 @@ bool mf_ul_prepare_emulation_response(
         uint8_t write_page = buff_rx[1];
         if((write_page > 1) && (write_page < page_num - 2)) {
             memcpy(&mf_ul_emulate->data.data[write_page * 4], &buff_rx[2], 4);
+            mf_ul_update_read_image(mf_ul_emulate, write_page);
             mf_ul_emulate->data_changed = true;
             // ACK
             buff_tx[0] = 0x0A;
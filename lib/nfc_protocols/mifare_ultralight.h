@@ -5,6 +5,8 @@
 #include <string.h>
 
 #define MF_UL_MAX_DUMP_SIZE 1024
+/** READ returns 4 pages, rolling over to page 0 after the last page */
+#define MF_UL_READ_WRAP_PAGES 3
 
 #define MF_UL_TEARING_FLAG_DEFAULT (0xBD)
 
@@ -81,6 +83,10 @@ typedef struct {
     MifareUlAuthData* auth_data;
     bool comp_write_cmd_started;
     uint8_t comp_write_page_addr;
+    /** Emulation: pages as reader sees them, with auth pages masked and first pages
+     * repeated after the last one, so READ and FAST_READ are a single copy.
+     * Allocated by mf_ul_prepare_emulation, reader doesn't carry it on stack */
+    uint8_t* read_image;
 } MifareUlDevice;
 
 bool mf_ul_check_card_type(uint8_t ATQA0, uint8_t ATQA1, uint8_t SAK);
@@ -116,6 +122,7 @@ void mf_ul_parse_fast_read_response(
 uint16_t mf_ul_prepare_write(uint8_t* dest, uint16_t page_addr, uint32_t data);
 
 void mf_ul_prepare_emulation(MifareUlDevice* mf_ul_emulate, MifareUlData* data);
+void mf_ul_free_emulation(MifareUlDevice* mf_ul_emulate);
 bool mf_ul_prepare_emulation_response(
     uint8_t* buff_rx,
     uint16_t buff_rx_len,
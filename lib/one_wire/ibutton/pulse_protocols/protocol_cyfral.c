@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <furi/check.h>
+#include <furi/common_defines.h>
 #include <furi_hal_delay.h>
 
 #define CYFRAL_DATA_SIZE 2
@@ -12,6 +13,11 @@ typedef enum {
     CYFRAL_BIT_WAIT_FRONT_LOW,
 } CyfralBitState;
 
+typedef enum {
+    CYFRAL_TIMING_VALID,
+    CYFRAL_TIMING_TOO_LONG,
+} CyfralTiming;
+
 typedef enum {
     CYFRAL_WAIT_START_NIBBLE,
     CYFRAL_READ_NIBBLE,
@@ -24,13 +30,14 @@ struct ProtocolCyfral {
     CyfralState state;
     CyfralBitState bit_state;
 
+    // period thresholds for the decoder front end, 230us x clock per us
+    uint32_t timings[1];
+
     // ready flag, key is read and valid
     // TODO: atomic access
     bool ready;
     // key data storage
     uint16_t key_data;
-    // high + low period time
-    uint32_t period_time;
     // temporary nibble storage
     uint8_t nibble;
     // data valid flag
@@ -40,11 +47,9 @@ struct ProtocolCyfral {
     uint8_t index;
     // bit index in nibble, 4 bit per nibble
     uint8_t bit_index;
-    // max period, 230us x clock per us
-    uint32_t max_period;
 };
 
-static void cyfral_pulse(void* context, bool polarity, uint32_t length);
+static bool cyfral_symbol(void* context, const PulseSymbol* symbol);
 static void cyfral_reset(void* context);
 static void cyfral_get_data(void* context, uint8_t* data, size_t length);
 static bool cyfral_decoded(void* context);
@@ -53,10 +58,12 @@ ProtocolCyfral* protocol_cyfral_alloc() {
     ProtocolCyfral* cyfral = malloc(sizeof(ProtocolCyfral));
     cyfral_reset(cyfral);
 
+    cyfral->timings[0] = CYFRAL_MAX_PERIOD_US * instructions_per_us;
     cyfral->protocol = pulse_protocol_alloc();
 
     pulse_protocol_set_context(cyfral->protocol, cyfral);
-    pulse_protocol_set_pulse_cb(cyfral->protocol, cyfral_pulse);
+    pulse_protocol_set_symbol_cb(cyfral->protocol, cyfral_symbol);
+    pulse_protocol_set_timings(cyfral->protocol, cyfral->timings, COUNT_OF(cyfral->timings));
     pulse_protocol_set_reset_cb(cyfral->protocol, cyfral_reset);
     pulse_protocol_set_get_data_cb(cyfral->protocol, cyfral_get_data);
     pulse_protocol_set_decoded_cb(cyfral->protocol, cyfral_decoded);
@@ -95,7 +102,6 @@ static void cyfral_reset(void* context) {
     cyfral->state = CYFRAL_WAIT_START_NIBBLE;
     cyfral->bit_state = CYFRAL_BIT_WAIT_FRONT_LOW;
 
-    cyfral->period_time = 0;
     cyfral->bit_index = 0;
     cyfral->ready = false;
     cyfral->index = 0;
@@ -103,28 +109,23 @@ static void cyfral_reset(void* context) {
     cyfral->key_data = 0;
     cyfral->nibble = 0;
     cyfral->data_valid = true;
-
-    cyfral->max_period = CYFRAL_MAX_PERIOD_US * instructions_per_us;
 }
 
 static bool cyfral_process_bit(
     ProtocolCyfral* cyfral,
-    bool polarity,
-    uint32_t length,
+    const PulseSymbol* symbol,
     bool* bit_ready,
     bool* bit_value) {
     bool result = true;
     *bit_ready = false;
 
-    // bit start from low
+    // bit start from low, symbol period is high + low time
     switch(cyfral->bit_state) {
     case CYFRAL_BIT_WAIT_FRONT_LOW:
-        if(polarity == true) {
-            cyfral->period_time += length;
-
+        if(symbol->polarity == true) {
             *bit_ready = true;
-            if(cyfral->period_time <= cyfral->max_period) {
-                if((cyfral->period_time / 2) > length) {
+            if(symbol->timing == CYFRAL_TIMING_VALID) {
+                if((symbol->period / 2) > symbol->length) {
                     *bit_value = false;
                 } else {
                     *bit_value = true;
@@ -139,8 +140,7 @@ static bool cyfral_process_bit(
         }
         break;
     case CYFRAL_BIT_WAIT_FRONT_HIGH:
-        if(polarity == false) {
-            cyfral->period_time = length;
+        if(symbol->polarity == false) {
             cyfral->bit_state = CYFRAL_BIT_WAIT_FRONT_LOW;
         } else {
             result = false;
@@ -151,19 +151,19 @@ static bool cyfral_process_bit(
     return result;
 }
 
-static void cyfral_pulse(void* context, bool polarity, uint32_t length) {
+static bool cyfral_symbol(void* context, const PulseSymbol* symbol) {
     furi_assert(context);
     ProtocolCyfral* cyfral = context;
 
     bool bit_ready;
     bool bit_value;
 
-    if(cyfral->ready) return;
+    if(cyfral->ready) return false;
 
     switch(cyfral->state) {
     case CYFRAL_WAIT_START_NIBBLE:
         // wait for start word
-        if(cyfral_process_bit(cyfral, polarity, length, &bit_ready, &bit_value)) {
+        if(cyfral_process_bit(cyfral, symbol, &bit_ready, &bit_value)) {
             if(bit_ready) {
                 cyfral->nibble = ((cyfral->nibble << 1) | bit_value) & 0x0F;
                 if(cyfral->nibble == 0b0001) {
@@ -178,7 +178,7 @@ static void cyfral_pulse(void* context, bool polarity, uint32_t length) {
         break;
     case CYFRAL_READ_NIBBLE:
         // read nibbles
-        if(cyfral_process_bit(cyfral, polarity, length, &bit_ready, &bit_value)) {
+        if(cyfral_process_bit(cyfral, symbol, &bit_ready, &bit_value)) {
             if(bit_ready) {
                 cyfral->nibble = (cyfral->nibble << 1) | bit_value;
 
@@ -220,7 +220,7 @@ static void cyfral_pulse(void* context, bool polarity, uint32_t length) {
         break;
     case CYFRAL_READ_STOP_NIBBLE:
         // read stop nibble
-        if(cyfral_process_bit(cyfral, polarity, length, &bit_ready, &bit_value)) {
+        if(cyfral_process_bit(cyfral, symbol, &bit_ready, &bit_value)) {
             if(bit_ready) {
                 cyfral->nibble = ((cyfral->nibble << 1) | bit_value) & 0x0F;
                 cyfral->bit_index++;
@@ -253,4 +253,6 @@ static void cyfral_pulse(void* context, bool polarity, uint32_t length) {
         }
         break;
     }
+
+    return cyfral->ready;
 }
@@ -15,17 +15,11 @@ typedef enum {
     METAKOM_READ_STOP_WORD,
 } MetakomState;
 
-typedef enum {
-    METAKOM_BIT_WAIT_FRONT_HIGH,
-    METAKOM_BIT_WAIT_FRONT_LOW,
-} MetakomBitState;
-
 struct ProtocolMetakom {
     PulseProtocol* protocol;
 
     // high + low period time
     uint32_t period_time;
-    uint32_t low_time_storage;
     uint8_t period_sample_index;
     uint32_t period_sample_data[METAKOM_PERIOD_SAMPLE_COUNT];
 
@@ -39,11 +33,10 @@ struct ProtocolMetakom {
     uint32_t key_data;
     uint8_t key_data_index;
 
-    MetakomBitState bit_state;
     MetakomState state;
 };
 
-static void metakom_pulse(void* context, bool polarity, uint32_t length);
+static bool metakom_symbol(void* context, const PulseSymbol* symbol);
 static void metakom_reset(void* context);
 static void metakom_get_data(void* context, uint8_t* data, size_t length);
 static bool metakom_decoded(void* context);
@@ -55,7 +48,7 @@ ProtocolMetakom* protocol_metakom_alloc() {
     metakom->protocol = pulse_protocol_alloc();
 
     pulse_protocol_set_context(metakom->protocol, metakom);
-    pulse_protocol_set_pulse_cb(metakom->protocol, metakom_pulse);
+    pulse_protocol_set_symbol_cb(metakom->protocol, metakom_symbol);
     pulse_protocol_set_reset_cb(metakom->protocol, metakom_reset);
     pulse_protocol_set_get_data_cb(metakom->protocol, metakom_get_data);
     pulse_protocol_set_decoded_cb(metakom->protocol, metakom_decoded);
@@ -101,10 +94,8 @@ static void metakom_reset(void* context) {
         metakom->period_sample_data[i] = 0;
     };
     metakom->state = METAKOM_WAIT_PERIOD_SYNC;
-    metakom->bit_state = METAKOM_BIT_WAIT_FRONT_LOW;
     metakom->key_data = 0;
     metakom->key_data_index = 0;
-    metakom->low_time_storage = 0;
 }
 
 static bool metakom_parity_check(uint8_t data) {
@@ -123,45 +114,33 @@ static bool metakom_parity_check(uint8_t data) {
 }
 
 static bool metakom_process_bit(
-    ProtocolMetakom* metakom,
-    bool polarity,
-    uint32_t time,
+    const PulseSymbol* symbol,
     uint32_t* high_time,
     uint32_t* low_time) {
     bool result = false;
 
-    switch(metakom->bit_state) {
-    case METAKOM_BIT_WAIT_FRONT_LOW:
-        if(polarity == false) {
-            *low_time = metakom->low_time_storage;
-            *high_time = time;
-            result = true;
-            metakom->bit_state = METAKOM_BIT_WAIT_FRONT_HIGH;
-        }
-        break;
-    case METAKOM_BIT_WAIT_FRONT_HIGH:
-        if(polarity == true) {
-            metakom->low_time_storage = time;
-            metakom->bit_state = METAKOM_BIT_WAIT_FRONT_LOW;
-        }
-        break;
+    // bit ends on the falling edge, symbol period is low + high time
+    if(symbol->polarity == false) {
+        *high_time = symbol->length;
+        *low_time = symbol->period - symbol->length;
+        result = true;
     }
 
     return result;
 }
 
-static void metakom_pulse(void* context, bool polarity, uint32_t time) {
+static bool metakom_symbol(void* context, const PulseSymbol* symbol) {
     furi_assert(context);
     ProtocolMetakom* metakom = context;
 
-    if(metakom->ready) return;
+    if(metakom->ready) return false;
 
     uint32_t high_time = 0;
     uint32_t low_time = 0;
 
     switch(metakom->state) {
     case METAKOM_WAIT_PERIOD_SYNC:
-        if(metakom_process_bit(metakom, polarity, time, &high_time, &low_time)) {
+        if(metakom_process_bit(symbol, &high_time, &low_time)) {
             metakom->period_sample_data[metakom->period_sample_index] = high_time + low_time;
             metakom->period_sample_index++;
 
@@ -177,7 +156,7 @@ static void metakom_pulse(void* context, bool polarity, uint32_t time) {
 
         break;
     case METAKOM_WAIT_START_BIT:
-        if(metakom_process_bit(metakom, polarity, time, &high_time, &low_time)) {
+        if(metakom_process_bit(symbol, &high_time, &low_time)) {
             metakom->tmp_counter++;
             if(high_time > metakom->period_time) {
                 metakom->tmp_counter = 0;
@@ -191,7 +170,7 @@ static void metakom_pulse(void* context, bool polarity, uint32_t time) {
 
         break;
     case METAKOM_WAIT_START_WORD:
-        if(metakom_process_bit(metakom, polarity, time, &high_time, &low_time)) {
+        if(metakom_process_bit(symbol, &high_time, &low_time)) {
             if(low_time < (metakom->period_time / 2)) {
                 metakom->tmp_data = (metakom->tmp_data << 1) | 0b0;
             } else {
@@ -211,7 +190,7 @@ static void metakom_pulse(void* context, bool polarity, uint32_t time) {
         }
         break;
     case METAKOM_READ_WORD:
-        if(metakom_process_bit(metakom, polarity, time, &high_time, &low_time)) {
+        if(metakom_process_bit(symbol, &high_time, &low_time)) {
             if(low_time < (metakom->period_time / 2)) {
                 metakom->tmp_data = (metakom->tmp_data << 1) | 0b0;
             } else {
@@ -241,7 +220,7 @@ static void metakom_pulse(void* context, bool polarity, uint32_t time) {
         }
         break;
     case METAKOM_READ_STOP_WORD:
-        if(metakom_process_bit(metakom, polarity, time, &high_time, &low_time)) {
+        if(metakom_process_bit(symbol, &high_time, &low_time)) {
             if(low_time < (metakom->period_time / 2)) {
                 metakom->tmp_data = (metakom->tmp_data << 1) | 0b0;
             } else {
@@ -259,4 +238,6 @@ static void metakom_pulse(void* context, bool polarity, uint32_t time) {
         }
         break;
     }
+
+    return metakom->ready;
 }
@@ -3,64 +3,137 @@
 #include <string.h>
 #include <furi/check.h>
 
-#define MAX_PROTOCOL 5
+typedef struct {
+    PulseProtocol* protocol;
+    int32_t index;
+    // merged timing class -> protocol timing class
+    uint8_t timing_map[PULSE_DECODER_TIMINGS_MAX + 1];
+} PulseDecoderSlot;
 
 struct PulseDecoder {
-    PulseProtocol* protocols[MAX_PROTOCOL];
+    PulseDecoderSlot* slots;
+    size_t slots_count;
+
+    // ascending, unique thresholds of all protocols
+    uint32_t timings[PULSE_DECODER_TIMINGS_MAX];
+    size_t timings_count;
+
+    uint32_t last_length;
+    volatile int32_t decoded_index;
 };
 
 PulseDecoder* pulse_decoder_alloc() {
     PulseDecoder* decoder = malloc(sizeof(PulseDecoder));
     memset(decoder, 0, sizeof(PulseDecoder));
+    decoder->decoded_index = -1;
     return decoder;
 }
 
 void pulse_decoder_free(PulseDecoder* reader) {
     furi_assert(reader);
+    free(reader->slots);
     free(reader);
 }
 
+static void pulse_decoder_merge_timings(PulseDecoder* reader, PulseProtocol* protocol) {
+    size_t count;
+    const uint32_t* thresholds = pulse_protocol_get_timings(protocol, &count);
+
+    for(size_t i = 0; i < count; i++) {
+        size_t pos = 0;
+        while(pos < reader->timings_count && reader->timings[pos] < thresholds[i]) pos++;
+        if(pos < reader->timings_count && reader->timings[pos] == thresholds[i]) continue;
+
+        furi_check(reader->timings_count < PULSE_DECODER_TIMINGS_MAX);
+        memmove(
+            &reader->timings[pos + 1],
+            &reader->timings[pos],
+            (reader->timings_count - pos) * sizeof(uint32_t));
+        reader->timings[pos] = thresholds[i];
+        reader->timings_count++;
+    }
+}
+
+static void pulse_decoder_build_timing_map(PulseDecoder* reader, PulseDecoderSlot* slot) {
+    size_t count;
+    const uint32_t* thresholds = pulse_protocol_get_timings(slot->protocol, &count);
+
+    // merged class N covers (timings[N-1], timings[N]], every protocol
+    // threshold is in the merged table, so the protocol class is exact
+    slot->timing_map[0] = 0;
+    for(size_t merged = 1; merged <= reader->timings_count; merged++) {
+        uint8_t local = 0;
+        while(local < count && thresholds[local] <= reader->timings[merged - 1]) local++;
+        slot->timing_map[merged] = local;
+    }
+}
+
 void pulse_decoder_add_protocol(PulseDecoder* reader, PulseProtocol* protocol, int32_t index) {
-    furi_check(index < MAX_PROTOCOL);
-    furi_check(reader->protocols[index] == NULL);
-    reader->protocols[index] = protocol;
+    furi_assert(reader);
+    furi_check(index >= 0);
+    for(size_t i = 0; i < reader->slots_count; i++) {
+        furi_check(reader->slots[i].index != index);
+    }
+
+    reader->slots = realloc(reader->slots, (reader->slots_count + 1) * sizeof(PulseDecoderSlot));
+    reader->slots[reader->slots_count].protocol = protocol;
+    reader->slots[reader->slots_count].index = index;
+    reader->slots_count++;
+
+    // merged table indexes shift on insert, rebuild every map
+    pulse_decoder_merge_timings(reader, protocol);
+    for(size_t i = 0; i < reader->slots_count; i++) {
+        pulse_decoder_build_timing_map(reader, &reader->slots[i]);
+    }
 }
 
 void pulse_decoder_process_pulse(PulseDecoder* reader, bool polarity, uint32_t length) {
     furi_assert(reader);
-    for(size_t index = 0; index < MAX_PROTOCOL; index++) {
-        if(reader->protocols[index] != NULL) {
-            pulse_protocol_process_pulse(reader->protocols[index], polarity, length);
+    if(reader->decoded_index >= 0) return;
+
+    PulseSymbol symbol = {
+        .polarity = polarity,
+        .length = length,
+        .period = reader->last_length + length,
+    };
+    reader->last_length = length;
+
+    uint8_t timing = 0;
+    while(timing < reader->timings_count && symbol.period > reader->timings[timing]) timing++;
+
+    for(size_t i = 0; i < reader->slots_count; i++) {
+        PulseDecoderSlot* slot = &reader->slots[i];
+        symbol.timing = slot->timing_map[timing];
+        if(pulse_protocol_process_symbol(slot->protocol, &symbol)) {
+            reader->decoded_index = slot->index;
+            break;
         }
     }
 }
 
 int32_t pulse_decoder_get_decoded_index(PulseDecoder* reader) {
     furi_assert(reader);
-    int32_t decoded = -1;
-    for(size_t index = 0; index < MAX_PROTOCOL; index++) {
-        if(reader->protocols[index] != NULL) {
-            if(pulse_protocol_decoded(reader->protocols[index])) {
-                decoded = index;
-                break;
-            }
-        }
-    }
-
-    return decoded;
+    return reader->decoded_index;
 }
 
 void pulse_decoder_reset(PulseDecoder* reader) {
     furi_assert(reader);
-    for(size_t index = 0; index < MAX_PROTOCOL; index++) {
-        if(reader->protocols[index] != NULL) {
-            pulse_protocol_reset(reader->protocols[index]);
-        }
+    for(size_t i = 0; i < reader->slots_count; i++) {
+        pulse_protocol_reset(reader->slots[i].protocol);
     }
+    reader->last_length = 0;
+    reader->decoded_index = -1;
 }
 
 void pulse_decoder_get_data(PulseDecoder* reader, int32_t index, uint8_t* data, size_t length) {
     furi_assert(reader);
-    furi_check(reader->protocols[index] != NULL);
-    pulse_protocol_get_data(reader->protocols[index], data, length);
+    PulseProtocol* protocol = NULL;
+    for(size_t i = 0; i < reader->slots_count; i++) {
+        if(reader->slots[i].index == index) {
+            protocol = reader->slots[i].protocol;
+            break;
+        }
+    }
+    furi_check(protocol != NULL);
+    pulse_protocol_get_data(protocol, data, length);
 }
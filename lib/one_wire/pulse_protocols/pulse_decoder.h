@@ -13,6 +13,9 @@
 extern "C" {
 #endif
 
+/** Max count of unique timing thresholds of all protocols in one decoder */
+#define PULSE_DECODER_TIMINGS_MAX 8
+
 typedef struct PulseDecoder PulseDecoder;
 
 /**
@@ -28,7 +31,7 @@ PulseDecoder* pulse_decoder_alloc();
 void pulse_decoder_free(PulseDecoder* decoder);
 
 /**
- * Add protocol to decoder
+ * Add protocol to decoder, protocol count is not limited
  * @param decoder 
  * @param protocol protocol implementation
  * @param index protocol index, should not be repeated
@@ -37,9 +40,11 @@ void pulse_decoder_add_protocol(PulseDecoder* decoder, PulseProtocol* protocol,
 
 /**
  * Push and process pulse with decoder
+ * Pulse is classified once and passed to protocols as PulseSymbol,
+ * processing stops on the first protocol that decoded data until reset
  * @param decoder 
- * @param polarity 
- * @param length 
+ * @param polarity level after the edge
+ * @param length duration of the level that just ended
  */
 void pulse_decoder_process_pulse(PulseDecoder* decoder, bool polarity, uint32_t length);
 
@@ -4,10 +4,12 @@
 
 struct PulseProtocol {
     void* context;
-    PulseProtocolPulseCallback pulse_cb;
+    PulseProtocolSymbolCallback symbol_cb;
     PulseProtocolResetCallback reset_cb;
     PulseProtocolGetDataCallback get_data_cb;
     PulseProtocolDecodedCallback decoded_cb;
+    const uint32_t* timings;
+    size_t timings_count;
 };
 
 PulseProtocol* pulse_protocol_alloc() {
@@ -20,8 +22,18 @@ void pulse_protocol_set_context(PulseProtocol* protocol, void* context) {
     protocol->context = context;
 }
 
-void pulse_protocol_set_pulse_cb(PulseProtocol* protocol, PulseProtocolPulseCallback callback) {
-    protocol->pulse_cb = callback;
+void pulse_protocol_set_symbol_cb(PulseProtocol* protocol, PulseProtocolSymbolCallback callback) {
+    protocol->symbol_cb = callback;
+}
+
+void pulse_protocol_set_timings(PulseProtocol* protocol, const uint32_t* thresholds, size_t count) {
+    protocol->timings = thresholds;
+    protocol->timings_count = count;
+}
+
+const uint32_t* pulse_protocol_get_timings(PulseProtocol* protocol, size_t* count) {
+    *count = protocol->timings_count;
+    return protocol->timings;
 }
 
 void pulse_protocol_set_reset_cb(PulseProtocol* protocol, PulseProtocolResetCallback callback) {
@@ -40,10 +52,12 @@ void pulse_protocol_free(PulseProtocol* protocol) {
     free(protocol);
 }
 
-void pulse_protocol_process_pulse(PulseProtocol* protocol, bool polarity, uint32_t length) {
-    if(protocol->pulse_cb != NULL) {
-        protocol->pulse_cb(protocol->context, polarity, length);
+bool pulse_protocol_process_symbol(PulseProtocol* protocol, const PulseSymbol* symbol) {
+    bool result = false;
+    if(protocol->symbol_cb != NULL) {
+        result = protocol->symbol_cb(protocol->context, symbol);
     }
+    return result;
 }
 
 void pulse_protocol_reset(PulseProtocol* protocol) {
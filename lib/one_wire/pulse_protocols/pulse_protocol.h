@@ -19,9 +19,20 @@ extern "C" {
 typedef struct PulseProtocol PulseProtocol;
 
 /**
- * Process pulse callback
+ * Pulse symbol, built once per pulse by the decoder front end and shared by all protocols
  */
-typedef void (*PulseProtocolPulseCallback)(void* context, bool polarity, uint32_t length);
+typedef struct {
+    bool polarity; /**< level after the edge */
+    uint32_t length; /**< duration of the level that just ended */
+    uint32_t period; /**< length plus duration of the level before it */
+    uint8_t timing; /**< period class: count of protocol timing thresholds the period exceeds */
+} PulseSymbol;
+
+/**
+ * Process symbol callback
+ * @return true if the protocol has just decoded data
+ */
+typedef bool (*PulseProtocolSymbolCallback)(void* context, const PulseSymbol* symbol);
 
 /**
  * Reset protocol callback
@@ -58,11 +69,28 @@ void pulse_protocol_free(PulseProtocol* protocol);
 void pulse_protocol_set_context(PulseProtocol* protocol, void* context);
 
 /**
- * Set "Process pulse" callback. Called from the decoder when a new pulse is received.
+ * Set "Process symbol" callback. Called from the decoder when a new pulse is received.
  * @param protocol 
  * @param callback 
  */
-void pulse_protocol_set_pulse_cb(PulseProtocol* protocol, PulseProtocolPulseCallback callback);
+void pulse_protocol_set_symbol_cb(PulseProtocol* protocol, PulseProtocolSymbolCallback callback);
+
+/**
+ * Set period timing thresholds. The decoder classifies the period of every pulse
+ * against thresholds of all protocols once and passes a protocol local class in PulseSymbol.
+ * @param protocol 
+ * @param thresholds ascending thresholds in CPU cycles, must outlive the protocol
+ * @param count thresholds count
+ */
+void pulse_protocol_set_timings(PulseProtocol* protocol, const uint32_t* thresholds, size_t count);
+
+/**
+ * Get period timing thresholds
+ * @param protocol 
+ * @param count thresholds count
+ * @return const uint32_t* thresholds, NULL if not set
+ */
+const uint32_t* pulse_protocol_get_timings(PulseProtocol* protocol, size_t* count);
 
 /**
  * Set "Reset protocol" callback. Called from the decoder when the decoder is reset.
@@ -88,10 +116,10 @@ void pulse_protocol_set_decoded_cb(PulseProtocol* protocol, PulseProtocolDecoded
 /**
  * Part of decoder interface.
  * @param protocol 
- * @param polarity 
- * @param length 
+ * @param symbol 
+ * @return true if the protocol has just decoded data
  */
-void pulse_protocol_process_pulse(PulseProtocol* protocol, bool polarity, uint32_t length);
+bool pulse_protocol_process_symbol(PulseProtocol* protocol, const PulseSymbol* symbol);
 
 /**
  * Part of decoder interface.
@@ -1,13 +1,20 @@
 #include "subghz_worker.h"
 
-#include <stream_buffer.h>
 #include <furi.h>
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_RING_SIZE 2048
+/** Worker wakes up on this many samples or on timeout */
+#define SUBGHZ_WORKER_WATERMARK 64
+#define SUBGHZ_WORKER_TIMEOUT 10
+#define SUBGHZ_WORKER_FLAG_RX 0x01
+
 struct SubGhzWorker {
     FuriThread* thread;
-    StreamBufferHandle_t stream;
+    FuriRing* ring;
+    /** Samples popped from ring, kept off the worker stack */
+    LevelDuration batch[SUBGHZ_WORKER_WATERMARK];
 
     volatile bool running;
     volatile bool overrun;
@@ -30,16 +37,47 @@ struct SubGhzWorker {
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     SubGhzWorker* instance = context;
 
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    FURI_TRACE_POINT(FuriTraceSubGhzRx, level, duration);
+
     LevelDuration level_duration = level_duration_make(level, duration);
     if(instance->overrun) {
         instance->overrun = false;
         level_duration = level_duration_reset();
     }
-    size_t ret = xStreamBufferSendFromISR(
-        instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    if(!furi_ring_push(instance->ring, &level_duration, 1)) {
+        FURI_TRACE_POINT(FuriTraceSubGhzOverrun, 0, 0);
+        instance->overrun = true;
+    }
+}
+
+static void subghz_worker_process(SubGhzWorker* instance, LevelDuration level_duration) {
+    if(level_duration_is_reset(level_duration)) {
+        FURI_LOG_E(TAG, "Overrun buffer");
+        if(instance->overrun_callback) instance->overrun_callback(instance->context);
+        return;
+    }
+
+    bool level = level_duration_get_level(level_duration);
+    uint32_t duration = level_duration_get_duration(level_duration);
+
+    if(instance->filter_running) {
+        if((duration < instance->filter_duration) ||
+           (instance->filter_level_duration.level == level)) {
+            instance->filter_level_duration.duration += duration;
+
+        } else if(instance->filter_level_duration.level != level) {
+            if(instance->pair_callback)
+                instance->pair_callback(
+                    instance->context,
+                    instance->filter_level_duration.level,
+                    instance->filter_level_duration.duration);
+
+            instance->filter_level_duration.duration = duration;
+            instance->filter_level_duration.level = level;
+        }
+    } else {
+        if(instance->pair_callback) instance->pair_callback(instance->context, level, duration);
+    }
 }
 
 /** Worker callback thread
@@ -50,42 +88,22 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
+    furi_ring_set_notify(
+        instance->ring, osThreadGetId(), SUBGHZ_WORKER_FLAG_RX, SUBGHZ_WORKER_WATERMARK);
+
     while(instance->running) {
-        int ret =
-            xStreamBufferReceive(instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");
-                ;
-                if(instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if(instance->filter_running) {
-                    if((duration < instance->filter_duration) ||
-                       (instance->filter_level_duration.level == level)) {
-                        instance->filter_level_duration.duration += duration;
-
-                    } else if(instance->filter_level_duration.level != level) {
-                        if(instance->pair_callback)
-                            instance->pair_callback(
-                                instance->context,
-                                instance->filter_level_duration.level,
-                                instance->filter_level_duration.duration);
-
-                        instance->filter_level_duration.duration = duration;
-                        instance->filter_level_duration.level = level;
-                    }
-                } else {
-                    if(instance->pair_callback)
-                        instance->pair_callback(instance->context, level, duration);
-                }
+        furi_ring_wait(instance->ring, SUBGHZ_WORKER_TIMEOUT);
+        size_t count;
+        while((count = furi_ring_pop(
+                   instance->ring, instance->batch, COUNT_OF(instance->batch)))) {
+            for(size_t i = 0; i < count; i++) {
+                subghz_worker_process(instance, instance->batch[i]);
             }
         }
     }
 
+    furi_ring_set_notify(instance->ring, NULL, 0, 0);
+
     return 0;
 }
 
@@ -98,7 +116,7 @@ SubGhzWorker* subghz_worker_alloc() {
     furi_thread_set_context(instance->thread, instance);
     furi_thread_set_callback(instance->thread, subghz_worker_thread_callback);
 
-    instance->stream = xStreamBufferCreate(sizeof(LevelDuration) * 2048, sizeof(LevelDuration));
+    instance->ring = furi_ring_alloc(sizeof(LevelDuration), SUBGHZ_WORKER_RING_SIZE);
 
     //setting filter
     instance->filter_running = true;
@@ -110,7 +128,7 @@ SubGhzWorker* subghz_worker_alloc() {
 void subghz_worker_free(SubGhzWorker* instance) {
     furi_assert(instance);
 
-    vStreamBufferDelete(instance->stream);
+    furi_ring_free(instance->ring);
     furi_thread_free(instance->thread);
 
     free(instance);
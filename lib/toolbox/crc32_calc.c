@@ -0,0 +1,32 @@
+#include "crc32_calc.h"
+
+/* Nibble table: 64 bytes of flash instead of 1K, still 2 lookups per byte */
+static const uint32_t crc32_calc_table[16] = {
+    0x00000000,
+    0x1DB71064,
+    0x3B6E20C8,
+    0x26D930AC,
+    0x76DC4190,
+    0x6B6B51F4,
+    0x4DB26158,
+    0x5005713C,
+    0xEDB88320,
+    0xF00F9344,
+    0xD6D6A3E8,
+    0xCB61B38C,
+    0x9B64C2B0,
+    0x86D3D2D4,
+    0xA00AE278,
+    0xBDBDF21C,
+};
+
+uint32_t crc32_calc_buffer(uint32_t crc, const void* buffer, size_t size) {
+    const uint8_t* data = buffer;
+    crc = ~crc;
+    for(size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ crc32_calc_table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc32_calc_table[crc & 0x0F];
+    }
+    return ~crc;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initial value for crc32_calc_buffer */
+#define CRC32_CALC_INIT 0
+
+/**
+ * Update CRC-32 (IEEE 802.3, same as zlib) with buffer
+ * @param crc value returned for previous data, CRC32_CALC_INIT for the first buffer
+ * @param buffer data
+ * @param size data size
+ * @return uint32_t CRC of all data so far
+ */
+uint32_t crc32_calc_buffer(uint32_t crc, const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
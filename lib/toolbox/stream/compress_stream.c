@@ -0,0 +1,301 @@
+#include "stream.h"
+#include "stream_i.h"
+#include "compress_stream.h"
+#include <furi.h>
+#include <lib/heatshrink/heatshrink_encoder.h>
+#include <lib/heatshrink/heatshrink_decoder.h>
+
+/** Staging buffer between base stream and codec */
+#define COMPRESS_STREAM_IO_SIZE 64
+/** Scratch buffer for forward seek in decode mode */
+#define COMPRESS_STREAM_SKIP_SIZE 32
+/** Encoder match candidates per position, trades a bit of ratio for speed */
+#define COMPRESS_STREAM_MAX_CHAIN 64
+
+typedef struct {
+    Stream stream_base;
+    Stream* base;
+    CompressStreamMode mode;
+
+    heatshrink_encoder* encoder;
+    heatshrink_decoder* decoder;
+    uint8_t* buffer;
+    size_t buffer_size;
+
+    uint8_t io_buffer[COMPRESS_STREAM_IO_SIZE];
+    size_t io_size;
+    size_t io_index;
+
+    size_t base_start;
+    size_t position;
+    bool finished;
+    bool failed;
+} CompressStream;
+
+static void compress_stream_free(CompressStream* stream);
+static bool compress_stream_eof(CompressStream* stream);
+static void compress_stream_clean(CompressStream* stream);
+static bool compress_stream_seek(CompressStream* stream, int32_t offset, StreamOffset offset_type);
+static size_t compress_stream_tell(CompressStream* stream);
+static size_t compress_stream_size(CompressStream* stream);
+static size_t compress_stream_write(CompressStream* stream, const uint8_t* data, size_t size);
+static size_t compress_stream_read(CompressStream* stream, uint8_t* data, size_t size);
+static bool compress_stream_delete_and_insert(
+    CompressStream* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx);
+
+const StreamVTable compress_stream_vtable = {
+    .free = (StreamFreeFn)compress_stream_free,
+    .eof = (StreamEOFFn)compress_stream_eof,
+    .clean = (StreamCleanFn)compress_stream_clean,
+    .seek = (StreamSeekFn)compress_stream_seek,
+    .tell = (StreamTellFn)compress_stream_tell,
+    .size = (StreamSizeFn)compress_stream_size,
+    .write = (StreamWriteFn)compress_stream_write,
+    .read = (StreamReadFn)compress_stream_read,
+    .delete_and_insert = (StreamDeleteAndInsertFn)compress_stream_delete_and_insert,
+};
+
+Stream* compress_stream_alloc(
+    CompressStreamMode mode,
+    uint8_t window_bits,
+    uint8_t lookahead_bits) {
+    CompressStream* stream = malloc(sizeof(CompressStream));
+    memset(stream, 0, sizeof(CompressStream));
+    stream->mode = mode;
+
+    if(mode == CompressStreamModeEncode) {
+        // current input and previous window for backreferences
+        stream->buffer_size = 2 << window_bits;
+        stream->buffer = malloc(stream->buffer_size);
+        stream->encoder = heatshrink_encoder_alloc_ex(
+            stream->buffer,
+            window_bits,
+            lookahead_bits,
+            HSEM_HASH_CHAIN,
+            COMPRESS_STREAM_MAX_CHAIN);
+        furi_check(stream->encoder);
+    } else {
+        // input buffer, then expansion window
+        stream->buffer_size = COMPRESS_STREAM_IO_SIZE + (1 << window_bits);
+        stream->buffer = malloc(stream->buffer_size);
+        stream->decoder = heatshrink_decoder_alloc(
+            stream->buffer, COMPRESS_STREAM_IO_SIZE, window_bits, lookahead_bits);
+        furi_check(stream->decoder);
+    }
+
+    stream->stream_base.vtable = &compress_stream_vtable;
+    return (Stream*)stream;
+}
+
+static void compress_stream_reset(CompressStream* stream) {
+    if(stream->mode == CompressStreamModeEncode) {
+        heatshrink_encoder_reset(stream->encoder);
+    } else {
+        heatshrink_decoder_reset(stream->decoder);
+    }
+    memset(stream->buffer, 0, stream->buffer_size);
+    stream->io_size = 0;
+    stream->io_index = 0;
+    stream->position = 0;
+    stream->finished = false;
+    stream->failed = false;
+}
+
+void compress_stream_attach(Stream* _stream, Stream* base) {
+    furi_assert(_stream);
+    furi_assert(base);
+    CompressStream* stream = (CompressStream*)_stream;
+    furi_check(stream->stream_base.vtable == &compress_stream_vtable);
+
+    stream->base = base;
+    stream->base_start = stream_tell(base);
+    compress_stream_reset(stream);
+}
+
+/** Move all pending encoder output to base stream */
+static bool compress_stream_drain(CompressStream* stream) {
+    HSE_poll_res result;
+    do {
+        size_t polled = 0;
+        result = heatshrink_encoder_poll(
+            stream->encoder, stream->io_buffer, COMPRESS_STREAM_IO_SIZE, &polled);
+        if(result < 0 || stream_write(stream->base, stream->io_buffer, polled) != polled) {
+            stream->failed = true;
+            break;
+        }
+    } while(result == HSER_POLL_MORE);
+
+    return !stream->failed;
+}
+
+bool compress_stream_finish(Stream* _stream) {
+    furi_assert(_stream);
+    CompressStream* stream = (CompressStream*)_stream;
+    furi_check(stream->stream_base.vtable == &compress_stream_vtable);
+    furi_assert(stream->mode == CompressStreamModeEncode);
+    furi_assert(stream->base);
+
+    while(!stream->finished && !stream->failed) {
+        HSE_finish_res result = heatshrink_encoder_finish(stream->encoder);
+        if(result < 0) {
+            stream->failed = true;
+        } else if(result == HSER_FINISH_DONE) {
+            stream->finished = true;
+        } else {
+            compress_stream_drain(stream);
+        }
+    }
+
+    return !stream->failed;
+}
+
+/** Sink next portion of base stream to decoder, finish decoder at the end of base stream */
+static void compress_stream_feed(CompressStream* stream) {
+    if(stream->io_index == stream->io_size) {
+        stream->io_size = stream_read(stream->base, stream->io_buffer, COMPRESS_STREAM_IO_SIZE);
+        stream->io_index = 0;
+    }
+
+    if(stream->io_size == 0) {
+        heatshrink_decoder_finish(stream->decoder);
+        stream->finished = true;
+    } else {
+        size_t sunk = 0;
+        if(heatshrink_decoder_sink(
+               stream->decoder,
+               &stream->io_buffer[stream->io_index],
+               stream->io_size - stream->io_index,
+               &sunk) < 0) {
+            stream->failed = true;
+        }
+        stream->io_index += sunk;
+    }
+}
+
+static void compress_stream_free(CompressStream* stream) {
+    if(stream->mode == CompressStreamModeEncode) {
+        heatshrink_encoder_free(stream->encoder);
+    } else {
+        heatshrink_decoder_free(stream->decoder);
+    }
+    free(stream->buffer);
+    free(stream);
+}
+
+static bool compress_stream_eof(CompressStream* stream) {
+    // decoder can't tell if data remains until it runs out of it
+    return (stream->mode == CompressStreamModeEncode) || stream->finished || stream->failed;
+}
+
+static void compress_stream_clean(CompressStream* stream) {
+    furi_assert(stream->base);
+    stream_clean(stream->base);
+    stream->base_start = 0;
+    compress_stream_reset(stream);
+}
+
+static bool
+    compress_stream_seek(CompressStream* stream, int32_t offset, StreamOffset offset_type) {
+    int32_t target;
+    switch(offset_type) {
+    case StreamOffsetFromStart:
+        target = offset;
+        break;
+    case StreamOffsetFromCurrent:
+        target = (int32_t)stream->position + offset;
+        break;
+    default:
+        // plain size is unknown until data is decoded
+        return false;
+    }
+
+    if(stream->mode == CompressStreamModeEncode || target < 0) {
+        return (target == (int32_t)stream->position);
+    }
+
+    // no way back in compressed data, decode again from the start
+    if(target < (int32_t)stream->position) {
+        if(!stream_seek(stream->base, stream->base_start, StreamOffsetFromStart)) return false;
+        compress_stream_reset(stream);
+    }
+
+    uint8_t skip[COMPRESS_STREAM_SKIP_SIZE];
+    while((int32_t)stream->position < target) {
+        size_t size = MIN((size_t)(target - stream->position), sizeof(skip));
+        if(compress_stream_read(stream, skip, size) != size) break;
+    }
+
+    return (target == (int32_t)stream->position);
+}
+
+static size_t compress_stream_tell(CompressStream* stream) {
+    return stream->position;
+}
+
+static size_t compress_stream_size(CompressStream* stream) {
+    return stream->position;
+}
+
+static size_t compress_stream_write(CompressStream* stream, const uint8_t* data, size_t size) {
+    furi_assert(stream->base);
+    if(stream->mode != CompressStreamModeEncode || stream->finished) return 0;
+
+    size_t written = 0;
+    while(written < size && !stream->failed) {
+        size_t sunk = 0;
+        if(heatshrink_encoder_sink(
+               stream->encoder, (uint8_t*)&data[written], size - written, &sunk) < 0) {
+            stream->failed = true;
+            break;
+        }
+        written += sunk;
+        compress_stream_drain(stream);
+    }
+
+    stream->position += written;
+    return written;
+}
+
+static size_t compress_stream_read(CompressStream* stream, uint8_t* data, size_t size) {
+    furi_assert(stream->base);
+    if(stream->mode != CompressStreamModeDecode) return 0;
+
+    size_t read = 0;
+    while(read < size && !stream->failed) {
+        size_t polled = 0;
+        HSD_poll_res result =
+            heatshrink_decoder_poll(stream->decoder, &data[read], size - read, &polled);
+        if(result < 0) {
+            stream->failed = true;
+            break;
+        }
+        read += polled;
+
+        // output is exhausted, decoder needs more input
+        if(result == HSDR_POLL_EMPTY) {
+            if(stream->finished) break;
+            compress_stream_feed(stream);
+        }
+    }
+
+    stream->position += read;
+    return read;
+}
+
+static bool compress_stream_delete_and_insert(
+    CompressStream* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx) {
+    // compressed data can only be appended
+    if(stream->mode != CompressStreamModeEncode || delete_size) return false;
+
+    bool result = true;
+    if(write_callback) {
+        result = write_callback((Stream*)stream, ctx);
+    }
+    return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <stdlib.h>
+#include "stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    CompressStreamModeEncode, /**< write plain data, compressed data goes to base stream */
+    CompressStreamModeDecode, /**< read plain data, compressed data comes from base stream */
+} CompressStreamMode;
+
+/**
+ * Allocate heatshrink compression stream.
+ * Stream works in one direction only: encoder stream is write only, decoder stream is read only.
+ * Size and tell report amount of plain data passed so far. Window and lookahead must be the same
+ * for encoding and decoding of the same data.
+ * @param mode encode or decode
+ * @param window_bits window size, log2, 4..15
+ * @param lookahead_bits lookahead size, log2, 3..window_bits-1
+ * @return Stream*
+ */
+Stream* compress_stream_alloc(
+    CompressStreamMode mode,
+    uint8_t window_bits,
+    uint8_t lookahead_bits);
+
+/**
+ * Attach stream to base stream and reset codec state, buffers are reused.
+ * Base stream is not owned and must outlive the attachment.
+ * Decoder starts reading from current position of base stream.
+ * @param stream compress stream
+ * @param base stream with compressed data
+ */
+void compress_stream_attach(Stream* stream, Stream* base);
+
+/**
+ * Flush encoder remainder to base stream, no writes are possible after that.
+ * Must be called before free or next attach, otherwise the tail of data is lost.
+ * @param stream compress stream in encode mode
+ * @return success flag, false if any write to base stream failed
+ */
+bool compress_stream_finish(Stream* stream);
+
+#ifdef __cplusplus
+}
+#endif
@@ -40,6 +40,7 @@ Stream* file_stream_alloc(Storage* storage) {
     stream->storage = storage;
 
     stream->stream_base.vtable = &file_stream_vtable;
+    stream->stream_base.revision = 0;
     return (Stream*)stream;
 }
 
@@ -51,6 +52,8 @@ bool file_stream_open(
     furi_assert(_stream);
     FileStream* stream = (FileStream*)_stream;
     furi_check(stream->stream_base.vtable == &file_stream_vtable);
+    // other file, other data
+    stream->stream_base.revision++;
     return storage_file_open(stream->file, path, access_mode, open_mode);
 }
 
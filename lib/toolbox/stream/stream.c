@@ -11,6 +11,7 @@ void stream_free(Stream* stream) {
 
 void stream_clean(Stream* stream) {
     furi_assert(stream);
+    stream->revision++;
     stream->vtable->clean(stream);
 }
 
@@ -36,6 +37,7 @@ size_t stream_size(Stream* stream) {
 
 size_t stream_write(Stream* stream, const uint8_t* data, size_t size) {
     furi_assert(stream);
+    stream->revision++;
     return stream->vtable->write(stream, data, size);
 }
 
@@ -50,9 +52,15 @@ bool stream_delete_and_insert(
     StreamWriteCB write_callback,
     const void* ctx) {
     furi_assert(stream);
+    stream->revision++;
     return stream->vtable->delete_and_insert(stream, delete_size, write_callback, ctx);
 }
 
+uint32_t stream_get_revision(Stream* stream) {
+    furi_assert(stream);
+    return stream->revision;
+}
+
 /********************************** Some random helpers starts here **********************************/
 
 typedef struct {
@@ -314,8 +322,8 @@ void stream_dump_data(Stream* stream) {
     size_t size = stream_size(stream);
     size_t tell = stream_tell(stream);
     printf("stream %p\r\n", stream);
-    printf("size = %u\r\n", size);
-    printf("tell = %u\r\n", tell);
+    printf("size = %zu\r\n", size);
+    printf("tell = %zu\r\n", tell);
     printf("DATA START\r\n");
     uint8_t* data = malloc(STREAM_CACHE_SIZE);
     stream_rewind(stream);
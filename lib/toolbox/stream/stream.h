@@ -96,6 +96,14 @@ bool stream_delete_and_insert(
     StreamWriteCB write_callback,
     const void* context);
 
+/**
+ * Get stream modification counter. Counter changes on every write, clean and delete and insert,
+ * so data cached from the stream can be checked against changes made by other users.
+ * @param stream Stream instance
+ * @return uint32_t modification counter
+ */
+uint32_t stream_get_revision(Stream* stream);
+
 /********************************** Some random helpers starts here **********************************/
 
 /**
@@ -39,6 +39,7 @@ struct StreamVTable {
 
 struct Stream {
     const StreamVTable* vtable;
+    uint32_t revision;
 };
 
 #ifdef __cplusplus
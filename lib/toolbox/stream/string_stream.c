@@ -1,24 +1,34 @@
 #include "stream.h"
 #include "stream_i.h"
 #include "string_stream.h"
+#include <furi/check.h>
 #include <furi/common_defines.h>
 
+/** Smallest pool, typical in-RAM document fits after one or two doublings */
+#define STRING_STREAM_MIN_CAPACITY 64
+
+/**
+ * Data lives in single pool: [data][free space][parked tail].
+ * While delete_and_insert callback writes, data after the rw pointer is parked
+ * at the end of the pool, so inserted data is written in place.
+ */
 typedef struct {
     Stream stream_base;
-    string_t string;
+    uint8_t* pool;
+    size_t capacity;
+    size_t size;
+    size_t tail;
     size_t index;
 } StringStream;
 
-static size_t string_stream_write_char(StringStream* stream, char c);
-
 static void string_stream_free(StringStream* stream);
 static bool string_stream_eof(StringStream* stream);
 static void string_stream_clean(StringStream* stream);
 static bool string_stream_seek(StringStream* stream, int32_t offset, StreamOffset offset_type);
 static size_t string_stream_tell(StringStream* stream);
 static size_t string_stream_size(StringStream* stream);
-static size_t string_stream_write(StringStream* stream, const char* data, size_t size);
-static size_t string_stream_read(StringStream* stream, char* data, size_t size);
+static size_t string_stream_write(StringStream* stream, const uint8_t* data, size_t size);
+static size_t string_stream_read(StringStream* stream, uint8_t* data, size_t size);
 static bool string_stream_delete_and_insert(
     StringStream* stream,
     size_t delete_size,
@@ -39,14 +49,70 @@ const StreamVTable string_stream_vtable = {
 
 Stream* string_stream_alloc() {
     StringStream* stream = malloc(sizeof(StringStream));
-    string_init(stream->string);
-    stream->index = 0;
+    memset(stream, 0, sizeof(StringStream));
     stream->stream_base.vtable = &string_stream_vtable;
     return (Stream*)stream;
 }
 
+/** Resize pool to exact capacity, parked tail moves along with the end of the pool */
+static void string_stream_resize(StringStream* stream, size_t capacity) {
+    furi_assert(capacity >= stream->size + stream->tail);
+    if(capacity == stream->capacity) return;
+
+    if(capacity < stream->capacity && stream->tail) {
+        memmove(
+            &stream->pool[capacity - stream->tail],
+            &stream->pool[stream->capacity - stream->tail],
+            stream->tail);
+    }
+
+    stream->pool = realloc(stream->pool, capacity);
+
+    if(capacity > stream->capacity && stream->tail) {
+        memmove(
+            &stream->pool[capacity - stream->tail],
+            &stream->pool[stream->capacity - stream->tail],
+            stream->tail);
+    }
+
+    stream->capacity = capacity;
+}
+
+/** Make room for data, capacity grows at least twice to keep appends amortized */
+static void string_stream_grow(StringStream* stream, size_t required) {
+    if(required <= stream->capacity) return;
+
+    size_t capacity = MAX(stream->capacity * 2, (size_t)STRING_STREAM_MIN_CAPACITY);
+    string_stream_resize(stream, MAX(capacity, required));
+}
+
+void string_stream_reserve(Stream* _stream, size_t capacity) {
+    furi_assert(_stream);
+    StringStream* stream = (StringStream*)_stream;
+    furi_check(stream->stream_base.vtable == &string_stream_vtable);
+
+    if(capacity > stream->capacity) {
+        string_stream_resize(stream, capacity);
+    }
+}
+
+void string_stream_shrink(Stream* _stream) {
+    furi_assert(_stream);
+    StringStream* stream = (StringStream*)_stream;
+    furi_check(stream->stream_base.vtable == &string_stream_vtable);
+    furi_check(stream->tail == 0);
+
+    if(stream->size == 0) {
+        free(stream->pool);
+        stream->pool = NULL;
+        stream->capacity = 0;
+    } else {
+        string_stream_resize(stream, stream->size);
+    }
+}
+
 static void string_stream_free(StringStream* stream) {
-    string_clear(stream->string);
+    free(stream->pool);
     free(stream);
 }
 
@@ -55,8 +121,9 @@ static bool string_stream_eof(StringStream* stream) {
 }
 
 static void string_stream_clean(StringStream* stream) {
+    // pool is kept for the next document
     stream->index = 0;
-    string_reset(stream->string);
+    stream->size = 0;
 }
 
 static bool string_stream_seek(StringStream* stream, int32_t offset, StreamOffset offset_type) {
@@ -79,8 +146,8 @@ static bool string_stream_seek(StringStream* stream, int32_t offset, StreamOffse
         }
         break;
     case StreamOffsetFromEnd:
-        if(((int32_t)string_size(stream->string) + offset) >= 0) {
-            stream->index = string_size(stream->string) + offset;
+        if(((int32_t)stream->size + offset) >= 0) {
+            stream->index = stream->size + offset;
         } else {
             result = false;
             stream->index = 0;
@@ -88,9 +155,8 @@ static bool string_stream_seek(StringStream* stream, int32_t offset, StreamOffse
         break;
     }
 
-    int32_t diff = (stream->index - string_size(stream->string));
-    if(diff > 0) {
-        stream->index -= diff;
+    if(stream->index > stream->size) {
+        stream->index = stream->size;
         result = false;
     }
 
@@ -102,35 +168,33 @@ static size_t string_stream_tell(StringStream* stream) {
 }
 
 static size_t string_stream_size(StringStream* stream) {
-    return string_size(stream->string);
+    return stream->size;
 }
 
-static size_t string_stream_write(StringStream* stream, const char* data, size_t size) {
-    // TODO: can be optimized for edge cases
-    size_t i;
-    for(i = 0; i < size; i++) {
-        string_stream_write_char(stream, data[i]);
+static size_t string_stream_write(StringStream* stream, const uint8_t* data, size_t size) {
+    size_t end = stream->index + size;
+    if(end > stream->size) {
+        string_stream_grow(stream, end + stream->tail);
+        stream->size = end;
     }
 
-    return i;
-}
+    if(size) {
+        memcpy(&stream->pool[stream->index], data, size);
+        stream->index = end;
+    }
 
-static size_t string_stream_read(StringStream* stream, char* data, size_t size) {
-    size_t write_index = 0;
-    const char* cstr = string_get_cstr(stream->string);
+    return size;
+}
 
-    if(!string_stream_eof(stream)) {
-        while(true) {
-            if(write_index >= size) break;
+static size_t string_stream_read(StringStream* stream, uint8_t* data, size_t size) {
+    size_t read = MIN(size, stream->size - stream->index);
 
-            data[write_index] = cstr[stream->index];
-            write_index++;
-            string_stream_seek(stream, 1, StreamOffsetFromCurrent);
-            if(string_stream_eof(stream)) break;
-        }
+    if(read) {
+        memcpy(data, &stream->pool[stream->index], read);
+        stream->index += read;
     }
 
-    return write_index;
+    return read;
 }
 
 static bool string_stream_delete_and_insert(
@@ -138,42 +202,39 @@ static bool string_stream_delete_and_insert(
     size_t delete_size,
     StreamWriteCB write_callback,
     const void* ctx) {
+    furi_check(stream->tail == 0);
     bool result = true;
 
-    if(delete_size) {
-        size_t remain_size = string_stream_size(stream) - string_stream_tell(stream);
-        remain_size = MIN(delete_size, remain_size);
+    delete_size = MIN(delete_size, stream->size - stream->index);
+    size_t tail = stream->size - stream->index - delete_size;
 
-        if(remain_size != 0) {
-            string_replace_at(stream->string, stream->index, remain_size, "");
+    if(write_callback) {
+        // park the tail, callback writes right over deleted data
+        if(tail) {
+            string_stream_grow(stream, stream->index + tail);
+            memmove(
+                &stream->pool[stream->capacity - tail],
+                &stream->pool[stream->index + delete_size],
+                tail);
         }
-    }
+        stream->size = stream->index;
+        stream->tail = tail;
 
-    if(write_callback) {
-        string_t right;
-        string_init_set(right, &string_get_cstr(stream->string)[stream->index]);
-        string_left(stream->string, string_stream_tell(stream));
         result &= write_callback((Stream*)stream, ctx);
-        string_cat(stream->string, right);
-        string_clear(right);
+
+        // callback may seek back and overwrite, tail goes after all written data
+        if(tail) {
+            memmove(&stream->pool[stream->size], &stream->pool[stream->capacity - tail], tail);
+        }
+        stream->tail = 0;
+        stream->size += tail;
+    } else if(delete_size) {
+        if(tail) {
+            memmove(
+                &stream->pool[stream->index], &stream->pool[stream->index + delete_size], tail);
+        }
+        stream->size = stream->index + tail;
     }
 
     return result;
 }
-
-/**
- * Write to string stream helper
- * @param stream 
- * @param c 
- * @return size_t 
- */
-static size_t string_stream_write_char(StringStream* stream, char c) {
-    if(string_stream_eof(stream)) {
-        string_push_back(stream->string, c);
-    } else {
-        string_set_char(stream->string, stream->index, c);
-    }
-    stream->index++;
-
-    return 1;
-}
\ No newline at end of file
@@ -8,11 +8,26 @@ extern "C" {
 #endif
 
 /**
- * Allocate string stream
+ * Allocate string stream.
+ * Data is kept in single memory pool, which grows geometrically and is kept on clean,
+ * so stream can be reused without allocations.
  * @return Stream* 
  */
 Stream* string_stream_alloc();
 
+/**
+ * Preallocate pool for the expected amount of data
+ * @param stream string stream
+ * @param capacity pool size in bytes
+ */
+void string_stream_reserve(Stream* stream, size_t capacity);
+
+/**
+ * Shrink pool to the data size, for streams which are kept in memory after they were filled
+ * @param stream string stream
+ */
+void string_stream_shrink(Stream* stream);
+
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
@@ -37,8 +37,13 @@ CHECK_AND_REINIT_SUBMODULES_SHELL=\
 $(info $(shell $(CHECK_AND_REINIT_SUBMODULES_SHELL)))
 
 
+ifeq ($(TOOLCHAIN), arm)
 all: $(OBJ_DIR)/$(PROJECT).elf $(OBJ_DIR)/$(PROJECT).hex $(OBJ_DIR)/$(PROJECT).bin $(OBJ_DIR)/$(PROJECT).dfu $(OBJ_DIR)/$(PROJECT).json
 	@:
+else
+all: $(OBJ_DIR)/$(PROJECT).elf
+	@:
+endif
 
 $(OBJ_DIR)/$(PROJECT).elf: $(OBJECTS)
 	@echo "\tLD\t" $@
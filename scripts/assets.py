@@ -61,6 +61,12 @@ class Main(App):
             help="Symbol and file name in dolphin output directory",
             default=None,
         )
+        self.parser_dolphin.add_argument(
+            "-b",
+            "--bundle",
+            help="Pack each animation to single bundle file",
+            action="store_true",
+        )
         self.parser_dolphin.add_argument(
             "input_directory", help="Dolphin source directory"
         )
@@ -245,7 +251,9 @@ class Main(App):
         self.logger.info(f"Loading data")
         dolphin.load(self.args.input_directory)
         self.logger.info(f"Packing")
-        dolphin.pack(self.args.output_directory, self.args.symbol_name)
+        dolphin.pack(
+            self.args.output_directory, self.args.symbol_name, self.args.bundle
+        )
         self.logger.info(f"Complete")
 
         return 0
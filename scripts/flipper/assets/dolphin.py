@@ -3,6 +3,7 @@ import logging
 import os
 import sys
 import shutil
+import struct
 from collections import Counter
 
 from flipper.utils.fff import *
@@ -26,6 +27,12 @@ class DolphinBubbleAnimation:
     FILE_TYPE = "Flipper Animation"
     FILE_VERSION = 1
 
+    BUNDLE_EXTENSION = ".bundle"
+    BUNDLE_MAGIC = b"FLAB"
+    BUNDLE_VERSION = 1
+    # Index is Align enum value in firmware
+    BUNDLE_ALIGN = ["Left", "Right", "Top", "Bottom", "Center"]
+
     def __init__(
         self,
         name: str,
@@ -230,6 +237,64 @@ class DolphinBubbleAnimation:
         pool = multiprocessing.Pool()
         pool.map(_convert_image_to_bm, to_pack)
 
+    def save2bundle(self, output_directory: str):
+        bundle_filename = os.path.join(
+            output_directory, f"{self.name}{self.BUNDLE_EXTENSION}"
+        )
+
+        header = struct.pack(
+            "<4sBBBBBBBBHHBBH",
+            self.BUNDLE_MAGIC,
+            self.BUNDLE_VERSION,
+            self.meta["Width"],
+            self.meta["Height"],
+            len(self.frames),
+            self.meta["Passive frames"],
+            self.meta["Active frames"],
+            self.meta["Active cycles"],
+            self.meta["Frame rate"],
+            self.meta["Duration"],
+            self.meta["Active cooldown"],
+            self.bubble_slots,
+            len(self.bubbles),
+            0,
+        )
+        frames_order = bytes(self.meta["Frames order"])
+
+        bubbles = bytearray()
+        for bubble in self.bubbles:
+            text = bubble["Text"].replace("\\n", "\n").encode()
+            assert len(text) <= 100
+            bubbles += struct.pack(
+                "<8B",
+                bubble["Slot"],
+                bubble["X"],
+                bubble["Y"],
+                self.BUNDLE_ALIGN.index(bubble["AlignH"]),
+                self.BUNDLE_ALIGN.index(bubble["AlignV"]),
+                bubble["StartFrame"],
+                bubble["EndFrame"],
+                len(text),
+            )
+            bubbles += text
+
+        # Absolute frame offsets, extra one marks end of last frame
+        offset = len(header) + len(frames_order) + 4 * (len(self.frames) + 1)
+        offset += len(bubbles)
+        offsets = []
+        for frame in self.frames:
+            offsets.append(offset)
+            offset += len(frame)
+        offsets.append(offset)
+
+        with open(bundle_filename, "wb") as file:
+            file.write(header)
+            file.write(frames_order)
+            file.write(struct.pack(f"<{len(offsets)}I", *offsets))
+            file.write(bubbles)
+            for frame in self.frames:
+                file.write(frame)
+
     def process(self):
         pool = multiprocessing.Pool()
         self.frames = pool.map(_convert_image, self.frames)
@@ -321,7 +386,11 @@ class DolphinManifest:
             symbol_name=symbol_name,
         )
 
-    def save2folder(self, output_directory: str):
+    def save2folder(self, output_directory: str, bundle: bool = False):
+        if bundle:
+            for animation in self.animations:
+                animation.process()
+
         manifest_filename = os.path.join(output_directory, "manifest.txt")
         file = FlipperFormatFile()
         file.setHeader(self.FILE_TYPE, self.FILE_VERSION)
@@ -336,16 +405,19 @@ class DolphinManifest:
             file.writeKey("Weight", animation.weight)
             file.writeEmptyLine()
 
-            animation.save(output_directory)
+            if bundle:
+                animation.save2bundle(output_directory)
+            else:
+                animation.save(output_directory)
 
         file.save(manifest_filename)
 
-    def save(self, output_directory: str, symbol_name: str):
+    def save(self, output_directory: str, symbol_name: str, bundle: bool = False):
         os.makedirs(output_directory, exist_ok=True)
         if symbol_name:
             self.save2code(output_directory, symbol_name)
         else:
-            self.save2folder(output_directory)
+            self.save2folder(output_directory, bundle)
 
 
 class Dolphin:
@@ -359,5 +431,7 @@ class Dolphin:
         self.logger.info(f"Loading directory {source_directory}")
         self.manifest.load(source_directory)
 
-    def pack(self, output_directory: str, symbol_name: str = None):
-        self.manifest.save(output_directory, symbol_name)
+    def pack(
+        self, output_directory: str, symbol_name: str = None, bundle: bool = False
+    ):
+        self.manifest.save(output_directory, symbol_name, bundle)
@@ -0,0 +1,347 @@
+#!/usr/bin/env python3
+
+from flipper.app import App
+from flipper.storage import BufferedRead
+
+import collections
+import html
+import serial
+import struct
+import subprocess
+import time
+
+# Keep in sync with furi_hal_profiler.h
+DUMP_MAGIC = 0x52505A46
+DUMP_VERSION = 1
+HEADER = struct.Struct("<IBBHIIIII")
+THREAD = struct.Struct("<I16sQ")
+SAMPLE = struct.Struct("<III")
+
+# Cortex-M exception numbers, external interrupts start from 16
+EXCEPTIONS = {
+    2: "NMI",
+    3: "HardFault",
+    4: "MemManage",
+    5: "BusFault",
+    6: "UsageFault",
+    11: "SVCall",
+    12: "DebugMon",
+    14: "PendSV",
+    15: "SysTick",
+}
+
+
+class ProfilerDump:
+    def __init__(self):
+        self.core_clock = 0
+        self.rate = 0
+        self.duration = 0
+        self.dropped = 0
+        # id: (name, runtime), last dump wins: counters are cumulative
+        self.threads = {}
+        # (context, lr, pc)
+        self.samples = []
+
+    def parse(self, data):
+        offset = 0
+        while offset < len(data):
+            offset = self.parse_one(data, offset)
+
+    def parse_one(self, data, offset):
+        (
+            magic,
+            version,
+            _,
+            thread_count,
+            core_clock,
+            rate,
+            duration,
+            sample_count,
+            dropped,
+        ) = HEADER.unpack_from(data, offset)
+        if magic != DUMP_MAGIC or version != DUMP_VERSION:
+            raise Exception(f"Not a profiler dump at offset {offset}")
+        offset += HEADER.size
+
+        self.core_clock = core_clock
+        self.rate = rate
+        self.duration = duration
+        self.dropped += dropped
+
+        for _ in range(thread_count):
+            id, name, runtime = THREAD.unpack_from(data, offset)
+            name = name.split(b"\0", 1)[0].decode("ascii", "replace")
+            self.threads[id] = (name, runtime)
+            offset += THREAD.size
+
+        for _ in range(sample_count):
+            pc, lr, context = SAMPLE.unpack_from(data, offset)
+            self.samples.append((context, lr, pc))
+            offset += SAMPLE.size
+
+        return offset
+
+    def context_name(self, context):
+        if context < 256:
+            if context in EXCEPTIONS:
+                return f"[{EXCEPTIONS[context]}]"
+            return f"[IRQ {context - 16}]"
+        if context in self.threads:
+            return self.threads[context][0]
+        return f"thread {context:08X}"
+
+
+class Symbolizer:
+    def __init__(self, elf, addr2line):
+        self.elf = elf
+        self.addr2line = addr2line
+        self.cache = {}
+
+    def resolve(self, addresses):
+        # Thumb bit set in LR, one batch call for all unknown addresses
+        pending = sorted(set(a & ~1 for a in addresses) - set(self.cache))
+        if pending and self.elf:
+            output = subprocess.check_output(
+                [self.addr2line, "-f", "-C", "-e", self.elf]
+                + [f"0x{a:08X}" for a in pending]
+            )
+            lines = output.decode("ascii", "replace").splitlines()
+            for address, function in zip(pending, lines[0::2]):
+                if function == "??":
+                    function = f"0x{address:08X}"
+                self.cache[address] = function
+        for address in pending:
+            self.cache.setdefault(address, f"0x{address:08X}")
+
+    def __call__(self, address):
+        return self.cache[address & ~1]
+
+
+class FlameGraph:
+    FRAME_HEIGHT = 16
+    WIDTH = 1200
+
+    def __init__(self, folded):
+        self.root = {"count": 0, "children": {}}
+        for stack, count in folded.items():
+            node = self.root
+            node["count"] += count
+            for frame in stack:
+                node = node["children"].setdefault(frame, {"count": 0, "children": {}})
+                node["count"] += count
+
+    def depth(self, node):
+        return 1 + max([self.depth(c) for c in node["children"].values()] or [0])
+
+    def render(self, path, title):
+        height = (self.depth(self.root) + 1) * self.FRAME_HEIGHT
+        total = max(self.root["count"], 1)
+        rects = []
+
+        def walk(node, name, x, level):
+            width = node["count"] * self.WIDTH / total
+            y = height - (level + 1) * self.FRAME_HEIGHT
+            label = html.escape(name)
+            share = node["count"] * 100 / total
+            rects.append(
+                f'<g><title>{label} ({node["count"]} samples, {share:.1f}%)</title>'
+                f'<rect x="{x:.1f}" y="{y}" width="{width:.1f}" '
+                f'height="{self.FRAME_HEIGHT - 1}" fill="{self.color(name)}"/>'
+                f'<text x="{x + 2:.1f}" y="{y + 12}" font-size="11">'
+                f"{label[:int(width / 7)]}</text></g>"
+            )
+            for child_name, child in sorted(node["children"].items()):
+                walk(child, child_name, x, level + 1)
+                x += child["count"] * self.WIDTH / total
+
+        walk(self.root, title, 0, 0)
+        with open(path, "w") as file:
+            file.write(
+                f'<svg xmlns="http://www.w3.org/2000/svg" width="{self.WIDTH}" '
+                f'height="{height}" font-family="monospace">\n'
+            )
+            file.write("\n".join(rects))
+            file.write("\n</svg>\n")
+
+    @staticmethod
+    def color(name):
+        value = sum(name.encode()) % 100
+        return f"rgb(230,{100 + value},{50 + value // 2})"
+
+
+class FlipperProfiler:
+    CLI_PROMPT = ">: "
+    CLI_EOL = "\r\n"
+
+    def __init__(self, portname):
+        self.port = serial.Serial()
+        self.port.port = portname
+        self.port.timeout = 2
+        self.port.baudrate = 115200
+        self.read = BufferedRead(self.port)
+
+    def start(self):
+        self.port.open()
+        self.port.reset_input_buffer()
+        # Send a command with a known syntax to make sure the buffer is flushed
+        self.port.write(b"device_info\r")
+        self.read.until("hardware_model")
+        self.read.until(self.CLI_PROMPT)
+
+    def stop(self):
+        self.port.close()
+
+    def command(self, line):
+        self.port.write((line + "\r").encode("ascii"))
+        self.read.until(self.CLI_EOL)
+        return self.read.until(self.CLI_PROMPT)
+
+    def read_exact(self, size):
+        while len(self.read.buffer) < size:
+            data = self.port.read(max(1, self.port.in_waiting))
+            if not data:
+                raise Exception("Timeout while reading dump")
+            self.read.buffer.extend(data)
+        data = self.read.buffer[:size]
+        self.read.buffer = self.read.buffer[size:]
+        return bytes(data)
+
+    def dump(self):
+        self.port.write(b"profiler dump\r")
+        self.read.until(self.CLI_EOL)
+        header = self.read_exact(HEADER.size)
+        magic, _, _, thread_count, _, _, _, sample_count, _ = HEADER.unpack(header)
+        if magic != DUMP_MAGIC:
+            raise Exception(f"Profiler dump expected: {header}")
+        body = self.read_exact(thread_count * THREAD.size + sample_count * SAMPLE.size)
+        self.read.until(self.CLI_PROMPT)
+        return header + body
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_record = self.subparsers.add_parser(
+            "record", help="Record profile over CLI"
+        )
+        self.parser_record.add_argument("-p", "--port", help="CDC Port", required=True)
+        self.parser_record.add_argument(
+            "-r", "--rate", type=int, default=1000, help="Samples per second"
+        )
+        self.parser_record.add_argument(
+            "-t", "--time", type=float, default=10, help="Duration, seconds"
+        )
+        self.parser_record.add_argument(
+            "-i",
+            "--interval",
+            type=float,
+            default=0.5,
+            help="Dump interval, seconds. Device buffer holds 1024 samples",
+        )
+        self.parser_record.add_argument("output", help="Dump file")
+        self.parser_record.set_defaults(func=self.record)
+
+        self.parser_report = self.subparsers.add_parser(
+            "report", help="Symbolize dump, print summary and make flame graph"
+        )
+        self.parser_report.add_argument("-e", "--elf", help="Firmware ELF")
+        self.parser_report.add_argument(
+            "--addr2line", default="arm-none-eabi-addr2line", help="addr2line binary"
+        )
+        self.parser_report.add_argument(
+            "-f", "--folded", help="Folded stacks output, flamegraph.pl format"
+        )
+        self.parser_report.add_argument("-s", "--svg", help="Flame graph SVG output")
+        self.parser_report.add_argument(
+            "-n", "--top", type=int, default=20, help="Functions in summary"
+        )
+        self.parser_report.add_argument("input", help="Dump file")
+        self.parser_report.set_defaults(func=self.report)
+
+    def record(self):
+        profiler = FlipperProfiler(self.args.port)
+        profiler.start()
+        output = profiler.command(f"profiler start {self.args.rate}")
+        if output.strip():
+            self.logger.error(output.decode("ascii", "replace").strip())
+            profiler.stop()
+            return 1
+
+        data = bytearray()
+        end = time.monotonic() + self.args.time
+        try:
+            while time.monotonic() < end:
+                time.sleep(self.args.interval)
+                data += profiler.dump()
+        finally:
+            profiler.command("profiler stop")
+            data += profiler.dump()
+            profiler.stop()
+
+        with open(self.args.output, "wb") as file:
+            file.write(data)
+
+        dump = ProfilerDump()
+        dump.parse(data)
+        self.logger.info(
+            f"{len(dump.samples)} samples, {dump.dropped} dropped, "
+            f"{len(dump.threads)} threads"
+        )
+        if dump.dropped:
+            self.logger.warning("Samples dropped, use lower rate or dump interval")
+        return 0
+
+    def report(self):
+        dump = ProfilerDump()
+        with open(self.args.input, "rb") as file:
+            dump.parse(file.read())
+
+        symbolize = Symbolizer(self.args.elf, self.args.addr2line)
+        symbolize.resolve([a for _, lr, pc in dump.samples for a in (lr, pc)])
+
+        # PC and LR are the only frames we have: thread, caller, function
+        folded = collections.Counter()
+        functions = collections.Counter()
+        for context, lr, pc in dump.samples:
+            function = symbolize(pc)
+            caller = symbolize(lr)
+            stack = [dump.context_name(context)]
+            if caller != function:
+                stack.append(caller)
+            stack.append(function)
+            folded[tuple(stack)] += 1
+            functions[function] += 1
+
+        total_runtime = sum(runtime for _, runtime in dump.threads.values())
+        print(
+            f"Duration {dump.duration} ms, {dump.rate} Hz, "
+            f"{len(dump.samples)} samples, {dump.dropped} dropped"
+        )
+        print(f"\n{'Thread':<20} {'CPU ms':>10} {'CPU %':>7}")
+        for id, (name, runtime) in sorted(
+            dump.threads.items(), key=lambda t: t[1][1], reverse=True
+        ):
+            print(
+                f"{name:<20} {runtime * 1000 / dump.core_clock:>10.1f} "
+                f"{runtime * 100 / max(total_runtime, 1):>7.1f}"
+            )
+
+        print(f"\n{'Function':<48} {'Samples':>8} {'%':>7}")
+        for function, count in functions.most_common(self.args.top):
+            share = count * 100 / max(len(dump.samples), 1)
+            print(f"{function[:48]:<48} {count:>8} {share:>7.1f}")
+
+        if self.args.folded:
+            with open(self.args.folded, "w") as file:
+                for stack, count in sorted(folded.items()):
+                    file.write(";".join(stack) + f" {count}\n")
+
+        if self.args.svg:
+            FlameGraph(folded).render(self.args.svg, "all")
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+
+from flipper.app import App
+from flipper.storage import BufferedRead
+
+import json
+import serial
+import struct
+import time
+
+# Keep in sync with core/furi/trace.h
+TRACE_MAGIC = 0x52545A46
+TRACE_VERSION = 1
+HEADER = struct.Struct("<IBBHHHIIIII")
+POINT = struct.Struct("<B3x16s12s12s")
+THREAD = struct.Struct("<I16s")
+EVENT = struct.Struct("<IHHII")
+CONTEXT_ISR = 0x8000
+
+KIND_PHASE = {0: "i", 1: "B", 2: "E"}
+
+# Events are stamped after slot is reserved, preempted writer may be a bit late
+REORDER_WINDOW_US = 1000
+
+
+def cstring(data):
+    return data.split(b"\0", 1)[0].decode("ascii", "replace")
+
+
+class TraceStream:
+    def __init__(self):
+        # id: (kind, name, arg0, arg1), taken from the latest drain
+        self.points = {}
+        # number: name
+        self.threads = {}
+        # (time_us, point_id, context, arg0, arg1)
+        self.events = []
+        self.lost = 0
+
+    def parse(self, data):
+        offset = 0
+        while offset < len(data):
+            offset = self.parse_one(data, offset)
+
+    def parse_one(self, data, offset):
+        (
+            magic,
+            version,
+            _,
+            point_count,
+            thread_count,
+            _,
+            core_clock,
+            timestamp,
+            uptime,
+            event_count,
+            lost,
+        ) = HEADER.unpack_from(data, offset)
+        if magic != TRACE_MAGIC or version != TRACE_VERSION:
+            raise Exception(f"Not a trace drain at offset {offset}")
+        offset += HEADER.size
+        self.lost += lost
+
+        for id in range(point_count):
+            kind, name, arg0, arg1 = POINT.unpack_from(data, offset)
+            self.points[id] = (kind, cstring(name), cstring(arg0), cstring(arg1))
+            offset += POINT.size
+
+        for _ in range(thread_count):
+            number, name = THREAD.unpack_from(data, offset)
+            self.threads[number] = cstring(name)
+            offset += THREAD.size
+
+        events = []
+        for _ in range(event_count):
+            events.append(EVENT.unpack_from(data, offset))
+            offset += EVENT.size
+
+        # Cycle counter wraps, walk back from drain time: gaps between events
+        # longer than counter period fold
+        cycles_per_us = core_clock / 1000000
+        window = int(REORDER_WINDOW_US * cycles_per_us)
+        time_us = uptime * 1000
+        next_timestamp = timestamp
+        timed = []
+        for event_timestamp, id, context, arg0, arg1 in reversed(events):
+            delta = (next_timestamp - event_timestamp) & 0xFFFFFFFF
+            if delta > 0xFFFFFFFF - window:
+                delta -= 1 << 32
+            time_us -= delta / cycles_per_us
+            next_timestamp = event_timestamp
+            timed.append((time_us, id, context, arg0, arg1))
+        self.events.extend(reversed(timed))
+
+        return offset
+
+    def context_name(self, context):
+        if context & CONTEXT_ISR:
+            exception = context & ~CONTEXT_ISR
+            if exception < 16:
+                return f"[Exception {exception}]"
+            return f"[IRQ {exception - 16}]"
+        if context == 0:
+            return "[main]"
+        return self.threads.get(context, f"thread {context}")
+
+    def chrome_trace(self):
+        trace_events = []
+        contexts = set()
+        for time_us, id, context, arg0, arg1 in self.events:
+            kind, name, arg0_name, arg1_name = self.points.get(
+                id, (0, f"point {id}", "arg0", "arg1")
+            )
+            args = {}
+            if arg0_name:
+                args[arg0_name] = arg0
+            if arg1_name:
+                args[arg1_name] = arg1
+            event = {
+                "name": name,
+                "ph": KIND_PHASE.get(kind, "i"),
+                "ts": round(time_us, 3),
+                "pid": 0,
+                "tid": context,
+                "args": args,
+            }
+            if event["ph"] == "i":
+                event["s"] = "t"
+            trace_events.append(event)
+            contexts.add(context)
+
+        for context in sorted(contexts):
+            trace_events.append(
+                {
+                    "name": "thread_name",
+                    "ph": "M",
+                    "pid": 0,
+                    "tid": context,
+                    "args": {"name": self.context_name(context)},
+                }
+            )
+
+        return {"traceEvents": trace_events, "displayTimeUnit": "ns"}
+
+
+class FlipperTrace:
+    CLI_PROMPT = ">: "
+    CLI_EOL = "\r\n"
+
+    def __init__(self, portname):
+        self.port = serial.Serial()
+        self.port.port = portname
+        self.port.timeout = 2
+        self.port.baudrate = 115200
+        self.read = BufferedRead(self.port)
+
+    def start(self):
+        self.port.open()
+        self.port.reset_input_buffer()
+        # Send a command with a known syntax to make sure the buffer is flushed
+        self.port.write(b"device_info\r")
+        self.read.until("hardware_model")
+        self.read.until(self.CLI_PROMPT)
+
+    def stop(self):
+        self.port.close()
+
+    def read_exact(self, size):
+        while len(self.read.buffer) < size:
+            data = self.port.read(max(1, self.port.in_waiting))
+            if not data:
+                raise Exception("Timeout while reading trace")
+            self.read.buffer.extend(data)
+        data = self.read.buffer[:size]
+        self.read.buffer = self.read.buffer[size:]
+        return bytes(data)
+
+    def drain(self):
+        self.port.write(b"trace drain\r")
+        self.read.until(self.CLI_EOL)
+        header = self.read_exact(HEADER.size)
+        magic, _, _, point_count, thread_count, *_, event_count, _ = HEADER.unpack(header)
+        if magic != TRACE_MAGIC:
+            # Text reply: not compiled in or busy
+            message = header + self.read.until(self.CLI_PROMPT)
+            raise Exception(message.decode("ascii", "replace").strip())
+        body = self.read_exact(
+            point_count * POINT.size
+            + thread_count * THREAD.size
+            + event_count * EVENT.size
+        )
+        self.read.until(self.CLI_PROMPT)
+        return header + body
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_record = self.subparsers.add_parser(
+            "record", help="Drain trace over CLI"
+        )
+        self.parser_record.add_argument("-p", "--port", help="CDC Port", required=True)
+        self.parser_record.add_argument(
+            "-t", "--time", type=float, default=10, help="Duration, seconds"
+        )
+        self.parser_record.add_argument(
+            "-i",
+            "--interval",
+            type=float,
+            default=0.2,
+            help="Drain interval, seconds. Device ring holds 512 events",
+        )
+        self.parser_record.add_argument("output", help="Trace stream file")
+        self.parser_record.set_defaults(func=self.record)
+
+        self.parser_convert = self.subparsers.add_parser(
+            "convert", help="Convert trace stream to Chrome trace JSON"
+        )
+        self.parser_convert.add_argument("input", help="Trace stream file")
+        self.parser_convert.add_argument(
+            "output", help="JSON file for chrome://tracing or Perfetto"
+        )
+        self.parser_convert.set_defaults(func=self.convert)
+
+    def record(self):
+        trace = FlipperTrace(self.args.port)
+        trace.start()
+
+        data = bytearray()
+        end = time.monotonic() + self.args.time
+        try:
+            # Start from fresh ring
+            trace.drain()
+            while time.monotonic() < end:
+                time.sleep(self.args.interval)
+                data += trace.drain()
+        except Exception as e:
+            self.logger.error(str(e))
+            return 1
+        finally:
+            trace.stop()
+
+        with open(self.args.output, "wb") as file:
+            file.write(data)
+
+        stream = TraceStream()
+        stream.parse(data)
+        self.logger.info(f"{len(stream.events)} events, {stream.lost} lost")
+        if stream.lost:
+            self.logger.warning("Events lost, use lower drain interval")
+        return 0
+
+    def convert(self):
+        stream = TraceStream()
+        with open(self.args.input, "rb") as file:
+            stream.parse(file.read())
+
+        with open(self.args.output, "w") as file:
+            json.dump(stream.chrome_trace(), file)
+
+        self.logger.info(f"{len(stream.events)} events, {stream.lost} lost")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()